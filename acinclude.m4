@@ -7,6 +7,10 @@ AC_DEFUN([AX_LIBLUKSDE_CHECK_LOCAL],
   [dnl Check for internationalization functions in libluksde/libluksde_i18n.c
   AC_CHECK_FUNCS([bindtextdomain])
 
+  dnl Check for the Linux kernel crypto API (AF_ALG) in libluksde/libluksde_af_alg.c
+  AC_CHECK_HEADERS([linux/if_alg.h])
+  AC_CHECK_FUNCS([splice vmsplice])
+
   dnl Check if library should be build with verbose output
   AX_COMMON_CHECK_ENABLE_VERBOSE_OUTPUT
 
@@ -0,0 +1,1686 @@
+/*
+ * AES-NI and VAES functions
+ *
+ * Copyright (C) 2013-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libluksde_aesni.h"
+#include "libluksde_encryption.h"
+#include "libluksde_libcerror.h"
+
+#if defined( HAVE_LIBLUKSDE_AESNI_SUPPORT )
+
+#include <cpuid.h>
+#include <immintrin.h>
+
+#define LIBLUKSDE_AESNI_TARGET \
+	__attribute__(( target( "aes,sse2" ) ))
+
+#if defined( HAVE_LIBLUKSDE_VAES_SUPPORT )
+#define LIBLUKSDE_VAES_TARGET \
+	__attribute__(( target( "aes,avx512f,vaes" ) ))
+#endif
+
+/* The round constants used by the key expansion
+ */
+static const uint32_t libluksde_aesni_round_constants[ 10 ] = {
+	0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1b, 0x36 };
+
+#endif /* defined( HAVE_LIBLUKSDE_AESNI_SUPPORT ) */
+
+/* Determines the AES and vector instructions supported by the CPU
+ * Returns the feature flags, which are 0 if none are supported
+ */
+int libluksde_aesni_get_features(
+     void )
+{
+#if defined( HAVE_LIBLUKSDE_AESNI_SUPPORT )
+	uint32_t extended_control_register_lower = 0;
+	uint32_t extended_control_register_upper = 0;
+	unsigned int cpuid_eax                   = 0;
+	unsigned int cpuid_ebx                   = 0;
+	unsigned int cpuid_ecx                   = 0;
+	unsigned int cpuid_edx                   = 0;
+	int features                             = 0;
+
+	if( __get_cpuid(
+	     1,
+	     &cpuid_eax,
+	     &cpuid_ebx,
+	     &cpuid_ecx,
+	     &cpuid_edx ) == 0 )
+	{
+		return( 0 );
+	}
+	/* CPUID.01H:ECX.AESNI[bit 25]
+	 */
+	if( ( cpuid_ecx & 0x02000000UL ) != 0 )
+	{
+		features = LIBLUKSDE_AESNI_FEATURE_FLAG_AES;
+	}
+	/* The vector extensions also require the operating system to save
+	 * the vector registers, CPUID.01H:ECX.OSXSAVE[bit 27]
+	 */
+	if( ( ( cpuid_ecx & 0x08000000UL ) == 0 )
+	 || ( __get_cpuid_max(
+	       0,
+	       NULL ) < 7 ) )
+	{
+		return( features );
+	}
+	__asm__ __volatile__ (
+	 "xgetbv"
+	 : "=a" ( extended_control_register_lower ),
+	   "=d" ( extended_control_register_upper )
+	 : "c" ( 0 ) );
+
+	__cpuid_count(
+	 7,
+	 0,
+	 cpuid_eax,
+	 cpuid_ebx,
+	 cpuid_ecx,
+	 cpuid_edx );
+
+	/* AVX2 requires the XMM and YMM registers to be saved
+	 * CPUID.(EAX=07H,ECX=0):EBX.AVX2[bit 5]
+	 */
+	if( ( ( extended_control_register_lower & 0x06 ) == 0x06 )
+	 && ( ( cpuid_ebx & 0x00000020UL ) != 0 ) )
+	{
+		features |= LIBLUKSDE_AESNI_FEATURE_FLAG_AVX2;
+	}
+	/* AVX-512 also requires the opmask and ZMM registers to be saved
+	 * CPUID.(EAX=07H,ECX=0):EBX.AVX512F[bit 16]
+	 */
+	if( ( ( extended_control_register_lower & 0xe6 ) == 0xe6 )
+	 && ( ( cpuid_ebx & 0x00010000UL ) != 0 ) )
+	{
+		features |= LIBLUKSDE_AESNI_FEATURE_FLAG_AVX512;
+	}
+#if defined( HAVE_LIBLUKSDE_VAES_SUPPORT )
+	/* VAES with 512-bit vectors also requires the opmask and ZMM registers to be saved
+	 * CPUID.(EAX=07H,ECX=0):EBX.AVX512F[bit 16]
+	 * CPUID.(EAX=07H,ECX=0):ECX.VAES[bit 9]
+	 */
+	if( ( ( features & LIBLUKSDE_AESNI_FEATURE_FLAG_AES ) != 0 )
+	 && ( ( extended_control_register_lower & 0xe6 ) == 0xe6 )
+	 && ( ( cpuid_ebx & 0x00010000UL ) != 0 )
+	 && ( ( cpuid_ecx & 0x00000200UL ) != 0 ) )
+	{
+		features |= LIBLUKSDE_AESNI_FEATURE_FLAG_VAES;
+	}
+#endif /* defined( HAVE_LIBLUKSDE_VAES_SUPPORT ) */
+
+	return( features );
+#else
+	return( 0 );
+#endif /* defined( HAVE_LIBLUKSDE_AESNI_SUPPORT ) */
+}
+
+#if defined( HAVE_LIBLUKSDE_AESNI_SUPPORT )
+
+/* Applies the S-box to the bytes of a 32-bit word
+ * Returns the substituted word
+ */
+LIBLUKSDE_AESNI_TARGET
+static uint32_t libluksde_aesni_substitute_word(
+                 uint32_t value )
+{
+	__m128i vector = _mm_set_epi32(
+	                  0,
+	                  0,
+	                  (int) value,
+	                  0 );
+
+	/* The lower 32-bit of the result contain SubWord() of the second 32-bit of the input
+	 */
+	vector = _mm_aeskeygenassist_si128(
+	          vector,
+	          0x00 );
+
+	return( (uint32_t) _mm_cvtsi128_si32(
+	                    vector ) );
+}
+
+/* Sets the key of an AES-NI key schedule
+ * Returns 1 if successful or -1 on error
+ */
+LIBLUKSDE_AESNI_TARGET
+int libluksde_aesni_key_schedule_set_key(
+     libluksde_aesni_key_schedule_t *key_schedule,
+     int mode,
+     const uint8_t *key,
+     size_t key_bit_size,
+     libcerror_error_t **error )
+{
+	uint8_t round_keys_data[ 240 ];
+	uint32_t round_key_words[ 60 ];
+
+	static char *function        = "libluksde_aesni_key_schedule_set_key";
+	size_t number_of_key_words   = 0;
+	size_t number_of_round_words = 0;
+	size_t word_index            = 0;
+	uint32_t value_32bit         = 0;
+	int number_of_rounds         = 0;
+	int round_index              = 0;
+
+	if( key_schedule == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key schedule.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( mode != LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT )
+	 && ( mode != LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( key_bit_size != 128 )
+	 && ( key_bit_size != 192 )
+	 && ( key_bit_size != 256 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported key bit size.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_key_words   = key_bit_size / 32;
+	number_of_rounds      = (int) number_of_key_words + 6;
+	number_of_round_words = 4 * ( (size_t) number_of_rounds + 1 );
+
+	for( word_index = 0;
+	     word_index < number_of_key_words;
+	     word_index++ )
+	{
+		byte_stream_copy_to_uint32_little_endian(
+		 &( key[ word_index * 4 ] ),
+		 round_key_words[ word_index ] );
+	}
+	/* Expand the key as described in FIPS-197 where the words are stored
+	 * in little-endian so that RotWord() is a rotate right by 8 bits
+	 */
+	for( word_index = number_of_key_words;
+	     word_index < number_of_round_words;
+	     word_index++ )
+	{
+		value_32bit = round_key_words[ word_index - 1 ];
+
+		if( ( word_index % number_of_key_words ) == 0 )
+		{
+			value_32bit = ( value_32bit >> 8 ) | ( value_32bit << 24 );
+
+			value_32bit = libluksde_aesni_substitute_word(
+			               value_32bit );
+
+			value_32bit ^= libluksde_aesni_round_constants[ ( word_index / number_of_key_words ) - 1 ];
+		}
+		else if( ( number_of_key_words > 6 )
+		      && ( ( word_index % number_of_key_words ) == 4 ) )
+		{
+			value_32bit = libluksde_aesni_substitute_word(
+			               value_32bit );
+		}
+		round_key_words[ word_index ] = round_key_words[ word_index - number_of_key_words ] ^ value_32bit;
+	}
+	for( word_index = 0;
+	     word_index < number_of_round_words;
+	     word_index++ )
+	{
+		byte_stream_copy_from_uint32_little_endian(
+		 &( round_keys_data[ word_index * 4 ] ),
+		 round_key_words[ word_index ] );
+	}
+	if( mode == LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT )
+	{
+		if( memory_copy(
+		     key_schedule->round_keys,
+		     round_keys_data,
+		     number_of_round_words * 4 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy round keys.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else
+	{
+		/* The decryption round keys are the encryption round keys in reverse order
+		 * with InvMixColumns() applied to all but the first and last round key
+		 */
+		for( round_index = 0;
+		     round_index <= number_of_rounds;
+		     round_index++ )
+		{
+			__m128i round_key = _mm_loadu_si128(
+			                     (__m128i *) &( round_keys_data[ ( number_of_rounds - round_index ) * 16 ] ) );
+
+			if( ( round_index > 0 )
+			 && ( round_index < number_of_rounds ) )
+			{
+				round_key = _mm_aesimc_si128(
+				             round_key );
+			}
+			_mm_storeu_si128(
+			 (__m128i *) &( key_schedule->round_keys[ round_index * 16 ] ),
+			 round_key );
+		}
+	}
+	key_schedule->number_of_rounds = number_of_rounds;
+
+	memory_set(
+	 round_key_words,
+	 0,
+	 sizeof( uint32_t ) * 60 );
+
+	memory_set(
+	 round_keys_data,
+	 0,
+	 240 );
+
+	return( 1 );
+
+on_error:
+	memory_set(
+	 round_key_words,
+	 0,
+	 sizeof( uint32_t ) * 60 );
+
+	memory_set(
+	 round_keys_data,
+	 0,
+	 240 );
+
+	return( -1 );
+}
+
+/* Loads the round keys of a key schedule
+ * All 15 round keys are loaded, independent of the number of rounds
+ */
+LIBLUKSDE_AESNI_TARGET
+static inline void libluksde_aesni_load_round_keys(
+                    const libluksde_aesni_key_schedule_t *key_schedule,
+                    __m128i *round_keys )
+{
+	int round_index = 0;
+
+	for( round_index = 0;
+	     round_index < 15;
+	     round_index++ )
+	{
+		round_keys[ round_index ] = _mm_loadu_si128(
+		                             (__m128i *) &( key_schedule->round_keys[ round_index * 16 ] ) );
+	}
+}
+
+/* Encrypts a single block
+ * Returns the encrypted block
+ */
+LIBLUKSDE_AESNI_TARGET
+static inline __m128i libluksde_aesni_encrypt_block(
+                       const __m128i *round_keys,
+                       int number_of_rounds,
+                       __m128i block )
+{
+	int round_index = 0;
+
+	block = _mm_xor_si128(
+	         block,
+	         round_keys[ 0 ] );
+
+	for( round_index = 1;
+	     round_index < number_of_rounds;
+	     round_index++ )
+	{
+		block = _mm_aesenc_si128(
+		         block,
+		         round_keys[ round_index ] );
+	}
+	return( _mm_aesenclast_si128(
+	         block,
+	         round_keys[ number_of_rounds ] ) );
+}
+
+/* Decrypts a single block
+ * Returns the decrypted block
+ */
+LIBLUKSDE_AESNI_TARGET
+static inline __m128i libluksde_aesni_decrypt_block(
+                       const __m128i *round_keys,
+                       int number_of_rounds,
+                       __m128i block )
+{
+	int round_index = 0;
+
+	block = _mm_xor_si128(
+	         block,
+	         round_keys[ 0 ] );
+
+	for( round_index = 1;
+	     round_index < number_of_rounds;
+	     round_index++ )
+	{
+		block = _mm_aesdec_si128(
+		         block,
+		         round_keys[ round_index ] );
+	}
+	return( _mm_aesdeclast_si128(
+	         block,
+	         round_keys[ number_of_rounds ] ) );
+}
+
+/* Encrypts 8 independent blocks, interleaved so that the AES units stay busy
+ */
+LIBLUKSDE_AESNI_TARGET
+static inline void libluksde_aesni_encrypt_8_blocks(
+                    const __m128i *round_keys,
+                    int number_of_rounds,
+                    __m128i *blocks )
+{
+	__m128i round_key = round_keys[ 0 ];
+	int round_index   = 0;
+
+	blocks[ 0 ] = _mm_xor_si128( blocks[ 0 ], round_key );
+	blocks[ 1 ] = _mm_xor_si128( blocks[ 1 ], round_key );
+	blocks[ 2 ] = _mm_xor_si128( blocks[ 2 ], round_key );
+	blocks[ 3 ] = _mm_xor_si128( blocks[ 3 ], round_key );
+	blocks[ 4 ] = _mm_xor_si128( blocks[ 4 ], round_key );
+	blocks[ 5 ] = _mm_xor_si128( blocks[ 5 ], round_key );
+	blocks[ 6 ] = _mm_xor_si128( blocks[ 6 ], round_key );
+	blocks[ 7 ] = _mm_xor_si128( blocks[ 7 ], round_key );
+
+	for( round_index = 1;
+	     round_index < number_of_rounds;
+	     round_index++ )
+	{
+		round_key = round_keys[ round_index ];
+
+		blocks[ 0 ] = _mm_aesenc_si128( blocks[ 0 ], round_key );
+		blocks[ 1 ] = _mm_aesenc_si128( blocks[ 1 ], round_key );
+		blocks[ 2 ] = _mm_aesenc_si128( blocks[ 2 ], round_key );
+		blocks[ 3 ] = _mm_aesenc_si128( blocks[ 3 ], round_key );
+		blocks[ 4 ] = _mm_aesenc_si128( blocks[ 4 ], round_key );
+		blocks[ 5 ] = _mm_aesenc_si128( blocks[ 5 ], round_key );
+		blocks[ 6 ] = _mm_aesenc_si128( blocks[ 6 ], round_key );
+		blocks[ 7 ] = _mm_aesenc_si128( blocks[ 7 ], round_key );
+	}
+	round_key = round_keys[ number_of_rounds ];
+
+	blocks[ 0 ] = _mm_aesenclast_si128( blocks[ 0 ], round_key );
+	blocks[ 1 ] = _mm_aesenclast_si128( blocks[ 1 ], round_key );
+	blocks[ 2 ] = _mm_aesenclast_si128( blocks[ 2 ], round_key );
+	blocks[ 3 ] = _mm_aesenclast_si128( blocks[ 3 ], round_key );
+	blocks[ 4 ] = _mm_aesenclast_si128( blocks[ 4 ], round_key );
+	blocks[ 5 ] = _mm_aesenclast_si128( blocks[ 5 ], round_key );
+	blocks[ 6 ] = _mm_aesenclast_si128( blocks[ 6 ], round_key );
+	blocks[ 7 ] = _mm_aesenclast_si128( blocks[ 7 ], round_key );
+}
+
+/* Decrypts 8 independent blocks, interleaved so that the AES units stay busy
+ */
+LIBLUKSDE_AESNI_TARGET
+static inline void libluksde_aesni_decrypt_8_blocks(
+                    const __m128i *round_keys,
+                    int number_of_rounds,
+                    __m128i *blocks )
+{
+	__m128i round_key = round_keys[ 0 ];
+	int round_index   = 0;
+
+	blocks[ 0 ] = _mm_xor_si128( blocks[ 0 ], round_key );
+	blocks[ 1 ] = _mm_xor_si128( blocks[ 1 ], round_key );
+	blocks[ 2 ] = _mm_xor_si128( blocks[ 2 ], round_key );
+	blocks[ 3 ] = _mm_xor_si128( blocks[ 3 ], round_key );
+	blocks[ 4 ] = _mm_xor_si128( blocks[ 4 ], round_key );
+	blocks[ 5 ] = _mm_xor_si128( blocks[ 5 ], round_key );
+	blocks[ 6 ] = _mm_xor_si128( blocks[ 6 ], round_key );
+	blocks[ 7 ] = _mm_xor_si128( blocks[ 7 ], round_key );
+
+	for( round_index = 1;
+	     round_index < number_of_rounds;
+	     round_index++ )
+	{
+		round_key = round_keys[ round_index ];
+
+		blocks[ 0 ] = _mm_aesdec_si128( blocks[ 0 ], round_key );
+		blocks[ 1 ] = _mm_aesdec_si128( blocks[ 1 ], round_key );
+		blocks[ 2 ] = _mm_aesdec_si128( blocks[ 2 ], round_key );
+		blocks[ 3 ] = _mm_aesdec_si128( blocks[ 3 ], round_key );
+		blocks[ 4 ] = _mm_aesdec_si128( blocks[ 4 ], round_key );
+		blocks[ 5 ] = _mm_aesdec_si128( blocks[ 5 ], round_key );
+		blocks[ 6 ] = _mm_aesdec_si128( blocks[ 6 ], round_key );
+		blocks[ 7 ] = _mm_aesdec_si128( blocks[ 7 ], round_key );
+	}
+	round_key = round_keys[ number_of_rounds ];
+
+	blocks[ 0 ] = _mm_aesdeclast_si128( blocks[ 0 ], round_key );
+	blocks[ 1 ] = _mm_aesdeclast_si128( blocks[ 1 ], round_key );
+	blocks[ 2 ] = _mm_aesdeclast_si128( blocks[ 2 ], round_key );
+	blocks[ 3 ] = _mm_aesdeclast_si128( blocks[ 3 ], round_key );
+	blocks[ 4 ] = _mm_aesdeclast_si128( blocks[ 4 ], round_key );
+	blocks[ 5 ] = _mm_aesdeclast_si128( blocks[ 5 ], round_key );
+	blocks[ 6 ] = _mm_aesdeclast_si128( blocks[ 6 ], round_key );
+	blocks[ 7 ] = _mm_aesdeclast_si128( blocks[ 7 ], round_key );
+}
+
+/* Multiplies a XTS tweak value by alpha (x) in GF(2^128)
+ * Returns the multiplied tweak value
+ */
+LIBLUKSDE_AESNI_TARGET
+static inline __m128i libluksde_aesni_xts_multiply_alpha(
+                       __m128i tweak )
+{
+	__m128i carry = _mm_srai_epi32(
+	                 tweak,
+	                 31 );
+
+	/* The carry of the upper 32-bit is reduced with the polynomial
+	 * x^128 + x^7 + x^2 + x + 1 into the lower 32-bit, the other carries
+	 * move into the next 32-bit
+	 */
+	carry = _mm_and_si128(
+	         carry,
+	         _mm_set_epi32(
+	          0x87,
+	          1,
+	          1,
+	          1 ) );
+
+	carry = _mm_shuffle_epi32(
+	         carry,
+	         0x93 );
+
+	return( _mm_xor_si128(
+	         _mm_slli_epi32(
+	          tweak,
+	          1 ),
+	         carry ) );
+}
+
+#if defined( HAVE_LIBLUKSDE_VAES_SUPPORT )
+
+/* De- or encrypts blocks of data 16 blocks at a time using VAES in ECB mode
+ * Returns the number of bytes processed
+ */
+LIBLUKSDE_VAES_TARGET
+static size_t libluksde_aesni_vaes_crypt_ecb(
+               libluksde_aesni_key_schedule_t *key_schedule,
+               int mode,
+               const uint8_t *input_data,
+               uint8_t *output_data,
+               size_t data_size )
+{
+	__m512i round_keys[ 15 ];
+	__m512i blocks[ 4 ];
+
+	size_t data_offset   = 0;
+	int number_of_rounds = key_schedule->number_of_rounds;
+	int round_index      = 0;
+
+	for( round_index = 0;
+	     round_index <= number_of_rounds;
+	     round_index++ )
+	{
+		round_keys[ round_index ] = _mm512_broadcast_i32x4(
+		                             _mm_loadu_si128(
+		                              (__m128i *) &( key_schedule->round_keys[ round_index * 16 ] ) ) );
+	}
+	while( ( data_offset + 256 ) <= data_size )
+	{
+		blocks[ 0 ] = _mm512_xor_si512( _mm512_loadu_si512( &( input_data[ data_offset ] ) ), round_keys[ 0 ] );
+		blocks[ 1 ] = _mm512_xor_si512( _mm512_loadu_si512( &( input_data[ data_offset + 64 ] ) ), round_keys[ 0 ] );
+		blocks[ 2 ] = _mm512_xor_si512( _mm512_loadu_si512( &( input_data[ data_offset + 128 ] ) ), round_keys[ 0 ] );
+		blocks[ 3 ] = _mm512_xor_si512( _mm512_loadu_si512( &( input_data[ data_offset + 192 ] ) ), round_keys[ 0 ] );
+
+		if( mode == LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT )
+		{
+			for( round_index = 1;
+			     round_index < number_of_rounds;
+			     round_index++ )
+			{
+				blocks[ 0 ] = _mm512_aesenc_epi128( blocks[ 0 ], round_keys[ round_index ] );
+				blocks[ 1 ] = _mm512_aesenc_epi128( blocks[ 1 ], round_keys[ round_index ] );
+				blocks[ 2 ] = _mm512_aesenc_epi128( blocks[ 2 ], round_keys[ round_index ] );
+				blocks[ 3 ] = _mm512_aesenc_epi128( blocks[ 3 ], round_keys[ round_index ] );
+			}
+			blocks[ 0 ] = _mm512_aesenclast_epi128( blocks[ 0 ], round_keys[ number_of_rounds ] );
+			blocks[ 1 ] = _mm512_aesenclast_epi128( blocks[ 1 ], round_keys[ number_of_rounds ] );
+			blocks[ 2 ] = _mm512_aesenclast_epi128( blocks[ 2 ], round_keys[ number_of_rounds ] );
+			blocks[ 3 ] = _mm512_aesenclast_epi128( blocks[ 3 ], round_keys[ number_of_rounds ] );
+		}
+		else
+		{
+			for( round_index = 1;
+			     round_index < number_of_rounds;
+			     round_index++ )
+			{
+				blocks[ 0 ] = _mm512_aesdec_epi128( blocks[ 0 ], round_keys[ round_index ] );
+				blocks[ 1 ] = _mm512_aesdec_epi128( blocks[ 1 ], round_keys[ round_index ] );
+				blocks[ 2 ] = _mm512_aesdec_epi128( blocks[ 2 ], round_keys[ round_index ] );
+				blocks[ 3 ] = _mm512_aesdec_epi128( blocks[ 3 ], round_keys[ round_index ] );
+			}
+			blocks[ 0 ] = _mm512_aesdeclast_epi128( blocks[ 0 ], round_keys[ number_of_rounds ] );
+			blocks[ 1 ] = _mm512_aesdeclast_epi128( blocks[ 1 ], round_keys[ number_of_rounds ] );
+			blocks[ 2 ] = _mm512_aesdeclast_epi128( blocks[ 2 ], round_keys[ number_of_rounds ] );
+			blocks[ 3 ] = _mm512_aesdeclast_epi128( blocks[ 3 ], round_keys[ number_of_rounds ] );
+		}
+		_mm512_storeu_si512( &( output_data[ data_offset ] ), blocks[ 0 ] );
+		_mm512_storeu_si512( &( output_data[ data_offset + 64 ] ), blocks[ 1 ] );
+		_mm512_storeu_si512( &( output_data[ data_offset + 128 ] ), blocks[ 2 ] );
+		_mm512_storeu_si512( &( output_data[ data_offset + 192 ] ), blocks[ 3 ] );
+
+		data_offset += 256;
+	}
+	memory_set(
+	 round_keys,
+	 0,
+	 sizeof( __m512i ) * 15 );
+
+	return( data_offset );
+}
+
+/* Multiplies the 4 XTS tweak values in a vector by alpha^4 in GF(2^128)
+ * Returns the multiplied tweak values
+ */
+LIBLUKSDE_VAES_TARGET
+static inline __m512i libluksde_aesni_vaes_xts_multiply_alpha4(
+                       __m512i tweaks )
+{
+	__m512i carry     = _mm512_srli_epi64(
+	                     tweaks,
+	                     60 );
+	__m512i reduction = _mm512_setzero_si512();
+
+	/* Swap the upper and lower 64-bit of every tweak value, so the carry
+	 * of the lower 64-bit moves into the upper 64-bit and the carry of
+	 * the upper 64-bit is reduced into the lower 64-bit
+	 */
+	carry = _mm512_shuffle_epi32(
+	         carry,
+	         _MM_PERM_BADC );
+
+	reduction = _mm512_maskz_mov_epi64(
+	             0x55,
+	             carry );
+
+	carry = _mm512_maskz_mov_epi64(
+	         0xaa,
+	         carry );
+
+	/* Carry-less multiply the 4-bit carry by 0x87
+	 */
+	reduction = _mm512_xor_si512(
+	             _mm512_xor_si512(
+	              reduction,
+	              _mm512_slli_epi64(
+	               reduction,
+	               1 ) ),
+	             _mm512_xor_si512(
+	              _mm512_slli_epi64(
+	               reduction,
+	               2 ),
+	              _mm512_slli_epi64(
+	               reduction,
+	               7 ) ) );
+
+	return( _mm512_xor_si512(
+	         _mm512_slli_epi64(
+	          tweaks,
+	          4 ),
+	         _mm512_xor_si512(
+	          carry,
+	          reduction ) ) );
+}
+
+/* De- or encrypts blocks of data 16 blocks at a time using VAES in XTS mode
+ * The tweak is updated to the tweak of the first block that was not processed
+ * Returns the number of bytes processed
+ */
+LIBLUKSDE_VAES_TARGET
+static size_t libluksde_aesni_vaes_crypt_xts(
+               libluksde_aesni_key_schedule_t *key_schedule,
+               int mode,
+               __m128i *tweak,
+               const uint8_t *input_data,
+               uint8_t *output_data,
+               size_t data_size )
+{
+	__m512i round_keys[ 15 ];
+	__m512i blocks[ 4 ];
+	__m512i tweaks[ 4 ];
+	__m128i tweak_value  = *tweak;
+
+	size_t data_offset   = 0;
+	int number_of_rounds = key_schedule->number_of_rounds;
+	int round_index      = 0;
+
+	if( data_size < 256 )
+	{
+		return( 0 );
+	}
+	for( round_index = 0;
+	     round_index <= number_of_rounds;
+	     round_index++ )
+	{
+		round_keys[ round_index ] = _mm512_broadcast_i32x4(
+		                             _mm_loadu_si128(
+		                              (__m128i *) &( key_schedule->round_keys[ round_index * 16 ] ) ) );
+	}
+	/* The first vector contains the tweak values of the first 4 blocks
+	 */
+	tweaks[ 0 ] = _mm512_castsi128_si512(
+	               tweak_value );
+
+	tweak_value = libluksde_aesni_xts_multiply_alpha(
+	               tweak_value );
+
+	tweaks[ 0 ] = _mm512_inserti32x4(
+	               tweaks[ 0 ],
+	               tweak_value,
+	               1 );
+
+	tweak_value = libluksde_aesni_xts_multiply_alpha(
+	               tweak_value );
+
+	tweaks[ 0 ] = _mm512_inserti32x4(
+	               tweaks[ 0 ],
+	               tweak_value,
+	               2 );
+
+	tweak_value = libluksde_aesni_xts_multiply_alpha(
+	               tweak_value );
+
+	tweaks[ 0 ] = _mm512_inserti32x4(
+	               tweaks[ 0 ],
+	               tweak_value,
+	               3 );
+
+	tweaks[ 1 ] = libluksde_aesni_vaes_xts_multiply_alpha4(
+	               tweaks[ 0 ] );
+	tweaks[ 2 ] = libluksde_aesni_vaes_xts_multiply_alpha4(
+	               tweaks[ 1 ] );
+	tweaks[ 3 ] = libluksde_aesni_vaes_xts_multiply_alpha4(
+	               tweaks[ 2 ] );
+
+	while( ( data_offset + 256 ) <= data_size )
+	{
+		blocks[ 0 ] = _mm512_xor_si512( _mm512_loadu_si512( &( input_data[ data_offset ] ) ), tweaks[ 0 ] );
+		blocks[ 1 ] = _mm512_xor_si512( _mm512_loadu_si512( &( input_data[ data_offset + 64 ] ) ), tweaks[ 1 ] );
+		blocks[ 2 ] = _mm512_xor_si512( _mm512_loadu_si512( &( input_data[ data_offset + 128 ] ) ), tweaks[ 2 ] );
+		blocks[ 3 ] = _mm512_xor_si512( _mm512_loadu_si512( &( input_data[ data_offset + 192 ] ) ), tweaks[ 3 ] );
+
+		blocks[ 0 ] = _mm512_xor_si512( blocks[ 0 ], round_keys[ 0 ] );
+		blocks[ 1 ] = _mm512_xor_si512( blocks[ 1 ], round_keys[ 0 ] );
+		blocks[ 2 ] = _mm512_xor_si512( blocks[ 2 ], round_keys[ 0 ] );
+		blocks[ 3 ] = _mm512_xor_si512( blocks[ 3 ], round_keys[ 0 ] );
+
+		if( mode == LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT )
+		{
+			for( round_index = 1;
+			     round_index < number_of_rounds;
+			     round_index++ )
+			{
+				blocks[ 0 ] = _mm512_aesenc_epi128( blocks[ 0 ], round_keys[ round_index ] );
+				blocks[ 1 ] = _mm512_aesenc_epi128( blocks[ 1 ], round_keys[ round_index ] );
+				blocks[ 2 ] = _mm512_aesenc_epi128( blocks[ 2 ], round_keys[ round_index ] );
+				blocks[ 3 ] = _mm512_aesenc_epi128( blocks[ 3 ], round_keys[ round_index ] );
+			}
+			blocks[ 0 ] = _mm512_aesenclast_epi128( blocks[ 0 ], round_keys[ number_of_rounds ] );
+			blocks[ 1 ] = _mm512_aesenclast_epi128( blocks[ 1 ], round_keys[ number_of_rounds ] );
+			blocks[ 2 ] = _mm512_aesenclast_epi128( blocks[ 2 ], round_keys[ number_of_rounds ] );
+			blocks[ 3 ] = _mm512_aesenclast_epi128( blocks[ 3 ], round_keys[ number_of_rounds ] );
+		}
+		else
+		{
+			for( round_index = 1;
+			     round_index < number_of_rounds;
+			     round_index++ )
+			{
+				blocks[ 0 ] = _mm512_aesdec_epi128( blocks[ 0 ], round_keys[ round_index ] );
+				blocks[ 1 ] = _mm512_aesdec_epi128( blocks[ 1 ], round_keys[ round_index ] );
+				blocks[ 2 ] = _mm512_aesdec_epi128( blocks[ 2 ], round_keys[ round_index ] );
+				blocks[ 3 ] = _mm512_aesdec_epi128( blocks[ 3 ], round_keys[ round_index ] );
+			}
+			blocks[ 0 ] = _mm512_aesdeclast_epi128( blocks[ 0 ], round_keys[ number_of_rounds ] );
+			blocks[ 1 ] = _mm512_aesdeclast_epi128( blocks[ 1 ], round_keys[ number_of_rounds ] );
+			blocks[ 2 ] = _mm512_aesdeclast_epi128( blocks[ 2 ], round_keys[ number_of_rounds ] );
+			blocks[ 3 ] = _mm512_aesdeclast_epi128( blocks[ 3 ], round_keys[ number_of_rounds ] );
+		}
+		_mm512_storeu_si512( &( output_data[ data_offset ] ), _mm512_xor_si512( blocks[ 0 ], tweaks[ 0 ] ) );
+		_mm512_storeu_si512( &( output_data[ data_offset + 64 ] ), _mm512_xor_si512( blocks[ 1 ], tweaks[ 1 ] ) );
+		_mm512_storeu_si512( &( output_data[ data_offset + 128 ] ), _mm512_xor_si512( blocks[ 2 ], tweaks[ 2 ] ) );
+		_mm512_storeu_si512( &( output_data[ data_offset + 192 ] ), _mm512_xor_si512( blocks[ 3 ], tweaks[ 3 ] ) );
+
+		tweaks[ 0 ] = libluksde_aesni_vaes_xts_multiply_alpha4(
+		               tweaks[ 3 ] );
+		tweaks[ 1 ] = libluksde_aesni_vaes_xts_multiply_alpha4(
+		               tweaks[ 0 ] );
+		tweaks[ 2 ] = libluksde_aesni_vaes_xts_multiply_alpha4(
+		               tweaks[ 1 ] );
+		tweaks[ 3 ] = libluksde_aesni_vaes_xts_multiply_alpha4(
+		               tweaks[ 2 ] );
+
+		data_offset += 256;
+	}
+	*tweak = _mm512_castsi512_si128(
+	          tweaks[ 0 ] );
+
+	memory_set(
+	 round_keys,
+	 0,
+	 sizeof( __m512i ) * 15 );
+
+	return( data_offset );
+}
+
+/* Decrypts blocks of data 16 blocks at a time using VAES in CBC mode
+ * The previous block is updated to the last cipher text block that was processed
+ * Returns the number of bytes processed
+ */
+LIBLUKSDE_VAES_TARGET
+static size_t libluksde_aesni_vaes_decrypt_cbc(
+               libluksde_aesni_key_schedule_t *key_schedule,
+               __m128i *previous_block,
+               const uint8_t *input_data,
+               uint8_t *output_data,
+               size_t data_size )
+{
+	__m512i blocks[ 4 ];
+	__m512i cipher_text_blocks[ 4 ];
+	__m512i round_keys[ 15 ];
+
+	__m512i previous_blocks = _mm512_setzero_si512();
+	size_t data_offset      = 0;
+	int number_of_rounds    = key_schedule->number_of_rounds;
+	int round_index         = 0;
+
+	if( data_size < 256 )
+	{
+		return( 0 );
+	}
+	for( round_index = 0;
+	     round_index <= number_of_rounds;
+	     round_index++ )
+	{
+		round_keys[ round_index ] = _mm512_broadcast_i32x4(
+		                             _mm_loadu_si128(
+		                              (__m128i *) &( key_schedule->round_keys[ round_index * 16 ] ) ) );
+	}
+	/* The previous cipher text block is kept in the last 128-bit of the vector
+	 */
+	previous_blocks = _mm512_inserti32x4(
+	                   previous_blocks,
+	                   *previous_block,
+	                   3 );
+
+	while( ( data_offset + 256 ) <= data_size )
+	{
+		cipher_text_blocks[ 0 ] = _mm512_loadu_si512( &( input_data[ data_offset ] ) );
+		cipher_text_blocks[ 1 ] = _mm512_loadu_si512( &( input_data[ data_offset + 64 ] ) );
+		cipher_text_blocks[ 2 ] = _mm512_loadu_si512( &( input_data[ data_offset + 128 ] ) );
+		cipher_text_blocks[ 3 ] = _mm512_loadu_si512( &( input_data[ data_offset + 192 ] ) );
+
+		blocks[ 0 ] = _mm512_xor_si512( cipher_text_blocks[ 0 ], round_keys[ 0 ] );
+		blocks[ 1 ] = _mm512_xor_si512( cipher_text_blocks[ 1 ], round_keys[ 0 ] );
+		blocks[ 2 ] = _mm512_xor_si512( cipher_text_blocks[ 2 ], round_keys[ 0 ] );
+		blocks[ 3 ] = _mm512_xor_si512( cipher_text_blocks[ 3 ], round_keys[ 0 ] );
+
+		for( round_index = 1;
+		     round_index < number_of_rounds;
+		     round_index++ )
+		{
+			blocks[ 0 ] = _mm512_aesdec_epi128( blocks[ 0 ], round_keys[ round_index ] );
+			blocks[ 1 ] = _mm512_aesdec_epi128( blocks[ 1 ], round_keys[ round_index ] );
+			blocks[ 2 ] = _mm512_aesdec_epi128( blocks[ 2 ], round_keys[ round_index ] );
+			blocks[ 3 ] = _mm512_aesdec_epi128( blocks[ 3 ], round_keys[ round_index ] );
+		}
+		blocks[ 0 ] = _mm512_aesdeclast_epi128( blocks[ 0 ], round_keys[ number_of_rounds ] );
+		blocks[ 1 ] = _mm512_aesdeclast_epi128( blocks[ 1 ], round_keys[ number_of_rounds ] );
+		blocks[ 2 ] = _mm512_aesdeclast_epi128( blocks[ 2 ], round_keys[ number_of_rounds ] );
+		blocks[ 3 ] = _mm512_aesdeclast_epi128( blocks[ 3 ], round_keys[ number_of_rounds ] );
+
+		/* Every block is XOR-ed with the preceding cipher text block, which is
+		 * the cipher text shifted by 128-bit. The cipher text is kept in registers
+		 * so that the data can be decrypted in place
+		 */
+		blocks[ 0 ] = _mm512_xor_si512( blocks[ 0 ], _mm512_alignr_epi64( cipher_text_blocks[ 0 ], previous_blocks, 6 ) );
+		blocks[ 1 ] = _mm512_xor_si512( blocks[ 1 ], _mm512_alignr_epi64( cipher_text_blocks[ 1 ], cipher_text_blocks[ 0 ], 6 ) );
+		blocks[ 2 ] = _mm512_xor_si512( blocks[ 2 ], _mm512_alignr_epi64( cipher_text_blocks[ 2 ], cipher_text_blocks[ 1 ], 6 ) );
+		blocks[ 3 ] = _mm512_xor_si512( blocks[ 3 ], _mm512_alignr_epi64( cipher_text_blocks[ 3 ], cipher_text_blocks[ 2 ], 6 ) );
+
+		_mm512_storeu_si512( &( output_data[ data_offset ] ), blocks[ 0 ] );
+		_mm512_storeu_si512( &( output_data[ data_offset + 64 ] ), blocks[ 1 ] );
+		_mm512_storeu_si512( &( output_data[ data_offset + 128 ] ), blocks[ 2 ] );
+		_mm512_storeu_si512( &( output_data[ data_offset + 192 ] ), blocks[ 3 ] );
+
+		previous_blocks = cipher_text_blocks[ 3 ];
+
+		data_offset += 256;
+	}
+	*previous_block = _mm512_extracti32x4_epi32(
+	                   previous_blocks,
+	                   3 );
+
+	memory_set(
+	 round_keys,
+	 0,
+	 sizeof( __m512i ) * 15 );
+
+	return( data_offset );
+}
+
+#endif /* defined( HAVE_LIBLUKSDE_VAES_SUPPORT ) */
+
+/* De- or encrypts one or more sectors of data using AES-NI in CBC mode
+ * Every sector is chained separately starting with its own 16-byte initialization vector
+ * Encryption is sequential, decryption is done for multiple blocks in parallel
+ * Returns 1 if successful or -1 on error
+ */
+LIBLUKSDE_AESNI_TARGET
+int libluksde_aesni_crypt_cbc(
+     libluksde_aesni_key_schedule_t *key_schedule,
+     int mode,
+     uint8_t use_vaes,
+     const uint8_t *initialization_vectors,
+     size_t initialization_vectors_size,
+     size_t sector_size,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error )
+{
+	__m128i blocks[ 8 ];
+	__m128i cipher_text_blocks[ 8 ];
+	__m128i round_keys[ 15 ];
+
+	__m128i block                       = _mm_setzero_si128();
+	__m128i previous_block              = _mm_setzero_si128();
+	static char *function               = "libluksde_aesni_crypt_cbc";
+	size_t block_index                  = 0;
+	size_t data_offset                  = 0;
+	size_t initialization_vector_offset = 0;
+	size_t sector_end_offset            = 0;
+	int number_of_rounds                = 0;
+
+	if( key_schedule == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key schedule.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( mode != LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT )
+	 && ( mode != LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( initialization_vectors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid initialization vectors.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( sector_size == 0 )
+	 || ( sector_size > (size_t) SSIZE_MAX )
+	 || ( ( sector_size % 16 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid sector size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( input_data_size > (size_t) SSIZE_MAX )
+	 || ( ( input_data_size % 16 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid input data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( input_data_size % sector_size ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid input data size value not a multitude of sector size.",
+		 function );
+
+		return( -1 );
+	}
+	if( initialization_vectors_size < ( ( input_data_size / sector_size ) * 16 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: initialization vectors size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output data.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data_size < input_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: output data size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	/* The round keys are loaded once for all the sectors
+	 */
+	number_of_rounds = key_schedule->number_of_rounds;
+
+	libluksde_aesni_load_round_keys(
+	 key_schedule,
+	 round_keys );
+
+	while( data_offset < input_data_size )
+	{
+		previous_block = _mm_loadu_si128(
+		                  (__m128i *) &( initialization_vectors[ initialization_vector_offset ] ) );
+
+		initialization_vector_offset += 16;
+		sector_end_offset             = data_offset + sector_size;
+
+		if( mode == LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT )
+		{
+			while( data_offset < sector_end_offset )
+			{
+				block = _mm_xor_si128(
+				         _mm_loadu_si128(
+				          (__m128i *) &( input_data[ data_offset ] ) ),
+				         previous_block );
+
+				previous_block = libluksde_aesni_encrypt_block(
+				                  round_keys,
+				                  number_of_rounds,
+				                  block );
+
+				_mm_storeu_si128(
+				 (__m128i *) &( output_data[ data_offset ] ),
+				 previous_block );
+
+				data_offset += 16;
+			}
+		}
+		else
+		{
+#if defined( HAVE_LIBLUKSDE_VAES_SUPPORT )
+			if( use_vaes != 0 )
+			{
+				data_offset += libluksde_aesni_vaes_decrypt_cbc(
+				                key_schedule,
+				                &previous_block,
+				                &( input_data[ data_offset ] ),
+				                &( output_data[ data_offset ] ),
+				                sector_size );
+			}
+#endif
+			/* Every plain text block only depends on 2 cipher text blocks, so multiple
+			 * blocks are decrypted in parallel and XOR-ed with the preceding cipher
+			 * text block afterwards
+			 */
+			while( ( data_offset + 128 ) <= sector_end_offset )
+			{
+				for( block_index = 0;
+				     block_index < 8;
+				     block_index++ )
+				{
+					cipher_text_blocks[ block_index ] = _mm_loadu_si128(
+					                                     (__m128i *) &( input_data[ data_offset + ( block_index * 16 ) ] ) );
+
+					blocks[ block_index ] = cipher_text_blocks[ block_index ];
+				}
+				libluksde_aesni_decrypt_8_blocks(
+				 round_keys,
+				 number_of_rounds,
+				 blocks );
+
+				_mm_storeu_si128(
+				 (__m128i *) &( output_data[ data_offset ] ),
+				 _mm_xor_si128(
+				  blocks[ 0 ],
+				  previous_block ) );
+
+				for( block_index = 1;
+				     block_index < 8;
+				     block_index++ )
+				{
+					_mm_storeu_si128(
+					 (__m128i *) &( output_data[ data_offset + ( block_index * 16 ) ] ),
+					 _mm_xor_si128(
+					  blocks[ block_index ],
+					  cipher_text_blocks[ block_index - 1 ] ) );
+				}
+				previous_block = cipher_text_blocks[ 7 ];
+
+				data_offset += 128;
+			}
+			while( data_offset < sector_end_offset )
+			{
+				block = _mm_loadu_si128(
+				         (__m128i *) &( input_data[ data_offset ] ) );
+
+				_mm_storeu_si128(
+				 (__m128i *) &( output_data[ data_offset ] ),
+				 _mm_xor_si128(
+				  libluksde_aesni_decrypt_block(
+				   round_keys,
+				   number_of_rounds,
+				   block ),
+				  previous_block ) );
+
+				previous_block = block;
+
+				data_offset += 16;
+			}
+		}
+	}
+	memory_set(
+	 round_keys,
+	 0,
+	 sizeof( __m128i ) * 15 );
+
+	return( 1 );
+}
+
+/* De- or encrypts a block of data using AES-NI in ECB mode
+ * Returns 1 if successful or -1 on error
+ */
+LIBLUKSDE_AESNI_TARGET
+int libluksde_aesni_crypt_ecb(
+     libluksde_aesni_key_schedule_t *key_schedule,
+     int mode,
+     uint8_t use_vaes,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error )
+{
+	__m128i blocks[ 8 ];
+	__m128i round_keys[ 15 ];
+
+	static char *function = "libluksde_aesni_crypt_ecb";
+	size_t block_index    = 0;
+	size_t data_offset    = 0;
+	int number_of_rounds  = 0;
+
+	if( key_schedule == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key schedule.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( mode != LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT )
+	 && ( mode != LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( input_data_size > (size_t) SSIZE_MAX )
+	 || ( ( input_data_size % 16 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid input data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output data.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data_size < input_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: output data size value too small.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBLUKSDE_VAES_SUPPORT )
+	if( use_vaes != 0 )
+	{
+		data_offset = libluksde_aesni_vaes_crypt_ecb(
+		               key_schedule,
+		               mode,
+		               input_data,
+		               output_data,
+		               input_data_size );
+	}
+#endif
+	number_of_rounds = key_schedule->number_of_rounds;
+
+	libluksde_aesni_load_round_keys(
+	 key_schedule,
+	 round_keys );
+
+	while( ( data_offset + 128 ) <= input_data_size )
+	{
+		for( block_index = 0;
+		     block_index < 8;
+		     block_index++ )
+		{
+			blocks[ block_index ] = _mm_loadu_si128(
+			                         (__m128i *) &( input_data[ data_offset + ( block_index * 16 ) ] ) );
+		}
+		if( mode == LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT )
+		{
+			libluksde_aesni_encrypt_8_blocks(
+			 round_keys,
+			 number_of_rounds,
+			 blocks );
+		}
+		else
+		{
+			libluksde_aesni_decrypt_8_blocks(
+			 round_keys,
+			 number_of_rounds,
+			 blocks );
+		}
+		for( block_index = 0;
+		     block_index < 8;
+		     block_index++ )
+		{
+			_mm_storeu_si128(
+			 (__m128i *) &( output_data[ data_offset + ( block_index * 16 ) ] ),
+			 blocks[ block_index ] );
+		}
+		data_offset += 128;
+	}
+	while( data_offset < input_data_size )
+	{
+		blocks[ 0 ] = _mm_loadu_si128(
+		               (__m128i *) &( input_data[ data_offset ] ) );
+
+		if( mode == LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT )
+		{
+			blocks[ 0 ] = libluksde_aesni_encrypt_block(
+			               round_keys,
+			               number_of_rounds,
+			               blocks[ 0 ] );
+		}
+		else
+		{
+			blocks[ 0 ] = libluksde_aesni_decrypt_block(
+			               round_keys,
+			               number_of_rounds,
+			               blocks[ 0 ] );
+		}
+		_mm_storeu_si128(
+		 (__m128i *) &( output_data[ data_offset ] ),
+		 blocks[ 0 ] );
+
+		data_offset += 16;
+	}
+	memory_set(
+	 round_keys,
+	 0,
+	 sizeof( __m128i ) * 15 );
+
+	return( 1 );
+}
+
+/* De- or encrypts one or more sectors of data using AES-NI in XTS mode
+ * Every sector has its own 16-byte tweak value, which is encrypted once and multiplied
+ * by alpha for every subsequent 16-byte block
+ * Returns 1 if successful or -1 on error
+ */
+LIBLUKSDE_AESNI_TARGET
+int libluksde_aesni_crypt_xts(
+     libluksde_aesni_key_schedule_t *key_schedule,
+     libluksde_aesni_key_schedule_t *tweak_key_schedule,
+     int mode,
+     uint8_t use_vaes,
+     const uint8_t *tweak_values,
+     size_t tweak_values_size,
+     size_t sector_size,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error )
+{
+	__m128i blocks[ 8 ];
+	__m128i encrypted_tweak_values[ 8 ];
+	__m128i round_keys[ 15 ];
+	__m128i tweak_round_keys[ 15 ];
+	__m128i tweaks[ 8 ];
+
+	__m128i tweak             = _mm_setzero_si128();
+	static char *function     = "libluksde_aesni_crypt_xts";
+	size_t block_index        = 0;
+	size_t data_offset        = 0;
+	size_t number_of_sectors  = 0;
+	size_t sector_end_offset  = 0;
+	size_t sector_index       = 0;
+	size_t tweak_index        = 0;
+	size_t tweak_value_offset = 0;
+	int number_of_rounds      = 0;
+
+	if( key_schedule == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key schedule.",
+		 function );
+
+		return( -1 );
+	}
+	if( tweak_key_schedule == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tweak key schedule.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( mode != LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT )
+	 && ( mode != LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( tweak_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tweak values.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( sector_size == 0 )
+	 || ( sector_size > (size_t) SSIZE_MAX )
+	 || ( ( sector_size % 16 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid sector size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( input_data_size > (size_t) SSIZE_MAX )
+	 || ( ( input_data_size % 16 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid input data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( input_data_size % sector_size ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid input data size value not a multitude of sector size.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_sectors = input_data_size / sector_size;
+
+	if( tweak_values_size < ( number_of_sectors * 16 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: tweak values size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output data.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data_size < input_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: output data size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	/* The round keys of both the tweak and data keys are loaded once for all the sectors
+	 */
+	libluksde_aesni_load_round_keys(
+	 tweak_key_schedule,
+	 tweak_round_keys );
+
+	number_of_rounds = key_schedule->number_of_rounds;
+
+	libluksde_aesni_load_round_keys(
+	 key_schedule,
+	 round_keys );
+
+	while( sector_index < number_of_sectors )
+	{
+		/* The tweak values of up to 8 sectors are encrypted in parallel
+		 */
+		tweak_index = sector_index % 8;
+
+		if( tweak_index == 0 )
+		{
+			if( ( number_of_sectors - sector_index ) >= 8 )
+			{
+				for( block_index = 0;
+				     block_index < 8;
+				     block_index++ )
+				{
+					encrypted_tweak_values[ block_index ] = _mm_loadu_si128(
+					                                         (__m128i *) &( tweak_values[ tweak_value_offset + ( block_index * 16 ) ] ) );
+				}
+				libluksde_aesni_encrypt_8_blocks(
+				 tweak_round_keys,
+				 tweak_key_schedule->number_of_rounds,
+				 encrypted_tweak_values );
+			}
+			else
+			{
+				for( block_index = 0;
+				     block_index < ( number_of_sectors - sector_index );
+				     block_index++ )
+				{
+					encrypted_tweak_values[ block_index ] = libluksde_aesni_encrypt_block(
+					                                         tweak_round_keys,
+					                                         tweak_key_schedule->number_of_rounds,
+					                                         _mm_loadu_si128(
+					                                          (__m128i *) &( tweak_values[ tweak_value_offset + ( block_index * 16 ) ] ) ) );
+				}
+			}
+			tweak_value_offset += 128;
+		}
+		tweak             = encrypted_tweak_values[ tweak_index ];
+		sector_end_offset = data_offset + sector_size;
+
+#if defined( HAVE_LIBLUKSDE_VAES_SUPPORT )
+		if( use_vaes != 0 )
+		{
+			data_offset += libluksde_aesni_vaes_crypt_xts(
+			                key_schedule,
+			                mode,
+			                &tweak,
+			                &( input_data[ data_offset ] ),
+			                &( output_data[ data_offset ] ),
+			                sector_size );
+		}
+#endif
+		while( ( data_offset + 128 ) <= sector_end_offset )
+		{
+			for( block_index = 0;
+			     block_index < 8;
+			     block_index++ )
+			{
+				tweaks[ block_index ] = tweak;
+
+				blocks[ block_index ] = _mm_xor_si128(
+				                         _mm_loadu_si128(
+				                          (__m128i *) &( input_data[ data_offset + ( block_index * 16 ) ] ) ),
+				                         tweak );
+
+				tweak = libluksde_aesni_xts_multiply_alpha(
+				         tweak );
+			}
+			if( mode == LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT )
+			{
+				libluksde_aesni_encrypt_8_blocks(
+				 round_keys,
+				 number_of_rounds,
+				 blocks );
+			}
+			else
+			{
+				libluksde_aesni_decrypt_8_blocks(
+				 round_keys,
+				 number_of_rounds,
+				 blocks );
+			}
+			for( block_index = 0;
+			     block_index < 8;
+			     block_index++ )
+			{
+				_mm_storeu_si128(
+				 (__m128i *) &( output_data[ data_offset + ( block_index * 16 ) ] ),
+				 _mm_xor_si128(
+				  blocks[ block_index ],
+				  tweaks[ block_index ] ) );
+			}
+			data_offset += 128;
+		}
+		while( data_offset < sector_end_offset )
+		{
+			blocks[ 0 ] = _mm_xor_si128(
+			               _mm_loadu_si128(
+			                (__m128i *) &( input_data[ data_offset ] ) ),
+			               tweak );
+
+			if( mode == LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT )
+			{
+				blocks[ 0 ] = libluksde_aesni_encrypt_block(
+				               round_keys,
+				               number_of_rounds,
+				               blocks[ 0 ] );
+			}
+			else
+			{
+				blocks[ 0 ] = libluksde_aesni_decrypt_block(
+				               round_keys,
+				               number_of_rounds,
+				               blocks[ 0 ] );
+			}
+			_mm_storeu_si128(
+			 (__m128i *) &( output_data[ data_offset ] ),
+			 _mm_xor_si128(
+			  blocks[ 0 ],
+			  tweak ) );
+
+			tweak = libluksde_aesni_xts_multiply_alpha(
+			         tweak );
+
+			data_offset += 16;
+		}
+		sector_index++;
+	}
+	memory_set(
+	 round_keys,
+	 0,
+	 sizeof( __m128i ) * 15 );
+
+	memory_set(
+	 tweak_round_keys,
+	 0,
+	 sizeof( __m128i ) * 15 );
+
+	memory_set(
+	 encrypted_tweak_values,
+	 0,
+	 sizeof( __m128i ) * 8 );
+
+	return( 1 );
+}
+
+#endif /* defined( HAVE_LIBLUKSDE_AESNI_SUPPORT ) */
+
@@ -0,0 +1,128 @@
+/*
+ * AES-NI and VAES functions
+ *
+ * Copyright (C) 2013-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBLUKSDE_AESNI_H )
+#define _LIBLUKSDE_AESNI_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libluksde_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The AES-NI functions require a compiler that supports function specific
+ * target attributes, so that the rest of the library does not need to be
+ * built for a specific CPU
+ */
+#if ( ( defined( __GNUC__ ) && ( __GNUC__ >= 5 ) ) || defined( __clang__ ) ) && defined( __x86_64__ )
+#define HAVE_LIBLUKSDE_AESNI_SUPPORT
+
+#if ( defined( __GNUC__ ) && ( __GNUC__ >= 8 ) ) || ( defined( __clang__ ) && ( __clang_major__ >= 6 ) )
+#define HAVE_LIBLUKSDE_VAES_SUPPORT
+#endif
+
+/* AVX2 is used by the ciphers that have no dedicated instructions
+ */
+#define HAVE_LIBLUKSDE_AVX2_SUPPORT
+
+#endif
+
+enum LIBLUKSDE_AESNI_FEATURE_FLAGS
+{
+	LIBLUKSDE_AESNI_FEATURE_FLAG_AES		= 0x01,
+	LIBLUKSDE_AESNI_FEATURE_FLAG_VAES		= 0x02,
+	LIBLUKSDE_AESNI_FEATURE_FLAG_AVX2		= 0x04,
+	LIBLUKSDE_AESNI_FEATURE_FLAG_AVX512		= 0x08
+};
+
+typedef struct libluksde_aesni_key_schedule libluksde_aesni_key_schedule_t;
+
+struct libluksde_aesni_key_schedule
+{
+	/* The round keys
+	 */
+	uint8_t round_keys[ 240 ];
+
+	/* The number of rounds
+	 */
+	int number_of_rounds;
+};
+
+int libluksde_aesni_get_features(
+     void );
+
+#if defined( HAVE_LIBLUKSDE_AESNI_SUPPORT )
+
+int libluksde_aesni_key_schedule_set_key(
+     libluksde_aesni_key_schedule_t *key_schedule,
+     int mode,
+     const uint8_t *key,
+     size_t key_bit_size,
+     libcerror_error_t **error );
+
+int libluksde_aesni_crypt_cbc(
+     libluksde_aesni_key_schedule_t *key_schedule,
+     int mode,
+     uint8_t use_vaes,
+     const uint8_t *initialization_vectors,
+     size_t initialization_vectors_size,
+     size_t sector_size,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error );
+
+int libluksde_aesni_crypt_ecb(
+     libluksde_aesni_key_schedule_t *key_schedule,
+     int mode,
+     uint8_t use_vaes,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error );
+
+int libluksde_aesni_crypt_xts(
+     libluksde_aesni_key_schedule_t *key_schedule,
+     libluksde_aesni_key_schedule_t *tweak_key_schedule,
+     int mode,
+     uint8_t use_vaes,
+     const uint8_t *tweak_values,
+     size_t tweak_values_size,
+     size_t sector_size,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBLUKSDE_AESNI_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBLUKSDE_AESNI_H ) */
+
@@ -0,0 +1,823 @@
+/*
+ * Linux kernel crypto API (AF_ALG) functions
+ *
+ * Copyright (C) 2013-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* vmsplice and splice are GNU extensions
+ */
+#if !defined( _GNU_SOURCE )
+#define _GNU_SOURCE
+#endif
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#include "libluksde_af_alg.h"
+#include "libluksde_definitions.h"
+#include "libluksde_encryption.h"
+#include "libluksde_libcerror.h"
+
+#if defined( HAVE_LIBLUKSDE_AF_ALG_SUPPORT )
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <linux/if_alg.h>
+
+#if !defined( AF_ALG )
+#define AF_ALG		38
+#endif
+
+#if !defined( SOL_ALG )
+#define SOL_ALG		279
+#endif
+
+/* Creates a context
+ * Make sure the value context is referencing, is set to NULL
+ * Returns 1 if successful, 0 if the kernel does not provide the algorithm or -1 on error
+ */
+int libluksde_af_alg_context_initialize(
+     libluksde_af_alg_context_t **context,
+     int method,
+     int chaining_mode,
+     libcerror_error_t **error )
+{
+	struct sockaddr_alg socket_address;
+
+	static char *function     = "libluksde_af_alg_context_initialize";
+	const char *chaining_name = NULL;
+	const char *cipher_name   = NULL;
+	size_t block_size         = 16;
+	int print_count           = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *context != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid context value already set.",
+		 function );
+
+		return( -1 );
+	}
+	switch( method )
+	{
+		case LIBLUKSDE_ENCRYPTION_METHOD_AES:
+			cipher_name = "aes";
+			break;
+
+		case LIBLUKSDE_ENCRYPTION_METHOD_BLOWFISH:
+			cipher_name = "blowfish";
+			block_size  = 8;
+			break;
+
+		case LIBLUKSDE_ENCRYPTION_METHOD_CAST5:
+			cipher_name = "cast5";
+			block_size  = 8;
+			break;
+
+		case LIBLUKSDE_ENCRYPTION_METHOD_CAST6:
+			cipher_name = "cast6";
+			break;
+
+		case LIBLUKSDE_ENCRYPTION_METHOD_SERPENT:
+			cipher_name = "serpent";
+			break;
+
+		case LIBLUKSDE_ENCRYPTION_METHOD_TWOFISH:
+			cipher_name = "twofish";
+			break;
+
+		default:
+			return( 0 );
+	}
+	switch( chaining_mode )
+	{
+		case LIBLUKSDE_ENCRYPTION_CHAINING_MODE_CBC:
+			chaining_name = "cbc";
+			break;
+
+		case LIBLUKSDE_ENCRYPTION_CHAINING_MODE_ECB:
+			chaining_name = "ecb";
+			block_size    = 0;
+			break;
+
+		case LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS:
+			if( block_size != 16 )
+			{
+				return( 0 );
+			}
+			chaining_name = "xts";
+			break;
+
+		default:
+			return( 0 );
+	}
+	if( memory_set(
+	     &socket_address,
+	     0,
+	     sizeof( struct sockaddr_alg ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear socket address.",
+		 function );
+
+		return( -1 );
+	}
+	socket_address.salg_family = AF_ALG;
+
+	if( narrow_string_copy(
+	     (char *) socket_address.salg_type,
+	     "skcipher",
+	     9 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy socket address type.",
+		 function );
+
+		return( -1 );
+	}
+	print_count = narrow_string_snprintf(
+	               (char *) socket_address.salg_name,
+	               sizeof( socket_address.salg_name ),
+	               "%s(%s)",
+	               chaining_name,
+	               cipher_name );
+
+	if( ( print_count < 0 )
+	 || ( (size_t) print_count >= sizeof( socket_address.salg_name ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set socket address name.",
+		 function );
+
+		return( -1 );
+	}
+	*context = memory_allocate_structure(
+	            libluksde_af_alg_context_t );
+
+	if( *context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create context.",
+		 function );
+
+		goto on_error;
+	}
+	( *context )->algorithm_socket           = -1;
+	( *context )->operation_socket           = -1;
+	( *context )->pipe_descriptors[ 0 ]      = -1;
+	( *context )->pipe_descriptors[ 1 ]      = -1;
+	( *context )->initialization_vector_size = block_size;
+
+	/* The kernel does not support AF_ALG or does not provide the algorithm
+	 */
+	( *context )->algorithm_socket = socket(
+	                                  AF_ALG,
+	                                  SOCK_SEQPACKET | SOCK_CLOEXEC,
+	                                  0 );
+
+	if( ( *context )->algorithm_socket == -1 )
+	{
+		goto on_unsupported;
+	}
+	if( bind(
+	     ( *context )->algorithm_socket,
+	     (struct sockaddr *) &socket_address,
+	     sizeof( struct sockaddr_alg ) ) != 0 )
+	{
+		goto on_unsupported;
+	}
+	if( pipe2(
+	     ( *context )->pipe_descriptors,
+	     O_CLOEXEC ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to create pipe.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_unsupported:
+	libluksde_af_alg_context_free(
+	 context,
+	 NULL );
+
+	return( 0 );
+
+on_error:
+	if( *context != NULL )
+	{
+		libluksde_af_alg_context_free(
+		 context,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a context
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_af_alg_context_free(
+     libluksde_af_alg_context_t **context,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_af_alg_context_free";
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *context != NULL )
+	{
+		/* The key is kept by the kernel and released when the algorithm socket is closed
+		 */
+		if( ( *context )->operation_socket != -1 )
+		{
+			close(
+			 ( *context )->operation_socket );
+		}
+		if( ( *context )->algorithm_socket != -1 )
+		{
+			close(
+			 ( *context )->algorithm_socket );
+		}
+		if( ( *context )->pipe_descriptors[ 0 ] != -1 )
+		{
+			close(
+			 ( *context )->pipe_descriptors[ 0 ] );
+		}
+		if( ( *context )->pipe_descriptors[ 1 ] != -1 )
+		{
+			close(
+			 ( *context )->pipe_descriptors[ 1 ] );
+		}
+		memory_free(
+		 *context );
+
+		*context = NULL;
+	}
+	return( 1 );
+}
+
+/* Sets the key
+ * The key of XTS contains both the data and the tweak key
+ * Returns 1 if successful, 0 if the kernel rejected the key or -1 on error
+ */
+int libluksde_af_alg_context_set_key(
+     libluksde_af_alg_context_t *context,
+     const uint8_t *key,
+     size_t key_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_af_alg_context_set_key";
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( context->algorithm_socket == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid context - missing algorithm socket.",
+		 function );
+
+		return( -1 );
+	}
+	if( key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( key_size == 0 )
+	 || ( key_size > 128 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid key size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* An operation socket that was accepted before is bound to the previous key
+	 */
+	if( context->operation_socket != -1 )
+	{
+		close(
+		 context->operation_socket );
+
+		context->operation_socket = -1;
+	}
+	if( setsockopt(
+	     context->algorithm_socket,
+	     SOL_ALG,
+	     ALG_SET_KEY,
+	     key,
+	     (socklen_t) key_size ) != 0 )
+	{
+		return( 0 );
+	}
+	context->operation_socket = accept4(
+	                             context->algorithm_socket,
+	                             NULL,
+	                             0,
+	                             SOCK_CLOEXEC );
+
+	if( context->operation_socket == -1 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Moves the input data of a sector into the operation socket without copying it
+ * The input data is mapped into the pipe and the pipe is spliced into the socket
+ * Returns 1 if successful or -1 on error
+ */
+static int libluksde_af_alg_splice_sector(
+            libluksde_af_alg_context_t *context,
+            const uint8_t *sector_data,
+            size_t sector_size,
+            libcerror_error_t **error )
+{
+	struct iovec io_vector;
+
+	static char *function     = "libluksde_af_alg_splice_sector";
+	ssize_t mapped_count      = 0;
+	ssize_t spliced_count     = 0;
+	size_t data_offset        = 0;
+	unsigned int splice_flags = 0;
+
+	while( data_offset < sector_size )
+	{
+		io_vector.iov_base = (void *) &( sector_data[ data_offset ] );
+		io_vector.iov_len  = sector_size - data_offset;
+
+		mapped_count = vmsplice(
+		                context->pipe_descriptors[ 1 ],
+		                &io_vector,
+		                1,
+		                0 );
+
+		if( mapped_count == -1 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to map sector data into pipe.",
+			 function );
+
+			return( -1 );
+		}
+		data_offset += (size_t) mapped_count;
+
+		/* The request is complete when the last part of the data is spliced
+		 */
+		splice_flags = ( data_offset < sector_size ) ? SPLICE_F_MORE : 0;
+
+		while( mapped_count > 0 )
+		{
+			spliced_count = splice(
+			                 context->pipe_descriptors[ 0 ],
+			                 NULL,
+			                 context->operation_socket,
+			                 NULL,
+			                 (size_t) mapped_count,
+			                 splice_flags );
+
+			if( spliced_count == -1 )
+			{
+				if( errno == EINTR )
+				{
+					continue;
+				}
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to splice sector data into operation socket.",
+				 function );
+
+				return( -1 );
+			}
+			mapped_count -= spliced_count;
+		}
+	}
+	return( 1 );
+}
+
+/* De- or encrypts sectors of data using the kernel
+ * Every sector is a separate request with its own initialization vector, the initialization
+ * vectors are stored 16 bytes apart
+ * Sectors that do not overlap the output data and are at least LIBLUKSDE_AF_ALG_MINIMUM_SPLICE_SIZE
+ * bytes are spliced into the kernel, other sectors are copied
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_af_alg_crypt_sectors(
+     libluksde_af_alg_context_t *context,
+     int mode,
+     const uint8_t *initialization_vectors,
+     size_t initialization_vectors_size,
+     size_t bytes_per_sector,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error )
+{
+	union
+	{
+		struct cmsghdr header;
+		uint8_t data[ CMSG_SPACE( sizeof( uint32_t ) ) + CMSG_SPACE( sizeof( struct af_alg_iv ) + 16 ) ];
+	} control_buffer;
+
+	struct af_alg_iv *initialization_vector = NULL;
+	struct cmsghdr *control_message         = NULL;
+	struct iovec io_vector;
+	struct msghdr message;
+
+	static char *function                   = "libluksde_af_alg_crypt_sectors";
+	size_t data_offset                      = 0;
+	size_t number_of_sectors                = 0;
+	size_t read_offset                      = 0;
+	size_t sector_index                     = 0;
+	ssize_t read_count                      = 0;
+	ssize_t write_count                     = 0;
+	uint32_t operation                      = 0;
+	uint8_t use_splice                      = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( context->operation_socket == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid context - missing operation socket.",
+		 function );
+
+		return( -1 );
+	}
+	if( mode == LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT )
+	{
+		operation = ALG_OP_ENCRYPT;
+	}
+	else if( mode == LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT )
+	{
+		operation = ALG_OP_DECRYPT;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( initialization_vectors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid initialization vectors.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( bytes_per_sector == 0 )
+	 || ( bytes_per_sector > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid bytes per sector value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( input_data_size > (size_t) SSIZE_MAX )
+	 || ( ( input_data_size % bytes_per_sector ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid input data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_sectors = input_data_size / bytes_per_sector;
+
+	if( initialization_vectors_size < ( number_of_sectors * 16 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: initialization vectors size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output data.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data_size < input_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: output data size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	/* The kernel reads spliced pages while it writes the output data, so the data
+	 * is only spliced if the input and output data do not overlap
+	 */
+	if( ( bytes_per_sector >= LIBLUKSDE_AF_ALG_MINIMUM_SPLICE_SIZE )
+	 && ( ( ( (uintptr_t) input_data + (uintptr_t) input_data_size ) <= (uintptr_t) output_data )
+	  || ( ( (uintptr_t) output_data + (uintptr_t) input_data_size ) <= (uintptr_t) input_data ) ) )
+	{
+		use_splice = 1;
+	}
+	if( memory_set(
+	     &control_buffer,
+	     0,
+	     sizeof( control_buffer ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear control buffer.",
+		 function );
+
+		return( -1 );
+	}
+	/* The operation is the same for all requests, only the initialization vector changes
+	 */
+	message.msg_name       = NULL;
+	message.msg_namelen    = 0;
+	message.msg_iov        = NULL;
+	message.msg_iovlen     = 0;
+	message.msg_control    = control_buffer.data;
+	message.msg_controllen = CMSG_SPACE( sizeof( uint32_t ) );
+	message.msg_flags      = 0;
+
+	if( context->initialization_vector_size > 0 )
+	{
+		message.msg_controllen += CMSG_SPACE( sizeof( struct af_alg_iv ) + context->initialization_vector_size );
+	}
+	control_message = CMSG_FIRSTHDR( &message );
+
+	control_message->cmsg_level = SOL_ALG;
+	control_message->cmsg_type  = ALG_SET_OP;
+	control_message->cmsg_len   = CMSG_LEN( sizeof( uint32_t ) );
+
+	memory_copy(
+	 CMSG_DATA( control_message ),
+	 &operation,
+	 sizeof( uint32_t ) );
+
+	if( context->initialization_vector_size > 0 )
+	{
+		control_message = CMSG_NXTHDR( &message, control_message );
+
+		control_message->cmsg_level = SOL_ALG;
+		control_message->cmsg_type  = ALG_SET_IV;
+		control_message->cmsg_len   = CMSG_LEN( sizeof( struct af_alg_iv ) + context->initialization_vector_size );
+
+		initialization_vector = (struct af_alg_iv *) CMSG_DATA( control_message );
+
+		initialization_vector->ivlen = (uint32_t) context->initialization_vector_size;
+	}
+	for( sector_index = 0;
+	     sector_index < number_of_sectors;
+	     sector_index++ )
+	{
+		if( initialization_vector != NULL )
+		{
+			memory_copy(
+			 initialization_vector->iv,
+			 &( initialization_vectors[ sector_index * 16 ] ),
+			 context->initialization_vector_size );
+		}
+		if( use_splice != 0 )
+		{
+			message.msg_iov    = NULL;
+			message.msg_iovlen = 0;
+		}
+		else
+		{
+			io_vector.iov_base = (void *) &( input_data[ data_offset ] );
+			io_vector.iov_len  = bytes_per_sector;
+
+			message.msg_iov    = &io_vector;
+			message.msg_iovlen = 1;
+		}
+		do
+		{
+			write_count = sendmsg(
+			               context->operation_socket,
+			               &message,
+			               ( use_splice != 0 ) ? MSG_MORE : 0 );
+		}
+		while( ( write_count == -1 )
+		    && ( errno == EINTR ) );
+
+		if( ( write_count == -1 )
+		 || ( ( use_splice == 0 )
+		  && ( (size_t) write_count != bytes_per_sector ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to send request of sector: %" PRIzd " to operation socket.",
+			 function,
+			 sector_index );
+
+			return( -1 );
+		}
+		if( use_splice != 0 )
+		{
+			if( libluksde_af_alg_splice_sector(
+			     context,
+			     &( input_data[ data_offset ] ),
+			     bytes_per_sector,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to splice sector: %" PRIzd " into operation socket.",
+				 function,
+				 sector_index );
+
+				return( -1 );
+			}
+		}
+		read_offset = 0;
+
+		while( read_offset < bytes_per_sector )
+		{
+			read_count = read(
+			              context->operation_socket,
+			              &( output_data[ data_offset + read_offset ] ),
+			              bytes_per_sector - read_offset );
+
+			if( read_count == -1 )
+			{
+				if( errno == EINTR )
+				{
+					continue;
+				}
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read result of sector: %" PRIzd " from operation socket.",
+				 function,
+				 sector_index );
+
+				return( -1 );
+			}
+			if( read_count == 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unexpected end of result of sector: %" PRIzd ".",
+				 function,
+				 sector_index );
+
+				return( -1 );
+			}
+			read_offset += (size_t) read_count;
+		}
+		data_offset += bytes_per_sector;
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_LIBLUKSDE_AF_ALG_SUPPORT ) */
+
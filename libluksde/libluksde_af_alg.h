@@ -0,0 +1,101 @@
+/*
+ * Linux kernel crypto API (AF_ALG) functions
+ *
+ * Copyright (C) 2013-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBLUKSDE_AF_ALG_H )
+#define _LIBLUKSDE_AF_ALG_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libluksde_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_LINUX_IF_ALG_H ) && defined( HAVE_SPLICE ) && defined( HAVE_VMSPLICE )
+#define HAVE_LIBLUKSDE_AF_ALG_SUPPORT
+#endif
+
+/* The minimum sector size for which the input data is spliced into the kernel
+ * instead of being copied, smaller sectors are cheaper to copy than to splice
+ */
+#define LIBLUKSDE_AF_ALG_MINIMUM_SPLICE_SIZE	4096
+
+typedef struct libluksde_af_alg_context libluksde_af_alg_context_t;
+
+struct libluksde_af_alg_context
+{
+	/* The algorithm (transformation) socket
+	 */
+	int algorithm_socket;
+
+	/* The operation socket
+	 */
+	int operation_socket;
+
+	/* The pipe used to splice data into the operation socket
+	 */
+	int pipe_descriptors[ 2 ];
+
+	/* The initialization vector size
+	 */
+	size_t initialization_vector_size;
+};
+
+#if defined( HAVE_LIBLUKSDE_AF_ALG_SUPPORT )
+
+int libluksde_af_alg_context_initialize(
+     libluksde_af_alg_context_t **context,
+     int method,
+     int chaining_mode,
+     libcerror_error_t **error );
+
+int libluksde_af_alg_context_free(
+     libluksde_af_alg_context_t **context,
+     libcerror_error_t **error );
+
+int libluksde_af_alg_context_set_key(
+     libluksde_af_alg_context_t *context,
+     const uint8_t *key,
+     size_t key_size,
+     libcerror_error_t **error );
+
+int libluksde_af_alg_crypt_sectors(
+     libluksde_af_alg_context_t *context,
+     int mode,
+     const uint8_t *initialization_vectors,
+     size_t initialization_vectors_size,
+     size_t bytes_per_sector,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBLUKSDE_AF_ALG_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBLUKSDE_AF_ALG_H ) */
+
@@ -0,0 +1,95 @@
+/*
+ * CAST-128 (CAST5) functions
+ *
+ * Copyright (C) 2013-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBLUKSDE_CAST5_H )
+#define _LIBLUKSDE_CAST5_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libluksde_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The S-boxes S1 to S4 of the round function, which CAST-256 uses as well
+ */
+extern const uint32_t libluksde_cast5_s_boxes[ 4 ][ 256 ];
+
+typedef struct libluksde_cast5_context libluksde_cast5_context_t;
+
+struct libluksde_cast5_context
+{
+	/* The masking subkeys
+	 */
+	uint32_t masking_keys[ 16 ];
+
+	/* The rotation subkeys
+	 */
+	uint8_t rotation_keys[ 16 ];
+
+	/* The number of rounds
+	 */
+	int number_of_rounds;
+};
+
+int libluksde_cast5_context_initialize(
+     libluksde_cast5_context_t **context,
+     libcerror_error_t **error );
+
+int libluksde_cast5_context_free(
+     libluksde_cast5_context_t **context,
+     libcerror_error_t **error );
+
+int libluksde_cast5_context_set_key(
+     libluksde_cast5_context_t *context,
+     const uint8_t *key,
+     size_t key_bit_size,
+     libcerror_error_t **error );
+
+int libluksde_cast5_crypt_cbc(
+     libluksde_cast5_context_t *context,
+     int mode,
+     const uint8_t *initialization_vectors,
+     size_t initialization_vectors_size,
+     size_t sector_size,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error );
+
+int libluksde_cast5_crypt_ecb(
+     libluksde_cast5_context_t *context,
+     int mode,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBLUKSDE_CAST5_H ) */
+
@@ -0,0 +1,1172 @@
+/*
+ * CAST-256 (CAST6) functions
+ *
+ * Copyright (C) 2013-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libluksde_cast5.h"
+#include "libluksde_cast6.h"
+#include "libluksde_encryption.h"
+#include "libluksde_libcerror.h"
+
+#define libluksde_cast6_rotate_left( value, number_of_bits ) \
+	( ( ( value ) << ( number_of_bits ) ) | ( ( value ) >> ( ( 32 - ( number_of_bits ) ) & 0x1f ) ) )
+
+/* Creates a context
+ * Make sure the value context is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_cast6_context_initialize(
+     libluksde_cast6_context_t **context,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_cast6_context_initialize";
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *context != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid context value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*context = memory_allocate_structure(
+	            libluksde_cast6_context_t );
+
+	if( *context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create context.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *context,
+	     0,
+	     sizeof( libluksde_cast6_context_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear context.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *context != NULL )
+	{
+		memory_free(
+		 *context );
+
+		*context = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a context
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_cast6_context_free(
+     libluksde_cast6_context_t **context,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_cast6_context_free";
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *context != NULL )
+	{
+		/* The subkeys are key material
+		 */
+		memory_set(
+		 *context,
+		 0,
+		 sizeof( libluksde_cast6_context_t ) );
+
+		memory_free(
+		 *context );
+
+		*context = NULL;
+	}
+	return( 1 );
+}
+
+/* Calculates the round function of type 1 (f1)
+ * Returns the resulting 32-bit word
+ */
+static inline uint32_t libluksde_cast6_f1(
+                        uint32_t value,
+                        uint32_t masking_key,
+                        uint8_t rotation_key )
+{
+	value = masking_key + value;
+	value = libluksde_cast6_rotate_left( value, rotation_key );
+
+	return( ( ( libluksde_cast5_s_boxes[ 0 ][ value >> 24 ]
+	          ^ libluksde_cast5_s_boxes[ 1 ][ ( value >> 16 ) & 0xff ] )
+	        - libluksde_cast5_s_boxes[ 2 ][ ( value >> 8 ) & 0xff ] )
+	      + libluksde_cast5_s_boxes[ 3 ][ value & 0xff ] );
+}
+
+/* Calculates the round function of type 2 (f2)
+ * Returns the resulting 32-bit word
+ */
+static inline uint32_t libluksde_cast6_f2(
+                        uint32_t value,
+                        uint32_t masking_key,
+                        uint8_t rotation_key )
+{
+	value = masking_key ^ value;
+	value = libluksde_cast6_rotate_left( value, rotation_key );
+
+	return( ( ( libluksde_cast5_s_boxes[ 0 ][ value >> 24 ]
+	          - libluksde_cast5_s_boxes[ 1 ][ ( value >> 16 ) & 0xff ] )
+	        + libluksde_cast5_s_boxes[ 2 ][ ( value >> 8 ) & 0xff ] )
+	      ^ libluksde_cast5_s_boxes[ 3 ][ value & 0xff ] );
+}
+
+/* Calculates the round function of type 3 (f3)
+ * Returns the resulting 32-bit word
+ */
+static inline uint32_t libluksde_cast6_f3(
+                        uint32_t value,
+                        uint32_t masking_key,
+                        uint8_t rotation_key )
+{
+	value = masking_key - value;
+	value = libluksde_cast6_rotate_left( value, rotation_key );
+
+	return( ( ( libluksde_cast5_s_boxes[ 0 ][ value >> 24 ]
+	          + libluksde_cast5_s_boxes[ 1 ][ ( value >> 16 ) & 0xff ] )
+	        ^ libluksde_cast5_s_boxes[ 2 ][ ( value >> 8 ) & 0xff ] )
+	      - libluksde_cast5_s_boxes[ 3 ][ value & 0xff ] );
+}
+
+/* Sets the key
+ * CAST-256 uses the same key schedule to de- and encrypt
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_cast6_context_set_key(
+     libluksde_cast6_context_t *context,
+     const uint8_t *key,
+     size_t key_bit_size,
+     libcerror_error_t **error )
+{
+	uint8_t key_data[ 32 ];
+	uint32_t key_words[ 8 ];
+	uint32_t masking_values[ 8 ];
+	uint8_t rotation_values[ 8 ];
+
+	static char *function      = "libluksde_cast6_context_set_key";
+	uint32_t masking_constant  = 0x5a827999UL;
+	uint8_t rotation_constant  = 19;
+	int quad_round_index       = 0;
+	int value_index            = 0;
+	int word_index             = 0;
+	int w_index                = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key.",
+		 function );
+
+		return( -1 );
+	}
+	/* CAST-256 supports key sizes of 128, 160, 192, 224 and 256 bits
+	 */
+	if( ( key_bit_size < 128 )
+	 || ( key_bit_size > 256 )
+	 || ( ( key_bit_size % 32 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported key bit size.",
+		 function );
+
+		return( -1 );
+	}
+	/* Keys smaller than 256 bits are padded with zero bytes
+	 */
+	if( memory_set(
+	     key_data,
+	     0,
+	     32 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear key data.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     key_data,
+	     key,
+	     key_bit_size / 8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy key data.",
+		 function );
+
+		return( -1 );
+	}
+	for( word_index = 0;
+	     word_index < 8;
+	     word_index++ )
+	{
+		byte_stream_copy_to_uint32_big_endian(
+		 &( key_data[ word_index * 4 ] ),
+		 key_words[ word_index ] );
+	}
+	for( quad_round_index = 0;
+	     quad_round_index < 12;
+	     quad_round_index++ )
+	{
+		/* Every quad-round the forward octave (W) is applied twice
+		 */
+		for( w_index = 0;
+		     w_index < 2;
+		     w_index++ )
+		{
+			/* The masking and rotation values of the octave are derived
+			 * from the square roots of 2 and 3
+			 */
+			for( value_index = 0;
+			     value_index < 8;
+			     value_index++ )
+			{
+				masking_values[ value_index ]  = masking_constant;
+				rotation_values[ value_index ] = rotation_constant;
+
+				masking_constant  += 0x6ed9eba1UL;
+				rotation_constant  = ( rotation_constant + 17 ) & 0x1f;
+			}
+			key_words[ 6 ] ^= libluksde_cast6_f1( key_words[ 7 ], masking_values[ 0 ], rotation_values[ 0 ] );
+			key_words[ 5 ] ^= libluksde_cast6_f2( key_words[ 6 ], masking_values[ 1 ], rotation_values[ 1 ] );
+			key_words[ 4 ] ^= libluksde_cast6_f3( key_words[ 5 ], masking_values[ 2 ], rotation_values[ 2 ] );
+			key_words[ 3 ] ^= libluksde_cast6_f1( key_words[ 4 ], masking_values[ 3 ], rotation_values[ 3 ] );
+			key_words[ 2 ] ^= libluksde_cast6_f2( key_words[ 3 ], masking_values[ 4 ], rotation_values[ 4 ] );
+			key_words[ 1 ] ^= libluksde_cast6_f3( key_words[ 2 ], masking_values[ 5 ], rotation_values[ 5 ] );
+			key_words[ 0 ] ^= libluksde_cast6_f1( key_words[ 1 ], masking_values[ 6 ], rotation_values[ 6 ] );
+			key_words[ 7 ] ^= libluksde_cast6_f2( key_words[ 0 ], masking_values[ 7 ], rotation_values[ 7 ] );
+		}
+		context->rotation_keys[ quad_round_index ][ 0 ] = (uint8_t) ( key_words[ 0 ] & 0x1f );
+		context->rotation_keys[ quad_round_index ][ 1 ] = (uint8_t) ( key_words[ 2 ] & 0x1f );
+		context->rotation_keys[ quad_round_index ][ 2 ] = (uint8_t) ( key_words[ 4 ] & 0x1f );
+		context->rotation_keys[ quad_round_index ][ 3 ] = (uint8_t) ( key_words[ 6 ] & 0x1f );
+
+		context->masking_keys[ quad_round_index ][ 0 ] = key_words[ 7 ];
+		context->masking_keys[ quad_round_index ][ 1 ] = key_words[ 5 ];
+		context->masking_keys[ quad_round_index ][ 2 ] = key_words[ 3 ];
+		context->masking_keys[ quad_round_index ][ 3 ] = key_words[ 1 ];
+	}
+	memory_set(
+	 key_words,
+	 0,
+	 sizeof( uint32_t ) * 8 );
+
+	memory_set(
+	 key_data,
+	 0,
+	 32 );
+
+	return( 1 );
+}
+
+/* Applies a forward quad-round (Q) to a number of blocks
+ */
+static inline void libluksde_cast6_quad_round(
+                    const libluksde_cast6_context_t *context,
+                    int quad_round_index,
+                    uint32_t *values_a,
+                    uint32_t *values_b,
+                    uint32_t *values_c,
+                    uint32_t *values_d,
+                    int number_of_blocks )
+{
+	const uint32_t *masking_keys = context->masking_keys[ quad_round_index ];
+	const uint8_t *rotation_keys = context->rotation_keys[ quad_round_index ];
+	int block_index              = 0;
+
+	for( block_index = 0;
+	     block_index < number_of_blocks;
+	     block_index++ )
+	{
+		values_c[ block_index ] ^= libluksde_cast6_f1( values_d[ block_index ], masking_keys[ 0 ], rotation_keys[ 0 ] );
+	}
+	for( block_index = 0;
+	     block_index < number_of_blocks;
+	     block_index++ )
+	{
+		values_b[ block_index ] ^= libluksde_cast6_f2( values_c[ block_index ], masking_keys[ 1 ], rotation_keys[ 1 ] );
+	}
+	for( block_index = 0;
+	     block_index < number_of_blocks;
+	     block_index++ )
+	{
+		values_a[ block_index ] ^= libluksde_cast6_f3( values_b[ block_index ], masking_keys[ 2 ], rotation_keys[ 2 ] );
+	}
+	for( block_index = 0;
+	     block_index < number_of_blocks;
+	     block_index++ )
+	{
+		values_d[ block_index ] ^= libluksde_cast6_f1( values_a[ block_index ], masking_keys[ 3 ], rotation_keys[ 3 ] );
+	}
+}
+
+/* Applies an inverse quad-round (QBAR) to a number of blocks
+ */
+static inline void libluksde_cast6_inverse_quad_round(
+                    const libluksde_cast6_context_t *context,
+                    int quad_round_index,
+                    uint32_t *values_a,
+                    uint32_t *values_b,
+                    uint32_t *values_c,
+                    uint32_t *values_d,
+                    int number_of_blocks )
+{
+	const uint32_t *masking_keys = context->masking_keys[ quad_round_index ];
+	const uint8_t *rotation_keys = context->rotation_keys[ quad_round_index ];
+	int block_index              = 0;
+
+	for( block_index = 0;
+	     block_index < number_of_blocks;
+	     block_index++ )
+	{
+		values_d[ block_index ] ^= libluksde_cast6_f1( values_a[ block_index ], masking_keys[ 3 ], rotation_keys[ 3 ] );
+	}
+	for( block_index = 0;
+	     block_index < number_of_blocks;
+	     block_index++ )
+	{
+		values_a[ block_index ] ^= libluksde_cast6_f3( values_b[ block_index ], masking_keys[ 2 ], rotation_keys[ 2 ] );
+	}
+	for( block_index = 0;
+	     block_index < number_of_blocks;
+	     block_index++ )
+	{
+		values_b[ block_index ] ^= libluksde_cast6_f2( values_c[ block_index ], masking_keys[ 1 ], rotation_keys[ 1 ] );
+	}
+	for( block_index = 0;
+	     block_index < number_of_blocks;
+	     block_index++ )
+	{
+		values_c[ block_index ] ^= libluksde_cast6_f1( values_d[ block_index ], masking_keys[ 0 ], rotation_keys[ 0 ] );
+	}
+}
+
+/* De- or encrypts a number of 16-byte blocks
+ * The rounds of the blocks are interleaved so that the S-box lookups of the independent
+ * blocks can be executed in parallel, a maximum of 4 blocks is supported
+ */
+static inline void libluksde_cast6_crypt_blocks(
+                    const libluksde_cast6_context_t *context,
+                    int mode,
+                    const uint8_t *input_data,
+                    uint8_t *output_data,
+                    int number_of_blocks )
+{
+	uint32_t values_a[ 4 ];
+	uint32_t values_b[ 4 ];
+	uint32_t values_c[ 4 ];
+	uint32_t values_d[ 4 ];
+
+	int block_index      = 0;
+	int quad_round_index = 0;
+
+	for( block_index = 0;
+	     block_index < number_of_blocks;
+	     block_index++ )
+	{
+		byte_stream_copy_to_uint32_big_endian(
+		 &( input_data[ block_index * 16 ] ),
+		 values_a[ block_index ] );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 &( input_data[ ( block_index * 16 ) + 4 ] ),
+		 values_b[ block_index ] );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 &( input_data[ ( block_index * 16 ) + 8 ] ),
+		 values_c[ block_index ] );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 &( input_data[ ( block_index * 16 ) + 12 ] ),
+		 values_d[ block_index ] );
+	}
+	/* CAST-256 applies 6 forward quad-rounds followed by 6 inverse quad-rounds,
+	 * decryption applies the same quad-rounds with the subkeys in reverse order
+	 */
+	if( mode == LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT )
+	{
+		for( quad_round_index = 0;
+		     quad_round_index < 6;
+		     quad_round_index++ )
+		{
+			libluksde_cast6_quad_round(
+			 context,
+			 quad_round_index,
+			 values_a,
+			 values_b,
+			 values_c,
+			 values_d,
+			 number_of_blocks );
+		}
+		for( quad_round_index = 6;
+		     quad_round_index < 12;
+		     quad_round_index++ )
+		{
+			libluksde_cast6_inverse_quad_round(
+			 context,
+			 quad_round_index,
+			 values_a,
+			 values_b,
+			 values_c,
+			 values_d,
+			 number_of_blocks );
+		}
+	}
+	else
+	{
+		for( quad_round_index = 11;
+		     quad_round_index >= 6;
+		     quad_round_index-- )
+		{
+			libluksde_cast6_quad_round(
+			 context,
+			 quad_round_index,
+			 values_a,
+			 values_b,
+			 values_c,
+			 values_d,
+			 number_of_blocks );
+		}
+		for( quad_round_index = 5;
+		     quad_round_index >= 0;
+		     quad_round_index-- )
+		{
+			libluksde_cast6_inverse_quad_round(
+			 context,
+			 quad_round_index,
+			 values_a,
+			 values_b,
+			 values_c,
+			 values_d,
+			 number_of_blocks );
+		}
+	}
+	for( block_index = 0;
+	     block_index < number_of_blocks;
+	     block_index++ )
+	{
+		byte_stream_copy_from_uint32_big_endian(
+		 &( output_data[ block_index * 16 ] ),
+		 values_a[ block_index ] );
+
+		byte_stream_copy_from_uint32_big_endian(
+		 &( output_data[ ( block_index * 16 ) + 4 ] ),
+		 values_b[ block_index ] );
+
+		byte_stream_copy_from_uint32_big_endian(
+		 &( output_data[ ( block_index * 16 ) + 8 ] ),
+		 values_c[ block_index ] );
+
+		byte_stream_copy_from_uint32_big_endian(
+		 &( output_data[ ( block_index * 16 ) + 12 ] ),
+		 values_d[ block_index ] );
+	}
+}
+
+/* Multiplies a XTS tweak value by alpha (x) in GF(2^128)
+ * The tweak value is stored as 2 64-bit values in little-endian byte order
+ */
+static inline void libluksde_cast6_xts_multiply_alpha(
+                    uint64_t *tweak_lower,
+                    uint64_t *tweak_upper )
+{
+	uint64_t carry = *tweak_upper >> 63;
+
+	*tweak_upper = ( *tweak_upper << 1 ) | ( *tweak_lower >> 63 );
+	*tweak_lower = ( *tweak_lower << 1 ) ^ ( carry * 0x87 );
+}
+
+/* De- or encrypts one or more sectors of data in CBC mode
+ * Every sector has its own 16-byte initialization vector
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_cast6_crypt_cbc(
+     libluksde_cast6_context_t *context,
+     int mode,
+     const uint8_t *initialization_vectors,
+     size_t initialization_vectors_size,
+     size_t sector_size,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error )
+{
+	uint8_t block_data[ 16 ];
+	uint8_t cipher_text_blocks[ 64 ];
+	uint8_t previous_block[ 16 ];
+
+	static char *function    = "libluksde_cast6_crypt_cbc";
+	size_t data_offset       = 0;
+	size_t number_of_sectors = 0;
+	size_t sector_end_offset = 0;
+	size_t sector_index      = 0;
+	uint8_t byte_index       = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( mode != LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT )
+	 && ( mode != LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( initialization_vectors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid initialization vectors.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( sector_size == 0 )
+	 || ( sector_size > (size_t) SSIZE_MAX )
+	 || ( ( sector_size % 16 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid sector size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( input_data_size > (size_t) SSIZE_MAX )
+	 || ( ( input_data_size % sector_size ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid input data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_sectors = input_data_size / sector_size;
+
+	if( initialization_vectors_size < ( number_of_sectors * 16 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: initialization vectors size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output data.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data_size < input_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: output data size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	for( sector_index = 0;
+	     sector_index < number_of_sectors;
+	     sector_index++ )
+	{
+		if( memory_copy(
+		     previous_block,
+		     &( initialization_vectors[ sector_index * 16 ] ),
+		     16 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy initialization vector.",
+			 function );
+
+			return( -1 );
+		}
+		sector_end_offset = data_offset + sector_size;
+
+		if( mode == LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT )
+		{
+			/* CBC encryption depends on the previous cipher text block
+			 * and cannot be interleaved
+			 */
+			while( data_offset < sector_end_offset )
+			{
+				for( byte_index = 0;
+				     byte_index < 16;
+				     byte_index++ )
+				{
+					block_data[ byte_index ] = input_data[ data_offset + byte_index ] ^ previous_block[ byte_index ];
+				}
+				libluksde_cast6_crypt_blocks(
+				 context,
+				 LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+				 block_data,
+				 previous_block,
+				 1 );
+
+				memory_copy(
+				 &( output_data[ data_offset ] ),
+				 previous_block,
+				 16 );
+
+				data_offset += 16;
+			}
+		}
+		else
+		{
+			/* The cipher text blocks are copied since the output can overlap the input
+			 */
+			while( ( data_offset + 64 ) <= sector_end_offset )
+			{
+				memory_copy(
+				 cipher_text_blocks,
+				 &( input_data[ data_offset ] ),
+				 64 );
+
+				libluksde_cast6_crypt_blocks(
+				 context,
+				 LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+				 cipher_text_blocks,
+				 &( output_data[ data_offset ] ),
+				 4 );
+
+				for( byte_index = 0;
+				     byte_index < 16;
+				     byte_index++ )
+				{
+					output_data[ data_offset + byte_index ] ^= previous_block[ byte_index ];
+				}
+				for( byte_index = 16;
+				     byte_index < 64;
+				     byte_index++ )
+				{
+					output_data[ data_offset + byte_index ] ^= cipher_text_blocks[ byte_index - 16 ];
+				}
+				memory_copy(
+				 previous_block,
+				 &( cipher_text_blocks[ 48 ] ),
+				 16 );
+
+				data_offset += 64;
+			}
+			while( data_offset < sector_end_offset )
+			{
+				memory_copy(
+				 cipher_text_blocks,
+				 &( input_data[ data_offset ] ),
+				 16 );
+
+				libluksde_cast6_crypt_blocks(
+				 context,
+				 LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+				 cipher_text_blocks,
+				 &( output_data[ data_offset ] ),
+				 1 );
+
+				for( byte_index = 0;
+				     byte_index < 16;
+				     byte_index++ )
+				{
+					output_data[ data_offset + byte_index ] ^= previous_block[ byte_index ];
+				}
+				memory_copy(
+				 previous_block,
+				 cipher_text_blocks,
+				 16 );
+
+				data_offset += 16;
+			}
+		}
+	}
+	memory_set(
+	 block_data,
+	 0,
+	 16 );
+
+	return( 1 );
+}
+
+/* De- or encrypts data in ECB mode
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_cast6_crypt_ecb(
+     libluksde_cast6_context_t *context,
+     int mode,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_cast6_crypt_ecb";
+	size_t data_offset    = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( mode != LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT )
+	 && ( mode != LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( input_data_size > (size_t) SSIZE_MAX )
+	 || ( ( input_data_size % 16 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid input data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output data.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data_size < input_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: output data size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	while( ( data_offset + 64 ) <= input_data_size )
+	{
+		libluksde_cast6_crypt_blocks(
+		 context,
+		 mode,
+		 &( input_data[ data_offset ] ),
+		 &( output_data[ data_offset ] ),
+		 4 );
+
+		data_offset += 64;
+	}
+	while( data_offset < input_data_size )
+	{
+		libluksde_cast6_crypt_blocks(
+		 context,
+		 mode,
+		 &( input_data[ data_offset ] ),
+		 &( output_data[ data_offset ] ),
+		 1 );
+
+		data_offset += 16;
+	}
+	return( 1 );
+}
+
+/* De- or encrypts one or more sectors of data in XTS mode
+ * Every sector has its own 16-byte tweak value, which is encrypted with the tweak context
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_cast6_crypt_xts(
+     libluksde_cast6_context_t *context,
+     libluksde_cast6_context_t *tweak_context,
+     int mode,
+     const uint8_t *tweak_values,
+     size_t tweak_values_size,
+     size_t sector_size,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error )
+{
+	uint8_t blocks_data[ 64 ];
+	uint8_t encrypted_tweak_values[ 64 ];
+
+	static char *function    = "libluksde_cast6_crypt_xts";
+	size_t blocks_size       = 0;
+	size_t data_offset       = 0;
+	size_t number_of_sectors = 0;
+	size_t sector_end_offset = 0;
+	size_t sector_index      = 0;
+	uint64_t tweak_lower     = 0;
+	uint64_t tweak_upper     = 0;
+	uint8_t byte_index       = 0;
+	int block_index          = 0;
+	int number_of_blocks     = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( tweak_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tweak context.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( mode != LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT )
+	 && ( mode != LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( tweak_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tweak values.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( sector_size == 0 )
+	 || ( sector_size > (size_t) SSIZE_MAX )
+	 || ( ( sector_size % 16 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid sector size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( input_data_size > (size_t) SSIZE_MAX )
+	 || ( ( input_data_size % sector_size ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid input data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_sectors = input_data_size / sector_size;
+
+	if( tweak_values_size < ( number_of_sectors * 16 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: tweak values size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output data.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data_size < input_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: output data size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	for( sector_index = 0;
+	     sector_index < number_of_sectors;
+	     sector_index++ )
+	{
+		libluksde_cast6_crypt_blocks(
+		 tweak_context,
+		 LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+		 &( tweak_values[ sector_index * 16 ] ),
+		 encrypted_tweak_values,
+		 1 );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 &( encrypted_tweak_values[ 0 ] ),
+		 tweak_lower );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 &( encrypted_tweak_values[ 8 ] ),
+		 tweak_upper );
+
+		sector_end_offset = data_offset + sector_size;
+
+		while( data_offset < sector_end_offset )
+		{
+			/* Blocks are de- or encrypted 4 at a time when possible
+			 */
+			if( ( data_offset + 64 ) <= sector_end_offset )
+			{
+				number_of_blocks = 4;
+			}
+			else
+			{
+				number_of_blocks = 1;
+			}
+			for( block_index = 0;
+			     block_index < number_of_blocks;
+			     block_index++ )
+			{
+				byte_stream_copy_from_uint64_little_endian(
+				 &( encrypted_tweak_values[ block_index * 16 ] ),
+				 tweak_lower );
+
+				byte_stream_copy_from_uint64_little_endian(
+				 &( encrypted_tweak_values[ ( block_index * 16 ) + 8 ] ),
+				 tweak_upper );
+
+				libluksde_cast6_xts_multiply_alpha(
+				 &tweak_lower,
+				 &tweak_upper );
+			}
+			blocks_size = number_of_blocks * 16;
+
+			for( byte_index = 0;
+			     byte_index < blocks_size;
+			     byte_index++ )
+			{
+				blocks_data[ byte_index ] = input_data[ data_offset + byte_index ] ^ encrypted_tweak_values[ byte_index ];
+			}
+			if( number_of_blocks == 4 )
+			{
+				libluksde_cast6_crypt_blocks(
+				 context,
+				 mode,
+				 blocks_data,
+				 &( output_data[ data_offset ] ),
+				 4 );
+			}
+			else
+			{
+				libluksde_cast6_crypt_blocks(
+				 context,
+				 mode,
+				 blocks_data,
+				 &( output_data[ data_offset ] ),
+				 1 );
+			}
+			for( byte_index = 0;
+			     byte_index < blocks_size;
+			     byte_index++ )
+			{
+				output_data[ data_offset + byte_index ] ^= encrypted_tweak_values[ byte_index ];
+			}
+			data_offset += blocks_size;
+		}
+	}
+	memory_set(
+	 encrypted_tweak_values,
+	 0,
+	 64 );
+
+	memory_set(
+	 blocks_data,
+	 0,
+	 64 );
+
+	return( 1 );
+}
+
@@ -0,0 +1,100 @@
+/*
+ * CAST-256 (CAST6) functions
+ *
+ * Copyright (C) 2013-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBLUKSDE_CAST6_H )
+#define _LIBLUKSDE_CAST6_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libluksde_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libluksde_cast6_context libluksde_cast6_context_t;
+
+struct libluksde_cast6_context
+{
+	/* The masking subkeys of the quad-rounds
+	 */
+	uint32_t masking_keys[ 12 ][ 4 ];
+
+	/* The rotation subkeys of the quad-rounds
+	 */
+	uint8_t rotation_keys[ 12 ][ 4 ];
+};
+
+int libluksde_cast6_context_initialize(
+     libluksde_cast6_context_t **context,
+     libcerror_error_t **error );
+
+int libluksde_cast6_context_free(
+     libluksde_cast6_context_t **context,
+     libcerror_error_t **error );
+
+int libluksde_cast6_context_set_key(
+     libluksde_cast6_context_t *context,
+     const uint8_t *key,
+     size_t key_bit_size,
+     libcerror_error_t **error );
+
+int libluksde_cast6_crypt_cbc(
+     libluksde_cast6_context_t *context,
+     int mode,
+     const uint8_t *initialization_vectors,
+     size_t initialization_vectors_size,
+     size_t sector_size,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error );
+
+int libluksde_cast6_crypt_ecb(
+     libluksde_cast6_context_t *context,
+     int mode,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error );
+
+int libluksde_cast6_crypt_xts(
+     libluksde_cast6_context_t *context,
+     libluksde_cast6_context_t *tweak_context,
+     int mode,
+     const uint8_t *tweak_values,
+     size_t tweak_values_size,
+     size_t sector_size,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBLUKSDE_CAST6_H ) */
+
@@ -19,6 +19,7 @@
  * along with this software.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+
 #include <common.h>
 #include <byte_stream.h>
 #include <memory.h>
@@ -26,39 +27,33 @@
 
 #include "libluksde_definitions.h"
 #include "libluksde_diffuser.h"
+#include "libluksde_hash.h"
 #include "libluksde_libcerror.h"
 #include "libluksde_libcnotify.h"
-#include "libluksde_libhmac.h"
+#include "libluksde_progress.h"
 
-/* Diffuses data
+/* Sets the hashing method and data size of a diffuser context
+ * The block index and a hash-sized part of the data always fit in a single block
+ * of the hash, hence the padding of the blocks is determined once
  * Returns 1 if successful or -1 on error
  */
-int libluksde_diffuser_diffuse(
-     uint8_t *data,
-     size_t data_size,
+int libluksde_diffuser_context_set_method(
+     libluksde_diffuser_context_t *context,
      int hashing_method,
+     size_t data_size,
      libcerror_error_t **error )
 {
-	uint8_t block_index_buffer[ 4 ];
-	uint8_t hash_buffer[ 32 ];
-
-	libhmac_sha1_context_t *sha1_context     = NULL;
-	libhmac_sha256_context_t *sha256_context = NULL;
-	libhmac_sha512_context_t *sha512_context = NULL;
-	static char *function                    = "libluksde_diffuser_diffuse";
-	size_t data_offset                       = 0;
-	size_t hash_size                         = 0;
-	size_t read_size                         = 0;
-	uint32_t block_index                     = 0;
-	int result                               = 0;
+	static char *function = "libluksde_diffuser_context_set_method";
+	size_t block_size     = 0;
+	size_t hash_size      = 0;
 
-	if( data == NULL )
+	if( context == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid data.",
+		 "%s: invalid context.",
 		 function );
 
 		return( -1 );
@@ -78,282 +73,254 @@ int libluksde_diffuser_diffuse(
 
 		return( -1 );
 	}
-	switch( hashing_method )
+	if( libluksde_hash_context_set_method(
+	     &( context->hash_context ),
+	     hashing_method,
+	     LIBLUKSDE_HASH_BACKEND_DEFAULT,
+	     error ) != 1 )
 	{
-		case LIBLUKSDE_HASHING_METHOD_SHA1:
-			hash_size = LIBHMAC_SHA1_HASH_SIZE;
-			break;
-
-		case LIBLUKSDE_HASHING_METHOD_SHA256:
-			hash_size = LIBHMAC_SHA256_HASH_SIZE;
-			break;
-
-		case LIBLUKSDE_HASHING_METHOD_SHA512:
-			hash_size = LIBHMAC_SHA512_HASH_SIZE;
-			break;
-
-		default:
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-			 "%s: unsupported hashing method.",
-			 function );
-
-			return( -1 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set hashing method.",
+		 function );
+
+		return( -1 );
 	}
-	while( data_size > 0 )
+	block_size = context->hash_context.block_size;
+	hash_size  = context->hash_context.hash_size;
+
+	/* The message size field is 8 bytes for a 64-byte block and 16 bytes for a 128-byte block
+	 */
+	if( ( 4 + hash_size + 1 + ( block_size / 8 ) ) > block_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported hashing method.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     context->initial_hash_values,
+	     context->hash_context.hash_values,
+	     sizeof( uint32_t ) * LIBLUKSDE_HASH_MAXIMUM_NUMBER_OF_HASH_VALUES ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy initial hash values.",
+		 function );
+
+		return( -1 );
+	}
+	context->data_size      = data_size;
+	context->last_part_size = data_size % hash_size;
+
+	libluksde_hash_set_padding(
+	 context->block_data,
+	 4 + hash_size,
+	 block_size,
+	 (uint64_t) ( 4 + hash_size ),
+	 context->hash_context.byte_order );
+
+	if( context->last_part_size > 0 )
+	{
+		libluksde_hash_set_padding(
+		 context->last_block_data,
+		 4 + context->last_part_size,
+		 block_size,
+		 (uint64_t) ( 4 + context->last_part_size ),
+		 context->hash_context.byte_order );
+	}
+	return( 1 );
+}
+
+/* Diffuses data using a diffuser context
+ * Every hash-sized part of the data is replaced by the hash of the block index and the part
+ * The size of the data must match the data size of the context
+ */
+void libluksde_diffuser_context_diffuse(
+      libluksde_diffuser_context_t *context,
+      uint8_t *data )
+{
+	uint8_t hash_buffer[ LIBLUKSDE_HASH_MAXIMUM_HASH_SIZE ];
+
+	size_t data_offset   = 0;
+	size_t hash_size     = context->hash_context.hash_size;
+	uint32_t block_index = 0;
+
+	while( ( context->data_size - data_offset ) >= hash_size )
 	{
-		switch( hashing_method )
-		{
-			case LIBLUKSDE_HASHING_METHOD_SHA1:
-				result = libhmac_sha1_initialize(
-					  &sha1_context,
-					  error );
-				break;
-
-			case LIBLUKSDE_HASHING_METHOD_SHA256:
-				result = libhmac_sha256_initialize(
-					  &sha256_context,
-					  error );
-				break;
-
-			case LIBLUKSDE_HASHING_METHOD_SHA512:
-				result = libhmac_sha512_initialize(
-					  &sha512_context,
-					  error );
-				break;
-
-			default:
-				result = 0;
-				break;
-		}
-		if( result != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize context.",
-			 function );
-
-			goto on_error;
-		}
 		byte_stream_copy_from_uint32_big_endian(
-		 block_index_buffer,
+		 context->block_data,
 		 block_index );
 
-		switch( hashing_method )
-		{
-			case LIBLUKSDE_HASHING_METHOD_SHA1:
-				result = libhmac_sha1_update(
-				          sha1_context,
-				          block_index_buffer,
-				          4,
-				          error );
-				break;
-
-			case LIBLUKSDE_HASHING_METHOD_SHA256:
-				result = libhmac_sha256_update(
-				          sha256_context,
-				          block_index_buffer,
-				          4,
-				          error );
-				break;
-
-			case LIBLUKSDE_HASHING_METHOD_SHA512:
-				result = libhmac_sha512_update(
-				          sha512_context,
-				          block_index_buffer,
-				          4,
-				          error );
-				break;
-
-			default:
-				result = 0;
-				break;
-		}
-		if( result != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update context.",
-			 function );
-
-			goto on_error;
-		}
-		if( data_size < hash_size )
-		{
-			read_size = data_size;
-		}
-		else
-		{
-			read_size = hash_size;
-		}
-		switch( hashing_method )
-		{
-			case LIBLUKSDE_HASHING_METHOD_SHA1:
-				result = libhmac_sha1_update(
-				          sha1_context,
-				          &( data[ data_offset ] ),
-				          read_size,
-				          error );
-				break;
-
-			case LIBLUKSDE_HASHING_METHOD_SHA256:
-				result = libhmac_sha256_update(
-				          sha256_context,
-				          &( data[ data_offset ] ),
-				          read_size,
-				          error );
-				break;
-
-			case LIBLUKSDE_HASHING_METHOD_SHA512:
-				result = libhmac_sha512_update(
-				          sha512_context,
-				          &( data[ data_offset ] ),
-				          read_size,
-				          error );
-				break;
-
-			default:
-				result = 0;
-				break;
-		}
-		if( result != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update context.",
-			 function );
-
-			goto on_error;
-		}
-		switch( hashing_method )
-		{
-			case LIBLUKSDE_HASHING_METHOD_SHA1:
-				result = libhmac_sha1_finalize(
-				          sha1_context,
-				          hash_buffer,
-				          hash_size,
-				          error );
-				break;
-
-			case LIBLUKSDE_HASHING_METHOD_SHA256:
-				result = libhmac_sha256_finalize(
-				          sha256_context,
-				          hash_buffer,
-				          hash_size,
-				          error );
-				break;
-
-			case LIBLUKSDE_HASHING_METHOD_SHA512:
-				result = libhmac_sha512_finalize(
-				          sha512_context,
-				          hash_buffer,
-				          hash_size,
-				          error );
-				break;
-
-			default:
-				result = 0;
-				break;
-		}
-		if( result != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to finalize context.",
-			 function );
-
-			goto on_error;
-		}
-		switch( hashing_method )
-		{
-			case LIBLUKSDE_HASHING_METHOD_SHA1:
-				result = libhmac_sha1_free(
-				          &sha1_context,
-				          error );
-				break;
-
-			case LIBLUKSDE_HASHING_METHOD_SHA256:
-				result = libhmac_sha256_free(
-				          &sha256_context,
-				          error );
-				break;
-
-			case LIBLUKSDE_HASHING_METHOD_SHA512:
-				result = libhmac_sha512_free(
-				          &sha512_context,
-				          error );
-				break;
-
-			default:
-				result = 0;
-				break;
-		}
-		if( result != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free context.",
-			 function );
-
-			goto on_error;
-		}
-		if( memory_copy(
-		     &( data[ data_offset ] ),
-		     hash_buffer,
-		     read_size ) == NULL)
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy hash to data.",
-			 function );
-
-			goto on_error;
-		}
-		data_offset += read_size;
-		data_size   -= read_size;
+		memory_copy(
+		 &( context->block_data[ 4 ] ),
+		 &( data[ data_offset ] ),
+		 hash_size );
+
+		memory_copy(
+		 context->hash_context.hash_values,
+		 context->initial_hash_values,
+		 sizeof( uint32_t ) * LIBLUKSDE_HASH_MAXIMUM_NUMBER_OF_HASH_VALUES );
+
+		context->hash_context.transform_function(
+		 context->hash_context.hash_values,
+		 context->block_data,
+		 1 );
+
+		libluksde_hash_copy_hash_values(
+		 &( data[ data_offset ] ),
+		 context->hash_context.hash_values,
+		 hash_size,
+		 context->hash_context.byte_order );
+
+		data_offset += hash_size;
 
 		block_index++;
 	}
-	return( 1 );
+	if( context->last_part_size > 0 )
+	{
+		byte_stream_copy_from_uint32_big_endian(
+		 context->last_block_data,
+		 block_index );
 
-on_error:
-	if( sha1_context != NULL )
+		memory_copy(
+		 &( context->last_block_data[ 4 ] ),
+		 &( data[ data_offset ] ),
+		 context->last_part_size );
+
+		memory_copy(
+		 context->hash_context.hash_values,
+		 context->initial_hash_values,
+		 sizeof( uint32_t ) * LIBLUKSDE_HASH_MAXIMUM_NUMBER_OF_HASH_VALUES );
+
+		context->hash_context.transform_function(
+		 context->hash_context.hash_values,
+		 context->last_block_data,
+		 1 );
+
+		libluksde_hash_copy_hash_values(
+		 hash_buffer,
+		 context->hash_context.hash_values,
+		 hash_size,
+		 context->hash_context.byte_order );
+
+		memory_copy(
+		 &( data[ data_offset ] ),
+		 hash_buffer,
+		 context->last_part_size );
+
+		memory_set(
+		 hash_buffer,
+		 0,
+		 LIBLUKSDE_HASH_MAXIMUM_HASH_SIZE );
+	}
+}
+
+/* XORs the split data into the data
+ * The data is processed as 64-bit values, which are copied since the data is not necessarily aligned
+ */
+void libluksde_diffuser_xor_data(
+      uint8_t *data,
+      const uint8_t *split_data,
+      size_t data_size )
+{
+	uint64_t data_value  = 0;
+	uint64_t split_value = 0;
+	size_t data_offset   = 0;
+
+	while( ( data_size - data_offset ) >= 8 )
 	{
-		libhmac_sha1_free(
-		 &sha1_context,
-		 NULL );
+		memory_copy(
+		 &data_value,
+		 &( data[ data_offset ] ),
+		 8 );
+
+		memory_copy(
+		 &split_value,
+		 &( split_data[ data_offset ] ),
+		 8 );
+
+		data_value ^= split_value;
+
+		memory_copy(
+		 &( data[ data_offset ] ),
+		 &data_value,
+		 8 );
+
+		data_offset += 8;
+	}
+	while( data_offset < data_size )
+	{
+		data[ data_offset ] ^= split_data[ data_offset ];
+
+		data_offset++;
 	}
-	if( sha256_context != NULL )
+}
+
+/* Diffuses data
+ * The hashes are calculated with the internal hashing functions, which use the SHA-NI backend if supported
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_diffuser_diffuse(
+     uint8_t *data,
+     size_t data_size,
+     int hashing_method,
+     libcerror_error_t **error )
+{
+	libluksde_diffuser_context_t context;
+
+	static char *function = "libluksde_diffuser_diffuse";
+
+	if( data == NULL )
 	{
-		libhmac_sha256_free(
-		 &sha256_context,
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
 	}
-	if( sha512_context != NULL )
+	if( libluksde_diffuser_context_set_method(
+	     &context,
+	     hashing_method,
+	     data_size,
+	     error ) != 1 )
 	{
-		libhmac_sha512_free(
-		 &sha512_context,
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set diffuser context.",
+		 function );
+
+		return( -1 );
 	}
-	return( -1 );
+	libluksde_diffuser_context_diffuse(
+	 &context,
+	 data );
+
+	memory_set(
+	 &context,
+	 0,
+	 sizeof( libluksde_diffuser_context_t ) );
+
+	return( 1 );
 }
 
 /* Merges the split data using the diffuser
- * Returns 1 if successful or -1 on error
+ * A single diffuser context is used for all the stripes
+ * The progress, if not NULL, is updated after every stripe
+ * Returns 1 if successful, 0 if aborted or -1 on error
  */
 int libluksde_diffuser_merge(
      const uint8_t *split_data,
@@ -362,10 +329,12 @@ int libluksde_diffuser_merge(
      size_t data_size,
      uint32_t number_of_stripes,
      int hashing_method,
+     libluksde_progress_t *progress,
      libcerror_error_t **error )
 {
+	libluksde_diffuser_context_t context;
+
 	static char *function    = "libluksde_diffuser_merge";
-	size_t data_offset       = 0;
 	size_t split_data_offset = 0;
 	uint32_t stripe_iterator = 0;
 
@@ -413,7 +382,8 @@ int libluksde_diffuser_merge(
 
 		return( -1 );
 	}
-	if( ( data_size * (size_t) number_of_stripes ) != split_data_size )
+	if( ( number_of_stripes == 0 )
+	 || ( ( data_size * (size_t) number_of_stripes ) != split_data_size ) )
 	{
 		libcerror_error_set(
 		 error,
@@ -424,6 +394,21 @@ int libluksde_diffuser_merge(
 
 		return( -1 );
 	}
+	if( libluksde_diffuser_context_set_method(
+	     &context,
+	     hashing_method,
+	     data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set diffuser context.",
+		 function );
+
+		return( -1 );
+	}
 	if( memory_set(
 	     data,
 	     0,
@@ -436,45 +421,64 @@ int libluksde_diffuser_merge(
 		 "%s: unable to clear data.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 	for( stripe_iterator = 0;
 	     stripe_iterator < ( number_of_stripes - 1 );
 	     stripe_iterator++ )
 	{
-		for( data_offset = 0;
-		     data_offset < data_size;
-		     data_offset++ )
-		{
-			data[ data_offset ] ^= split_data[ split_data_offset ];
+		libluksde_diffuser_xor_data(
+		 data,
+		 &( split_data[ split_data_offset ] ),
+		 data_size );
 
-			split_data_offset++;
-		}
-		if( libluksde_diffuser_diffuse(
-		     data,
-		     data_size,
-		     LIBLUKSDE_HASHING_METHOD_SHA1,
-		     error ) != 1 )
+		libluksde_diffuser_context_diffuse(
+		 &context,
+		 data );
+
+		split_data_offset += data_size;
+
+		if( progress != NULL )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GENERIC,
-			 "%s: unable to diffuse stripe: %" PRIu32 ".",
-			 function,
-			 stripe_iterator );
-
-			return( -1 );
+			if( libluksde_progress_update(
+			     progress,
+			     (uint64_t) stripe_iterator + 1,
+			     (uint64_t) number_of_stripes ) == 0 )
+			{
+				memory_set(
+				 &context,
+				 0,
+				 sizeof( libluksde_diffuser_context_t ) );
+
+				return( 0 );
+			}
 		}
 	}
-	for( data_offset = 0;
-	     data_offset < data_size;
-	     data_offset++ )
-	{
-		data[ data_offset ] ^= split_data[ split_data_offset ];
+	libluksde_diffuser_xor_data(
+	 data,
+	 &( split_data[ split_data_offset ] ),
+	 data_size );
 
-		split_data_offset++;
+	memory_set(
+	 &context,
+	 0,
+	 sizeof( libluksde_diffuser_context_t ) );
+
+	if( progress != NULL )
+	{
+		return( libluksde_progress_update(
+		         progress,
+		         (uint64_t) number_of_stripes,
+		         (uint64_t) number_of_stripes ) );
 	}
 	return( 1 );
+
+on_error:
+	memory_set(
+	 &context,
+	 0,
+	 sizeof( libluksde_diffuser_context_t ) );
+
+	return( -1 );
 }
 
@@ -25,12 +25,59 @@
 #include <common.h>
 #include <types.h>
 
+#include "libluksde_hash.h"
 #include "libluksde_libcerror.h"
+#include "libluksde_progress.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
+typedef struct libluksde_diffuser_context libluksde_diffuser_context_t;
+
+struct libluksde_diffuser_context
+{
+	/* The hash context
+	 */
+	libluksde_hash_context_t hash_context;
+
+	/* The initial hash values, which are restored before every block
+	 */
+	uint32_t initial_hash_values[ LIBLUKSDE_HASH_MAXIMUM_NUMBER_OF_HASH_VALUES ];
+
+	/* The data size
+	 */
+	size_t data_size;
+
+	/* The size of the last part of the data, which is smaller than the hash size
+	 */
+	size_t last_part_size;
+
+	/* The padded block of a hash-sized part of the data
+	 * The block index and data are stored in front of the padding
+	 */
+	uint8_t block_data[ LIBLUKSDE_HASH_MAXIMUM_BLOCK_SIZE ];
+
+	/* The padded block of the last part of the data
+	 */
+	uint8_t last_block_data[ LIBLUKSDE_HASH_MAXIMUM_BLOCK_SIZE ];
+};
+
+int libluksde_diffuser_context_set_method(
+     libluksde_diffuser_context_t *context,
+     int hashing_method,
+     size_t data_size,
+     libcerror_error_t **error );
+
+void libluksde_diffuser_context_diffuse(
+      libluksde_diffuser_context_t *context,
+      uint8_t *data );
+
+void libluksde_diffuser_xor_data(
+      uint8_t *data,
+      const uint8_t *split_data,
+      size_t data_size );
+
 int libluksde_diffuser_diffuse(
      uint8_t *data,
      size_t data_size,
@@ -44,6 +91,7 @@ int libluksde_diffuser_merge(
      size_t data_size,
      uint32_t number_of_stripes,
      int hashing_method,
+     libluksde_progress_t *progress,
      libcerror_error_t **error );
 
 /* TODO */
@@ -24,12 +24,20 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libluksde_aesni.h"
+#include "libluksde_af_alg.h"
+#include "libluksde_blowfish.h"
+#include "libluksde_cast5.h"
+#include "libluksde_cast6.h"
 #include "libluksde_definitions.h"
 #include "libluksde_encryption.h"
 #include "libluksde_libcaes.h"
 #include "libluksde_libcerror.h"
 #include "libluksde_libcnotify.h"
 #include "libluksde_libhmac.h"
+#include "libluksde_serpent.h"
+#include "libluksde_twofish.h"
+#include "libluksde_unused.h"
 
 /* Creates an encryption context
  * Make sure the value context is referencing, is set to NULL
@@ -68,7 +76,12 @@ int libluksde_encryption_initialize(
 
 		return( -1 );
 	}
-	if( method != LIBLUKSDE_ENCRYPTION_METHOD_AES )
+	if( ( method != LIBLUKSDE_ENCRYPTION_METHOD_AES )
+	 && ( method != LIBLUKSDE_ENCRYPTION_METHOD_BLOWFISH )
+	 && ( method != LIBLUKSDE_ENCRYPTION_METHOD_CAST5 )
+	 && ( method != LIBLUKSDE_ENCRYPTION_METHOD_CAST6 )
+	 && ( method != LIBLUKSDE_ENCRYPTION_METHOD_SERPENT )
+	 && ( method != LIBLUKSDE_ENCRYPTION_METHOD_TWOFISH ) )
 	{
 		libcerror_error_set(
 		 error,
@@ -79,6 +92,21 @@ int libluksde_encryption_initialize(
 
 		return( -1 );
 	}
+	/* XTS is defined for 128-bit block ciphers only
+	 */
+	if( ( chaining_mode == LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS )
+	 && ( ( method == LIBLUKSDE_ENCRYPTION_METHOD_BLOWFISH )
+	  || ( method == LIBLUKSDE_ENCRYPTION_METHOD_CAST5 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported chaining mode for 64-bit block cipher.",
+		 function );
+
+		return( -1 );
+	}
 	*context = memory_allocate_structure(
 	            libluksde_encryption_context_t );
 
@@ -120,6 +148,36 @@ int libluksde_encryption_initialize(
 			          error );
 			break;
 
+		case LIBLUKSDE_ENCRYPTION_METHOD_TWOFISH:
+			result = libluksde_twofish_context_initialize(
+			          &( ( *context )->twofish_context ),
+			          error );
+			break;
+
+		case LIBLUKSDE_ENCRYPTION_METHOD_SERPENT:
+			result = libluksde_serpent_context_initialize(
+			          &( ( *context )->serpent_context ),
+			          error );
+			break;
+
+		case LIBLUKSDE_ENCRYPTION_METHOD_BLOWFISH:
+			result = libluksde_blowfish_context_initialize(
+			          &( ( *context )->blowfish_context ),
+			          error );
+			break;
+
+		case LIBLUKSDE_ENCRYPTION_METHOD_CAST5:
+			result = libluksde_cast5_context_initialize(
+			          &( ( *context )->cast5_context ),
+			          error );
+			break;
+
+		case LIBLUKSDE_ENCRYPTION_METHOD_CAST6:
+			result = libluksde_cast6_context_initialize(
+			          &( ( *context )->cast6_context ),
+			          error );
+			break;
+
 		default:
 			result = 0;
 			break;
@@ -143,6 +201,16 @@ int libluksde_encryption_initialize(
 			          error );
 			break;
 
+		/* The other methods use the same context to de- and encrypt
+		 */
+		case LIBLUKSDE_ENCRYPTION_METHOD_BLOWFISH:
+		case LIBLUKSDE_ENCRYPTION_METHOD_CAST5:
+		case LIBLUKSDE_ENCRYPTION_METHOD_CAST6:
+		case LIBLUKSDE_ENCRYPTION_METHOD_SERPENT:
+		case LIBLUKSDE_ENCRYPTION_METHOD_TWOFISH:
+			result = 1;
+			break;
+
 		default:
 			result = 0;
 			break;
@@ -168,6 +236,36 @@ int libluksde_encryption_initialize(
 					  error );
 				break;
 
+			case LIBLUKSDE_ENCRYPTION_METHOD_TWOFISH:
+				result = libluksde_twofish_context_initialize(
+					  &( ( *context )->twofish_essiv_encryption_context ),
+					  error );
+				break;
+
+			case LIBLUKSDE_ENCRYPTION_METHOD_SERPENT:
+				result = libluksde_serpent_context_initialize(
+					  &( ( *context )->serpent_essiv_encryption_context ),
+					  error );
+				break;
+
+			case LIBLUKSDE_ENCRYPTION_METHOD_BLOWFISH:
+				result = libluksde_blowfish_context_initialize(
+					  &( ( *context )->blowfish_essiv_encryption_context ),
+					  error );
+				break;
+
+			case LIBLUKSDE_ENCRYPTION_METHOD_CAST5:
+				result = libluksde_cast5_context_initialize(
+					  &( ( *context )->cast5_essiv_encryption_context ),
+					  error );
+				break;
+
+			case LIBLUKSDE_ENCRYPTION_METHOD_CAST6:
+				result = libluksde_cast6_context_initialize(
+					  &( ( *context )->cast6_essiv_encryption_context ),
+					  error );
+				break;
+
 			default:
 				result = 0;
 				break;
@@ -184,19 +282,122 @@ int libluksde_encryption_initialize(
 			goto on_error;
 		}
 	}
+	if( chaining_mode == LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS )
+	{
+		switch( method )
+		{
+			case LIBLUKSDE_ENCRYPTION_METHOD_AES:
+				result = libcaes_context_initialize(
+					  &( ( *context )->tweak_encryption_context ),
+					  error );
+				break;
+
+			case LIBLUKSDE_ENCRYPTION_METHOD_TWOFISH:
+				result = libluksde_twofish_context_initialize(
+					  &( ( *context )->twofish_tweak_encryption_context ),
+					  error );
+				break;
+
+			case LIBLUKSDE_ENCRYPTION_METHOD_SERPENT:
+				result = libluksde_serpent_context_initialize(
+					  &( ( *context )->serpent_tweak_encryption_context ),
+					  error );
+				break;
+
+			case LIBLUKSDE_ENCRYPTION_METHOD_CAST6:
+				result = libluksde_cast6_context_initialize(
+					  &( ( *context )->cast6_tweak_encryption_context ),
+					  error );
+				break;
+
+			default:
+				result = 0;
+				break;
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize tweak encryption context.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	( *context )->method                     = method;
 	( *context )->chaining_mode              = chaining_mode;
 	( *context )->initialization_vector_mode = initialization_vector_mode;
 	( *context )->essiv_hashing_method       = essiv_hashing_method;
+	( *context )->backend                    = LIBLUKSDE_ENCRYPTION_BACKEND_GENERIC;
+
+	/* Use the fastest instructions supported by the CPU for the method
+	 */
+	( *context )->aesni_features = libluksde_aesni_get_features();
+
+	if( method == LIBLUKSDE_ENCRYPTION_METHOD_AES )
+	{
+		if( ( ( *context )->aesni_features & LIBLUKSDE_AESNI_FEATURE_FLAG_VAES ) != 0 )
+		{
+			( *context )->backend = LIBLUKSDE_ENCRYPTION_BACKEND_VAES;
+		}
+		else if( ( ( *context )->aesni_features & LIBLUKSDE_AESNI_FEATURE_FLAG_AES ) != 0 )
+		{
+			( *context )->backend = LIBLUKSDE_ENCRYPTION_BACKEND_AESNI;
+		}
+	}
+#if defined( HAVE_LIBLUKSDE_AVX2_SUPPORT )
+	else if( ( ( method == LIBLUKSDE_ENCRYPTION_METHOD_SERPENT )
+	       || ( method == LIBLUKSDE_ENCRYPTION_METHOD_TWOFISH ) )
+	      && ( ( ( *context )->aesni_features & LIBLUKSDE_AESNI_FEATURE_FLAG_AVX2 ) != 0 ) )
+	{
+		( *context )->backend = LIBLUKSDE_ENCRYPTION_BACKEND_AVX2;
+	}
+#endif
+	if( libluksde_encryption_set_crypt_functions(
+	     *context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set crypt functions.",
+		 function );
 
+		goto on_error;
+	}
 	return( 1 );
 
 on_error:
 	if( *context != NULL )
 	{
+		if( ( *context )->essiv_cache_block_keys != NULL )
+		{
+			memory_free(
+			 ( *context )->essiv_cache_block_keys );
+		}
+		if( ( *context )->essiv_cache_data != NULL )
+		{
+			memory_free(
+			 ( *context )->essiv_cache_data );
+		}
 		switch( method )
 		{
 			case LIBLUKSDE_ENCRYPTION_METHOD_AES:
+				if( ( *context )->tweak_encryption_context != NULL )
+				{
+					libcaes_context_free(
+					 &( ( *context )->tweak_encryption_context ),
+					 NULL );
+				}
+				if( ( *context )->essiv_encryption_context != NULL )
+				{
+					libcaes_context_free(
+					 &( ( *context )->essiv_encryption_context ),
+					 NULL );
+				}
 				if( ( *context )->encryption_context != NULL )
 				{
 					libcaes_context_free(
@@ -211,6 +412,99 @@ on_error:
 				}
 				break;
 
+			case LIBLUKSDE_ENCRYPTION_METHOD_TWOFISH:
+				if( ( *context )->twofish_tweak_encryption_context != NULL )
+				{
+					libluksde_twofish_context_free(
+					 &( ( *context )->twofish_tweak_encryption_context ),
+					 NULL );
+				}
+				if( ( *context )->twofish_essiv_encryption_context != NULL )
+				{
+					libluksde_twofish_context_free(
+					 &( ( *context )->twofish_essiv_encryption_context ),
+					 NULL );
+				}
+				if( ( *context )->twofish_context != NULL )
+				{
+					libluksde_twofish_context_free(
+					 &( ( *context )->twofish_context ),
+					 NULL );
+				}
+				break;
+
+			case LIBLUKSDE_ENCRYPTION_METHOD_SERPENT:
+				if( ( *context )->serpent_tweak_encryption_context != NULL )
+				{
+					libluksde_serpent_context_free(
+					 &( ( *context )->serpent_tweak_encryption_context ),
+					 NULL );
+				}
+				if( ( *context )->serpent_essiv_encryption_context != NULL )
+				{
+					libluksde_serpent_context_free(
+					 &( ( *context )->serpent_essiv_encryption_context ),
+					 NULL );
+				}
+				if( ( *context )->serpent_context != NULL )
+				{
+					libluksde_serpent_context_free(
+					 &( ( *context )->serpent_context ),
+					 NULL );
+				}
+				break;
+
+			case LIBLUKSDE_ENCRYPTION_METHOD_BLOWFISH:
+				if( ( *context )->blowfish_essiv_encryption_context != NULL )
+				{
+					libluksde_blowfish_context_free(
+					 &( ( *context )->blowfish_essiv_encryption_context ),
+					 NULL );
+				}
+				if( ( *context )->blowfish_context != NULL )
+				{
+					libluksde_blowfish_context_free(
+					 &( ( *context )->blowfish_context ),
+					 NULL );
+				}
+				break;
+
+			case LIBLUKSDE_ENCRYPTION_METHOD_CAST5:
+				if( ( *context )->cast5_essiv_encryption_context != NULL )
+				{
+					libluksde_cast5_context_free(
+					 &( ( *context )->cast5_essiv_encryption_context ),
+					 NULL );
+				}
+				if( ( *context )->cast5_context != NULL )
+				{
+					libluksde_cast5_context_free(
+					 &( ( *context )->cast5_context ),
+					 NULL );
+				}
+				break;
+
+			case LIBLUKSDE_ENCRYPTION_METHOD_CAST6:
+				if( ( *context )->cast6_tweak_encryption_context != NULL )
+				{
+					libluksde_cast6_context_free(
+					 &( ( *context )->cast6_tweak_encryption_context ),
+					 NULL );
+				}
+				if( ( *context )->cast6_essiv_encryption_context != NULL )
+				{
+					libluksde_cast6_context_free(
+					 &( ( *context )->cast6_essiv_encryption_context ),
+					 NULL );
+				}
+				if( ( *context )->cast6_context != NULL )
+				{
+					libluksde_cast6_context_free(
+					 &( ( *context )->cast6_context ),
+					 NULL );
+				}
+				break;
+
 			default:
 				break;
 		}
@@ -290,241 +584,2769 @@ int libluksde_encryption_free(
 						result = -1;
 					}
 				}
-				break;
+				if( ( *context )->tweak_encryption_context != NULL )
+				{
+					if( libcaes_context_free(
+					     &( ( *context )->tweak_encryption_context ),
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+						 "%s: unable free tweak encryption context.",
+						 function );
 
-			default:
+						result = -1;
+					}
+				}
 				break;
-		}
-		memory_free(
-		 *context );
-
-		*context = NULL;
-	}
-	return( result );
-}
 
-/* Sets the de- and encryption keys
- * Returns 1 if successful or -1 on error
- */
-int libluksde_encryption_set_keys(
-     libluksde_encryption_context_t *context,
-     const uint8_t *key,
-     size_t key_size,
-     libcerror_error_t **error )
-{
-	uint8_t essiv_key[ 32 ];
+			case LIBLUKSDE_ENCRYPTION_METHOD_TWOFISH:
+				if( libluksde_twofish_context_free(
+				     &( ( *context )->twofish_context ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable free Twofish context.",
+					 function );
 
-	static char *function = "libluksde_encryption_set_keys";
-	size_t key_bit_size   = 0;
-	int result            = 0;
+					result = -1;
+				}
+				if( libluksde_twofish_context_free(
+				     &( ( *context )->twofish_essiv_encryption_context ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable free Twofish ESSIV encryption context.",
+					 function );
 
-	if( context == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid context.",
-		 function );
+					result = -1;
+				}
+				if( libluksde_twofish_context_free(
+				     &( ( *context )->twofish_tweak_encryption_context ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable free Twofish tweak encryption context.",
+					 function );
 
-		return( -1 );
-	}
-	if( key == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid key.",
-		 function );
+					result = -1;
+				}
+				break;
 
-		return( -1 );
-	}
-	if( key_size > (size_t) SSIZE_MAX )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid key size value exceeds maximum.",
-		 function );
+			case LIBLUKSDE_ENCRYPTION_METHOD_SERPENT:
+				if( libluksde_serpent_context_free(
+				     &( ( *context )->serpent_context ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable free Serpent context.",
+					 function );
 
-		return( -1 );
-	}
-	key_bit_size = key_size * 8;
+					result = -1;
+				}
+				if( libluksde_serpent_context_free(
+				     &( ( *context )->serpent_essiv_encryption_context ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable free Serpent ESSIV encryption context.",
+					 function );
 
-	switch( context->method )
+					result = -1;
+				}
+				if( libluksde_serpent_context_free(
+				     &( ( *context )->serpent_tweak_encryption_context ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable free Serpent tweak encryption context.",
+					 function );
+
+					result = -1;
+				}
+				break;
+
+			case LIBLUKSDE_ENCRYPTION_METHOD_BLOWFISH:
+				if( libluksde_blowfish_context_free(
+				     &( ( *context )->blowfish_context ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable free Blowfish context.",
+					 function );
+
+					result = -1;
+				}
+				if( libluksde_blowfish_context_free(
+				     &( ( *context )->blowfish_essiv_encryption_context ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable free Blowfish ESSIV encryption context.",
+					 function );
+
+					result = -1;
+				}
+				break;
+
+			case LIBLUKSDE_ENCRYPTION_METHOD_CAST5:
+				if( libluksde_cast5_context_free(
+				     &( ( *context )->cast5_context ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable free CAST5 context.",
+					 function );
+
+					result = -1;
+				}
+				if( libluksde_cast5_context_free(
+				     &( ( *context )->cast5_essiv_encryption_context ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable free CAST5 ESSIV encryption context.",
+					 function );
+
+					result = -1;
+				}
+				break;
+
+			case LIBLUKSDE_ENCRYPTION_METHOD_CAST6:
+				if( libluksde_cast6_context_free(
+				     &( ( *context )->cast6_context ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable free CAST6 context.",
+					 function );
+
+					result = -1;
+				}
+				if( libluksde_cast6_context_free(
+				     &( ( *context )->cast6_essiv_encryption_context ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable free CAST6 ESSIV encryption context.",
+					 function );
+
+					result = -1;
+				}
+				if( libluksde_cast6_context_free(
+				     &( ( *context )->cast6_tweak_encryption_context ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable free CAST6 tweak encryption context.",
+					 function );
+
+					result = -1;
+				}
+				break;
+
+			default:
+				break;
+		}
+#if defined( HAVE_LIBLUKSDE_AF_ALG_SUPPORT )
+		if( ( *context )->af_alg_context != NULL )
+		{
+			if( libluksde_af_alg_context_free(
+			     &( ( *context )->af_alg_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable free kernel crypto API context.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
+		if( ( *context )->essiv_cache_data != NULL )
+		{
+			memory_set(
+			 ( *context )->essiv_cache_data,
+			 0,
+			 ( *context )->essiv_cache_number_of_entries * 16 );
+
+			memory_free(
+			 ( *context )->essiv_cache_data );
+		}
+		if( ( *context )->essiv_cache_block_keys != NULL )
+		{
+			memory_free(
+			 ( *context )->essiv_cache_block_keys );
+		}
+		memory_set(
+		 *context,
+		 0,
+		 sizeof( libluksde_encryption_context_t ) );
+
+		memory_free(
+		 *context );
+
+		*context = NULL;
+	}
+	return( result );
+}
+
+/* Sets the backend
+ * Returns 1 if successful, 0 if the backend is not supported by the CPU or the method or -1 on error
+ */
+int libluksde_encryption_set_backend(
+     libluksde_encryption_context_t *context,
+     int backend,
+     libcerror_error_t **error )
+{
+	static char *function       = "libluksde_encryption_set_backend";
+	int required_features       = 0;
+	uint8_t is_supported_method = 0;
+
+	if( context == NULL )
 	{
-		case LIBLUKSDE_ENCRYPTION_METHOD_AES:
-			result = libcaes_context_set_key(
-			          context->decryption_context,
-			          LIBCAES_CRYPT_MODE_DECRYPT,
-			          key,
-			          key_bit_size,
-			          error );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	switch( backend )
+	{
+		case LIBLUKSDE_ENCRYPTION_BACKEND_GENERIC:
+			is_supported_method = 1;
 			break;
 
-		default:
+		case LIBLUKSDE_ENCRYPTION_BACKEND_AESNI:
+			required_features   = LIBLUKSDE_AESNI_FEATURE_FLAG_AES;
+			is_supported_method = (uint8_t) ( context->method == LIBLUKSDE_ENCRYPTION_METHOD_AES );
+			break;
+
+		case LIBLUKSDE_ENCRYPTION_BACKEND_VAES:
+			required_features   = LIBLUKSDE_AESNI_FEATURE_FLAG_AES
+			                    | LIBLUKSDE_AESNI_FEATURE_FLAG_VAES;
+			is_supported_method = (uint8_t) ( context->method == LIBLUKSDE_ENCRYPTION_METHOD_AES );
+			break;
+
+		case LIBLUKSDE_ENCRYPTION_BACKEND_AVX2:
+			required_features   = LIBLUKSDE_AESNI_FEATURE_FLAG_AVX2;
+			is_supported_method = (uint8_t) ( ( context->method == LIBLUKSDE_ENCRYPTION_METHOD_SERPENT )
+			                               || ( context->method == LIBLUKSDE_ENCRYPTION_METHOD_TWOFISH ) );
 			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported backend.",
+			 function );
+
+			return( -1 );
 	}
-	if( result != 1 )
+	if( ( is_supported_method == 0 )
+	 || ( ( context->aesni_features & required_features ) != required_features ) )
+	{
+		return( 0 );
+	}
+	context->backend = backend;
+
+	if( libluksde_encryption_set_crypt_functions(
+	     context,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set key in decryption context.",
+		 "%s: unable to set crypt functions.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	switch( context->method )
+	return( 1 );
+}
+
+/* Sets the provider
+ * The kernel provider de- and encrypts the sectors using the Linux kernel crypto API,
+ * the initialization vectors are still determined by the library
+ * This function needs to be used before libluksde_encryption_set_keys
+ * Returns 1 if successful, 0 if the provider does not support the method or -1 on error
+ */
+int libluksde_encryption_set_provider(
+     libluksde_encryption_context_t *context,
+     int provider,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_encryption_set_provider";
+	int result            = 0;
+
+	if( context == NULL )
 	{
-		case LIBLUKSDE_ENCRYPTION_METHOD_AES:
-			result = libcaes_context_set_key(
-			          context->encryption_context,
-			          LIBCAES_CRYPT_MODE_ENCRYPT,
-			          key,
-			          key_bit_size,
-			          error );
-			break;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
 
-		default:
-			break;
+		return( -1 );
 	}
-	if( result != 1 )
+	if( ( provider != LIBLUKSDE_ENCRYPTION_PROVIDER_BUILT_IN )
+	 && ( provider != LIBLUKSDE_ENCRYPTION_PROVIDER_KERNEL ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set key in encryption context.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported provider.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( context->initialization_vector_mode == LIBLUKSDE_INITIALIZATION_VECTOR_MODE_ESSIV )
+#if defined( HAVE_LIBLUKSDE_AF_ALG_SUPPORT )
+	if( provider == LIBLUKSDE_ENCRYPTION_PROVIDER_BUILT_IN )
 	{
-		if( memory_set(
-		     essiv_key,
-		     0,
-		     32 ) == NULL )
+		if( context->af_alg_context != NULL )
+		{
+			if( libluksde_af_alg_context_free(
+			     &( context->af_alg_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable free kernel crypto API context.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		result = 1;
+	}
+	else if( context->af_alg_context != NULL )
+	{
+		result = 1;
+	}
+	else
+	{
+		/* The kernel does not support AF_ALG or does not provide the algorithm
+		 */
+		result = libluksde_af_alg_context_initialize(
+		          &( context->af_alg_context ),
+		          context->method,
+		          context->chaining_mode,
+		          error );
+
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-			 "%s: unable to clear ESSIV key.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create kernel crypto API context.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
-		switch( context->essiv_hashing_method )
-		{
-			case LIBLUKSDE_HASHING_METHOD_SHA1:
-	                	result = libhmac_sha1_calculate(
-				          key,
-				          key_size,
-				          essiv_key,
-				          32,
-				          error );
-				break;
+	}
+#else
+	if( provider == LIBLUKSDE_ENCRYPTION_PROVIDER_BUILT_IN )
+	{
+		result = 1;
+	}
+#endif
+	if( libluksde_encryption_set_crypt_functions(
+	     context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set crypt functions.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Sets the number of entries of the ESSIV initialization vector cache
+ * The cache is direct-mapped by sector number, a number of entries of 0 disables the cache
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_encryption_set_essiv_cache_size(
+     libluksde_encryption_context_t *context,
+     size_t number_of_entries,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_encryption_set_essiv_cache_size";
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_entries > (size_t) ( SSIZE_MAX / 16 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of entries value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( context->essiv_cache_data != NULL )
+	{
+		memory_set(
+		 context->essiv_cache_data,
+		 0,
+		 context->essiv_cache_number_of_entries * 16 );
+
+		memory_free(
+		 context->essiv_cache_data );
+
+		context->essiv_cache_data = NULL;
+	}
+	if( context->essiv_cache_block_keys != NULL )
+	{
+		memory_free(
+		 context->essiv_cache_block_keys );
+
+		context->essiv_cache_block_keys = NULL;
+	}
+	context->essiv_cache_number_of_entries = 0;
+
+	if( number_of_entries == 0 )
+	{
+		return( 1 );
+	}
+	context->essiv_cache_block_keys = (uint64_t *) memory_allocate(
+	                                                sizeof( uint64_t ) * number_of_entries );
+
+	if( context->essiv_cache_block_keys == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create ESSIV cache block keys.",
+		 function );
+
+		goto on_error;
+	}
+	context->essiv_cache_data = (uint8_t *) memory_allocate(
+	                                         sizeof( uint8_t ) * number_of_entries * 16 );
+
+	if( context->essiv_cache_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create ESSIV cache data.",
+		 function );
+
+		goto on_error;
+	}
+	context->essiv_cache_number_of_entries = number_of_entries;
+
+	if( libluksde_encryption_clear_essiv_cache(
+	     context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to clear ESSIV cache.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( context->essiv_cache_data != NULL )
+	{
+		memory_free(
+		 context->essiv_cache_data );
+
+		context->essiv_cache_data = NULL;
+	}
+	if( context->essiv_cache_block_keys != NULL )
+	{
+		memory_free(
+		 context->essiv_cache_block_keys );
+
+		context->essiv_cache_block_keys = NULL;
+	}
+	context->essiv_cache_number_of_entries = 0;
+
+	return( -1 );
+}
+
+/* Clears the ESSIV initialization vector cache
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_encryption_clear_essiv_cache(
+     libluksde_encryption_context_t *context,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_encryption_clear_essiv_cache";
+	size_t entry_index    = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( context->essiv_cache_number_of_entries == 0 )
+	{
+		return( 1 );
+	}
+	if( memory_set(
+	     context->essiv_cache_data,
+	     0,
+	     context->essiv_cache_number_of_entries * 16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear ESSIV cache data.",
+		 function );
+
+		return( -1 );
+	}
+	/* Mark every entry as unused, sector number 2^64 - 1 cannot be stored
+	 * in a volume
+	 */
+	for( entry_index = 0;
+	     entry_index < context->essiv_cache_number_of_entries;
+	     entry_index++ )
+	{
+		context->essiv_cache_block_keys[ entry_index ] = (uint64_t) -1;
+	}
+	return( 1 );
+}
+
+/* Sets the decryption keys
+ * Only the key schedules needed to decrypt are determined, which are the decryption,
+ * XTS tweak and ESSIV key schedules, the context cannot be used to encrypt until
+ * the keys are set with libluksde_encryption_set_keys
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_encryption_set_decryption_keys(
+     libluksde_encryption_context_t *context,
+     const uint8_t *key,
+     size_t key_size,
+     libcerror_error_t **error )
+{
+	uint8_t essiv_key[ 32 ];
+
+	static char *function = "libluksde_encryption_set_decryption_keys";
+	size_t essiv_key_size = 0;
+	size_t key_bit_size   = 0;
+	int result            = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key.",
+		 function );
+
+		return( -1 );
+	}
+	if( key_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid key size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	key_bit_size = key_size * 8;
+
+	if( context->chaining_mode == LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS )
+	{
+		/* In XTS the first half of the key is used to de- or encrypt
+		 * the data and the second half to encrypt the tweak value
+		 */
+		if( ( key_size != 32 )
+		 && ( key_size != 64 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported key size.",
+			 function );
+
+			return( -1 );
+		}
+		key_bit_size /= 2;
+	}
+	switch( context->method )
+	{
+		case LIBLUKSDE_ENCRYPTION_METHOD_AES:
+			result = libcaes_context_set_key(
+			          context->decryption_context,
+			          LIBCAES_CRYPT_MODE_DECRYPT,
+			          key,
+			          key_bit_size,
+			          error );
+			break;
+
+		case LIBLUKSDE_ENCRYPTION_METHOD_TWOFISH:
+			result = libluksde_twofish_context_set_key(
+			          context->twofish_context,
+			          key,
+			          key_bit_size,
+			          error );
+			break;
+
+		case LIBLUKSDE_ENCRYPTION_METHOD_SERPENT:
+			result = libluksde_serpent_context_set_key(
+			          context->serpent_context,
+			          key,
+			          key_bit_size,
+			          error );
+			break;
+
+		case LIBLUKSDE_ENCRYPTION_METHOD_BLOWFISH:
+			result = libluksde_blowfish_context_set_key(
+			          context->blowfish_context,
+			          key,
+			          key_bit_size,
+			          error );
+			break;
+
+		case LIBLUKSDE_ENCRYPTION_METHOD_CAST5:
+			result = libluksde_cast5_context_set_key(
+			          context->cast5_context,
+			          key,
+			          key_bit_size,
+			          error );
+			break;
+
+		case LIBLUKSDE_ENCRYPTION_METHOD_CAST6:
+			result = libluksde_cast6_context_set_key(
+			          context->cast6_context,
+			          key,
+			          key_bit_size,
+			          error );
+			break;
+
+		default:
+			break;
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set key in decryption context.",
+		 function );
+
+		goto on_error;
+	}
+	if( context->chaining_mode == LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS )
+	{
+		switch( context->method )
+		{
+			case LIBLUKSDE_ENCRYPTION_METHOD_AES:
+				result = libcaes_context_set_key(
+					  context->tweak_encryption_context,
+					  LIBCAES_CRYPT_MODE_ENCRYPT,
+					  &( key[ key_size / 2 ] ),
+					  key_bit_size,
+					  error );
+				break;
+
+			case LIBLUKSDE_ENCRYPTION_METHOD_TWOFISH:
+				result = libluksde_twofish_context_set_key(
+					  context->twofish_tweak_encryption_context,
+					  &( key[ key_size / 2 ] ),
+					  key_bit_size,
+					  error );
+				break;
+
+			case LIBLUKSDE_ENCRYPTION_METHOD_SERPENT:
+				result = libluksde_serpent_context_set_key(
+					  context->serpent_tweak_encryption_context,
+					  &( key[ key_size / 2 ] ),
+					  key_bit_size,
+					  error );
+				break;
+
+			case LIBLUKSDE_ENCRYPTION_METHOD_CAST6:
+				result = libluksde_cast6_context_set_key(
+					  context->cast6_tweak_encryption_context,
+					  &( key[ key_size / 2 ] ),
+					  key_bit_size,
+					  error );
+				break;
+
+			default:
+				result = 0;
+				break;
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set key in tweak encryption context.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_LIBLUKSDE_AESNI_SUPPORT )
+	/* The AES-NI key schedules are always set when supported by the CPU
+	 * so that the backend can be changed after the keys were set
+	 */
+	if( ( context->method == LIBLUKSDE_ENCRYPTION_METHOD_AES )
+	 && ( ( context->aesni_features & LIBLUKSDE_AESNI_FEATURE_FLAG_AES ) != 0 ) )
+	{
+		if( libluksde_aesni_key_schedule_set_key(
+		     &( context->aesni_decryption_key_schedule ),
+		     LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+		     key,
+		     key_bit_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set key in AES-NI decryption key schedule.",
+			 function );
+
+			goto on_error;
+		}
+		if( context->chaining_mode == LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS )
+		{
+			if( libluksde_aesni_key_schedule_set_key(
+			     &( context->aesni_tweak_encryption_key_schedule ),
+			     LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+			     &( key[ key_size / 2 ] ),
+			     key_bit_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set key in AES-NI tweak encryption key schedule.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+#endif /* defined( HAVE_LIBLUKSDE_AESNI_SUPPORT ) */
+	if( context->initialization_vector_mode == LIBLUKSDE_INITIALIZATION_VECTOR_MODE_ESSIV )
+	{
+		if( memory_set(
+		     essiv_key,
+		     0,
+		     32 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear ESSIV key.",
+			 function );
+
+			goto on_error;
+		}
+		switch( context->essiv_hashing_method )
+		{
+			case LIBLUKSDE_HASHING_METHOD_SHA1:
+	                	result = libhmac_sha1_calculate(
+				          key,
+				          key_size,
+				          essiv_key,
+				          32,
+				          error );
+
+				essiv_key_size = LIBHMAC_SHA1_HASH_SIZE;
+
+				break;
+
+			case LIBLUKSDE_HASHING_METHOD_SHA256:
+	                	result = libhmac_sha256_calculate(
+				          key,
+				          key_size,
+				          essiv_key,
+				          32,
+				          error );
+
+				essiv_key_size = LIBHMAC_SHA256_HASH_SIZE;
+
+				break;
+
+			default:
+				break;
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to compute ESSIV encryption key.",
+			 function );
+
+			goto on_error;
+		}
+		/* The size of the ESSIV key is the size of the hash and not that of the key
+		 */
+		switch( context->method )
+		{
+			case LIBLUKSDE_ENCRYPTION_METHOD_AES:
+				result = libcaes_context_set_key(
+					  context->essiv_encryption_context,
+					  LIBCAES_CRYPT_MODE_ENCRYPT,
+					  essiv_key,
+					  essiv_key_size * 8,
+					  error );
+				break;
+
+			case LIBLUKSDE_ENCRYPTION_METHOD_TWOFISH:
+				result = libluksde_twofish_context_set_key(
+					  context->twofish_essiv_encryption_context,
+					  essiv_key,
+					  essiv_key_size * 8,
+					  error );
+				break;
+
+			case LIBLUKSDE_ENCRYPTION_METHOD_SERPENT:
+				result = libluksde_serpent_context_set_key(
+					  context->serpent_essiv_encryption_context,
+					  essiv_key,
+					  essiv_key_size * 8,
+					  error );
+				break;
+
+			case LIBLUKSDE_ENCRYPTION_METHOD_BLOWFISH:
+				result = libluksde_blowfish_context_set_key(
+					  context->blowfish_essiv_encryption_context,
+					  essiv_key,
+					  essiv_key_size * 8,
+					  error );
+				break;
+
+			case LIBLUKSDE_ENCRYPTION_METHOD_CAST5:
+				result = libluksde_cast5_context_set_key(
+					  context->cast5_essiv_encryption_context,
+					  essiv_key,
+					  essiv_key_size * 8,
+					  error );
+				break;
+
+			case LIBLUKSDE_ENCRYPTION_METHOD_CAST6:
+				result = libluksde_cast6_context_set_key(
+					  context->cast6_essiv_encryption_context,
+					  essiv_key,
+					  essiv_key_size * 8,
+					  error );
+				break;
+
+			default:
+				break;
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set key in ESSIV encryption context.",
+			 function );
+
+			goto on_error;
+		}
+#if defined( HAVE_LIBLUKSDE_AESNI_SUPPORT )
+		if( ( context->method == LIBLUKSDE_ENCRYPTION_METHOD_AES )
+		 && ( ( context->aesni_features & LIBLUKSDE_AESNI_FEATURE_FLAG_AES ) != 0 ) )
+		{
+			if( libluksde_aesni_key_schedule_set_key(
+			     &( context->aesni_essiv_encryption_key_schedule ),
+			     LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+			     essiv_key,
+			     essiv_key_size * 8,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set key in AES-NI ESSIV encryption key schedule.",
+				 function );
+
+				goto on_error;
+			}
+		}
+#endif
+		/* The cached initialization vectors were determined with the previous key
+		 */
+		if( libluksde_encryption_clear_essiv_cache(
+		     context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to clear ESSIV cache.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     essiv_key,
+		     0,
+		     32 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear ESSIV key.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_LIBLUKSDE_AF_ALG_SUPPORT )
+	if( context->af_alg_context != NULL )
+	{
+		result = libluksde_af_alg_context_set_key(
+		          context->af_alg_context,
+		          key,
+		          key_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set key in kernel crypto API context.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			/* Fall back to the built-in implementation if the kernel does not accept the key
+			 */
+			if( libluksde_af_alg_context_free(
+			     &( context->af_alg_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable free kernel crypto API context.",
+				 function );
+
+				goto on_error;
+			}
+			if( libluksde_encryption_set_crypt_functions(
+			     context,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set crypt functions.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+#endif
+	context->encryption_keys_are_set = 0;
+
+	return( 1 );
+
+on_error:
+	if( context->initialization_vector_mode == LIBLUKSDE_INITIALIZATION_VECTOR_MODE_ESSIV )
+	{
+		memory_set(
+		 essiv_key,
+		 0,
+		 32 );
+	}
+	return( -1 );
+}
+
+/* Sets the de- and encryption keys
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_encryption_set_keys(
+     libluksde_encryption_context_t *context,
+     const uint8_t *key,
+     size_t key_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_encryption_set_keys";
+	size_t key_bit_size   = 0;
+	int result            = 0;
+
+	if( libluksde_encryption_set_decryption_keys(
+	     context,
+	     key,
+	     key_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set decryption keys.",
+		 function );
+
+		return( -1 );
+	}
+	key_bit_size = key_size * 8;
+
+	if( context->chaining_mode == LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS )
+	{
+		key_bit_size /= 2;
+	}
+	switch( context->method )
+	{
+		case LIBLUKSDE_ENCRYPTION_METHOD_AES:
+			result = libcaes_context_set_key(
+			          context->encryption_context,
+			          LIBCAES_CRYPT_MODE_ENCRYPT,
+			          key,
+			          key_bit_size,
+			          error );
+			break;
+
+		case LIBLUKSDE_ENCRYPTION_METHOD_BLOWFISH:
+		case LIBLUKSDE_ENCRYPTION_METHOD_CAST5:
+		case LIBLUKSDE_ENCRYPTION_METHOD_CAST6:
+		case LIBLUKSDE_ENCRYPTION_METHOD_SERPENT:
+		case LIBLUKSDE_ENCRYPTION_METHOD_TWOFISH:
+			result = 1;
+			break;
+
+		default:
+			break;
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set key in encryption context.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBLUKSDE_AESNI_SUPPORT )
+	if( ( context->method == LIBLUKSDE_ENCRYPTION_METHOD_AES )
+	 && ( ( context->aesni_features & LIBLUKSDE_AESNI_FEATURE_FLAG_AES ) != 0 ) )
+	{
+		if( libluksde_aesni_key_schedule_set_key(
+		     &( context->aesni_encryption_key_schedule ),
+		     LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+		     key,
+		     key_bit_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set key in AES-NI encryption key schedule.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	context->encryption_keys_are_set = 1;
+
+	return( 1 );
+}
+
+/* Encrypts the block keys of a run of sectors with the ESSIV key
+ * The initialization vectors contain the little-endian block keys and are encrypted in place
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_encryption_encrypt_essiv_block_keys(
+     libluksde_encryption_context_t *context,
+     uint8_t *initialization_vectors,
+     size_t initialization_vectors_size,
+     libcerror_error_t **error )
+{
+	uint8_t block_key_data[ 16 ];
+
+	static char *function = "libluksde_encryption_encrypt_essiv_block_keys";
+	size_t data_offset    = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( context->essiv_encryption_context == NULL )
+	 && ( context->blowfish_essiv_encryption_context == NULL )
+	 && ( context->cast5_essiv_encryption_context == NULL )
+	 && ( context->cast6_essiv_encryption_context == NULL )
+	 && ( context->serpent_essiv_encryption_context == NULL )
+	 && ( context->twofish_essiv_encryption_context == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid context - missing ESSIV encryption context.",
+		 function );
+
+		return( -1 );
+	}
+	if( initialization_vectors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid initialization vectors.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( initialization_vectors_size > (size_t) SSIZE_MAX )
+	 || ( ( initialization_vectors_size % 16 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid initialization vectors size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( context->method == LIBLUKSDE_ENCRYPTION_METHOD_TWOFISH )
+	{
+		if( libluksde_twofish_crypt_ecb(
+		     context->twofish_essiv_encryption_context,
+		     LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+		     (uint8_t) ( context->backend == LIBLUKSDE_ENCRYPTION_BACKEND_AVX2 ),
+		     initialization_vectors,
+		     initialization_vectors_size,
+		     initialization_vectors,
+		     initialization_vectors_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+			 "%s: unable to encrypt initialization vectors.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	if( context->method == LIBLUKSDE_ENCRYPTION_METHOD_SERPENT )
+	{
+		if( libluksde_serpent_crypt_ecb(
+		     context->serpent_essiv_encryption_context,
+		     LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+		     (uint8_t) ( context->backend == LIBLUKSDE_ENCRYPTION_BACKEND_AVX2 ),
+		     initialization_vectors,
+		     initialization_vectors_size,
+		     initialization_vectors,
+		     initialization_vectors_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+			 "%s: unable to encrypt initialization vectors.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	/* The block keys of the 64-bit block ciphers are encrypted as 2 blocks
+	 * of which only the first is used as the initialization vector
+	 */
+	if( context->method == LIBLUKSDE_ENCRYPTION_METHOD_BLOWFISH )
+	{
+		if( libluksde_blowfish_crypt_ecb(
+		     context->blowfish_essiv_encryption_context,
+		     LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+		     initialization_vectors,
+		     initialization_vectors_size,
+		     initialization_vectors,
+		     initialization_vectors_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+			 "%s: unable to encrypt initialization vectors.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	if( context->method == LIBLUKSDE_ENCRYPTION_METHOD_CAST5 )
+	{
+		if( libluksde_cast5_crypt_ecb(
+		     context->cast5_essiv_encryption_context,
+		     LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+		     initialization_vectors,
+		     initialization_vectors_size,
+		     initialization_vectors,
+		     initialization_vectors_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+			 "%s: unable to encrypt initialization vectors.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	if( context->method == LIBLUKSDE_ENCRYPTION_METHOD_CAST6 )
+	{
+		if( libluksde_cast6_crypt_ecb(
+		     context->cast6_essiv_encryption_context,
+		     LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+		     initialization_vectors,
+		     initialization_vectors_size,
+		     initialization_vectors,
+		     initialization_vectors_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+			 "%s: unable to encrypt initialization vectors.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+#if defined( HAVE_LIBLUKSDE_AESNI_SUPPORT )
+	if( context->backend != LIBLUKSDE_ENCRYPTION_BACKEND_GENERIC )
+	{
+		/* All the block keys are encrypted in a single wide ECB pass
+		 */
+		if( libluksde_aesni_crypt_ecb(
+		     &( context->aesni_essiv_encryption_key_schedule ),
+		     LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+		     (uint8_t) ( context->backend == LIBLUKSDE_ENCRYPTION_BACKEND_VAES ),
+		     initialization_vectors,
+		     initialization_vectors_size,
+		     initialization_vectors,
+		     initialization_vectors_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+			 "%s: unable to encrypt initialization vectors.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+#endif
+	while( data_offset < initialization_vectors_size )
+	{
+		if( memory_copy(
+		     block_key_data,
+		     &( initialization_vectors[ data_offset ] ),
+		     16 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy block key data.",
+			 function );
+
+			return( -1 );
+		}
+		if( libcaes_crypt_ecb(
+		     context->essiv_encryption_context,
+		     LIBCAES_CRYPT_MODE_ENCRYPT,
+		     block_key_data,
+		     16,
+		     &( initialization_vectors[ data_offset ] ),
+		     16,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+			 "%s: unable to encrypt initialization vector.",
+			 function );
+
+			return( -1 );
+		}
+		data_offset += 16;
+	}
+	return( 1 );
+}
+
+/* Determines the benbi initialization vectors of a run of sectors
+ * The big-endian block key is stored in the last 8 bytes of the initialization vector
+ */
+static void libluksde_encryption_get_benbi_initialization_vectors(
+            uint8_t *initialization_vectors,
+            uint64_t block_key,
+            size_t number_of_sectors )
+{
+	size_t initialization_vector_offset = 0;
+	size_t sector_index                 = 0;
+
+	for( sector_index = 0;
+	     sector_index < number_of_sectors;
+	     sector_index++ )
+	{
+		byte_stream_copy_from_uint64_big_endian(
+		 &( initialization_vectors[ initialization_vector_offset ] ),
+		 (uint64_t) 0 );
+
+		byte_stream_copy_from_uint64_big_endian(
+		 &( initialization_vectors[ initialization_vector_offset + 8 ] ),
+		 block_key + sector_index );
+
+		initialization_vector_offset += 16;
+	}
+}
+
+/* Determines the null initialization vectors of a run of sectors
+ */
+static void libluksde_encryption_get_null_initialization_vectors(
+            uint8_t *initialization_vectors,
+            uint64_t block_key LIBLUKSDE_ATTRIBUTE_UNUSED,
+            size_t number_of_sectors )
+{
+	LIBLUKSDE_UNREFERENCED_PARAMETER( block_key )
+
+	memory_set(
+	 initialization_vectors,
+	 0,
+	 number_of_sectors * 16 );
+}
+
+/* Determines the plain32 initialization vectors of a run of sectors
+ * The little-endian lower 32-bits of the block key are stored in the first 4 bytes
+ * of the initialization vector
+ */
+static void libluksde_encryption_get_plain32_initialization_vectors(
+            uint8_t *initialization_vectors,
+            uint64_t block_key,
+            size_t number_of_sectors )
+{
+	size_t initialization_vector_offset = 0;
+	size_t sector_index                 = 0;
+
+	for( sector_index = 0;
+	     sector_index < number_of_sectors;
+	     sector_index++ )
+	{
+		byte_stream_copy_from_uint64_little_endian(
+		 &( initialization_vectors[ initialization_vector_offset ] ),
+		 ( block_key + sector_index ) & 0xffffffffUL );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 &( initialization_vectors[ initialization_vector_offset + 8 ] ),
+		 (uint64_t) 0 );
+
+		initialization_vector_offset += 16;
+	}
+}
+
+/* Determines the plain64 initialization vectors of a run of sectors
+ * The little-endian block key is stored in the first 8 bytes of the initialization vector
+ */
+static void libluksde_encryption_get_plain64_initialization_vectors(
+            uint8_t *initialization_vectors,
+            uint64_t block_key,
+            size_t number_of_sectors )
+{
+	size_t initialization_vector_offset = 0;
+	size_t sector_index                 = 0;
+
+	for( sector_index = 0;
+	     sector_index < number_of_sectors;
+	     sector_index++ )
+	{
+		byte_stream_copy_from_uint64_little_endian(
+		 &( initialization_vectors[ initialization_vector_offset ] ),
+		 block_key + sector_index );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 &( initialization_vectors[ initialization_vector_offset + 8 ] ),
+		 (uint64_t) 0 );
+
+		initialization_vector_offset += 16;
+	}
+}
+
+/* Determines the initialization vectors of a run of sectors
+ * The block key is the key of the first sector and is incremented for every subsequent sector
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_encryption_get_initialization_vectors(
+     libluksde_encryption_context_t *context,
+     uint64_t block_key,
+     size_t number_of_sectors,
+     uint8_t *initialization_vectors,
+     size_t initialization_vectors_size,
+     libcerror_error_t **error )
+{
+	static char *function    = "libluksde_encryption_get_initialization_vectors";
+	size_t cache_entry_index = 0;
+	size_t sector_index      = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( initialization_vectors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid initialization vectors.",
+		 function );
+
+		return( -1 );
+	}
+	if( context->initialization_vectors_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid context - unsupported initialization vector mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( initialization_vectors_size > (size_t) SSIZE_MAX )
+	 || ( number_of_sectors > ( initialization_vectors_size / 16 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid initialization vectors size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( context->initialization_vector_mode == LIBLUKSDE_INITIALIZATION_VECTOR_MODE_ESSIV )
+	 && ( context->essiv_cache_number_of_entries > 0 ) )
+	{
+		/* Check if the initialization vectors of all the sectors are cached
+		 */
+		for( sector_index = 0;
+		     sector_index < number_of_sectors;
+		     sector_index++ )
+		{
+			cache_entry_index = (size_t) ( ( block_key + sector_index ) % context->essiv_cache_number_of_entries );
+
+			if( context->essiv_cache_block_keys[ cache_entry_index ] != ( block_key + sector_index ) )
+			{
+				break;
+			}
+			if( memory_copy(
+			     &( initialization_vectors[ sector_index * 16 ] ),
+			     &( context->essiv_cache_data[ cache_entry_index * 16 ] ),
+			     16 ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy cached initialization vector.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( sector_index == number_of_sectors )
+		{
+			return( 1 );
+		}
+	}
+	context->initialization_vectors_function(
+	 initialization_vectors,
+	 block_key,
+	 number_of_sectors );
+
+	if( context->initialization_vector_mode == LIBLUKSDE_INITIALIZATION_VECTOR_MODE_ESSIV )
+	{
+		/* The block key for the initialization vector is encrypted
+		 * with the hash of the key
+		 */
+		if( libluksde_encryption_encrypt_essiv_block_keys(
+		     context,
+		     initialization_vectors,
+		     number_of_sectors * 16,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+			 "%s: unable to encrypt ESSIV block keys.",
+			 function );
+
+			return( -1 );
+		}
+		if( context->essiv_cache_number_of_entries > 0 )
+		{
+			for( sector_index = 0;
+			     sector_index < number_of_sectors;
+			     sector_index++ )
+			{
+				cache_entry_index = (size_t) ( ( block_key + sector_index ) % context->essiv_cache_number_of_entries );
+
+				if( memory_copy(
+				     &( context->essiv_cache_data[ cache_entry_index * 16 ] ),
+				     &( initialization_vectors[ sector_index * 16 ] ),
+				     16 ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy initialization vector to cache.",
+					 function );
+
+					return( -1 );
+				}
+				context->essiv_cache_block_keys[ cache_entry_index ] = block_key + sector_index;
+			}
+		}
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: initialization vectors data:\n",
+		 function );
+		libcnotify_print_data(
+		 initialization_vectors,
+		 number_of_sectors * 16,
+		 0 );
+	}
+#endif
+	return( 1 );
+}
+
+/* De- or encrypts a block of data
+ * The data is handled as a single sector
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_encryption_crypt(
+     libluksde_encryption_context_t *context,
+     int mode,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     uint64_t block_key,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_encryption_crypt";
+
+	if( libluksde_encryption_crypt_sectors(
+	     context,
+	     mode,
+	     input_data,
+	     input_data_size,
+	     output_data,
+	     output_data_size,
+	     block_key,
+	     input_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+		 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+		 "%s: unable to de- or encrypt data.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* De- or encrypts a contiguous run of sectors
+ * The block key is the key of the first sector and is incremented for every subsequent sector
+ * The initialization vectors are determined and the sectors are de- or encrypted once per batch
+ * of sectors instead of once per sector, using the functions resolved for the context
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_encryption_crypt_sectors(
+     libluksde_encryption_context_t *context,
+     int mode,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     uint64_t block_key,
+     size_t bytes_per_sector,
+     libcerror_error_t **error )
+{
+	uint8_t initialization_vectors[ 16 * LIBLUKSDE_MAXIMUM_NUMBER_OF_BATCH_SECTORS ];
+
+	static char *function    = "libluksde_encryption_crypt_sectors";
+	size_t batch_size        = 0;
+	size_t data_offset       = 0;
+	size_t number_of_sectors = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( context->crypt_sectors_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid context - unsupported method or chaining mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( mode != LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT )
+	 && ( mode != LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( mode == LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT )
+	 && ( context->encryption_keys_are_set == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid context - missing encryption keys.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid input data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( bytes_per_sector == 0 )
+	 || ( ( bytes_per_sector % 16 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid bytes per sector value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( input_data_size % bytes_per_sector ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid input data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output data.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data_size < input_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: output data size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	while( data_offset < input_data_size )
+	{
+		number_of_sectors = ( input_data_size - data_offset ) / bytes_per_sector;
+
+		if( number_of_sectors > LIBLUKSDE_MAXIMUM_NUMBER_OF_BATCH_SECTORS )
+		{
+			number_of_sectors = LIBLUKSDE_MAXIMUM_NUMBER_OF_BATCH_SECTORS;
+		}
+		batch_size = number_of_sectors * bytes_per_sector;
+
+		if( libluksde_encryption_get_initialization_vectors(
+		     context,
+		     block_key,
+		     number_of_sectors,
+		     initialization_vectors,
+		     16 * LIBLUKSDE_MAXIMUM_NUMBER_OF_BATCH_SECTORS,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine initialization vectors.",
+			 function );
+
+			return( -1 );
+		}
+		if( context->crypt_sectors_function(
+		     context,
+		     mode,
+		     initialization_vectors,
+		     16 * LIBLUKSDE_MAXIMUM_NUMBER_OF_BATCH_SECTORS,
+		     bytes_per_sector,
+		     &( input_data[ data_offset ] ),
+		     batch_size,
+		     &( output_data[ data_offset ] ),
+		     output_data_size - data_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+			 "%s: unable to de- or encrypt sectors at offset: %" PRIzd ".",
+			 function,
+			 data_offset );
+
+			return( -1 );
+		}
+		block_key   += number_of_sectors;
+		data_offset += batch_size;
+	}
+	return( 1 );
+}
+
+/* The functions below de- or encrypt a batch of sectors for a specific method, chaining mode
+ * and backend. They are resolved by libluksde_encryption_set_crypt_functions and are only
+ * called by libluksde_encryption_crypt_sectors, which has validated the arguments
+ * Returns 1 if successful or -1 on error
+ */
+
+/* De- or encrypts sectors using AES-CBC (libcaes)
+ */
+static int libluksde_encryption_crypt_cbc_aes(
+            libluksde_encryption_context_t *context,
+            int mode,
+            const uint8_t *initialization_vectors,
+            size_t initialization_vectors_size LIBLUKSDE_ATTRIBUTE_UNUSED,
+            size_t bytes_per_sector,
+            const uint8_t *input_data,
+            size_t input_data_size,
+            uint8_t *output_data,
+            size_t output_data_size LIBLUKSDE_ATTRIBUTE_UNUSED,
+            libcerror_error_t **error )
+{
+	libcaes_context_t *aes_context      = context->decryption_context;
+	const uint8_t *sector_data          = NULL;
+	uint8_t *cipher_text_data           = NULL;
+	static char *function               = "libluksde_encryption_crypt_cbc_aes";
+	size_t data_offset                  = 0;
+	size_t initialization_vector_offset = 0;
+	int aes_mode                        = LIBCAES_CRYPT_MODE_DECRYPT;
+
+	LIBLUKSDE_UNREFERENCED_PARAMETER( initialization_vectors_size )
+	LIBLUKSDE_UNREFERENCED_PARAMETER( output_data_size )
+
+	if( mode == LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT )
+	{
+		aes_context = context->encryption_context;
+		aes_mode    = LIBCAES_CRYPT_MODE_ENCRYPT;
+	}
+	/* libcaes does not guarantee that CBC decryption can be done in place,
+	 * hence when decrypting in place the cipher text of every sector is copied
+	 * into a scratch buffer and the sector is decrypted from there
+	 */
+	if( ( aes_mode == LIBCAES_CRYPT_MODE_DECRYPT )
+	 && ( input_data == output_data ) )
+	{
+		cipher_text_data = (uint8_t *) memory_allocate(
+		                                sizeof( uint8_t ) * bytes_per_sector );
+
+		if( cipher_text_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create cipher text data.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	while( data_offset < input_data_size )
+	{
+		sector_data = &( input_data[ data_offset ] );
+
+		if( cipher_text_data != NULL )
+		{
+			if( memory_copy(
+			     cipher_text_data,
+			     sector_data,
+			     bytes_per_sector ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy cipher text data at offset: %" PRIzd ".",
+				 function,
+				 data_offset );
+
+				goto on_error;
+			}
+			sector_data = cipher_text_data;
+		}
+		if( libcaes_crypt_cbc(
+		     aes_context,
+		     aes_mode,
+		     &( initialization_vectors[ initialization_vector_offset ] ),
+		     16,
+		     sector_data,
+		     bytes_per_sector,
+		     &( output_data[ data_offset ] ),
+		     bytes_per_sector,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+			 "%s: unable to de- or encrypt sector at offset: %" PRIzd ".",
+			 function,
+			 data_offset );
+
+			goto on_error;
+		}
+		initialization_vector_offset += 16;
+		data_offset                  += bytes_per_sector;
+	}
+	if( cipher_text_data != NULL )
+	{
+		memory_free(
+		 cipher_text_data );
+	}
+	return( 1 );
+
+on_error:
+	if( cipher_text_data != NULL )
+	{
+		memory_free(
+		 cipher_text_data );
+	}
+	return( -1 );
+}
+
+/* De- or encrypts sectors using AES-ECB (libcaes)
+ */
+static int libluksde_encryption_crypt_ecb_aes(
+            libluksde_encryption_context_t *context,
+            int mode,
+            const uint8_t *initialization_vectors LIBLUKSDE_ATTRIBUTE_UNUSED,
+            size_t initialization_vectors_size LIBLUKSDE_ATTRIBUTE_UNUSED,
+            size_t bytes_per_sector LIBLUKSDE_ATTRIBUTE_UNUSED,
+            const uint8_t *input_data,
+            size_t input_data_size,
+            uint8_t *output_data,
+            size_t output_data_size LIBLUKSDE_ATTRIBUTE_UNUSED,
+            libcerror_error_t **error )
+{
+	libcaes_context_t *aes_context = context->decryption_context;
+	size_t data_offset             = 0;
+	int aes_mode                   = LIBCAES_CRYPT_MODE_DECRYPT;
+
+	LIBLUKSDE_UNREFERENCED_PARAMETER( initialization_vectors )
+	LIBLUKSDE_UNREFERENCED_PARAMETER( initialization_vectors_size )
+	LIBLUKSDE_UNREFERENCED_PARAMETER( bytes_per_sector )
+	LIBLUKSDE_UNREFERENCED_PARAMETER( output_data_size )
+
+	if( mode == LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT )
+	{
+		aes_context = context->encryption_context;
+		aes_mode    = LIBCAES_CRYPT_MODE_ENCRYPT;
+	}
+	/* The libcaes_crypt_ecb function de- or encrypts 16 bytes at a time
+	 */
+	while( data_offset < input_data_size )
+	{
+		if( libcaes_crypt_ecb(
+		     aes_context,
+		     aes_mode,
+		     &( input_data[ data_offset ] ),
+		     16,
+		     &( output_data[ data_offset ] ),
+		     16,
+		     error ) != 1 )
+		{
+			return( -1 );
+		}
+		data_offset += 16;
+	}
+	return( 1 );
+}
+
+/* De- or encrypts sectors using AES-XTS (libcaes)
+ * Every sector has its own 16-byte tweak value, which is encrypted once and multiplied
+ * by alpha for every subsequent 16-byte block
+ */
+static int libluksde_encryption_crypt_xts_aes(
+            libluksde_encryption_context_t *context,
+            int mode,
+            const uint8_t *tweak_values,
+            size_t tweak_values_size LIBLUKSDE_ATTRIBUTE_UNUSED,
+            size_t sector_size,
+            const uint8_t *input_data,
+            size_t input_data_size,
+            uint8_t *output_data,
+            size_t output_data_size LIBLUKSDE_ATTRIBUTE_UNUSED,
+            libcerror_error_t **error )
+{
+	uint8_t block_data[ 16 ];
+	uint8_t encrypted_tweak_value[ 16 ];
+
+	libcaes_context_t *aes_context = context->decryption_context;
+	static char *function          = "libluksde_encryption_crypt_xts_aes";
+	size_t data_offset             = 0;
+	size_t sector_end_offset       = 0;
+	size_t tweak_value_offset      = 0;
+	uint8_t byte_index             = 0;
+	uint8_t carry_bit              = 0;
+	int aes_mode                   = LIBCAES_CRYPT_MODE_DECRYPT;
+
+	LIBLUKSDE_UNREFERENCED_PARAMETER( tweak_values_size )
+	LIBLUKSDE_UNREFERENCED_PARAMETER( output_data_size )
+
+	if( mode == LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT )
+	{
+		aes_context = context->encryption_context;
+		aes_mode    = LIBCAES_CRYPT_MODE_ENCRYPT;
+	}
+	/* Ciphertext stealing is not needed since sectors are a multitude of 16 bytes
+	 */
+	while( data_offset < input_data_size )
+	{
+		if( libcaes_crypt_ecb(
+		     context->tweak_encryption_context,
+		     LIBCAES_CRYPT_MODE_ENCRYPT,
+		     &( tweak_values[ tweak_value_offset ] ),
+		     16,
+		     encrypted_tweak_value,
+		     16,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+			 "%s: unable to encrypt tweak value.",
+			 function );
+
+			goto on_error;
+		}
+		tweak_value_offset += 16;
+		sector_end_offset   = data_offset + sector_size;
+
+		while( data_offset < sector_end_offset )
+		{
+			for( byte_index = 0;
+			     byte_index < 16;
+			     byte_index++ )
+			{
+				block_data[ byte_index ] = input_data[ data_offset + byte_index ] ^ encrypted_tweak_value[ byte_index ];
+			}
+			if( libcaes_crypt_ecb(
+			     aes_context,
+			     aes_mode,
+			     block_data,
+			     16,
+			     &( output_data[ data_offset ] ),
+			     16,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+				 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+				 "%s: unable to de- or encrypt block at offset: %" PRIzd ".",
+				 function,
+				 data_offset );
+
+				goto on_error;
+			}
+			for( byte_index = 0;
+			     byte_index < 16;
+			     byte_index++ )
+			{
+				output_data[ data_offset + byte_index ] ^= encrypted_tweak_value[ byte_index ];
+			}
+			/* Multiply the tweak value by alpha (x) in GF(2^128) where
+			 * the tweak value is stored in little-endian byte order
+			 */
+			carry_bit = encrypted_tweak_value[ 15 ] >> 7;
+
+			for( byte_index = 15;
+			     byte_index > 0;
+			     byte_index-- )
+			{
+				encrypted_tweak_value[ byte_index ] = (uint8_t) ( ( encrypted_tweak_value[ byte_index ] << 1 )
+				                                    | ( encrypted_tweak_value[ byte_index - 1 ] >> 7 ) );
+			}
+			encrypted_tweak_value[ 0 ] <<= 1;
+
+			if( carry_bit != 0 )
+			{
+				encrypted_tweak_value[ 0 ] ^= 0x87;
+			}
+			data_offset += 16;
+		}
+	}
+	if( memory_set(
+	     block_data,
+	     0,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear block data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     encrypted_tweak_value,
+	     0,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear encrypted tweak value.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	memory_set(
+	 block_data,
+	 0,
+	 16 );
+
+	memory_set(
+	 encrypted_tweak_value,
+	 0,
+	 16 );
+
+	return( -1 );
+}
+
+#if defined( HAVE_LIBLUKSDE_AESNI_SUPPORT )
+
+/* De- or encrypts sectors using AES-CBC (AES-NI or VAES)
+ */
+static int libluksde_encryption_crypt_cbc_aesni(
+            libluksde_encryption_context_t *context,
+            int mode,
+            const uint8_t *initialization_vectors,
+            size_t initialization_vectors_size,
+            size_t bytes_per_sector,
+            const uint8_t *input_data,
+            size_t input_data_size,
+            uint8_t *output_data,
+            size_t output_data_size,
+            libcerror_error_t **error )
+{
+	libluksde_aesni_key_schedule_t *key_schedule = &( context->aesni_decryption_key_schedule );
+
+	if( mode == LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT )
+	{
+		key_schedule = &( context->aesni_encryption_key_schedule );
+	}
+	return( libluksde_aesni_crypt_cbc(
+	         key_schedule,
+	         mode,
+	         (uint8_t) ( context->backend == LIBLUKSDE_ENCRYPTION_BACKEND_VAES ),
+	         initialization_vectors,
+	         initialization_vectors_size,
+	         bytes_per_sector,
+	         input_data,
+	         input_data_size,
+	         output_data,
+	         output_data_size,
+	         error ) );
+}
+
+/* De- or encrypts sectors using AES-ECB (AES-NI or VAES)
+ */
+static int libluksde_encryption_crypt_ecb_aesni(
+            libluksde_encryption_context_t *context,
+            int mode,
+            const uint8_t *initialization_vectors LIBLUKSDE_ATTRIBUTE_UNUSED,
+            size_t initialization_vectors_size LIBLUKSDE_ATTRIBUTE_UNUSED,
+            size_t bytes_per_sector LIBLUKSDE_ATTRIBUTE_UNUSED,
+            const uint8_t *input_data,
+            size_t input_data_size,
+            uint8_t *output_data,
+            size_t output_data_size,
+            libcerror_error_t **error )
+{
+	libluksde_aesni_key_schedule_t *key_schedule = &( context->aesni_decryption_key_schedule );
+
+	LIBLUKSDE_UNREFERENCED_PARAMETER( initialization_vectors )
+	LIBLUKSDE_UNREFERENCED_PARAMETER( initialization_vectors_size )
+	LIBLUKSDE_UNREFERENCED_PARAMETER( bytes_per_sector )
+
+	if( mode == LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT )
+	{
+		key_schedule = &( context->aesni_encryption_key_schedule );
+	}
+	return( libluksde_aesni_crypt_ecb(
+	         key_schedule,
+	         mode,
+	         (uint8_t) ( context->backend == LIBLUKSDE_ENCRYPTION_BACKEND_VAES ),
+	         input_data,
+	         input_data_size,
+	         output_data,
+	         output_data_size,
+	         error ) );
+}
+
+/* De- or encrypts sectors using AES-XTS (AES-NI or VAES)
+ */
+static int libluksde_encryption_crypt_xts_aesni(
+            libluksde_encryption_context_t *context,
+            int mode,
+            const uint8_t *tweak_values,
+            size_t tweak_values_size,
+            size_t sector_size,
+            const uint8_t *input_data,
+            size_t input_data_size,
+            uint8_t *output_data,
+            size_t output_data_size,
+            libcerror_error_t **error )
+{
+	libluksde_aesni_key_schedule_t *key_schedule = &( context->aesni_decryption_key_schedule );
+
+	if( mode == LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT )
+	{
+		key_schedule = &( context->aesni_encryption_key_schedule );
+	}
+	return( libluksde_aesni_crypt_xts(
+	         key_schedule,
+	         &( context->aesni_tweak_encryption_key_schedule ),
+	         mode,
+	         (uint8_t) ( context->backend == LIBLUKSDE_ENCRYPTION_BACKEND_VAES ),
+	         tweak_values,
+	         tweak_values_size,
+	         sector_size,
+	         input_data,
+	         input_data_size,
+	         output_data,
+	         output_data_size,
+	         error ) );
+}
+
+#endif /* defined( HAVE_LIBLUKSDE_AESNI_SUPPORT ) */
+
+/* De- or encrypts sectors using Twofish-CBC
+ */
+static int libluksde_encryption_crypt_cbc_twofish(
+            libluksde_encryption_context_t *context,
+            int mode,
+            const uint8_t *initialization_vectors,
+            size_t initialization_vectors_size,
+            size_t bytes_per_sector,
+            const uint8_t *input_data,
+            size_t input_data_size,
+            uint8_t *output_data,
+            size_t output_data_size,
+            libcerror_error_t **error )
+{
+	return( libluksde_twofish_crypt_cbc(
+	         context->twofish_context,
+	         mode,
+	         (uint8_t) ( context->backend == LIBLUKSDE_ENCRYPTION_BACKEND_AVX2 ),
+	         initialization_vectors,
+	         initialization_vectors_size,
+	         bytes_per_sector,
+	         input_data,
+	         input_data_size,
+	         output_data,
+	         output_data_size,
+	         error ) );
+}
+
+/* De- or encrypts sectors using Twofish-ECB
+ */
+static int libluksde_encryption_crypt_ecb_twofish(
+            libluksde_encryption_context_t *context,
+            int mode,
+            const uint8_t *initialization_vectors LIBLUKSDE_ATTRIBUTE_UNUSED,
+            size_t initialization_vectors_size LIBLUKSDE_ATTRIBUTE_UNUSED,
+            size_t bytes_per_sector LIBLUKSDE_ATTRIBUTE_UNUSED,
+            const uint8_t *input_data,
+            size_t input_data_size,
+            uint8_t *output_data,
+            size_t output_data_size,
+            libcerror_error_t **error )
+{
+	LIBLUKSDE_UNREFERENCED_PARAMETER( initialization_vectors )
+	LIBLUKSDE_UNREFERENCED_PARAMETER( initialization_vectors_size )
+	LIBLUKSDE_UNREFERENCED_PARAMETER( bytes_per_sector )
+
+	return( libluksde_twofish_crypt_ecb(
+	         context->twofish_context,
+	         mode,
+	         (uint8_t) ( context->backend == LIBLUKSDE_ENCRYPTION_BACKEND_AVX2 ),
+	         input_data,
+	         input_data_size,
+	         output_data,
+	         output_data_size,
+	         error ) );
+}
+
+/* De- or encrypts sectors using Twofish-XTS
+ */
+static int libluksde_encryption_crypt_xts_twofish(
+            libluksde_encryption_context_t *context,
+            int mode,
+            const uint8_t *tweak_values,
+            size_t tweak_values_size,
+            size_t sector_size,
+            const uint8_t *input_data,
+            size_t input_data_size,
+            uint8_t *output_data,
+            size_t output_data_size,
+            libcerror_error_t **error )
+{
+	return( libluksde_twofish_crypt_xts(
+	         context->twofish_context,
+	         context->twofish_tweak_encryption_context,
+	         mode,
+	         (uint8_t) ( context->backend == LIBLUKSDE_ENCRYPTION_BACKEND_AVX2 ),
+	         tweak_values,
+	         tweak_values_size,
+	         sector_size,
+	         input_data,
+	         input_data_size,
+	         output_data,
+	         output_data_size,
+	         error ) );
+}
+
+/* De- or encrypts sectors using Serpent-CBC
+ */
+static int libluksde_encryption_crypt_cbc_serpent(
+            libluksde_encryption_context_t *context,
+            int mode,
+            const uint8_t *initialization_vectors,
+            size_t initialization_vectors_size,
+            size_t bytes_per_sector,
+            const uint8_t *input_data,
+            size_t input_data_size,
+            uint8_t *output_data,
+            size_t output_data_size,
+            libcerror_error_t **error )
+{
+	return( libluksde_serpent_crypt_cbc(
+	         context->serpent_context,
+	         mode,
+	         (uint8_t) ( context->backend == LIBLUKSDE_ENCRYPTION_BACKEND_AVX2 ),
+	         initialization_vectors,
+	         initialization_vectors_size,
+	         bytes_per_sector,
+	         input_data,
+	         input_data_size,
+	         output_data,
+	         output_data_size,
+	         error ) );
+}
+
+/* De- or encrypts sectors using Serpent-ECB
+ */
+static int libluksde_encryption_crypt_ecb_serpent(
+            libluksde_encryption_context_t *context,
+            int mode,
+            const uint8_t *initialization_vectors LIBLUKSDE_ATTRIBUTE_UNUSED,
+            size_t initialization_vectors_size LIBLUKSDE_ATTRIBUTE_UNUSED,
+            size_t bytes_per_sector LIBLUKSDE_ATTRIBUTE_UNUSED,
+            const uint8_t *input_data,
+            size_t input_data_size,
+            uint8_t *output_data,
+            size_t output_data_size,
+            libcerror_error_t **error )
+{
+	LIBLUKSDE_UNREFERENCED_PARAMETER( initialization_vectors )
+	LIBLUKSDE_UNREFERENCED_PARAMETER( initialization_vectors_size )
+	LIBLUKSDE_UNREFERENCED_PARAMETER( bytes_per_sector )
+
+	return( libluksde_serpent_crypt_ecb(
+	         context->serpent_context,
+	         mode,
+	         (uint8_t) ( context->backend == LIBLUKSDE_ENCRYPTION_BACKEND_AVX2 ),
+	         input_data,
+	         input_data_size,
+	         output_data,
+	         output_data_size,
+	         error ) );
+}
+
+/* De- or encrypts sectors using Serpent-XTS
+ */
+static int libluksde_encryption_crypt_xts_serpent(
+            libluksde_encryption_context_t *context,
+            int mode,
+            const uint8_t *tweak_values,
+            size_t tweak_values_size,
+            size_t sector_size,
+            const uint8_t *input_data,
+            size_t input_data_size,
+            uint8_t *output_data,
+            size_t output_data_size,
+            libcerror_error_t **error )
+{
+	return( libluksde_serpent_crypt_xts(
+	         context->serpent_context,
+	         context->serpent_tweak_encryption_context,
+	         mode,
+	         (uint8_t) ( context->backend == LIBLUKSDE_ENCRYPTION_BACKEND_AVX2 ),
+	         tweak_values,
+	         tweak_values_size,
+	         sector_size,
+	         input_data,
+	         input_data_size,
+	         output_data,
+	         output_data_size,
+	         error ) );
+}
+
+/* De- or encrypts sectors using Blowfish-CBC
+ */
+static int libluksde_encryption_crypt_cbc_blowfish(
+            libluksde_encryption_context_t *context,
+            int mode,
+            const uint8_t *initialization_vectors,
+            size_t initialization_vectors_size,
+            size_t bytes_per_sector,
+            const uint8_t *input_data,
+            size_t input_data_size,
+            uint8_t *output_data,
+            size_t output_data_size,
+            libcerror_error_t **error )
+{
+	return( libluksde_blowfish_crypt_cbc(
+	         context->blowfish_context,
+	         mode,
+	         initialization_vectors,
+	         initialization_vectors_size,
+	         bytes_per_sector,
+	         input_data,
+	         input_data_size,
+	         output_data,
+	         output_data_size,
+	         error ) );
+}
+
+/* De- or encrypts sectors using Blowfish-ECB
+ */
+static int libluksde_encryption_crypt_ecb_blowfish(
+            libluksde_encryption_context_t *context,
+            int mode,
+            const uint8_t *initialization_vectors LIBLUKSDE_ATTRIBUTE_UNUSED,
+            size_t initialization_vectors_size LIBLUKSDE_ATTRIBUTE_UNUSED,
+            size_t bytes_per_sector LIBLUKSDE_ATTRIBUTE_UNUSED,
+            const uint8_t *input_data,
+            size_t input_data_size,
+            uint8_t *output_data,
+            size_t output_data_size,
+            libcerror_error_t **error )
+{
+	LIBLUKSDE_UNREFERENCED_PARAMETER( initialization_vectors )
+	LIBLUKSDE_UNREFERENCED_PARAMETER( initialization_vectors_size )
+	LIBLUKSDE_UNREFERENCED_PARAMETER( bytes_per_sector )
+
+	return( libluksde_blowfish_crypt_ecb(
+	         context->blowfish_context,
+	         mode,
+	         input_data,
+	         input_data_size,
+	         output_data,
+	         output_data_size,
+	         error ) );
+}
 
-			case LIBLUKSDE_HASHING_METHOD_SHA256:
-	                	result = libhmac_sha256_calculate(
-				          key,
-				          key_size,
-				          essiv_key,
-				          32,
-				          error );
-				break;
+/* De- or encrypts sectors using CAST5-CBC
+ */
+static int libluksde_encryption_crypt_cbc_cast5(
+            libluksde_encryption_context_t *context,
+            int mode,
+            const uint8_t *initialization_vectors,
+            size_t initialization_vectors_size,
+            size_t bytes_per_sector,
+            const uint8_t *input_data,
+            size_t input_data_size,
+            uint8_t *output_data,
+            size_t output_data_size,
+            libcerror_error_t **error )
+{
+	return( libluksde_cast5_crypt_cbc(
+	         context->cast5_context,
+	         mode,
+	         initialization_vectors,
+	         initialization_vectors_size,
+	         bytes_per_sector,
+	         input_data,
+	         input_data_size,
+	         output_data,
+	         output_data_size,
+	         error ) );
+}
 
-			default:
-				break;
-		}
-		if( result != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GENERIC,
-			 "%s: unable to compute ESSIV encryption key.",
-			 function );
+/* De- or encrypts sectors using CAST5-ECB
+ */
+static int libluksde_encryption_crypt_ecb_cast5(
+            libluksde_encryption_context_t *context,
+            int mode,
+            const uint8_t *initialization_vectors LIBLUKSDE_ATTRIBUTE_UNUSED,
+            size_t initialization_vectors_size LIBLUKSDE_ATTRIBUTE_UNUSED,
+            size_t bytes_per_sector LIBLUKSDE_ATTRIBUTE_UNUSED,
+            const uint8_t *input_data,
+            size_t input_data_size,
+            uint8_t *output_data,
+            size_t output_data_size,
+            libcerror_error_t **error )
+{
+	LIBLUKSDE_UNREFERENCED_PARAMETER( initialization_vectors )
+	LIBLUKSDE_UNREFERENCED_PARAMETER( initialization_vectors_size )
+	LIBLUKSDE_UNREFERENCED_PARAMETER( bytes_per_sector )
+
+	return( libluksde_cast5_crypt_ecb(
+	         context->cast5_context,
+	         mode,
+	         input_data,
+	         input_data_size,
+	         output_data,
+	         output_data_size,
+	         error ) );
+}
 
-			goto on_error;
-		}
-		switch( context->method )
-		{
-			case LIBLUKSDE_ENCRYPTION_METHOD_AES:
-				result = libcaes_context_set_key(
-					  context->essiv_encryption_context,
-					  LIBCAES_CRYPT_MODE_ENCRYPT,
-					  essiv_key,
-					  key_bit_size,
-					  error );
-				break;
+/* De- or encrypts sectors using CAST6-CBC
+ */
+static int libluksde_encryption_crypt_cbc_cast6(
+            libluksde_encryption_context_t *context,
+            int mode,
+            const uint8_t *initialization_vectors,
+            size_t initialization_vectors_size,
+            size_t bytes_per_sector,
+            const uint8_t *input_data,
+            size_t input_data_size,
+            uint8_t *output_data,
+            size_t output_data_size,
+            libcerror_error_t **error )
+{
+	return( libluksde_cast6_crypt_cbc(
+	         context->cast6_context,
+	         mode,
+	         initialization_vectors,
+	         initialization_vectors_size,
+	         bytes_per_sector,
+	         input_data,
+	         input_data_size,
+	         output_data,
+	         output_data_size,
+	         error ) );
+}
 
-			default:
-				break;
-		}
-		if( result != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set key in ESSIV encryption context.",
-			 function );
+/* De- or encrypts sectors using CAST6-ECB
+ */
+static int libluksde_encryption_crypt_ecb_cast6(
+            libluksde_encryption_context_t *context,
+            int mode,
+            const uint8_t *initialization_vectors LIBLUKSDE_ATTRIBUTE_UNUSED,
+            size_t initialization_vectors_size LIBLUKSDE_ATTRIBUTE_UNUSED,
+            size_t bytes_per_sector LIBLUKSDE_ATTRIBUTE_UNUSED,
+            const uint8_t *input_data,
+            size_t input_data_size,
+            uint8_t *output_data,
+            size_t output_data_size,
+            libcerror_error_t **error )
+{
+	LIBLUKSDE_UNREFERENCED_PARAMETER( initialization_vectors )
+	LIBLUKSDE_UNREFERENCED_PARAMETER( initialization_vectors_size )
+	LIBLUKSDE_UNREFERENCED_PARAMETER( bytes_per_sector )
+
+	return( libluksde_cast6_crypt_ecb(
+	         context->cast6_context,
+	         mode,
+	         input_data,
+	         input_data_size,
+	         output_data,
+	         output_data_size,
+	         error ) );
+}
 
-			goto on_error;
-		}
-		if( memory_set(
-		     essiv_key,
-		     0,
-		     32 ) == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-			 "%s: unable to clear ESSIV key.",
-			 function );
+/* De- or encrypts sectors using CAST6-XTS
+ */
+static int libluksde_encryption_crypt_xts_cast6(
+            libluksde_encryption_context_t *context,
+            int mode,
+            const uint8_t *tweak_values,
+            size_t tweak_values_size,
+            size_t sector_size,
+            const uint8_t *input_data,
+            size_t input_data_size,
+            uint8_t *output_data,
+            size_t output_data_size,
+            libcerror_error_t **error )
+{
+	return( libluksde_cast6_crypt_xts(
+	         context->cast6_context,
+	         context->cast6_tweak_encryption_context,
+	         mode,
+	         tweak_values,
+	         tweak_values_size,
+	         sector_size,
+	         input_data,
+	         input_data_size,
+	         output_data,
+	         output_data_size,
+	         error ) );
+}
 
-			goto on_error;
-		}
-	}
-	return( 1 );
+#if defined( HAVE_LIBLUKSDE_AF_ALG_SUPPORT )
 
-on_error:
-	if( context->initialization_vector_mode == LIBLUKSDE_INITIALIZATION_VECTOR_MODE_ESSIV )
-	{
-		memory_set(
-		 essiv_key,
-		 0,
-		 32 );
-	}
-	return( -1 );
+/* De- or encrypts sectors using the Linux kernel crypto API
+ */
+static int libluksde_encryption_crypt_af_alg(
+            libluksde_encryption_context_t *context,
+            int mode,
+            const uint8_t *initialization_vectors,
+            size_t initialization_vectors_size,
+            size_t bytes_per_sector,
+            const uint8_t *input_data,
+            size_t input_data_size,
+            uint8_t *output_data,
+            size_t output_data_size,
+            libcerror_error_t **error )
+{
+	return( libluksde_af_alg_crypt_sectors(
+	         context->af_alg_context,
+	         mode,
+	         initialization_vectors,
+	         initialization_vectors_size,
+	         bytes_per_sector,
+	         input_data,
+	         input_data_size,
+	         output_data,
+	         output_data_size,
+	         error ) );
 }
 
-/* De- or encrypts a block of data
+#endif /* defined( HAVE_LIBLUKSDE_AF_ALG_SUPPORT ) */
+
+/* Resolves the functions to determine the initialization vectors and to de- or encrypt sectors
+ * from the method, chaining mode, initialization vector mode, backend and provider
+ * This is done when the context is set up, or the backend, provider or keys are changed,
+ * so that reading sectors does not need to dispatch on these values
+ * An unsupported combination leaves the function unset and is reported when used
  * Returns 1 if successful or -1 on error
  */
-int libluksde_encryption_crypt(
+int libluksde_encryption_set_crypt_functions(
      libluksde_encryption_context_t *context,
-     int mode,
-     const uint8_t *input_data,
-     size_t input_data_size,
-     uint8_t *output_data,
-     size_t output_data_size,
-     uint64_t block_key,
      libcerror_error_t **error )
 {
-	uint8_t block_key_data[ 16 ];
-	uint8_t initialization_vector[ 16 ];
-
-	static char *function = "libluksde_encryption_crypt";
-	size_t data_offset    = 0;
-	int result            = 0;
+	static char *function = "libluksde_encryption_set_crypt_functions";
+	uint8_t use_aesni     = 0;
 
 	if( context == NULL )
 	{
@@ -537,260 +3359,160 @@ int libluksde_encryption_crypt(
 
 		return( -1 );
 	}
-	if( ( mode != LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT )
-	 && ( mode != LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT ) )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported mode.",
-		 function );
-
-		return( -1 );
-	}
-	if( output_data_size < input_data_size )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
-		 "%s: output data size value too small.",
-		 function );
-
-		return( -1 );
-	}
-	if( memory_set(
-	     initialization_vector,
-	     0,
-	     16 ) == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to clear initialization vector.",
-		 function );
-
-		return( -1 );
-	}
 	switch( context->initialization_vector_mode )
 	{
 		case LIBLUKSDE_INITIALIZATION_VECTOR_MODE_BENBI:
-			byte_stream_copy_from_uint64_big_endian(
-			 &( initialization_vector[ 8 ] ),
-			 block_key );
-
-			break;
-
-		case LIBLUKSDE_INITIALIZATION_VECTOR_MODE_ESSIV:
-			if( memory_set(
-			     block_key_data,
-			     0,
-			     16 ) == NULL )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_MEMORY,
-				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-				 "%s: unable to clear block key data.",
-				 function );
-
-				return( -1 );
-			}
-			byte_stream_copy_from_uint64_little_endian(
-			 block_key_data,
-			 block_key );
-
-			/* The block key for the initialization vector is encrypted
-			 * with the hash of the key
-			 */
-			if( libcaes_crypt_ecb(
-			     context->essiv_encryption_context,
-			     LIBCAES_CRYPT_MODE_ENCRYPT,
-			     block_key_data,
-			     16,
-			     initialization_vector,
-			     16,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
-				 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
-				 "%s: unable to encrypt initialization vector.",
-				 function );
-
-				return( -1 );
-			}
+			context->initialization_vectors_function = &libluksde_encryption_get_benbi_initialization_vectors;
 			break;
 
 		case LIBLUKSDE_INITIALIZATION_VECTOR_MODE_NULL:
+			context->initialization_vectors_function = &libluksde_encryption_get_null_initialization_vectors;
 			break;
 
 		case LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN32:
-			byte_stream_copy_from_uint32_little_endian(
-			 initialization_vector,
-			 (uint32_t) block_key );
-
+			context->initialization_vectors_function = &libluksde_encryption_get_plain32_initialization_vectors;
 			break;
 
+		/* The ESSIV block keys are encrypted after all of them were determined
+		 */
+		case LIBLUKSDE_INITIALIZATION_VECTOR_MODE_ESSIV:
 		case LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64:
-			byte_stream_copy_from_uint64_little_endian(
-			 initialization_vector,
-			 block_key );
-
+			context->initialization_vectors_function = &libluksde_encryption_get_plain64_initialization_vectors;
 			break;
 
 		default:
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-			 "%s: unsupported initialization vector mode.",
-			 function );
-
-			return( -1 );
+			context->initialization_vectors_function = NULL;
+			break;
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	context->crypt_sectors_function = NULL;
+
+#if defined( HAVE_LIBLUKSDE_AF_ALG_SUPPORT )
+	if( context->af_alg_context != NULL )
 	{
-		libcnotify_printf(
-		 "%s: initialization vector data:\n",
-		 function );
-		libcnotify_print_data(
-		 initialization_vector,
-		 16,
-		 0 );
+		context->crypt_sectors_function = &libluksde_encryption_crypt_af_alg;
+
+		return( 1 );
 	}
 #endif
-	if( mode == LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT )
+#if defined( HAVE_LIBLUKSDE_AESNI_SUPPORT )
+	use_aesni = (uint8_t) ( ( context->backend == LIBLUKSDE_ENCRYPTION_BACKEND_AESNI )
+	                     || ( context->backend == LIBLUKSDE_ENCRYPTION_BACKEND_VAES ) );
+#endif
+	switch( context->chaining_mode )
 	{
-		switch( context->method )
-		{
-			case LIBLUKSDE_ENCRYPTION_METHOD_AES:
-				switch( context->chaining_mode )
-				{
-					case LIBLUKSDE_ENCRYPTION_CHAINING_MODE_CBC:
-						result = libcaes_crypt_cbc(
-							  context->encryption_context,
-							  LIBCAES_CRYPT_MODE_ENCRYPT,
-							  initialization_vector,
-							  16,
-							  input_data,
-							  input_data_size,
-							  output_data,
-							  output_data_size,
-							  error );
+		case LIBLUKSDE_ENCRYPTION_CHAINING_MODE_CBC:
+			switch( context->method )
+			{
+				case LIBLUKSDE_ENCRYPTION_METHOD_AES:
+#if defined( HAVE_LIBLUKSDE_AESNI_SUPPORT )
+					if( use_aesni != 0 )
+					{
+						context->crypt_sectors_function = &libluksde_encryption_crypt_cbc_aesni;
 						break;
+					}
+#endif
+					context->crypt_sectors_function = &libluksde_encryption_crypt_cbc_aes;
+					break;
 
-					case LIBLUKSDE_ENCRYPTION_CHAINING_MODE_ECB:
-						while( data_offset < input_data_size )
-						{
-							/* The libcaes_crypt_ecb function encrypts 16 bytes at a time
-							 */
-							result = libcaes_crypt_ecb(
-								  context->encryption_context,
-								  LIBCAES_CRYPT_MODE_ENCRYPT,
-								  &( input_data[ data_offset ] ),
-								  input_data_size - data_offset,
-								  &( output_data[ data_offset ] ),
-								  output_data_size - data_offset,
-								  error );
-
-							if( result != 1 )
-							{
-								break;
-							}
-							data_offset += 16;
-						}
-						break;
+				case LIBLUKSDE_ENCRYPTION_METHOD_BLOWFISH:
+					context->crypt_sectors_function = &libluksde_encryption_crypt_cbc_blowfish;
+					break;
 
-					default:
-						result = 0;
-						break;
-				}
-				break;
+				case LIBLUKSDE_ENCRYPTION_METHOD_CAST5:
+					context->crypt_sectors_function = &libluksde_encryption_crypt_cbc_cast5;
+					break;
 
-			default:
-				result = 0;
-				break;
-		}
-		if( result != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
-			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
-			 "%s: unable to encrypt output data.",
-			 function );
+				case LIBLUKSDE_ENCRYPTION_METHOD_CAST6:
+					context->crypt_sectors_function = &libluksde_encryption_crypt_cbc_cast6;
+					break;
 
-			return( -1 );
-		}
-	}
-	else
-	{
-		switch( context->method )
-		{
-			case LIBLUKSDE_ENCRYPTION_METHOD_AES:
-				switch( context->chaining_mode )
-				{
-					case LIBLUKSDE_ENCRYPTION_CHAINING_MODE_CBC:
-						result = libcaes_crypt_cbc(
-							  context->decryption_context,
-							  LIBCAES_CRYPT_MODE_DECRYPT,
-							  initialization_vector,
-							  16,
-							  input_data,
-							  input_data_size,
-							  output_data,
-							  output_data_size,
-							  error );
-						break;
+				case LIBLUKSDE_ENCRYPTION_METHOD_SERPENT:
+					context->crypt_sectors_function = &libluksde_encryption_crypt_cbc_serpent;
+					break;
+
+				case LIBLUKSDE_ENCRYPTION_METHOD_TWOFISH:
+					context->crypt_sectors_function = &libluksde_encryption_crypt_cbc_twofish;
+					break;
+
+				default:
+					break;
+			}
+			break;
 
-					case LIBLUKSDE_ENCRYPTION_CHAINING_MODE_ECB:
-						while( data_offset < input_data_size )
-						{
-							/* The libcaes_crypt_ecb function decrypts 16 bytes at a time
-							 */
-							result = libcaes_crypt_ecb(
-								  context->encryption_context,
-								  LIBCAES_CRYPT_MODE_DECRYPT,
-								  &( input_data[ data_offset ] ),
-								  input_data_size - data_offset,
-								  &( output_data[ data_offset ] ),
-								  output_data_size - data_offset,
-								  error );
-
-							if( result != 1 )
-							{
-								break;
-							}
-							data_offset += 16;
-						}
+		case LIBLUKSDE_ENCRYPTION_CHAINING_MODE_ECB:
+			switch( context->method )
+			{
+				case LIBLUKSDE_ENCRYPTION_METHOD_AES:
+#if defined( HAVE_LIBLUKSDE_AESNI_SUPPORT )
+					if( use_aesni != 0 )
+					{
+						context->crypt_sectors_function = &libluksde_encryption_crypt_ecb_aesni;
 						break;
+					}
+#endif
+					context->crypt_sectors_function = &libluksde_encryption_crypt_ecb_aes;
+					break;
+
+				case LIBLUKSDE_ENCRYPTION_METHOD_BLOWFISH:
+					context->crypt_sectors_function = &libluksde_encryption_crypt_ecb_blowfish;
+					break;
+
+				case LIBLUKSDE_ENCRYPTION_METHOD_CAST5:
+					context->crypt_sectors_function = &libluksde_encryption_crypt_ecb_cast5;
+					break;
 
-					default:
-						result = 0;
+				case LIBLUKSDE_ENCRYPTION_METHOD_CAST6:
+					context->crypt_sectors_function = &libluksde_encryption_crypt_ecb_cast6;
+					break;
+
+				case LIBLUKSDE_ENCRYPTION_METHOD_SERPENT:
+					context->crypt_sectors_function = &libluksde_encryption_crypt_ecb_serpent;
+					break;
+
+				case LIBLUKSDE_ENCRYPTION_METHOD_TWOFISH:
+					context->crypt_sectors_function = &libluksde_encryption_crypt_ecb_twofish;
+					break;
+
+				default:
+					break;
+			}
+			break;
+
+		/* XTS is defined for 128-bit block ciphers only
+		 */
+		case LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS:
+			switch( context->method )
+			{
+				case LIBLUKSDE_ENCRYPTION_METHOD_AES:
+#if defined( HAVE_LIBLUKSDE_AESNI_SUPPORT )
+					if( use_aesni != 0 )
+					{
+						context->crypt_sectors_function = &libluksde_encryption_crypt_xts_aesni;
 						break;
-				}
-				break;
+					}
+#endif
+					context->crypt_sectors_function = &libluksde_encryption_crypt_xts_aes;
+					break;
 
-			default:
-				result = 0;
-				break;
-		}
-		if( result != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
-			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
-			 "%s: unable to decrypt output data.",
-			 function );
+				case LIBLUKSDE_ENCRYPTION_METHOD_CAST6:
+					context->crypt_sectors_function = &libluksde_encryption_crypt_xts_cast6;
+					break;
 
-			return( -1 );
-		}
+				case LIBLUKSDE_ENCRYPTION_METHOD_SERPENT:
+					context->crypt_sectors_function = &libluksde_encryption_crypt_xts_serpent;
+					break;
+
+				case LIBLUKSDE_ENCRYPTION_METHOD_TWOFISH:
+					context->crypt_sectors_function = &libluksde_encryption_crypt_xts_twofish;
+					break;
+
+				default:
+					break;
+			}
+			break;
+
+		default:
+			break;
 	}
 	return( 1 );
 }
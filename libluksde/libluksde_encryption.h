@@ -25,8 +25,15 @@
 #include <common.h>
 #include <types.h>
 
+#include "libluksde_aesni.h"
+#include "libluksde_af_alg.h"
+#include "libluksde_blowfish.h"
+#include "libluksde_cast5.h"
+#include "libluksde_cast6.h"
 #include "libluksde_libcaes.h"
 #include "libluksde_libcerror.h"
+#include "libluksde_serpent.h"
+#include "libluksde_twofish.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -38,6 +45,17 @@ enum LIBLUKSDE_ENCRYPTION_CRYPT_MODES
 	LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT   = 1
 };
 
+/* The generic backend is libcaes for AES and the table-driven
+ * implementation for the other methods
+ */
+enum LIBLUKSDE_ENCRYPTION_BACKENDS
+{
+	LIBLUKSDE_ENCRYPTION_BACKEND_GENERIC      = 0,
+	LIBLUKSDE_ENCRYPTION_BACKEND_AESNI        = 1,
+	LIBLUKSDE_ENCRYPTION_BACKEND_VAES         = 2,
+	LIBLUKSDE_ENCRYPTION_BACKEND_AVX2         = 3
+};
+
 typedef struct libluksde_encryption_context libluksde_encryption_context_t;
 
 struct libluksde_encryption_context
@@ -69,6 +87,132 @@ struct libluksde_encryption_context
 	/* The ESSIV encryption context
 	 */
 	libcaes_context_t *essiv_encryption_context;
+
+	/* The XTS tweak encryption context
+	 */
+	libcaes_context_t *tweak_encryption_context;
+
+	/* The Blowfish context, which is used to both de- and encrypt
+	 */
+	libluksde_blowfish_context_t *blowfish_context;
+
+	/* The Blowfish ESSIV encryption context
+	 */
+	libluksde_blowfish_context_t *blowfish_essiv_encryption_context;
+
+	/* The CAST-128 (CAST5) context, which is used to both de- and encrypt
+	 */
+	libluksde_cast5_context_t *cast5_context;
+
+	/* The CAST-128 (CAST5) ESSIV encryption context
+	 */
+	libluksde_cast5_context_t *cast5_essiv_encryption_context;
+
+	/* The CAST-256 (CAST6) context, which is used to both de- and encrypt
+	 */
+	libluksde_cast6_context_t *cast6_context;
+
+	/* The CAST-256 (CAST6) ESSIV encryption context
+	 */
+	libluksde_cast6_context_t *cast6_essiv_encryption_context;
+
+	/* The CAST-256 (CAST6) XTS tweak encryption context
+	 */
+	libluksde_cast6_context_t *cast6_tweak_encryption_context;
+
+	/* The Serpent context, which is used to both de- and encrypt
+	 */
+	libluksde_serpent_context_t *serpent_context;
+
+	/* The Serpent ESSIV encryption context
+	 */
+	libluksde_serpent_context_t *serpent_essiv_encryption_context;
+
+	/* The Serpent XTS tweak encryption context
+	 */
+	libluksde_serpent_context_t *serpent_tweak_encryption_context;
+
+	/* The Twofish context, which is used to both de- and encrypt
+	 */
+	libluksde_twofish_context_t *twofish_context;
+
+	/* The Twofish ESSIV encryption context
+	 */
+	libluksde_twofish_context_t *twofish_essiv_encryption_context;
+
+	/* The Twofish XTS tweak encryption context
+	 */
+	libluksde_twofish_context_t *twofish_tweak_encryption_context;
+
+	/* Value to indicate the encryption keys are set, which is not the case
+	 * if only the decryption keys were set
+	 */
+	uint8_t encryption_keys_are_set;
+
+	/* The backend
+	 */
+	int backend;
+
+	/* The kernel crypto API context, which is set when the kernel provider is used
+	 */
+	libluksde_af_alg_context_t *af_alg_context;
+
+	/* The AES-NI and vector feature flags of the CPU
+	 */
+	int aesni_features;
+
+#if defined( HAVE_LIBLUKSDE_AESNI_SUPPORT )
+	/* The AES-NI decryption key schedule
+	 */
+	libluksde_aesni_key_schedule_t aesni_decryption_key_schedule;
+
+	/* The AES-NI encryption key schedule
+	 */
+	libluksde_aesni_key_schedule_t aesni_encryption_key_schedule;
+
+	/* The AES-NI XTS tweak encryption key schedule
+	 */
+	libluksde_aesni_key_schedule_t aesni_tweak_encryption_key_schedule;
+
+	/* The AES-NI ESSIV encryption key schedule
+	 */
+	libluksde_aesni_key_schedule_t aesni_essiv_encryption_key_schedule;
+#endif
+
+	/* The function to determine the initialization vectors of a run of sectors
+	 * which is resolved from the initialization vector mode
+	 */
+	void (*initialization_vectors_function)(
+	        uint8_t *initialization_vectors,
+	        uint64_t block_key,
+	        size_t number_of_sectors );
+
+	/* The function to de- or encrypt a batch of sectors which is resolved
+	 * from the method, chaining mode, backend and provider
+	 */
+	int (*crypt_sectors_function)(
+	       libluksde_encryption_context_t *context,
+	       int mode,
+	       const uint8_t *initialization_vectors,
+	       size_t initialization_vectors_size,
+	       size_t bytes_per_sector,
+	       const uint8_t *input_data,
+	       size_t input_data_size,
+	       uint8_t *output_data,
+	       size_t output_data_size,
+	       libcerror_error_t **error );
+
+	/* The block keys of the ESSIV initialization vector cache entries
+	 */
+	uint64_t *essiv_cache_block_keys;
+
+	/* The ESSIV initialization vector cache data
+	 */
+	uint8_t *essiv_cache_data;
+
+	/* The number of ESSIV initialization vector cache entries
+	 */
+	size_t essiv_cache_number_of_entries;
 };
 
 int libluksde_encryption_initialize(
@@ -83,12 +227,51 @@ int libluksde_encryption_free(
      libluksde_encryption_context_t **context,
      libcerror_error_t **error );
 
+int libluksde_encryption_set_backend(
+     libluksde_encryption_context_t *context,
+     int backend,
+     libcerror_error_t **error );
+
+int libluksde_encryption_set_provider(
+     libluksde_encryption_context_t *context,
+     int provider,
+     libcerror_error_t **error );
+
+int libluksde_encryption_set_essiv_cache_size(
+     libluksde_encryption_context_t *context,
+     size_t number_of_entries,
+     libcerror_error_t **error );
+
+int libluksde_encryption_clear_essiv_cache(
+     libluksde_encryption_context_t *context,
+     libcerror_error_t **error );
+
+int libluksde_encryption_set_decryption_keys(
+     libluksde_encryption_context_t *context,
+     const uint8_t *key,
+     size_t key_size,
+     libcerror_error_t **error );
+
 int libluksde_encryption_set_keys(
      libluksde_encryption_context_t *context,
      const uint8_t *key,
      size_t key_size,
      libcerror_error_t **error );
 
+int libluksde_encryption_encrypt_essiv_block_keys(
+     libluksde_encryption_context_t *context,
+     uint8_t *initialization_vectors,
+     size_t initialization_vectors_size,
+     libcerror_error_t **error );
+
+int libluksde_encryption_get_initialization_vectors(
+     libluksde_encryption_context_t *context,
+     uint64_t block_key,
+     size_t number_of_sectors,
+     uint8_t *initialization_vectors,
+     size_t initialization_vectors_size,
+     libcerror_error_t **error );
+
 int libluksde_encryption_crypt(
      libluksde_encryption_context_t *context,
      int mode,
@@ -99,6 +282,21 @@ int libluksde_encryption_crypt(
      uint64_t block_key,
      libcerror_error_t **error );
 
+int libluksde_encryption_crypt_sectors(
+     libluksde_encryption_context_t *context,
+     int mode,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     uint64_t block_key,
+     size_t bytes_per_sector,
+     libcerror_error_t **error );
+
+int libluksde_encryption_set_crypt_functions(
+     libluksde_encryption_context_t *context,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -0,0 +1,431 @@
+/*
+ * Hashing functions
+ *
+ * Copyright (C) 2013-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libluksde_definitions.h"
+#include "libluksde_hash.h"
+#include "libluksde_libcerror.h"
+#include "libluksde_ripemd160.h"
+#include "libluksde_sha1.h"
+#include "libluksde_sha256.h"
+#include "libluksde_sha512.h"
+#include "libluksde_shani.h"
+
+/* The default backend, which is determined on first use since the CPUID
+ * instruction can be expensive in a virtual machine
+ * The value is accessed atomically since hash contexts can be set up
+ * concurrently, every thread determines the same backend hence racing
+ * initializations are harmless
+ */
+#if defined( __GNUC__ ) || defined( __clang__ )
+static int libluksde_hash_default_backend = -1;
+
+#define libluksde_hash_default_backend_load() \
+	__atomic_load_n( &libluksde_hash_default_backend, __ATOMIC_RELAXED )
+
+#define libluksde_hash_default_backend_store( backend ) \
+	__atomic_store_n( &libluksde_hash_default_backend, backend, __ATOMIC_RELAXED )
+
+#else
+/* Aligned reads and writes of a volatile int are atomic on the supported platforms
+ */
+static volatile int libluksde_hash_default_backend = -1;
+
+#define libluksde_hash_default_backend_load() \
+	libluksde_hash_default_backend
+
+#define libluksde_hash_default_backend_store( backend ) \
+	libluksde_hash_default_backend = backend
+
+#endif /* defined( __GNUC__ ) || defined( __clang__ ) */
+
+/* Retrieves the default backend
+ * Returns the backend
+ */
+int libluksde_hash_get_default_backend(
+     void )
+{
+	int backend = libluksde_hash_default_backend_load();
+
+	if( backend == -1 )
+	{
+		if( libluksde_shani_is_supported() != 0 )
+		{
+			backend = LIBLUKSDE_HASH_BACKEND_SHANI;
+		}
+		else
+		{
+			backend = LIBLUKSDE_HASH_BACKEND_GENERIC;
+		}
+		libluksde_hash_default_backend_store(
+		 backend );
+	}
+	return( backend );
+}
+
+/* Sets the hashing method and backend of a hash context
+ * This sets the hash values to the initial hash values of the hashing method
+ * The SHA-NI backend only applies to SHA-1, SHA-224 and SHA-256, the other
+ * hashing methods always use the generic compression function
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_hash_context_set_method(
+     libluksde_hash_context_t *context,
+     int hashing_method,
+     int backend,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_hash_context_set_method";
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( backend == LIBLUKSDE_HASH_BACKEND_DEFAULT )
+	{
+		backend = libluksde_hash_get_default_backend();
+	}
+	if( ( backend != LIBLUKSDE_HASH_BACKEND_GENERIC )
+	 && ( backend != LIBLUKSDE_HASH_BACKEND_SHANI ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported backend.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( backend == LIBLUKSDE_HASH_BACKEND_SHANI )
+	 && ( libluksde_shani_is_supported() == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: SHA-NI backend not supported by CPU.",
+		 function );
+
+		return( -1 );
+	}
+	context->block_size = LIBLUKSDE_HASH_BLOCK_SIZE;
+	context->byte_order = _BYTE_STREAM_ENDIAN_BIG;
+
+	switch( hashing_method )
+	{
+		case LIBLUKSDE_HASHING_METHOD_RIPEMD160:
+			libluksde_ripemd160_initialize_hash_values(
+			 context->hash_values );
+
+			context->hash_size          = LIBLUKSDE_RIPEMD160_HASH_SIZE;
+			context->byte_order         = _BYTE_STREAM_ENDIAN_LITTLE;
+			context->transform_function = &libluksde_ripemd160_transform;
+
+			break;
+
+		case LIBLUKSDE_HASHING_METHOD_SHA1:
+			libluksde_sha1_initialize_hash_values(
+			 context->hash_values );
+
+			context->hash_size          = LIBLUKSDE_SHA1_HASH_SIZE;
+			context->transform_function = &libluksde_sha1_transform;
+
+#if defined( HAVE_LIBLUKSDE_SHANI_SUPPORT )
+			if( backend == LIBLUKSDE_HASH_BACKEND_SHANI )
+			{
+				context->transform_function = &libluksde_shani_sha1_transform;
+			}
+#endif
+			break;
+
+		case LIBLUKSDE_HASHING_METHOD_SHA224:
+		case LIBLUKSDE_HASHING_METHOD_SHA256:
+			if( hashing_method == LIBLUKSDE_HASHING_METHOD_SHA224 )
+			{
+				libluksde_sha224_initialize_hash_values(
+				 context->hash_values );
+
+				context->hash_size = LIBLUKSDE_SHA224_HASH_SIZE;
+			}
+			else
+			{
+				libluksde_sha256_initialize_hash_values(
+				 context->hash_values );
+
+				context->hash_size = LIBLUKSDE_SHA256_HASH_SIZE;
+			}
+			context->transform_function = &libluksde_sha256_transform;
+
+#if defined( HAVE_LIBLUKSDE_SHANI_SUPPORT )
+			if( backend == LIBLUKSDE_HASH_BACKEND_SHANI )
+			{
+				context->transform_function = &libluksde_shani_sha256_transform;
+			}
+#endif
+			break;
+
+		case LIBLUKSDE_HASHING_METHOD_SHA512:
+			libluksde_sha512_initialize_hash_values(
+			 context->hash_values );
+
+			context->hash_size          = LIBLUKSDE_SHA512_HASH_SIZE;
+			context->block_size         = LIBLUKSDE_SHA512_BLOCK_SIZE;
+			context->transform_function = &libluksde_sha512_transform;
+
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported hashing method.",
+			 function );
+
+			return( -1 );
+	}
+	return( 1 );
+}
+
+/* Hashes the last part of a message, including the padding
+ * The hash values should contain the state after hashing the preceding data of prefix size bytes
+ */
+void libluksde_hash_context_finalize(
+      libluksde_hash_context_t *context,
+      const uint8_t *data,
+      size_t data_size,
+      uint64_t prefix_size )
+{
+	uint8_t block_data[ 2 * LIBLUKSDE_HASH_MAXIMUM_BLOCK_SIZE ];
+
+	size_t number_of_blocks = data_size / context->block_size;
+	size_t remaining_size   = data_size % context->block_size;
+	size_t padding_size     = 0;
+
+	if( number_of_blocks > 0 )
+	{
+		context->transform_function(
+		 context->hash_values,
+		 data,
+		 number_of_blocks );
+	}
+	/* The message size field is 8 bytes for a 64-byte block and 16 bytes for a 128-byte block
+	 */
+	padding_size = context->block_size;
+
+	if( remaining_size >= ( context->block_size - ( context->block_size / 8 ) ) )
+	{
+		padding_size += context->block_size;
+	}
+	if( remaining_size > 0 )
+	{
+		memory_copy(
+		 block_data,
+		 &( data[ number_of_blocks * context->block_size ] ),
+		 remaining_size );
+	}
+	libluksde_hash_set_padding(
+	 block_data,
+	 remaining_size,
+	 padding_size,
+	 prefix_size + data_size,
+	 context->byte_order );
+
+	context->transform_function(
+	 context->hash_values,
+	 block_data,
+	 padding_size / context->block_size );
+
+	memory_set(
+	 block_data,
+	 0,
+	 2 * LIBLUKSDE_HASH_MAXIMUM_BLOCK_SIZE );
+}
+
+/* Sets the padding of a message that ends at data size bytes in the block data
+ * The padding consists of a 0x80 byte, 0-byte values and the 64-bit number of bits
+ * of the message, which is stored at the end of padding size bytes. Padding of
+ * SHA-512 contains a 128-bit number of bits of which the upper 64 bits are 0
+ */
+void libluksde_hash_set_padding(
+      uint8_t *block_data,
+      size_t data_size,
+      size_t padding_size,
+      uint64_t message_size,
+      uint8_t byte_order )
+{
+	block_data[ data_size ] = 0x80;
+
+	memory_set(
+	 &( block_data[ data_size + 1 ] ),
+	 0,
+	 padding_size - ( data_size + 1 ) - 8 );
+
+	if( byte_order == _BYTE_STREAM_ENDIAN_LITTLE )
+	{
+		byte_stream_copy_from_uint64_little_endian(
+		 &( block_data[ padding_size - 8 ] ),
+		 message_size * 8 );
+	}
+	else
+	{
+		byte_stream_copy_from_uint64_big_endian(
+		 &( block_data[ padding_size - 8 ] ),
+		 message_size * 8 );
+	}
+}
+
+/* Copies the hash values to a byte stream of hash size
+ */
+void libluksde_hash_copy_hash_values(
+      uint8_t *byte_stream,
+      const uint32_t *hash_values,
+      size_t hash_size,
+      uint8_t byte_order )
+{
+	size_t value_index = 0;
+
+	if( byte_order == _BYTE_STREAM_ENDIAN_LITTLE )
+	{
+		for( value_index = 0;
+		     value_index < ( hash_size / 4 );
+		     value_index++ )
+		{
+			byte_stream_copy_from_uint32_little_endian(
+			 &( byte_stream[ value_index * 4 ] ),
+			 hash_values[ value_index ] );
+		}
+	}
+	else
+	{
+		for( value_index = 0;
+		     value_index < ( hash_size / 4 );
+		     value_index++ )
+		{
+			byte_stream_copy_from_uint32_big_endian(
+			 &( byte_stream[ value_index * 4 ] ),
+			 hash_values[ value_index ] );
+		}
+	}
+}
+
+/* Calculates the hash of the data
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_hash_calculate(
+     int hashing_method,
+     int backend,
+     const uint8_t *data,
+     size_t data_size,
+     uint8_t *hash,
+     size_t hash_size,
+     libcerror_error_t **error )
+{
+	libluksde_hash_context_t hash_context;
+
+	static char *function = "libluksde_hash_calculate";
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( libluksde_hash_context_set_method(
+	     &hash_context,
+	     hashing_method,
+	     backend,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set hashing method.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_size < hash_context.hash_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid hash value too small.",
+		 function );
+
+		return( -1 );
+	}
+	libluksde_hash_context_finalize(
+	 &hash_context,
+	 data,
+	 data_size,
+	 0 );
+
+	libluksde_hash_copy_hash_values(
+	 hash,
+	 hash_context.hash_values,
+	 hash_context.hash_size,
+	 hash_context.byte_order );
+
+	return( 1 );
+}
+
@@ -0,0 +1,124 @@
+/*
+ * Hashing functions
+ *
+ * Copyright (C) 2013-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBLUKSDE_HASH_H )
+#define _LIBLUKSDE_HASH_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libluksde_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The block size of the RIPEMD-160, SHA-1, SHA-224 and SHA-256 hashes
+ */
+#define LIBLUKSDE_HASH_BLOCK_SIZE			64
+
+/* The maximum supported block size, hash size and number of 32-bit hash values
+ */
+#define LIBLUKSDE_HASH_MAXIMUM_BLOCK_SIZE		128
+#define LIBLUKSDE_HASH_MAXIMUM_HASH_SIZE		64
+#define LIBLUKSDE_HASH_MAXIMUM_NUMBER_OF_HASH_VALUES	16
+
+/* The default backend is the SHA-NI backend if supported by the CPU
+ * and the generic backend otherwise
+ */
+enum LIBLUKSDE_HASH_BACKENDS
+{
+	LIBLUKSDE_HASH_BACKEND_DEFAULT			= 0,
+	LIBLUKSDE_HASH_BACKEND_GENERIC			= 1,
+	LIBLUKSDE_HASH_BACKEND_SHANI			= 2
+};
+
+typedef struct libluksde_hash_context libluksde_hash_context_t;
+
+struct libluksde_hash_context
+{
+	/* The hash values
+	 */
+	uint32_t hash_values[ LIBLUKSDE_HASH_MAXIMUM_NUMBER_OF_HASH_VALUES ];
+
+	/* The hash size
+	 */
+	size_t hash_size;
+
+	/* The block size
+	 */
+	size_t block_size;
+
+	/* The byte order of the hash values and of the message size in the padding
+	 */
+	uint8_t byte_order;
+
+	/* The function to apply the compression function of the hash to a number of blocks
+	 */
+	void (*transform_function)(
+	        uint32_t *hash_values,
+	        const uint8_t *blocks,
+	        size_t number_of_blocks );
+};
+
+int libluksde_hash_get_default_backend(
+     void );
+
+int libluksde_hash_context_set_method(
+     libluksde_hash_context_t *context,
+     int hashing_method,
+     int backend,
+     libcerror_error_t **error );
+
+void libluksde_hash_context_finalize(
+      libluksde_hash_context_t *context,
+      const uint8_t *data,
+      size_t data_size,
+      uint64_t prefix_size );
+
+void libluksde_hash_set_padding(
+      uint8_t *block_data,
+      size_t data_size,
+      size_t padding_size,
+      uint64_t message_size,
+      uint8_t byte_order );
+
+void libluksde_hash_copy_hash_values(
+      uint8_t *byte_stream,
+      const uint32_t *hash_values,
+      size_t hash_size,
+      uint8_t byte_order );
+
+int libluksde_hash_calculate(
+     int hashing_method,
+     int backend,
+     const uint8_t *data,
+     size_t data_size,
+     uint8_t *hash,
+     size_t hash_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBLUKSDE_HASH_H ) */
+
@@ -116,7 +116,9 @@ int libluksde_io_handle_initialize(
 
 		goto on_error;
 	}
-	( *io_handle )->bytes_per_sector = 512;
+	( *io_handle )->bytes_per_sector                  = 512;
+	( *io_handle )->unlocked_candidate_password_index = -1;
+	( *io_handle )->unlocked_key_slot_index           = -1;
 
 	return( 1 );
 
@@ -189,6 +191,19 @@ int libluksde_io_handle_free(
 			( *io_handle )->user_password      = NULL;
 			( *io_handle )->user_password_size = 0;
 		}
+		if( libluksde_io_handle_free_candidate_passwords(
+		     *io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free candidate passwords.",
+			 function );
+
+			result = -1;
+		}
 		if( libcdata_array_free(
 		     &( ( *io_handle )->key_slots_array ),
 		     (int(*)(intptr_t **, libcerror_error_t **)) &libluksde_key_slot_free,
@@ -251,7 +266,7 @@ int libluksde_io_handle_clear(
 	if( memory_set(
 	     io_handle->master_key,
 	     0,
-	     32 ) == NULL )
+	     64 ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -276,11 +291,77 @@ int libluksde_io_handle_clear(
 
 		result = -1;
 	}
-	io_handle->bytes_per_sector = 512;
+	if( io_handle->key_material_area_data != NULL )
+	{
+		memory_free(
+		 io_handle->key_material_area_data );
+
+		io_handle->key_material_area_data = NULL;
+	}
+	io_handle->key_material_area_offset          = 0;
+	io_handle->key_material_area_size            = 0;
+	io_handle->bytes_per_sector                  = 512;
+	io_handle->unlocked_candidate_password_index = -1;
+	io_handle->unlocked_key_slot_index           = -1;
 
 	return( result );
 }
 
+/* Frees the candidate passwords
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_io_handle_free_candidate_passwords(
+     libluksde_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_io_handle_free_candidate_passwords";
+	int password_index    = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->candidate_passwords != NULL )
+	{
+		for( password_index = 0;
+		     password_index < io_handle->number_of_candidate_passwords;
+		     password_index++ )
+		{
+			if( io_handle->candidate_passwords[ password_index ] != NULL )
+			{
+				memory_set(
+				 io_handle->candidate_passwords[ password_index ],
+				 0,
+				 io_handle->candidate_password_sizes[ password_index ] );
+
+				memory_free(
+				 io_handle->candidate_passwords[ password_index ] );
+			}
+		}
+		memory_free(
+		 io_handle->candidate_passwords );
+
+		io_handle->candidate_passwords = NULL;
+	}
+	if( io_handle->candidate_password_sizes != NULL )
+	{
+		memory_free(
+		 io_handle->candidate_password_sizes );
+
+		io_handle->candidate_password_sizes = NULL;
+	}
+	io_handle->number_of_candidate_passwords = 0;
+
+	return( 1 );
+}
+
 /* Reads the volume header
  * Returns 1 if successful or -1 on error
  */
@@ -743,6 +824,18 @@ int libluksde_io_handle_read_volume_header(
 
 		goto on_error;
 	}
+	if( ( io_handle->master_key_size == 0 )
+	 || ( io_handle->master_key_size > 64 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported master key size.",
+		 function );
+
+		goto on_error;
+	}
 	if( ( ( (luksde_volume_header_t *) volume_header_data )->encryption_method[ 0 ] == 'a' )
 	 || ( ( (luksde_volume_header_t *) volume_header_data )->encryption_method[ 0 ] == 'A' ) )
 	{
@@ -861,9 +954,8 @@ int libluksde_io_handle_read_volume_header(
 		  ||  ( ( (luksde_volume_header_t *) volume_header_data )->encryption_mode[ 2 ] == 'B' ) )
 		 &&   ( ( (luksde_volume_header_t *) volume_header_data )->encryption_mode[ 3 ] == 0 ) )
 		{
-			io_handle->encryption_chaining_mode = LIBLUKSDE_ENCRYPTION_CHAINING_MODE_ECB;
-
-			separator_index = 3;
+			io_handle->encryption_chaining_mode   = LIBLUKSDE_ENCRYPTION_CHAINING_MODE_ECB;
+			io_handle->initialization_vector_mode = LIBLUKSDE_INITIALIZATION_VECTOR_MODE_NULL;
 		}
 	}
 	else if( ( ( (luksde_volume_header_t *) volume_header_data )->encryption_mode[ 0 ] == 'x' )
@@ -1036,6 +1128,13 @@ int libluksde_io_handle_read_volume_header(
 			{
 				io_handle->hashing_method = LIBLUKSDE_HASHING_METHOD_SHA256;
 			}
+			else if( ( ( (luksde_volume_header_t *) volume_header_data )->hashing_method[ 3 ] == '5' )
+			      && ( ( (luksde_volume_header_t *) volume_header_data )->hashing_method[ 4 ] == '1' )
+			      && ( ( (luksde_volume_header_t *) volume_header_data )->hashing_method[ 5 ] == '2' )
+			      && ( ( (luksde_volume_header_t *) volume_header_data )->hashing_method[ 6 ] == 0 ) )
+			{
+				io_handle->hashing_method = LIBLUKSDE_HASHING_METHOD_SHA512;
+			}
 		}
 	}
 	volume_key_slot_data = volume_header_data + sizeof( luksde_volume_header_t );
@@ -1097,6 +1196,23 @@ int libluksde_io_handle_read_volume_header(
 	io_handle->encrypted_volume_size = io_handle->volume_size
 	                                 - io_handle->encrypted_volume_offset;
 
+	if( libluksde_io_handle_read_key_material_area(
+	     io_handle,
+	     file_io_handle,
+	     file_offset,
+	     volume_header_data,
+	     read_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read key material area.",
+		 function );
+
+		goto on_error;
+	}
 	memory_free(
 	 volume_header_data );
 
@@ -1131,11 +1247,247 @@ on_error:
 	return( -1 );
 }
 
-/* Reads a sector
+/* Reads the key material area
+ * The key material of the active key slots is read, together with the volume header,
+ * in a single sequential read so the key slots can be tried from memory
+ * If the key material of a key slot is not within the maximum key material area size
+ * the key material area is not read and the key material is read per key slot
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_io_handle_read_key_material_area(
+     libluksde_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     off64_t file_offset,
+     const uint8_t *volume_header_data,
+     size_t volume_header_data_size,
+     libcerror_error_t **error )
+{
+	libluksde_key_slot_t *key_slot = NULL;
+	static char *function          = "libluksde_io_handle_read_key_material_area";
+	size64_t key_material_end      = 0;
+	size64_t key_material_size     = 0;
+	size64_t key_slot_end          = 0;
+	size_t area_size               = 0;
+	ssize_t read_count             = 0;
+	int key_slot_index             = 0;
+	int number_of_key_slots        = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->key_material_area_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid IO handle - key material area data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( volume_header_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume header data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( volume_header_data_size == 0 )
+	 || ( volume_header_data_size > (size_t) LIBLUKSDE_MAXIMUM_KEY_MATERIAL_AREA_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid volume header data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( io_handle->master_key_size == 0 )
+	 || ( io_handle->master_key_size > 64 ) )
+	{
+		return( 1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     io_handle->key_slots_array,
+	     &number_of_key_slots,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of key slots.",
+		 function );
+
+		return( -1 );
+	}
+	for( key_slot_index = 0;
+	     key_slot_index < number_of_key_slots;
+	     key_slot_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     io_handle->key_slots_array,
+		     key_slot_index,
+		     (intptr_t **) &key_slot,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve key slot: %d.",
+			 function,
+			 key_slot_index );
+
+			return( -1 );
+		}
+		if( ( key_slot == NULL )
+		 || ( key_slot->state != 0x00ac71f3 ) )
+		{
+			continue;
+		}
+		/* The key material size is rounded up to a multitude of the sector size
+		 */
+		key_material_size = (size64_t) io_handle->master_key_size * key_slot->number_of_stripes;
+
+		if( ( key_material_size % io_handle->bytes_per_sector ) != 0 )
+		{
+			key_material_size += io_handle->bytes_per_sector - ( key_material_size % io_handle->bytes_per_sector );
+		}
+		/* The key material offset is stored in sectors
+		 */
+		key_slot_end = ( (size64_t) key_slot->key_material_offset * io_handle->bytes_per_sector )
+		             + key_material_size;
+
+		if( key_slot_end > (size64_t) LIBLUKSDE_MAXIMUM_KEY_MATERIAL_AREA_SIZE )
+		{
+			return( 1 );
+		}
+		if( key_slot_end > key_material_end )
+		{
+			key_material_end = key_slot_end;
+		}
+	}
+	if( ( key_material_end <= (size64_t) volume_header_data_size )
+	 || ( (size64_t) file_offset > io_handle->volume_size )
+	 || ( key_material_end > ( io_handle->volume_size - (size64_t) file_offset ) ) )
+	{
+		return( 1 );
+	}
+	area_size = (size_t) key_material_end;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: reading key material area at offset: %" PRIi64 " (0x%08" PRIx64 ") of size: %" PRIzd "\n",
+		 function,
+		 file_offset,
+		 file_offset,
+		 area_size );
+	}
+#endif
+	io_handle->key_material_area_data = (uint8_t *) memory_allocate(
+	                                                 sizeof( uint8_t ) * area_size );
+
+	if( io_handle->key_material_area_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create key material area data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     io_handle->key_material_area_data,
+	     volume_header_data,
+	     volume_header_data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy volume header data.",
+		 function );
+
+		goto on_error;
+	}
+	/* The key material directly follows the volume header data that was read
+	 */
+	if( libbfio_handle_seek_offset(
+	     file_io_handle,
+	     file_offset + (off64_t) volume_header_data_size,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek key material area offset: %" PRIi64 ".",
+		 function,
+		 file_offset + (off64_t) volume_header_data_size );
+
+		goto on_error;
+	}
+	read_count = libbfio_handle_read_buffer(
+	              file_io_handle,
+	              &( io_handle->key_material_area_data[ volume_header_data_size ] ),
+	              area_size - volume_header_data_size,
+	              error );
+
+	if( read_count != (ssize_t) ( area_size - volume_header_data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read key material area data.",
+		 function );
+
+		goto on_error;
+	}
+	io_handle->key_material_area_offset = file_offset;
+	io_handle->key_material_area_size   = area_size;
+
+	return( 1 );
+
+on_error:
+	if( io_handle->key_material_area_data != NULL )
+	{
+		memory_free(
+		 io_handle->key_material_area_data );
+
+		io_handle->key_material_area_data = NULL;
+	}
+	return( -1 );
+}
+
+/* Reads a chunk
  * Callback function for the volume vector
+ * The chunk is read and decrypted as a single run of sectors, the last chunk
+ * is truncated to the whole sectors within the encrypted volume
  * Returns 1 if successful or -1 on error
  */
-int libluksde_io_handle_read_sector(
+int libluksde_io_handle_read_chunk(
      libluksde_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
      libfdata_vector_t *vector,
@@ -1143,16 +1495,18 @@ int libluksde_io_handle_read_sector(
      int element_index,
      int element_data_file_index LIBLUKSDE_ATTRIBUTE_UNUSED,
      off64_t element_data_offset,
-     size64_t element_data_size LIBLUKSDE_ATTRIBUTE_UNUSED,
+     size64_t element_data_size,
      uint32_t element_data_flags LIBLUKSDE_ATTRIBUTE_UNUSED,
      uint8_t read_flags LIBLUKSDE_ATTRIBUTE_UNUSED,
      libcerror_error_t **error )
 {
 	libluksde_sector_data_t *sector_data = NULL;
-	static char *function                = "libluksde_io_handle_read_sector";
+	static char *function                = "libluksde_io_handle_read_chunk";
+	size64_t chunk_data_size             = 0;
+	off64_t chunk_offset                 = 0;
+	int result                           = 0;
 
 	LIBLUKSDE_UNREFERENCED_PARAMETER( element_data_file_index );
-	LIBLUKSDE_UNREFERENCED_PARAMETER( element_data_size );
 	LIBLUKSDE_UNREFERENCED_PARAMETER( element_data_flags );
 	LIBLUKSDE_UNREFERENCED_PARAMETER( read_flags );
 
@@ -1167,11 +1521,67 @@ int libluksde_io_handle_read_sector(
 
 		return( -1 );
 	}
-/* TODO handle virtual sectors, what about different sector sizes? */
-	if( libluksde_sector_data_initialize(
-	     &sector_data,
-	     (size_t) io_handle->bytes_per_sector,
-	     error ) != 1 )
+	if( io_handle->bytes_per_sector == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing bytes per sector.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_offset = element_data_offset - io_handle->encrypted_volume_offset;
+
+	if( ( chunk_offset < 0 )
+	 || ( (size64_t) chunk_offset >= io_handle->encrypted_volume_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid element data offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_data_size = io_handle->encrypted_volume_size - (size64_t) chunk_offset;
+
+	if( chunk_data_size > element_data_size )
+	{
+		chunk_data_size = element_data_size;
+	}
+	chunk_data_size -= chunk_data_size % io_handle->bytes_per_sector;
+
+	if( ( chunk_data_size == 0 )
+	 || ( chunk_data_size > (size64_t) LIBLUKSDE_MAXIMUM_CHUNK_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->sector_data_pool != NULL )
+	{
+		result = libluksde_sector_data_initialize_from_pool(
+		          &sector_data,
+		          io_handle->sector_data_pool,
+		          (size_t) chunk_data_size,
+		          error );
+	}
+	else
+	{
+		result = libluksde_sector_data_initialize(
+		          &sector_data,
+		          (size_t) chunk_data_size,
+		          error );
+	}
+	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
@@ -1216,7 +1626,7 @@ int libluksde_io_handle_read_sector(
 		 "%s: unable to set sector data as element value.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 	return( 1 );
 
@@ -1230,3 +1640,143 @@ on_error:
 	return( -1 );
 }
 
+/* Reads and decrypts a contiguous run of sectors
+ * The offset is relative to the start of the encrypted volume and must be sector aligned
+ * The encrypted data is read into the data buffer and decrypted in place
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_io_handle_read_sectors(
+     libluksde_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     off64_t offset,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_io_handle_read_sectors";
+	ssize_t read_count    = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->bytes_per_sector == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing bytes per sector.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < 0 )
+	 || ( ( offset % io_handle->bytes_per_sector ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size > (size_t) SSIZE_MAX )
+	 || ( ( data_size % io_handle->bytes_per_sector ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: reading %" PRIzd " bytes of sectors data at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+		 function,
+		 data_size,
+		 io_handle->encrypted_volume_offset + offset,
+		 io_handle->encrypted_volume_offset + offset );
+	}
+#endif
+	if( libbfio_handle_seek_offset(
+	     file_io_handle,
+	     io_handle->encrypted_volume_offset + offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek sectors data offset: %" PRIi64 ".",
+		 function,
+		 io_handle->encrypted_volume_offset + offset );
+
+		return( -1 );
+	}
+	read_count = libbfio_handle_read_buffer(
+	              file_io_handle,
+	              data,
+	              data_size,
+	              error );
+
+	if( read_count != (ssize_t) data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read sectors data.",
+		 function );
+
+		return( -1 );
+	}
+	if( libluksde_encryption_crypt_sectors(
+	     io_handle->encryption_context,
+	     LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	     data,
+	     data_size,
+	     data,
+	     data_size,
+	     (uint64_t) ( offset / io_handle->bytes_per_sector ),
+	     (size_t) io_handle->bytes_per_sector,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+		 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+		 "%s: unable to decrypt sectors data.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
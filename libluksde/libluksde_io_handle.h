@@ -31,6 +31,7 @@
 #include "libluksde_libcerror.h"
 #include "libluksde_libfcache.h"
 #include "libluksde_libfdata.h"
+#include "libluksde_sector_data_pool.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -84,7 +85,7 @@ struct libluksde_io_handle
 
 	/* The master key
 	 */
-	uint8_t master_key[ 32 ];
+	uint8_t master_key[ 64 ];
 
 	/* The master key size
 	 */
@@ -102,14 +103,52 @@ struct libluksde_io_handle
 	 */
 	uint32_t master_key_number_of_iterations;
 
+	/* The encryption provider
+	 */
+	int encryption_provider;
+
+	/* The number of entries of the ESSIV initialization vector cache
+	 */
+	int number_of_essiv_cache_entries;
+
+	/* The key derivation progress callback function
+	 */
+	int (*progress_callback_function)(
+	       void *callback_data,
+	       int key_slot_index,
+	       int stage,
+	       uint64_t value,
+	       uint64_t maximum_value );
+
+	/* The key derivation progress callback data
+	 */
+	void *progress_callback_data;
+
 	/* The encryption context
 	 */
 	libluksde_encryption_context_t *encryption_context;
 
+	/* The sector data pool, which recycles the blocks of the cached sector data
+	 */
+	libluksde_sector_data_pool_t *sector_data_pool;
+
 	/* The key slots array
 	 */
 	libcdata_array_t *key_slots_array;
 
+	/* The key material area data, which contains the volume header
+	 * and the key material of the active key slots
+	 */
+	uint8_t *key_material_area_data;
+
+	/* The key material area offset
+	 */
+	off64_t key_material_area_offset;
+
+	/* The key material area size
+	 */
+	size_t key_material_area_size;
+
 	/* The user password
 	 */
 	uint8_t *user_password;
@@ -122,6 +161,28 @@ struct libluksde_io_handle
 	 */
 	uint8_t user_password_is_set;
 
+	/* The candidate passwords
+	 */
+	uint8_t **candidate_passwords;
+
+	/* The candidate password sizes
+	 */
+	size_t *candidate_password_sizes;
+
+	/* The number of candidate passwords
+	 */
+	int number_of_candidate_passwords;
+
+	/* The index of the candidate password that unlocked the volume
+	 * or -1 if the volume was not unlocked with a candidate password
+	 */
+	int unlocked_candidate_password_index;
+
+	/* The index of the key slot that unlocked the volume
+	 * or -1 if the volume was not unlocked with a key slot
+	 */
+	int unlocked_key_slot_index;
+
 	/* Value to indicate the keys are set
 	 */
 	uint8_t keys_are_set;
@@ -129,6 +190,13 @@ struct libluksde_io_handle
 	/* Value to indicate if abort was signalled
 	 */
 	int abort;
+
+	/* Value to indicate if trying the key slots should stop, which is set
+	 * when abort was signalled or when one of the key slots was unlocked
+	 * The value is shared by the key slot trials and must be accessed with
+	 * libluksde_progress_get_abort and libluksde_progress_set_abort
+	 */
+	int key_slots_abort;
 };
 
 int libluksde_io_handle_initialize(
@@ -143,13 +211,25 @@ int libluksde_io_handle_clear(
      libluksde_io_handle_t *io_handle,
      libcerror_error_t **error );
 
+int libluksde_io_handle_free_candidate_passwords(
+     libluksde_io_handle_t *io_handle,
+     libcerror_error_t **error );
+
 int libluksde_io_handle_read_volume_header(
      libluksde_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
      off64_t file_offset,
      libcerror_error_t **error );
 
-int libluksde_io_handle_read_sector(
+int libluksde_io_handle_read_key_material_area(
+     libluksde_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     off64_t file_offset,
+     const uint8_t *volume_header_data,
+     size_t volume_header_data_size,
+     libcerror_error_t **error );
+
+int libluksde_io_handle_read_chunk(
      libluksde_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
      libfdata_vector_t *vector,
@@ -162,6 +242,14 @@ int libluksde_io_handle_read_sector(
      uint8_t read_flags,
      libcerror_error_t **error );
 
+int libluksde_io_handle_read_sectors(
+     libluksde_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     off64_t offset,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
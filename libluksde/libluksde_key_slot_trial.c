@@ -0,0 +1,194 @@
+/*
+ * Key slot trial functions
+ *
+ * Copyright (C) 2013-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libluksde_definitions.h"
+#include "libluksde_key_slot.h"
+#include "libluksde_key_slot_trial.h"
+#include "libluksde_libcerror.h"
+
+/* Creates a key slot trial
+ * Make sure the value key_slot_trial is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_key_slot_trial_initialize(
+     libluksde_key_slot_trial_t **key_slot_trial,
+     int key_slot_index,
+     libluksde_key_slot_t *key_slot,
+     size_t key_material_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_key_slot_trial_initialize";
+
+	if( key_slot_trial == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key slot trial.",
+		 function );
+
+		return( -1 );
+	}
+	if( *key_slot_trial != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid key slot trial value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( key_slot == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key slot.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( key_material_size == 0 )
+	 || ( key_material_size > LIBLUKSDE_MAXIMUM_KEY_MATERIAL_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid key material size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*key_slot_trial = memory_allocate_structure(
+	                   libluksde_key_slot_trial_t );
+
+	if( *key_slot_trial == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create key slot trial.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *key_slot_trial,
+	     0,
+	     sizeof( libluksde_key_slot_trial_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear key slot trial.",
+		 function );
+
+		goto on_error;
+	}
+	( *key_slot_trial )->key_material_data = (uint8_t *) memory_allocate(
+	                                                      sizeof( uint8_t ) * key_material_size );
+
+	if( ( *key_slot_trial )->key_material_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create key material data.",
+		 function );
+
+		goto on_error;
+	}
+	( *key_slot_trial )->key_slot_index    = key_slot_index;
+	( *key_slot_trial )->key_slot          = key_slot;
+	( *key_slot_trial )->key_material_size = key_material_size;
+
+	return( 1 );
+
+on_error:
+	if( *key_slot_trial != NULL )
+	{
+		memory_free(
+		 *key_slot_trial );
+
+		*key_slot_trial = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a key slot trial
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_key_slot_trial_free(
+     libluksde_key_slot_trial_t **key_slot_trial,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_key_slot_trial_free";
+
+	if( key_slot_trial == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key slot trial.",
+		 function );
+
+		return( -1 );
+	}
+	if( *key_slot_trial != NULL )
+	{
+		/* The key slot is referenced and not managed by the key slot trial
+		 */
+		if( ( *key_slot_trial )->key_material_data != NULL )
+		{
+			memory_free(
+			 ( *key_slot_trial )->key_material_data );
+		}
+		if( ( *key_slot_trial )->error != NULL )
+		{
+			libcerror_error_free(
+			 &( ( *key_slot_trial )->error ) );
+		}
+		memory_set(
+		 ( *key_slot_trial )->master_key,
+		 0,
+		 64 );
+
+		memory_free(
+		 *key_slot_trial );
+
+		*key_slot_trial = NULL;
+	}
+	return( 1 );
+}
+
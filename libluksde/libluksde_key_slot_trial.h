@@ -0,0 +1,87 @@
+/*
+ * Key slot trial functions
+ *
+ * Copyright (C) 2013-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBLUKSDE_KEY_SLOT_TRIAL_H )
+#define _LIBLUKSDE_KEY_SLOT_TRIAL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libluksde_key_slot.h"
+#include "libluksde_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libluksde_key_slot_trial libluksde_key_slot_trial_t;
+
+/* A key slot trial contains the state of trying to unlock a single key slot,
+ * which allows the key slots to be tried concurrently
+ */
+struct libluksde_key_slot_trial
+{
+	/* The key slot index
+	 */
+	int key_slot_index;
+
+	/* The key slot
+	 */
+	libluksde_key_slot_t *key_slot;
+
+	/* The (encrypted) key material data
+	 */
+	uint8_t *key_material_data;
+
+	/* The key material size
+	 */
+	size_t key_material_size;
+
+	/* The master key
+	 */
+	uint8_t master_key[ 64 ];
+
+	/* The result, which is 1 if the key slot was unlocked, 0 if not or -1 on error
+	 */
+	int result;
+
+	/* The error of the trial
+	 */
+	libcerror_error_t *error;
+};
+
+int libluksde_key_slot_trial_initialize(
+     libluksde_key_slot_trial_t **key_slot_trial,
+     int key_slot_index,
+     libluksde_key_slot_t *key_slot,
+     size_t key_material_size,
+     libcerror_error_t **error );
+
+int libluksde_key_slot_trial_free(
+     libluksde_key_slot_trial_t **key_slot_trial,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBLUKSDE_KEY_SLOT_TRIAL_H ) */
+
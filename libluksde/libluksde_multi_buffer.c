@@ -0,0 +1,736 @@
+/*
+ * Multi-buffer hashing functions
+ *
+ * Copyright (C) 2013-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libluksde_aesni.h"
+#include "libluksde_definitions.h"
+#include "libluksde_libcerror.h"
+#include "libluksde_multi_buffer.h"
+
+#if defined( HAVE_LIBLUKSDE_MULTI_BUFFER_SUPPORT )
+
+/* Every lane of a vector contains the corresponding 32-bit value of a different message
+ */
+typedef uint32_t libluksde_multi_buffer_vector4_t __attribute__(( vector_size( 16 ) ));
+
+#if defined( HAVE_LIBLUKSDE_MULTI_BUFFER_AVX_SUPPORT )
+
+typedef uint32_t libluksde_multi_buffer_vector8_t __attribute__(( vector_size( 32 ) ));
+typedef uint32_t libluksde_multi_buffer_vector16_t __attribute__(( vector_size( 64 ) ));
+
+#define LIBLUKSDE_MULTI_BUFFER_AVX2_TARGET \
+	__attribute__(( target( "avx2" ) ))
+
+#define LIBLUKSDE_MULTI_BUFFER_AVX512_TARGET \
+	__attribute__(( target( "avx512f" ) ))
+
+#endif /* defined( HAVE_LIBLUKSDE_MULTI_BUFFER_AVX_SUPPORT ) */
+
+/* The SHA-256 round constants
+ */
+static const uint32_t libluksde_multi_buffer_sha256_round_constants[ 64 ] = {
+	0x428a2f98UL, 0x71374491UL, 0xb5c0fbcfUL, 0xe9b5dba5UL, 0x3956c25bUL, 0x59f111f1UL, 0x923f82a4UL, 0xab1c5ed5UL,
+	0xd807aa98UL, 0x12835b01UL, 0x243185beUL, 0x550c7dc3UL, 0x72be5d74UL, 0x80deb1feUL, 0x9bdc06a7UL, 0xc19bf174UL,
+	0xe49b69c1UL, 0xefbe4786UL, 0x0fc19dc6UL, 0x240ca1ccUL, 0x2de92c6fUL, 0x4a7484aaUL, 0x5cb0a9dcUL, 0x76f988daUL,
+	0x983e5152UL, 0xa831c66dUL, 0xb00327c8UL, 0xbf597fc7UL, 0xc6e00bf3UL, 0xd5a79147UL, 0x06ca6351UL, 0x14292967UL,
+	0x27b70a85UL, 0x2e1b2138UL, 0x4d2c6dfcUL, 0x53380d13UL, 0x650a7354UL, 0x766a0abbUL, 0x81c2c92eUL, 0x92722c85UL,
+	0xa2bfe8a1UL, 0xa81a664bUL, 0xc24b8b70UL, 0xc76c51a3UL, 0xd192e819UL, 0xd6990624UL, 0xf40e3585UL, 0x106aa070UL,
+	0x19a4c116UL, 0x1e376c08UL, 0x2748774cUL, 0x34b0bcb5UL, 0x391c0cb3UL, 0x4ed8aa4aUL, 0x5b9cca4fUL, 0x682e6ff3UL,
+	0x748f82eeUL, 0x78a5636fUL, 0x84c87814UL, 0x8cc70208UL, 0x90befffaUL, 0xa4506cebUL, 0xbef9a3f7UL, 0xc67178f2UL };
+
+#define libluksde_multi_buffer_rotate_left( value, number_of_bits ) \
+	( ( ( value ) << ( number_of_bits ) ) | ( ( value ) >> ( 32 - ( number_of_bits ) ) ) )
+
+#define libluksde_multi_buffer_rotate_right( value, number_of_bits ) \
+	( ( ( value ) >> ( number_of_bits ) ) | ( ( value ) << ( 32 - ( number_of_bits ) ) ) )
+
+/* The rounds are unrolled so that the schedule indexes are constant and the
+ * schedule can be kept in registers, the working variables are rotated by
+ * changing the order of the arguments
+ */
+#define libluksde_multi_buffer_sha1_choose( value_b, value_c, value_d ) \
+	( value_d ^ ( value_b & ( value_c ^ value_d ) ) )
+
+#define libluksde_multi_buffer_sha1_parity( value_b, value_c, value_d ) \
+	( value_b ^ value_c ^ value_d )
+
+#define libluksde_multi_buffer_sha1_majority( value_b, value_c, value_d ) \
+	( ( value_b & value_c ) | ( value_d & ( value_b | value_c ) ) )
+
+/* Retrieves the SHA-1 message schedule value of a round
+ * W[t] = ( W[t-3] ^ W[t-8] ^ W[t-14] ^ W[t-16] ) <<< 1
+ */
+#define libluksde_multi_buffer_sha1_schedule( round_index ) \
+	( ( ( round_index ) < 16 ) ? schedule[ ( round_index ) & 15 ] : \
+	  ( schedule[ ( round_index ) & 15 ] = libluksde_multi_buffer_rotate_left( \
+	     schedule[ ( ( round_index ) - 3 ) & 15 ] \
+	   ^ schedule[ ( ( round_index ) - 8 ) & 15 ] \
+	   ^ schedule[ ( ( round_index ) - 14 ) & 15 ] \
+	   ^ schedule[ ( round_index ) & 15 ], 1 ) ) )
+
+#define libluksde_multi_buffer_sha1_round( value_a, value_b, value_c, value_d, value_e, round_index, function, round_constant ) \
+	value_e += libluksde_multi_buffer_rotate_left( value_a, 5 ) \
+	         + function( value_b, value_c, value_d ) \
+	         + round_constant \
+	         + libluksde_multi_buffer_sha1_schedule( round_index ); \
+	value_b = libluksde_multi_buffer_rotate_left( value_b, 30 );
+
+#define libluksde_multi_buffer_sha1_rounds5( round_index, function, round_constant ) \
+	libluksde_multi_buffer_sha1_round( value_a, value_b, value_c, value_d, value_e, round_index, function, round_constant ) \
+	libluksde_multi_buffer_sha1_round( value_e, value_a, value_b, value_c, value_d, round_index + 1, function, round_constant ) \
+	libluksde_multi_buffer_sha1_round( value_d, value_e, value_a, value_b, value_c, round_index + 2, function, round_constant ) \
+	libluksde_multi_buffer_sha1_round( value_c, value_d, value_e, value_a, value_b, round_index + 3, function, round_constant ) \
+	libluksde_multi_buffer_sha1_round( value_b, value_c, value_d, value_e, value_a, round_index + 4, function, round_constant )
+
+/* Applies the SHA-1 compression function to the schedule, starting from the initial values
+ * and stores the result in the message values
+ */
+#define libluksde_multi_buffer_sha1_compress( initial_values ) \
+	value_a = initial_values[ 0 ]; \
+	value_b = initial_values[ 1 ]; \
+	value_c = initial_values[ 2 ]; \
+	value_d = initial_values[ 3 ]; \
+	value_e = initial_values[ 4 ]; \
+	libluksde_multi_buffer_sha1_rounds5( 0, libluksde_multi_buffer_sha1_choose, 0x5a827999UL ) \
+	libluksde_multi_buffer_sha1_rounds5( 5, libluksde_multi_buffer_sha1_choose, 0x5a827999UL ) \
+	libluksde_multi_buffer_sha1_rounds5( 10, libluksde_multi_buffer_sha1_choose, 0x5a827999UL ) \
+	libluksde_multi_buffer_sha1_rounds5( 15, libluksde_multi_buffer_sha1_choose, 0x5a827999UL ) \
+	libluksde_multi_buffer_sha1_rounds5( 20, libluksde_multi_buffer_sha1_parity, 0x6ed9eba1UL ) \
+	libluksde_multi_buffer_sha1_rounds5( 25, libluksde_multi_buffer_sha1_parity, 0x6ed9eba1UL ) \
+	libluksde_multi_buffer_sha1_rounds5( 30, libluksde_multi_buffer_sha1_parity, 0x6ed9eba1UL ) \
+	libluksde_multi_buffer_sha1_rounds5( 35, libluksde_multi_buffer_sha1_parity, 0x6ed9eba1UL ) \
+	libluksde_multi_buffer_sha1_rounds5( 40, libluksde_multi_buffer_sha1_majority, 0x8f1bbcdcUL ) \
+	libluksde_multi_buffer_sha1_rounds5( 45, libluksde_multi_buffer_sha1_majority, 0x8f1bbcdcUL ) \
+	libluksde_multi_buffer_sha1_rounds5( 50, libluksde_multi_buffer_sha1_majority, 0x8f1bbcdcUL ) \
+	libluksde_multi_buffer_sha1_rounds5( 55, libluksde_multi_buffer_sha1_majority, 0x8f1bbcdcUL ) \
+	libluksde_multi_buffer_sha1_rounds5( 60, libluksde_multi_buffer_sha1_parity, 0xca62c1d6UL ) \
+	libluksde_multi_buffer_sha1_rounds5( 65, libluksde_multi_buffer_sha1_parity, 0xca62c1d6UL ) \
+	libluksde_multi_buffer_sha1_rounds5( 70, libluksde_multi_buffer_sha1_parity, 0xca62c1d6UL ) \
+	libluksde_multi_buffer_sha1_rounds5( 75, libluksde_multi_buffer_sha1_parity, 0xca62c1d6UL ) \
+	message_values[ 0 ] = initial_values[ 0 ] + value_a; \
+	message_values[ 1 ] = initial_values[ 1 ] + value_b; \
+	message_values[ 2 ] = initial_values[ 2 ] + value_c; \
+	message_values[ 3 ] = initial_values[ 3 ] + value_d; \
+	message_values[ 4 ] = initial_values[ 4 ] + value_e;
+
+/* Applies the remaining PBKDF2-HMAC-SHA1 iterations
+ * The message of every HMAC is the 20-byte result of the previous HMAC, which is
+ * followed by the padding of a message of 64 + 20 bytes
+ */
+#define libluksde_multi_buffer_pbkdf2_sha1() \
+	for( value_index = 0; \
+	     value_index < 5; \
+	     value_index++ ) \
+	{ \
+		memory_copy( \
+		 &( inner_values[ value_index ] ), \
+		 &( inner_hash_values[ value_index * number_of_lanes ] ), \
+		 sizeof( inner_values[ 0 ] ) ); \
+		memory_copy( \
+		 &( outer_values[ value_index ] ), \
+		 &( outer_hash_values[ value_index * number_of_lanes ] ), \
+		 sizeof( outer_values[ 0 ] ) ); \
+		memory_copy( \
+		 &( block_values[ value_index ] ), \
+		 &( block_hash_values[ value_index * number_of_lanes ] ), \
+		 sizeof( block_values[ 0 ] ) ); \
+		message_values[ value_index ] = block_values[ value_index ]; \
+	} \
+	while( number_of_iterations > 0 ) \
+	{ \
+		for( compress_index = 0; \
+		     compress_index < 2; \
+		     compress_index++ ) \
+		{ \
+			for( value_index = 0; \
+			     value_index < 5; \
+			     value_index++ ) \
+			{ \
+				schedule[ value_index ] = message_values[ value_index ]; \
+			} \
+			schedule[ 5 ] = zero_values + 0x80000000UL; \
+			for( value_index = 6; \
+			     value_index < 15; \
+			     value_index++ ) \
+			{ \
+				schedule[ value_index ] = zero_values; \
+			} \
+			schedule[ 15 ] = zero_values + ( ( 64 + 20 ) * 8 ); \
+			if( compress_index == 0 ) \
+			{ \
+				libluksde_multi_buffer_sha1_compress( inner_values ) \
+			} \
+			else \
+			{ \
+				libluksde_multi_buffer_sha1_compress( outer_values ) \
+			} \
+		} \
+		for( value_index = 0; \
+		     value_index < 5; \
+		     value_index++ ) \
+		{ \
+			block_values[ value_index ] ^= message_values[ value_index ]; \
+		} \
+		number_of_iterations--; \
+	} \
+	for( value_index = 0; \
+	     value_index < 5; \
+	     value_index++ ) \
+	{ \
+		memory_copy( \
+		 &( block_hash_values[ value_index * number_of_lanes ] ), \
+		 &( block_values[ value_index ] ), \
+		 sizeof( block_values[ 0 ] ) ); \
+	}
+
+#define libluksde_multi_buffer_sha256_choose( value_e, value_f, value_g ) \
+	( value_g ^ ( value_e & ( value_f ^ value_g ) ) )
+
+#define libluksde_multi_buffer_sha256_majority( value_a, value_b, value_c ) \
+	( ( value_a & value_b ) | ( value_c & ( value_a | value_b ) ) )
+
+#define libluksde_multi_buffer_sha256_sum0( value ) \
+	( libluksde_multi_buffer_rotate_right( value, 2 ) \
+	^ libluksde_multi_buffer_rotate_right( value, 13 ) \
+	^ libluksde_multi_buffer_rotate_right( value, 22 ) )
+
+#define libluksde_multi_buffer_sha256_sum1( value ) \
+	( libluksde_multi_buffer_rotate_right( value, 6 ) \
+	^ libluksde_multi_buffer_rotate_right( value, 11 ) \
+	^ libluksde_multi_buffer_rotate_right( value, 25 ) )
+
+#define libluksde_multi_buffer_sha256_sigma0( value ) \
+	( libluksde_multi_buffer_rotate_right( value, 7 ) \
+	^ libluksde_multi_buffer_rotate_right( value, 18 ) \
+	^ ( ( value ) >> 3 ) )
+
+#define libluksde_multi_buffer_sha256_sigma1( value ) \
+	( libluksde_multi_buffer_rotate_right( value, 17 ) \
+	^ libluksde_multi_buffer_rotate_right( value, 19 ) \
+	^ ( ( value ) >> 10 ) )
+
+/* Retrieves the SHA-256 message schedule value of a round
+ * W[t] = sigma1( W[t-2] ) + W[t-7] + sigma0( W[t-15] ) + W[t-16]
+ */
+#define libluksde_multi_buffer_sha256_schedule( round_index ) \
+	( ( ( round_index ) < 16 ) ? schedule[ ( round_index ) & 15 ] : \
+	  ( schedule[ ( round_index ) & 15 ] += \
+	     libluksde_multi_buffer_sha256_sigma1( schedule[ ( ( round_index ) - 2 ) & 15 ] ) \
+	   + schedule[ ( ( round_index ) - 7 ) & 15 ] \
+	   + libluksde_multi_buffer_sha256_sigma0( schedule[ ( ( round_index ) - 15 ) & 15 ] ) ) )
+
+#define libluksde_multi_buffer_sha256_round( value_a, value_b, value_c, value_d, value_e, value_f, value_g, value_h, round_index ) \
+	value_t1 = value_h \
+	         + libluksde_multi_buffer_sha256_sum1( value_e ) \
+	         + libluksde_multi_buffer_sha256_choose( value_e, value_f, value_g ) \
+	         + libluksde_multi_buffer_sha256_round_constants[ round_index ] \
+	         + libluksde_multi_buffer_sha256_schedule( round_index ); \
+	value_d += value_t1; \
+	value_h  = value_t1 \
+	         + libluksde_multi_buffer_sha256_sum0( value_a ) \
+	         + libluksde_multi_buffer_sha256_majority( value_a, value_b, value_c );
+
+#define libluksde_multi_buffer_sha256_rounds8( round_index ) \
+	libluksde_multi_buffer_sha256_round( value_a, value_b, value_c, value_d, value_e, value_f, value_g, value_h, round_index ) \
+	libluksde_multi_buffer_sha256_round( value_h, value_a, value_b, value_c, value_d, value_e, value_f, value_g, round_index + 1 ) \
+	libluksde_multi_buffer_sha256_round( value_g, value_h, value_a, value_b, value_c, value_d, value_e, value_f, round_index + 2 ) \
+	libluksde_multi_buffer_sha256_round( value_f, value_g, value_h, value_a, value_b, value_c, value_d, value_e, round_index + 3 ) \
+	libluksde_multi_buffer_sha256_round( value_e, value_f, value_g, value_h, value_a, value_b, value_c, value_d, round_index + 4 ) \
+	libluksde_multi_buffer_sha256_round( value_d, value_e, value_f, value_g, value_h, value_a, value_b, value_c, round_index + 5 ) \
+	libluksde_multi_buffer_sha256_round( value_c, value_d, value_e, value_f, value_g, value_h, value_a, value_b, round_index + 6 ) \
+	libluksde_multi_buffer_sha256_round( value_b, value_c, value_d, value_e, value_f, value_g, value_h, value_a, round_index + 7 )
+
+/* Applies the SHA-256 compression function to the schedule, starting from the initial values
+ * and stores the result in the message values
+ */
+#define libluksde_multi_buffer_sha256_compress( initial_values ) \
+	value_a = initial_values[ 0 ]; \
+	value_b = initial_values[ 1 ]; \
+	value_c = initial_values[ 2 ]; \
+	value_d = initial_values[ 3 ]; \
+	value_e = initial_values[ 4 ]; \
+	value_f = initial_values[ 5 ]; \
+	value_g = initial_values[ 6 ]; \
+	value_h = initial_values[ 7 ]; \
+	libluksde_multi_buffer_sha256_rounds8( 0 ) \
+	libluksde_multi_buffer_sha256_rounds8( 8 ) \
+	libluksde_multi_buffer_sha256_rounds8( 16 ) \
+	libluksde_multi_buffer_sha256_rounds8( 24 ) \
+	libluksde_multi_buffer_sha256_rounds8( 32 ) \
+	libluksde_multi_buffer_sha256_rounds8( 40 ) \
+	libluksde_multi_buffer_sha256_rounds8( 48 ) \
+	libluksde_multi_buffer_sha256_rounds8( 56 ) \
+	message_values[ 0 ] = initial_values[ 0 ] + value_a; \
+	message_values[ 1 ] = initial_values[ 1 ] + value_b; \
+	message_values[ 2 ] = initial_values[ 2 ] + value_c; \
+	message_values[ 3 ] = initial_values[ 3 ] + value_d; \
+	message_values[ 4 ] = initial_values[ 4 ] + value_e; \
+	message_values[ 5 ] = initial_values[ 5 ] + value_f; \
+	message_values[ 6 ] = initial_values[ 6 ] + value_g; \
+	message_values[ 7 ] = initial_values[ 7 ] + value_h;
+
+/* Applies the remaining PBKDF2-HMAC-SHA224 or PBKDF2-HMAC-SHA256 iterations
+ * The message of every HMAC is the 28 or 32-byte result of the previous HMAC, which is
+ * followed by the padding of a message of 64 + 28 or 64 + 32 bytes
+ */
+#define libluksde_multi_buffer_pbkdf2_sha256() \
+	for( value_index = 0; \
+	     value_index < 8; \
+	     value_index++ ) \
+	{ \
+		memory_copy( \
+		 &( inner_values[ value_index ] ), \
+		 &( inner_hash_values[ value_index * number_of_lanes ] ), \
+		 sizeof( inner_values[ 0 ] ) ); \
+		memory_copy( \
+		 &( outer_values[ value_index ] ), \
+		 &( outer_hash_values[ value_index * number_of_lanes ] ), \
+		 sizeof( outer_values[ 0 ] ) ); \
+		memory_copy( \
+		 &( block_values[ value_index ] ), \
+		 &( block_hash_values[ value_index * number_of_lanes ] ), \
+		 sizeof( block_values[ 0 ] ) ); \
+		message_values[ value_index ] = block_values[ value_index ]; \
+	} \
+	while( number_of_iterations > 0 ) \
+	{ \
+		for( compress_index = 0; \
+		     compress_index < 2; \
+		     compress_index++ ) \
+		{ \
+			for( value_index = 0; \
+			     value_index < number_of_hash_values; \
+			     value_index++ ) \
+			{ \
+				schedule[ value_index ] = message_values[ value_index ]; \
+			} \
+			schedule[ number_of_hash_values ] = zero_values + 0x80000000UL; \
+			for( value_index = number_of_hash_values + 1; \
+			     value_index < 15; \
+			     value_index++ ) \
+			{ \
+				schedule[ value_index ] = zero_values; \
+			} \
+			schedule[ 15 ] = zero_values + (uint32_t) ( ( 64 + ( number_of_hash_values * 4 ) ) * 8 ); \
+			if( compress_index == 0 ) \
+			{ \
+				libluksde_multi_buffer_sha256_compress( inner_values ) \
+			} \
+			else \
+			{ \
+				libluksde_multi_buffer_sha256_compress( outer_values ) \
+			} \
+		} \
+		for( value_index = 0; \
+		     value_index < 8; \
+		     value_index++ ) \
+		{ \
+			block_values[ value_index ] ^= message_values[ value_index ]; \
+		} \
+		number_of_iterations--; \
+	} \
+	for( value_index = 0; \
+	     value_index < 8; \
+	     value_index++ ) \
+	{ \
+		memory_copy( \
+		 &( block_hash_values[ value_index * number_of_lanes ] ), \
+		 &( block_values[ value_index ] ), \
+		 sizeof( block_values[ 0 ] ) ); \
+	}
+
+/* Applies the remaining PBKDF2-HMAC-SHA1 iterations to 4 lanes
+ */
+static void libluksde_multi_buffer_pbkdf2_sha1_4_lanes(
+             const uint32_t *inner_hash_values,
+             const uint32_t *outer_hash_values,
+             uint32_t *block_hash_values,
+             uint32_t number_of_iterations )
+{
+	libluksde_multi_buffer_vector4_t block_values[ 5 ];
+	libluksde_multi_buffer_vector4_t inner_values[ 5 ];
+	libluksde_multi_buffer_vector4_t message_values[ 5 ];
+	libluksde_multi_buffer_vector4_t outer_values[ 5 ];
+	libluksde_multi_buffer_vector4_t schedule[ 16 ];
+
+	libluksde_multi_buffer_vector4_t value_a;
+	libluksde_multi_buffer_vector4_t value_b;
+	libluksde_multi_buffer_vector4_t value_c;
+	libluksde_multi_buffer_vector4_t value_d;
+	libluksde_multi_buffer_vector4_t value_e;
+	libluksde_multi_buffer_vector4_t zero_values = { 0 };
+
+	const int number_of_lanes = 4;
+	int compress_index        = 0;
+	int value_index           = 0;
+
+	libluksde_multi_buffer_pbkdf2_sha1()
+}
+
+/* Applies the remaining PBKDF2-HMAC-SHA224 or PBKDF2-HMAC-SHA256 iterations to 4 lanes
+ */
+static void libluksde_multi_buffer_pbkdf2_sha256_4_lanes(
+             const uint32_t *inner_hash_values,
+             const uint32_t *outer_hash_values,
+             uint32_t *block_hash_values,
+             int number_of_hash_values,
+             uint32_t number_of_iterations )
+{
+	libluksde_multi_buffer_vector4_t block_values[ 8 ];
+	libluksde_multi_buffer_vector4_t inner_values[ 8 ];
+	libluksde_multi_buffer_vector4_t message_values[ 8 ];
+	libluksde_multi_buffer_vector4_t outer_values[ 8 ];
+	libluksde_multi_buffer_vector4_t schedule[ 16 ];
+
+	libluksde_multi_buffer_vector4_t value_a;
+	libluksde_multi_buffer_vector4_t value_b;
+	libluksde_multi_buffer_vector4_t value_c;
+	libluksde_multi_buffer_vector4_t value_d;
+	libluksde_multi_buffer_vector4_t value_e;
+	libluksde_multi_buffer_vector4_t value_f;
+	libluksde_multi_buffer_vector4_t value_g;
+	libluksde_multi_buffer_vector4_t value_h;
+	libluksde_multi_buffer_vector4_t value_t1;
+	libluksde_multi_buffer_vector4_t zero_values = { 0 };
+
+	const int number_of_lanes = 4;
+	int compress_index        = 0;
+	int value_index           = 0;
+
+	libluksde_multi_buffer_pbkdf2_sha256()
+}
+
+#if defined( HAVE_LIBLUKSDE_MULTI_BUFFER_AVX_SUPPORT )
+
+/* Applies the remaining PBKDF2-HMAC-SHA1 iterations to 8 lanes using AVX2
+ */
+LIBLUKSDE_MULTI_BUFFER_AVX2_TARGET
+static void libluksde_multi_buffer_pbkdf2_sha1_8_lanes(
+             const uint32_t *inner_hash_values,
+             const uint32_t *outer_hash_values,
+             uint32_t *block_hash_values,
+             uint32_t number_of_iterations )
+{
+	libluksde_multi_buffer_vector8_t block_values[ 5 ];
+	libluksde_multi_buffer_vector8_t inner_values[ 5 ];
+	libluksde_multi_buffer_vector8_t message_values[ 5 ];
+	libluksde_multi_buffer_vector8_t outer_values[ 5 ];
+	libluksde_multi_buffer_vector8_t schedule[ 16 ];
+
+	libluksde_multi_buffer_vector8_t value_a;
+	libluksde_multi_buffer_vector8_t value_b;
+	libluksde_multi_buffer_vector8_t value_c;
+	libluksde_multi_buffer_vector8_t value_d;
+	libluksde_multi_buffer_vector8_t value_e;
+	libluksde_multi_buffer_vector8_t zero_values = { 0 };
+
+	const int number_of_lanes = 8;
+	int compress_index        = 0;
+	int value_index           = 0;
+
+	libluksde_multi_buffer_pbkdf2_sha1()
+}
+
+/* Applies the remaining PBKDF2-HMAC-SHA224 or PBKDF2-HMAC-SHA256 iterations to 8 lanes using AVX2
+ */
+LIBLUKSDE_MULTI_BUFFER_AVX2_TARGET
+static void libluksde_multi_buffer_pbkdf2_sha256_8_lanes(
+             const uint32_t *inner_hash_values,
+             const uint32_t *outer_hash_values,
+             uint32_t *block_hash_values,
+             int number_of_hash_values,
+             uint32_t number_of_iterations )
+{
+	libluksde_multi_buffer_vector8_t block_values[ 8 ];
+	libluksde_multi_buffer_vector8_t inner_values[ 8 ];
+	libluksde_multi_buffer_vector8_t message_values[ 8 ];
+	libluksde_multi_buffer_vector8_t outer_values[ 8 ];
+	libluksde_multi_buffer_vector8_t schedule[ 16 ];
+
+	libluksde_multi_buffer_vector8_t value_a;
+	libluksde_multi_buffer_vector8_t value_b;
+	libluksde_multi_buffer_vector8_t value_c;
+	libluksde_multi_buffer_vector8_t value_d;
+	libluksde_multi_buffer_vector8_t value_e;
+	libluksde_multi_buffer_vector8_t value_f;
+	libluksde_multi_buffer_vector8_t value_g;
+	libluksde_multi_buffer_vector8_t value_h;
+	libluksde_multi_buffer_vector8_t value_t1;
+	libluksde_multi_buffer_vector8_t zero_values = { 0 };
+
+	const int number_of_lanes = 8;
+	int compress_index        = 0;
+	int value_index           = 0;
+
+	libluksde_multi_buffer_pbkdf2_sha256()
+}
+
+/* Applies the remaining PBKDF2-HMAC-SHA1 iterations to 16 lanes using AVX-512
+ */
+LIBLUKSDE_MULTI_BUFFER_AVX512_TARGET
+static void libluksde_multi_buffer_pbkdf2_sha1_16_lanes(
+             const uint32_t *inner_hash_values,
+             const uint32_t *outer_hash_values,
+             uint32_t *block_hash_values,
+             uint32_t number_of_iterations )
+{
+	libluksde_multi_buffer_vector16_t block_values[ 5 ];
+	libluksde_multi_buffer_vector16_t inner_values[ 5 ];
+	libluksde_multi_buffer_vector16_t message_values[ 5 ];
+	libluksde_multi_buffer_vector16_t outer_values[ 5 ];
+	libluksde_multi_buffer_vector16_t schedule[ 16 ];
+
+	libluksde_multi_buffer_vector16_t value_a;
+	libluksde_multi_buffer_vector16_t value_b;
+	libluksde_multi_buffer_vector16_t value_c;
+	libluksde_multi_buffer_vector16_t value_d;
+	libluksde_multi_buffer_vector16_t value_e;
+	libluksde_multi_buffer_vector16_t zero_values = { 0 };
+
+	const int number_of_lanes = 16;
+	int compress_index        = 0;
+	int value_index           = 0;
+
+	libluksde_multi_buffer_pbkdf2_sha1()
+}
+
+/* Applies the remaining PBKDF2-HMAC-SHA224 or PBKDF2-HMAC-SHA256 iterations to 16 lanes using AVX-512
+ */
+LIBLUKSDE_MULTI_BUFFER_AVX512_TARGET
+static void libluksde_multi_buffer_pbkdf2_sha256_16_lanes(
+             const uint32_t *inner_hash_values,
+             const uint32_t *outer_hash_values,
+             uint32_t *block_hash_values,
+             int number_of_hash_values,
+             uint32_t number_of_iterations )
+{
+	libluksde_multi_buffer_vector16_t block_values[ 8 ];
+	libluksde_multi_buffer_vector16_t inner_values[ 8 ];
+	libluksde_multi_buffer_vector16_t message_values[ 8 ];
+	libluksde_multi_buffer_vector16_t outer_values[ 8 ];
+	libluksde_multi_buffer_vector16_t schedule[ 16 ];
+
+	libluksde_multi_buffer_vector16_t value_a;
+	libluksde_multi_buffer_vector16_t value_b;
+	libluksde_multi_buffer_vector16_t value_c;
+	libluksde_multi_buffer_vector16_t value_d;
+	libluksde_multi_buffer_vector16_t value_e;
+	libluksde_multi_buffer_vector16_t value_f;
+	libluksde_multi_buffer_vector16_t value_g;
+	libluksde_multi_buffer_vector16_t value_h;
+	libluksde_multi_buffer_vector16_t value_t1;
+	libluksde_multi_buffer_vector16_t zero_values = { 0 };
+
+	const int number_of_lanes = 16;
+	int compress_index        = 0;
+	int value_index           = 0;
+
+	libluksde_multi_buffer_pbkdf2_sha256()
+}
+
+#endif /* defined( HAVE_LIBLUKSDE_MULTI_BUFFER_AVX_SUPPORT ) */
+
+#endif /* defined( HAVE_LIBLUKSDE_MULTI_BUFFER_SUPPORT ) */
+
+/* Retrieves the number of lanes supported by the CPU
+ * Returns the number of lanes, which is 1 if multi-buffer hashing is not supported
+ */
+int libluksde_multi_buffer_get_number_of_lanes(
+     void )
+{
+#if defined( HAVE_LIBLUKSDE_MULTI_BUFFER_SUPPORT )
+#if defined( HAVE_LIBLUKSDE_MULTI_BUFFER_AVX_SUPPORT )
+	int features = libluksde_aesni_get_features();
+
+	if( ( features & LIBLUKSDE_AESNI_FEATURE_FLAG_AVX512 ) != 0 )
+	{
+		return( 16 );
+	}
+	if( ( features & LIBLUKSDE_AESNI_FEATURE_FLAG_AVX2 ) != 0 )
+	{
+		return( 8 );
+	}
+#endif
+	return( 4 );
+#else
+	return( 1 );
+#endif
+}
+
+/* Applies the remaining PBKDF2 iterations of a block to multiple lanes
+ * The inner and outer hash values contain the hash values after hashing the HMAC
+ * padded key blocks and the block hash values contain the result of the first
+ * iteration on input and the block result on output. The hash values are stored
+ * by value index, [value index * number of lanes + lane]
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_multi_buffer_pbkdf2_iterate(
+     int hashing_method,
+     int number_of_lanes,
+     const uint32_t *inner_hash_values,
+     const uint32_t *outer_hash_values,
+     uint32_t *block_hash_values,
+     uint32_t number_of_iterations,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_multi_buffer_pbkdf2_iterate";
+
+	if( inner_hash_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid inner hash values.",
+		 function );
+
+		return( -1 );
+	}
+	if( outer_hash_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid outer hash values.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_hash_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block hash values.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( hashing_method != LIBLUKSDE_HASHING_METHOD_SHA1 )
+	 && ( hashing_method != LIBLUKSDE_HASHING_METHOD_SHA224 )
+	 && ( hashing_method != LIBLUKSDE_HASHING_METHOD_SHA256 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported hashing method.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_lanes <= 1 )
+	 || ( number_of_lanes > libluksde_multi_buffer_get_number_of_lanes() ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported number of lanes.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_BUFFER_SUPPORT )
+	switch( number_of_lanes )
+	{
+		case 4:
+			if( hashing_method == LIBLUKSDE_HASHING_METHOD_SHA1 )
+			{
+				libluksde_multi_buffer_pbkdf2_sha1_4_lanes(
+				 inner_hash_values,
+				 outer_hash_values,
+				 block_hash_values,
+				 number_of_iterations );
+			}
+			else
+			{
+				libluksde_multi_buffer_pbkdf2_sha256_4_lanes(
+				 inner_hash_values,
+				 outer_hash_values,
+				 block_hash_values,
+				 ( hashing_method == LIBLUKSDE_HASHING_METHOD_SHA224 ) ? 7 : 8,
+				 number_of_iterations );
+			}
+			return( 1 );
+
+#if defined( HAVE_LIBLUKSDE_MULTI_BUFFER_AVX_SUPPORT )
+		case 8:
+			if( hashing_method == LIBLUKSDE_HASHING_METHOD_SHA1 )
+			{
+				libluksde_multi_buffer_pbkdf2_sha1_8_lanes(
+				 inner_hash_values,
+				 outer_hash_values,
+				 block_hash_values,
+				 number_of_iterations );
+			}
+			else
+			{
+				libluksde_multi_buffer_pbkdf2_sha256_8_lanes(
+				 inner_hash_values,
+				 outer_hash_values,
+				 block_hash_values,
+				 ( hashing_method == LIBLUKSDE_HASHING_METHOD_SHA224 ) ? 7 : 8,
+				 number_of_iterations );
+			}
+			return( 1 );
+
+		case 16:
+			if( hashing_method == LIBLUKSDE_HASHING_METHOD_SHA1 )
+			{
+				libluksde_multi_buffer_pbkdf2_sha1_16_lanes(
+				 inner_hash_values,
+				 outer_hash_values,
+				 block_hash_values,
+				 number_of_iterations );
+			}
+			else
+			{
+				libluksde_multi_buffer_pbkdf2_sha256_16_lanes(
+				 inner_hash_values,
+				 outer_hash_values,
+				 block_hash_values,
+				 ( hashing_method == LIBLUKSDE_HASHING_METHOD_SHA224 ) ? 7 : 8,
+				 number_of_iterations );
+			}
+			return( 1 );
+#endif /* defined( HAVE_LIBLUKSDE_MULTI_BUFFER_AVX_SUPPORT ) */
+
+		default:
+			break;
+	}
+#endif /* defined( HAVE_LIBLUKSDE_MULTI_BUFFER_SUPPORT ) */
+
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+	 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+	 "%s: unsupported number of lanes.",
+	 function );
+
+	return( -1 );
+}
+
@@ -0,0 +1,67 @@
+/*
+ * Multi-buffer hashing functions
+ *
+ * Copyright (C) 2013-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBLUKSDE_MULTI_BUFFER_H )
+#define _LIBLUKSDE_MULTI_BUFFER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libluksde_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The multi-buffer functions require a compiler that supports vector extensions,
+ * the 8 and 16 lane functions also require function specific target attributes
+ */
+#if ( defined( __GNUC__ ) && ( __GNUC__ >= 5 ) ) || defined( __clang__ )
+#define HAVE_LIBLUKSDE_MULTI_BUFFER_SUPPORT
+
+#if defined( __x86_64__ )
+#define HAVE_LIBLUKSDE_MULTI_BUFFER_AVX_SUPPORT
+#endif
+
+#endif
+
+/* The maximum number of lanes, which is the number of 32-bit values in a 512-bit vector
+ */
+#define LIBLUKSDE_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES	16
+
+int libluksde_multi_buffer_get_number_of_lanes(
+     void );
+
+int libluksde_multi_buffer_pbkdf2_iterate(
+     int hashing_method,
+     int number_of_lanes,
+     const uint32_t *inner_hash_values,
+     const uint32_t *outer_hash_values,
+     uint32_t *block_hash_values,
+     uint32_t number_of_iterations,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBLUKSDE_MULTI_BUFFER_H ) */
+
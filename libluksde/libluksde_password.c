@@ -25,10 +25,237 @@
 #include <types.h>
 
 #include "libluksde_definitions.h"
+#include "libluksde_hash.h"
 #include "libluksde_libcerror.h"
 #include "libluksde_libcnotify.h"
-#include "libluksde_libhmac.h"
+#include "libluksde_multi_buffer.h"
 #include "libluksde_password.h"
+#include "libluksde_progress.h"
+
+/* Sets the key of a HMAC context
+ * The inner and outer padded key blocks are hashed once, a key larger than
+ * the block size is hashed first
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_password_hmac_context_set_key(
+     libluksde_password_hmac_context_t *context,
+     int hashing_method,
+     int backend,
+     const uint8_t *key,
+     size_t key_size,
+     libcerror_error_t **error )
+{
+	uint8_t key_block[ LIBLUKSDE_HASH_MAXIMUM_BLOCK_SIZE ];
+
+	libluksde_hash_context_t hash_context;
+
+	static char *function = "libluksde_password_hmac_context_set_key";
+	size_t byte_index     = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key.",
+		 function );
+
+		return( -1 );
+	}
+	if( key_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid key size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( libluksde_hash_context_set_method(
+	     &hash_context,
+	     hashing_method,
+	     backend,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set hashing method.",
+		 function );
+
+		return( -1 );
+	}
+	context->hash_size          = hash_context.hash_size;
+	context->block_size         = hash_context.block_size;
+	context->byte_order         = hash_context.byte_order;
+	context->transform_function = hash_context.transform_function;
+
+	memory_set(
+	 key_block,
+	 0,
+	 LIBLUKSDE_HASH_MAXIMUM_BLOCK_SIZE );
+
+	if( key_size > context->block_size )
+	{
+		memory_copy(
+		 context->inner_hash_values,
+		 hash_context.hash_values,
+		 sizeof( uint32_t ) * LIBLUKSDE_HASH_MAXIMUM_NUMBER_OF_HASH_VALUES );
+
+		libluksde_hash_context_finalize(
+		 &hash_context,
+		 key,
+		 key_size,
+		 0 );
+
+		libluksde_hash_copy_hash_values(
+		 key_block,
+		 hash_context.hash_values,
+		 context->hash_size,
+		 context->byte_order );
+
+		memory_copy(
+		 hash_context.hash_values,
+		 context->inner_hash_values,
+		 sizeof( uint32_t ) * LIBLUKSDE_HASH_MAXIMUM_NUMBER_OF_HASH_VALUES );
+	}
+	else
+	{
+		memory_copy(
+		 key_block,
+		 key,
+		 key_size );
+	}
+	for( byte_index = 0;
+	     byte_index < context->block_size;
+	     byte_index++ )
+	{
+		key_block[ byte_index ] ^= 0x36;
+	}
+	memory_copy(
+	 context->inner_hash_values,
+	 hash_context.hash_values,
+	 sizeof( uint32_t ) * LIBLUKSDE_HASH_MAXIMUM_NUMBER_OF_HASH_VALUES );
+
+	context->transform_function(
+	 context->inner_hash_values,
+	 key_block,
+	 1 );
+
+	/* 0x36 ^ 0x5c converts the inner padded key block into the outer padded key block
+	 */
+	for( byte_index = 0;
+	     byte_index < context->block_size;
+	     byte_index++ )
+	{
+		key_block[ byte_index ] ^= 0x36 ^ 0x5c;
+	}
+	memory_copy(
+	 context->outer_hash_values,
+	 hash_context.hash_values,
+	 sizeof( uint32_t ) * LIBLUKSDE_HASH_MAXIMUM_NUMBER_OF_HASH_VALUES );
+
+	context->transform_function(
+	 context->outer_hash_values,
+	 key_block,
+	 1 );
+
+	memory_set(
+	 key_block,
+	 0,
+	 LIBLUKSDE_HASH_MAXIMUM_BLOCK_SIZE );
+
+	memory_set(
+	 &hash_context,
+	 0,
+	 sizeof( libluksde_hash_context_t ) );
+
+	return( 1 );
+}
+
+/* Calculates the first HMAC of a PBKDF2 block, which is the HMAC of the salt
+ * followed by the big-endian 32-bit block number
+ */
+static void libluksde_password_pbkdf2_calculate_first_hmac(
+             libluksde_password_hmac_context_t *context,
+             const uint8_t *salt,
+             size_t salt_size,
+             uint32_t block_number,
+             uint8_t *outer_block,
+             uint32_t *hash_values )
+{
+	uint8_t tail_data[ LIBLUKSDE_HASH_MAXIMUM_BLOCK_SIZE + 4 ];
+
+	libluksde_hash_context_t hash_context;
+
+	size_t number_of_blocks = salt_size / context->block_size;
+	size_t tail_data_size   = salt_size % context->block_size;
+
+	memory_copy(
+	 hash_context.hash_values,
+	 context->inner_hash_values,
+	 sizeof( uint32_t ) * LIBLUKSDE_HASH_MAXIMUM_NUMBER_OF_HASH_VALUES );
+
+	hash_context.hash_size          = context->hash_size;
+	hash_context.block_size         = context->block_size;
+	hash_context.byte_order         = context->byte_order;
+	hash_context.transform_function = context->transform_function;
+
+	if( number_of_blocks > 0 )
+	{
+		context->transform_function(
+		 hash_context.hash_values,
+		 salt,
+		 number_of_blocks );
+	}
+	memory_copy(
+	 tail_data,
+	 &( salt[ number_of_blocks * context->block_size ] ),
+	 tail_data_size );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( tail_data[ tail_data_size ] ),
+	 block_number );
+
+	tail_data_size += 4;
+
+	libluksde_hash_context_finalize(
+	 &hash_context,
+	 tail_data,
+	 tail_data_size,
+	 (uint64_t) ( number_of_blocks + 1 ) * context->block_size );
+
+	libluksde_hash_copy_hash_values(
+	 outer_block,
+	 hash_context.hash_values,
+	 context->hash_size,
+	 context->byte_order );
+
+	memory_copy(
+	 hash_values,
+	 context->outer_hash_values,
+	 sizeof( uint32_t ) * LIBLUKSDE_HASH_MAXIMUM_NUMBER_OF_HASH_VALUES );
+
+	context->transform_function(
+	 hash_values,
+	 outer_block,
+	 1 );
+}
 
 /* Compute a PBKDF2-derived key from the given input.
  * Returns 1 if successful or -1 on error
@@ -37,27 +264,82 @@ int libluksde_password_pbkdf2(
      const uint8_t *password,
      size_t password_size,
      int password_hashing_method,
+     int backend,
+     const uint8_t *salt,
+     size_t salt_size,
+     uint32_t number_of_iterations,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_password_pbkdf2";
+
+	if( libluksde_password_pbkdf2_with_progress(
+	     password,
+	     password_size,
+	     password_hashing_method,
+	     backend,
+	     salt,
+	     salt_size,
+	     number_of_iterations,
+	     output_data,
+	     output_data_size,
+	     NULL,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to compute PBKDF2-derived key.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Compute a PBKDF2-derived key from the given input, which can be aborted
+ * The HMAC inner and outer padded password blocks are hashed once, after which every
+ * iteration consists of 2 calls of the compression function on pre-padded blocks
+ * The backend determines the implementation of the compression function
+ * The progress, if not NULL, is updated every LIBLUKSDE_PASSWORD_PROGRESS_INTERVAL iterations,
+ * the iterations are run in batches of this interval so that the loop itself contains no checks
+ * Returns 1 if successful, 0 if aborted or -1 on error
+ */
+int libluksde_password_pbkdf2_with_progress(
+     const uint8_t *password,
+     size_t password_size,
+     int password_hashing_method,
+     int backend,
      const uint8_t *salt,
      size_t salt_size,
      uint32_t number_of_iterations,
      uint8_t *output_data,
      size_t output_data_size,
+     libluksde_progress_t *progress,
      libcerror_error_t **error )
 {
-	uint8_t hash_buffer[ 32 ];
-
-	uint8_t *data_buffer       = NULL;
-	uint8_t *output_ptr        = NULL;
-	static char *function      = "libluksde_password_pbkdf2";
-	size_t data_buffer_size    = 0;
-	size_t block_offset        = 0;
-	size_t hash_size           = 0;
-	size_t remaining_data_size = 0;
-	uint32_t block_index       = 0;
-	uint32_t byte_index        = 0;
-	uint32_t number_of_blocks  = 0;
-	uint32_t password_iterator = 0;
-	int result                 = 0;
+	libluksde_password_hmac_context_t hmac_context;
+
+	uint8_t hash_data[ LIBLUKSDE_HASH_MAXIMUM_HASH_SIZE ];
+	uint8_t inner_block[ LIBLUKSDE_HASH_MAXIMUM_BLOCK_SIZE ];
+	uint8_t outer_block[ LIBLUKSDE_HASH_MAXIMUM_BLOCK_SIZE ];
+	uint32_t block_hash_values[ LIBLUKSDE_HASH_MAXIMUM_NUMBER_OF_HASH_VALUES ];
+	uint32_t hash_values[ LIBLUKSDE_HASH_MAXIMUM_NUMBER_OF_HASH_VALUES ];
+
+	static char *function        = "libluksde_password_pbkdf2_with_progress";
+	size_t block_offset          = 0;
+	size_t block_size            = 0;
+	size_t hash_size             = 0;
+	size_t number_of_hash_values = 0;
+	size_t value_index           = 0;
+	uint64_t maximum_value       = 0;
+	uint32_t block_number        = 0;
+	uint32_t iteration_index     = 0;
+	uint32_t last_iteration      = 0;
+	uint32_t number_of_blocks    = 0;
+	int result                   = 1;
 
 	if( password == NULL )
 	{
@@ -81,29 +363,20 @@ int libluksde_password_pbkdf2(
 
 		return( -1 );
 	}
-	switch( password_hashing_method )
+	if( ( password_hashing_method != LIBLUKSDE_HASHING_METHOD_RIPEMD160 )
+	 && ( password_hashing_method != LIBLUKSDE_HASHING_METHOD_SHA1 )
+	 && ( password_hashing_method != LIBLUKSDE_HASHING_METHOD_SHA224 )
+	 && ( password_hashing_method != LIBLUKSDE_HASHING_METHOD_SHA256 )
+	 && ( password_hashing_method != LIBLUKSDE_HASHING_METHOD_SHA512 ) )
 	{
-		case LIBLUKSDE_HASHING_METHOD_SHA1:
-			hash_size = LIBHMAC_SHA1_HASH_SIZE;
-			break;
-
-		case LIBLUKSDE_HASHING_METHOD_SHA224:
-			hash_size = LIBHMAC_SHA224_HASH_SIZE;
-			break;
-
-		case LIBLUKSDE_HASHING_METHOD_SHA256:
-			hash_size = LIBHMAC_SHA256_HASH_SIZE;
-			break;
-
-		default:
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-			 "%s: unsupported password hashing method.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported password hashing method.",
+		 function );
 
-			return( -1 );
+		return( -1 );
 	}
 	if( salt == NULL )
 	{
@@ -160,67 +433,42 @@ int libluksde_password_pbkdf2(
 
 		return( -1 );
 	}
-	if( memory_set(
-	     hash_buffer,
-	     0,
-	     32 ) == NULL )
+	if( libluksde_password_hmac_context_set_key(
+	     &hmac_context,
+	     password_hashing_method,
+	     backend,
+	     password,
+	     password_size,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to clear hash buffer.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set HMAC key.",
 		 function );
 
 		goto on_error;
 	}
-	if( memory_set(
-	     output_data,
-	     0,
-	     output_data_size ) == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to clear output data.",
-		 function );
+	hash_size             = hmac_context.hash_size;
+	number_of_hash_values = hash_size / 4;
 
-		goto on_error;
-	}
-/* TODO add bounds check */
-	number_of_blocks    = output_data_size / hash_size;
-	remaining_data_size = output_data_size - ( number_of_blocks * hash_size );
-	data_buffer_size    = salt_size + 4;
-
-	data_buffer = (uint8_t *) memory_allocate(
-	                           sizeof( uint8_t ) * data_buffer_size );
-
-	if( data_buffer == NULL )
+	/* PBKDF2 is defined for a maximum of 2^32 - 1 blocks
+	 */
+	if( ( output_data_size / hash_size ) >= (size_t) UINT32_MAX )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create data buffer.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid output data size value exceeds maximum.",
 		 function );
 
 		goto on_error;
 	}
-	if( memory_copy(
-	     data_buffer,
-	     salt,
-	     salt_size ) == NULL)
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to copy salt into data buffer.",
-		 function );
+	number_of_blocks = (uint32_t) ( ( output_data_size + hash_size - 1 ) / hash_size );
+	maximum_value    = (uint64_t) number_of_blocks * number_of_iterations;
 
-		goto on_error;
-	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
@@ -233,11 +481,11 @@ int libluksde_password_pbkdf2(
 		 0 );
 
 		libcnotify_printf(
-		 "%s: data buffer:\n",
+		 "%s: salt:\n",
 		 function );
 		libcnotify_print_data(
-		 data_buffer,
-		 data_buffer_size,
+		 salt,
+		 salt_size,
 		 0 );
 
 		libcnotify_printf(
@@ -255,303 +503,622 @@ int libluksde_password_pbkdf2(
 		 function,
 		 number_of_blocks );
 
-		libcnotify_printf(
-		 "%s: remaining data size\t\t\t\t: %" PRIzd "\n",
-		 function,
-		 remaining_data_size );
-
 		libcnotify_printf(
 		 "\n" );
 	}
 #endif
-	for( block_index = 0;
-	     block_index < number_of_blocks;
-	     block_index++ )
+	/* The inner and outer blocks contain a message of hash size bytes, which
+	 * is preceded by the padded key block, followed by the padding
+	 */
+	libluksde_hash_set_padding(
+	 inner_block,
+	 hash_size,
+	 hmac_context.block_size,
+	 (uint64_t) hmac_context.block_size + hash_size,
+	 hmac_context.byte_order );
+
+	memory_copy(
+	 outer_block,
+	 inner_block,
+	 hmac_context.block_size );
+
+	for( block_number = 1;
+	     block_number <= number_of_blocks;
+	     block_number++ )
 	{
-		output_ptr = &( output_data[ block_offset ] );
+		libluksde_password_pbkdf2_calculate_first_hmac(
+		 &hmac_context,
+		 salt,
+		 salt_size,
+		 block_number,
+		 outer_block,
+		 hash_values );
 
-		byte_stream_copy_from_uint32_big_endian(
-		 &( data_buffer[ salt_size ] ),
-		 block_index + 1 );
+		for( value_index = 0;
+		     value_index < number_of_hash_values;
+		     value_index++ )
+		{
+			block_hash_values[ value_index ] = hash_values[ value_index ];
+		}
+		iteration_index = 1;
 
-		switch( password_hashing_method )
+		while( iteration_index < number_of_iterations )
 		{
-			case LIBLUKSDE_HASHING_METHOD_SHA1:
-	                	result = libhmac_sha1_calculate_hmac(
-				          password,
-				          password_size,
-				          data_buffer,
-				          data_buffer_size,
-				          hash_buffer,
-				          hash_size,
-				          error );
-				break;
+			last_iteration = number_of_iterations;
 
-			case LIBLUKSDE_HASHING_METHOD_SHA224:
-	                	result = libhmac_sha224_calculate_hmac(
-				          password,
-				          password_size,
-				          data_buffer,
-				          data_buffer_size,
-				          hash_buffer,
-				          hash_size,
-				          error );
-				break;
+			if( ( progress != NULL )
+			 && ( ( number_of_iterations - iteration_index ) > LIBLUKSDE_PASSWORD_PROGRESS_INTERVAL ) )
+			{
+				last_iteration = iteration_index + LIBLUKSDE_PASSWORD_PROGRESS_INTERVAL;
+			}
+			for( ;
+			     iteration_index < last_iteration;
+			     iteration_index++ )
+			{
+				libluksde_hash_copy_hash_values(
+				 inner_block,
+				 hash_values,
+				 hash_size,
+				 hmac_context.byte_order );
 
-			case LIBLUKSDE_HASHING_METHOD_SHA256:
-	                	result = libhmac_sha256_calculate_hmac(
-				          password,
-				          password_size,
-				          data_buffer,
-				          data_buffer_size,
-				          hash_buffer,
-				          hash_size,
-				          error );
-				break;
+				memory_copy(
+				 hash_values,
+				 hmac_context.inner_hash_values,
+				 sizeof( uint32_t ) * LIBLUKSDE_HASH_MAXIMUM_NUMBER_OF_HASH_VALUES );
+
+				hmac_context.transform_function(
+				 hash_values,
+				 inner_block,
+				 1 );
+
+				libluksde_hash_copy_hash_values(
+				 outer_block,
+				 hash_values,
+				 hash_size,
+				 hmac_context.byte_order );
+
+				memory_copy(
+				 hash_values,
+				 hmac_context.outer_hash_values,
+				 sizeof( uint32_t ) * LIBLUKSDE_HASH_MAXIMUM_NUMBER_OF_HASH_VALUES );
 
-			default:
+				hmac_context.transform_function(
+				 hash_values,
+				 outer_block,
+				 1 );
+
+				for( value_index = 0;
+				     value_index < number_of_hash_values;
+				     value_index++ )
+				{
+					block_hash_values[ value_index ] ^= hash_values[ value_index ];
+				}
+			}
+			if( libluksde_progress_update(
+			     progress,
+			     ( (uint64_t) ( block_number - 1 ) * number_of_iterations ) + iteration_index,
+			     maximum_value ) == 0 )
+			{
 				result = 0;
+
 				break;
+			}
 		}
-		if( result != 1 )
+		if( result == 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GENERIC,
-			 "%s: unable to compute initial hmac for block %d.",
-			 function,
-			 block_index );
+			break;
+		}
+		libluksde_hash_copy_hash_values(
+		 hash_data,
+		 block_hash_values,
+		 hash_size,
+		 hmac_context.byte_order );
 
-			goto on_error;
+		block_size = output_data_size - block_offset;
+
+		if( block_size > hash_size )
+		{
+			block_size = hash_size;
 		}
 		if( memory_copy(
-		     output_ptr,
-		     hash_buffer,
-		     hash_size ) == NULL )
+		     &( output_data[ block_offset ] ),
+		     hash_data,
+		     block_size ) == NULL )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_MEMORY,
 			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy hash buffer into output data.",
+			 "%s: unable to copy hash data into output data.",
 			 function );
 
 			goto on_error;
 		}
-		for( password_iterator = 0;
-		     password_iterator < number_of_iterations - 1;
-		     password_iterator++ )
+		block_offset += block_size;
+	}
+	memory_set(
+	 &hmac_context,
+	 0,
+	 sizeof( libluksde_password_hmac_context_t ) );
+
+	memory_set(
+	 hash_data,
+	 0,
+	 LIBLUKSDE_HASH_MAXIMUM_HASH_SIZE );
+
+	memory_set(
+	 inner_block,
+	 0,
+	 LIBLUKSDE_HASH_MAXIMUM_BLOCK_SIZE );
+
+	memory_set(
+	 outer_block,
+	 0,
+	 LIBLUKSDE_HASH_MAXIMUM_BLOCK_SIZE );
+
+	memory_set(
+	 block_hash_values,
+	 0,
+	 sizeof( uint32_t ) * LIBLUKSDE_HASH_MAXIMUM_NUMBER_OF_HASH_VALUES );
+
+	memory_set(
+	 hash_values,
+	 0,
+	 sizeof( uint32_t ) * LIBLUKSDE_HASH_MAXIMUM_NUMBER_OF_HASH_VALUES );
+
+	return( result );
+
+on_error:
+	memory_set(
+	 &hmac_context,
+	 0,
+	 sizeof( libluksde_password_hmac_context_t ) );
+
+	return( -1 );
+}
+
+/* Compute PBKDF2-derived keys of multiple passwords with the same salt and number of iterations
+ * The passwords are processed in batches of the number of lanes supported by the CPU,
+ * where the HMAC of every iteration is calculated for all the lanes at once
+ * The output data contains the derived keys of the passwords consecutively, every key
+ * is output data size bytes in size
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_password_pbkdf2_multi_buffer(
+     const uint8_t **passwords,
+     const size_t *password_sizes,
+     int number_of_passwords,
+     int password_hashing_method,
+     const uint8_t *salt,
+     size_t salt_size,
+     uint32_t number_of_iterations,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error )
+{
+	libluksde_password_hmac_context_t hmac_contexts[ LIBLUKSDE_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES ];
+
+	uint8_t hash_data[ LIBLUKSDE_HASH_MAXIMUM_HASH_SIZE ];
+	uint8_t outer_block[ LIBLUKSDE_HASH_BLOCK_SIZE ];
+	uint32_t block_hash_values[ LIBLUKSDE_HASH_MAXIMUM_NUMBER_OF_HASH_VALUES * LIBLUKSDE_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES ];
+	uint32_t hash_values[ LIBLUKSDE_HASH_MAXIMUM_NUMBER_OF_HASH_VALUES ];
+	uint32_t inner_hash_values[ LIBLUKSDE_HASH_MAXIMUM_NUMBER_OF_HASH_VALUES * LIBLUKSDE_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES ];
+	uint32_t outer_hash_values[ LIBLUKSDE_HASH_MAXIMUM_NUMBER_OF_HASH_VALUES * LIBLUKSDE_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES ];
+
+	static char *function           = "libluksde_password_pbkdf2_multi_buffer";
+	size_t block_offset             = 0;
+	size_t block_size               = 0;
+	size_t hash_size                = 0;
+	size_t number_of_hash_values    = 0;
+	size_t value_index              = 0;
+	uint32_t block_number           = 0;
+	uint32_t number_of_blocks       = 0;
+	int lane_index                  = 0;
+	int maximum_number_of_lanes     = 0;
+	int minimum_number_of_lanes     = 0;
+	int minimum_number_of_passwords = 0;
+	int number_of_lanes             = 0;
+	int password_index              = 0;
+	int result                      = 1;
+
+	if( passwords == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid passwords.",
+		 function );
+
+		return( -1 );
+	}
+	if( password_sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid password sizes.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_passwords <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of passwords value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	for( password_index = 0;
+	     password_index < number_of_passwords;
+	     password_index++ )
+	{
+		if( passwords[ password_index ] == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid password: %d.",
+			 function,
+			 password_index );
+
+			return( -1 );
+		}
+		if( password_sizes[ password_index ] > (size_t) SSIZE_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid password: %d size value exceeds maximum.",
+			 function,
+			 password_index );
+
+			return( -1 );
+		}
+	}
+	if( ( password_hashing_method != LIBLUKSDE_HASHING_METHOD_RIPEMD160 )
+	 && ( password_hashing_method != LIBLUKSDE_HASHING_METHOD_SHA1 )
+	 && ( password_hashing_method != LIBLUKSDE_HASHING_METHOD_SHA224 )
+	 && ( password_hashing_method != LIBLUKSDE_HASHING_METHOD_SHA256 )
+	 && ( password_hashing_method != LIBLUKSDE_HASHING_METHOD_SHA512 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported password hashing method.",
+		 function );
+
+		return( -1 );
+	}
+	if( salt == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid salt.",
+		 function );
+
+		return( -1 );
+	}
+	if( salt_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid salt size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_iterations == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of iterations value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( output_data_size == 0 )
+	 || ( output_data_size > (size_t) ( SSIZE_MAX / number_of_passwords ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid output data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	maximum_number_of_lanes     = libluksde_multi_buffer_get_number_of_lanes();
+	minimum_number_of_lanes     = 4;
+	minimum_number_of_passwords = 2;
+
+	/* The multi-buffer compression functions are only available for SHA-1, SHA-224 and SHA-256
+	 */
+	if( ( password_hashing_method != LIBLUKSDE_HASHING_METHOD_SHA1 )
+	 && ( password_hashing_method != LIBLUKSDE_HASHING_METHOD_SHA224 )
+	 && ( password_hashing_method != LIBLUKSDE_HASHING_METHOD_SHA256 ) )
+	{
+		maximum_number_of_lanes = 1;
+	}
+	/* A single buffer with SHA-NI is faster than multiple buffers in 128-bit
+	 * or 256-bit vectors, and 512-bit vectors only pay off with several passwords
+	 */
+	else if( libluksde_hash_get_default_backend() == LIBLUKSDE_HASH_BACKEND_SHANI )
+	{
+		if( maximum_number_of_lanes < 16 )
+		{
+			maximum_number_of_lanes = 1;
+		}
+		minimum_number_of_lanes     = 16;
+		minimum_number_of_passwords = 4;
+	}
+	password_index = 0;
+
+	while( password_index < number_of_passwords )
+	{
+		/* Use the smallest number of lanes that covers the remaining passwords
+		 */
+		number_of_lanes = number_of_passwords - password_index;
+
+		if( ( number_of_lanes < minimum_number_of_passwords )
+		 || ( maximum_number_of_lanes == 1 ) )
+		{
+			number_of_lanes = 1;
+		}
+		else if( number_of_lanes >= maximum_number_of_lanes )
 		{
-			switch( password_hashing_method )
+			number_of_lanes = maximum_number_of_lanes;
+		}
+		else
+		{
+			lane_index = minimum_number_of_lanes;
+
+			while( lane_index < number_of_lanes )
 			{
-				case LIBLUKSDE_HASHING_METHOD_SHA1:
-					result = libhmac_sha1_calculate_hmac(
-					          password,
-					          password_size,
-					          hash_buffer,
-					          hash_size,
-					          hash_buffer,
-					          hash_size,
-					          error );
-					break;
-
-				case LIBLUKSDE_HASHING_METHOD_SHA224:
-					result = libhmac_sha224_calculate_hmac(
-					          password,
-					          password_size,
-					          hash_buffer,
-					          hash_size,
-					          hash_buffer,
-					          hash_size,
-					          error );
-					break;
-
-				case LIBLUKSDE_HASHING_METHOD_SHA256:
-					result = libhmac_sha256_calculate_hmac(
-					          password,
-					          password_size,
-					          hash_buffer,
-					          hash_size,
-					          hash_buffer,
-					          hash_size,
-					          error );
-					break;
-
-				default:
-					result = 0;
-					break;
+				lane_index *= 2;
 			}
-			if( result != 1 )
+			number_of_lanes = lane_index;
+		}
+		if( ( number_of_lanes == 1 )
+		 || ( number_of_iterations == 1 ) )
+		{
+			if( libluksde_password_pbkdf2(
+			     passwords[ password_index ],
+			     password_sizes[ password_index ],
+			     password_hashing_method,
+			     LIBLUKSDE_HASH_BACKEND_DEFAULT,
+			     salt,
+			     salt_size,
+			     number_of_iterations,
+			     &( output_data[ password_index * output_data_size ] ),
+			     output_data_size,
+			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_GENERIC,
-				 "%s: unable to compute initial hmac for block %d.",
+				 "%s: unable to determine password: %d key.",
 				 function,
-				 block_index);
+				 password_index );
 
-				goto on_error;
-			}
-			for( byte_index = 0;
-			     byte_index < hash_size;
-			     byte_index++ )
-			{
-				output_ptr[ byte_index ] ^= hash_buffer[ byte_index ];
-			}
-		}
-		block_offset += hash_size;
-	}
-	if( remaining_data_size > 0 )
-	{
-		output_ptr = &( output_data[ block_offset ] );
+				result = -1;
 
-		byte_stream_copy_from_uint32_big_endian(
-		 &( data_buffer[ salt_size ] ),
-		 block_index + 1 );
+				break;
+			}
+			password_index++;
 
-		switch( password_hashing_method )
+			continue;
+		}
+		/* Lanes beyond the remaining passwords are filled with the first password of the batch
+		 */
+		for( lane_index = 0;
+		     lane_index < number_of_lanes;
+		     lane_index++ )
 		{
-			case LIBLUKSDE_HASHING_METHOD_SHA1:
-				result = libhmac_sha1_calculate_hmac(
-				          password,
-				          password_size,
-				          data_buffer,
-				          data_buffer_size,
-				          hash_buffer,
-				          hash_size,
+			if( ( password_index + lane_index ) < number_of_passwords )
+			{
+				result = libluksde_password_hmac_context_set_key(
+				          &( hmac_contexts[ lane_index ] ),
+				          password_hashing_method,
+				          LIBLUKSDE_HASH_BACKEND_DEFAULT,
+				          passwords[ password_index + lane_index ],
+				          password_sizes[ password_index + lane_index ],
 				          error );
-				break;
-
-			case LIBLUKSDE_HASHING_METHOD_SHA224:
-				result = libhmac_sha224_calculate_hmac(
-				          password,
-				          password_size,
-				          data_buffer,
-				          data_buffer_size,
-				          hash_buffer,
-				          hash_size,
+			}
+			else
+			{
+				result = libluksde_password_hmac_context_set_key(
+				          &( hmac_contexts[ lane_index ] ),
+				          password_hashing_method,
+				          LIBLUKSDE_HASH_BACKEND_DEFAULT,
+				          passwords[ password_index ],
+				          password_sizes[ password_index ],
 				          error );
-				break;
+			}
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set HMAC key.",
+				 function );
 
-			case LIBLUKSDE_HASHING_METHOD_SHA256:
-				result = libhmac_sha256_calculate_hmac(
-				          password,
-				          password_size,
-				          data_buffer,
-				          data_buffer_size,
-				          hash_buffer,
-				          hash_size,
-				          error );
-				break;
+				result = -1;
 
-			default:
-				result = 0;
 				break;
+			}
+			for( value_index = 0;
+			     value_index < LIBLUKSDE_HASH_MAXIMUM_NUMBER_OF_HASH_VALUES;
+			     value_index++ )
+			{
+				inner_hash_values[ ( value_index * number_of_lanes ) + lane_index ] = hmac_contexts[ lane_index ].inner_hash_values[ value_index ];
+				outer_hash_values[ ( value_index * number_of_lanes ) + lane_index ] = hmac_contexts[ lane_index ].outer_hash_values[ value_index ];
+			}
 		}
 		if( result != 1 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GENERIC,
-			 "%s: unable to compute initial hmac for block %d.",
-			 function,
-			 block_index);
-
-			goto on_error;
+			break;
 		}
-		if( memory_copy(
-		     output_ptr,
-		     hash_buffer,
-		     remaining_data_size ) == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy hash buffer into output data in last block.",
-			 function );
+		hash_size             = hmac_contexts[ 0 ].hash_size;
+		number_of_hash_values = hash_size / 4;
+		number_of_blocks      = (uint32_t) ( ( output_data_size + hash_size - 1 ) / hash_size );
 
-			goto on_error;
-		}
-		for( password_iterator = 0;
-		     password_iterator < number_of_iterations - 1;
-		     password_iterator++ )
+		memory_set(
+		 outer_block,
+		 0,
+		 LIBLUKSDE_HASH_BLOCK_SIZE );
+
+		outer_block[ hash_size ] = 0x80;
+
+		byte_stream_copy_from_uint64_big_endian(
+		 &( outer_block[ LIBLUKSDE_HASH_BLOCK_SIZE - 8 ] ),
+		 (uint64_t) ( LIBLUKSDE_HASH_BLOCK_SIZE + hash_size ) * 8 );
+
+		block_offset = 0;
+
+		for( block_number = 1;
+		     block_number <= number_of_blocks;
+		     block_number++ )
 		{
-			switch( password_hashing_method )
+			for( lane_index = 0;
+			     lane_index < number_of_lanes;
+			     lane_index++ )
 			{
-				case LIBLUKSDE_HASHING_METHOD_SHA1:
-					result = libhmac_sha1_calculate_hmac(
-					          password,
-					          password_size,
-					          hash_buffer,
-					          hash_size,
-					          hash_buffer,
-					          hash_size,
-					          error );
-					break;
-
-				case LIBLUKSDE_HASHING_METHOD_SHA224:
-					result = libhmac_sha224_calculate_hmac(
-					          password,
-					          password_size,
-					          hash_buffer,
-					          hash_size,
-					          hash_buffer,
-					          hash_size,
-					          error );
-					break;
-
-				case LIBLUKSDE_HASHING_METHOD_SHA256:
-					result = libhmac_sha256_calculate_hmac(
-					          password,
-					          password_size,
-					          hash_buffer,
-					          hash_size,
-					          hash_buffer,
-					          hash_size,
-					          error );
-					break;
-
-				default:
-					result = 0;
-					break;
+				libluksde_password_pbkdf2_calculate_first_hmac(
+				 &( hmac_contexts[ lane_index ] ),
+				 salt,
+				 salt_size,
+				 block_number,
+				 outer_block,
+				 hash_values );
+
+				for( value_index = 0;
+				     value_index < LIBLUKSDE_HASH_MAXIMUM_NUMBER_OF_HASH_VALUES;
+				     value_index++ )
+				{
+					block_hash_values[ ( value_index * number_of_lanes ) + lane_index ] = hash_values[ value_index ];
+				}
 			}
-			if( result != 1 )
+			if( libluksde_multi_buffer_pbkdf2_iterate(
+			     password_hashing_method,
+			     number_of_lanes,
+			     inner_hash_values,
+			     outer_hash_values,
+			     block_hash_values,
+			     number_of_iterations - 1,
+			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_GENERIC,
-				 "%s: unable to compute initial hmac for block %d.",
+				 "%s: unable to iterate PBKDF2 block: %" PRIu32 ".",
 				 function,
-				 block_index );
+				 block_number );
+
+				result = -1;
+
+				break;
+			}
+			block_size = output_data_size - block_offset;
 
-				goto on_error;
+			if( block_size > hash_size )
+			{
+				block_size = hash_size;
 			}
-			for( byte_index = 0;
-			     byte_index < remaining_data_size;
-			     byte_index++ )
+			for( lane_index = 0;
+			     ( lane_index < number_of_lanes )
+			  && ( ( password_index + lane_index ) < number_of_passwords );
+			     lane_index++ )
 			{
-				output_ptr[ byte_index ] ^= hash_buffer[ byte_index ];
+				for( value_index = 0;
+				     value_index < number_of_hash_values;
+				     value_index++ )
+				{
+					hash_values[ value_index ] = block_hash_values[ ( value_index * number_of_lanes ) + lane_index ];
+				}
+				libluksde_hash_copy_hash_values(
+				 hash_data,
+				 hash_values,
+				 hash_size,
+				 _BYTE_STREAM_ENDIAN_BIG );
+
+				memory_copy(
+				 &( output_data[ ( ( password_index + lane_index ) * output_data_size ) + block_offset ] ),
+				 hash_data,
+				 block_size );
 			}
+			block_offset += block_size;
 		}
+		if( result != 1 )
+		{
+			break;
+		}
+		password_index += number_of_lanes;
 	}
-	if( data_buffer != NULL )
-	{
-		memory_free(
-		 data_buffer );
-	}
-	return( 1 );
+	memory_set(
+	 hmac_contexts,
+	 0,
+	 sizeof( libluksde_password_hmac_context_t ) * LIBLUKSDE_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES );
 
-on_error:
-	if( data_buffer != NULL )
-	{
-		memory_free(
-		 data_buffer );
-	}
-	return( -1 );
+	memory_set(
+	 hash_data,
+	 0,
+	 LIBLUKSDE_HASH_MAXIMUM_HASH_SIZE );
+
+	memory_set(
+	 outer_block,
+	 0,
+	 LIBLUKSDE_HASH_BLOCK_SIZE );
+
+	memory_set(
+	 block_hash_values,
+	 0,
+	 sizeof( uint32_t ) * LIBLUKSDE_HASH_MAXIMUM_NUMBER_OF_HASH_VALUES * LIBLUKSDE_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES );
+
+	memory_set(
+	 hash_values,
+	 0,
+	 sizeof( uint32_t ) * LIBLUKSDE_HASH_MAXIMUM_NUMBER_OF_HASH_VALUES );
+
+	memory_set(
+	 inner_hash_values,
+	 0,
+	 sizeof( uint32_t ) * LIBLUKSDE_HASH_MAXIMUM_NUMBER_OF_HASH_VALUES * LIBLUKSDE_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES );
+
+	memory_set(
+	 outer_hash_values,
+	 0,
+	 sizeof( uint32_t ) * LIBLUKSDE_HASH_MAXIMUM_NUMBER_OF_HASH_VALUES * LIBLUKSDE_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES );
+
+	return( result );
 }
 
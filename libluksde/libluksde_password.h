@@ -25,16 +25,91 @@
 #include <common.h>
 #include <types.h>
 
+#include "libluksde_hash.h"
 #include "libluksde_libcerror.h"
+#include "libluksde_progress.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
+/* The number of PBKDF2 iterations after which the progress is updated
+ */
+#define LIBLUKSDE_PASSWORD_PROGRESS_INTERVAL	1024
+
+typedef struct libluksde_password_hmac_context libluksde_password_hmac_context_t;
+
+/* The HMAC context contains the hash values after the inner and outer padded key blocks
+ * were hashed, so that every subsequent HMAC only needs to hash the message
+ */
+struct libluksde_password_hmac_context
+{
+	/* The hash values after hashing the inner (ipad) padded key block
+	 */
+	uint32_t inner_hash_values[ LIBLUKSDE_HASH_MAXIMUM_NUMBER_OF_HASH_VALUES ];
+
+	/* The hash values after hashing the outer (opad) padded key block
+	 */
+	uint32_t outer_hash_values[ LIBLUKSDE_HASH_MAXIMUM_NUMBER_OF_HASH_VALUES ];
+
+	/* The hash size
+	 */
+	size_t hash_size;
+
+	/* The block size
+	 */
+	size_t block_size;
+
+	/* The byte order of the hash values and of the message size in the padding
+	 */
+	uint8_t byte_order;
+
+	/* The function to apply the compression function of the hash to a number of blocks
+	 */
+	void (*transform_function)(
+	        uint32_t *hash_values,
+	        const uint8_t *blocks,
+	        size_t number_of_blocks );
+};
+
+int libluksde_password_hmac_context_set_key(
+     libluksde_password_hmac_context_t *context,
+     int hashing_method,
+     int backend,
+     const uint8_t *key,
+     size_t key_size,
+     libcerror_error_t **error );
+
 int libluksde_password_pbkdf2(
      const uint8_t *password,
      size_t password_size,
      int password_hashing_method,
+     int backend,
+     const uint8_t *salt,
+     size_t salt_size,
+     uint32_t number_of_iterations,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error );
+
+int libluksde_password_pbkdf2_with_progress(
+     const uint8_t *password,
+     size_t password_size,
+     int password_hashing_method,
+     int backend,
+     const uint8_t *salt,
+     size_t salt_size,
+     uint32_t number_of_iterations,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libluksde_progress_t *progress,
+     libcerror_error_t **error );
+
+int libluksde_password_pbkdf2_multi_buffer(
+     const uint8_t **passwords,
+     const size_t *password_sizes,
+     int number_of_passwords,
+     int password_hashing_method,
      const uint8_t *salt,
      size_t salt_size,
      uint32_t number_of_iterations,
@@ -0,0 +1,101 @@
+/*
+ * Key derivation progress functions
+ *
+ * Copyright (C) 2013-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libluksde_progress.h"
+
+/* Retrieves an abort value
+ * The abort value is shared by concurrent key derivations hence it is accessed atomically
+ * Returns the abort value
+ */
+int libluksde_progress_get_abort(
+     int *abort )
+{
+#if defined( __GNUC__ ) || defined( __clang__ )
+	return( __atomic_load_n(
+	         abort,
+	         __ATOMIC_ACQUIRE ) );
+#else
+	return( *( (volatile int *) abort ) );
+#endif
+}
+
+/* Sets an abort value
+ * The abort value is shared by concurrent key derivations hence it is accessed atomically
+ */
+void libluksde_progress_set_abort(
+      int *abort,
+      int value )
+{
+#if defined( __GNUC__ ) || defined( __clang__ )
+	__atomic_store_n(
+	 abort,
+	 value,
+	 __ATOMIC_RELEASE );
+#else
+	*( (volatile int *) abort ) = value;
+#endif
+}
+
+/* Reports the progress of a stage to the callback function and checks the abort value
+ * The abort value is set when the callback function returns 0 so that other
+ * concurrent key derivations using the same abort value stop as well
+ * Returns 1 to continue or 0 if aborted
+ */
+int libluksde_progress_update(
+     libluksde_progress_t *progress,
+     uint64_t value,
+     uint64_t maximum_value )
+{
+	if( progress == NULL )
+	{
+		return( 1 );
+	}
+	if( ( progress->abort != NULL )
+	 && ( libluksde_progress_get_abort(
+	       progress->abort ) != 0 ) )
+	{
+		return( 0 );
+	}
+	if( progress->callback_function != NULL )
+	{
+		if( progress->callback_function(
+		     progress->callback_data,
+		     progress->key_slot_index,
+		     progress->stage,
+		     value,
+		     maximum_value ) == 0 )
+		{
+			if( progress->abort != NULL )
+			{
+				libluksde_progress_set_abort(
+				 progress->abort,
+				 1 );
+			}
+			return( 0 );
+		}
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,79 @@
+/*
+ * Key derivation progress functions
+ *
+ * Copyright (C) 2013-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBLUKSDE_PROGRESS_H )
+#define _LIBLUKSDE_PROGRESS_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libluksde_progress libluksde_progress_t;
+
+struct libluksde_progress
+{
+	/* The abort value, which is set when the callback function cancels
+	 */
+	int *abort;
+
+	/* The callback function
+	 */
+	int (*callback_function)(
+	       void *callback_data,
+	       int key_slot_index,
+	       int stage,
+	       uint64_t value,
+	       uint64_t maximum_value );
+
+	/* The callback data
+	 */
+	void *callback_data;
+
+	/* The index of the key slot
+	 */
+	int key_slot_index;
+
+	/* The (progress) stage
+	 */
+	int stage;
+};
+
+int libluksde_progress_get_abort(
+     int *abort );
+
+void libluksde_progress_set_abort(
+      int *abort,
+      int value );
+
+int libluksde_progress_update(
+     libluksde_progress_t *progress,
+     uint64_t value,
+     uint64_t maximum_value );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBLUKSDE_PROGRESS_H ) */
+
@@ -0,0 +1,1251 @@
+/*
+ * Readahead functions
+ *
+ * Copyright (C) 2013-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libluksde_definitions.h"
+#include "libluksde_encryption.h"
+#include "libluksde_io_handle.h"
+#include "libluksde_libbfio.h"
+#include "libluksde_libcerror.h"
+#include "libluksde_libcthreads.h"
+#include "libluksde_readahead.h"
+#include "libluksde_sector_data.h"
+#include "libluksde_sector_data_pool.h"
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+
+/* Creates a readahead
+ * The file IO handle is cloned and a separate encryption context is created
+ * so that the worker thread does not share state with the thread that reads the volume
+ * Make sure the value readahead is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_readahead_initialize(
+     libluksde_readahead_t **readahead,
+     libluksde_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     size_t chunk_size,
+     int minimum_window_size,
+     int maximum_window_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_readahead_initialize";
+	size_t block_size     = 0;
+	int result            = 0;
+
+	if( readahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid readahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( *readahead != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid readahead value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->bytes_per_sector == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing bytes per sector.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_size == 0 )
+	 || ( chunk_size > (size_t) LIBLUKSDE_MAXIMUM_CHUNK_SIZE )
+	 || ( ( chunk_size % io_handle->bytes_per_sector ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_window_size <= 0 )
+	 || ( maximum_window_size > LIBLUKSDE_MAXIMUM_NUMBER_OF_READAHEAD_CHUNKS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum window size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( minimum_window_size <= 0 )
+	 || ( minimum_window_size > maximum_window_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid minimum window size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*readahead = memory_allocate_structure(
+	              libluksde_readahead_t );
+
+	if( *readahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create readahead.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *readahead,
+	     0,
+	     sizeof( libluksde_readahead_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear readahead.",
+		 function );
+
+		memory_free(
+		 *readahead );
+
+		*readahead = NULL;
+
+		return( -1 );
+	}
+	( *readahead )->chunks = (libluksde_readahead_chunk_t *) memory_allocate(
+	                                                          sizeof( libluksde_readahead_chunk_t ) * maximum_window_size );
+
+	if( ( *readahead )->chunks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunks.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *readahead )->chunks,
+	     0,
+	     sizeof( libluksde_readahead_chunk_t ) * maximum_window_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunks.",
+		 function );
+
+		goto on_error;
+	}
+	if( libluksde_sector_data_get_block_size(
+	     chunk_size,
+	     &block_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine sector data block size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libluksde_sector_data_pool_initialize(
+	     &( ( *readahead )->sector_data_pool ),
+	     block_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create sector data pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_clone(
+	     &( ( *readahead )->file_io_handle ),
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to clone file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	result = libbfio_handle_is_open(
+	          ( *readahead )->file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to determine if file IO handle is open.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		if( libbfio_handle_open(
+		     ( *readahead )->file_io_handle,
+		     LIBBFIO_OPEN_READ,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libluksde_encryption_initialize(
+	     &( ( *readahead )->encryption_context ),
+	     io_handle->encryption_method,
+	     io_handle->encryption_chaining_mode,
+	     io_handle->initialization_vector_mode,
+	     io_handle->essiv_hashing_method,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create encryption context.",
+		 function );
+
+		goto on_error;
+	}
+	if( libluksde_encryption_set_provider(
+	     ( *readahead )->encryption_context,
+	     io_handle->encryption_provider,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set provider in encryption context.",
+		 function );
+
+		goto on_error;
+	}
+	if( io_handle->number_of_essiv_cache_entries > 0 )
+	{
+		if( libluksde_encryption_set_essiv_cache_size(
+		     ( *readahead )->encryption_context,
+		     (size_t) io_handle->number_of_essiv_cache_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set ESSIV initialization vector cache size in encryption context.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libluksde_encryption_set_decryption_keys(
+	     ( *readahead )->encryption_context,
+	     io_handle->master_key,
+	     io_handle->master_key_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set key in encryption context.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *readahead )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *readahead )->request_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create request condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *readahead )->completion_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create completion condition.",
+		 function );
+
+		goto on_error;
+	}
+	( *readahead )->io_handle              = io_handle;
+	( *readahead )->chunk_size             = chunk_size;
+	( *readahead )->number_of_chunks       = maximum_window_size;
+	( *readahead )->minimum_window_size    = minimum_window_size;
+	( *readahead )->window_size            = minimum_window_size;
+	( *readahead )->next_offset            = -1;
+	( *readahead )->missed_chunk_offset    = -1;
+	( *readahead )->requested_start_offset = -1;
+	( *readahead )->requested_end_offset   = -1;
+
+	if( libcthreads_thread_create(
+	     &( ( *readahead )->worker_thread ),
+	     NULL,
+	     (int (*)(void *)) &libluksde_readahead_worker_callback,
+	     (void *) *readahead,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create worker thread.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *readahead != NULL )
+	{
+		if( ( *readahead )->completion_condition != NULL )
+		{
+			libcthreads_condition_free(
+			 &( ( *readahead )->completion_condition ),
+			 NULL );
+		}
+		if( ( *readahead )->request_condition != NULL )
+		{
+			libcthreads_condition_free(
+			 &( ( *readahead )->request_condition ),
+			 NULL );
+		}
+		if( ( *readahead )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *readahead )->mutex ),
+			 NULL );
+		}
+		if( ( *readahead )->encryption_context != NULL )
+		{
+			libluksde_encryption_free(
+			 &( ( *readahead )->encryption_context ),
+			 NULL );
+		}
+		if( ( *readahead )->file_io_handle != NULL )
+		{
+			libbfio_handle_free(
+			 &( ( *readahead )->file_io_handle ),
+			 NULL );
+		}
+		if( ( *readahead )->sector_data_pool != NULL )
+		{
+			libluksde_sector_data_pool_free(
+			 &( ( *readahead )->sector_data_pool ),
+			 NULL );
+		}
+		if( ( *readahead )->chunks != NULL )
+		{
+			memory_free(
+			 ( *readahead )->chunks );
+		}
+		memory_free(
+		 *readahead );
+
+		*readahead = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a readahead
+ * The worker thread is stopped before the chunks are freed
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_readahead_free(
+     libluksde_readahead_t **readahead,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_readahead_free";
+	int chunk_index       = 0;
+	int result            = 1;
+
+	if( readahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid readahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( *readahead != NULL )
+	{
+		if( ( *readahead )->worker_thread != NULL )
+		{
+			if( libcthreads_mutex_grab(
+			     ( *readahead )->mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to grab mutex.",
+				 function );
+
+				return( -1 );
+			}
+			( *readahead )->stop = 1;
+
+			if( libcthreads_condition_broadcast(
+			     ( *readahead )->request_condition,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to broadcast request condition.",
+				 function );
+
+				result = -1;
+			}
+			if( libcthreads_mutex_release(
+			     ( *readahead )->mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release mutex.",
+				 function );
+
+				return( -1 );
+			}
+			/* The chunks cannot be freed if the worker thread could not be stopped
+			 */
+			if( result != 1 )
+			{
+				return( -1 );
+			}
+			if( libcthreads_thread_join(
+			     &( ( *readahead )->worker_thread ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join worker thread.",
+				 function );
+
+				result = -1;
+			}
+		}
+		for( chunk_index = 0;
+		     chunk_index < ( *readahead )->number_of_chunks;
+		     chunk_index++ )
+		{
+			if( libluksde_sector_data_free(
+			     &( ( *readahead )->chunks[ chunk_index ].sector_data ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free sector data of chunk: %d.",
+				 function,
+				 chunk_index );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 ( *readahead )->chunks );
+
+		/* The decrypted data of the chunks was cleared when the sector data
+		 * was released to the pool
+		 */
+		if( libluksde_sector_data_pool_free(
+		     &( ( *readahead )->sector_data_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free sector data pool.",
+			 function );
+
+			result = -1;
+		}
+		if( libluksde_encryption_free(
+		     &( ( *readahead )->encryption_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free encryption context.",
+			 function );
+
+			result = -1;
+		}
+		if( libbfio_handle_close(
+		     ( *readahead )->file_io_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close file IO handle.",
+			 function );
+
+			result = -1;
+		}
+		if( libbfio_handle_free(
+		     &( ( *readahead )->file_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file IO handle.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_condition_free(
+		     &( ( *readahead )->completion_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free completion condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_condition_free(
+		     &( ( *readahead )->request_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free request condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *readahead )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *readahead );
+
+		*readahead = NULL;
+	}
+	return( result );
+}
+
+/* Reads and decrypts the requested chunks until the readahead is stopped
+ * The chunk with the lowest offset is read first
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_readahead_worker_callback(
+     libluksde_readahead_t *readahead )
+{
+	libcerror_error_t *error           = NULL;
+	libluksde_readahead_chunk_t *chunk = NULL;
+	static char *function              = "libluksde_readahead_worker_callback";
+	int chunk_index                    = 0;
+	int result                         = 0;
+
+	if( readahead == NULL )
+	{
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     readahead->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	while( readahead->stop == 0 )
+	{
+		chunk = NULL;
+
+		for( chunk_index = 0;
+		     chunk_index < readahead->number_of_chunks;
+		     chunk_index++ )
+		{
+			if( readahead->chunks[ chunk_index ].state != LIBLUKSDE_READAHEAD_CHUNK_STATE_REQUESTED )
+			{
+				continue;
+			}
+			if( ( chunk == NULL )
+			 || ( readahead->chunks[ chunk_index ].offset < chunk->offset ) )
+			{
+				chunk = &( readahead->chunks[ chunk_index ] );
+			}
+		}
+		if( chunk == NULL )
+		{
+			if( libcthreads_condition_wait(
+			     readahead->request_condition,
+			     readahead->mutex,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to wait for request condition.",
+				 function );
+
+				goto on_error;
+			}
+			continue;
+		}
+		chunk->state = LIBLUKSDE_READAHEAD_CHUNK_STATE_READING;
+
+		if( libcthreads_mutex_release(
+		     readahead->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			goto on_error;
+		}
+		/* The chunk is not changed by the thread that reads the volume
+		 * while it is being read
+		 */
+		result = libluksde_sector_data_read(
+		          chunk->sector_data,
+		          readahead->io_handle,
+		          readahead->file_io_handle,
+		          readahead->io_handle->encrypted_volume_offset + chunk->offset,
+		          readahead->encryption_context,
+		          &error );
+
+		/* A chunk that could not be read is read again by the thread that reads
+		 * the volume, which reports the error
+		 */
+		if( result != 1 )
+		{
+			libcerror_error_free(
+			 &error );
+		}
+		if( libcthreads_mutex_grab(
+		     readahead->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			goto on_error;
+		}
+		if( result == 1 )
+		{
+			chunk->state = LIBLUKSDE_READAHEAD_CHUNK_STATE_READ;
+		}
+		else
+		{
+			chunk->state = LIBLUKSDE_READAHEAD_CHUNK_STATE_FAILED;
+		}
+		if( libcthreads_condition_broadcast(
+		     readahead->completion_condition,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast completion condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 readahead->mutex,
+			 NULL );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     readahead->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	libcerror_error_free(
+	 &error );
+
+	return( -1 );
+}
+
+/* Retrieves a chunk that was read ahead
+ * A chunk that is being read by the worker thread is waited for, a chunk
+ * that was requested but not yet read is taken back from the worker thread
+ * The sector data remains valid until the next call to libluksde_readahead_update
+ * Returns 1 if successful, 0 if the chunk was not read ahead or -1 on error
+ */
+int libluksde_readahead_get_chunk(
+     libluksde_readahead_t *readahead,
+     off64_t chunk_offset,
+     libluksde_sector_data_t **sector_data,
+     libcerror_error_t **error )
+{
+	libluksde_readahead_chunk_t *chunk = NULL;
+	static char *function              = "libluksde_readahead_get_chunk";
+	int chunk_index                    = 0;
+	int result                         = 0;
+
+	if( readahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid readahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( sector_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector data.",
+		 function );
+
+		return( -1 );
+	}
+	/* The worker thread does not change a chunk that was read,
+	 * hence the current chunk can be used without grabbing the mutex
+	 */
+	if( ( readahead->current_chunk != NULL )
+	 && ( readahead->current_chunk->offset == chunk_offset ) )
+	{
+		*sector_data = readahead->current_chunk->sector_data;
+
+		return( 1 );
+	}
+	if( chunk_offset == readahead->missed_chunk_offset )
+	{
+		return( 0 );
+	}
+	if( libcthreads_mutex_grab(
+	     readahead->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	for( chunk_index = 0;
+	     chunk_index < readahead->number_of_chunks;
+	     chunk_index++ )
+	{
+		if( ( readahead->chunks[ chunk_index ].state != LIBLUKSDE_READAHEAD_CHUNK_STATE_UNUSED )
+		 && ( readahead->chunks[ chunk_index ].offset == chunk_offset ) )
+		{
+			chunk = &( readahead->chunks[ chunk_index ] );
+
+			break;
+		}
+	}
+	if( chunk != NULL )
+	{
+		while( chunk->state == LIBLUKSDE_READAHEAD_CHUNK_STATE_READING )
+		{
+			if( libcthreads_condition_wait(
+			     readahead->completion_condition,
+			     readahead->mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to wait for completion condition.",
+				 function );
+
+				libcthreads_mutex_release(
+				 readahead->mutex,
+				 NULL );
+
+				return( -1 );
+			}
+		}
+		if( chunk->state == LIBLUKSDE_READAHEAD_CHUNK_STATE_READ )
+		{
+			result = 1;
+		}
+		else
+		{
+			chunk->state = LIBLUKSDE_READAHEAD_CHUNK_STATE_UNUSED;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     readahead->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( result != 0 )
+	{
+		readahead->current_chunk = chunk;
+		readahead->number_of_hits += 1;
+
+		/* The window grows while the chunks read ahead are used
+		 */
+		if( readahead->window_size < readahead->number_of_chunks )
+		{
+			readahead->window_size += 1;
+		}
+		*sector_data = chunk->sector_data;
+	}
+	else
+	{
+		readahead->missed_chunk_offset = chunk_offset;
+
+		if( readahead->number_of_sequential_reads >= LIBLUKSDE_READAHEAD_SEQUENTIAL_READS_THRESHOLD )
+		{
+			readahead->number_of_misses += 1;
+		}
+	}
+	return( result );
+}
+
+/* Updates the readahead after a read of size at offset
+ * Sequential reads request the chunks that follow the read from the worker thread,
+ * other reads reset the window and take back the requests that were not yet read
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_readahead_update(
+     libluksde_readahead_t *readahead,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error )
+{
+	libluksde_readahead_chunk_t *chunk = NULL;
+	static char *function              = "libluksde_readahead_update";
+	size64_t chunk_data_size           = 0;
+	off64_t chunk_offset               = 0;
+	off64_t window_end_offset          = 0;
+	off64_t window_start_offset        = 0;
+	off64_t used_chunk_offset          = 0;
+	int chunk_index                    = 0;
+	int is_requested                   = 0;
+	int number_of_requests             = 0;
+	int result                         = 1;
+
+	if( readahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid readahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( readahead->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid readahead - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset == readahead->next_offset )
+	{
+		if( readahead->number_of_sequential_reads < LIBLUKSDE_READAHEAD_SEQUENTIAL_READS_THRESHOLD )
+		{
+			readahead->number_of_sequential_reads += 1;
+		}
+	}
+	else
+	{
+		readahead->number_of_sequential_reads = 0;
+		readahead->window_size                = readahead->minimum_window_size;
+	}
+	readahead->next_offset = offset + (off64_t) size;
+
+	/* The chunk that contains the next offset can still be in use,
+	 * the window starts at the first chunk that was not read
+	 */
+	used_chunk_offset   = readahead->next_offset - ( readahead->next_offset % (off64_t) readahead->chunk_size );
+	window_start_offset = used_chunk_offset;
+
+	if( window_start_offset < readahead->next_offset )
+	{
+		window_start_offset += (off64_t) readahead->chunk_size;
+	}
+	window_end_offset = window_start_offset;
+
+	if( readahead->number_of_sequential_reads >= LIBLUKSDE_READAHEAD_SEQUENTIAL_READS_THRESHOLD )
+	{
+		window_end_offset += (off64_t) readahead->window_size * (off64_t) readahead->chunk_size;
+	}
+	if( window_end_offset > (off64_t) readahead->io_handle->encrypted_volume_size )
+	{
+		window_end_offset = (off64_t) readahead->io_handle->encrypted_volume_size;
+	}
+	/* Successive reads within the same chunk do not change the window
+	 */
+	if( ( window_start_offset == readahead->requested_start_offset )
+	 && ( window_end_offset == readahead->requested_end_offset ) )
+	{
+		return( 1 );
+	}
+	readahead->requested_start_offset = window_start_offset;
+	readahead->requested_end_offset   = window_end_offset;
+
+	if( libcthreads_mutex_grab(
+	     readahead->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	/* Requests outside the window are taken back from the worker thread
+	 */
+	for( chunk_index = 0;
+	     chunk_index < readahead->number_of_chunks;
+	     chunk_index++ )
+	{
+		chunk = &( readahead->chunks[ chunk_index ] );
+
+		if( ( chunk->state == LIBLUKSDE_READAHEAD_CHUNK_STATE_REQUESTED )
+		 && ( ( chunk->offset < used_chunk_offset )
+		  || ( chunk->offset >= window_end_offset ) ) )
+		{
+			chunk->state = LIBLUKSDE_READAHEAD_CHUNK_STATE_UNUSED;
+		}
+	}
+	for( chunk_offset = window_start_offset;
+	     chunk_offset < window_end_offset;
+	     chunk_offset += (off64_t) readahead->chunk_size )
+	{
+		is_requested = 0;
+
+		for( chunk_index = 0;
+		     chunk_index < readahead->number_of_chunks;
+		     chunk_index++ )
+		{
+			if( ( readahead->chunks[ chunk_index ].state != LIBLUKSDE_READAHEAD_CHUNK_STATE_UNUSED )
+			 && ( readahead->chunks[ chunk_index ].state != LIBLUKSDE_READAHEAD_CHUNK_STATE_FAILED )
+			 && ( readahead->chunks[ chunk_index ].offset == chunk_offset ) )
+			{
+				is_requested = 1;
+
+				break;
+			}
+		}
+		if( is_requested != 0 )
+		{
+			continue;
+		}
+		/* Reuse a chunk that is not being read and is no longer in use
+		 */
+		chunk = NULL;
+
+		for( chunk_index = 0;
+		     chunk_index < readahead->number_of_chunks;
+		     chunk_index++ )
+		{
+			if( ( readahead->chunks[ chunk_index ].state == LIBLUKSDE_READAHEAD_CHUNK_STATE_UNUSED )
+			 || ( readahead->chunks[ chunk_index ].state == LIBLUKSDE_READAHEAD_CHUNK_STATE_FAILED )
+			 || ( ( readahead->chunks[ chunk_index ].state == LIBLUKSDE_READAHEAD_CHUNK_STATE_READ )
+			  && ( ( readahead->chunks[ chunk_index ].offset < used_chunk_offset )
+			   || ( readahead->chunks[ chunk_index ].offset >= window_end_offset ) ) ) )
+			{
+				chunk = &( readahead->chunks[ chunk_index ] );
+
+				break;
+			}
+		}
+		if( chunk == NULL )
+		{
+			break;
+		}
+		chunk_data_size = readahead->io_handle->encrypted_volume_size - (size64_t) chunk_offset;
+
+		if( chunk_data_size > (size64_t) readahead->chunk_size )
+		{
+			chunk_data_size = (size64_t) readahead->chunk_size;
+		}
+		chunk_data_size -= chunk_data_size % readahead->io_handle->bytes_per_sector;
+
+		if( chunk_data_size == 0 )
+		{
+			break;
+		}
+		if( chunk == readahead->current_chunk )
+		{
+			readahead->current_chunk = NULL;
+		}
+		chunk->state = LIBLUKSDE_READAHEAD_CHUNK_STATE_UNUSED;
+
+		/* The blocks of the sector data pool are reused when the size of the chunk changes
+		 */
+		if( ( chunk->sector_data != NULL )
+		 && ( chunk->sector_data->data_size != (size_t) chunk_data_size ) )
+		{
+			if( libluksde_sector_data_free(
+			     &( chunk->sector_data ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free sector data.",
+				 function );
+
+				result = -1;
+
+				break;
+			}
+		}
+		if( chunk->sector_data == NULL )
+		{
+			if( libluksde_sector_data_initialize_from_pool(
+			     &( chunk->sector_data ),
+			     readahead->sector_data_pool,
+			     (size_t) chunk_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create sector data.",
+				 function );
+
+				result = -1;
+
+				break;
+			}
+		}
+		if( chunk_offset == readahead->missed_chunk_offset )
+		{
+			readahead->missed_chunk_offset = -1;
+		}
+		chunk->offset = chunk_offset;
+		chunk->state  = LIBLUKSDE_READAHEAD_CHUNK_STATE_REQUESTED;
+
+		number_of_requests++;
+	}
+	if( number_of_requests > 0 )
+	{
+		if( libcthreads_condition_signal(
+		     readahead->request_condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal request condition.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     readahead->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,198 @@
+/*
+ * Readahead functions
+ *
+ * Copyright (C) 2013-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBLUKSDE_READAHEAD_H )
+#define _LIBLUKSDE_READAHEAD_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libluksde_encryption.h"
+#include "libluksde_io_handle.h"
+#include "libluksde_libbfio.h"
+#include "libluksde_libcerror.h"
+#include "libluksde_libcthreads.h"
+#include "libluksde_sector_data.h"
+#include "libluksde_sector_data_pool.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+
+enum LIBLUKSDE_READAHEAD_CHUNK_STATES
+{
+	LIBLUKSDE_READAHEAD_CHUNK_STATE_UNUSED		= 0,
+	LIBLUKSDE_READAHEAD_CHUNK_STATE_REQUESTED	= 1,
+	LIBLUKSDE_READAHEAD_CHUNK_STATE_READING		= 2,
+	LIBLUKSDE_READAHEAD_CHUNK_STATE_READ		= 3,
+	LIBLUKSDE_READAHEAD_CHUNK_STATE_FAILED		= 4
+};
+
+typedef struct libluksde_readahead_chunk libluksde_readahead_chunk_t;
+
+struct libluksde_readahead_chunk
+{
+	/* The offset of the chunk relative to the start of the encrypted volume
+	 */
+	off64_t offset;
+
+	/* The sector data
+	 */
+	libluksde_sector_data_t *sector_data;
+
+	/* The state
+	 */
+	int state;
+};
+
+typedef struct libluksde_readahead libluksde_readahead_t;
+
+/* The readahead detects sequential reads and has a worker thread read and
+ * decrypt the chunks that follow while the caller consumes the current ones.
+ * The chunks are only scheduled and consumed by the thread that reads the volume,
+ * the worker thread only reads the chunks that were requested.
+ */
+struct libluksde_readahead
+{
+	/* The IO handle
+	 */
+	libluksde_io_handle_t *io_handle;
+
+	/* The file IO handle of the worker thread
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* The encryption context of the worker thread
+	 */
+	libluksde_encryption_context_t *encryption_context;
+
+	/* The sector data pool of the chunks
+	 */
+	libluksde_sector_data_pool_t *sector_data_pool;
+
+	/* The chunk size
+	 */
+	size_t chunk_size;
+
+	/* The chunks
+	 */
+	libluksde_readahead_chunk_t *chunks;
+
+	/* The number of chunks, which is the maximum window size
+	 */
+	int number_of_chunks;
+
+	/* The minimum window size in chunks
+	 */
+	int minimum_window_size;
+
+	/* The current window size in chunks
+	 */
+	int window_size;
+
+	/* The offset at which the next sequential read is expected
+	 */
+	off64_t next_offset;
+
+	/* The number of consecutive sequential reads
+	 */
+	int number_of_sequential_reads;
+
+	/* The chunk that was last retrieved, which is only used by the thread that reads the volume
+	 */
+	libluksde_readahead_chunk_t *current_chunk;
+
+	/* The offset of the chunk that was last not read ahead
+	 */
+	off64_t missed_chunk_offset;
+
+	/* The start and end offset of the chunks that were last requested
+	 */
+	off64_t requested_start_offset;
+	off64_t requested_end_offset;
+
+	/* The number of chunks read from the readahead
+	 */
+	uint64_t number_of_hits;
+
+	/* The number of chunks of sequential reads that were not read ahead
+	 */
+	uint64_t number_of_misses;
+
+	/* Value to indicate the worker thread should stop
+	 */
+	int stop;
+
+	/* The mutex that protects the chunk states
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that signals the worker thread that chunks were requested
+	 */
+	libcthreads_condition_t *request_condition;
+
+	/* The condition that signals a chunk was read by the worker thread
+	 */
+	libcthreads_condition_t *completion_condition;
+
+	/* The worker thread
+	 */
+	libcthreads_thread_t *worker_thread;
+};
+
+int libluksde_readahead_initialize(
+     libluksde_readahead_t **readahead,
+     libluksde_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     size_t chunk_size,
+     int minimum_window_size,
+     int maximum_window_size,
+     libcerror_error_t **error );
+
+int libluksde_readahead_free(
+     libluksde_readahead_t **readahead,
+     libcerror_error_t **error );
+
+int libluksde_readahead_worker_callback(
+     libluksde_readahead_t *readahead );
+
+int libluksde_readahead_get_chunk(
+     libluksde_readahead_t *readahead,
+     off64_t chunk_offset,
+     libluksde_sector_data_t **sector_data,
+     libcerror_error_t **error );
+
+int libluksde_readahead_update(
+     libluksde_readahead_t *readahead,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBLUKSDE_READAHEAD_H ) */
+
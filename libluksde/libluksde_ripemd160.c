@@ -0,0 +1,198 @@
+/*
+ * RIPEMD-160 functions
+ *
+ * Copyright (C) 2013-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <types.h>
+
+#include "libluksde_ripemd160.h"
+
+/* The RIPEMD-160 initial hash values
+ */
+static const uint32_t libluksde_ripemd160_initial_hash_values[ 5 ] = {
+	0x67452301UL, 0xefcdab89UL, 0x98badcfeUL, 0x10325476UL, 0xc3d2e1f0UL };
+
+/* The round constants of the left and right lines, per 16 rounds
+ */
+static const uint32_t libluksde_ripemd160_left_round_constants[ 5 ] = {
+	0x00000000UL, 0x5a827999UL, 0x6ed9eba1UL, 0x8f1bbcdcUL, 0xa953fd4eUL };
+
+static const uint32_t libluksde_ripemd160_right_round_constants[ 5 ] = {
+	0x50a28be6UL, 0x5c4dd124UL, 0x6d703ef3UL, 0x7a6d76e9UL, 0x00000000UL };
+
+/* The message word selection of the left and right lines
+ */
+static const uint8_t libluksde_ripemd160_left_word_indexes[ 80 ] = {
+	0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+	7, 4, 13, 1, 10, 6, 15, 3, 12, 0, 9, 5, 2, 14, 11, 8,
+	3, 10, 14, 4, 9, 15, 8, 1, 2, 7, 0, 6, 13, 11, 5, 12,
+	1, 9, 11, 10, 0, 8, 12, 4, 13, 3, 7, 15, 14, 5, 6, 2,
+	4, 0, 5, 9, 7, 12, 2, 10, 14, 1, 3, 8, 11, 6, 15, 13 };
+
+static const uint8_t libluksde_ripemd160_right_word_indexes[ 80 ] = {
+	5, 14, 7, 0, 9, 2, 11, 4, 13, 6, 15, 8, 1, 10, 3, 12,
+	6, 11, 3, 7, 0, 13, 5, 10, 14, 15, 8, 12, 4, 9, 1, 2,
+	15, 5, 1, 3, 7, 14, 6, 9, 11, 8, 12, 2, 10, 0, 4, 13,
+	8, 6, 4, 1, 3, 11, 15, 0, 5, 12, 2, 13, 9, 7, 10, 14,
+	12, 15, 10, 4, 1, 5, 8, 7, 6, 2, 13, 14, 0, 3, 9, 11 };
+
+/* The number of bits of the left rotations of the left and right lines
+ */
+static const uint8_t libluksde_ripemd160_left_rotations[ 80 ] = {
+	11, 14, 15, 12, 5, 8, 7, 9, 11, 13, 14, 15, 6, 7, 9, 8,
+	7, 6, 8, 13, 11, 9, 7, 15, 7, 12, 15, 9, 11, 7, 13, 12,
+	11, 13, 6, 7, 14, 9, 13, 15, 14, 8, 13, 6, 5, 12, 7, 5,
+	11, 12, 14, 15, 14, 15, 9, 8, 9, 14, 5, 6, 8, 6, 5, 12,
+	9, 15, 5, 11, 6, 8, 13, 12, 5, 12, 13, 14, 11, 8, 5, 6 };
+
+static const uint8_t libluksde_ripemd160_right_rotations[ 80 ] = {
+	8, 9, 9, 11, 13, 15, 15, 5, 7, 7, 8, 11, 14, 14, 12, 6,
+	9, 13, 15, 7, 12, 8, 9, 11, 7, 7, 12, 7, 6, 15, 13, 11,
+	9, 7, 15, 11, 8, 6, 6, 14, 12, 13, 5, 14, 13, 13, 7, 5,
+	15, 5, 8, 11, 14, 14, 6, 14, 6, 9, 12, 9, 12, 5, 15, 8,
+	8, 5, 12, 9, 12, 5, 14, 6, 8, 13, 6, 5, 15, 13, 11, 11 };
+
+#define libluksde_ripemd160_rotate_left( value, number_of_bits ) \
+	( ( ( value ) << ( number_of_bits ) ) | ( ( value ) >> ( 32 - ( number_of_bits ) ) ) )
+
+/* The boolean functions, the left line uses them in order of the rounds
+ * and the right line in reverse order
+ */
+#define libluksde_ripemd160_function0( value_x, value_y, value_z ) \
+	( ( value_x ) ^ ( value_y ) ^ ( value_z ) )
+
+#define libluksde_ripemd160_function1( value_x, value_y, value_z ) \
+	( ( ( value_x ) & ( value_y ) ) | ( ~( value_x ) & ( value_z ) ) )
+
+#define libluksde_ripemd160_function2( value_x, value_y, value_z ) \
+	( ( ( value_x ) | ~( value_y ) ) ^ ( value_z ) )
+
+#define libluksde_ripemd160_function3( value_x, value_y, value_z ) \
+	( ( ( value_x ) & ( value_z ) ) | ( ( value_y ) & ~( value_z ) ) )
+
+#define libluksde_ripemd160_function4( value_x, value_y, value_z ) \
+	( ( value_x ) ^ ( ( value_y ) | ~( value_z ) ) )
+
+/* Applies a round to the working variables A to E of a line
+ */
+#define libluksde_ripemd160_round( values, function_value, word, round_constant, number_of_bits ) \
+	value_t = ( values )[ 0 ] + ( function_value ) + ( word ) + ( round_constant ); \
+	value_t = libluksde_ripemd160_rotate_left( value_t, number_of_bits ) + ( values )[ 4 ]; \
+	( values )[ 0 ] = ( values )[ 4 ]; \
+	( values )[ 4 ] = ( values )[ 3 ]; \
+	( values )[ 3 ] = libluksde_ripemd160_rotate_left( ( values )[ 2 ], 10 ); \
+	( values )[ 2 ] = ( values )[ 1 ]; \
+	( values )[ 1 ] = value_t;
+
+/* Applies 16 rounds to the left and right lines, which use a fixed boolean function
+ */
+#define libluksde_ripemd160_rounds( group_index, left_function, right_function ) \
+	for( round_index = group_index * 16; \
+	     round_index < ( group_index + 1 ) * 16; \
+	     round_index++ ) \
+	{ \
+		libluksde_ripemd160_round( \
+		 left_values, \
+		 left_function( left_values[ 1 ], left_values[ 2 ], left_values[ 3 ] ), \
+		 words[ libluksde_ripemd160_left_word_indexes[ round_index ] ], \
+		 libluksde_ripemd160_left_round_constants[ group_index ], \
+		 libluksde_ripemd160_left_rotations[ round_index ] ) \
+		libluksde_ripemd160_round( \
+		 right_values, \
+		 right_function( right_values[ 1 ], right_values[ 2 ], right_values[ 3 ] ), \
+		 words[ libluksde_ripemd160_right_word_indexes[ round_index ] ], \
+		 libluksde_ripemd160_right_round_constants[ group_index ], \
+		 libluksde_ripemd160_right_rotations[ round_index ] ) \
+	}
+
+/* Sets the initial hash values
+ */
+void libluksde_ripemd160_initialize_hash_values(
+      uint32_t *hash_values )
+{
+	int value_index = 0;
+
+	for( value_index = 0;
+	     value_index < 5;
+	     value_index++ )
+	{
+		hash_values[ value_index ] = libluksde_ripemd160_initial_hash_values[ value_index ];
+	}
+}
+
+/* Applies the RIPEMD-160 compression function to a number of 64-byte blocks
+ * The hash values are updated in place, the blocks are not padded
+ * Note that RIPEMD-160 uses little-endian message words and hash values
+ */
+void libluksde_ripemd160_transform(
+      uint32_t *hash_values,
+      const uint8_t *blocks,
+      size_t number_of_blocks )
+{
+	uint32_t left_values[ 5 ];
+	uint32_t right_values[ 5 ];
+	uint32_t words[ 16 ];
+
+	size_t block_offset = 0;
+	size_t block_index  = 0;
+	uint32_t value_t    = 0;
+	int round_index     = 0;
+	int value_index     = 0;
+
+	for( block_index = 0;
+	     block_index < number_of_blocks;
+	     block_index++ )
+	{
+		for( value_index = 0;
+		     value_index < 16;
+		     value_index++ )
+		{
+			byte_stream_copy_to_uint32_little_endian(
+			 &( blocks[ block_offset + ( value_index * 4 ) ] ),
+			 words[ value_index ] );
+		}
+		for( value_index = 0;
+		     value_index < 5;
+		     value_index++ )
+		{
+			left_values[ value_index ]  = hash_values[ value_index ];
+			right_values[ value_index ] = hash_values[ value_index ];
+		}
+		/* left_values[ 0 ] to left_values[ 4 ] and right_values[ 0 ] to right_values[ 4 ]
+		 * contain the working variables A to E of the left and right lines
+		 */
+		libluksde_ripemd160_rounds( 0, libluksde_ripemd160_function0, libluksde_ripemd160_function4 )
+		libluksde_ripemd160_rounds( 1, libluksde_ripemd160_function1, libluksde_ripemd160_function3 )
+		libluksde_ripemd160_rounds( 2, libluksde_ripemd160_function2, libluksde_ripemd160_function2 )
+		libluksde_ripemd160_rounds( 3, libluksde_ripemd160_function3, libluksde_ripemd160_function1 )
+		libluksde_ripemd160_rounds( 4, libluksde_ripemd160_function4, libluksde_ripemd160_function0 )
+
+		value_t          = hash_values[ 1 ] + left_values[ 2 ] + right_values[ 3 ];
+		hash_values[ 1 ] = hash_values[ 2 ] + left_values[ 3 ] + right_values[ 4 ];
+		hash_values[ 2 ] = hash_values[ 3 ] + left_values[ 4 ] + right_values[ 0 ];
+		hash_values[ 3 ] = hash_values[ 4 ] + left_values[ 0 ] + right_values[ 1 ];
+		hash_values[ 4 ] = hash_values[ 0 ] + left_values[ 1 ] + right_values[ 2 ];
+		hash_values[ 0 ] = value_t;
+
+		block_offset += LIBLUKSDE_RIPEMD160_BLOCK_SIZE;
+	}
+}
+
@@ -31,8 +31,134 @@
 #include "libluksde_libcerror.h"
 #include "libluksde_libcnotify.h"
 #include "libluksde_sector_data.h"
+#include "libluksde_sector_data_pool.h"
+
+/* Determines the size of the block that contains the sector data
+ * The block contains the sector data structure followed by the data,
+ * which is aligned to LIBLUKSDE_SECTOR_DATA_ALIGNMENT
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_sector_data_get_block_size(
+     size_t data_size,
+     size_t *block_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_sector_data_get_block_size";
+
+	if( data_size > (size_t) LIBLUKSDE_MAXIMUM_CHUNK_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block size.",
+		 function );
+
+		return( -1 );
+	}
+	*block_size = sizeof( libluksde_sector_data_t );
+
+	if( data_size > 0 )
+	{
+		/* The memory allocator does not guarantee the alignment, hence the
+		 * additional alignment - 1 bytes to align the start of the data
+		 */
+		*block_size += ( LIBLUKSDE_SECTOR_DATA_ALIGNMENT - 1 ) + data_size;
+	}
+	return( 1 );
+}
+
+/* Sets up the sector data in a block of block size
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_sector_data_set_block(
+     libluksde_sector_data_t *sector_data,
+     size_t block_size,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function    = "libluksde_sector_data_set_block";
+	size_t alignment_padding = 0;
+	size_t required_size     = 0;
+
+	if( sector_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector data.",
+		 function );
+
+		return( -1 );
+	}
+	if( libluksde_sector_data_get_block_size(
+	     data_size,
+	     &required_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine block size.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_size < required_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid block size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     sector_data,
+	     0,
+	     sizeof( libluksde_sector_data_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear sector data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > 0 )
+	{
+		sector_data->data = &( ( (uint8_t *) sector_data )[ sizeof( libluksde_sector_data_t ) ] );
+
+		alignment_padding = (size_t) ( (intptr_t) sector_data->data % LIBLUKSDE_SECTOR_DATA_ALIGNMENT );
+
+		if( alignment_padding != 0 )
+		{
+			sector_data->data += LIBLUKSDE_SECTOR_DATA_ALIGNMENT - alignment_padding;
+		}
+		sector_data->data_size = data_size;
+	}
+	return( 1 );
+}
 
 /* Creates sector data
+ * The sector data structure and data are allocated as a single block
  * Make sure the value sector_data is referencing, is set to NULL
  * Returns 1 if successful or -1 on error
  */
@@ -42,6 +168,7 @@ int libluksde_sector_data_initialize(
      libcerror_error_t **error )
 {
 	static char *function = "libluksde_sector_data_initialize";
+	size_t block_size     = 0;
 
 	if( sector_data == NULL )
 	{
@@ -65,19 +192,22 @@ int libluksde_sector_data_initialize(
 
 		return( -1 );
 	}
-	if( data_size > (size_t) SSIZE_MAX )
+	if( libluksde_sector_data_get_block_size(
+	     data_size,
+	     &block_size,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid data size value exceeds maximum.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine block size.",
 		 function );
 
 		return( -1 );
 	}
-	*sector_data = memory_allocate_structure(
-	                libluksde_sector_data_t );
+	*sector_data = (libluksde_sector_data_t *) memory_allocate(
+	                                            block_size );
 
 	if( *sector_data == NULL )
 	{
@@ -90,84 +220,138 @@ int libluksde_sector_data_initialize(
 
 		goto on_error;
 	}
-	if( memory_set(
+	if( libluksde_sector_data_set_block(
 	     *sector_data,
-	     0,
-	     sizeof( libluksde_sector_data_t ) ) == NULL )
+	     block_size,
+	     data_size,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to clear sector data.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set up sector data.",
 		 function );
 
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *sector_data != NULL )
+	{
 		memory_free(
 		 *sector_data );
 
 		*sector_data = NULL;
+	}
+	return( -1 );
+}
+
+/* Creates sector data from a block of the sector data pool
+ * Make sure the value sector_data is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_sector_data_initialize_from_pool(
+     libluksde_sector_data_t **sector_data,
+     libluksde_sector_data_pool_t *pool,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t *block        = NULL;
+	static char *function = "libluksde_sector_data_initialize_from_pool";
+
+	if( sector_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector data.",
+		 function );
 
 		return( -1 );
 	}
-	if( data_size > 0 )
+	if( *sector_data != NULL )
 	{
-		( *sector_data )->encrypted_data = (uint8_t *) memory_allocate(
-		                                                sizeof( uint8_t ) * data_size );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid sector data value already set.",
+		 function );
 
-		if( ( *sector_data )->encrypted_data == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-			 "%s: unable to create encrypted data.",
-			 function );
-
-			goto on_error;
-		}
-		( *sector_data )->data = (uint8_t *) memory_allocate(
-		                                      sizeof( uint8_t ) * data_size );
+		return( -1 );
+	}
+	if( pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool.",
+		 function );
 
-		if( ( *sector_data )->data == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-			 "%s: unable to create data.",
-			 function );
-
-			goto on_error;
-		}
-		( *sector_data )->data_size = data_size;
+		return( -1 );
 	}
+	if( libluksde_sector_data_pool_get_block(
+	     pool,
+	     &block,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve block from pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( libluksde_sector_data_set_block(
+	     (libluksde_sector_data_t *) block,
+	     pool->block_size,
+	     data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set up sector data.",
+		 function );
+
+		goto on_error;
+	}
+	*sector_data = (libluksde_sector_data_t *) block;
+
+	( *sector_data )->pool = pool;
+
 	return( 1 );
 
 on_error:
-	if( *sector_data != NULL )
+	if( block != NULL )
 	{
-		if( ( *sector_data )->encrypted_data != NULL )
-		{
-			memory_free(
-			 ( *sector_data )->encrypted_data );
-		}
-		memory_free(
-		 *sector_data );
-
-		*sector_data = NULL;
+		libluksde_sector_data_pool_release_block(
+		 pool,
+		 block,
+		 NULL );
 	}
 	return( -1 );
 }
 
 /* Frees sector data
+ * Sector data created from a pool is cleared and released back to the pool,
+ * otherwise the data is cleared and freed
  * Returns 1 if successful or -1 on error
  */
 int libluksde_sector_data_free(
      libluksde_sector_data_t **sector_data,
      libcerror_error_t **error )
 {
-	static char *function = "libluksde_sector_data_free";
-	int result            = 1;
+	libluksde_sector_data_pool_t *pool = NULL;
+	static char *function              = "libluksde_sector_data_free";
+	int result                         = 1;
 
 	if( sector_data == NULL )
 	{
@@ -182,37 +366,54 @@ int libluksde_sector_data_free(
 	}
 	if( *sector_data != NULL )
 	{
-		if( ( *sector_data )->data != NULL )
+		pool = ( *sector_data )->pool;
+
+		if( pool != NULL )
 		{
-			if( memory_set(
-			     ( *sector_data )->data,
-			     0,
-			     ( *sector_data )->data_size ) == NULL )
+			if( libluksde_sector_data_pool_release_block(
+			     pool,
+			     (uint8_t *) *sector_data,
+			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_MEMORY,
-				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-				 "%s: unable to clear data.",
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to release block to pool.",
 				 function );
 
 				result = -1;
 			}
+		}
+		else
+		{
+			if( ( *sector_data )->data != NULL )
+			{
+				if( memory_set(
+				     ( *sector_data )->data,
+				     0,
+				     ( *sector_data )->data_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to clear data.",
+					 function );
+
+					result = -1;
+				}
+			}
 			memory_free(
-			 ( *sector_data )->data );
-
-			memory_free(
-			 ( *sector_data )->encrypted_data );
+			 *sector_data );
 		}
-		memory_free(
-		 *sector_data );
-
 		*sector_data = NULL;
 	}
 	return( result );
 }
 
 /* Reads sector data
+ * The encrypted data is read into the data and decrypted in place
  * Returns 1 if successful or -1 on error
  */
 int libluksde_sector_data_read(
@@ -237,17 +438,6 @@ int libluksde_sector_data_read(
 
 		return( -1 );
 	}
-	if( sector_data->encrypted_data == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid sector data - missing encrypted data.",
-		 function );
-
-		return( -1 );
-	}
 	if( sector_data->data == NULL )
 	{
 		libcerror_error_set(
@@ -309,7 +499,7 @@ int libluksde_sector_data_read(
 	}
 	read_count = libbfio_handle_read_buffer(
 	              file_io_handle,
-	              sector_data->encrypted_data,
+	              sector_data->data,
 	              sector_data->data_size,
 	              error );
 
@@ -331,7 +521,7 @@ int libluksde_sector_data_read(
 		 "%s: encrypted sector data:\n",
 		 function );
 		libcnotify_print_data(
-		 sector_data->encrypted_data,
+		 sector_data->data,
 		 sector_data->data_size,
 		 0 );
 	}
@@ -339,14 +529,15 @@ int libluksde_sector_data_read(
 	sector_data_offset -= io_handle->encrypted_volume_offset;
 	sector_data_offset /= io_handle->bytes_per_sector;
 
-	if( libluksde_encryption_crypt(
+	if( libluksde_encryption_crypt_sectors(
 	     encryption_context,
 	     LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
-	     sector_data->encrypted_data,
+	     sector_data->data,
 	     sector_data->data_size,
 	     sector_data->data,
 	     sector_data->data_size,
 	     (uint64_t) sector_data_offset,
+	     (size_t) io_handle->bytes_per_sector,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
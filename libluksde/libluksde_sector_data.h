@@ -29,6 +29,7 @@
 #include "libluksde_io_handle.h"
 #include "libluksde_libbfio.h"
 #include "libluksde_libcerror.h"
+#include "libluksde_sector_data_pool.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -38,10 +39,6 @@ typedef struct libluksde_sector_data libluksde_sector_data_t;
 
 struct libluksde_sector_data
 {
-	/* The encrypted data
-	 */
-	uint8_t *encrypted_data;
-
 	/* The data
 	 */
 	uint8_t *data;
@@ -49,13 +46,34 @@ struct libluksde_sector_data
 	/* The data size
 	 */
 	size_t data_size;
+
+	/* The pool the sector data was retrieved from or NULL if not set
+	 */
+	libluksde_sector_data_pool_t *pool;
 };
 
+int libluksde_sector_data_get_block_size(
+     size_t data_size,
+     size_t *block_size,
+     libcerror_error_t **error );
+
+int libluksde_sector_data_set_block(
+     libluksde_sector_data_t *sector_data,
+     size_t block_size,
+     size_t data_size,
+     libcerror_error_t **error );
+
 int libluksde_sector_data_initialize(
      libluksde_sector_data_t **sector_data,
      size_t data_size,
      libcerror_error_t **error );
 
+int libluksde_sector_data_initialize_from_pool(
+     libluksde_sector_data_t **sector_data,
+     libluksde_sector_data_pool_t *pool,
+     size_t data_size,
+     libcerror_error_t **error );
+
 int libluksde_sector_data_free(
      libluksde_sector_data_t **sector_data,
      libcerror_error_t **error );
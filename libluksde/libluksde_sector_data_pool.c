@@ -0,0 +1,315 @@
+/*
+ * Sector data pool functions
+ *
+ * Copyright (C) 2013-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libluksde_libcerror.h"
+#include "libluksde_sector_data_pool.h"
+
+/* Creates a sector data pool
+ * The pool recycles blocks of a fixed size, which are allocated on demand
+ * Make sure the value pool is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_sector_data_pool_initialize(
+     libluksde_sector_data_pool_t **pool,
+     size_t block_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_sector_data_pool_initialize";
+
+	if( pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_size < sizeof( uint8_t * ) )
+	 || ( block_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*pool = memory_allocate_structure(
+	         libluksde_sector_data_pool_t );
+
+	if( *pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *pool,
+	     0,
+	     sizeof( libluksde_sector_data_pool_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear pool.",
+		 function );
+
+		goto on_error;
+	}
+	( *pool )->block_size = block_size;
+
+	return( 1 );
+
+on_error:
+	if( *pool != NULL )
+	{
+		memory_free(
+		 *pool );
+
+		*pool = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a sector data pool
+ * The unused blocks were cleared when they were released.
+ * All the blocks must have been released.
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_sector_data_pool_free(
+     libluksde_sector_data_pool_t **pool,
+     libcerror_error_t **error )
+{
+	uint8_t *block        = NULL;
+	uint8_t *next_block   = NULL;
+	static char *function = "libluksde_sector_data_pool_free";
+	int result            = 1;
+
+	if( pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *pool != NULL )
+	{
+		if( ( *pool )->number_of_unused_blocks != ( *pool )->number_of_blocks )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid pool - %d blocks still in use.",
+			 function,
+			 ( *pool )->number_of_blocks - ( *pool )->number_of_unused_blocks );
+
+			result = -1;
+		}
+		block = ( *pool )->unused_blocks;
+
+		while( block != NULL )
+		{
+			next_block = *( (uint8_t **) block );
+
+			memory_free(
+			 block );
+
+			block = next_block;
+		}
+		memory_free(
+		 *pool );
+
+		*pool = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves a block from the pool
+ * An unused block is reused if available, otherwise a new block is allocated
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_sector_data_pool_get_block(
+     libluksde_sector_data_pool_t *pool,
+     uint8_t **block,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_sector_data_pool_get_block";
+
+	if( pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block.",
+		 function );
+
+		return( -1 );
+	}
+	if( pool->unused_blocks != NULL )
+	{
+		*block = pool->unused_blocks;
+
+		pool->unused_blocks = *( (uint8_t **) *block );
+
+		pool->number_of_unused_blocks -= 1;
+
+		return( 1 );
+	}
+	if( pool->number_of_blocks == INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid pool - number of blocks value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	*block = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * pool->block_size );
+
+	if( *block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create block.",
+		 function );
+
+		return( -1 );
+	}
+	pool->number_of_blocks += 1;
+
+	return( 1 );
+}
+
+/* Releases a block that was retrieved from the pool so it can be reused
+ * The block is cleared since it can contain decrypted data
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_sector_data_pool_release_block(
+     libluksde_sector_data_pool_t *pool,
+     uint8_t *block,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_sector_data_pool_release_block";
+
+	if( pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block.",
+		 function );
+
+		return( -1 );
+	}
+	if( pool->number_of_unused_blocks >= pool->number_of_blocks )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid pool - no blocks in use.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     block,
+	     0,
+	     pool->block_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear block.",
+		 function );
+
+		return( -1 );
+	}
+	*( (uint8_t **) block ) = pool->unused_blocks;
+
+	pool->unused_blocks = block;
+
+	pool->number_of_unused_blocks += 1;
+
+	return( 1 );
+}
+
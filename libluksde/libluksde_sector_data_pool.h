@@ -0,0 +1,80 @@
+/*
+ * Sector data pool functions
+ *
+ * Copyright (C) 2013-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBLUKSDE_SECTOR_DATA_POOL_H )
+#define _LIBLUKSDE_SECTOR_DATA_POOL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libluksde_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libluksde_sector_data_pool libluksde_sector_data_pool_t;
+
+struct libluksde_sector_data_pool
+{
+	/* The block size
+	 */
+	size_t block_size;
+
+	/* The unused blocks, where every unused block starts with
+	 * a reference to the next unused block
+	 */
+	uint8_t *unused_blocks;
+
+	/* The number of blocks
+	 */
+	int number_of_blocks;
+
+	/* The number of unused blocks
+	 */
+	int number_of_unused_blocks;
+};
+
+int libluksde_sector_data_pool_initialize(
+     libluksde_sector_data_pool_t **pool,
+     size_t block_size,
+     libcerror_error_t **error );
+
+int libluksde_sector_data_pool_free(
+     libluksde_sector_data_pool_t **pool,
+     libcerror_error_t **error );
+
+int libluksde_sector_data_pool_get_block(
+     libluksde_sector_data_pool_t *pool,
+     uint8_t **block,
+     libcerror_error_t **error );
+
+int libluksde_sector_data_pool_release_block(
+     libluksde_sector_data_pool_t *pool,
+     uint8_t *block,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBLUKSDE_SECTOR_DATA_POOL_H ) */
+
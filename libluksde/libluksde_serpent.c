@@ -0,0 +1,2495 @@
+/*
+ * Serpent functions
+ *
+ * Copyright (C) 2013-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libluksde_aesni.h"
+#include "libluksde_encryption.h"
+#include "libluksde_libcerror.h"
+#include "libluksde_serpent.h"
+
+#if defined( HAVE_LIBLUKSDE_AVX2_SUPPORT )
+
+#include <immintrin.h>
+
+#define LIBLUKSDE_SERPENT_AVX2_TARGET \
+	__attribute__(( target( "avx2" ) ))
+
+#define libluksde_serpent_avx2_rotate_left( vector, number_of_bits ) \
+	_mm256_or_si256( _mm256_slli_epi32( vector, number_of_bits ), _mm256_srli_epi32( vector, 32 - ( number_of_bits ) ) )
+
+#define libluksde_serpent_avx2_rotate_right( vector, number_of_bits ) \
+	_mm256_or_si256( _mm256_srli_epi32( vector, number_of_bits ), _mm256_slli_epi32( vector, 32 - ( number_of_bits ) ) )
+
+#define libluksde_serpent_avx2_shift_left( vector, number_of_bits ) \
+	_mm256_slli_epi32( vector, number_of_bits )
+
+#define libluksde_serpent_avx2_xor_round_key( word0, word1, word2, word3, round_key ) \
+	do { \
+		word0 = _mm256_xor_si256( word0, _mm256_set1_epi32( (int) ( round_key )[ 0 ] ) ); \
+		word1 = _mm256_xor_si256( word1, _mm256_set1_epi32( (int) ( round_key )[ 1 ] ) ); \
+		word2 = _mm256_xor_si256( word2, _mm256_set1_epi32( (int) ( round_key )[ 2 ] ) ); \
+		word3 = _mm256_xor_si256( word3, _mm256_set1_epi32( (int) ( round_key )[ 3 ] ) ); \
+	} while( 0 )
+
+#endif /* defined( HAVE_LIBLUKSDE_AVX2_SUPPORT ) */
+
+#define libluksde_serpent_rotate_left( value, number_of_bits ) \
+	( ( ( value ) << ( number_of_bits ) ) | ( ( value ) >> ( 32 - ( number_of_bits ) ) ) )
+
+#define libluksde_serpent_rotate_right( value, number_of_bits ) \
+	( ( ( value ) >> ( number_of_bits ) ) | ( ( value ) << ( 32 - ( number_of_bits ) ) ) )
+
+#define libluksde_serpent_shift_left( value, number_of_bits ) \
+	( ( value ) << ( number_of_bits ) )
+
+#define libluksde_serpent_xor_round_key( word0, word1, word2, word3, round_key ) \
+	do { \
+		word0 ^= ( round_key )[ 0 ]; \
+		word1 ^= ( round_key )[ 1 ]; \
+		word2 ^= ( round_key )[ 2 ]; \
+		word3 ^= ( round_key )[ 3 ]; \
+	} while( 0 )
+
+/* The S-boxes and the linear transformation operate on bit-sliced words, where bit N of
+ * word0 to word3 form the input of the S-box applied to column N of the block.
+ * They are defined as macros so that they apply to both 32-bit integers and AVX2 vectors
+ * of 32-bit integers, where every vector element contains the same word of a different block.
+ * The S-box circuits leave their result in word0 to word3.
+ */
+
+/* Applies the linear transformation to 4 bit-sliced words
+ */
+#define libluksde_serpent_linear_transform( word0, word1, word2, word3, rotate_left, shift_left ) \
+	do { \
+		word0 = rotate_left( word0, 13 ); \
+		word2 = rotate_left( word2, 3 ); \
+		word1 ^= word0 ^ word2; \
+		word3 ^= word2 ^ shift_left( word0, 3 ); \
+		word1 = rotate_left( word1, 1 ); \
+		word3 = rotate_left( word3, 7 ); \
+		word0 ^= word1 ^ word3; \
+		word2 ^= word3 ^ shift_left( word1, 7 ); \
+		word0 = rotate_left( word0, 5 ); \
+		word2 = rotate_left( word2, 22 ); \
+	} while( 0 )
+
+/* Applies the inverse of the linear transformation to 4 bit-sliced words
+ */
+#define libluksde_serpent_inverse_linear_transform( word0, word1, word2, word3, rotate_right, shift_left ) \
+	do { \
+		word2 = rotate_right( word2, 22 ); \
+		word0 = rotate_right( word0, 5 ); \
+		word2 ^= word3 ^ shift_left( word1, 7 ); \
+		word0 ^= word1 ^ word3; \
+		word3 = rotate_right( word3, 7 ); \
+		word1 = rotate_right( word1, 1 ); \
+		word3 ^= word2 ^ shift_left( word0, 3 ); \
+		word1 ^= word0 ^ word2; \
+		word2 = rotate_right( word2, 3 ); \
+		word0 = rotate_right( word0, 13 ); \
+	} while( 0 )
+
+/* Applies S-box 0 to 4 bit-sliced 32-bit words
+ * The fifth word is used as a temporary value
+ */
+#define libluksde_serpent_substitute0( word0, word1, word2, word3, word4 ) \
+	do { \
+		word4 = word3; word3 |= word0; word0 ^= word4; word4 ^= word2; \
+		word4 = ~word4; word3 ^= word1; word1 &= word0; word1 ^= word4; \
+		word2 ^= word0; word0 ^= word3; word4 |= word0; word0 ^= word2; \
+		word2 &= word1; word3 ^= word2; word1 = ~word1; word2 ^= word4; \
+		word1 ^= word2; word4 = word0; word0 = word2; word2 = word3; \
+		word3 = word4; \
+	} while( 0 )
+
+/* Applies S-box 1 to 4 bit-sliced 32-bit words
+ * The fifth word is used as a temporary value
+ */
+#define libluksde_serpent_substitute1( word0, word1, word2, word3, word4 ) \
+	do { \
+		word4 = word1; word1 ^= word0; word0 ^= word3; word3 = ~word3; \
+		word4 &= word1; word0 |= word1; word3 ^= word2; word0 ^= word3; \
+		word1 ^= word3; word3 ^= word4; word1 |= word4; word4 ^= word2; \
+		word2 &= word0; word2 ^= word1; word1 |= word0; word0 = ~word0; \
+		word0 ^= word2; word4 ^= word1; word1 = word2; word2 = word3; \
+		word3 = word0; word0 = word4; \
+	} while( 0 )
+
+/* Applies S-box 2 to 4 bit-sliced 32-bit words
+ * The fifth word is used as a temporary value
+ */
+#define libluksde_serpent_substitute2( word0, word1, word2, word3, word4 ) \
+	do { \
+		word3 = ~word3; word1 ^= word0; word4 = word0; word0 &= word2; \
+		word0 ^= word3; word3 |= word4; word2 ^= word1; word3 ^= word1; \
+		word1 &= word0; word0 ^= word2; word2 &= word3; word3 |= word1; \
+		word0 = ~word0; word3 ^= word0; word4 ^= word0; word0 ^= word2; \
+		word1 |= word2; word2 = word0; word0 = word4; \
+	} while( 0 )
+
+/* Applies S-box 3 to 4 bit-sliced 32-bit words
+ * The fifth word is used as a temporary value
+ */
+#define libluksde_serpent_substitute3( word0, word1, word2, word3, word4 ) \
+	do { \
+		word4 = word1; word1 ^= word3; word3 |= word0; word4 &= word0; \
+		word0 ^= word2; word2 ^= word1; word1 &= word3; word2 ^= word3; \
+		word0 |= word4; word4 ^= word3; word1 ^= word0; word0 &= word3; \
+		word3 &= word4; word3 ^= word2; word4 |= word1; word2 &= word1; \
+		word4 ^= word3; word0 ^= word3; word3 ^= word2; word2 = word1; \
+		word1 = word4; word4 = word0; word0 = word3; word3 = word4; \
+	} while( 0 )
+
+/* Applies S-box 4 to 4 bit-sliced 32-bit words
+ * The fifth word is used as a temporary value
+ */
+#define libluksde_serpent_substitute4( word0, word1, word2, word3, word4 ) \
+	do { \
+		word4 = word3; word3 &= word0; word0 ^= word4; word3 ^= word2; \
+		word2 |= word4; word0 ^= word1; word4 ^= word3; word2 |= word0; \
+		word2 ^= word1; word1 &= word0; word1 ^= word4; word4 &= word2; \
+		word2 ^= word3; word4 ^= word0; word3 |= word1; word1 = ~word1; \
+		word3 ^= word0; word0 = word1; word1 = word2; word2 = word3; \
+		word3 = word4; \
+	} while( 0 )
+
+/* Applies S-box 5 to 4 bit-sliced 32-bit words
+ * The fifth word is used as a temporary value
+ */
+#define libluksde_serpent_substitute5( word0, word1, word2, word3, word4 ) \
+	do { \
+		word4 = word1; word1 |= word0; word2 ^= word1; word3 = ~word3; \
+		word4 ^= word0; word0 ^= word2; word1 &= word4; word4 |= word3; \
+		word4 ^= word0; word0 &= word3; word1 ^= word3; word3 ^= word2; \
+		word0 ^= word1; word2 &= word4; word1 ^= word2; word2 &= word0; \
+		word3 ^= word2; word2 = word1; word1 = word0; word0 = word4; \
+	} while( 0 )
+
+/* Applies S-box 6 to 4 bit-sliced 32-bit words
+ * The fifth word is used as a temporary value
+ */
+#define libluksde_serpent_substitute6( word0, word1, word2, word3, word4 ) \
+	do { \
+		word4 = word1; word3 ^= word0; word1 ^= word2; word2 ^= word0; \
+		word0 &= word3; word1 |= word3; word4 = ~word4; word0 ^= word1; \
+		word1 ^= word2; word3 ^= word4; word4 ^= word0; word2 &= word0; \
+		word4 ^= word1; word2 ^= word3; word3 &= word1; word3 ^= word0; \
+		word1 ^= word2; word0 = word2; word2 = word1; word1 = word4; \
+	} while( 0 )
+
+/* Applies S-box 7 to 4 bit-sliced 32-bit words
+ * The fifth word is used as a temporary value
+ */
+#define libluksde_serpent_substitute7( word0, word1, word2, word3, word4 ) \
+	do { \
+		word1 = ~word1; word4 = word1; word0 = ~word0; word1 &= word2; \
+		word1 ^= word3; word3 |= word4; word4 ^= word2; word2 ^= word3; \
+		word3 ^= word0; word0 |= word1; word2 &= word0; word0 ^= word4; \
+		word4 ^= word3; word3 &= word0; word4 ^= word1; word2 ^= word4; \
+		word3 ^= word1; word4 |= word0; word4 ^= word1; word1 = word2; \
+		word2 = word3; word3 = word0; word0 = word4; \
+	} while( 0 )
+
+/* Applies the inverse of S-box 0 to 4 bit-sliced 32-bit words
+ * The fifth word is used as a temporary value
+ */
+#define libluksde_serpent_inverse_substitute0( word0, word1, word2, word3, word4 ) \
+	do { \
+		word4 = word3; word1 ^= word0; word3 |= word1; word4 ^= word1; \
+		word0 = ~word0; word2 ^= word3; word3 ^= word0; word0 &= word1; \
+		word0 ^= word2; word2 &= word3; word3 ^= word4; word2 ^= word3; \
+		word1 ^= word3; word3 &= word0; word1 ^= word0; word0 ^= word2; \
+		word4 ^= word3; word3 = word0; word0 = word2; word2 = word1; \
+		word1 = word4; \
+	} while( 0 )
+
+/* Applies the inverse of S-box 1 to 4 bit-sliced 32-bit words
+ * The fifth word is used as a temporary value
+ */
+#define libluksde_serpent_inverse_substitute1( word0, word1, word2, word3, word4 ) \
+	do { \
+		word1 ^= word3; word4 = word0; word0 ^= word2; word2 = ~word2; \
+		word4 |= word1; word4 ^= word3; word3 &= word1; word1 ^= word2; \
+		word2 &= word4; word4 ^= word1; word1 |= word3; word3 ^= word0; \
+		word2 ^= word0; word0 |= word4; word2 ^= word4; word1 ^= word0; \
+		word4 ^= word1; word0 = word4; \
+	} while( 0 )
+
+/* Applies the inverse of S-box 2 to 4 bit-sliced 32-bit words
+ * The fifth word is used as a temporary value
+ */
+#define libluksde_serpent_inverse_substitute2( word0, word1, word2, word3, word4 ) \
+	do { \
+		word2 ^= word1; word4 = word3; word3 = ~word3; word3 |= word2; \
+		word2 ^= word4; word4 ^= word0; word3 ^= word1; word1 |= word2; \
+		word2 ^= word0; word1 ^= word4; word4 |= word3; word2 ^= word3; \
+		word4 ^= word2; word2 &= word1; word2 ^= word3; word3 ^= word4; \
+		word4 ^= word0; word0 = word1; word1 = word4; word4 = word2; \
+		word2 = word3; word3 = word4; \
+	} while( 0 )
+
+/* Applies the inverse of S-box 3 to 4 bit-sliced 32-bit words
+ * The fifth word is used as a temporary value
+ */
+#define libluksde_serpent_inverse_substitute3( word0, word1, word2, word3, word4 ) \
+	do { \
+		word2 ^= word1; word4 = word1; word1 &= word2; word1 ^= word0; \
+		word0 |= word4; word4 ^= word3; word0 ^= word3; word3 |= word1; \
+		word1 ^= word2; word1 ^= word3; word0 ^= word2; word2 ^= word3; \
+		word3 &= word1; word1 ^= word0; word0 &= word2; word4 ^= word3; \
+		word3 ^= word0; word0 ^= word1; word1 = word0; word0 = word2; \
+		word2 = word4; \
+	} while( 0 )
+
+/* Applies the inverse of S-box 4 to 4 bit-sliced 32-bit words
+ * The fifth word is used as a temporary value
+ */
+#define libluksde_serpent_inverse_substitute4( word0, word1, word2, word3, word4 ) \
+	do { \
+		word2 ^= word3; word4 = word0; word0 &= word1; word0 ^= word2; \
+		word2 |= word3; word4 = ~word4; word1 ^= word0; word0 ^= word2; \
+		word2 &= word4; word2 ^= word0; word0 |= word4; word0 ^= word3; \
+		word3 &= word2; word4 ^= word3; word3 ^= word1; word1 &= word0; \
+		word4 ^= word1; word0 ^= word3; word1 = word2; word2 = word4; \
+	} while( 0 )
+
+/* Applies the inverse of S-box 5 to 4 bit-sliced 32-bit words
+ * The fifth word is used as a temporary value
+ */
+#define libluksde_serpent_inverse_substitute5( word0, word1, word2, word3, word4 ) \
+	do { \
+		word4 = word1; word1 |= word2; word2 ^= word4; word1 ^= word3; \
+		word3 &= word4; word2 ^= word3; word3 |= word0; word0 = ~word0; \
+		word3 ^= word2; word2 |= word0; word4 ^= word1; word2 ^= word4; \
+		word4 &= word0; word0 ^= word1; word1 ^= word3; word0 &= word2; \
+		word2 ^= word3; word0 ^= word2; word2 ^= word4; word4 ^= word3; \
+		word3 = word2; word2 = word0; word0 = word1; word1 = word4; \
+	} while( 0 )
+
+/* Applies the inverse of S-box 6 to 4 bit-sliced 32-bit words
+ * The fifth word is used as a temporary value
+ */
+#define libluksde_serpent_inverse_substitute6( word0, word1, word2, word3, word4 ) \
+	do { \
+		word0 ^= word2; word4 = word0; word0 &= word3; word2 ^= word3; \
+		word0 ^= word2; word3 ^= word1; word2 |= word4; word2 ^= word3; \
+		word3 &= word0; word0 = ~word0; word3 ^= word1; word1 &= word2; \
+		word4 ^= word0; word3 ^= word4; word4 ^= word2; word0 ^= word1; \
+		word2 ^= word0; word1 = word4; word4 = word0; word0 = word2; \
+		word2 = word3; word3 = word4; \
+	} while( 0 )
+
+/* Applies the inverse of S-box 7 to 4 bit-sliced 32-bit words
+ * The fifth word is used as a temporary value
+ */
+#define libluksde_serpent_inverse_substitute7( word0, word1, word2, word3, word4 ) \
+	do { \
+		word4 = word3; word3 &= word0; word0 ^= word2; word2 |= word4; \
+		word4 ^= word1; word0 = ~word0; word1 |= word3; word4 ^= word0; \
+		word0 &= word2; word0 ^= word1; word1 &= word2; word3 ^= word2; \
+		word4 ^= word3; word2 &= word3; word3 |= word0; word1 ^= word4; \
+		word3 ^= word4; word4 &= word0; word4 ^= word2; word2 = word0; \
+		word0 = word1; word1 = word3; word3 = word4; \
+	} while( 0 )
+
+/* Creates a context
+ * Make sure the value context is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_serpent_context_initialize(
+     libluksde_serpent_context_t **context,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_serpent_context_initialize";
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *context != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid context value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*context = memory_allocate_structure(
+	            libluksde_serpent_context_t );
+
+	if( *context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create context.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *context,
+	     0,
+	     sizeof( libluksde_serpent_context_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear context.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *context != NULL )
+	{
+		memory_free(
+		 *context );
+
+		*context = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a context
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_serpent_context_free(
+     libluksde_serpent_context_t **context,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_serpent_context_free";
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *context != NULL )
+	{
+		/* The round keys are key material
+		 */
+		memory_set(
+		 *context,
+		 0,
+		 sizeof( libluksde_serpent_context_t ) );
+
+		memory_free(
+		 *context );
+
+		*context = NULL;
+	}
+	return( 1 );
+}
+
+
+/* Sets the key
+ * Serpent uses the same key schedule to de- and encrypt
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_serpent_context_set_key(
+     libluksde_serpent_context_t *context,
+     const uint8_t *key,
+     size_t key_bit_size,
+     libcerror_error_t **error )
+{
+	uint32_t key_words[ 140 ];
+
+	static char *function = "libluksde_serpent_context_set_key";
+	size_t key_byte_size  = 0;
+	uint32_t value_32bit  = 0;
+	uint32_t word0        = 0;
+	uint32_t word1        = 0;
+	uint32_t word2        = 0;
+	uint32_t word3        = 0;
+	uint32_t word4        = 0;
+	int round_index       = 0;
+	int word_index        = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key.",
+		 function );
+
+		return( -1 );
+	}
+	/* Serpent supports key sizes up to 256 bits, such as the 160-bit keys used by ESSIV with SHA1
+	 */
+	if( ( key_bit_size == 0 )
+	 || ( key_bit_size > 256 )
+	 || ( ( key_bit_size % 32 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported key bit size.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     key_words,
+	     0,
+	     sizeof( uint32_t ) * 140 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear key words.",
+		 function );
+
+		return( -1 );
+	}
+	key_byte_size = key_bit_size / 8;
+
+	for( word_index = 0;
+	     word_index < (int) ( key_byte_size / 4 );
+	     word_index++ )
+	{
+		byte_stream_copy_to_uint32_little_endian(
+		 &( key[ word_index * 4 ] ),
+		 key_words[ word_index ] );
+	}
+	/* Keys shorter than 256 bits are padded with a single 1 bit followed by 0 bits
+	 */
+	if( key_bit_size < 256 )
+	{
+		key_words[ key_byte_size / 4 ] = 0x00000001UL;
+	}
+	/* The 8 key words are expanded into 132 prekey words
+	 */
+	for( word_index = 8;
+	     word_index < 140;
+	     word_index++ )
+	{
+		value_32bit = key_words[ word_index - 8 ]
+		            ^ key_words[ word_index - 5 ]
+		            ^ key_words[ word_index - 3 ]
+		            ^ key_words[ word_index - 1 ]
+		            ^ 0x9e3779b9UL
+		            ^ (uint32_t) ( word_index - 8 );
+
+		key_words[ word_index ] = libluksde_serpent_rotate_left(
+		                           value_32bit,
+		                           11 );
+	}
+	/* Round key N is the result of S-box ( 3 - N ) modulus 8 applied to prekey words 4 x N to 4 x N + 3
+	 */
+	for( round_index = 0;
+	     round_index < 33;
+	     round_index++ )
+	{
+		word0 = key_words[ 8 + ( round_index * 4 ) ];
+		word1 = key_words[ 9 + ( round_index * 4 ) ];
+		word2 = key_words[ 10 + ( round_index * 4 ) ];
+		word3 = key_words[ 11 + ( round_index * 4 ) ];
+
+		switch( ( 35 - round_index ) % 8 )
+		{
+			case 0:
+				libluksde_serpent_substitute0(
+				 word0,
+				 word1,
+				 word2,
+				 word3,
+				 word4 );
+				break;
+
+			case 1:
+				libluksde_serpent_substitute1(
+				 word0,
+				 word1,
+				 word2,
+				 word3,
+				 word4 );
+				break;
+
+			case 2:
+				libluksde_serpent_substitute2(
+				 word0,
+				 word1,
+				 word2,
+				 word3,
+				 word4 );
+				break;
+
+			case 3:
+				libluksde_serpent_substitute3(
+				 word0,
+				 word1,
+				 word2,
+				 word3,
+				 word4 );
+				break;
+
+			case 4:
+				libluksde_serpent_substitute4(
+				 word0,
+				 word1,
+				 word2,
+				 word3,
+				 word4 );
+				break;
+
+			case 5:
+				libluksde_serpent_substitute5(
+				 word0,
+				 word1,
+				 word2,
+				 word3,
+				 word4 );
+				break;
+
+			case 6:
+				libluksde_serpent_substitute6(
+				 word0,
+				 word1,
+				 word2,
+				 word3,
+				 word4 );
+				break;
+
+			case 7:
+				libluksde_serpent_substitute7(
+				 word0,
+				 word1,
+				 word2,
+				 word3,
+				 word4 );
+				break;
+		}
+		context->round_keys[ round_index ][ 0 ] = word0;
+		context->round_keys[ round_index ][ 1 ] = word1;
+		context->round_keys[ round_index ][ 2 ] = word2;
+		context->round_keys[ round_index ][ 3 ] = word3;
+	}
+	memory_set(
+	 key_words,
+	 0,
+	 sizeof( uint32_t ) * 140 );
+
+	return( 1 );
+}
+
+/* Encrypts a 16-byte block
+ */
+static void libluksde_serpent_encrypt_block(
+             const libluksde_serpent_context_t *context,
+             const uint8_t *input_data,
+             uint8_t *output_data )
+{
+	uint32_t word0  = 0;
+	uint32_t word1  = 0;
+	uint32_t word2  = 0;
+	uint32_t word3  = 0;
+	uint32_t word4  = 0;
+	int round_index = 0;
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( input_data[ 0 ] ),
+	 word0 );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( input_data[ 4 ] ),
+	 word1 );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( input_data[ 8 ] ),
+	 word2 );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( input_data[ 12 ] ),
+	 word3 );
+
+	for( round_index = 0;
+	     round_index < 32;
+	     round_index += 8 )
+	{
+		if( round_index > 0 )
+		{
+			libluksde_serpent_linear_transform(
+			 word0,
+			 word1,
+			 word2,
+			 word3,
+			 libluksde_serpent_rotate_left,
+			 libluksde_serpent_shift_left );
+		}
+		libluksde_serpent_xor_round_key(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 context->round_keys[ round_index ] );
+
+		libluksde_serpent_substitute0(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 word4 );
+
+		libluksde_serpent_linear_transform(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 libluksde_serpent_rotate_left,
+		 libluksde_serpent_shift_left );
+
+		libluksde_serpent_xor_round_key(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 context->round_keys[ round_index + 1 ] );
+
+		libluksde_serpent_substitute1(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 word4 );
+
+		libluksde_serpent_linear_transform(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 libluksde_serpent_rotate_left,
+		 libluksde_serpent_shift_left );
+
+		libluksde_serpent_xor_round_key(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 context->round_keys[ round_index + 2 ] );
+
+		libluksde_serpent_substitute2(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 word4 );
+
+		libluksde_serpent_linear_transform(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 libluksde_serpent_rotate_left,
+		 libluksde_serpent_shift_left );
+
+		libluksde_serpent_xor_round_key(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 context->round_keys[ round_index + 3 ] );
+
+		libluksde_serpent_substitute3(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 word4 );
+
+		libluksde_serpent_linear_transform(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 libluksde_serpent_rotate_left,
+		 libluksde_serpent_shift_left );
+
+		libluksde_serpent_xor_round_key(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 context->round_keys[ round_index + 4 ] );
+
+		libluksde_serpent_substitute4(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 word4 );
+
+		libluksde_serpent_linear_transform(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 libluksde_serpent_rotate_left,
+		 libluksde_serpent_shift_left );
+
+		libluksde_serpent_xor_round_key(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 context->round_keys[ round_index + 5 ] );
+
+		libluksde_serpent_substitute5(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 word4 );
+
+		libluksde_serpent_linear_transform(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 libluksde_serpent_rotate_left,
+		 libluksde_serpent_shift_left );
+
+		libluksde_serpent_xor_round_key(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 context->round_keys[ round_index + 6 ] );
+
+		libluksde_serpent_substitute6(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 word4 );
+
+		libluksde_serpent_linear_transform(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 libluksde_serpent_rotate_left,
+		 libluksde_serpent_shift_left );
+
+		libluksde_serpent_xor_round_key(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 context->round_keys[ round_index + 7 ] );
+
+		libluksde_serpent_substitute7(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 word4 );
+	}
+	/* The last round applies a round key instead of the linear transformation
+	 */
+	libluksde_serpent_xor_round_key(
+	 word0,
+	 word1,
+	 word2,
+	 word3,
+	 context->round_keys[ 32 ] );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( output_data[ 0 ] ),
+	 word0 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( output_data[ 4 ] ),
+	 word1 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( output_data[ 8 ] ),
+	 word2 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( output_data[ 12 ] ),
+	 word3 );
+}
+
+/* Decrypts a 16-byte block
+ */
+static void libluksde_serpent_decrypt_block(
+             const libluksde_serpent_context_t *context,
+             const uint8_t *input_data,
+             uint8_t *output_data )
+{
+	uint32_t word0  = 0;
+	uint32_t word1  = 0;
+	uint32_t word2  = 0;
+	uint32_t word3  = 0;
+	uint32_t word4  = 0;
+	int round_index = 0;
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( input_data[ 0 ] ),
+	 word0 );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( input_data[ 4 ] ),
+	 word1 );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( input_data[ 8 ] ),
+	 word2 );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( input_data[ 12 ] ),
+	 word3 );
+
+	libluksde_serpent_xor_round_key(
+	 word0,
+	 word1,
+	 word2,
+	 word3,
+	 context->round_keys[ 32 ] );
+
+	for( round_index = 24;
+	     round_index >= 0;
+	     round_index -= 8 )
+	{
+		if( round_index < 24 )
+		{
+			libluksde_serpent_inverse_linear_transform(
+			 word0,
+			 word1,
+			 word2,
+			 word3,
+			 libluksde_serpent_rotate_right,
+			 libluksde_serpent_shift_left );
+		}
+		libluksde_serpent_inverse_substitute7(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 word4 );
+
+		libluksde_serpent_xor_round_key(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 context->round_keys[ round_index + 7 ] );
+
+		libluksde_serpent_inverse_linear_transform(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 libluksde_serpent_rotate_right,
+		 libluksde_serpent_shift_left );
+
+		libluksde_serpent_inverse_substitute6(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 word4 );
+
+		libluksde_serpent_xor_round_key(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 context->round_keys[ round_index + 6 ] );
+
+		libluksde_serpent_inverse_linear_transform(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 libluksde_serpent_rotate_right,
+		 libluksde_serpent_shift_left );
+
+		libluksde_serpent_inverse_substitute5(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 word4 );
+
+		libluksde_serpent_xor_round_key(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 context->round_keys[ round_index + 5 ] );
+
+		libluksde_serpent_inverse_linear_transform(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 libluksde_serpent_rotate_right,
+		 libluksde_serpent_shift_left );
+
+		libluksde_serpent_inverse_substitute4(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 word4 );
+
+		libluksde_serpent_xor_round_key(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 context->round_keys[ round_index + 4 ] );
+
+		libluksde_serpent_inverse_linear_transform(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 libluksde_serpent_rotate_right,
+		 libluksde_serpent_shift_left );
+
+		libluksde_serpent_inverse_substitute3(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 word4 );
+
+		libluksde_serpent_xor_round_key(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 context->round_keys[ round_index + 3 ] );
+
+		libluksde_serpent_inverse_linear_transform(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 libluksde_serpent_rotate_right,
+		 libluksde_serpent_shift_left );
+
+		libluksde_serpent_inverse_substitute2(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 word4 );
+
+		libluksde_serpent_xor_round_key(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 context->round_keys[ round_index + 2 ] );
+
+		libluksde_serpent_inverse_linear_transform(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 libluksde_serpent_rotate_right,
+		 libluksde_serpent_shift_left );
+
+		libluksde_serpent_inverse_substitute1(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 word4 );
+
+		libluksde_serpent_xor_round_key(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 context->round_keys[ round_index + 1 ] );
+
+		libluksde_serpent_inverse_linear_transform(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 libluksde_serpent_rotate_right,
+		 libluksde_serpent_shift_left );
+
+		libluksde_serpent_inverse_substitute0(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 word4 );
+
+		libluksde_serpent_xor_round_key(
+		 word0,
+		 word1,
+		 word2,
+		 word3,
+		 context->round_keys[ round_index ] );
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 &( output_data[ 0 ] ),
+	 word0 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( output_data[ 4 ] ),
+	 word1 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( output_data[ 8 ] ),
+	 word2 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( output_data[ 12 ] ),
+	 word3 );
+}
+
+/* Multiplies a XTS tweak value by alpha (x) in GF(2^128)
+ * The tweak value is stored as 2 64-bit values in little-endian byte order
+ */
+static inline void libluksde_serpent_xts_multiply_alpha(
+                    uint64_t *tweak_lower,
+                    uint64_t *tweak_upper )
+{
+	uint64_t carry = *tweak_upper >> 63;
+
+	*tweak_upper = ( *tweak_upper << 1 ) | ( *tweak_lower >> 63 );
+	*tweak_lower = ( *tweak_lower << 1 ) ^ ( carry * 0x87 );
+}
+
+
+#if defined( HAVE_LIBLUKSDE_AVX2_SUPPORT )
+
+/* Transposes 8 blocks between 4 vectors of 2 blocks and 4 vectors of the same 32-bit word of every block
+ * The transpose is its own inverse
+ */
+LIBLUKSDE_SERPENT_AVX2_TARGET
+static inline void libluksde_serpent_avx2_transpose(
+                    __m256i *vectors )
+{
+	__m256i vector0 = _mm256_unpacklo_epi32(
+	                   vectors[ 0 ],
+	                   vectors[ 1 ] );
+
+	__m256i vector1 = _mm256_unpackhi_epi32(
+	                   vectors[ 0 ],
+	                   vectors[ 1 ] );
+
+	__m256i vector2 = _mm256_unpacklo_epi32(
+	                   vectors[ 2 ],
+	                   vectors[ 3 ] );
+
+	__m256i vector3 = _mm256_unpackhi_epi32(
+	                   vectors[ 2 ],
+	                   vectors[ 3 ] );
+
+	vectors[ 0 ] = _mm256_unpacklo_epi64(
+	                vector0,
+	                vector2 );
+
+	vectors[ 1 ] = _mm256_unpackhi_epi64(
+	                vector0,
+	                vector2 );
+
+	vectors[ 2 ] = _mm256_unpacklo_epi64(
+	                vector1,
+	                vector3 );
+
+	vectors[ 3 ] = _mm256_unpackhi_epi64(
+	                vector1,
+	                vector3 );
+}
+
+
+/* Encrypts 16 blocks in parallel as 2 interleaved sets of 8 blocks,
+ * where every vector contains the same 32-bit word of 8 blocks
+ */
+LIBLUKSDE_SERPENT_AVX2_TARGET
+static inline void libluksde_serpent_avx2_encrypt_16_blocks(
+                    const libluksde_serpent_context_t *context,
+                    __m256i *words )
+{
+	__m256i word0[ 2 ];
+	__m256i word1[ 2 ];
+	__m256i word2[ 2 ];
+	__m256i word3[ 2 ];
+	__m256i word4[ 2 ];
+
+	int round_index = 0;
+	int set_index   = 0;
+
+	for( set_index = 0;
+	     set_index < 2;
+	     set_index++ )
+	{
+		word0[ set_index ] = words[ ( set_index * 4 ) ];
+		word1[ set_index ] = words[ ( set_index * 4 ) + 1 ];
+		word2[ set_index ] = words[ ( set_index * 4 ) + 2 ];
+		word3[ set_index ] = words[ ( set_index * 4 ) + 3 ];
+		word4[ set_index ] = _mm256_setzero_si256();
+	}
+	for( round_index = 0;
+	     round_index < 32;
+	     round_index += 8 )
+	{
+		if( round_index > 0 )
+		{
+			for( set_index = 0;
+			     set_index < 2;
+			     set_index++ )
+			{
+				libluksde_serpent_linear_transform(
+				 word0[ set_index ],
+				 word1[ set_index ],
+				 word2[ set_index ],
+				 word3[ set_index ],
+				 libluksde_serpent_avx2_rotate_left,
+				 libluksde_serpent_avx2_shift_left );
+			}
+		}
+		for( set_index = 0;
+		     set_index < 2;
+		     set_index++ )
+		{
+			libluksde_serpent_avx2_xor_round_key(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 context->round_keys[ round_index ] );
+
+			libluksde_serpent_substitute0(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 word4[ set_index ] );
+		}
+		for( set_index = 0;
+		     set_index < 2;
+		     set_index++ )
+		{
+			libluksde_serpent_linear_transform(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 libluksde_serpent_avx2_rotate_left,
+			 libluksde_serpent_avx2_shift_left );
+
+			libluksde_serpent_avx2_xor_round_key(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 context->round_keys[ round_index + 1 ] );
+
+			libluksde_serpent_substitute1(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 word4[ set_index ] );
+		}
+		for( set_index = 0;
+		     set_index < 2;
+		     set_index++ )
+		{
+			libluksde_serpent_linear_transform(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 libluksde_serpent_avx2_rotate_left,
+			 libluksde_serpent_avx2_shift_left );
+
+			libluksde_serpent_avx2_xor_round_key(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 context->round_keys[ round_index + 2 ] );
+
+			libluksde_serpent_substitute2(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 word4[ set_index ] );
+		}
+		for( set_index = 0;
+		     set_index < 2;
+		     set_index++ )
+		{
+			libluksde_serpent_linear_transform(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 libluksde_serpent_avx2_rotate_left,
+			 libluksde_serpent_avx2_shift_left );
+
+			libluksde_serpent_avx2_xor_round_key(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 context->round_keys[ round_index + 3 ] );
+
+			libluksde_serpent_substitute3(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 word4[ set_index ] );
+		}
+		for( set_index = 0;
+		     set_index < 2;
+		     set_index++ )
+		{
+			libluksde_serpent_linear_transform(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 libluksde_serpent_avx2_rotate_left,
+			 libluksde_serpent_avx2_shift_left );
+
+			libluksde_serpent_avx2_xor_round_key(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 context->round_keys[ round_index + 4 ] );
+
+			libluksde_serpent_substitute4(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 word4[ set_index ] );
+		}
+		for( set_index = 0;
+		     set_index < 2;
+		     set_index++ )
+		{
+			libluksde_serpent_linear_transform(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 libluksde_serpent_avx2_rotate_left,
+			 libluksde_serpent_avx2_shift_left );
+
+			libluksde_serpent_avx2_xor_round_key(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 context->round_keys[ round_index + 5 ] );
+
+			libluksde_serpent_substitute5(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 word4[ set_index ] );
+		}
+		for( set_index = 0;
+		     set_index < 2;
+		     set_index++ )
+		{
+			libluksde_serpent_linear_transform(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 libluksde_serpent_avx2_rotate_left,
+			 libluksde_serpent_avx2_shift_left );
+
+			libluksde_serpent_avx2_xor_round_key(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 context->round_keys[ round_index + 6 ] );
+
+			libluksde_serpent_substitute6(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 word4[ set_index ] );
+		}
+		for( set_index = 0;
+		     set_index < 2;
+		     set_index++ )
+		{
+			libluksde_serpent_linear_transform(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 libluksde_serpent_avx2_rotate_left,
+			 libluksde_serpent_avx2_shift_left );
+
+			libluksde_serpent_avx2_xor_round_key(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 context->round_keys[ round_index + 7 ] );
+
+			libluksde_serpent_substitute7(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 word4[ set_index ] );
+		}
+	}
+	for( set_index = 0;
+	     set_index < 2;
+	     set_index++ )
+	{
+		libluksde_serpent_avx2_xor_round_key(
+		 word0[ set_index ],
+		 word1[ set_index ],
+		 word2[ set_index ],
+		 word3[ set_index ],
+		 context->round_keys[ 32 ] );
+
+		words[ ( set_index * 4 ) ]     = word0[ set_index ];
+		words[ ( set_index * 4 ) + 1 ] = word1[ set_index ];
+		words[ ( set_index * 4 ) + 2 ] = word2[ set_index ];
+		words[ ( set_index * 4 ) + 3 ] = word3[ set_index ];
+	}
+}
+
+/* Decrypts 16 blocks in parallel as 2 interleaved sets of 8 blocks,
+ * where every vector contains the same 32-bit word of 8 blocks
+ */
+LIBLUKSDE_SERPENT_AVX2_TARGET
+static inline void libluksde_serpent_avx2_decrypt_16_blocks(
+                    const libluksde_serpent_context_t *context,
+                    __m256i *words )
+{
+	__m256i word0[ 2 ];
+	__m256i word1[ 2 ];
+	__m256i word2[ 2 ];
+	__m256i word3[ 2 ];
+	__m256i word4[ 2 ];
+
+	int round_index = 0;
+	int set_index   = 0;
+
+	for( set_index = 0;
+	     set_index < 2;
+	     set_index++ )
+	{
+		word0[ set_index ] = words[ ( set_index * 4 ) ];
+		word1[ set_index ] = words[ ( set_index * 4 ) + 1 ];
+		word2[ set_index ] = words[ ( set_index * 4 ) + 2 ];
+		word3[ set_index ] = words[ ( set_index * 4 ) + 3 ];
+		word4[ set_index ] = _mm256_setzero_si256();
+
+		libluksde_serpent_avx2_xor_round_key(
+		 word0[ set_index ],
+		 word1[ set_index ],
+		 word2[ set_index ],
+		 word3[ set_index ],
+		 context->round_keys[ 32 ] );
+	}
+	for( round_index = 24;
+	     round_index >= 0;
+	     round_index -= 8 )
+	{
+		if( round_index < 24 )
+		{
+			for( set_index = 0;
+			     set_index < 2;
+			     set_index++ )
+			{
+				libluksde_serpent_inverse_linear_transform(
+				 word0[ set_index ],
+				 word1[ set_index ],
+				 word2[ set_index ],
+				 word3[ set_index ],
+				 libluksde_serpent_avx2_rotate_right,
+				 libluksde_serpent_avx2_shift_left );
+			}
+		}
+		for( set_index = 0;
+		     set_index < 2;
+		     set_index++ )
+		{
+			libluksde_serpent_inverse_substitute7(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 word4[ set_index ] );
+
+			libluksde_serpent_avx2_xor_round_key(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 context->round_keys[ round_index + 7 ] );
+		}
+		for( set_index = 0;
+		     set_index < 2;
+		     set_index++ )
+		{
+			libluksde_serpent_inverse_linear_transform(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 libluksde_serpent_avx2_rotate_right,
+			 libluksde_serpent_avx2_shift_left );
+
+			libluksde_serpent_inverse_substitute6(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 word4[ set_index ] );
+
+			libluksde_serpent_avx2_xor_round_key(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 context->round_keys[ round_index + 6 ] );
+		}
+		for( set_index = 0;
+		     set_index < 2;
+		     set_index++ )
+		{
+			libluksde_serpent_inverse_linear_transform(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 libluksde_serpent_avx2_rotate_right,
+			 libluksde_serpent_avx2_shift_left );
+
+			libluksde_serpent_inverse_substitute5(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 word4[ set_index ] );
+
+			libluksde_serpent_avx2_xor_round_key(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 context->round_keys[ round_index + 5 ] );
+		}
+		for( set_index = 0;
+		     set_index < 2;
+		     set_index++ )
+		{
+			libluksde_serpent_inverse_linear_transform(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 libluksde_serpent_avx2_rotate_right,
+			 libluksde_serpent_avx2_shift_left );
+
+			libluksde_serpent_inverse_substitute4(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 word4[ set_index ] );
+
+			libluksde_serpent_avx2_xor_round_key(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 context->round_keys[ round_index + 4 ] );
+		}
+		for( set_index = 0;
+		     set_index < 2;
+		     set_index++ )
+		{
+			libluksde_serpent_inverse_linear_transform(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 libluksde_serpent_avx2_rotate_right,
+			 libluksde_serpent_avx2_shift_left );
+
+			libluksde_serpent_inverse_substitute3(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 word4[ set_index ] );
+
+			libluksde_serpent_avx2_xor_round_key(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 context->round_keys[ round_index + 3 ] );
+		}
+		for( set_index = 0;
+		     set_index < 2;
+		     set_index++ )
+		{
+			libluksde_serpent_inverse_linear_transform(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 libluksde_serpent_avx2_rotate_right,
+			 libluksde_serpent_avx2_shift_left );
+
+			libluksde_serpent_inverse_substitute2(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 word4[ set_index ] );
+
+			libluksde_serpent_avx2_xor_round_key(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 context->round_keys[ round_index + 2 ] );
+		}
+		for( set_index = 0;
+		     set_index < 2;
+		     set_index++ )
+		{
+			libluksde_serpent_inverse_linear_transform(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 libluksde_serpent_avx2_rotate_right,
+			 libluksde_serpent_avx2_shift_left );
+
+			libluksde_serpent_inverse_substitute1(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 word4[ set_index ] );
+
+			libluksde_serpent_avx2_xor_round_key(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 context->round_keys[ round_index + 1 ] );
+		}
+		for( set_index = 0;
+		     set_index < 2;
+		     set_index++ )
+		{
+			libluksde_serpent_inverse_linear_transform(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 libluksde_serpent_avx2_rotate_right,
+			 libluksde_serpent_avx2_shift_left );
+
+			libluksde_serpent_inverse_substitute0(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 word4[ set_index ] );
+
+			libluksde_serpent_avx2_xor_round_key(
+			 word0[ set_index ],
+			 word1[ set_index ],
+			 word2[ set_index ],
+			 word3[ set_index ],
+			 context->round_keys[ round_index ] );
+		}
+	}
+	for( set_index = 0;
+	     set_index < 2;
+	     set_index++ )
+	{
+		words[ ( set_index * 4 ) ]     = word0[ set_index ];
+		words[ ( set_index * 4 ) + 1 ] = word1[ set_index ];
+		words[ ( set_index * 4 ) + 2 ] = word2[ set_index ];
+		words[ ( set_index * 4 ) + 3 ] = word3[ set_index ];
+	}
+}
+
+/* De- or encrypts 16 blocks in parallel
+ * The blocks are transposed into vectors of 32-bit words and back
+ */
+LIBLUKSDE_SERPENT_AVX2_TARGET
+static inline void libluksde_serpent_avx2_crypt_16_blocks(
+                    const libluksde_serpent_context_t *context,
+                    int mode,
+                    __m256i *blocks )
+{
+	libluksde_serpent_avx2_transpose(
+	 &( blocks[ 0 ] ) );
+
+	libluksde_serpent_avx2_transpose(
+	 &( blocks[ 4 ] ) );
+
+	if( mode == LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT )
+	{
+		libluksde_serpent_avx2_encrypt_16_blocks(
+		 context,
+		 blocks );
+	}
+	else
+	{
+		libluksde_serpent_avx2_decrypt_16_blocks(
+		 context,
+		 blocks );
+	}
+	libluksde_serpent_avx2_transpose(
+	 &( blocks[ 0 ] ) );
+
+	libluksde_serpent_avx2_transpose(
+	 &( blocks[ 4 ] ) );
+}
+
+/* De- or encrypts blocks of data 16 blocks at a time using AVX2 in ECB mode
+ * Returns the number of bytes processed
+ */
+LIBLUKSDE_SERPENT_AVX2_TARGET
+static size_t libluksde_serpent_avx2_crypt_ecb(
+               const libluksde_serpent_context_t *context,
+               int mode,
+               const uint8_t *input_data,
+               uint8_t *output_data,
+               size_t data_size )
+{
+	__m256i blocks[ 8 ];
+
+	size_t data_offset = 0;
+	int vector_index   = 0;
+
+	while( ( data_offset + 256 ) <= data_size )
+	{
+		for( vector_index = 0;
+		     vector_index < 8;
+		     vector_index++ )
+		{
+			blocks[ vector_index ] = _mm256_loadu_si256(
+			                          (__m256i *) &( input_data[ data_offset + ( vector_index * 32 ) ] ) );
+		}
+		libluksde_serpent_avx2_crypt_16_blocks(
+		 context,
+		 mode,
+		 blocks );
+
+		for( vector_index = 0;
+		     vector_index < 8;
+		     vector_index++ )
+		{
+			_mm256_storeu_si256(
+			 (__m256i *) &( output_data[ data_offset + ( vector_index * 32 ) ] ),
+			 blocks[ vector_index ] );
+		}
+		data_offset += 256;
+	}
+	return( data_offset );
+}
+
+/* Decrypts blocks of data 16 blocks at a time using AVX2 in CBC mode
+ * The previous block is updated to the last cipher text block that was processed
+ * Returns the number of bytes processed
+ */
+LIBLUKSDE_SERPENT_AVX2_TARGET
+static size_t libluksde_serpent_avx2_decrypt_cbc(
+               const libluksde_serpent_context_t *context,
+               uint8_t *previous_block,
+               const uint8_t *input_data,
+               uint8_t *output_data,
+               size_t data_size )
+{
+	__m256i blocks[ 8 ];
+	__m256i previous_blocks[ 8 ];
+
+	__m128i previous    = _mm_loadu_si128(
+	                       (__m128i *) previous_block );
+	size_t data_offset  = 0;
+	int vector_index    = 0;
+
+	while( ( data_offset + 256 ) <= data_size )
+	{
+		/* Every cipher text block is combined with the cipher text block preceding it
+		 * so all of them are loaded before the output, which can overlap the input, is stored
+		 */
+		previous_blocks[ 0 ] = _mm256_inserti128_si256(
+		                        _mm256_castsi128_si256(
+		                         previous ),
+		                        _mm_loadu_si128(
+		                         (__m128i *) &( input_data[ data_offset ] ) ),
+		                        1 );
+
+		for( vector_index = 0;
+		     vector_index < 8;
+		     vector_index++ )
+		{
+			blocks[ vector_index ] = _mm256_loadu_si256(
+			                          (__m256i *) &( input_data[ data_offset + ( vector_index * 32 ) ] ) );
+
+			if( vector_index > 0 )
+			{
+				previous_blocks[ vector_index ] = _mm256_loadu_si256(
+				                                   (__m256i *) &( input_data[ data_offset + ( vector_index * 32 ) - 16 ] ) );
+			}
+		}
+		previous = _mm_loadu_si128(
+		            (__m128i *) &( input_data[ data_offset + 240 ] ) );
+
+		libluksde_serpent_avx2_crypt_16_blocks(
+		 context,
+		 LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+		 blocks );
+
+		for( vector_index = 0;
+		     vector_index < 8;
+		     vector_index++ )
+		{
+			_mm256_storeu_si256(
+			 (__m256i *) &( output_data[ data_offset + ( vector_index * 32 ) ] ),
+			 _mm256_xor_si256(
+			  blocks[ vector_index ],
+			  previous_blocks[ vector_index ] ) );
+		}
+		data_offset += 256;
+	}
+	_mm_storeu_si128(
+	 (__m128i *) previous_block,
+	 previous );
+
+	return( data_offset );
+}
+
+/* De- or encrypts blocks of data 16 blocks at a time using AVX2 in XTS mode
+ * The tweak value is updated to the tweak value of the first block that was not processed
+ * Returns the number of bytes processed
+ */
+LIBLUKSDE_SERPENT_AVX2_TARGET
+static size_t libluksde_serpent_avx2_crypt_xts(
+               const libluksde_serpent_context_t *context,
+               int mode,
+               uint64_t *tweak_lower,
+               uint64_t *tweak_upper,
+               const uint8_t *input_data,
+               uint8_t *output_data,
+               size_t data_size )
+{
+	uint64_t tweak_values[ 32 ];
+	__m256i blocks[ 8 ];
+	__m256i tweaks[ 8 ];
+
+	size_t data_offset = 0;
+	int block_index    = 0;
+	int vector_index   = 0;
+
+	while( ( data_offset + 256 ) <= data_size )
+	{
+		for( block_index = 0;
+		     block_index < 16;
+		     block_index++ )
+		{
+			tweak_values[ block_index * 2 ]       = *tweak_lower;
+			tweak_values[ ( block_index * 2 ) + 1 ] = *tweak_upper;
+
+			libluksde_serpent_xts_multiply_alpha(
+			 tweak_lower,
+			 tweak_upper );
+		}
+		for( vector_index = 0;
+		     vector_index < 8;
+		     vector_index++ )
+		{
+			tweaks[ vector_index ] = _mm256_loadu_si256(
+			                          (__m256i *) &( tweak_values[ vector_index * 4 ] ) );
+
+			blocks[ vector_index ] = _mm256_xor_si256(
+			                          _mm256_loadu_si256(
+			                           (__m256i *) &( input_data[ data_offset + ( vector_index * 32 ) ] ) ),
+			                          tweaks[ vector_index ] );
+		}
+		libluksde_serpent_avx2_crypt_16_blocks(
+		 context,
+		 mode,
+		 blocks );
+
+		for( vector_index = 0;
+		     vector_index < 8;
+		     vector_index++ )
+		{
+			_mm256_storeu_si256(
+			 (__m256i *) &( output_data[ data_offset + ( vector_index * 32 ) ] ),
+			 _mm256_xor_si256(
+			  blocks[ vector_index ],
+			  tweaks[ vector_index ] ) );
+		}
+		data_offset += 256;
+	}
+	memory_set(
+	 tweak_values,
+	 0,
+	 sizeof( uint64_t ) * 32 );
+
+	return( data_offset );
+}
+
+#endif /* defined( HAVE_LIBLUKSDE_AVX2_SUPPORT ) */
+
+/* De- or encrypts one or more sectors of data in CBC mode
+ * Every sector has its own 16-byte initialization vector
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_serpent_crypt_cbc(
+     libluksde_serpent_context_t *context,
+     int mode,
+     uint8_t use_avx2,
+     const uint8_t *initialization_vectors,
+     size_t initialization_vectors_size,
+     size_t sector_size,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error )
+{
+	uint8_t block_data[ 16 ];
+	uint8_t cipher_text_block[ 16 ];
+	uint8_t previous_block[ 16 ];
+
+	static char *function    = "libluksde_serpent_crypt_cbc";
+	size_t data_offset       = 0;
+	size_t number_of_sectors = 0;
+	size_t sector_end_offset = 0;
+	size_t sector_index      = 0;
+	uint8_t byte_index       = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( mode != LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT )
+	 && ( mode != LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( initialization_vectors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid initialization vectors.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( sector_size == 0 )
+	 || ( sector_size > (size_t) SSIZE_MAX )
+	 || ( ( sector_size % 16 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid sector size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( input_data_size > (size_t) SSIZE_MAX )
+	 || ( ( input_data_size % sector_size ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid input data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_sectors = input_data_size / sector_size;
+
+	if( initialization_vectors_size < ( number_of_sectors * 16 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: initialization vectors size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output data.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data_size < input_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: output data size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	for( sector_index = 0;
+	     sector_index < number_of_sectors;
+	     sector_index++ )
+	{
+		if( memory_copy(
+		     previous_block,
+		     &( initialization_vectors[ sector_index * 16 ] ),
+		     16 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy initialization vector.",
+			 function );
+
+			return( -1 );
+		}
+		sector_end_offset = data_offset + sector_size;
+
+		if( mode == LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT )
+		{
+			/* CBC encryption depends on the previous cipher text block
+			 * and cannot be parallelized
+			 */
+			while( data_offset < sector_end_offset )
+			{
+				for( byte_index = 0;
+				     byte_index < 16;
+				     byte_index++ )
+				{
+					block_data[ byte_index ] = input_data[ data_offset + byte_index ] ^ previous_block[ byte_index ];
+				}
+				libluksde_serpent_encrypt_block(
+				 context,
+				 block_data,
+				 previous_block );
+
+				memory_copy(
+				 &( output_data[ data_offset ] ),
+				 previous_block,
+				 16 );
+
+				data_offset += 16;
+			}
+		}
+		else
+		{
+#if defined( HAVE_LIBLUKSDE_AVX2_SUPPORT )
+			if( use_avx2 != 0 )
+			{
+				data_offset += libluksde_serpent_avx2_decrypt_cbc(
+				                context,
+				                previous_block,
+				                &( input_data[ data_offset ] ),
+				                &( output_data[ data_offset ] ),
+				                sector_size );
+			}
+#endif
+			while( data_offset < sector_end_offset )
+			{
+				/* The cipher text block is copied since the output can overlap the input
+				 */
+				memory_copy(
+				 cipher_text_block,
+				 &( input_data[ data_offset ] ),
+				 16 );
+
+				libluksde_serpent_decrypt_block(
+				 context,
+				 cipher_text_block,
+				 &( output_data[ data_offset ] ) );
+
+				for( byte_index = 0;
+				     byte_index < 16;
+				     byte_index++ )
+				{
+					output_data[ data_offset + byte_index ] ^= previous_block[ byte_index ];
+				}
+				memory_copy(
+				 previous_block,
+				 cipher_text_block,
+				 16 );
+
+				data_offset += 16;
+			}
+		}
+	}
+	memory_set(
+	 block_data,
+	 0,
+	 16 );
+
+	return( 1 );
+}
+
+/* De- or encrypts data in ECB mode
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_serpent_crypt_ecb(
+     libluksde_serpent_context_t *context,
+     int mode,
+     uint8_t use_avx2,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_serpent_crypt_ecb";
+	size_t data_offset    = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( mode != LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT )
+	 && ( mode != LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( input_data_size > (size_t) SSIZE_MAX )
+	 || ( ( input_data_size % 16 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid input data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output data.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data_size < input_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: output data size value too small.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBLUKSDE_AVX2_SUPPORT )
+	if( use_avx2 != 0 )
+	{
+		data_offset = libluksde_serpent_avx2_crypt_ecb(
+		               context,
+		               mode,
+		               input_data,
+		               output_data,
+		               input_data_size );
+	}
+#endif
+	while( data_offset < input_data_size )
+	{
+		if( mode == LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT )
+		{
+			libluksde_serpent_encrypt_block(
+			 context,
+			 &( input_data[ data_offset ] ),
+			 &( output_data[ data_offset ] ) );
+		}
+		else
+		{
+			libluksde_serpent_decrypt_block(
+			 context,
+			 &( input_data[ data_offset ] ),
+			 &( output_data[ data_offset ] ) );
+		}
+		data_offset += 16;
+	}
+	return( 1 );
+}
+
+/* De- or encrypts one or more sectors of data in XTS mode
+ * Every sector has its own 16-byte tweak value, which is encrypted with the tweak context
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_serpent_crypt_xts(
+     libluksde_serpent_context_t *context,
+     libluksde_serpent_context_t *tweak_context,
+     int mode,
+     uint8_t use_avx2,
+     const uint8_t *tweak_values,
+     size_t tweak_values_size,
+     size_t sector_size,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error )
+{
+	uint8_t block_data[ 16 ];
+	uint8_t encrypted_tweak_value[ 16 ];
+
+	static char *function    = "libluksde_serpent_crypt_xts";
+	size_t data_offset       = 0;
+	size_t number_of_sectors = 0;
+	size_t sector_end_offset = 0;
+	size_t sector_index      = 0;
+	uint64_t tweak_lower     = 0;
+	uint64_t tweak_upper     = 0;
+	uint8_t byte_index       = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( tweak_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tweak context.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( mode != LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT )
+	 && ( mode != LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( tweak_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tweak values.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( sector_size == 0 )
+	 || ( sector_size > (size_t) SSIZE_MAX )
+	 || ( ( sector_size % 16 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid sector size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( input_data_size > (size_t) SSIZE_MAX )
+	 || ( ( input_data_size % sector_size ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid input data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_sectors = input_data_size / sector_size;
+
+	if( tweak_values_size < ( number_of_sectors * 16 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: tweak values size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output data.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data_size < input_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: output data size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	for( sector_index = 0;
+	     sector_index < number_of_sectors;
+	     sector_index++ )
+	{
+		libluksde_serpent_encrypt_block(
+		 tweak_context,
+		 &( tweak_values[ sector_index * 16 ] ),
+		 encrypted_tweak_value );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 &( encrypted_tweak_value[ 0 ] ),
+		 tweak_lower );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 &( encrypted_tweak_value[ 8 ] ),
+		 tweak_upper );
+
+		sector_end_offset = data_offset + sector_size;
+
+#if defined( HAVE_LIBLUKSDE_AVX2_SUPPORT )
+		if( use_avx2 != 0 )
+		{
+			data_offset += libluksde_serpent_avx2_crypt_xts(
+			                context,
+			                mode,
+			                &tweak_lower,
+			                &tweak_upper,
+			                &( input_data[ data_offset ] ),
+			                &( output_data[ data_offset ] ),
+			                sector_size );
+		}
+#endif
+		while( data_offset < sector_end_offset )
+		{
+			byte_stream_copy_from_uint64_little_endian(
+			 &( encrypted_tweak_value[ 0 ] ),
+			 tweak_lower );
+
+			byte_stream_copy_from_uint64_little_endian(
+			 &( encrypted_tweak_value[ 8 ] ),
+			 tweak_upper );
+
+			for( byte_index = 0;
+			     byte_index < 16;
+			     byte_index++ )
+			{
+				block_data[ byte_index ] = input_data[ data_offset + byte_index ] ^ encrypted_tweak_value[ byte_index ];
+			}
+			if( mode == LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT )
+			{
+				libluksde_serpent_encrypt_block(
+				 context,
+				 block_data,
+				 &( output_data[ data_offset ] ) );
+			}
+			else
+			{
+				libluksde_serpent_decrypt_block(
+				 context,
+				 block_data,
+				 &( output_data[ data_offset ] ) );
+			}
+			for( byte_index = 0;
+			     byte_index < 16;
+			     byte_index++ )
+			{
+				output_data[ data_offset + byte_index ] ^= encrypted_tweak_value[ byte_index ];
+			}
+			libluksde_serpent_xts_multiply_alpha(
+			 &tweak_lower,
+			 &tweak_upper );
+
+			data_offset += 16;
+		}
+	}
+	memory_set(
+	 encrypted_tweak_value,
+	 0,
+	 16 );
+
+	memory_set(
+	 block_data,
+	 0,
+	 16 );
+
+	return( 1 );
+}
+
@@ -0,0 +1,138 @@
+/*
+ * SHA-1 functions
+ *
+ * Copyright (C) 2013-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <types.h>
+
+#include "libluksde_sha1.h"
+
+/* The SHA-1 initial hash values
+ */
+static const uint32_t libluksde_sha1_initial_hash_values[ 5 ] = {
+	0x67452301UL, 0xefcdab89UL, 0x98badcfeUL, 0x10325476UL, 0xc3d2e1f0UL };
+
+#define libluksde_sha1_rotate_left( value, number_of_bits ) \
+	( ( ( value ) << ( number_of_bits ) ) | ( ( value ) >> ( 32 - ( number_of_bits ) ) ) )
+
+/* Sets the initial hash values
+ */
+void libluksde_sha1_initialize_hash_values(
+      uint32_t *hash_values )
+{
+	int value_index = 0;
+
+	for( value_index = 0;
+	     value_index < 5;
+	     value_index++ )
+	{
+		hash_values[ value_index ] = libluksde_sha1_initial_hash_values[ value_index ];
+	}
+}
+
+/* Applies the SHA-1 compression function to a number of 64-byte blocks
+ * The hash values are updated in place, the blocks are not padded
+ */
+void libluksde_sha1_transform(
+      uint32_t *hash_values,
+      const uint8_t *blocks,
+      size_t number_of_blocks )
+{
+	uint32_t schedule[ 80 ];
+
+	size_t block_offset  = 0;
+	size_t block_index   = 0;
+	uint32_t value_32bit = 0;
+	uint32_t value_a     = 0;
+	uint32_t value_b     = 0;
+	uint32_t value_c     = 0;
+	uint32_t value_d     = 0;
+	uint32_t value_e     = 0;
+	uint32_t value_f     = 0;
+	int round_index      = 0;
+
+	for( block_index = 0;
+	     block_index < number_of_blocks;
+	     block_index++ )
+	{
+		for( round_index = 0;
+		     round_index < 16;
+		     round_index++ )
+		{
+			byte_stream_copy_to_uint32_big_endian(
+			 &( blocks[ block_offset + ( round_index * 4 ) ] ),
+			 schedule[ round_index ] );
+		}
+		for( round_index = 16;
+		     round_index < 80;
+		     round_index++ )
+		{
+			value_32bit = schedule[ round_index - 3 ]
+			            ^ schedule[ round_index - 8 ]
+			            ^ schedule[ round_index - 14 ]
+			            ^ schedule[ round_index - 16 ];
+
+			schedule[ round_index ] = libluksde_sha1_rotate_left( value_32bit, 1 );
+		}
+		value_a = hash_values[ 0 ];
+		value_b = hash_values[ 1 ];
+		value_c = hash_values[ 2 ];
+		value_d = hash_values[ 3 ];
+		value_e = hash_values[ 4 ];
+
+		for( round_index = 0;
+		     round_index < 80;
+		     round_index++ )
+		{
+			if( round_index < 20 )
+			{
+				value_f = ( ( value_b & value_c ) | ( ~value_b & value_d ) ) + 0x5a827999UL;
+			}
+			else if( round_index < 40 )
+			{
+				value_f = ( value_b ^ value_c ^ value_d ) + 0x6ed9eba1UL;
+			}
+			else if( round_index < 60 )
+			{
+				value_f = ( ( value_b & value_c ) | ( value_b & value_d ) | ( value_c & value_d ) ) + 0x8f1bbcdcUL;
+			}
+			else
+			{
+				value_f = ( value_b ^ value_c ^ value_d ) + 0xca62c1d6UL;
+			}
+			value_32bit = libluksde_sha1_rotate_left( value_a, 5 ) + value_f + value_e + schedule[ round_index ];
+
+			value_e = value_d;
+			value_d = value_c;
+			value_c = libluksde_sha1_rotate_left( value_b, 30 );
+			value_b = value_a;
+			value_a = value_32bit;
+		}
+		hash_values[ 0 ] += value_a;
+		hash_values[ 1 ] += value_b;
+		hash_values[ 2 ] += value_c;
+		hash_values[ 3 ] += value_d;
+		hash_values[ 4 ] += value_e;
+
+		block_offset += LIBLUKSDE_SHA1_BLOCK_SIZE;
+	}
+}
+
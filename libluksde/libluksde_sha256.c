@@ -0,0 +1,177 @@
+/*
+ * SHA-224 and SHA-256 functions
+ *
+ * Copyright (C) 2013-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <types.h>
+
+#include "libluksde_sha256.h"
+
+/* The SHA-224 initial hash values
+ */
+static const uint32_t libluksde_sha224_initial_hash_values[ 8 ] = {
+	0xc1059ed8UL, 0x367cd507UL, 0x3070dd17UL, 0xf70e5939UL, 0xffc00b31UL, 0x68581511UL, 0x64f98fa7UL, 0xbefa4fa4UL };
+
+/* The SHA-256 initial hash values
+ */
+static const uint32_t libluksde_sha256_initial_hash_values[ 8 ] = {
+	0x6a09e667UL, 0xbb67ae85UL, 0x3c6ef372UL, 0xa54ff53aUL, 0x510e527fUL, 0x9b05688cUL, 0x1f83d9abUL, 0x5be0cd19UL };
+
+/* The SHA-256 round constants
+ */
+static const uint32_t libluksde_sha256_round_constants[ 64 ] = {
+	0x428a2f98UL, 0x71374491UL, 0xb5c0fbcfUL, 0xe9b5dba5UL, 0x3956c25bUL, 0x59f111f1UL, 0x923f82a4UL, 0xab1c5ed5UL,
+	0xd807aa98UL, 0x12835b01UL, 0x243185beUL, 0x550c7dc3UL, 0x72be5d74UL, 0x80deb1feUL, 0x9bdc06a7UL, 0xc19bf174UL,
+	0xe49b69c1UL, 0xefbe4786UL, 0x0fc19dc6UL, 0x240ca1ccUL, 0x2de92c6fUL, 0x4a7484aaUL, 0x5cb0a9dcUL, 0x76f988daUL,
+	0x983e5152UL, 0xa831c66dUL, 0xb00327c8UL, 0xbf597fc7UL, 0xc6e00bf3UL, 0xd5a79147UL, 0x06ca6351UL, 0x14292967UL,
+	0x27b70a85UL, 0x2e1b2138UL, 0x4d2c6dfcUL, 0x53380d13UL, 0x650a7354UL, 0x766a0abbUL, 0x81c2c92eUL, 0x92722c85UL,
+	0xa2bfe8a1UL, 0xa81a664bUL, 0xc24b8b70UL, 0xc76c51a3UL, 0xd192e819UL, 0xd6990624UL, 0xf40e3585UL, 0x106aa070UL,
+	0x19a4c116UL, 0x1e376c08UL, 0x2748774cUL, 0x34b0bcb5UL, 0x391c0cb3UL, 0x4ed8aa4aUL, 0x5b9cca4fUL, 0x682e6ff3UL,
+	0x748f82eeUL, 0x78a5636fUL, 0x84c87814UL, 0x8cc70208UL, 0x90befffaUL, 0xa4506cebUL, 0xbef9a3f7UL, 0xc67178f2UL };
+
+#define libluksde_sha256_rotate_right( value, number_of_bits ) \
+	( ( ( value ) >> ( number_of_bits ) ) | ( ( value ) << ( 32 - ( number_of_bits ) ) ) )
+
+/* Sets the SHA-224 initial hash values
+ */
+void libluksde_sha224_initialize_hash_values(
+      uint32_t *hash_values )
+{
+	int value_index = 0;
+
+	for( value_index = 0;
+	     value_index < 8;
+	     value_index++ )
+	{
+		hash_values[ value_index ] = libluksde_sha224_initial_hash_values[ value_index ];
+	}
+}
+
+/* Sets the SHA-256 initial hash values
+ */
+void libluksde_sha256_initialize_hash_values(
+      uint32_t *hash_values )
+{
+	int value_index = 0;
+
+	for( value_index = 0;
+	     value_index < 8;
+	     value_index++ )
+	{
+		hash_values[ value_index ] = libluksde_sha256_initial_hash_values[ value_index ];
+	}
+}
+
+/* Applies the SHA-256 compression function to a number of 64-byte blocks
+ * SHA-224 uses the same compression function with different initial hash values
+ * The hash values are updated in place, the blocks are not padded
+ */
+void libluksde_sha256_transform(
+      uint32_t *hash_values,
+      const uint8_t *blocks,
+      size_t number_of_blocks )
+{
+	uint32_t schedule[ 64 ];
+	uint32_t values[ 8 ];
+
+	size_t block_offset = 0;
+	size_t block_index  = 0;
+	uint32_t sigma0     = 0;
+	uint32_t sigma1     = 0;
+	uint32_t value_t1   = 0;
+	uint32_t value_t2   = 0;
+	int round_index     = 0;
+	int value_index     = 0;
+
+	for( block_index = 0;
+	     block_index < number_of_blocks;
+	     block_index++ )
+	{
+		for( round_index = 0;
+		     round_index < 16;
+		     round_index++ )
+		{
+			byte_stream_copy_to_uint32_big_endian(
+			 &( blocks[ block_offset + ( round_index * 4 ) ] ),
+			 schedule[ round_index ] );
+		}
+		for( round_index = 16;
+		     round_index < 64;
+		     round_index++ )
+		{
+			sigma0 = libluksde_sha256_rotate_right( schedule[ round_index - 15 ], 7 )
+			       ^ libluksde_sha256_rotate_right( schedule[ round_index - 15 ], 18 )
+			       ^ ( schedule[ round_index - 15 ] >> 3 );
+
+			sigma1 = libluksde_sha256_rotate_right( schedule[ round_index - 2 ], 17 )
+			       ^ libluksde_sha256_rotate_right( schedule[ round_index - 2 ], 19 )
+			       ^ ( schedule[ round_index - 2 ] >> 10 );
+
+			schedule[ round_index ] = schedule[ round_index - 16 ] + sigma0 + schedule[ round_index - 7 ] + sigma1;
+		}
+		for( value_index = 0;
+		     value_index < 8;
+		     value_index++ )
+		{
+			values[ value_index ] = hash_values[ value_index ];
+		}
+		/* values[ 0 ] to values[ 7 ] contain the working variables a to h
+		 */
+		for( round_index = 0;
+		     round_index < 64;
+		     round_index++ )
+		{
+			sigma1 = libluksde_sha256_rotate_right( values[ 4 ], 6 )
+			       ^ libluksde_sha256_rotate_right( values[ 4 ], 11 )
+			       ^ libluksde_sha256_rotate_right( values[ 4 ], 25 );
+
+			value_t1 = values[ 7 ]
+			         + sigma1
+			         + ( ( values[ 4 ] & values[ 5 ] ) ^ ( ~values[ 4 ] & values[ 6 ] ) )
+			         + libluksde_sha256_round_constants[ round_index ]
+			         + schedule[ round_index ];
+
+			sigma0 = libluksde_sha256_rotate_right( values[ 0 ], 2 )
+			       ^ libluksde_sha256_rotate_right( values[ 0 ], 13 )
+			       ^ libluksde_sha256_rotate_right( values[ 0 ], 22 );
+
+			value_t2 = sigma0
+			         + ( ( values[ 0 ] & values[ 1 ] ) ^ ( values[ 0 ] & values[ 2 ] ) ^ ( values[ 1 ] & values[ 2 ] ) );
+
+			values[ 7 ] = values[ 6 ];
+			values[ 6 ] = values[ 5 ];
+			values[ 5 ] = values[ 4 ];
+			values[ 4 ] = values[ 3 ] + value_t1;
+			values[ 3 ] = values[ 2 ];
+			values[ 2 ] = values[ 1 ];
+			values[ 1 ] = values[ 0 ];
+			values[ 0 ] = value_t1 + value_t2;
+		}
+		for( value_index = 0;
+		     value_index < 8;
+		     value_index++ )
+		{
+			hash_values[ value_index ] += values[ value_index ];
+		}
+		block_offset += LIBLUKSDE_SHA256_BLOCK_SIZE;
+	}
+}
+
@@ -0,0 +1,53 @@
+/*
+ * SHA-224 and SHA-256 functions
+ *
+ * Copyright (C) 2013-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBLUKSDE_SHA256_H )
+#define _LIBLUKSDE_SHA256_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#define LIBLUKSDE_SHA256_BLOCK_SIZE		64
+#define LIBLUKSDE_SHA224_HASH_SIZE		28
+#define LIBLUKSDE_SHA256_HASH_SIZE		32
+#define LIBLUKSDE_SHA256_NUMBER_OF_HASH_VALUES	8
+
+void libluksde_sha224_initialize_hash_values(
+      uint32_t *hash_values );
+
+void libluksde_sha256_initialize_hash_values(
+      uint32_t *hash_values );
+
+void libluksde_sha256_transform(
+      uint32_t *hash_values,
+      const uint8_t *blocks,
+      size_t number_of_blocks );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBLUKSDE_SHA256_H ) */
+
@@ -0,0 +1,185 @@
+/*
+ * SHA-512 functions
+ *
+ * Copyright (C) 2013-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <types.h>
+
+#include "libluksde_sha512.h"
+
+/* The SHA-512 initial hash values
+ */
+static const uint64_t libluksde_sha512_initial_hash_values[ 8 ] = {
+	0x6a09e667f3bcc908UL, 0xbb67ae8584caa73bUL, 0x3c6ef372fe94f82bUL, 0xa54ff53a5f1d36f1UL,
+	0x510e527fade682d1UL, 0x9b05688c2b3e6c1fUL, 0x1f83d9abfb41bd6bUL, 0x5be0cd19137e2179UL };
+
+/* The SHA-512 round constants
+ */
+static const uint64_t libluksde_sha512_round_constants[ 80 ] = {
+	0x428a2f98d728ae22UL, 0x7137449123ef65cdUL, 0xb5c0fbcfec4d3b2fUL, 0xe9b5dba58189dbbcUL,
+	0x3956c25bf348b538UL, 0x59f111f1b605d019UL, 0x923f82a4af194f9bUL, 0xab1c5ed5da6d8118UL,
+	0xd807aa98a3030242UL, 0x12835b0145706fbeUL, 0x243185be4ee4b28cUL, 0x550c7dc3d5ffb4e2UL,
+	0x72be5d74f27b896fUL, 0x80deb1fe3b1696b1UL, 0x9bdc06a725c71235UL, 0xc19bf174cf692694UL,
+	0xe49b69c19ef14ad2UL, 0xefbe4786384f25e3UL, 0x0fc19dc68b8cd5b5UL, 0x240ca1cc77ac9c65UL,
+	0x2de92c6f592b0275UL, 0x4a7484aa6ea6e483UL, 0x5cb0a9dcbd41fbd4UL, 0x76f988da831153b5UL,
+	0x983e5152ee66dfabUL, 0xa831c66d2db43210UL, 0xb00327c898fb213fUL, 0xbf597fc7beef0ee4UL,
+	0xc6e00bf33da88fc2UL, 0xd5a79147930aa725UL, 0x06ca6351e003826fUL, 0x142929670a0e6e70UL,
+	0x27b70a8546d22ffcUL, 0x2e1b21385c26c926UL, 0x4d2c6dfc5ac42aedUL, 0x53380d139d95b3dfUL,
+	0x650a73548baf63deUL, 0x766a0abb3c77b2a8UL, 0x81c2c92e47edaee6UL, 0x92722c851482353bUL,
+	0xa2bfe8a14cf10364UL, 0xa81a664bbc423001UL, 0xc24b8b70d0f89791UL, 0xc76c51a30654be30UL,
+	0xd192e819d6ef5218UL, 0xd69906245565a910UL, 0xf40e35855771202aUL, 0x106aa07032bbd1b8UL,
+	0x19a4c116b8d2d0c8UL, 0x1e376c085141ab53UL, 0x2748774cdf8eeb99UL, 0x34b0bcb5e19b48a8UL,
+	0x391c0cb3c5c95a63UL, 0x4ed8aa4ae3418acbUL, 0x5b9cca4f7763e373UL, 0x682e6ff3d6b2b8a3UL,
+	0x748f82ee5defb2fcUL, 0x78a5636f43172f60UL, 0x84c87814a1f0ab72UL, 0x8cc702081a6439ecUL,
+	0x90befffa23631e28UL, 0xa4506cebde82bde9UL, 0xbef9a3f7b2c67915UL, 0xc67178f2e372532bUL,
+	0xca273eceea26619cUL, 0xd186b8c721c0c207UL, 0xeada7dd6cde0eb1eUL, 0xf57d4f7fee6ed178UL,
+	0x06f067aa72176fbaUL, 0x0a637dc5a2c898a6UL, 0x113f9804bef90daeUL, 0x1b710b35131c471bUL,
+	0x28db77f523047d84UL, 0x32caab7b40c72493UL, 0x3c9ebe0a15c9bebcUL, 0x431d67c49c100d4cUL,
+	0x4cc5d4becb3e42b6UL, 0x597f299cfc657e2aUL, 0x5fcb6fab3ad6faecUL, 0x6c44198c4a475817UL };
+
+#define libluksde_sha512_rotate_right( value, number_of_bits ) \
+	( ( ( value ) >> ( number_of_bits ) ) | ( ( value ) << ( 64 - ( number_of_bits ) ) ) )
+
+/* Sets the SHA-512 initial hash values
+ */
+void libluksde_sha512_initialize_hash_values(
+      uint32_t *hash_values )
+{
+	int value_index = 0;
+
+	for( value_index = 0;
+	     value_index < 8;
+	     value_index++ )
+	{
+		hash_values[ value_index * 2 ]         = (uint32_t) ( libluksde_sha512_initial_hash_values[ value_index ] >> 32 );
+		hash_values[ ( value_index * 2 ) + 1 ] = (uint32_t) libluksde_sha512_initial_hash_values[ value_index ];
+	}
+}
+
+/* Applies the SHA-512 compression function to a number of 128-byte blocks
+ * The hash values are updated in place, the blocks are not padded
+ */
+void libluksde_sha512_transform(
+      uint32_t *hash_values,
+      const uint8_t *blocks,
+      size_t number_of_blocks )
+{
+	uint64_t schedule[ 80 ];
+	uint64_t state[ 8 ];
+	uint64_t values[ 8 ];
+
+	size_t block_offset = 0;
+	size_t block_index  = 0;
+	uint64_t sigma0     = 0;
+	uint64_t sigma1     = 0;
+	uint64_t value_t1   = 0;
+	uint64_t value_t2   = 0;
+	int round_index     = 0;
+	int value_index     = 0;
+
+	for( value_index = 0;
+	     value_index < 8;
+	     value_index++ )
+	{
+		state[ value_index ] = ( (uint64_t) hash_values[ value_index * 2 ] << 32 )
+		                     | hash_values[ ( value_index * 2 ) + 1 ];
+	}
+	for( block_index = 0;
+	     block_index < number_of_blocks;
+	     block_index++ )
+	{
+		for( round_index = 0;
+		     round_index < 16;
+		     round_index++ )
+		{
+			byte_stream_copy_to_uint64_big_endian(
+			 &( blocks[ block_offset + ( round_index * 8 ) ] ),
+			 schedule[ round_index ] );
+		}
+		for( round_index = 16;
+		     round_index < 80;
+		     round_index++ )
+		{
+			sigma0 = libluksde_sha512_rotate_right( schedule[ round_index - 15 ], 1 )
+			       ^ libluksde_sha512_rotate_right( schedule[ round_index - 15 ], 8 )
+			       ^ ( schedule[ round_index - 15 ] >> 7 );
+
+			sigma1 = libluksde_sha512_rotate_right( schedule[ round_index - 2 ], 19 )
+			       ^ libluksde_sha512_rotate_right( schedule[ round_index - 2 ], 61 )
+			       ^ ( schedule[ round_index - 2 ] >> 6 );
+
+			schedule[ round_index ] = schedule[ round_index - 16 ] + sigma0 + schedule[ round_index - 7 ] + sigma1;
+		}
+		for( value_index = 0;
+		     value_index < 8;
+		     value_index++ )
+		{
+			values[ value_index ] = state[ value_index ];
+		}
+		/* values[ 0 ] to values[ 7 ] contain the working variables a to h
+		 */
+		for( round_index = 0;
+		     round_index < 80;
+		     round_index++ )
+		{
+			sigma1 = libluksde_sha512_rotate_right( values[ 4 ], 14 )
+			       ^ libluksde_sha512_rotate_right( values[ 4 ], 18 )
+			       ^ libluksde_sha512_rotate_right( values[ 4 ], 41 );
+
+			value_t1 = values[ 7 ]
+			         + sigma1
+			         + ( ( values[ 4 ] & values[ 5 ] ) ^ ( ~values[ 4 ] & values[ 6 ] ) )
+			         + libluksde_sha512_round_constants[ round_index ]
+			         + schedule[ round_index ];
+
+			sigma0 = libluksde_sha512_rotate_right( values[ 0 ], 28 )
+			       ^ libluksde_sha512_rotate_right( values[ 0 ], 34 )
+			       ^ libluksde_sha512_rotate_right( values[ 0 ], 39 );
+
+			value_t2 = sigma0
+			         + ( ( values[ 0 ] & values[ 1 ] ) ^ ( values[ 0 ] & values[ 2 ] ) ^ ( values[ 1 ] & values[ 2 ] ) );
+
+			values[ 7 ] = values[ 6 ];
+			values[ 6 ] = values[ 5 ];
+			values[ 5 ] = values[ 4 ];
+			values[ 4 ] = values[ 3 ] + value_t1;
+			values[ 3 ] = values[ 2 ];
+			values[ 2 ] = values[ 1 ];
+			values[ 1 ] = values[ 0 ];
+			values[ 0 ] = value_t1 + value_t2;
+		}
+		for( value_index = 0;
+		     value_index < 8;
+		     value_index++ )
+		{
+			state[ value_index ] += values[ value_index ];
+		}
+		block_offset += LIBLUKSDE_SHA512_BLOCK_SIZE;
+	}
+	for( value_index = 0;
+	     value_index < 8;
+	     value_index++ )
+	{
+		hash_values[ value_index * 2 ]         = (uint32_t) ( state[ value_index ] >> 32 );
+		hash_values[ ( value_index * 2 ) + 1 ] = (uint32_t) state[ value_index ];
+	}
+}
+
@@ -0,0 +1,400 @@
+/*
+ * SHA extensions (SHA-NI) functions
+ *
+ * Copyright (C) 2013-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <types.h>
+
+#include "libluksde_shani.h"
+
+#if defined( HAVE_LIBLUKSDE_SHANI_SUPPORT )
+
+#include <cpuid.h>
+#include <immintrin.h>
+
+#define LIBLUKSDE_SHANI_TARGET \
+	__attribute__(( target( "sha,sse4.1,ssse3" ) ))
+
+/* The SHA-256 round constants
+ */
+static const uint32_t libluksde_shani_sha256_round_constants[ 64 ] = {
+	0x428a2f98UL, 0x71374491UL, 0xb5c0fbcfUL, 0xe9b5dba5UL, 0x3956c25bUL, 0x59f111f1UL, 0x923f82a4UL, 0xab1c5ed5UL,
+	0xd807aa98UL, 0x12835b01UL, 0x243185beUL, 0x550c7dc3UL, 0x72be5d74UL, 0x80deb1feUL, 0x9bdc06a7UL, 0xc19bf174UL,
+	0xe49b69c1UL, 0xefbe4786UL, 0x0fc19dc6UL, 0x240ca1ccUL, 0x2de92c6fUL, 0x4a7484aaUL, 0x5cb0a9dcUL, 0x76f988daUL,
+	0x983e5152UL, 0xa831c66dUL, 0xb00327c8UL, 0xbf597fc7UL, 0xc6e00bf3UL, 0xd5a79147UL, 0x06ca6351UL, 0x14292967UL,
+	0x27b70a85UL, 0x2e1b2138UL, 0x4d2c6dfcUL, 0x53380d13UL, 0x650a7354UL, 0x766a0abbUL, 0x81c2c92eUL, 0x92722c85UL,
+	0xa2bfe8a1UL, 0xa81a664bUL, 0xc24b8b70UL, 0xc76c51a3UL, 0xd192e819UL, 0xd6990624UL, 0xf40e3585UL, 0x106aa070UL,
+	0x19a4c116UL, 0x1e376c08UL, 0x2748774cUL, 0x34b0bcb5UL, 0x391c0cb3UL, 0x4ed8aa4aUL, 0x5b9cca4fUL, 0x682e6ff3UL,
+	0x748f82eeUL, 0x78a5636fUL, 0x84c87814UL, 0x8cc70208UL, 0x90befffaUL, 0xa4506cebUL, 0xbef9a3f7UL, 0xc67178f2UL };
+
+/* Calculates the next 4 words of the SHA-1 message schedule
+ * W[t] = ( W[t-3] ^ W[t-8] ^ W[t-14] ^ W[t-16] ) <<< 1
+ */
+#define libluksde_shani_sha1_schedule( message0, message1, message2, message3 ) \
+	message0 = _mm_sha1msg2_epu32( \
+	            _mm_xor_si128( \
+	             _mm_sha1msg1_epu32( message0, message1 ), \
+	             message2 ), \
+	            message3 );
+
+/* Applies 4 SHA-1 rounds, where value_e contains the value A from before the previous 4 rounds
+ */
+#define libluksde_shani_sha1_rounds( message, function ) \
+	value_e1 = _mm_sha1nexte_epu32( value_e0, message ); \
+	value_e0 = value_abcd; \
+	value_abcd = _mm_sha1rnds4_epu32( value_abcd, value_e1, function );
+
+/* Calculates the next 4 words of the SHA-256 message schedule
+ * W[t] = sigma1( W[t-2] ) + W[t-7] + sigma0( W[t-15] ) + W[t-16]
+ */
+#define libluksde_shani_sha256_schedule( message0, message1, message2, message3 ) \
+	message0 = _mm_sha256msg2_epu32( \
+	            _mm_add_epi32( \
+	             _mm_sha256msg1_epu32( message0, message1 ), \
+	             _mm_alignr_epi8( message3, message2, 4 ) ), \
+	            message3 );
+
+/* Applies 4 SHA-256 rounds
+ */
+#define libluksde_shani_sha256_rounds( message, round_index ) \
+	round_values = _mm_add_epi32( \
+	                message, \
+	                _mm_loadu_si128( (__m128i *) &( libluksde_shani_sha256_round_constants[ round_index ] ) ) ); \
+	state1 = _mm_sha256rnds2_epu32( state1, state0, round_values ); \
+	round_values = _mm_shuffle_epi32( round_values, 0x0e ); \
+	state0 = _mm_sha256rnds2_epu32( state0, state1, round_values );
+
+#endif /* defined( HAVE_LIBLUKSDE_SHANI_SUPPORT ) */
+
+/* Determines if the CPU supports the SHA extensions
+ * Returns 1 if supported or 0 if not
+ */
+int libluksde_shani_is_supported(
+     void )
+{
+#if defined( HAVE_LIBLUKSDE_SHANI_SUPPORT )
+	unsigned int cpuid_eax = 0;
+	unsigned int cpuid_ebx = 0;
+	unsigned int cpuid_ecx = 0;
+	unsigned int cpuid_edx = 0;
+
+	if( __get_cpuid(
+	     1,
+	     &cpuid_eax,
+	     &cpuid_ebx,
+	     &cpuid_ecx,
+	     &cpuid_edx ) == 0 )
+	{
+		return( 0 );
+	}
+	/* CPUID.01H:ECX.SSSE3[bit 9]
+	 * CPUID.01H:ECX.SSE4_1[bit 19]
+	 */
+	if( ( ( cpuid_ecx & 0x00000200UL ) == 0 )
+	 || ( ( cpuid_ecx & 0x00080000UL ) == 0 )
+	 || ( __get_cpuid_max(
+	       0,
+	       NULL ) < 7 ) )
+	{
+		return( 0 );
+	}
+	__cpuid_count(
+	 7,
+	 0,
+	 cpuid_eax,
+	 cpuid_ebx,
+	 cpuid_ecx,
+	 cpuid_edx );
+
+	/* CPUID.(EAX=07H,ECX=0):EBX.SHA[bit 29]
+	 */
+	if( ( cpuid_ebx & 0x20000000UL ) == 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+#else
+	return( 0 );
+#endif /* defined( HAVE_LIBLUKSDE_SHANI_SUPPORT ) */
+}
+
+#if defined( HAVE_LIBLUKSDE_SHANI_SUPPORT )
+
+/* Applies the SHA-1 compression function to a number of 64-byte blocks
+ * The hash values are updated in place, the blocks are not padded
+ */
+LIBLUKSDE_SHANI_TARGET
+void libluksde_shani_sha1_transform(
+      uint32_t *hash_values,
+      const uint8_t *blocks,
+      size_t number_of_blocks )
+{
+	__m128i byte_order_mask;
+	__m128i message0;
+	__m128i message1;
+	__m128i message2;
+	__m128i message3;
+	__m128i saved_value_abcd;
+	__m128i saved_value_e;
+	__m128i value_abcd;
+	__m128i value_e0;
+	__m128i value_e1;
+
+	/* Reverses the bytes of a 128-bit value, which also places the first word in the upper lane
+	 */
+	byte_order_mask = _mm_set_epi64x(
+	                   0x0001020304050607ULL,
+	                   0x08090a0b0c0d0e0fULL );
+
+	/* The SHA-1 instructions expect A in the upper lane and E in the upper lane of a separate register
+	 */
+	value_abcd = _mm_loadu_si128(
+	              (__m128i *) hash_values );
+	value_abcd = _mm_shuffle_epi32(
+	              value_abcd,
+	              0x1b );
+	value_e0 = _mm_set_epi32(
+	            (int) hash_values[ 4 ],
+	            0,
+	            0,
+	            0 );
+
+	while( number_of_blocks > 0 )
+	{
+		saved_value_abcd = value_abcd;
+		saved_value_e    = value_e0;
+
+		message0 = _mm_shuffle_epi8(
+		            _mm_loadu_si128( (__m128i *) &( blocks[ 0 ] ) ),
+		            byte_order_mask );
+		message1 = _mm_shuffle_epi8(
+		            _mm_loadu_si128( (__m128i *) &( blocks[ 16 ] ) ),
+		            byte_order_mask );
+		message2 = _mm_shuffle_epi8(
+		            _mm_loadu_si128( (__m128i *) &( blocks[ 32 ] ) ),
+		            byte_order_mask );
+		message3 = _mm_shuffle_epi8(
+		            _mm_loadu_si128( (__m128i *) &( blocks[ 48 ] ) ),
+		            byte_order_mask );
+
+		/* Rounds 0 to 3 add E directly, since there are no preceding rounds
+		 */
+		value_e1   = _mm_add_epi32( value_e0, message0 );
+		value_e0   = value_abcd;
+		value_abcd = _mm_sha1rnds4_epu32( value_abcd, value_e1, 0 );
+
+		libluksde_shani_sha1_rounds( message1, 0 )
+		libluksde_shani_sha1_rounds( message2, 0 )
+		libluksde_shani_sha1_rounds( message3, 0 )
+
+		libluksde_shani_sha1_schedule( message0, message1, message2, message3 )
+		libluksde_shani_sha1_rounds( message0, 0 )
+
+		/* Rounds 20 to 39
+		 */
+		libluksde_shani_sha1_schedule( message1, message2, message3, message0 )
+		libluksde_shani_sha1_rounds( message1, 1 )
+		libluksde_shani_sha1_schedule( message2, message3, message0, message1 )
+		libluksde_shani_sha1_rounds( message2, 1 )
+		libluksde_shani_sha1_schedule( message3, message0, message1, message2 )
+		libluksde_shani_sha1_rounds( message3, 1 )
+		libluksde_shani_sha1_schedule( message0, message1, message2, message3 )
+		libluksde_shani_sha1_rounds( message0, 1 )
+		libluksde_shani_sha1_schedule( message1, message2, message3, message0 )
+		libluksde_shani_sha1_rounds( message1, 1 )
+
+		/* Rounds 40 to 59
+		 */
+		libluksde_shani_sha1_schedule( message2, message3, message0, message1 )
+		libluksde_shani_sha1_rounds( message2, 2 )
+		libluksde_shani_sha1_schedule( message3, message0, message1, message2 )
+		libluksde_shani_sha1_rounds( message3, 2 )
+		libluksde_shani_sha1_schedule( message0, message1, message2, message3 )
+		libluksde_shani_sha1_rounds( message0, 2 )
+		libluksde_shani_sha1_schedule( message1, message2, message3, message0 )
+		libluksde_shani_sha1_rounds( message1, 2 )
+		libluksde_shani_sha1_schedule( message2, message3, message0, message1 )
+		libluksde_shani_sha1_rounds( message2, 2 )
+
+		/* Rounds 60 to 79
+		 */
+		libluksde_shani_sha1_schedule( message3, message0, message1, message2 )
+		libluksde_shani_sha1_rounds( message3, 3 )
+		libluksde_shani_sha1_schedule( message0, message1, message2, message3 )
+		libluksde_shani_sha1_rounds( message0, 3 )
+		libluksde_shani_sha1_schedule( message1, message2, message3, message0 )
+		libluksde_shani_sha1_rounds( message1, 3 )
+		libluksde_shani_sha1_schedule( message2, message3, message0, message1 )
+		libluksde_shani_sha1_rounds( message2, 3 )
+		libluksde_shani_sha1_schedule( message3, message0, message1, message2 )
+		libluksde_shani_sha1_rounds( message3, 3 )
+
+		/* Determines E from A of before the last 4 rounds
+		 */
+		value_e0   = _mm_sha1nexte_epu32( value_e0, saved_value_e );
+		value_abcd = _mm_add_epi32( value_abcd, saved_value_abcd );
+
+		blocks           += 64;
+		number_of_blocks -= 1;
+	}
+	value_abcd = _mm_shuffle_epi32(
+	              value_abcd,
+	              0x1b );
+
+	_mm_storeu_si128(
+	 (__m128i *) hash_values,
+	 value_abcd );
+
+	hash_values[ 4 ] = (uint32_t) _mm_extract_epi32(
+	                               value_e0,
+	                               3 );
+}
+
+/* Applies the SHA-256 compression function to a number of 64-byte blocks
+ * The hash values are updated in place, the blocks are not padded
+ */
+LIBLUKSDE_SHANI_TARGET
+void libluksde_shani_sha256_transform(
+      uint32_t *hash_values,
+      const uint8_t *blocks,
+      size_t number_of_blocks )
+{
+	__m128i byte_order_mask;
+	__m128i message0;
+	__m128i message1;
+	__m128i message2;
+	__m128i message3;
+	__m128i round_values;
+	__m128i saved_state0;
+	__m128i saved_state1;
+	__m128i state0;
+	__m128i state1;
+
+	/* Reverses the bytes of every 32-bit word
+	 */
+	byte_order_mask = _mm_set_epi64x(
+	                   0x0c0d0e0f08090a0bULL,
+	                   0x0405060700010203ULL );
+
+	/* The SHA-256 instructions expect the state as ABEF and CDGH
+	 */
+	round_values = _mm_loadu_si128(
+	                (__m128i *) &( hash_values[ 0 ] ) );
+	state1       = _mm_loadu_si128(
+	                (__m128i *) &( hash_values[ 4 ] ) );
+
+	round_values = _mm_shuffle_epi32(
+	                round_values,
+	                0xb1 );
+	state1       = _mm_shuffle_epi32(
+	                state1,
+	                0x1b );
+	state0       = _mm_alignr_epi8(
+	                round_values,
+	                state1,
+	                8 );
+	state1       = _mm_blend_epi16(
+	                state1,
+	                round_values,
+	                0xf0 );
+
+	while( number_of_blocks > 0 )
+	{
+		saved_state0 = state0;
+		saved_state1 = state1;
+
+		message0 = _mm_shuffle_epi8(
+		            _mm_loadu_si128( (__m128i *) &( blocks[ 0 ] ) ),
+		            byte_order_mask );
+		message1 = _mm_shuffle_epi8(
+		            _mm_loadu_si128( (__m128i *) &( blocks[ 16 ] ) ),
+		            byte_order_mask );
+		message2 = _mm_shuffle_epi8(
+		            _mm_loadu_si128( (__m128i *) &( blocks[ 32 ] ) ),
+		            byte_order_mask );
+		message3 = _mm_shuffle_epi8(
+		            _mm_loadu_si128( (__m128i *) &( blocks[ 48 ] ) ),
+		            byte_order_mask );
+
+		libluksde_shani_sha256_rounds( message0, 0 )
+		libluksde_shani_sha256_rounds( message1, 4 )
+		libluksde_shani_sha256_rounds( message2, 8 )
+		libluksde_shani_sha256_rounds( message3, 12 )
+
+		libluksde_shani_sha256_schedule( message0, message1, message2, message3 )
+		libluksde_shani_sha256_rounds( message0, 16 )
+		libluksde_shani_sha256_schedule( message1, message2, message3, message0 )
+		libluksde_shani_sha256_rounds( message1, 20 )
+		libluksde_shani_sha256_schedule( message2, message3, message0, message1 )
+		libluksde_shani_sha256_rounds( message2, 24 )
+		libluksde_shani_sha256_schedule( message3, message0, message1, message2 )
+		libluksde_shani_sha256_rounds( message3, 28 )
+
+		libluksde_shani_sha256_schedule( message0, message1, message2, message3 )
+		libluksde_shani_sha256_rounds( message0, 32 )
+		libluksde_shani_sha256_schedule( message1, message2, message3, message0 )
+		libluksde_shani_sha256_rounds( message1, 36 )
+		libluksde_shani_sha256_schedule( message2, message3, message0, message1 )
+		libluksde_shani_sha256_rounds( message2, 40 )
+		libluksde_shani_sha256_schedule( message3, message0, message1, message2 )
+		libluksde_shani_sha256_rounds( message3, 44 )
+
+		libluksde_shani_sha256_schedule( message0, message1, message2, message3 )
+		libluksde_shani_sha256_rounds( message0, 48 )
+		libluksde_shani_sha256_schedule( message1, message2, message3, message0 )
+		libluksde_shani_sha256_rounds( message1, 52 )
+		libluksde_shani_sha256_schedule( message2, message3, message0, message1 )
+		libluksde_shani_sha256_rounds( message2, 56 )
+		libluksde_shani_sha256_schedule( message3, message0, message1, message2 )
+		libluksde_shani_sha256_rounds( message3, 60 )
+
+		state0 = _mm_add_epi32( state0, saved_state0 );
+		state1 = _mm_add_epi32( state1, saved_state1 );
+
+		blocks           += 64;
+		number_of_blocks -= 1;
+	}
+	/* Converts the ABEF and CDGH state back to ABCD and EFGH
+	 */
+	round_values = _mm_shuffle_epi32(
+	                state0,
+	                0x1b );
+	state1       = _mm_shuffle_epi32(
+	                state1,
+	                0xb1 );
+	state0       = _mm_blend_epi16(
+	                round_values,
+	                state1,
+	                0xf0 );
+	state1       = _mm_alignr_epi8(
+	                state1,
+	                round_values,
+	                8 );
+
+	_mm_storeu_si128(
+	 (__m128i *) &( hash_values[ 0 ] ),
+	 state0 );
+	_mm_storeu_si128(
+	 (__m128i *) &( hash_values[ 4 ] ),
+	 state1 );
+}
+
+#endif /* defined( HAVE_LIBLUKSDE_SHANI_SUPPORT ) */
+
@@ -0,0 +1,61 @@
+/*
+ * SHA extensions (SHA-NI) functions
+ *
+ * Copyright (C) 2013-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBLUKSDE_SHANI_H )
+#define _LIBLUKSDE_SHANI_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The SHA-NI functions require a compiler that supports function specific
+ * target attributes, like the AES-NI functions
+ */
+#if ( ( defined( __GNUC__ ) && ( __GNUC__ >= 5 ) ) || defined( __clang__ ) ) && defined( __x86_64__ )
+#define HAVE_LIBLUKSDE_SHANI_SUPPORT
+#endif
+
+int libluksde_shani_is_supported(
+     void );
+
+#if defined( HAVE_LIBLUKSDE_SHANI_SUPPORT )
+
+void libluksde_shani_sha1_transform(
+      uint32_t *hash_values,
+      const uint8_t *blocks,
+      size_t number_of_blocks );
+
+void libluksde_shani_sha256_transform(
+      uint32_t *hash_values,
+      const uint8_t *blocks,
+      size_t number_of_blocks );
+
+#endif /* defined( HAVE_LIBLUKSDE_SHANI_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBLUKSDE_SHANI_H ) */
+
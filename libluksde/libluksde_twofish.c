@@ -0,0 +1,2137 @@
+/*
+ * Twofish functions
+ *
+ * Copyright (C) 2013-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libluksde_aesni.h"
+#include "libluksde_encryption.h"
+#include "libluksde_libcerror.h"
+#include "libluksde_twofish.h"
+
+#if defined( HAVE_LIBLUKSDE_AVX2_SUPPORT )
+
+#include <immintrin.h>
+
+#define LIBLUKSDE_TWOFISH_AVX2_TARGET \
+	__attribute__(( target( "avx2" ) ))
+
+#endif /* defined( HAVE_LIBLUKSDE_AVX2_SUPPORT ) */
+
+#define libluksde_twofish_rotate_left( value, number_of_bits ) \
+	( ( ( value ) << ( number_of_bits ) ) | ( ( value ) >> ( 32 - ( number_of_bits ) ) ) )
+
+#define libluksde_twofish_rotate_right( value, number_of_bits ) \
+	( ( ( value ) >> ( number_of_bits ) ) | ( ( value ) << ( 32 - ( number_of_bits ) ) ) )
+
+/* The q0 permutation
+ */
+static const uint8_t libluksde_twofish_q0[ 256 ] = {
+	0xa9, 0x67, 0xb3, 0xe8, 0x04, 0xfd, 0xa3, 0x76, 0x9a, 0x92, 0x80, 0x78, 0xe4, 0xdd, 0xd1, 0x38,
+	0x0d, 0xc6, 0x35, 0x98, 0x18, 0xf7, 0xec, 0x6c, 0x43, 0x75, 0x37, 0x26, 0xfa, 0x13, 0x94, 0x48,
+	0xf2, 0xd0, 0x8b, 0x30, 0x84, 0x54, 0xdf, 0x23, 0x19, 0x5b, 0x3d, 0x59, 0xf3, 0xae, 0xa2, 0x82,
+	0x63, 0x01, 0x83, 0x2e, 0xd9, 0x51, 0x9b, 0x7c, 0xa6, 0xeb, 0xa5, 0xbe, 0x16, 0x0c, 0xe3, 0x61,
+	0xc0, 0x8c, 0x3a, 0xf5, 0x73, 0x2c, 0x25, 0x0b, 0xbb, 0x4e, 0x89, 0x6b, 0x53, 0x6a, 0xb4, 0xf1,
+	0xe1, 0xe6, 0xbd, 0x45, 0xe2, 0xf4, 0xb6, 0x66, 0xcc, 0x95, 0x03, 0x56, 0xd4, 0x1c, 0x1e, 0xd7,
+	0xfb, 0xc3, 0x8e, 0xb5, 0xe9, 0xcf, 0xbf, 0xba, 0xea, 0x77, 0x39, 0xaf, 0x33, 0xc9, 0x62, 0x71,
+	0x81, 0x79, 0x09, 0xad, 0x24, 0xcd, 0xf9, 0xd8, 0xe5, 0xc5, 0xb9, 0x4d, 0x44, 0x08, 0x86, 0xe7,
+	0xa1, 0x1d, 0xaa, 0xed, 0x06, 0x70, 0xb2, 0xd2, 0x41, 0x7b, 0xa0, 0x11, 0x31, 0xc2, 0x27, 0x90,
+	0x20, 0xf6, 0x60, 0xff, 0x96, 0x5c, 0xb1, 0xab, 0x9e, 0x9c, 0x52, 0x1b, 0x5f, 0x93, 0x0a, 0xef,
+	0x91, 0x85, 0x49, 0xee, 0x2d, 0x4f, 0x8f, 0x3b, 0x47, 0x87, 0x6d, 0x46, 0xd6, 0x3e, 0x69, 0x64,
+	0x2a, 0xce, 0xcb, 0x2f, 0xfc, 0x97, 0x05, 0x7a, 0xac, 0x7f, 0xd5, 0x1a, 0x4b, 0x0e, 0xa7, 0x5a,
+	0x28, 0x14, 0x3f, 0x29, 0x88, 0x3c, 0x4c, 0x02, 0xb8, 0xda, 0xb0, 0x17, 0x55, 0x1f, 0x8a, 0x7d,
+	0x57, 0xc7, 0x8d, 0x74, 0xb7, 0xc4, 0x9f, 0x72, 0x7e, 0x15, 0x22, 0x12, 0x58, 0x07, 0x99, 0x34,
+	0x6e, 0x50, 0xde, 0x68, 0x65, 0xbc, 0xdb, 0xf8, 0xc8, 0xa8, 0x2b, 0x40, 0xdc, 0xfe, 0x32, 0xa4,
+	0xca, 0x10, 0x21, 0xf0, 0xd3, 0x5d, 0x0f, 0x00, 0x6f, 0x9d, 0x36, 0x42, 0x4a, 0x5e, 0xc1, 0xe0 };
+
+/* The q1 permutation
+ */
+static const uint8_t libluksde_twofish_q1[ 256 ] = {
+	0x75, 0xf3, 0xc6, 0xf4, 0xdb, 0x7b, 0xfb, 0xc8, 0x4a, 0xd3, 0xe6, 0x6b, 0x45, 0x7d, 0xe8, 0x4b,
+	0xd6, 0x32, 0xd8, 0xfd, 0x37, 0x71, 0xf1, 0xe1, 0x30, 0x0f, 0xf8, 0x1b, 0x87, 0xfa, 0x06, 0x3f,
+	0x5e, 0xba, 0xae, 0x5b, 0x8a, 0x00, 0xbc, 0x9d, 0x6d, 0xc1, 0xb1, 0x0e, 0x80, 0x5d, 0xd2, 0xd5,
+	0xa0, 0x84, 0x07, 0x14, 0xb5, 0x90, 0x2c, 0xa3, 0xb2, 0x73, 0x4c, 0x54, 0x92, 0x74, 0x36, 0x51,
+	0x38, 0xb0, 0xbd, 0x5a, 0xfc, 0x60, 0x62, 0x96, 0x6c, 0x42, 0xf7, 0x10, 0x7c, 0x28, 0x27, 0x8c,
+	0x13, 0x95, 0x9c, 0xc7, 0x24, 0x46, 0x3b, 0x70, 0xca, 0xe3, 0x85, 0xcb, 0x11, 0xd0, 0x93, 0xb8,
+	0xa6, 0x83, 0x20, 0xff, 0x9f, 0x77, 0xc3, 0xcc, 0x03, 0x6f, 0x08, 0xbf, 0x40, 0xe7, 0x2b, 0xe2,
+	0x79, 0x0c, 0xaa, 0x82, 0x41, 0x3a, 0xea, 0xb9, 0xe4, 0x9a, 0xa4, 0x97, 0x7e, 0xda, 0x7a, 0x17,
+	0x66, 0x94, 0xa1, 0x1d, 0x3d, 0xf0, 0xde, 0xb3, 0x0b, 0x72, 0xa7, 0x1c, 0xef, 0xd1, 0x53, 0x3e,
+	0x8f, 0x33, 0x26, 0x5f, 0xec, 0x76, 0x2a, 0x49, 0x81, 0x88, 0xee, 0x21, 0xc4, 0x1a, 0xeb, 0xd9,
+	0xc5, 0x39, 0x99, 0xcd, 0xad, 0x31, 0x8b, 0x01, 0x18, 0x23, 0xdd, 0x1f, 0x4e, 0x2d, 0xf9, 0x48,
+	0x4f, 0xf2, 0x65, 0x8e, 0x78, 0x5c, 0x58, 0x19, 0x8d, 0xe5, 0x98, 0x57, 0x67, 0x7f, 0x05, 0x64,
+	0xaf, 0x63, 0xb6, 0xfe, 0xf5, 0xb7, 0x3c, 0xa5, 0xce, 0xe9, 0x68, 0x44, 0xe0, 0x4d, 0x43, 0x69,
+	0x29, 0x2e, 0xac, 0x15, 0x59, 0xa8, 0x0a, 0x9e, 0x6e, 0x47, 0xdf, 0x34, 0x35, 0x6a, 0xcf, 0xdc,
+	0x22, 0xc9, 0xc0, 0x9b, 0x89, 0xd4, 0xed, 0xab, 0x12, 0xa2, 0x0d, 0x52, 0xbb, 0x02, 0x2f, 0xa9,
+	0xd7, 0x61, 0x1e, 0xb4, 0x50, 0x04, 0xf6, 0xc2, 0x16, 0x25, 0x86, 0x56, 0x55, 0x09, 0xbe, 0x91 };
+
+/* The columns of the MDS matrix multiplied by every byte value
+ */
+static const uint32_t libluksde_twofish_mds[ 4 ][ 256 ] = {
+	{ 0x00000000UL, 0xefef5b01UL, 0xb7b7b602UL, 0x5858ed03UL, 0x07070504UL, 0xe8e85e05UL,
+	  0xb0b0b306UL, 0x5f5fe807UL, 0x0e0e0a08UL, 0xe1e15109UL, 0xb9b9bc0aUL, 0x5656e70bUL,
+	  0x09090f0cUL, 0xe6e6540dUL, 0xbebeb90eUL, 0x5151e20fUL, 0x1c1c1410UL, 0xf3f34f11UL,
+	  0xababa212UL, 0x4444f913UL, 0x1b1b1114UL, 0xf4f44a15UL, 0xacaca716UL, 0x4343fc17UL,
+	  0x12121e18UL, 0xfdfd4519UL, 0xa5a5a81aUL, 0x4a4af31bUL, 0x15151b1cUL, 0xfafa401dUL,
+	  0xa2a2ad1eUL, 0x4d4df61fUL, 0x38382820UL, 0xd7d77321UL, 0x8f8f9e22UL, 0x6060c523UL,
+	  0x3f3f2d24UL, 0xd0d07625UL, 0x88889b26UL, 0x6767c027UL, 0x36362228UL, 0xd9d97929UL,
+	  0x8181942aUL, 0x6e6ecf2bUL, 0x3131272cUL, 0xdede7c2dUL, 0x8686912eUL, 0x6969ca2fUL,
+	  0x24243c30UL, 0xcbcb6731UL, 0x93938a32UL, 0x7c7cd133UL, 0x23233934UL, 0xcccc6235UL,
+	  0x94948f36UL, 0x7b7bd437UL, 0x2a2a3638UL, 0xc5c56d39UL, 0x9d9d803aUL, 0x7272db3bUL,
+	  0x2d2d333cUL, 0xc2c2683dUL, 0x9a9a853eUL, 0x7575de3fUL, 0x70705040UL, 0x9f9f0b41UL,
+	  0xc7c7e642UL, 0x2828bd43UL, 0x77775544UL, 0x98980e45UL, 0xc0c0e346UL, 0x2f2fb847UL,
+	  0x7e7e5a48UL, 0x91910149UL, 0xc9c9ec4aUL, 0x2626b74bUL, 0x79795f4cUL, 0x9696044dUL,
+	  0xcecee94eUL, 0x2121b24fUL, 0x6c6c4450UL, 0x83831f51UL, 0xdbdbf252UL, 0x3434a953UL,
+	  0x6b6b4154UL, 0x84841a55UL, 0xdcdcf756UL, 0x3333ac57UL, 0x62624e58UL, 0x8d8d1559UL,
+	  0xd5d5f85aUL, 0x3a3aa35bUL, 0x65654b5cUL, 0x8a8a105dUL, 0xd2d2fd5eUL, 0x3d3da65fUL,
+	  0x48487860UL, 0xa7a72361UL, 0xffffce62UL, 0x10109563UL, 0x4f4f7d64UL, 0xa0a02665UL,
+	  0xf8f8cb66UL, 0x17179067UL, 0x46467268UL, 0xa9a92969UL, 0xf1f1c46aUL, 0x1e1e9f6bUL,
+	  0x4141776cUL, 0xaeae2c6dUL, 0xf6f6c16eUL, 0x19199a6fUL, 0x54546c70UL, 0xbbbb3771UL,
+	  0xe3e3da72UL, 0x0c0c8173UL, 0x53536974UL, 0xbcbc3275UL, 0xe4e4df76UL, 0x0b0b8477UL,
+	  0x5a5a6678UL, 0xb5b53d79UL, 0xededd07aUL, 0x02028b7bUL, 0x5d5d637cUL, 0xb2b2387dUL,
+	  0xeaead57eUL, 0x05058e7fUL, 0xe0e0a080UL, 0x0f0ffb81UL, 0x57571682UL, 0xb8b84d83UL,
+	  0xe7e7a584UL, 0x0808fe85UL, 0x50501386UL, 0xbfbf4887UL, 0xeeeeaa88UL, 0x0101f189UL,
+	  0x59591c8aUL, 0xb6b6478bUL, 0xe9e9af8cUL, 0x0606f48dUL, 0x5e5e198eUL, 0xb1b1428fUL,
+	  0xfcfcb490UL, 0x1313ef91UL, 0x4b4b0292UL, 0xa4a45993UL, 0xfbfbb194UL, 0x1414ea95UL,
+	  0x4c4c0796UL, 0xa3a35c97UL, 0xf2f2be98UL, 0x1d1de599UL, 0x4545089aUL, 0xaaaa539bUL,
+	  0xf5f5bb9cUL, 0x1a1ae09dUL, 0x42420d9eUL, 0xadad569fUL, 0xd8d888a0UL, 0x3737d3a1UL,
+	  0x6f6f3ea2UL, 0x808065a3UL, 0xdfdf8da4UL, 0x3030d6a5UL, 0x68683ba6UL, 0x878760a7UL,
+	  0xd6d682a8UL, 0x3939d9a9UL, 0x616134aaUL, 0x8e8e6fabUL, 0xd1d187acUL, 0x3e3edcadUL,
+	  0x666631aeUL, 0x89896aafUL, 0xc4c49cb0UL, 0x2b2bc7b1UL, 0x73732ab2UL, 0x9c9c71b3UL,
+	  0xc3c399b4UL, 0x2c2cc2b5UL, 0x74742fb6UL, 0x9b9b74b7UL, 0xcaca96b8UL, 0x2525cdb9UL,
+	  0x7d7d20baUL, 0x92927bbbUL, 0xcdcd93bcUL, 0x2222c8bdUL, 0x7a7a25beUL, 0x95957ebfUL,
+	  0x9090f0c0UL, 0x7f7fabc1UL, 0x272746c2UL, 0xc8c81dc3UL, 0x9797f5c4UL, 0x7878aec5UL,
+	  0x202043c6UL, 0xcfcf18c7UL, 0x9e9efac8UL, 0x7171a1c9UL, 0x29294ccaUL, 0xc6c617cbUL,
+	  0x9999ffccUL, 0x7676a4cdUL, 0x2e2e49ceUL, 0xc1c112cfUL, 0x8c8ce4d0UL, 0x6363bfd1UL,
+	  0x3b3b52d2UL, 0xd4d409d3UL, 0x8b8be1d4UL, 0x6464bad5UL, 0x3c3c57d6UL, 0xd3d30cd7UL,
+	  0x8282eed8UL, 0x6d6db5d9UL, 0x353558daUL, 0xdada03dbUL, 0x8585ebdcUL, 0x6a6ab0ddUL,
+	  0x32325ddeUL, 0xdddd06dfUL, 0xa8a8d8e0UL, 0x474783e1UL, 0x1f1f6ee2UL, 0xf0f035e3UL,
+	  0xafafdde4UL, 0x404086e5UL, 0x18186be6UL, 0xf7f730e7UL, 0xa6a6d2e8UL, 0x494989e9UL,
+	  0x111164eaUL, 0xfefe3febUL, 0xa1a1d7ecUL, 0x4e4e8cedUL, 0x161661eeUL, 0xf9f93aefUL,
+	  0xb4b4ccf0UL, 0x5b5b97f1UL, 0x03037af2UL, 0xecec21f3UL, 0xb3b3c9f4UL, 0x5c5c92f5UL,
+	  0x04047ff6UL, 0xebeb24f7UL, 0xbabac6f8UL, 0x55559df9UL, 0x0d0d70faUL, 0xe2e22bfbUL,
+	  0xbdbdc3fcUL, 0x525298fdUL, 0x0a0a75feUL, 0xe5e52effUL },
+	{ 0x00000000UL, 0x015befefUL, 0x02b6b7b7UL, 0x03ed5858UL, 0x04050707UL, 0x055ee8e8UL,
+	  0x06b3b0b0UL, 0x07e85f5fUL, 0x080a0e0eUL, 0x0951e1e1UL, 0x0abcb9b9UL, 0x0be75656UL,
+	  0x0c0f0909UL, 0x0d54e6e6UL, 0x0eb9bebeUL, 0x0fe25151UL, 0x10141c1cUL, 0x114ff3f3UL,
+	  0x12a2ababUL, 0x13f94444UL, 0x14111b1bUL, 0x154af4f4UL, 0x16a7acacUL, 0x17fc4343UL,
+	  0x181e1212UL, 0x1945fdfdUL, 0x1aa8a5a5UL, 0x1bf34a4aUL, 0x1c1b1515UL, 0x1d40fafaUL,
+	  0x1eada2a2UL, 0x1ff64d4dUL, 0x20283838UL, 0x2173d7d7UL, 0x229e8f8fUL, 0x23c56060UL,
+	  0x242d3f3fUL, 0x2576d0d0UL, 0x269b8888UL, 0x27c06767UL, 0x28223636UL, 0x2979d9d9UL,
+	  0x2a948181UL, 0x2bcf6e6eUL, 0x2c273131UL, 0x2d7cdedeUL, 0x2e918686UL, 0x2fca6969UL,
+	  0x303c2424UL, 0x3167cbcbUL, 0x328a9393UL, 0x33d17c7cUL, 0x34392323UL, 0x3562ccccUL,
+	  0x368f9494UL, 0x37d47b7bUL, 0x38362a2aUL, 0x396dc5c5UL, 0x3a809d9dUL, 0x3bdb7272UL,
+	  0x3c332d2dUL, 0x3d68c2c2UL, 0x3e859a9aUL, 0x3fde7575UL, 0x40507070UL, 0x410b9f9fUL,
+	  0x42e6c7c7UL, 0x43bd2828UL, 0x44557777UL, 0x450e9898UL, 0x46e3c0c0UL, 0x47b82f2fUL,
+	  0x485a7e7eUL, 0x49019191UL, 0x4aecc9c9UL, 0x4bb72626UL, 0x4c5f7979UL, 0x4d049696UL,
+	  0x4ee9ceceUL, 0x4fb22121UL, 0x50446c6cUL, 0x511f8383UL, 0x52f2dbdbUL, 0x53a93434UL,
+	  0x54416b6bUL, 0x551a8484UL, 0x56f7dcdcUL, 0x57ac3333UL, 0x584e6262UL, 0x59158d8dUL,
+	  0x5af8d5d5UL, 0x5ba33a3aUL, 0x5c4b6565UL, 0x5d108a8aUL, 0x5efdd2d2UL, 0x5fa63d3dUL,
+	  0x60784848UL, 0x6123a7a7UL, 0x62ceffffUL, 0x63951010UL, 0x647d4f4fUL, 0x6526a0a0UL,
+	  0x66cbf8f8UL, 0x67901717UL, 0x68724646UL, 0x6929a9a9UL, 0x6ac4f1f1UL, 0x6b9f1e1eUL,
+	  0x6c774141UL, 0x6d2caeaeUL, 0x6ec1f6f6UL, 0x6f9a1919UL, 0x706c5454UL, 0x7137bbbbUL,
+	  0x72dae3e3UL, 0x73810c0cUL, 0x74695353UL, 0x7532bcbcUL, 0x76dfe4e4UL, 0x77840b0bUL,
+	  0x78665a5aUL, 0x793db5b5UL, 0x7ad0ededUL, 0x7b8b0202UL, 0x7c635d5dUL, 0x7d38b2b2UL,
+	  0x7ed5eaeaUL, 0x7f8e0505UL, 0x80a0e0e0UL, 0x81fb0f0fUL, 0x82165757UL, 0x834db8b8UL,
+	  0x84a5e7e7UL, 0x85fe0808UL, 0x86135050UL, 0x8748bfbfUL, 0x88aaeeeeUL, 0x89f10101UL,
+	  0x8a1c5959UL, 0x8b47b6b6UL, 0x8cafe9e9UL, 0x8df40606UL, 0x8e195e5eUL, 0x8f42b1b1UL,
+	  0x90b4fcfcUL, 0x91ef1313UL, 0x92024b4bUL, 0x9359a4a4UL, 0x94b1fbfbUL, 0x95ea1414UL,
+	  0x96074c4cUL, 0x975ca3a3UL, 0x98bef2f2UL, 0x99e51d1dUL, 0x9a084545UL, 0x9b53aaaaUL,
+	  0x9cbbf5f5UL, 0x9de01a1aUL, 0x9e0d4242UL, 0x9f56adadUL, 0xa088d8d8UL, 0xa1d33737UL,
+	  0xa23e6f6fUL, 0xa3658080UL, 0xa48ddfdfUL, 0xa5d63030UL, 0xa63b6868UL, 0xa7608787UL,
+	  0xa882d6d6UL, 0xa9d93939UL, 0xaa346161UL, 0xab6f8e8eUL, 0xac87d1d1UL, 0xaddc3e3eUL,
+	  0xae316666UL, 0xaf6a8989UL, 0xb09cc4c4UL, 0xb1c72b2bUL, 0xb22a7373UL, 0xb3719c9cUL,
+	  0xb499c3c3UL, 0xb5c22c2cUL, 0xb62f7474UL, 0xb7749b9bUL, 0xb896cacaUL, 0xb9cd2525UL,
+	  0xba207d7dUL, 0xbb7b9292UL, 0xbc93cdcdUL, 0xbdc82222UL, 0xbe257a7aUL, 0xbf7e9595UL,
+	  0xc0f09090UL, 0xc1ab7f7fUL, 0xc2462727UL, 0xc31dc8c8UL, 0xc4f59797UL, 0xc5ae7878UL,
+	  0xc6432020UL, 0xc718cfcfUL, 0xc8fa9e9eUL, 0xc9a17171UL, 0xca4c2929UL, 0xcb17c6c6UL,
+	  0xccff9999UL, 0xcda47676UL, 0xce492e2eUL, 0xcf12c1c1UL, 0xd0e48c8cUL, 0xd1bf6363UL,
+	  0xd2523b3bUL, 0xd309d4d4UL, 0xd4e18b8bUL, 0xd5ba6464UL, 0xd6573c3cUL, 0xd70cd3d3UL,
+	  0xd8ee8282UL, 0xd9b56d6dUL, 0xda583535UL, 0xdb03dadaUL, 0xdceb8585UL, 0xddb06a6aUL,
+	  0xde5d3232UL, 0xdf06ddddUL, 0xe0d8a8a8UL, 0xe1834747UL, 0xe26e1f1fUL, 0xe335f0f0UL,
+	  0xe4ddafafUL, 0xe5864040UL, 0xe66b1818UL, 0xe730f7f7UL, 0xe8d2a6a6UL, 0xe9894949UL,
+	  0xea641111UL, 0xeb3ffefeUL, 0xecd7a1a1UL, 0xed8c4e4eUL, 0xee611616UL, 0xef3af9f9UL,
+	  0xf0ccb4b4UL, 0xf1975b5bUL, 0xf27a0303UL, 0xf321ececUL, 0xf4c9b3b3UL, 0xf5925c5cUL,
+	  0xf67f0404UL, 0xf724ebebUL, 0xf8c6babaUL, 0xf99d5555UL, 0xfa700d0dUL, 0xfb2be2e2UL,
+	  0xfcc3bdbdUL, 0xfd985252UL, 0xfe750a0aUL, 0xff2ee5e5UL },
+	{ 0x00000000UL, 0xef01ef5bUL, 0xb702b7b6UL, 0x580358edUL, 0x07040705UL, 0xe805e85eUL,
+	  0xb006b0b3UL, 0x5f075fe8UL, 0x0e080e0aUL, 0xe109e151UL, 0xb90ab9bcUL, 0x560b56e7UL,
+	  0x090c090fUL, 0xe60de654UL, 0xbe0ebeb9UL, 0x510f51e2UL, 0x1c101c14UL, 0xf311f34fUL,
+	  0xab12aba2UL, 0x441344f9UL, 0x1b141b11UL, 0xf415f44aUL, 0xac16aca7UL, 0x431743fcUL,
+	  0x1218121eUL, 0xfd19fd45UL, 0xa51aa5a8UL, 0x4a1b4af3UL, 0x151c151bUL, 0xfa1dfa40UL,
+	  0xa21ea2adUL, 0x4d1f4df6UL, 0x38203828UL, 0xd721d773UL, 0x8f228f9eUL, 0x602360c5UL,
+	  0x3f243f2dUL, 0xd025d076UL, 0x8826889bUL, 0x672767c0UL, 0x36283622UL, 0xd929d979UL,
+	  0x812a8194UL, 0x6e2b6ecfUL, 0x312c3127UL, 0xde2dde7cUL, 0x862e8691UL, 0x692f69caUL,
+	  0x2430243cUL, 0xcb31cb67UL, 0x9332938aUL, 0x7c337cd1UL, 0x23342339UL, 0xcc35cc62UL,
+	  0x9436948fUL, 0x7b377bd4UL, 0x2a382a36UL, 0xc539c56dUL, 0x9d3a9d80UL, 0x723b72dbUL,
+	  0x2d3c2d33UL, 0xc23dc268UL, 0x9a3e9a85UL, 0x753f75deUL, 0x70407050UL, 0x9f419f0bUL,
+	  0xc742c7e6UL, 0x284328bdUL, 0x77447755UL, 0x9845980eUL, 0xc046c0e3UL, 0x2f472fb8UL,
+	  0x7e487e5aUL, 0x91499101UL, 0xc94ac9ecUL, 0x264b26b7UL, 0x794c795fUL, 0x964d9604UL,
+	  0xce4ecee9UL, 0x214f21b2UL, 0x6c506c44UL, 0x8351831fUL, 0xdb52dbf2UL, 0x345334a9UL,
+	  0x6b546b41UL, 0x8455841aUL, 0xdc56dcf7UL, 0x335733acUL, 0x6258624eUL, 0x8d598d15UL,
+	  0xd55ad5f8UL, 0x3a5b3aa3UL, 0x655c654bUL, 0x8a5d8a10UL, 0xd25ed2fdUL, 0x3d5f3da6UL,
+	  0x48604878UL, 0xa761a723UL, 0xff62ffceUL, 0x10631095UL, 0x4f644f7dUL, 0xa065a026UL,
+	  0xf866f8cbUL, 0x17671790UL, 0x46684672UL, 0xa969a929UL, 0xf16af1c4UL, 0x1e6b1e9fUL,
+	  0x416c4177UL, 0xae6dae2cUL, 0xf66ef6c1UL, 0x196f199aUL, 0x5470546cUL, 0xbb71bb37UL,
+	  0xe372e3daUL, 0x0c730c81UL, 0x53745369UL, 0xbc75bc32UL, 0xe476e4dfUL, 0x0b770b84UL,
+	  0x5a785a66UL, 0xb579b53dUL, 0xed7aedd0UL, 0x027b028bUL, 0x5d7c5d63UL, 0xb27db238UL,
+	  0xea7eead5UL, 0x057f058eUL, 0xe080e0a0UL, 0x0f810ffbUL, 0x57825716UL, 0xb883b84dUL,
+	  0xe784e7a5UL, 0x088508feUL, 0x50865013UL, 0xbf87bf48UL, 0xee88eeaaUL, 0x018901f1UL,
+	  0x598a591cUL, 0xb68bb647UL, 0xe98ce9afUL, 0x068d06f4UL, 0x5e8e5e19UL, 0xb18fb142UL,
+	  0xfc90fcb4UL, 0x139113efUL, 0x4b924b02UL, 0xa493a459UL, 0xfb94fbb1UL, 0x149514eaUL,
+	  0x4c964c07UL, 0xa397a35cUL, 0xf298f2beUL, 0x1d991de5UL, 0x459a4508UL, 0xaa9baa53UL,
+	  0xf59cf5bbUL, 0x1a9d1ae0UL, 0x429e420dUL, 0xad9fad56UL, 0xd8a0d888UL, 0x37a137d3UL,
+	  0x6fa26f3eUL, 0x80a38065UL, 0xdfa4df8dUL, 0x30a530d6UL, 0x68a6683bUL, 0x87a78760UL,
+	  0xd6a8d682UL, 0x39a939d9UL, 0x61aa6134UL, 0x8eab8e6fUL, 0xd1acd187UL, 0x3ead3edcUL,
+	  0x66ae6631UL, 0x89af896aUL, 0xc4b0c49cUL, 0x2bb12bc7UL, 0x73b2732aUL, 0x9cb39c71UL,
+	  0xc3b4c399UL, 0x2cb52cc2UL, 0x74b6742fUL, 0x9bb79b74UL, 0xcab8ca96UL, 0x25b925cdUL,
+	  0x7dba7d20UL, 0x92bb927bUL, 0xcdbccd93UL, 0x22bd22c8UL, 0x7abe7a25UL, 0x95bf957eUL,
+	  0x90c090f0UL, 0x7fc17fabUL, 0x27c22746UL, 0xc8c3c81dUL, 0x97c497f5UL, 0x78c578aeUL,
+	  0x20c62043UL, 0xcfc7cf18UL, 0x9ec89efaUL, 0x71c971a1UL, 0x29ca294cUL, 0xc6cbc617UL,
+	  0x99cc99ffUL, 0x76cd76a4UL, 0x2ece2e49UL, 0xc1cfc112UL, 0x8cd08ce4UL, 0x63d163bfUL,
+	  0x3bd23b52UL, 0xd4d3d409UL, 0x8bd48be1UL, 0x64d564baUL, 0x3cd63c57UL, 0xd3d7d30cUL,
+	  0x82d882eeUL, 0x6dd96db5UL, 0x35da3558UL, 0xdadbda03UL, 0x85dc85ebUL, 0x6add6ab0UL,
+	  0x32de325dUL, 0xdddfdd06UL, 0xa8e0a8d8UL, 0x47e14783UL, 0x1fe21f6eUL, 0xf0e3f035UL,
+	  0xafe4afddUL, 0x40e54086UL, 0x18e6186bUL, 0xf7e7f730UL, 0xa6e8a6d2UL, 0x49e94989UL,
+	  0x11ea1164UL, 0xfeebfe3fUL, 0xa1eca1d7UL, 0x4eed4e8cUL, 0x16ee1661UL, 0xf9eff93aUL,
+	  0xb4f0b4ccUL, 0x5bf15b97UL, 0x03f2037aUL, 0xecf3ec21UL, 0xb3f4b3c9UL, 0x5cf55c92UL,
+	  0x04f6047fUL, 0xebf7eb24UL, 0xbaf8bac6UL, 0x55f9559dUL, 0x0dfa0d70UL, 0xe2fbe22bUL,
+	  0xbdfcbdc3UL, 0x52fd5298UL, 0x0afe0a75UL, 0xe5ffe52eUL },
+	{ 0x00000000UL, 0x5bef015bUL, 0xb6b702b6UL, 0xed5803edUL, 0x05070405UL, 0x5ee8055eUL,
+	  0xb3b006b3UL, 0xe85f07e8UL, 0x0a0e080aUL, 0x51e10951UL, 0xbcb90abcUL, 0xe7560be7UL,
+	  0x0f090c0fUL, 0x54e60d54UL, 0xb9be0eb9UL, 0xe2510fe2UL, 0x141c1014UL, 0x4ff3114fUL,
+	  0xa2ab12a2UL, 0xf94413f9UL, 0x111b1411UL, 0x4af4154aUL, 0xa7ac16a7UL, 0xfc4317fcUL,
+	  0x1e12181eUL, 0x45fd1945UL, 0xa8a51aa8UL, 0xf34a1bf3UL, 0x1b151c1bUL, 0x40fa1d40UL,
+	  0xada21eadUL, 0xf64d1ff6UL, 0x28382028UL, 0x73d72173UL, 0x9e8f229eUL, 0xc56023c5UL,
+	  0x2d3f242dUL, 0x76d02576UL, 0x9b88269bUL, 0xc06727c0UL, 0x22362822UL, 0x79d92979UL,
+	  0x94812a94UL, 0xcf6e2bcfUL, 0x27312c27UL, 0x7cde2d7cUL, 0x91862e91UL, 0xca692fcaUL,
+	  0x3c24303cUL, 0x67cb3167UL, 0x8a93328aUL, 0xd17c33d1UL, 0x39233439UL, 0x62cc3562UL,
+	  0x8f94368fUL, 0xd47b37d4UL, 0x362a3836UL, 0x6dc5396dUL, 0x809d3a80UL, 0xdb723bdbUL,
+	  0x332d3c33UL, 0x68c23d68UL, 0x859a3e85UL, 0xde753fdeUL, 0x50704050UL, 0x0b9f410bUL,
+	  0xe6c742e6UL, 0xbd2843bdUL, 0x55774455UL, 0x0e98450eUL, 0xe3c046e3UL, 0xb82f47b8UL,
+	  0x5a7e485aUL, 0x01914901UL, 0xecc94aecUL, 0xb7264bb7UL, 0x5f794c5fUL, 0x04964d04UL,
+	  0xe9ce4ee9UL, 0xb2214fb2UL, 0x446c5044UL, 0x1f83511fUL, 0xf2db52f2UL, 0xa93453a9UL,
+	  0x416b5441UL, 0x1a84551aUL, 0xf7dc56f7UL, 0xac3357acUL, 0x4e62584eUL, 0x158d5915UL,
+	  0xf8d55af8UL, 0xa33a5ba3UL, 0x4b655c4bUL, 0x108a5d10UL, 0xfdd25efdUL, 0xa63d5fa6UL,
+	  0x78486078UL, 0x23a76123UL, 0xceff62ceUL, 0x95106395UL, 0x7d4f647dUL, 0x26a06526UL,
+	  0xcbf866cbUL, 0x90176790UL, 0x72466872UL, 0x29a96929UL, 0xc4f16ac4UL, 0x9f1e6b9fUL,
+	  0x77416c77UL, 0x2cae6d2cUL, 0xc1f66ec1UL, 0x9a196f9aUL, 0x6c54706cUL, 0x37bb7137UL,
+	  0xdae372daUL, 0x810c7381UL, 0x69537469UL, 0x32bc7532UL, 0xdfe476dfUL, 0x840b7784UL,
+	  0x665a7866UL, 0x3db5793dUL, 0xd0ed7ad0UL, 0x8b027b8bUL, 0x635d7c63UL, 0x38b27d38UL,
+	  0xd5ea7ed5UL, 0x8e057f8eUL, 0xa0e080a0UL, 0xfb0f81fbUL, 0x16578216UL, 0x4db8834dUL,
+	  0xa5e784a5UL, 0xfe0885feUL, 0x13508613UL, 0x48bf8748UL, 0xaaee88aaUL, 0xf10189f1UL,
+	  0x1c598a1cUL, 0x47b68b47UL, 0xafe98cafUL, 0xf4068df4UL, 0x195e8e19UL, 0x42b18f42UL,
+	  0xb4fc90b4UL, 0xef1391efUL, 0x024b9202UL, 0x59a49359UL, 0xb1fb94b1UL, 0xea1495eaUL,
+	  0x074c9607UL, 0x5ca3975cUL, 0xbef298beUL, 0xe51d99e5UL, 0x08459a08UL, 0x53aa9b53UL,
+	  0xbbf59cbbUL, 0xe01a9de0UL, 0x0d429e0dUL, 0x56ad9f56UL, 0x88d8a088UL, 0xd337a1d3UL,
+	  0x3e6fa23eUL, 0x6580a365UL, 0x8ddfa48dUL, 0xd630a5d6UL, 0x3b68a63bUL, 0x6087a760UL,
+	  0x82d6a882UL, 0xd939a9d9UL, 0x3461aa34UL, 0x6f8eab6fUL, 0x87d1ac87UL, 0xdc3eaddcUL,
+	  0x3166ae31UL, 0x6a89af6aUL, 0x9cc4b09cUL, 0xc72bb1c7UL, 0x2a73b22aUL, 0x719cb371UL,
+	  0x99c3b499UL, 0xc22cb5c2UL, 0x2f74b62fUL, 0x749bb774UL, 0x96cab896UL, 0xcd25b9cdUL,
+	  0x207dba20UL, 0x7b92bb7bUL, 0x93cdbc93UL, 0xc822bdc8UL, 0x257abe25UL, 0x7e95bf7eUL,
+	  0xf090c0f0UL, 0xab7fc1abUL, 0x4627c246UL, 0x1dc8c31dUL, 0xf597c4f5UL, 0xae78c5aeUL,
+	  0x4320c643UL, 0x18cfc718UL, 0xfa9ec8faUL, 0xa171c9a1UL, 0x4c29ca4cUL, 0x17c6cb17UL,
+	  0xff99ccffUL, 0xa476cda4UL, 0x492ece49UL, 0x12c1cf12UL, 0xe48cd0e4UL, 0xbf63d1bfUL,
+	  0x523bd252UL, 0x09d4d309UL, 0xe18bd4e1UL, 0xba64d5baUL, 0x573cd657UL, 0x0cd3d70cUL,
+	  0xee82d8eeUL, 0xb56dd9b5UL, 0x5835da58UL, 0x03dadb03UL, 0xeb85dcebUL, 0xb06addb0UL,
+	  0x5d32de5dUL, 0x06dddf06UL, 0xd8a8e0d8UL, 0x8347e183UL, 0x6e1fe26eUL, 0x35f0e335UL,
+	  0xddafe4ddUL, 0x8640e586UL, 0x6b18e66bUL, 0x30f7e730UL, 0xd2a6e8d2UL, 0x8949e989UL,
+	  0x6411ea64UL, 0x3ffeeb3fUL, 0xd7a1ecd7UL, 0x8c4eed8cUL, 0x6116ee61UL, 0x3af9ef3aUL,
+	  0xccb4f0ccUL, 0x975bf197UL, 0x7a03f27aUL, 0x21ecf321UL, 0xc9b3f4c9UL, 0x925cf592UL,
+	  0x7f04f67fUL, 0x24ebf724UL, 0xc6baf8c6UL, 0x9d55f99dUL, 0x700dfa70UL, 0x2be2fb2bUL,
+	  0xc3bdfcc3UL, 0x9852fd98UL, 0x750afe75UL, 0x2ee5ff2eUL } };
+
+/* The Reed-Solomon matrix used to derive the S-box keys
+ */
+static const uint8_t libluksde_twofish_reed_solomon_matrix[ 4 ][ 8 ] = {
+	{ 0x01, 0xa4, 0x55, 0x87, 0x5a, 0x58, 0xdb, 0x9e },
+	{ 0xa4, 0x56, 0x82, 0xf3, 0x1e, 0xc6, 0x68, 0xe5 },
+	{ 0x02, 0xa1, 0xfc, 0xc1, 0x47, 0xae, 0x3d, 0x19 },
+	{ 0xa4, 0x55, 0x87, 0x5a, 0x58, 0xdb, 0x9e, 0x03 } };
+
+/* Creates a context
+ * Make sure the value context is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_twofish_context_initialize(
+     libluksde_twofish_context_t **context,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_twofish_context_initialize";
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *context != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid context value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*context = memory_allocate_structure(
+	            libluksde_twofish_context_t );
+
+	if( *context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create context.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *context,
+	     0,
+	     sizeof( libluksde_twofish_context_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear context.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *context != NULL )
+	{
+		memory_free(
+		 *context );
+
+		*context = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a context
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_twofish_context_free(
+     libluksde_twofish_context_t **context,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_twofish_context_free";
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *context != NULL )
+	{
+		/* The key-dependent S-boxes and subkeys are key material
+		 */
+		memory_set(
+		 *context,
+		 0,
+		 sizeof( libluksde_twofish_context_t ) );
+
+		memory_free(
+		 *context );
+
+		*context = NULL;
+	}
+	return( 1 );
+}
+
+/* Multiplies two elements in GF(2^8) modulo the Reed-Solomon code polynomial
+ * x^8 + x^6 + x^3 + x^2 + 1
+ * Returns the product
+ */
+static uint8_t libluksde_twofish_reed_solomon_multiply(
+                uint8_t multiplicand,
+                uint8_t multiplier )
+{
+	uint16_t product = 0;
+	uint16_t value   = multiplicand;
+
+	while( multiplier != 0 )
+	{
+		if( ( multiplier & 0x01 ) != 0 )
+		{
+			product ^= value;
+		}
+		value <<= 1;
+
+		if( ( value & 0x0100 ) != 0 )
+		{
+			value ^= 0x014d;
+		}
+		multiplier >>= 1;
+	}
+	return( (uint8_t) product );
+}
+
+/* Applies the q permutations of the h function, interleaved with the key words,
+ * to the 4 bytes of a 32-bit word
+ */
+static void libluksde_twofish_permute_bytes(
+             uint8_t *bytes,
+             const uint32_t *key_words,
+             int number_of_key_words )
+{
+	if( number_of_key_words == 4 )
+	{
+		bytes[ 0 ] = libluksde_twofish_q1[ bytes[ 0 ] ] ^ (uint8_t) key_words[ 3 ];
+		bytes[ 1 ] = libluksde_twofish_q0[ bytes[ 1 ] ] ^ (uint8_t) ( key_words[ 3 ] >> 8 );
+		bytes[ 2 ] = libluksde_twofish_q0[ bytes[ 2 ] ] ^ (uint8_t) ( key_words[ 3 ] >> 16 );
+		bytes[ 3 ] = libluksde_twofish_q1[ bytes[ 3 ] ] ^ (uint8_t) ( key_words[ 3 ] >> 24 );
+	}
+	if( number_of_key_words >= 3 )
+	{
+		bytes[ 0 ] = libluksde_twofish_q1[ bytes[ 0 ] ] ^ (uint8_t) key_words[ 2 ];
+		bytes[ 1 ] = libluksde_twofish_q1[ bytes[ 1 ] ] ^ (uint8_t) ( key_words[ 2 ] >> 8 );
+		bytes[ 2 ] = libluksde_twofish_q0[ bytes[ 2 ] ] ^ (uint8_t) ( key_words[ 2 ] >> 16 );
+		bytes[ 3 ] = libluksde_twofish_q0[ bytes[ 3 ] ] ^ (uint8_t) ( key_words[ 2 ] >> 24 );
+	}
+	bytes[ 0 ] = libluksde_twofish_q1[ libluksde_twofish_q0[ libluksde_twofish_q0[ bytes[ 0 ] ] ^ (uint8_t) key_words[ 1 ] ] ^ (uint8_t) key_words[ 0 ] ];
+	bytes[ 1 ] = libluksde_twofish_q0[ libluksde_twofish_q0[ libluksde_twofish_q1[ bytes[ 1 ] ] ^ (uint8_t) ( key_words[ 1 ] >> 8 ) ] ^ (uint8_t) ( key_words[ 0 ] >> 8 ) ];
+	bytes[ 2 ] = libluksde_twofish_q1[ libluksde_twofish_q1[ libluksde_twofish_q0[ bytes[ 2 ] ] ^ (uint8_t) ( key_words[ 1 ] >> 16 ) ] ^ (uint8_t) ( key_words[ 0 ] >> 16 ) ];
+	bytes[ 3 ] = libluksde_twofish_q0[ libluksde_twofish_q1[ libluksde_twofish_q1[ bytes[ 3 ] ] ^ (uint8_t) ( key_words[ 1 ] >> 24 ) ] ^ (uint8_t) ( key_words[ 0 ] >> 24 ) ];
+}
+
+/* Calculates the h function used by the key schedule
+ * Returns the resulting 32-bit word
+ */
+static uint32_t libluksde_twofish_h(
+                 uint32_t value,
+                 const uint32_t *key_words,
+                 int number_of_key_words )
+{
+	uint8_t bytes[ 4 ];
+
+	bytes[ 0 ] = (uint8_t) value;
+	bytes[ 1 ] = (uint8_t) ( value >> 8 );
+	bytes[ 2 ] = (uint8_t) ( value >> 16 );
+	bytes[ 3 ] = (uint8_t) ( value >> 24 );
+
+	libluksde_twofish_permute_bytes(
+	 bytes,
+	 key_words,
+	 number_of_key_words );
+
+	return( libluksde_twofish_mds[ 0 ][ bytes[ 0 ] ]
+	      ^ libluksde_twofish_mds[ 1 ][ bytes[ 1 ] ]
+	      ^ libluksde_twofish_mds[ 2 ][ bytes[ 2 ] ]
+	      ^ libluksde_twofish_mds[ 3 ][ bytes[ 3 ] ] );
+}
+
+/* Sets the key
+ * Twofish uses the same key schedule to de- and encrypt
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_twofish_context_set_key(
+     libluksde_twofish_context_t *context,
+     const uint8_t *key,
+     size_t key_bit_size,
+     libcerror_error_t **error )
+{
+	uint32_t even_key_words[ 4 ];
+	uint32_t odd_key_words[ 4 ];
+	uint32_t s_box_key_words[ 4 ];
+	uint8_t bytes[ 4 ];
+
+	static char *function   = "libluksde_twofish_context_set_key";
+	uint32_t subkey_a       = 0;
+	uint32_t subkey_b       = 0;
+	uint32_t value_32bit    = 0;
+	uint16_t byte_value     = 0;
+	uint8_t column_index    = 0;
+	uint8_t row_index       = 0;
+	uint8_t value_8bit      = 0;
+	int byte_index          = 0;
+	int number_of_key_words = 0;
+	int word_index          = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( key_bit_size != 128 )
+	 && ( key_bit_size != 192 )
+	 && ( key_bit_size != 256 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported key bit size.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_key_words = (int) ( key_bit_size / 64 );
+
+	for( word_index = 0;
+	     word_index < number_of_key_words;
+	     word_index++ )
+	{
+		byte_stream_copy_to_uint32_little_endian(
+		 &( key[ word_index * 8 ] ),
+		 even_key_words[ word_index ] );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 &( key[ ( word_index * 8 ) + 4 ] ),
+		 odd_key_words[ word_index ] );
+
+		/* The S-box key words are derived from 8 bytes of the key using
+		 * the Reed-Solomon matrix and are used in reverse order
+		 */
+		value_32bit = 0;
+
+		for( row_index = 0;
+		     row_index < 4;
+		     row_index++ )
+		{
+			value_8bit = 0;
+
+			for( column_index = 0;
+			     column_index < 8;
+			     column_index++ )
+			{
+				value_8bit ^= libluksde_twofish_reed_solomon_multiply(
+				               libluksde_twofish_reed_solomon_matrix[ row_index ][ column_index ],
+				               key[ ( word_index * 8 ) + column_index ] );
+			}
+			value_32bit |= (uint32_t) value_8bit << ( row_index * 8 );
+		}
+		s_box_key_words[ number_of_key_words - 1 - word_index ] = value_32bit;
+	}
+	for( word_index = 0;
+	     word_index < 40;
+	     word_index += 2 )
+	{
+		subkey_a = libluksde_twofish_h(
+		            (uint32_t) word_index * 0x01010101UL,
+		            even_key_words,
+		            number_of_key_words );
+
+		subkey_b = libluksde_twofish_h(
+		            (uint32_t) ( word_index + 1 ) * 0x01010101UL,
+		            odd_key_words,
+		            number_of_key_words );
+
+		subkey_b = libluksde_twofish_rotate_left(
+		            subkey_b,
+		            8 );
+
+		context->subkeys[ word_index ]     = subkey_a + subkey_b;
+		context->subkeys[ word_index + 1 ] = libluksde_twofish_rotate_left(
+		                                      subkey_a + ( 2 * subkey_b ),
+		                                      9 );
+	}
+	/* The S-boxes are fully precomputed for the key and combined with the MDS matrix
+	 * so that the g function only requires 4 table lookups
+	 */
+	for( byte_value = 0;
+	     byte_value < 256;
+	     byte_value++ )
+	{
+		for( byte_index = 0;
+		     byte_index < 4;
+		     byte_index++ )
+		{
+			bytes[ byte_index ] = (uint8_t) byte_value;
+		}
+		libluksde_twofish_permute_bytes(
+		 bytes,
+		 s_box_key_words,
+		 number_of_key_words );
+
+		for( byte_index = 0;
+		     byte_index < 4;
+		     byte_index++ )
+		{
+			context->s_boxes[ byte_index ][ byte_value ] = libluksde_twofish_mds[ byte_index ][ bytes[ byte_index ] ];
+		}
+	}
+	memory_set(
+	 even_key_words,
+	 0,
+	 sizeof( uint32_t ) * 4 );
+
+	memory_set(
+	 odd_key_words,
+	 0,
+	 sizeof( uint32_t ) * 4 );
+
+	memory_set(
+	 s_box_key_words,
+	 0,
+	 sizeof( uint32_t ) * 4 );
+
+	memory_set(
+	 bytes,
+	 0,
+	 4 );
+
+	return( 1 );
+}
+
+/* Calculates the g function of a 32-bit word
+ * Returns the resulting 32-bit word
+ */
+static inline uint32_t libluksde_twofish_g(
+                        const libluksde_twofish_context_t *context,
+                        uint32_t value )
+{
+	return( context->s_boxes[ 0 ][ value & 0xff ]
+	      ^ context->s_boxes[ 1 ][ ( value >> 8 ) & 0xff ]
+	      ^ context->s_boxes[ 2 ][ ( value >> 16 ) & 0xff ]
+	      ^ context->s_boxes[ 3 ][ value >> 24 ] );
+}
+
+/* Calculates the g function of a 32-bit word that is rotated left by 8 bits
+ * Returns the resulting 32-bit word
+ */
+static inline uint32_t libluksde_twofish_g_rotated(
+                        const libluksde_twofish_context_t *context,
+                        uint32_t value )
+{
+	return( context->s_boxes[ 0 ][ value >> 24 ]
+	      ^ context->s_boxes[ 1 ][ value & 0xff ]
+	      ^ context->s_boxes[ 2 ][ ( value >> 8 ) & 0xff ]
+	      ^ context->s_boxes[ 3 ][ ( value >> 16 ) & 0xff ] );
+}
+
+/* Encrypts a 16-byte block
+ */
+static void libluksde_twofish_encrypt_block(
+             const libluksde_twofish_context_t *context,
+             const uint8_t *input_data,
+             uint8_t *output_data )
+{
+	const uint32_t *subkeys = context->subkeys;
+	uint32_t value_a        = 0;
+	uint32_t value_b        = 0;
+	uint32_t value_c        = 0;
+	uint32_t value_d        = 0;
+	uint32_t value_t0       = 0;
+	uint32_t value_t1       = 0;
+	int round_index         = 0;
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( input_data[ 0 ] ),
+	 value_a );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( input_data[ 4 ] ),
+	 value_b );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( input_data[ 8 ] ),
+	 value_c );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( input_data[ 12 ] ),
+	 value_d );
+
+	value_a ^= subkeys[ 0 ];
+	value_b ^= subkeys[ 1 ];
+	value_c ^= subkeys[ 2 ];
+	value_d ^= subkeys[ 3 ];
+
+	/* 2 rounds are calculated per iteration so that the halves do not need to be swapped
+	 */
+	for( round_index = 0;
+	     round_index < 16;
+	     round_index += 2 )
+	{
+		value_t0 = libluksde_twofish_g(
+		            context,
+		            value_a );
+
+		value_t1 = libluksde_twofish_g_rotated(
+		            context,
+		            value_b );
+
+		value_c ^= value_t0 + value_t1 + subkeys[ 8 + ( 2 * round_index ) ];
+		value_c  = libluksde_twofish_rotate_right(
+		            value_c,
+		            1 );
+
+		value_d  = libluksde_twofish_rotate_left(
+		            value_d,
+		            1 );
+		value_d ^= value_t0 + ( 2 * value_t1 ) + subkeys[ 9 + ( 2 * round_index ) ];
+
+		value_t0 = libluksde_twofish_g(
+		            context,
+		            value_c );
+
+		value_t1 = libluksde_twofish_g_rotated(
+		            context,
+		            value_d );
+
+		value_a ^= value_t0 + value_t1 + subkeys[ 10 + ( 2 * round_index ) ];
+		value_a  = libluksde_twofish_rotate_right(
+		            value_a,
+		            1 );
+
+		value_b  = libluksde_twofish_rotate_left(
+		            value_b,
+		            1 );
+		value_b ^= value_t0 + ( 2 * value_t1 ) + subkeys[ 11 + ( 2 * round_index ) ];
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 &( output_data[ 0 ] ),
+	 value_c ^ subkeys[ 4 ] );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( output_data[ 4 ] ),
+	 value_d ^ subkeys[ 5 ] );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( output_data[ 8 ] ),
+	 value_a ^ subkeys[ 6 ] );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( output_data[ 12 ] ),
+	 value_b ^ subkeys[ 7 ] );
+}
+
+/* Decrypts a 16-byte block
+ */
+static void libluksde_twofish_decrypt_block(
+             const libluksde_twofish_context_t *context,
+             const uint8_t *input_data,
+             uint8_t *output_data )
+{
+	const uint32_t *subkeys = context->subkeys;
+	uint32_t value_a        = 0;
+	uint32_t value_b        = 0;
+	uint32_t value_c        = 0;
+	uint32_t value_d        = 0;
+	uint32_t value_t0       = 0;
+	uint32_t value_t1       = 0;
+	int round_index         = 0;
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( input_data[ 0 ] ),
+	 value_c );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( input_data[ 4 ] ),
+	 value_d );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( input_data[ 8 ] ),
+	 value_a );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( input_data[ 12 ] ),
+	 value_b );
+
+	value_c ^= subkeys[ 4 ];
+	value_d ^= subkeys[ 5 ];
+	value_a ^= subkeys[ 6 ];
+	value_b ^= subkeys[ 7 ];
+
+	for( round_index = 14;
+	     round_index >= 0;
+	     round_index -= 2 )
+	{
+		value_t0 = libluksde_twofish_g(
+		            context,
+		            value_c );
+
+		value_t1 = libluksde_twofish_g_rotated(
+		            context,
+		            value_d );
+
+		value_a  = libluksde_twofish_rotate_left(
+		            value_a,
+		            1 );
+		value_a ^= value_t0 + value_t1 + subkeys[ 10 + ( 2 * round_index ) ];
+
+		value_b ^= value_t0 + ( 2 * value_t1 ) + subkeys[ 11 + ( 2 * round_index ) ];
+		value_b  = libluksde_twofish_rotate_right(
+		            value_b,
+		            1 );
+
+		value_t0 = libluksde_twofish_g(
+		            context,
+		            value_a );
+
+		value_t1 = libluksde_twofish_g_rotated(
+		            context,
+		            value_b );
+
+		value_c  = libluksde_twofish_rotate_left(
+		            value_c,
+		            1 );
+		value_c ^= value_t0 + value_t1 + subkeys[ 8 + ( 2 * round_index ) ];
+
+		value_d ^= value_t0 + ( 2 * value_t1 ) + subkeys[ 9 + ( 2 * round_index ) ];
+		value_d  = libluksde_twofish_rotate_right(
+		            value_d,
+		            1 );
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 &( output_data[ 0 ] ),
+	 value_a ^ subkeys[ 0 ] );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( output_data[ 4 ] ),
+	 value_b ^ subkeys[ 1 ] );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( output_data[ 8 ] ),
+	 value_c ^ subkeys[ 2 ] );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( output_data[ 12 ] ),
+	 value_d ^ subkeys[ 3 ] );
+}
+
+/* Multiplies a XTS tweak value by alpha (x) in GF(2^128)
+ * The tweak value is stored as 2 64-bit values in little-endian byte order
+ */
+static inline void libluksde_twofish_xts_multiply_alpha(
+                    uint64_t *tweak_lower,
+                    uint64_t *tweak_upper )
+{
+	uint64_t carry = *tweak_upper >> 63;
+
+	*tweak_upper = ( *tweak_upper << 1 ) | ( *tweak_lower >> 63 );
+	*tweak_lower = ( *tweak_lower << 1 ) ^ ( carry * 0x87 );
+}
+
+#if defined( HAVE_LIBLUKSDE_AVX2_SUPPORT )
+
+/* Calculates the g function of 8 32-bit words using AVX2 gathers
+ * Returns the resulting 32-bit words
+ */
+LIBLUKSDE_TWOFISH_AVX2_TARGET
+static inline __m256i libluksde_twofish_avx2_g(
+                       const libluksde_twofish_context_t *context,
+                       __m256i value )
+{
+	__m256i byte_mask = _mm256_set1_epi32(
+	                     0xff );
+
+	__m256i result = _mm256_i32gather_epi32(
+	                  (const int *) context->s_boxes[ 0 ],
+	                  _mm256_and_si256(
+	                   value,
+	                   byte_mask ),
+	                  4 );
+
+	result = _mm256_xor_si256(
+	          result,
+	          _mm256_i32gather_epi32(
+	           (const int *) context->s_boxes[ 1 ],
+	           _mm256_and_si256(
+	            _mm256_srli_epi32(
+	             value,
+	             8 ),
+	            byte_mask ),
+	           4 ) );
+
+	result = _mm256_xor_si256(
+	          result,
+	          _mm256_i32gather_epi32(
+	           (const int *) context->s_boxes[ 2 ],
+	           _mm256_and_si256(
+	            _mm256_srli_epi32(
+	             value,
+	             16 ),
+	            byte_mask ),
+	           4 ) );
+
+	return( _mm256_xor_si256(
+	         result,
+	         _mm256_i32gather_epi32(
+	          (const int *) context->s_boxes[ 3 ],
+	          _mm256_srli_epi32(
+	           value,
+	           24 ),
+	          4 ) ) );
+}
+
+/* Calculates the g function of 8 32-bit words that are rotated left by 8 bits using AVX2 gathers
+ * Returns the resulting 32-bit words
+ */
+LIBLUKSDE_TWOFISH_AVX2_TARGET
+static inline __m256i libluksde_twofish_avx2_g_rotated(
+                       const libluksde_twofish_context_t *context,
+                       __m256i value )
+{
+	__m256i byte_mask = _mm256_set1_epi32(
+	                     0xff );
+
+	__m256i result = _mm256_i32gather_epi32(
+	                  (const int *) context->s_boxes[ 0 ],
+	                  _mm256_srli_epi32(
+	                   value,
+	                   24 ),
+	                  4 );
+
+	result = _mm256_xor_si256(
+	          result,
+	          _mm256_i32gather_epi32(
+	           (const int *) context->s_boxes[ 1 ],
+	           _mm256_and_si256(
+	            value,
+	            byte_mask ),
+	           4 ) );
+
+	result = _mm256_xor_si256(
+	          result,
+	          _mm256_i32gather_epi32(
+	           (const int *) context->s_boxes[ 2 ],
+	           _mm256_and_si256(
+	            _mm256_srli_epi32(
+	             value,
+	             8 ),
+	            byte_mask ),
+	           4 ) );
+
+	return( _mm256_xor_si256(
+	         result,
+	         _mm256_i32gather_epi32(
+	          (const int *) context->s_boxes[ 3 ],
+	          _mm256_and_si256(
+	           _mm256_srli_epi32(
+	            value,
+	            16 ),
+	           byte_mask ),
+	          4 ) ) );
+}
+
+/* Rotates 8 32-bit words left by 1 bit
+ * Returns the rotated words
+ */
+LIBLUKSDE_TWOFISH_AVX2_TARGET
+static inline __m256i libluksde_twofish_avx2_rotate_left_1(
+                       __m256i value )
+{
+	return( _mm256_or_si256(
+	         _mm256_slli_epi32(
+	          value,
+	          1 ),
+	         _mm256_srli_epi32(
+	          value,
+	          31 ) ) );
+}
+
+/* Rotates 8 32-bit words right by 1 bit
+ * Returns the rotated words
+ */
+LIBLUKSDE_TWOFISH_AVX2_TARGET
+static inline __m256i libluksde_twofish_avx2_rotate_right_1(
+                       __m256i value )
+{
+	return( _mm256_or_si256(
+	         _mm256_srli_epi32(
+	          value,
+	          1 ),
+	         _mm256_slli_epi32(
+	          value,
+	          31 ) ) );
+}
+
+/* Transposes 8 blocks between 4 vectors of 2 blocks and 4 vectors of the same 32-bit word of every block
+ * The transpose is its own inverse
+ */
+LIBLUKSDE_TWOFISH_AVX2_TARGET
+static inline void libluksde_twofish_avx2_transpose(
+                    __m256i *vectors )
+{
+	__m256i vector0 = _mm256_unpacklo_epi32(
+	                   vectors[ 0 ],
+	                   vectors[ 1 ] );
+
+	__m256i vector1 = _mm256_unpackhi_epi32(
+	                   vectors[ 0 ],
+	                   vectors[ 1 ] );
+
+	__m256i vector2 = _mm256_unpacklo_epi32(
+	                   vectors[ 2 ],
+	                   vectors[ 3 ] );
+
+	__m256i vector3 = _mm256_unpackhi_epi32(
+	                   vectors[ 2 ],
+	                   vectors[ 3 ] );
+
+	vectors[ 0 ] = _mm256_unpacklo_epi64(
+	                vector0,
+	                vector2 );
+
+	vectors[ 1 ] = _mm256_unpackhi_epi64(
+	                vector0,
+	                vector2 );
+
+	vectors[ 2 ] = _mm256_unpacklo_epi64(
+	                vector1,
+	                vector3 );
+
+	vectors[ 3 ] = _mm256_unpackhi_epi64(
+	                vector1,
+	                vector3 );
+}
+
+/* Encrypts 16 blocks in parallel as 2 interleaved sets of 8 blocks,
+ * where every vector contains the same 32-bit word of 8 blocks
+ */
+LIBLUKSDE_TWOFISH_AVX2_TARGET
+static inline void libluksde_twofish_avx2_encrypt_16_blocks(
+                    const libluksde_twofish_context_t *context,
+                    __m256i *words )
+{
+	__m256i value_a[ 2 ];
+	__m256i value_b[ 2 ];
+	__m256i value_c[ 2 ];
+	__m256i value_d[ 2 ];
+	__m256i value_t0[ 2 ];
+	__m256i value_t1[ 2 ];
+
+	const uint32_t *subkeys = context->subkeys;
+	int round_index         = 0;
+	int set_index           = 0;
+
+	for( set_index = 0;
+	     set_index < 2;
+	     set_index++ )
+	{
+		value_a[ set_index ] = _mm256_xor_si256(
+		                        words[ ( set_index * 4 ) ],
+		                        _mm256_set1_epi32(
+		                         (int) subkeys[ 0 ] ) );
+
+		value_b[ set_index ] = _mm256_xor_si256(
+		                        words[ ( set_index * 4 ) + 1 ],
+		                        _mm256_set1_epi32(
+		                         (int) subkeys[ 1 ] ) );
+
+		value_c[ set_index ] = _mm256_xor_si256(
+		                        words[ ( set_index * 4 ) + 2 ],
+		                        _mm256_set1_epi32(
+		                         (int) subkeys[ 2 ] ) );
+
+		value_d[ set_index ] = _mm256_xor_si256(
+		                        words[ ( set_index * 4 ) + 3 ],
+		                        _mm256_set1_epi32(
+		                         (int) subkeys[ 3 ] ) );
+	}
+	for( round_index = 0;
+	     round_index < 16;
+	     round_index += 2 )
+	{
+		for( set_index = 0;
+		     set_index < 2;
+		     set_index++ )
+		{
+			value_t0[ set_index ] = libluksde_twofish_avx2_g(
+			                         context,
+			                         value_a[ set_index ] );
+
+			value_t1[ set_index ] = libluksde_twofish_avx2_g_rotated(
+			                         context,
+			                         value_b[ set_index ] );
+		}
+		for( set_index = 0;
+		     set_index < 2;
+		     set_index++ )
+		{
+			value_c[ set_index ] = libluksde_twofish_avx2_rotate_right_1(
+			                        _mm256_xor_si256(
+			                         value_c[ set_index ],
+			                         _mm256_add_epi32(
+			                          _mm256_add_epi32(
+			                           value_t0[ set_index ],
+			                           value_t1[ set_index ] ),
+			                          _mm256_set1_epi32(
+			                           (int) subkeys[ 8 + ( 2 * round_index ) ] ) ) ) );
+
+			value_d[ set_index ] = _mm256_xor_si256(
+			                        libluksde_twofish_avx2_rotate_left_1(
+			                         value_d[ set_index ] ),
+			                        _mm256_add_epi32(
+			                         _mm256_add_epi32(
+			                          value_t0[ set_index ],
+			                          _mm256_add_epi32(
+			                           value_t1[ set_index ],
+			                           value_t1[ set_index ] ) ),
+			                         _mm256_set1_epi32(
+			                          (int) subkeys[ 9 + ( 2 * round_index ) ] ) ) );
+		}
+		for( set_index = 0;
+		     set_index < 2;
+		     set_index++ )
+		{
+			value_t0[ set_index ] = libluksde_twofish_avx2_g(
+			                         context,
+			                         value_c[ set_index ] );
+
+			value_t1[ set_index ] = libluksde_twofish_avx2_g_rotated(
+			                         context,
+			                         value_d[ set_index ] );
+		}
+		for( set_index = 0;
+		     set_index < 2;
+		     set_index++ )
+		{
+			value_a[ set_index ] = libluksde_twofish_avx2_rotate_right_1(
+			                        _mm256_xor_si256(
+			                         value_a[ set_index ],
+			                         _mm256_add_epi32(
+			                          _mm256_add_epi32(
+			                           value_t0[ set_index ],
+			                           value_t1[ set_index ] ),
+			                          _mm256_set1_epi32(
+			                           (int) subkeys[ 10 + ( 2 * round_index ) ] ) ) ) );
+
+			value_b[ set_index ] = _mm256_xor_si256(
+			                        libluksde_twofish_avx2_rotate_left_1(
+			                         value_b[ set_index ] ),
+			                        _mm256_add_epi32(
+			                         _mm256_add_epi32(
+			                          value_t0[ set_index ],
+			                          _mm256_add_epi32(
+			                           value_t1[ set_index ],
+			                           value_t1[ set_index ] ) ),
+			                         _mm256_set1_epi32(
+			                          (int) subkeys[ 11 + ( 2 * round_index ) ] ) ) );
+		}
+	}
+	for( set_index = 0;
+	     set_index < 2;
+	     set_index++ )
+	{
+		words[ ( set_index * 4 ) ] = _mm256_xor_si256(
+		                              value_c[ set_index ],
+		                              _mm256_set1_epi32(
+		                               (int) subkeys[ 4 ] ) );
+
+		words[ ( set_index * 4 ) + 1 ] = _mm256_xor_si256(
+		                                  value_d[ set_index ],
+		                                  _mm256_set1_epi32(
+		                                   (int) subkeys[ 5 ] ) );
+
+		words[ ( set_index * 4 ) + 2 ] = _mm256_xor_si256(
+		                                  value_a[ set_index ],
+		                                  _mm256_set1_epi32(
+		                                   (int) subkeys[ 6 ] ) );
+
+		words[ ( set_index * 4 ) + 3 ] = _mm256_xor_si256(
+		                                  value_b[ set_index ],
+		                                  _mm256_set1_epi32(
+		                                   (int) subkeys[ 7 ] ) );
+	}
+}
+
+/* Decrypts 16 blocks in parallel as 2 interleaved sets of 8 blocks,
+ * where every vector contains the same 32-bit word of 8 blocks
+ */
+LIBLUKSDE_TWOFISH_AVX2_TARGET
+static inline void libluksde_twofish_avx2_decrypt_16_blocks(
+                    const libluksde_twofish_context_t *context,
+                    __m256i *words )
+{
+	__m256i value_a[ 2 ];
+	__m256i value_b[ 2 ];
+	__m256i value_c[ 2 ];
+	__m256i value_d[ 2 ];
+	__m256i value_t0[ 2 ];
+	__m256i value_t1[ 2 ];
+
+	const uint32_t *subkeys = context->subkeys;
+	int round_index         = 0;
+	int set_index           = 0;
+
+	for( set_index = 0;
+	     set_index < 2;
+	     set_index++ )
+	{
+		value_c[ set_index ] = _mm256_xor_si256(
+		                        words[ ( set_index * 4 ) ],
+		                        _mm256_set1_epi32(
+		                         (int) subkeys[ 4 ] ) );
+
+		value_d[ set_index ] = _mm256_xor_si256(
+		                        words[ ( set_index * 4 ) + 1 ],
+		                        _mm256_set1_epi32(
+		                         (int) subkeys[ 5 ] ) );
+
+		value_a[ set_index ] = _mm256_xor_si256(
+		                        words[ ( set_index * 4 ) + 2 ],
+		                        _mm256_set1_epi32(
+		                         (int) subkeys[ 6 ] ) );
+
+		value_b[ set_index ] = _mm256_xor_si256(
+		                        words[ ( set_index * 4 ) + 3 ],
+		                        _mm256_set1_epi32(
+		                         (int) subkeys[ 7 ] ) );
+	}
+	for( round_index = 14;
+	     round_index >= 0;
+	     round_index -= 2 )
+	{
+		for( set_index = 0;
+		     set_index < 2;
+		     set_index++ )
+		{
+			value_t0[ set_index ] = libluksde_twofish_avx2_g(
+			                         context,
+			                         value_c[ set_index ] );
+
+			value_t1[ set_index ] = libluksde_twofish_avx2_g_rotated(
+			                         context,
+			                         value_d[ set_index ] );
+		}
+		for( set_index = 0;
+		     set_index < 2;
+		     set_index++ )
+		{
+			value_a[ set_index ] = _mm256_xor_si256(
+			                        libluksde_twofish_avx2_rotate_left_1(
+			                         value_a[ set_index ] ),
+			                        _mm256_add_epi32(
+			                         _mm256_add_epi32(
+			                          value_t0[ set_index ],
+			                          value_t1[ set_index ] ),
+			                         _mm256_set1_epi32(
+			                          (int) subkeys[ 10 + ( 2 * round_index ) ] ) ) );
+
+			value_b[ set_index ] = libluksde_twofish_avx2_rotate_right_1(
+			                        _mm256_xor_si256(
+			                         value_b[ set_index ],
+			                         _mm256_add_epi32(
+			                          _mm256_add_epi32(
+			                           value_t0[ set_index ],
+			                           _mm256_add_epi32(
+			                            value_t1[ set_index ],
+			                            value_t1[ set_index ] ) ),
+			                          _mm256_set1_epi32(
+			                           (int) subkeys[ 11 + ( 2 * round_index ) ] ) ) ) );
+		}
+		for( set_index = 0;
+		     set_index < 2;
+		     set_index++ )
+		{
+			value_t0[ set_index ] = libluksde_twofish_avx2_g(
+			                         context,
+			                         value_a[ set_index ] );
+
+			value_t1[ set_index ] = libluksde_twofish_avx2_g_rotated(
+			                         context,
+			                         value_b[ set_index ] );
+		}
+		for( set_index = 0;
+		     set_index < 2;
+		     set_index++ )
+		{
+			value_c[ set_index ] = _mm256_xor_si256(
+			                        libluksde_twofish_avx2_rotate_left_1(
+			                         value_c[ set_index ] ),
+			                        _mm256_add_epi32(
+			                         _mm256_add_epi32(
+			                          value_t0[ set_index ],
+			                          value_t1[ set_index ] ),
+			                         _mm256_set1_epi32(
+			                          (int) subkeys[ 8 + ( 2 * round_index ) ] ) ) );
+
+			value_d[ set_index ] = libluksde_twofish_avx2_rotate_right_1(
+			                        _mm256_xor_si256(
+			                         value_d[ set_index ],
+			                         _mm256_add_epi32(
+			                          _mm256_add_epi32(
+			                           value_t0[ set_index ],
+			                           _mm256_add_epi32(
+			                            value_t1[ set_index ],
+			                            value_t1[ set_index ] ) ),
+			                          _mm256_set1_epi32(
+			                           (int) subkeys[ 9 + ( 2 * round_index ) ] ) ) ) );
+		}
+	}
+	for( set_index = 0;
+	     set_index < 2;
+	     set_index++ )
+	{
+		words[ ( set_index * 4 ) ] = _mm256_xor_si256(
+		                              value_a[ set_index ],
+		                              _mm256_set1_epi32(
+		                               (int) subkeys[ 0 ] ) );
+
+		words[ ( set_index * 4 ) + 1 ] = _mm256_xor_si256(
+		                                  value_b[ set_index ],
+		                                  _mm256_set1_epi32(
+		                                   (int) subkeys[ 1 ] ) );
+
+		words[ ( set_index * 4 ) + 2 ] = _mm256_xor_si256(
+		                                  value_c[ set_index ],
+		                                  _mm256_set1_epi32(
+		                                   (int) subkeys[ 2 ] ) );
+
+		words[ ( set_index * 4 ) + 3 ] = _mm256_xor_si256(
+		                                  value_d[ set_index ],
+		                                  _mm256_set1_epi32(
+		                                   (int) subkeys[ 3 ] ) );
+	}
+}
+
+/* De- or encrypts 16 blocks in parallel
+ * The blocks are transposed into vectors of 32-bit words and back
+ */
+LIBLUKSDE_TWOFISH_AVX2_TARGET
+static inline void libluksde_twofish_avx2_crypt_16_blocks(
+                    const libluksde_twofish_context_t *context,
+                    int mode,
+                    __m256i *blocks )
+{
+	libluksde_twofish_avx2_transpose(
+	 &( blocks[ 0 ] ) );
+
+	libluksde_twofish_avx2_transpose(
+	 &( blocks[ 4 ] ) );
+
+	if( mode == LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT )
+	{
+		libluksde_twofish_avx2_encrypt_16_blocks(
+		 context,
+		 blocks );
+	}
+	else
+	{
+		libluksde_twofish_avx2_decrypt_16_blocks(
+		 context,
+		 blocks );
+	}
+	libluksde_twofish_avx2_transpose(
+	 &( blocks[ 0 ] ) );
+
+	libluksde_twofish_avx2_transpose(
+	 &( blocks[ 4 ] ) );
+}
+
+/* De- or encrypts blocks of data 16 blocks at a time using AVX2 in ECB mode
+ * Returns the number of bytes processed
+ */
+LIBLUKSDE_TWOFISH_AVX2_TARGET
+static size_t libluksde_twofish_avx2_crypt_ecb(
+               const libluksde_twofish_context_t *context,
+               int mode,
+               const uint8_t *input_data,
+               uint8_t *output_data,
+               size_t data_size )
+{
+	__m256i blocks[ 8 ];
+
+	size_t data_offset = 0;
+	int vector_index   = 0;
+
+	while( ( data_offset + 256 ) <= data_size )
+	{
+		for( vector_index = 0;
+		     vector_index < 8;
+		     vector_index++ )
+		{
+			blocks[ vector_index ] = _mm256_loadu_si256(
+			                          (__m256i *) &( input_data[ data_offset + ( vector_index * 32 ) ] ) );
+		}
+		libluksde_twofish_avx2_crypt_16_blocks(
+		 context,
+		 mode,
+		 blocks );
+
+		for( vector_index = 0;
+		     vector_index < 8;
+		     vector_index++ )
+		{
+			_mm256_storeu_si256(
+			 (__m256i *) &( output_data[ data_offset + ( vector_index * 32 ) ] ),
+			 blocks[ vector_index ] );
+		}
+		data_offset += 256;
+	}
+	return( data_offset );
+}
+
+/* Decrypts blocks of data 16 blocks at a time using AVX2 in CBC mode
+ * The previous block is updated to the last cipher text block that was processed
+ * Returns the number of bytes processed
+ */
+LIBLUKSDE_TWOFISH_AVX2_TARGET
+static size_t libluksde_twofish_avx2_decrypt_cbc(
+               const libluksde_twofish_context_t *context,
+               uint8_t *previous_block,
+               const uint8_t *input_data,
+               uint8_t *output_data,
+               size_t data_size )
+{
+	__m256i blocks[ 8 ];
+	__m256i previous_blocks[ 8 ];
+
+	__m128i previous    = _mm_loadu_si128(
+	                       (__m128i *) previous_block );
+	size_t data_offset  = 0;
+	int vector_index    = 0;
+
+	while( ( data_offset + 256 ) <= data_size )
+	{
+		/* Every cipher text block is combined with the cipher text block preceding it
+		 * so all of them are loaded before the output, which can overlap the input, is stored
+		 */
+		previous_blocks[ 0 ] = _mm256_inserti128_si256(
+		                        _mm256_castsi128_si256(
+		                         previous ),
+		                        _mm_loadu_si128(
+		                         (__m128i *) &( input_data[ data_offset ] ) ),
+		                        1 );
+
+		for( vector_index = 0;
+		     vector_index < 8;
+		     vector_index++ )
+		{
+			blocks[ vector_index ] = _mm256_loadu_si256(
+			                          (__m256i *) &( input_data[ data_offset + ( vector_index * 32 ) ] ) );
+
+			if( vector_index > 0 )
+			{
+				previous_blocks[ vector_index ] = _mm256_loadu_si256(
+				                                   (__m256i *) &( input_data[ data_offset + ( vector_index * 32 ) - 16 ] ) );
+			}
+		}
+		previous = _mm_loadu_si128(
+		            (__m128i *) &( input_data[ data_offset + 240 ] ) );
+
+		libluksde_twofish_avx2_crypt_16_blocks(
+		 context,
+		 LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+		 blocks );
+
+		for( vector_index = 0;
+		     vector_index < 8;
+		     vector_index++ )
+		{
+			_mm256_storeu_si256(
+			 (__m256i *) &( output_data[ data_offset + ( vector_index * 32 ) ] ),
+			 _mm256_xor_si256(
+			  blocks[ vector_index ],
+			  previous_blocks[ vector_index ] ) );
+		}
+		data_offset += 256;
+	}
+	_mm_storeu_si128(
+	 (__m128i *) previous_block,
+	 previous );
+
+	return( data_offset );
+}
+
+/* De- or encrypts blocks of data 16 blocks at a time using AVX2 in XTS mode
+ * The tweak value is updated to the tweak value of the first block that was not processed
+ * Returns the number of bytes processed
+ */
+LIBLUKSDE_TWOFISH_AVX2_TARGET
+static size_t libluksde_twofish_avx2_crypt_xts(
+               const libluksde_twofish_context_t *context,
+               int mode,
+               uint64_t *tweak_lower,
+               uint64_t *tweak_upper,
+               const uint8_t *input_data,
+               uint8_t *output_data,
+               size_t data_size )
+{
+	uint64_t tweak_values[ 32 ];
+	__m256i blocks[ 8 ];
+	__m256i tweaks[ 8 ];
+
+	size_t data_offset = 0;
+	int block_index    = 0;
+	int vector_index   = 0;
+
+	while( ( data_offset + 256 ) <= data_size )
+	{
+		for( block_index = 0;
+		     block_index < 16;
+		     block_index++ )
+		{
+			tweak_values[ block_index * 2 ]       = *tweak_lower;
+			tweak_values[ ( block_index * 2 ) + 1 ] = *tweak_upper;
+
+			libluksde_twofish_xts_multiply_alpha(
+			 tweak_lower,
+			 tweak_upper );
+		}
+		for( vector_index = 0;
+		     vector_index < 8;
+		     vector_index++ )
+		{
+			tweaks[ vector_index ] = _mm256_loadu_si256(
+			                          (__m256i *) &( tweak_values[ vector_index * 4 ] ) );
+
+			blocks[ vector_index ] = _mm256_xor_si256(
+			                          _mm256_loadu_si256(
+			                           (__m256i *) &( input_data[ data_offset + ( vector_index * 32 ) ] ) ),
+			                          tweaks[ vector_index ] );
+		}
+		libluksde_twofish_avx2_crypt_16_blocks(
+		 context,
+		 mode,
+		 blocks );
+
+		for( vector_index = 0;
+		     vector_index < 8;
+		     vector_index++ )
+		{
+			_mm256_storeu_si256(
+			 (__m256i *) &( output_data[ data_offset + ( vector_index * 32 ) ] ),
+			 _mm256_xor_si256(
+			  blocks[ vector_index ],
+			  tweaks[ vector_index ] ) );
+		}
+		data_offset += 256;
+	}
+	memory_set(
+	 tweak_values,
+	 0,
+	 sizeof( uint64_t ) * 32 );
+
+	return( data_offset );
+}
+
+#endif /* defined( HAVE_LIBLUKSDE_AVX2_SUPPORT ) */
+
+/* De- or encrypts one or more sectors of data in CBC mode
+ * Every sector has its own 16-byte initialization vector
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_twofish_crypt_cbc(
+     libluksde_twofish_context_t *context,
+     int mode,
+     uint8_t use_avx2,
+     const uint8_t *initialization_vectors,
+     size_t initialization_vectors_size,
+     size_t sector_size,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error )
+{
+	uint8_t block_data[ 16 ];
+	uint8_t cipher_text_block[ 16 ];
+	uint8_t previous_block[ 16 ];
+
+	static char *function    = "libluksde_twofish_crypt_cbc";
+	size_t data_offset       = 0;
+	size_t number_of_sectors = 0;
+	size_t sector_end_offset = 0;
+	size_t sector_index      = 0;
+	uint8_t byte_index       = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( mode != LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT )
+	 && ( mode != LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( initialization_vectors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid initialization vectors.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( sector_size == 0 )
+	 || ( sector_size > (size_t) SSIZE_MAX )
+	 || ( ( sector_size % 16 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid sector size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( input_data_size > (size_t) SSIZE_MAX )
+	 || ( ( input_data_size % sector_size ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid input data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_sectors = input_data_size / sector_size;
+
+	if( initialization_vectors_size < ( number_of_sectors * 16 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: initialization vectors size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output data.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data_size < input_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: output data size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	for( sector_index = 0;
+	     sector_index < number_of_sectors;
+	     sector_index++ )
+	{
+		if( memory_copy(
+		     previous_block,
+		     &( initialization_vectors[ sector_index * 16 ] ),
+		     16 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy initialization vector.",
+			 function );
+
+			return( -1 );
+		}
+		sector_end_offset = data_offset + sector_size;
+
+		if( mode == LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT )
+		{
+			/* CBC encryption depends on the previous cipher text block
+			 * and cannot be parallelized
+			 */
+			while( data_offset < sector_end_offset )
+			{
+				for( byte_index = 0;
+				     byte_index < 16;
+				     byte_index++ )
+				{
+					block_data[ byte_index ] = input_data[ data_offset + byte_index ] ^ previous_block[ byte_index ];
+				}
+				libluksde_twofish_encrypt_block(
+				 context,
+				 block_data,
+				 previous_block );
+
+				memory_copy(
+				 &( output_data[ data_offset ] ),
+				 previous_block,
+				 16 );
+
+				data_offset += 16;
+			}
+		}
+		else
+		{
+#if defined( HAVE_LIBLUKSDE_AVX2_SUPPORT )
+			if( use_avx2 != 0 )
+			{
+				data_offset += libluksde_twofish_avx2_decrypt_cbc(
+				                context,
+				                previous_block,
+				                &( input_data[ data_offset ] ),
+				                &( output_data[ data_offset ] ),
+				                sector_size );
+			}
+#endif
+			while( data_offset < sector_end_offset )
+			{
+				/* The cipher text block is copied since the output can overlap the input
+				 */
+				memory_copy(
+				 cipher_text_block,
+				 &( input_data[ data_offset ] ),
+				 16 );
+
+				libluksde_twofish_decrypt_block(
+				 context,
+				 cipher_text_block,
+				 &( output_data[ data_offset ] ) );
+
+				for( byte_index = 0;
+				     byte_index < 16;
+				     byte_index++ )
+				{
+					output_data[ data_offset + byte_index ] ^= previous_block[ byte_index ];
+				}
+				memory_copy(
+				 previous_block,
+				 cipher_text_block,
+				 16 );
+
+				data_offset += 16;
+			}
+		}
+	}
+	memory_set(
+	 block_data,
+	 0,
+	 16 );
+
+	return( 1 );
+}
+
+/* De- or encrypts data in ECB mode
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_twofish_crypt_ecb(
+     libluksde_twofish_context_t *context,
+     int mode,
+     uint8_t use_avx2,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_twofish_crypt_ecb";
+	size_t data_offset    = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( mode != LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT )
+	 && ( mode != LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( input_data_size > (size_t) SSIZE_MAX )
+	 || ( ( input_data_size % 16 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid input data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output data.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data_size < input_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: output data size value too small.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBLUKSDE_AVX2_SUPPORT )
+	if( use_avx2 != 0 )
+	{
+		data_offset = libluksde_twofish_avx2_crypt_ecb(
+		               context,
+		               mode,
+		               input_data,
+		               output_data,
+		               input_data_size );
+	}
+#endif
+	while( data_offset < input_data_size )
+	{
+		if( mode == LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT )
+		{
+			libluksde_twofish_encrypt_block(
+			 context,
+			 &( input_data[ data_offset ] ),
+			 &( output_data[ data_offset ] ) );
+		}
+		else
+		{
+			libluksde_twofish_decrypt_block(
+			 context,
+			 &( input_data[ data_offset ] ),
+			 &( output_data[ data_offset ] ) );
+		}
+		data_offset += 16;
+	}
+	return( 1 );
+}
+
+/* De- or encrypts one or more sectors of data in XTS mode
+ * Every sector has its own 16-byte tweak value, which is encrypted with the tweak context
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_twofish_crypt_xts(
+     libluksde_twofish_context_t *context,
+     libluksde_twofish_context_t *tweak_context,
+     int mode,
+     uint8_t use_avx2,
+     const uint8_t *tweak_values,
+     size_t tweak_values_size,
+     size_t sector_size,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error )
+{
+	uint8_t block_data[ 16 ];
+	uint8_t encrypted_tweak_value[ 16 ];
+
+	static char *function    = "libluksde_twofish_crypt_xts";
+	size_t data_offset       = 0;
+	size_t number_of_sectors = 0;
+	size_t sector_end_offset = 0;
+	size_t sector_index      = 0;
+	uint64_t tweak_lower     = 0;
+	uint64_t tweak_upper     = 0;
+	uint8_t byte_index       = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( tweak_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tweak context.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( mode != LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT )
+	 && ( mode != LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( tweak_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tweak values.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( sector_size == 0 )
+	 || ( sector_size > (size_t) SSIZE_MAX )
+	 || ( ( sector_size % 16 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid sector size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( input_data_size > (size_t) SSIZE_MAX )
+	 || ( ( input_data_size % sector_size ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid input data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_sectors = input_data_size / sector_size;
+
+	if( tweak_values_size < ( number_of_sectors * 16 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: tweak values size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output data.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data_size < input_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: output data size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	for( sector_index = 0;
+	     sector_index < number_of_sectors;
+	     sector_index++ )
+	{
+		libluksde_twofish_encrypt_block(
+		 tweak_context,
+		 &( tweak_values[ sector_index * 16 ] ),
+		 encrypted_tweak_value );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 &( encrypted_tweak_value[ 0 ] ),
+		 tweak_lower );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 &( encrypted_tweak_value[ 8 ] ),
+		 tweak_upper );
+
+		sector_end_offset = data_offset + sector_size;
+
+#if defined( HAVE_LIBLUKSDE_AVX2_SUPPORT )
+		if( use_avx2 != 0 )
+		{
+			data_offset += libluksde_twofish_avx2_crypt_xts(
+			                context,
+			                mode,
+			                &tweak_lower,
+			                &tweak_upper,
+			                &( input_data[ data_offset ] ),
+			                &( output_data[ data_offset ] ),
+			                sector_size );
+		}
+#endif
+		while( data_offset < sector_end_offset )
+		{
+			byte_stream_copy_from_uint64_little_endian(
+			 &( encrypted_tweak_value[ 0 ] ),
+			 tweak_lower );
+
+			byte_stream_copy_from_uint64_little_endian(
+			 &( encrypted_tweak_value[ 8 ] ),
+			 tweak_upper );
+
+			for( byte_index = 0;
+			     byte_index < 16;
+			     byte_index++ )
+			{
+				block_data[ byte_index ] = input_data[ data_offset + byte_index ] ^ encrypted_tweak_value[ byte_index ];
+			}
+			if( mode == LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT )
+			{
+				libluksde_twofish_encrypt_block(
+				 context,
+				 block_data,
+				 &( output_data[ data_offset ] ) );
+			}
+			else
+			{
+				libluksde_twofish_decrypt_block(
+				 context,
+				 block_data,
+				 &( output_data[ data_offset ] ) );
+			}
+			for( byte_index = 0;
+			     byte_index < 16;
+			     byte_index++ )
+			{
+				output_data[ data_offset + byte_index ] ^= encrypted_tweak_value[ byte_index ];
+			}
+			libluksde_twofish_xts_multiply_alpha(
+			 &tweak_lower,
+			 &tweak_upper );
+
+			data_offset += 16;
+		}
+	}
+	memory_set(
+	 encrypted_tweak_value,
+	 0,
+	 16 );
+
+	memory_set(
+	 block_data,
+	 0,
+	 16 );
+
+	return( 1 );
+}
+
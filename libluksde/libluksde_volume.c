@@ -29,9 +29,13 @@
 #include "libluksde_debug.h"
 #include "libluksde_definitions.h"
 #include "libluksde_diffuser.h"
+#include "libluksde_encryption.h"
+#include "libluksde_hash.h"
 #include "libluksde_io_handle.h"
 #include "libluksde_key_slot.h"
+#include "libluksde_key_slot_trial.h"
 #include "libluksde_libbfio.h"
+#include "libluksde_libcdata.h"
 #include "libluksde_libcerror.h"
 #include "libluksde_libcnotify.h"
 #include "libluksde_libcthreads.h"
@@ -39,7 +43,10 @@
 #include "libluksde_libfdata.h"
 #include "libluksde_libuna.h"
 #include "libluksde_password.h"
+#include "libluksde_progress.h"
+#include "libluksde_readahead.h"
 #include "libluksde_sector_data.h"
+#include "libluksde_sector_data_pool.h"
 #include "libluksde_volume.h"
 
 /* Creates a volume
@@ -134,7 +141,11 @@ int libluksde_volume_initialize(
 		goto on_error;
 	}
 #endif
-	internal_volume->is_locked = 1;
+	internal_volume->chunk_size                         = LIBLUKSDE_DEFAULT_CHUNK_SIZE;
+	internal_volume->number_of_cache_entries            = LIBLUKSDE_DEFAULT_NUMBER_OF_CACHE_ENTRIES_CHUNKS;
+	internal_volume->minimum_number_of_readahead_chunks = LIBLUKSDE_DEFAULT_MINIMUM_NUMBER_OF_READAHEAD_CHUNKS;
+	internal_volume->maximum_number_of_readahead_chunks = LIBLUKSDE_DEFAULT_MAXIMUM_NUMBER_OF_READAHEAD_CHUNKS;
+	internal_volume->is_locked                          = 1;
 
 	*volume = (libluksde_volume_t *) internal_volume;
 
@@ -269,6 +280,10 @@ int libluksde_volume_signal_abort(
 	}
 	internal_volume->io_handle->abort = 1;
 
+	libluksde_progress_set_abort(
+	 &( internal_volume->io_handle->key_slots_abort ),
+	 1 );
+
 	return( 1 );
 }
 
@@ -923,6 +938,22 @@ int libluksde_volume_close(
 
 		return( -1 );
 	}
+	/* The readahead is freed first since its worker thread uses the IO handle
+	 */
+	if( libluksde_readahead_free(
+	     &( internal_volume->readahead ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free readahead.",
+		 function );
+
+		result = -1;
+	}
+	internal_volume->readahead_is_unavailable = 0;
 #endif
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
@@ -995,27 +1026,43 @@ int libluksde_volume_close(
 		result = -1;
 	}
 	if( libfdata_vector_free(
-	     &( internal_volume->sectors_vector ),
+	     &( internal_volume->chunks_vector ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free sectors vector.",
+		 "%s: unable to free chunks vector.",
 		 function );
 
 		result = -1;
 	}
 	if( libfcache_cache_free(
-	     &( internal_volume->sectors_cache ),
+	     &( internal_volume->chunks_cache ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free chunks cache.",
+		 function );
+
+		result = -1;
+	}
+	/* The sector data pool is freed after the chunks cache since the cached
+	 * sector data is released to the pool
+	 */
+	if( libluksde_sector_data_pool_free(
+	     &( internal_volume->io_handle->sector_data_pool ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free sectors cache.",
+		 "%s: unable to free sector data pool.",
 		 function );
 
 		result = -1;
@@ -1060,19 +1107,13 @@ int libluksde_volume_open_read(
      libcerror_error_t **error )
 {
 	uint8_t master_key_validation_hash[ 20 ];
-	uint8_t user_key[ 32 ];
-
-	libluksde_key_slot_t *key_slot  = NULL;
-	uint8_t *key_material_data      = NULL;
-	uint8_t *split_master_key_data  = NULL;
-	static char *function           = "libluksde_volume_open_read";
-	size_t key_material_data_offset = 0;
-	size_t key_material_size        = 0;
-	ssize_t read_count              = 0;
-	uint64_t key_material_block_key = 0;
-	int element_index               = 0;
-	int key_slot_index              = 0;
-	int result                      = 0;
+
+	static char *function        = "libluksde_volume_open_read";
+	size_t block_size            = 0;
+	int candidate_password_index = 0;
+	int element_index            = 0;
+	int key_slot_index           = 0;
+	int result                   = 0;
 
 	if( internal_volume == NULL )
 	{
@@ -1107,24 +1148,35 @@ int libluksde_volume_open_read(
 
 		return( -1 );
 	}
-	if( internal_volume->sectors_vector != NULL )
+	if( internal_volume->chunks_vector != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - chunks vector already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->chunks_cache != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid volume - sectors vector already set.",
+		 "%s: invalid volume - chunks cache already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_volume->sectors_cache != NULL )
+	if( internal_volume->io_handle->sector_data_pool != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid volume - sectors cache already set.",
+		 "%s: invalid volume - invalid IO handle - sector data pool already set.",
 		 function );
 
 		return( -1 );
@@ -1201,12 +1253,47 @@ int libluksde_volume_open_read(
 
 		goto on_error;
 	}
+	/* The encryption context falls back to the built-in implementation
+	 * if the provider does not support the encryption method
+	 */
+	if( libluksde_encryption_set_provider(
+	     internal_volume->io_handle->encryption_context,
+	     internal_volume->io_handle->encryption_provider,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set provider in encryption context.",
+		 function );
+
+		goto on_error;
+	}
+	if( internal_volume->io_handle->number_of_essiv_cache_entries > 0 )
+	{
+		if( libluksde_encryption_set_essiv_cache_size(
+		     internal_volume->io_handle->encryption_context,
+		     (size_t) internal_volume->io_handle->number_of_essiv_cache_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set ESSIV initialization vector cache size in encryption context.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( internal_volume->io_handle->keys_are_set != 0 )
 	{
 		if( libluksde_password_pbkdf2(
 		     internal_volume->io_handle->master_key,
 		     internal_volume->io_handle->master_key_size,
 		     internal_volume->io_handle->hashing_method,
+		     LIBLUKSDE_HASH_BACKEND_DEFAULT,
 		     internal_volume->io_handle->master_key_salt,
 		     32,
 		     internal_volume->io_handle->master_key_number_of_iterations,
@@ -1246,342 +1333,56 @@ int libluksde_volume_open_read(
 	if( ( result == 0 )
 	 && ( internal_volume->io_handle->user_password_is_set != 0 ) )
 	{
-		for( key_slot_index = 0;
-		     key_slot_index < 8;
-		     key_slot_index++ )
-		{
-			if( libcdata_array_get_entry_by_index(
-			     internal_volume->io_handle->key_slots_array,
-			     key_slot_index,
-			     (intptr_t **) &key_slot,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve key slot: %d.",
-				 function,
-				 key_slot_index );
-
-				goto on_error;
-			}
-			if( key_slot == NULL )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-				 "%s: missing key slot: %d.",
-				 function,
-				 key_slot_index );
-
-				goto on_error;
-			}
-			if( key_slot->state != 0x00ac71f3 )
-			{
-				continue;
-			}
-			if( internal_volume->io_handle->user_password_is_set != 0 )
-			{
-				if( libluksde_password_pbkdf2(
-				     internal_volume->io_handle->user_password,
-				     internal_volume->io_handle->user_password_size - 1,
-				     internal_volume->io_handle->hashing_method,
-				     key_slot->salt,
-				     32,
-				     key_slot->number_of_iterations,
-				     user_key,
-				     internal_volume->io_handle->master_key_size,
-				     error) == -1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-					 "%s: unable to determine user key.",
-					 function );
-
-					goto on_error;
-				}
-				key_slot->key_material_offset *= internal_volume->io_handle->bytes_per_sector;
-
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: reading key material at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
-					 function,
-					 key_slot->key_material_offset,
-					 key_slot->key_material_offset );
-				}
-#endif
-				if( libbfio_handle_seek_offset(
-				     file_io_handle,
-				     key_slot->key_material_offset,
-				     SEEK_SET,
-				     error ) == -1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_SEEK_FAILED,
-					 "%s: unable to seek key material offset: %" PRIi64 ".",
-					 function,
-					 key_slot->key_material_offset );
-
-					goto on_error;
-				}
-/* TODO add bounds check */
-				key_material_size = internal_volume->io_handle->master_key_size
-						  * key_slot->number_of_stripes;
-
-				key_material_data = (uint8_t *) memory_allocate(
-				                                 sizeof( uint8_t ) * key_material_size );
-
-				if( key_material_data == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-					 "%s: unable to create key material data.",
-					 function );
-
-					goto on_error;
-				}
-				read_count = libbfio_handle_read_buffer(
-					      file_io_handle,
-					      key_material_data,
-					      key_material_size,
-					      error );
-
-				if( read_count != (ssize_t) key_material_size )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read key material data.",
-					 function );
-
-					goto on_error;
-				}
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: key material data:\n",
-					 function );
-					libcnotify_print_data(
-					 key_material_data,
-					 key_material_size,
-					 LIBCNOTIFY_PRINT_DATA_FLAG_GROUP_DATA );
-				}
-#endif
-				split_master_key_data = (uint8_t *) memory_allocate(
-				                                     sizeof( uint8_t ) * key_material_size );
-
-				if( split_master_key_data == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-					 "%s: unable to create split master key data.",
-					 function );
-
-					goto on_error;
-				}
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: user key:\n",
-					 function );
-					libcnotify_print_data(
-					 user_key,
-					 32,
-					 0 );
-				}
-#endif
-				if( libluksde_encryption_set_keys(
-				     internal_volume->io_handle->encryption_context,
-				     user_key,
-				     internal_volume->io_handle->master_key_size,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-					 "%s: unable to set key in encryption context.",
-					 function );
-
-					goto on_error;
-				}
-				if( memory_set(
-				     user_key,
-				     0,
-				     32  ) == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_MEMORY,
-					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-					 "%s: unable to clear user key.",
-					 function );
-
-					goto on_error;
-				}
-				key_material_block_key = 0;
-
-				while( key_material_data_offset < key_material_size )
-				{
-					/* The data needs to be decrypted sector-by-sector
-					 */
-					if( libluksde_encryption_crypt(
-					     internal_volume->io_handle->encryption_context,
-					     LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
-					     &( key_material_data[ key_material_data_offset ] ),
-					     internal_volume->io_handle->bytes_per_sector,
-					     &( split_master_key_data[ key_material_data_offset ] ),
-					     internal_volume->io_handle->bytes_per_sector,
-					     key_material_block_key,
-					     error ) != 1 )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
-						 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
-						 "%s: unable to decrypt key material data.",
-						 function );
-
-						goto on_error;
-					}
-					key_material_data_offset += internal_volume->io_handle->bytes_per_sector;
-					key_material_block_key   += 1;
-				}
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: split master key data:\n",
-					 function );
-					libcnotify_print_data(
-					 split_master_key_data,
-					 key_material_size,
-					 LIBCNOTIFY_PRINT_DATA_FLAG_GROUP_DATA );
-				}
-#endif
-				memory_free(
-				 key_material_data );
-
-				key_material_data = NULL;
-
-				if( libluksde_diffuser_merge(
-				     split_master_key_data,
-				     key_material_size,
-				     internal_volume->io_handle->master_key,
-				     internal_volume->io_handle->master_key_size,
-				     key_slot->number_of_stripes,
-				     internal_volume->io_handle->hashing_method,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_GENERIC,
-					 "%s: unable to merge split master key.",
-					 function );
-
-					goto on_error;
-				}
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: master key data:\n",
-					 function );
-					libcnotify_print_data(
-					 internal_volume->io_handle->master_key,
-					 internal_volume->io_handle->master_key_size,
-					 0 );
-				}
-#endif
-				if( memory_set(
-				     split_master_key_data,
-				     0,
-				     key_material_size  ) == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_MEMORY,
-					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-					 "%s: unable to clear split master key data.",
-					 function );
-
-					goto on_error;
-				}
-				memory_free(
-				 split_master_key_data );
+		result = libluksde_internal_volume_try_key_slots(
+		          internal_volume,
+		          file_io_handle,
+		          &key_slot_index,
+		          error );
 
-				split_master_key_data = NULL;
-
-				if( libluksde_password_pbkdf2(
-				     internal_volume->io_handle->master_key,
-				     internal_volume->io_handle->master_key_size,
-				     internal_volume->io_handle->hashing_method,
-				     internal_volume->io_handle->master_key_salt,
-				     32,
-				     internal_volume->io_handle->master_key_number_of_iterations,
-				     master_key_validation_hash,
-				     20,
-				     error) == -1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-					 "%s: unable to determine master key validation hash.",
-					 function );
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to try key slots.",
+			 function );
 
-					goto on_error;
-				}
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: master key validation hash data:\n",
-					 function );
-					libcnotify_print_data(
-					 master_key_validation_hash,
-					 20,
-					 0 );
-				}
-#endif
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: check:\n",
-					 function );
-					libcnotify_print_data(
-					 internal_volume->io_handle->master_key_validation_hash,
-					 20,
-					 0 );
-				}
-#endif
-				if( memory_compare(
-				     master_key_validation_hash,
-				     internal_volume->io_handle->master_key_validation_hash,
-				     20 ) == 0 )
-				{
-					result = 1;
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			internal_volume->io_handle->unlocked_key_slot_index = key_slot_index;
+		}
+	}
+	if( ( result == 0 )
+	 && ( internal_volume->io_handle->number_of_candidate_passwords > 0 ) )
+	{
+		result = libluksde_internal_volume_test_passwords(
+		          internal_volume,
+		          file_io_handle,
+		          (const uint8_t **) internal_volume->io_handle->candidate_passwords,
+		          internal_volume->io_handle->candidate_password_sizes,
+		          internal_volume->io_handle->number_of_candidate_passwords,
+		          &candidate_password_index,
+		          &key_slot_index,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to test candidate passwords.",
+			 function );
 
-					break;
-				}
-			}
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			internal_volume->io_handle->unlocked_candidate_password_index = candidate_password_index;
+			internal_volume->io_handle->unlocked_key_slot_index           = key_slot_index;
 		}
 	}
 	if( result != 0 )
@@ -1603,12 +1404,12 @@ int libluksde_volume_open_read(
 		}
 /* TODO clone function ? */
 		if( libfdata_vector_initialize(
-		     &( internal_volume->sectors_vector ),
-		     (size64_t) internal_volume->io_handle->bytes_per_sector,
+		     &( internal_volume->chunks_vector ),
+		     (size64_t) internal_volume->chunk_size,
 		     (intptr_t *) internal_volume->io_handle,
 		     NULL,
 		     NULL,
-		     (int (*)(intptr_t *, intptr_t *, libfdata_vector_t *, libfcache_cache_t *, int, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &libluksde_io_handle_read_sector,
+		     (int (*)(intptr_t *, intptr_t *, libfdata_vector_t *, libfcache_cache_t *, int, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &libluksde_io_handle_read_chunk,
 		     NULL,
 		     LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
 		     error ) != 1 )
@@ -1617,17 +1418,17 @@ int libluksde_volume_open_read(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create sectors vector.",
+			 "%s: unable to create chunks vector.",
 			 function );
 
 			goto on_error;
 		}
 		if( libfdata_vector_append_segment(
-		     internal_volume->sectors_vector,
+		     internal_volume->chunks_vector,
 		     &element_index,
 		     0,
 		     internal_volume->io_handle->encrypted_volume_offset,
-		     internal_volume->io_handle->volume_size,
+		     internal_volume->io_handle->encrypted_volume_size,
 		     0,
 		     error ) != 1 )
 		{
@@ -1635,21 +1436,49 @@ int libluksde_volume_open_read(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to append segment to sectors vector.",
+			 "%s: unable to append segment to chunks vector.",
 			 function );
 
 			goto on_error;
 		}
 		if( libfcache_cache_initialize(
-		     &( internal_volume->sectors_cache ),
-		     LIBLUKSDE_MAXIMUM_CACHE_ENTRIES_SECTORS,
+		     &( internal_volume->chunks_cache ),
+		     internal_volume->number_of_cache_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create chunks cache.",
+			 function );
+
+			goto on_error;
+		}
+		if( libluksde_sector_data_get_block_size(
+		     internal_volume->chunk_size,
+		     &block_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine sector data block size.",
+			 function );
+
+			goto on_error;
+		}
+		if( libluksde_sector_data_pool_initialize(
+		     &( internal_volume->io_handle->sector_data_pool ),
+		     block_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create sectors cache.",
+			 "%s: unable to create sector data pool.",
 			 function );
 
 			goto on_error;
@@ -1674,38 +1503,24 @@ int libluksde_volume_open_read(
 	return( result );
 
 on_error:
-	if( internal_volume->sectors_cache != NULL )
+	if( internal_volume->chunks_cache != NULL )
 	{
 		libfcache_cache_free(
-		 &( internal_volume->sectors_cache ),
+		 &( internal_volume->chunks_cache ),
 		 NULL );
 	}
-	if( internal_volume->sectors_vector != NULL )
+	if( internal_volume->chunks_vector != NULL )
 	{
 		libfdata_vector_free(
-		 &( internal_volume->sectors_vector ),
+		 &( internal_volume->chunks_vector ),
 		 NULL );
 	}
-	if( split_master_key_data != NULL )
-	{
-		memory_set(
-		 split_master_key_data,
-		 0,
-		 key_material_size );
-
-		memory_free(
-		 split_master_key_data );
-	}
-	if( key_material_data != NULL )
+	if( internal_volume->io_handle->sector_data_pool != NULL )
 	{
-		memory_free(
-		 key_material_data );
+		libluksde_sector_data_pool_free(
+		 &( internal_volume->io_handle->sector_data_pool ),
+		 NULL );
 	}
-	memory_set(
-	 user_key,
-	 0,
-	 32 );
-
 #if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
 	libcthreads_read_write_lock_release_for_write(
 	 internal_volume->read_write_lock,
@@ -1714,18 +1529,21 @@ on_error:
 	return( -1 );
 }
 
-/* Determines if the volume is locked
- * Returns 1 if locked, 0 if not or -1 on error
+/* Determines the size of the key material of a key slot
+ * The key material is stored in whole sectors
+ * Returns 1 if successful or -1 on error
  */
-int libluksde_volume_is_locked(
-     libluksde_volume_t *volume,
+int libluksde_internal_volume_get_key_material_size(
+     libluksde_internal_volume_t *internal_volume,
+     libluksde_key_slot_t *key_slot,
+     size_t *key_material_size,
      libcerror_error_t **error )
 {
-	libluksde_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libluksde_volume_is_locked";
-	uint8_t is_locked                            = 0;
+	static char *function   = "libluksde_internal_volume_get_key_material_size";
+	size_t bytes_per_sector = 0;
+	size_t master_key_size  = 0;
 
-	if( volume == NULL )
+	if( internal_volume == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -1736,240 +1554,269 @@ int libluksde_volume_is_locked(
 
 		return( -1 );
 	}
-	internal_volume = (libluksde_internal_volume_t *) volume;
-
-#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	if( internal_volume->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	is_locked = internal_volume->is_locked;
-
-#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	if( key_slot == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key slot.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	return( is_locked );
-}
-
-/* Reads (volume) data from the last current into a buffer using a Basic File IO (bfio) handle
- * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes read or -1 on error
- */
-ssize_t libluksde_internal_volume_read_buffer_from_file_io_handle(
-         libluksde_internal_volume_t *internal_volume,
-         libbfio_handle_t *file_io_handle,
-         void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
-{
-	libluksde_sector_data_t *sector_data = NULL;
-	static char *function                = "libluksde_internal_volume_read_buffer_from_file_io_handle";
-	off64_t element_data_offset          = 0;
-	size_t buffer_offset                 = 0;
-	size_t read_size                     = 0;
-	size_t sector_data_offset            = 0;
-	ssize_t total_read_count             = 0;
-
-	if( internal_volume == NULL )
+	if( key_material_size == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid volume.",
+		 "%s: invalid key material size.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_volume->io_handle == NULL )
+	bytes_per_sector = (size_t) internal_volume->io_handle->bytes_per_sector;
+	master_key_size  = internal_volume->io_handle->master_key_size;
+
+	if( ( bytes_per_sector == 0 )
+	 || ( bytes_per_sector > LIBLUKSDE_MAXIMUM_KEY_MATERIAL_SIZE ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid volume - invalid IO handle - bytes per sector value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_volume->sectors_vector == NULL )
+	if( ( master_key_size == 0 )
+	 || ( master_key_size > 64 ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing sectors vector.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid volume - invalid IO handle - master key size value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_volume->sectors_cache == NULL )
+	if( ( key_slot->number_of_stripes == 0 )
+	 || ( (size_t) key_slot->number_of_stripes > ( LIBLUKSDE_MAXIMUM_KEY_MATERIAL_SIZE / master_key_size ) ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing sectors cache.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid key slot - number of stripes value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_volume->current_offset < 0 )
+	*key_material_size = master_key_size * key_slot->number_of_stripes;
+
+	if( ( *key_material_size % bytes_per_sector ) != 0 )
+	{
+		*key_material_size += bytes_per_sector - ( *key_material_size % bytes_per_sector );
+	}
+	return( 1 );
+}
+
+/* Reads the (encrypted) key material of a key slot
+ * The key material is read from the file IO handle if it is not in the key material area
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_internal_volume_read_key_material(
+     libluksde_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     libluksde_key_slot_t *key_slot,
+     uint8_t *key_material_data,
+     size_t key_material_size,
+     libcerror_error_t **error )
+{
+	static char *function       = "libluksde_internal_volume_read_key_material";
+	size_t area_offset          = 0;
+	ssize_t read_count          = 0;
+	off64_t key_material_offset = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid volume - current offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer == NULL )
+	if( key_slot == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
+		 "%s: invalid key slot.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer_size > (size_t) SSIZE_MAX )
+	if( key_material_data == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid buffer size value exceeds maximum.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key material data.",
 		 function );
 
 		return( -1 );
 	}
-	if( (size64_t) internal_volume->current_offset >= internal_volume->io_handle->encrypted_volume_size )
-	{
-		return( 0 );
-	}
-	if( (size64_t) ( internal_volume->current_offset + buffer_size ) >= internal_volume->io_handle->encrypted_volume_size )
+	if( key_material_size > (size_t) SSIZE_MAX )
 	{
-		buffer_size = (size_t) ( internal_volume->io_handle->encrypted_volume_size - internal_volume->current_offset );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid key material size value exceeds maximum.",
+		 function );
+
+		return( -1 );
 	}
-	sector_data_offset = (size_t) ( internal_volume->current_offset % internal_volume->io_handle->bytes_per_sector );
+	/* The key material offset is stored in sectors
+	 */
+	key_material_offset = key_slot->key_material_offset * internal_volume->io_handle->bytes_per_sector;
 
-	while( buffer_size > 0 )
+	/* The key material is copied from the key material area if it was read at open
+	 */
+	if( ( internal_volume->io_handle->key_material_area_data != NULL )
+	 && ( key_material_offset >= internal_volume->io_handle->key_material_area_offset ) )
 	{
-		if( libfdata_vector_get_element_value_at_offset(
-		     internal_volume->sectors_vector,
-		     (intptr_t *) file_io_handle,
-		     internal_volume->sectors_cache,
-		     internal_volume->current_offset,
-		     &element_data_offset,
-		     (intptr_t **) &sector_data,
-		     0,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve sector data at offset: %" PRIi64 ".",
-			 function,
-			 internal_volume->current_offset );
+		area_offset = (size_t) ( key_material_offset - internal_volume->io_handle->key_material_area_offset );
 
-			return( -1 );
-		}
-		if( sector_data == NULL )
+		if( ( area_offset <= internal_volume->io_handle->key_material_area_size )
+		 && ( key_material_size <= ( internal_volume->io_handle->key_material_area_size - area_offset ) ) )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing sector data at offset: %" PRIi64 ".",
-			 function,
-			 internal_volume->current_offset );
-
-			return( -1 );
-		}
-		read_size = sector_data->data_size - sector_data_offset;
+			if( memory_copy(
+			     key_material_data,
+			     &( internal_volume->io_handle->key_material_area_data[ area_offset ] ),
+			     key_material_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy key material data from key material area.",
+				 function );
 
-		if( read_size > buffer_size )
-		{
-			read_size = buffer_size;
-		}
-		if( read_size == 0 )
-		{
-			break;
+				return( -1 );
+			}
+			return( 1 );
 		}
-		if( memory_copy(
-		     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
-		     &( ( sector_data->data )[ sector_data_offset ] ),
-		     read_size ) == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy sector data to buffer.",
-			 function );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: reading key material at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+		 function,
+		 key_material_offset,
+		 key_material_offset );
+	}
+#endif
+	if( libbfio_handle_seek_offset(
+	     file_io_handle,
+	     key_material_offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek key material offset: %" PRIi64 ".",
+		 function,
+		 key_material_offset );
 
-			return( -1 );
-		}
-		buffer_offset     += read_size;
-		buffer_size       -= read_size;
-		total_read_count  += (ssize_t) read_size;
-		sector_data_offset = 0;
+		return( -1 );
+	}
+	read_count = libbfio_handle_read_buffer(
+	              file_io_handle,
+	              key_material_data,
+	              key_material_size,
+	              error );
 
-		internal_volume->current_offset += (off64_t) read_size;
+	if( read_count != (ssize_t) key_material_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read key material data.",
+		 function );
 
-		if( (size64_t) internal_volume->current_offset >= internal_volume->io_handle->encrypted_volume_size )
-		{
-			break;
-		}
-		if( internal_volume->io_handle->abort != 0 )
-		{
-			break;
-		}
+		return( -1 );
 	}
-	return( total_read_count );
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: key material data:\n",
+		 function );
+		libcnotify_print_data(
+		 key_material_data,
+		 key_material_size,
+		 LIBCNOTIFY_PRINT_DATA_FLAG_GROUP_DATA );
+	}
+#endif
+	return( 1 );
 }
 
-/* Reads data at the current offset into a buffer
- * Returns the number of bytes read or -1 on error
+/* Decrypts the key material of a key slot with an user key and merges the split master key
+ * The split master key data is used as scratch buffer and is of the same size as the key material data
+ * Returns 1 if successful, 0 if aborted or -1 on error
  */
-ssize_t libluksde_volume_read_buffer(
-         libluksde_volume_t *volume,
-         void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
+int libluksde_internal_volume_decrypt_key_material(
+     libluksde_internal_volume_t *internal_volume,
+     libluksde_encryption_context_t *encryption_context,
+     libluksde_key_slot_t *key_slot,
+     const uint8_t *user_key,
+     const uint8_t *key_material_data,
+     uint8_t *split_master_key_data,
+     size_t key_material_size,
+     uint8_t *master_key,
+     libluksde_progress_t *progress,
+     libcerror_error_t **error )
 {
-	libluksde_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libluksde_volume_read_buffer";
-	ssize_t read_count                           = 0;
+	static char *function  = "libluksde_internal_volume_decrypt_key_material";
+	size_t master_key_size = 0;
+	int result             = 0;
 
-	if( volume == NULL )
+	if( internal_volume == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -1980,235 +1827,165 @@ ssize_t libluksde_volume_read_buffer(
 
 		return( -1 );
 	}
-	internal_volume = (libluksde_internal_volume_t *) volume;
-
-#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	if( internal_volume->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	read_count = libluksde_internal_volume_read_buffer_from_file_io_handle(
-		      internal_volume,
-		      internal_volume->file_io_handle,
-		      buffer,
-		      buffer_size,
-		      error );
-
-	if( read_count == -1 )
+	if( key_slot == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key slot.",
 		 function );
 
-		read_count = -1;
+		return( -1 );
 	}
-#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	master_key_size = internal_volume->io_handle->master_key_size;
+
+	if( key_material_size < ( master_key_size * key_slot->number_of_stripes ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid key material size value too small.",
 		 function );
 
 		return( -1 );
 	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: user key:\n",
+		 function );
+		libcnotify_print_data(
+		 user_key,
+		 master_key_size,
+		 0 );
+	}
 #endif
-	return( read_count );
-}
-
-/* Reads (volume) data at a specific offset
- * Returns the number of bytes read or -1 on error
- */
-ssize_t libluksde_volume_read_buffer_at_offset(
-         libluksde_volume_t *volume,
-         void *buffer,
-         size_t buffer_size,
-         off64_t offset,
-         libcerror_error_t **error )
-{
-	libluksde_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libluksde_volume_read_buffer_at_offset";
-	ssize_t read_count                           = 0;
-
-	if( volume == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid volume.",
-		 function );
-
-		return( -1 );
-	}
-	internal_volume = (libluksde_internal_volume_t *) volume;
-
-#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_volume->read_write_lock,
+	/* The key material is only decrypted, hence the encryption key schedules are not determined
+	 */
+	if( libluksde_encryption_set_decryption_keys(
+	     encryption_context,
+	     user_key,
+	     master_key_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to set decryption key in encryption context.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( libluksde_internal_volume_seek_offset(
-	     internal_volume,
-	     offset,
-	     SEEK_SET,
-	     error ) == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
-		 function );
-
-		goto on_error;
-	}
-	read_count = libluksde_internal_volume_read_buffer_from_file_io_handle(
-		      internal_volume,
-		      internal_volume->file_io_handle,
-		      buffer,
-		      buffer_size,
-		      error );
-
-	if( read_count == -1 )
+	/* The key material is encrypted as a run of sectors, that starts at block key 0
+	 */
+	if( libluksde_encryption_crypt_sectors(
+	     encryption_context,
+	     LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	     key_material_data,
+	     key_material_size,
+	     split_master_key_data,
+	     key_material_size,
+	     0,
+	     (size_t) internal_volume->io_handle->bytes_per_sector,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
+		 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+		 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+		 "%s: unable to decrypt key material data.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		libcnotify_printf(
+		 "%s: split master key data:\n",
 		 function );
-
-		return( -1 );
+		libcnotify_print_data(
+		 split_master_key_data,
+		 key_material_size,
+		 LIBCNOTIFY_PRINT_DATA_FLAG_GROUP_DATA );
 	}
 #endif
-	return( read_count );
-
-on_error:
-#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_volume->read_write_lock,
-	 NULL );
-#endif
-	return( -1 );
-}
-
-#ifdef TODO_WRITE_SUPPORT
-
-/* Writes (volume) data at the current offset
- * Returns the number of input bytes written, 0 when no longer bytes can be written or -1 on error
- */
-ssize_t libluksde_volume_write_buffer(
-         libluksde_volume_t *volume,
-         void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
-{
-	return( -1 );
-}
-
-/* Writes (volume) data at a specific offset,
- * Returns the number of input bytes written, 0 when no longer bytes can be written or -1 on error
- */
-ssize_t libluksde_volume_write_buffer_at_offset(
-         libluksde_volume_t *volume,
-         const void *buffer,
-         size_t buffer_size,
-         off64_t offset,
-         libcerror_error_t **error )
-{
-	static char *function = "libluksde_volume_write_buffer_at_offset";
-	ssize_t write_count   = 0;
+	if( progress != NULL )
+	{
+		progress->stage = LIBLUKSDE_PROGRESS_STAGE_ANTI_FORENSIC_MERGE;
+	}
+	result = libluksde_diffuser_merge(
+	          split_master_key_data,
+	          master_key_size * key_slot->number_of_stripes,
+	          master_key,
+	          master_key_size,
+	          key_slot->number_of_stripes,
+	          internal_volume->io_handle->hashing_method,
+	          progress,
+	          error );
 
-	if( libluksde_volume_seek_offset(
-	     volume,
-	     offset,
-	     SEEK_SET,
-	     error ) == -1 )
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to merge split master key.",
 		 function );
 
 		return( -1 );
 	}
-	write_count = libluksde_volume_write_buffer(
-	               volume,
-	               buffer,
-	               buffer_size,
-	               error );
-
-	if( write_count < 0 )
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( ( libcnotify_verbose != 0 )
+	 && ( result != 0 ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write buffer.",
+		libcnotify_printf(
+		 "%s: master key data:\n",
 		 function );
-
-		return( -1 );
+		libcnotify_print_data(
+		 master_key,
+		 master_key_size,
+		 0 );
 	}
-	return( write_count );
+#endif
+	return( result );
 }
 
-#endif /* TODO_WRITE_SUPPORT */
-
-/* Seeks a certain offset of the (volume) data
- * This function is not multi-thread safe acquire write lock before call
- * Returns the offset if seek is successful or -1 on error
+/* Tries to unlock a key slot with a password
+ * The key slot trial contains the key material of the key slot and receives the master key
+ * Returns 1 if the key slot was unlocked, 0 if not or -1 on error
  */
-off64_t libluksde_internal_volume_seek_offset(
-         libluksde_internal_volume_t *internal_volume,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
+int libluksde_internal_volume_try_key_slot(
+     libluksde_internal_volume_t *internal_volume,
+     libluksde_key_slot_trial_t *key_slot_trial,
+     const uint8_t *password,
+     size_t password_size,
+     libcerror_error_t **error )
 {
-	static char *function = "libluksde_internal_volume_seek_offset";
+	uint8_t master_key_validation_hash[ 20 ];
+	uint8_t user_key[ 64 ];
+
+	libluksde_progress_t progress;
+
+	libluksde_encryption_context_t *encryption_context = NULL;
+	uint8_t *split_master_key_data                     = NULL;
+	static char *function                              = "libluksde_internal_volume_try_key_slot";
+	int result                                         = 0;
 
 	if( internal_volume == NULL )
 	{
@@ -2232,311 +2009,3945 @@ off64_t libluksde_internal_volume_seek_offset(
 
 		return( -1 );
 	}
-	if( ( whence != SEEK_CUR )
-	 && ( whence != SEEK_END )
-	 && ( whence != SEEK_SET ) )
+	if( key_slot_trial == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported whence.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key slot trial.",
 		 function );
 
 		return( -1 );
 	}
-	if( whence == SEEK_CUR )
-	{	
-		offset += internal_volume->current_offset;
-	}
-	else if( whence == SEEK_END )
-	{	
-		offset += (off64_t) internal_volume->io_handle->encrypted_volume_size;
-	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	if( libluksde_progress_get_abort(
+	     &( internal_volume->io_handle->key_slots_abort ) ) != 0 )
 	{
-		libcnotify_printf(
-		 "%s: seeking volume data offset: %" PRIi64 ".\n",
-		 function,
-		 offset );
+		return( 0 );
 	}
-#endif
-	if( offset < 0 )
+	/* A callback that cancels stops the trials of the other key slots as well
+	 */
+	progress.abort             = &( internal_volume->io_handle->key_slots_abort );
+	progress.callback_function = internal_volume->io_handle->progress_callback_function;
+	progress.callback_data     = internal_volume->io_handle->progress_callback_data;
+	progress.key_slot_index    = key_slot_trial->key_slot_index;
+	progress.stage             = LIBLUKSDE_PROGRESS_STAGE_KEY_SLOT_PBKDF2;
+
+	/* Every key slot trial uses its own encryption context since the key slots
+	 * can be tried concurrently
+	 */
+	if( libluksde_encryption_initialize(
+	     &encryption_context,
+	     internal_volume->io_handle->encryption_method,
+	     internal_volume->io_handle->encryption_chaining_mode,
+	     internal_volume->io_handle->initialization_vector_mode,
+	     internal_volume->io_handle->essiv_hashing_method,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create encryption context.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	internal_volume->current_offset = offset;
-
-	return( offset );
-}
-
-/* Seeks a certain offset of the data
- * Returns the offset if seek is successful or -1 on error
- */
-off64_t libluksde_volume_seek_offset(
-         libluksde_volume_t *volume,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
-{
-	libluksde_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libluksde_volume_seek_offset";
+	split_master_key_data = (uint8_t *) memory_allocate(
+	                                     sizeof( uint8_t ) * key_slot_trial->key_material_size );
 
-	if( volume == NULL )
+	if( split_master_key_data == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid volume.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create split master key data.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	internal_volume = (libluksde_internal_volume_t *) volume;
+	result = libluksde_password_pbkdf2_with_progress(
+	          password,
+	          password_size,
+	          internal_volume->io_handle->hashing_method,
+	          LIBLUKSDE_HASH_BACKEND_DEFAULT,
+	          key_slot_trial->key_slot->salt,
+	          32,
+	          key_slot_trial->key_slot->number_of_iterations,
+	          user_key,
+	          internal_volume->io_handle->master_key_size,
+	          &progress,
+	          error );
 
-	if( internal_volume->io_handle == NULL )
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine user key.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
-		 function );
+	else if( result != 0 )
+	{
+		result = libluksde_internal_volume_decrypt_key_material(
+		          internal_volume,
+		          encryption_context,
+		          key_slot_trial->key_slot,
+		          user_key,
+		          key_slot_trial->key_material_data,
+		          split_master_key_data,
+		          key_slot_trial->key_material_size,
+		          key_slot_trial->master_key,
+		          &progress,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+			 "%s: unable to decrypt key slot: %d key material.",
+			 function,
+			 key_slot_trial->key_slot_index );
 
-		return( -1 );
+			goto on_error;
+		}
 	}
-#endif
-	offset = libluksde_internal_volume_seek_offset(
-	          internal_volume,
-	          offset,
-	          whence,
-	          error );
-
-	if( offset == -1 )
+	if( result != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
-		 function );
+		progress.stage = LIBLUKSDE_PROGRESS_STAGE_MASTER_KEY_DIGEST;
+
+		result = libluksde_password_pbkdf2_with_progress(
+		          key_slot_trial->master_key,
+		          internal_volume->io_handle->master_key_size,
+		          internal_volume->io_handle->hashing_method,
+		          LIBLUKSDE_HASH_BACKEND_DEFAULT,
+		          internal_volume->io_handle->master_key_salt,
+		          32,
+		          internal_volume->io_handle->master_key_number_of_iterations,
+		          master_key_validation_hash,
+		          20,
+		          &progress,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine master key validation hash.",
+			 function );
 
-		offset = -1;
+			goto on_error;
+		}
 	}
-#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_volume->read_write_lock,
+	if( result != 0 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: key slot: %d master key validation hash data:\n",
+			 function,
+			 key_slot_trial->key_slot_index );
+			libcnotify_print_data(
+			 master_key_validation_hash,
+			 20,
+			 0 );
+		}
+#endif
+		if( memory_compare(
+		     master_key_validation_hash,
+		     internal_volume->io_handle->master_key_validation_hash,
+		     20 ) == 0 )
+		{
+			/* Stop the trials of the other key slots
+			 */
+			libluksde_progress_set_abort(
+			 &( internal_volume->io_handle->key_slots_abort ),
+			 1 );
+		}
+		else
+		{
+			result = 0;
+		}
+	}
+	memory_set(
+	 split_master_key_data,
+	 0,
+	 key_slot_trial->key_material_size );
+
+	memory_free(
+	 split_master_key_data );
+
+	memory_set(
+	 user_key,
+	 0,
+	 64 );
+
+	if( libluksde_encryption_free(
+	     &encryption_context,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free encryption context.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	return( offset );
+	return( result );
+
+on_error:
+	if( split_master_key_data != NULL )
+	{
+		memory_set(
+		 split_master_key_data,
+		 0,
+		 key_slot_trial->key_material_size );
+
+		memory_free(
+		 split_master_key_data );
+	}
+	memory_set(
+	 user_key,
+	 0,
+	 64 );
+
+	if( encryption_context != NULL )
+	{
+		libluksde_encryption_free(
+		 &encryption_context,
+		 NULL );
+	}
+	return( -1 );
 }
 
-/* Retrieves the current offset of the (volume) data
+/* Callback function to try to unlock a key slot from the thread pool
+ * The result and error are stored in the key slot trial, so that an error trying
+ * one key slot does not fail the thread pool and stop the trials of the other key slots
  * Returns 1 if successful or -1 on error
  */
-int libluksde_volume_get_offset(
-     libluksde_volume_t *volume,
-     off64_t *offset,
-     libcerror_error_t **error )
+int libluksde_internal_volume_key_slot_trial_callback(
+     libluksde_key_slot_trial_t *key_slot_trial,
+     libluksde_internal_volume_t *internal_volume )
 {
-	libluksde_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libluksde_volume_get_offset";
+	static char *function = "libluksde_internal_volume_key_slot_trial_callback";
 
-	if( volume == NULL )
+	if( key_slot_trial == NULL )
+	{
+		return( -1 );
+	}
+	if( ( internal_volume == NULL )
+	 || ( internal_volume->io_handle == NULL ) )
 	{
 		libcerror_error_set(
-		 error,
+		 &( key_slot_trial->error ),
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
 		 "%s: invalid volume.",
 		 function );
 
-		return( -1 );
+		key_slot_trial->result = -1;
+
+		return( 1 );
 	}
-	internal_volume = (libluksde_internal_volume_t *) volume;
+	key_slot_trial->result = libluksde_internal_volume_try_key_slot(
+	                          internal_volume,
+	                          key_slot_trial,
+	                          internal_volume->io_handle->user_password,
+	                          internal_volume->io_handle->user_password_size - 1,
+	                          &( key_slot_trial->error ) );
 
-	if( internal_volume->io_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing IO handle.",
-		 function );
+	return( 1 );
+}
 
-		return( -1 );
-	}
-	if( offset == NULL )
+/* Tries to unlock the key slots with the user password
+ * The active key slots are tried concurrently on a thread pool, where the trials
+ * of the other key slots are stopped as soon as one of the key slots was unlocked
+ * Returns 1 if one of the key slots was unlocked, 0 if not or -1 on error
+ */
+int libluksde_internal_volume_try_key_slots(
+     libluksde_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     int *key_slot_index,
+     libcerror_error_t **error )
+{
+	libluksde_key_slot_trial_t *key_slot_trials[ 8 ];
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	libcthreads_thread_pool_t *thread_pool = NULL;
+#endif
+	libluksde_key_slot_t *key_slot         = NULL;
+	static char *function                  = "libluksde_internal_volume_try_key_slots";
+	size_t key_material_size               = 0;
+	int number_of_trials                   = 0;
+	int result                             = 0;
+	int trial_index                        = 0;
+
+	if( internal_volume == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid offset.",
+		 "%s: invalid volume.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	if( internal_volume->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	*offset = internal_volume->current_offset;
-
-#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	if( ( internal_volume->io_handle->user_password == NULL )
+	 || ( internal_volume->io_handle->user_password_size == 0 ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - invalid IO handle - missing user password.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	return( 1 );
-}
-
-/* Retrieves the size
- * Returns 1 if successful or -1 on error
- */
-int libluksde_volume_get_size(
-     libluksde_volume_t *volume,
-     size64_t *size,
-     libcerror_error_t **error )
-{
-	libluksde_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libluksde_volume_get_size";
-
-	if( volume == NULL )
+	if( key_slot_index == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid volume.",
+		 "%s: invalid key slot index.",
 		 function );
 
 		return( -1 );
 	}
-	internal_volume = (libluksde_internal_volume_t *) volume;
-
-	if( internal_volume->io_handle == NULL )
+	if( memory_set(
+	     key_slot_trials,
+	     0,
+	     sizeof( libluksde_key_slot_trial_t * ) * 8 ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear key slot trials.",
 		 function );
 
 		return( -1 );
 	}
-	if( size == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid size.",
-		 function );
+	/* The key material is read up front since the file IO handle
+	 * cannot be shared by the threads
+	 */
+	for( trial_index = 0;
+	     trial_index < 8;
+	     trial_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_volume->io_handle->key_slots_array,
+		     trial_index,
+		     (intptr_t **) &key_slot,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve key slot: %d.",
+			 function,
+			 trial_index );
 
-		return( -1 );
+			goto on_error;
+		}
+		if( key_slot == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing key slot: %d.",
+			 function,
+			 trial_index );
+
+			goto on_error;
+		}
+		if( key_slot->state != 0x00ac71f3 )
+		{
+			continue;
+		}
+		if( libluksde_internal_volume_get_key_material_size(
+		     internal_volume,
+		     key_slot,
+		     &key_material_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine key slot: %d key material size.",
+			 function,
+			 trial_index );
+
+			goto on_error;
+		}
+		if( libluksde_key_slot_trial_initialize(
+		     &( key_slot_trials[ number_of_trials ] ),
+		     trial_index,
+		     key_slot,
+		     key_material_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create key slot: %d trial.",
+			 function,
+			 trial_index );
+
+			goto on_error;
+		}
+		number_of_trials++;
+
+		if( libluksde_internal_volume_read_key_material(
+		     internal_volume,
+		     file_io_handle,
+		     key_slot,
+		     key_slot_trials[ number_of_trials - 1 ]->key_material_data,
+		     key_material_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read key slot: %d key material.",
+			 function,
+			 trial_index );
+
+			goto on_error;
+		}
 	}
+	libluksde_progress_set_abort(
+	 &( internal_volume->io_handle->key_slots_abort ),
+	 internal_volume->io_handle->abort );
+
 #if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	if( number_of_trials > 1 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
-		 function );
+		if( libcthreads_thread_pool_create(
+		     &thread_pool,
+		     NULL,
+		     number_of_trials,
+		     number_of_trials,
+		     (int (*)(intptr_t *, void *)) &libluksde_internal_volume_key_slot_trial_callback,
+		     (void *) internal_volume,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread pool.",
+			 function );
 
-		return( -1 );
+			goto on_error;
+		}
+		for( trial_index = 0;
+		     trial_index < number_of_trials;
+		     trial_index++ )
+		{
+			if( libcthreads_thread_pool_push(
+			     thread_pool,
+			     (intptr_t *) key_slot_trials[ trial_index ],
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push key slot: %d trial onto thread pool.",
+				 function,
+				 key_slot_trials[ trial_index ]->key_slot_index );
+
+				goto on_error;
+			}
+		}
+		if( libcthreads_thread_pool_join(
+		     &thread_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else
+#endif
+	{
+		for( trial_index = 0;
+		     trial_index < number_of_trials;
+		     trial_index++ )
+		{
+			libluksde_internal_volume_key_slot_trial_callback(
+			 key_slot_trials[ trial_index ],
+			 internal_volume );
+
+			/* A key slot that cannot be tried does not stop the trials of the other
+			 * key slots, the same as when the key slots are tried concurrently
+			 */
+			if( key_slot_trials[ trial_index ]->result == 1 )
+			{
+				break;
+			}
+		}
+	}
+	/* If multiple key slots were unlocked concurrently, they contain the same master key
+	 */
+	for( trial_index = 0;
+	     trial_index < number_of_trials;
+	     trial_index++ )
+	{
+		if( key_slot_trials[ trial_index ]->result == 1 )
+		{
+			if( memory_copy(
+			     internal_volume->io_handle->master_key,
+			     key_slot_trials[ trial_index ]->master_key,
+			     internal_volume->io_handle->master_key_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy master key.",
+				 function );
+
+				goto on_error;
+			}
+			*key_slot_index = key_slot_trials[ trial_index ]->key_slot_index;
+
+			result = 1;
+
+			break;
+		}
+	}
+	if( result == 0 )
+	{
+		for( trial_index = 0;
+		     trial_index < number_of_trials;
+		     trial_index++ )
+		{
+			if( key_slot_trials[ trial_index ]->result == -1 )
+			{
+				/* Pass the error of the trial on to the caller
+				 */
+				if( ( error != NULL )
+				 && ( *error == NULL ) )
+				{
+					*error = key_slot_trials[ trial_index ]->error;
+
+					key_slot_trials[ trial_index ]->error = NULL;
+				}
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to try key slot: %d.",
+				 function,
+				 key_slot_trials[ trial_index ]->key_slot_index );
+
+				goto on_error;
+			}
+		}
+	}
+	for( trial_index = 0;
+	     trial_index < number_of_trials;
+	     trial_index++ )
+	{
+		if( libluksde_key_slot_trial_free(
+		     &( key_slot_trials[ trial_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free key slot: %d trial.",
+			 function,
+			 trial_index );
+
+			goto on_error;
+		}
+	}
+	return( result );
+
+on_error:
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( thread_pool != NULL )
+	{
+		libluksde_progress_set_abort(
+		 &( internal_volume->io_handle->key_slots_abort ),
+		 1 );
+
+		libcthreads_thread_pool_join(
+		 &thread_pool,
+		 NULL );
+	}
+#endif
+	for( trial_index = 0;
+	     trial_index < number_of_trials;
+	     trial_index++ )
+	{
+		if( key_slot_trials[ trial_index ] != NULL )
+		{
+			libluksde_key_slot_trial_free(
+			 &( key_slot_trials[ trial_index ] ),
+			 NULL );
+		}
+	}
+	return( -1 );
+}
+
+/* Determines if the volume is locked
+ * Returns 1 if locked, 0 if not or -1 on error
+ */
+int libluksde_volume_is_locked(
+     libluksde_volume_t *volume,
+     libcerror_error_t **error )
+{
+	libluksde_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libluksde_volume_is_locked";
+	uint8_t is_locked                            = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	is_locked = internal_volume->is_locked;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( is_locked );
+}
+
+/* Reads (volume) data from the last current into a buffer using a Basic File IO (bfio) handle
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libluksde_internal_volume_read_buffer_from_file_io_handle(
+         libluksde_internal_volume_t *internal_volume,
+         libbfio_handle_t *file_io_handle,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libluksde_sector_data_t *sector_data = NULL;
+	static char *function                = "libluksde_internal_volume_read_buffer_from_file_io_handle";
+	off64_t element_data_offset          = 0;
+	size_t buffer_offset                 = 0;
+	size_t chunk_data_offset             = 0;
+	size_t read_size                     = 0;
+	ssize_t total_read_count             = 0;
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	libcerror_error_t *readahead_error   = NULL;
+	off64_t chunk_offset                 = 0;
+	off64_t read_offset                  = 0;
+	int result                           = 0;
+#endif
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->chunks_vector == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing chunks vector.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->chunks_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing chunks cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid volume - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) internal_volume->current_offset >= internal_volume->io_handle->encrypted_volume_size )
+	{
+		return( 0 );
+	}
+	if( (size64_t) ( internal_volume->current_offset + buffer_size ) >= internal_volume->io_handle->encrypted_volume_size )
+	{
+		buffer_size = (size_t) ( internal_volume->io_handle->encrypted_volume_size - internal_volume->current_offset );
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	/* The readahead is created on the first read, if it cannot be created
+	 * the volume is read without it
+	 */
+	if( ( internal_volume->readahead == NULL )
+	 && ( internal_volume->readahead_is_unavailable == 0 )
+	 && ( internal_volume->maximum_number_of_readahead_chunks > 0 ) )
+	{
+		if( libluksde_readahead_initialize(
+		     &( internal_volume->readahead ),
+		     internal_volume->io_handle,
+		     file_io_handle,
+		     internal_volume->chunk_size,
+		     internal_volume->minimum_number_of_readahead_chunks,
+		     internal_volume->maximum_number_of_readahead_chunks,
+		     &readahead_error ) != 1 )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_print_error_backtrace(
+				 readahead_error );
+			}
+#endif
+			libcerror_error_free(
+			 &readahead_error );
+
+			internal_volume->readahead_is_unavailable = 1;
+		}
+	}
+	read_offset = internal_volume->current_offset;
+#endif
+	while( buffer_size > 0 )
+	{
+		sector_data = NULL;
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+		/* Chunks that were read ahead by the worker thread are used first
+		 */
+		if( internal_volume->readahead != NULL )
+		{
+			chunk_offset = internal_volume->current_offset - ( internal_volume->current_offset % internal_volume->chunk_size );
+
+			result = libluksde_readahead_get_chunk(
+			          internal_volume->readahead,
+			          chunk_offset,
+			          &sector_data,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve readahead chunk at offset: %" PRIi64 ".",
+				 function,
+				 chunk_offset );
+
+				return( -1 );
+			}
+			else if( result != 0 )
+			{
+				element_data_offset = internal_volume->current_offset - chunk_offset;
+			}
+		}
+#endif
+		/* Sector aligned reads of at least a chunk bypass the chunks cache,
+		 * their whole sectors are read into the buffer and decrypted in place
+		 */
+		if( ( sector_data == NULL )
+		 && ( ( internal_volume->current_offset % internal_volume->io_handle->bytes_per_sector ) == 0 )
+		 && ( buffer_size >= internal_volume->chunk_size ) )
+		{
+			read_size = buffer_size - ( buffer_size % internal_volume->io_handle->bytes_per_sector );
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+			/* The read stops at the end of the chunk so that the chunks
+			 * that follow can be retrieved from the readahead
+			 */
+			if( internal_volume->readahead != NULL )
+			{
+				chunk_data_offset = (size_t) ( internal_volume->current_offset % internal_volume->chunk_size );
+
+				if( read_size > ( internal_volume->chunk_size - chunk_data_offset ) )
+				{
+					read_size = internal_volume->chunk_size - chunk_data_offset;
+				}
+			}
+#endif
+
+			if( libluksde_io_handle_read_sectors(
+			     internal_volume->io_handle,
+			     file_io_handle,
+			     internal_volume->current_offset,
+			     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			     read_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read sectors at offset: %" PRIi64 ".",
+				 function,
+				 internal_volume->current_offset );
+
+				return( -1 );
+			}
+		}
+		else if( sector_data == NULL )
+		{
+			if( libfdata_vector_get_element_value_at_offset(
+			     internal_volume->chunks_vector,
+			     (intptr_t *) file_io_handle,
+			     internal_volume->chunks_cache,
+			     internal_volume->current_offset,
+			     &element_data_offset,
+			     (intptr_t **) &sector_data,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve chunk data at offset: %" PRIi64 ".",
+				 function,
+				 internal_volume->current_offset );
+
+				return( -1 );
+			}
+			if( sector_data == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing chunk data at offset: %" PRIi64 ".",
+				 function,
+				 internal_volume->current_offset );
+
+				return( -1 );
+			}
+		}
+		if( sector_data != NULL )
+		{
+			if( (size64_t) element_data_offset >= (size64_t) sector_data->data_size )
+			{
+				break;
+			}
+			chunk_data_offset = (size_t) element_data_offset;
+
+			read_size = sector_data->data_size - chunk_data_offset;
+
+			if( read_size > buffer_size )
+			{
+				read_size = buffer_size;
+			}
+			if( memory_copy(
+			     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			     &( ( sector_data->data )[ chunk_data_offset ] ),
+			     read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy chunk data to buffer.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		buffer_offset     += read_size;
+		buffer_size       -= read_size;
+		total_read_count  += (ssize_t) read_size;
+
+		internal_volume->current_offset += (off64_t) read_size;
+
+		if( (size64_t) internal_volume->current_offset >= internal_volume->io_handle->encrypted_volume_size )
+		{
+			break;
+		}
+		if( internal_volume->io_handle->abort != 0 )
+		{
+			break;
+		}
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( ( internal_volume->readahead != NULL )
+	 && ( total_read_count > 0 ) )
+	{
+		if( libluksde_readahead_update(
+		     internal_volume->readahead,
+		     read_offset,
+		     (size64_t) total_read_count,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update readahead.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	return( total_read_count );
+}
+
+/* Reads data at the current offset into a buffer
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libluksde_volume_read_buffer(
+         libluksde_volume_t *volume,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libluksde_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libluksde_volume_read_buffer";
+	ssize_t read_count                           = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libluksde_internal_volume_read_buffer_from_file_io_handle(
+		      internal_volume,
+		      internal_volume->file_io_handle,
+		      buffer,
+		      buffer_size,
+		      error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		read_count = -1;
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Reads (volume) data at a specific offset
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libluksde_volume_read_buffer_at_offset(
+         libluksde_volume_t *volume,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libluksde_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libluksde_volume_read_buffer_at_offset";
+	ssize_t read_count                           = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libluksde_internal_volume_seek_offset(
+	     internal_volume,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libluksde_internal_volume_read_buffer_from_file_io_handle(
+		      internal_volume,
+		      internal_volume->file_io_handle,
+		      buffer,
+		      buffer_size,
+		      error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+
+on_error:
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_volume->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+#ifdef TODO_WRITE_SUPPORT
+
+/* Writes (volume) data at the current offset
+ * Returns the number of input bytes written, 0 when no longer bytes can be written or -1 on error
+ */
+ssize_t libluksde_volume_write_buffer(
+         libluksde_volume_t *volume,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	return( -1 );
+}
+
+/* Writes (volume) data at a specific offset,
+ * Returns the number of input bytes written, 0 when no longer bytes can be written or -1 on error
+ */
+ssize_t libluksde_volume_write_buffer_at_offset(
+         libluksde_volume_t *volume,
+         const void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function = "libluksde_volume_write_buffer_at_offset";
+	ssize_t write_count   = 0;
+
+	if( libluksde_volume_seek_offset(
+	     volume,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+
+		return( -1 );
+	}
+	write_count = libluksde_volume_write_buffer(
+	               volume,
+	               buffer,
+	               buffer_size,
+	               error );
+
+	if( write_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write buffer.",
+		 function );
+
+		return( -1 );
+	}
+	return( write_count );
+}
+
+#endif /* TODO_WRITE_SUPPORT */
+
+/* Seeks a certain offset of the (volume) data
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libluksde_internal_volume_seek_offset(
+         libluksde_internal_volume_t *internal_volume,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "libluksde_internal_volume_seek_offset";
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( whence == SEEK_CUR )
+	{	
+		offset += internal_volume->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{	
+		offset += (off64_t) internal_volume->io_handle->encrypted_volume_size;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: seeking volume data offset: %" PRIi64 ".\n",
+		 function,
+		 offset );
+	}
+#endif
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume->current_offset = offset;
+
+	return( offset );
+}
+
+/* Seeks a certain offset of the data
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libluksde_volume_seek_offset(
+         libluksde_volume_t *volume,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	libluksde_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libluksde_volume_seek_offset";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	offset = libluksde_internal_volume_seek_offset(
+	          internal_volume,
+	          offset,
+	          whence,
+	          error );
+
+	if( offset == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+
+		offset = -1;
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( offset );
+}
+
+/* Retrieves the current offset of the (volume) data
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_volume_get_offset(
+     libluksde_volume_t *volume,
+     off64_t *offset,
+     libcerror_error_t **error )
+{
+	libluksde_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libluksde_volume_get_offset";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*offset = internal_volume->current_offset;
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the size
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_volume_get_size(
+     libluksde_volume_t *volume,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	libluksde_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libluksde_volume_get_size";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*size = internal_volume->io_handle->encrypted_volume_size;
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the encryption method
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_volume_get_encryption_method(
+     libluksde_volume_t *volume,
+     int *encryption_method,
+     int *encryption_chaining_mode,
+     libcerror_error_t **error )
+{
+	libluksde_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libluksde_volume_get_encryption_method";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( encryption_method == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid encryption method.",
+		 function );
+
+		return( -1 );
+	}
+	if( encryption_chaining_mode == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid encryption chaining mode.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*encryption_method        = internal_volume->io_handle->encryption_method;
+	*encryption_chaining_mode = internal_volume->io_handle->encryption_chaining_mode;
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the password and diffuser hashing method
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_volume_get_hashing_method(
+     libluksde_volume_t *volume,
+     int *hashing_method,
+     libcerror_error_t **error )
+{
+	libluksde_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libluksde_volume_get_hashing_method";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( hashing_method == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hashing method.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*hashing_method = internal_volume->io_handle->hashing_method;
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the master key size and the number of iterations of the master key digest
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_volume_get_master_key_parameters(
+     libluksde_volume_t *volume,
+     size_t *master_key_size,
+     uint32_t *number_of_iterations,
+     libcerror_error_t **error )
+{
+	libluksde_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libluksde_volume_get_master_key_parameters";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( master_key_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid master key size.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_iterations == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of iterations.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*master_key_size      = (size_t) internal_volume->io_handle->master_key_size;
+	*number_of_iterations = internal_volume->io_handle->master_key_number_of_iterations;
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the number of key slots
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_volume_get_number_of_key_slots(
+     libluksde_volume_t *volume,
+     int *number_of_key_slots,
+     libcerror_error_t **error )
+{
+	libluksde_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libluksde_volume_get_number_of_key_slots";
+	int result                                   = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libcdata_array_get_number_of_entries(
+	     internal_volume->io_handle->key_slots_array,
+	     number_of_key_slots,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of key slots.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the number of iterations and the number of anti-forensic stripes of a specific key slot
+ * Returns 1 if successful, 0 if the key slot is not active or -1 on error
+ */
+int libluksde_volume_get_key_slot_parameters(
+     libluksde_volume_t *volume,
+     int key_slot_index,
+     uint32_t *number_of_iterations,
+     uint32_t *number_of_stripes,
+     libcerror_error_t **error )
+{
+	libluksde_internal_volume_t *internal_volume = NULL;
+	libluksde_key_slot_t *key_slot               = NULL;
+	static char *function                        = "libluksde_volume_get_key_slot_parameters";
+	int result                                   = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_iterations == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of iterations.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_stripes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of stripes.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libcdata_array_get_entry_by_index(
+	     internal_volume->io_handle->key_slots_array,
+	     key_slot_index,
+	     (intptr_t **) &key_slot,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve key slot: %d.",
+		 function,
+		 key_slot_index );
+
+		result = -1;
+	}
+	else if( key_slot == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing key slot: %d.",
+		 function,
+		 key_slot_index );
+
+		result = -1;
+	}
+	else if( key_slot->state == 0x00ac71f3 )
+	{
+		*number_of_iterations = key_slot->number_of_iterations;
+		*number_of_stripes    = key_slot->number_of_stripes;
+
+		result = 1;
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Derives a key using PBKDF2 with the hashing method of the volume
+ * A fixed password and salt are used and the key is discarded, this function is
+ * intended to measure the PBKDF2 throughput of the host before unlocking a volume
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_volume_probe_pbkdf2(
+     libluksde_volume_t *volume,
+     uint32_t number_of_iterations,
+     size_t key_size,
+     libcerror_error_t **error )
+{
+	uint8_t key[ 64 ];
+	uint8_t salt[ 32 ];
+
+	libluksde_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libluksde_volume_probe_pbkdf2";
+	int hashing_method                           = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_iterations == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of iterations value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( key_size == 0 )
+	 || ( key_size > 64 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid key size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	hashing_method = internal_volume->io_handle->hashing_method;
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	/* The salt has the size of a key slot salt
+	 */
+	if( memory_set(
+	     salt,
+	     0,
+	     32 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear salt.",
+		 function );
+
+		return( -1 );
+	}
+	if( libluksde_password_pbkdf2(
+	     (uint8_t *) "password",
+	     8,
+	     hashing_method,
+	     LIBLUKSDE_HASH_BACKEND_DEFAULT,
+	     salt,
+	     32,
+	     number_of_iterations,
+	     key,
+	     key_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to derive key.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the encryption provider
+ * This function needs to be used before one of the open functions
+ * The built-in implementation is used when the provider does not support the encryption method
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_volume_set_encryption_provider(
+     libluksde_volume_t *volume,
+     int encryption_provider,
+     libcerror_error_t **error )
+{
+	libluksde_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libluksde_volume_set_encryption_provider";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( encryption_provider != LIBLUKSDE_ENCRYPTION_PROVIDER_BUILT_IN )
+	 && ( encryption_provider != LIBLUKSDE_ENCRYPTION_PROVIDER_KERNEL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported encryption provider.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_volume->io_handle->encryption_provider = encryption_provider;
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the number of entries of the ESSIV initialization vector cache
+ * The cache is only used by volumes that use the ESSIV initialization vector mode
+ * and is disabled by default, a number of cache entries of 0 disables the cache.
+ * This function needs to be used before one of the open functions
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_volume_set_essiv_cache_size(
+     libluksde_volume_t *volume,
+     int number_of_cache_entries,
+     libcerror_error_t **error )
+{
+	libluksde_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libluksde_volume_set_essiv_cache_size";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_cache_entries < 0 )
+	 || ( number_of_cache_entries > LIBLUKSDE_MAXIMUM_CACHE_ENTRIES_ESSIV_INITIALIZATION_VECTORS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of cache entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_volume->io_handle->number_of_essiv_cache_entries = number_of_cache_entries;
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the chunk cache parameters
+ * The volume data is read, decrypted and cached in chunks of the chunk size,
+ * which must be a multiple of the bytes per sector. Reads of at least the chunk
+ * size bypass the cache.
+ * This function needs to be used before one of the open functions
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_volume_set_chunk_cache_parameters(
+     libluksde_volume_t *volume,
+     size_t chunk_size,
+     int number_of_cache_entries,
+     libcerror_error_t **error )
+{
+	libluksde_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libluksde_volume_set_chunk_cache_parameters";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle->bytes_per_sector == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - invalid IO handle - missing bytes per sector.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_size == 0 )
+	 || ( chunk_size > (size_t) LIBLUKSDE_MAXIMUM_CHUNK_SIZE )
+	 || ( ( chunk_size % internal_volume->io_handle->bytes_per_sector ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_cache_entries <= 0 )
+	 || ( number_of_cache_entries > LIBLUKSDE_MAXIMUM_NUMBER_OF_CACHE_ENTRIES_CHUNKS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of cache entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_volume->chunk_size              = chunk_size;
+	internal_volume->number_of_cache_entries = number_of_cache_entries;
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the readahead parameters
+ * Sequential reads have chunks read ahead and decrypted by a worker thread,
+ * starting with the minimum number of chunks and growing up to the maximum
+ * number of chunks while the chunks read ahead are used.
+ * A maximum number of chunks of 0 disables the readahead, which is the default.
+ * The readahead requires multi-thread support, without it the parameters are ignored.
+ * This function needs to be used before one of the open functions
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_volume_set_readahead_parameters(
+     libluksde_volume_t *volume,
+     int minimum_number_of_chunks,
+     int maximum_number_of_chunks,
+     libcerror_error_t **error )
+{
+	libluksde_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libluksde_volume_set_readahead_parameters";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+	if( internal_volume->file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_chunks < 0 )
+	 || ( maximum_number_of_chunks > LIBLUKSDE_MAXIMUM_NUMBER_OF_READAHEAD_CHUNKS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of chunks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_chunks != 0 )
+	 && ( ( minimum_number_of_chunks <= 0 )
+	  || ( minimum_number_of_chunks > maximum_number_of_chunks ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid minimum number of chunks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_volume->minimum_number_of_readahead_chunks = minimum_number_of_chunks;
+	internal_volume->maximum_number_of_readahead_chunks = maximum_number_of_chunks;
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the readahead statistics
+ * The number of hits is the number of chunks that were read ahead and used,
+ * the number of misses is the number of chunks of sequential reads that were not read ahead.
+ * Both are 0 if no readahead is used
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_volume_get_readahead_statistics(
+     libluksde_volume_t *volume,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error )
+{
+	libluksde_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libluksde_volume_get_readahead_statistics";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+	if( number_of_hits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of hits.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_misses == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of misses.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_hits   = 0;
+	*number_of_misses = 0;
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->readahead != NULL )
+	{
+		*number_of_hits   = internal_volume->readahead->number_of_hits;
+		*number_of_misses = internal_volume->readahead->number_of_misses;
+	}
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the key derivation progress callback
+ * The callback is invoked every LIBLUKSDE_PASSWORD_PROGRESS_INTERVAL PBKDF2 iterations and after
+ * every anti-forensic stripe while trying a key slot, with the index of the key slot and the stage.
+ * Since the key slots can be tried concurrently the callback can be invoked from multiple threads.
+ * The callback should return 1 to continue or 0 to cancel unlocking the volume.
+ * The abort signalled by libluksde_volume_signal_abort is checked at the same points.
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_volume_set_progress_callback(
+     libluksde_volume_t *volume,
+     int (*progress_callback_function)(
+            void *callback_data,
+            int key_slot_index,
+            int stage,
+            uint64_t value,
+            uint64_t maximum_value ),
+     void *callback_data,
+     libcerror_error_t **error )
+{
+	libluksde_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libluksde_volume_set_progress_callback";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_volume->io_handle->progress_callback_function = progress_callback_function;
+	internal_volume->io_handle->progress_callback_data     = callback_data;
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the keys
+ * This function needs to be used before one of the open functions
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_volume_set_keys(
+     libluksde_volume_t *volume,
+     const uint8_t *master_key,
+     size_t master_key_size,
+     libcerror_error_t **error )
+{
+	libluksde_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libluksde_volume_set_keys";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( master_key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid master key.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( master_key_size != 16 )
+	 && ( master_key_size != 32 )
+	 && ( master_key_size != 64 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported master key size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( master_key_size < 64 )
+	{
+		if( memory_set(
+		     internal_volume->io_handle->master_key,
+		     0,
+		     64 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear master key.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( memory_copy(
+	     internal_volume->io_handle->master_key,
+	     master_key,
+	     master_key_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy master key.",
+		 function );
+
+		goto on_error;
+	}
+	internal_volume->io_handle->master_key_size = (uint32_t) master_key_size;
+
+	internal_volume->io_handle->keys_are_set = 1;
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+	memory_set(
+	 internal_volume->io_handle->master_key,
+	 0,
+	 64 );
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_volume->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Sets an UTF-8 formatted password
+ * This function needs to be used before one of the open functions
+ * Returns 1 if successful, 0 if password is invalid or -1 on error
+ */
+int libluksde_volume_set_utf8_password(
+     libluksde_volume_t *volume,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libcerror_error_t **error )
+{
+	libluksde_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libluksde_volume_set_utf8_password";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_volume->io_handle->user_password != NULL )
+	{
+		if( memory_set(
+		     internal_volume->io_handle->user_password,
+		     0,
+		     internal_volume->io_handle->user_password_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to user password.",
+			 function );
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+			libcthreads_read_write_lock_release_for_write(
+			 internal_volume->read_write_lock,
+			 NULL );
+#endif
+			return( -1 );
+		}
+		memory_free(
+		 internal_volume->io_handle->user_password );
+
+		internal_volume->io_handle->user_password      = NULL;
+		internal_volume->io_handle->user_password_size = 0;
+	}
+	if( libuna_byte_stream_size_from_utf8(
+	     utf8_string,
+	     utf8_string_length,
+	     LIBLUKSDE_CODEPAGE_US_ASCII,
+	     &( internal_volume->io_handle->user_password_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set password size.",
+		 function );
+
+		goto on_error;
+	}
+	internal_volume->io_handle->user_password_size += 1;
+
+	internal_volume->io_handle->user_password = (uint8_t *) memory_allocate(
+	                                                         sizeof( uint8_t ) * internal_volume->io_handle->user_password_size );
+
+	if( internal_volume->io_handle->user_password == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to create user password.",
+		 function );
+
+		goto on_error;
+	}
+	if( libuna_byte_stream_copy_from_utf8(
+	     internal_volume->io_handle->user_password,
+	     internal_volume->io_handle->user_password_size,
+	     LIBLUKSDE_CODEPAGE_US_ASCII,
+	     utf8_string,
+	     utf8_string_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to copy user password.",
+		 function );
+
+		goto on_error;
+	}
+	internal_volume->io_handle->user_password[ internal_volume->io_handle->user_password_size - 1 ] = 0;
+
+	internal_volume->io_handle->user_password_is_set = 1;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: user password: %s\n",
+		 function,
+		 internal_volume->io_handle->user_password );
+	}
+#endif
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( internal_volume->io_handle->user_password != NULL )
+	{
+		memory_set(
+		 internal_volume->io_handle->user_password,
+		 0,
+		 internal_volume->io_handle->user_password_size );
+		memory_free(
+		 internal_volume->io_handle->user_password );
+
+		internal_volume->io_handle->user_password = NULL;
+	}
+	internal_volume->io_handle->user_password_size = 0;
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_volume->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Sets an UTF-16 formatted password
+ * This function needs to be used before one of the open functions
+ * Returns 1 if successful, 0 if password is invalid or -1 on error
+ */
+int libluksde_volume_set_utf16_password(
+     libluksde_volume_t *volume,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     libcerror_error_t **error )
+{
+	libluksde_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libluksde_volume_set_utf16_password";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_volume->io_handle->user_password != NULL )
+	{
+		if( memory_set(
+		     internal_volume->io_handle->user_password,
+		     0,
+		     internal_volume->io_handle->user_password_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to user password.",
+			 function );
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+			libcthreads_read_write_lock_release_for_write(
+			 internal_volume->read_write_lock,
+			 NULL );
+#endif
+			return( -1 );
+		}
+		memory_free(
+		 internal_volume->io_handle->user_password );
+
+		internal_volume->io_handle->user_password      = NULL;
+		internal_volume->io_handle->user_password_size = 0;
+	}
+	if( libuna_byte_stream_size_from_utf16(
+	     utf16_string,
+	     utf16_string_length,
+	     LIBLUKSDE_CODEPAGE_US_ASCII,
+	     &( internal_volume->io_handle->user_password_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set password length.",
+		 function );
+
+		goto on_error;
+	}
+	internal_volume->io_handle->user_password_size += 1;
+
+	internal_volume->io_handle->user_password = (uint8_t *) memory_allocate(
+	                                                         sizeof( uint8_t ) * internal_volume->io_handle->user_password_size );
+
+	if( internal_volume->io_handle->user_password == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to create user password.",
+		 function );
+
+		goto on_error;
+	}
+	if( libuna_byte_stream_copy_from_utf16(
+	     internal_volume->io_handle->user_password,
+	     internal_volume->io_handle->user_password_size,
+	     LIBLUKSDE_CODEPAGE_US_ASCII,
+	     utf16_string,
+	     utf16_string_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to copy user password.",
+		 function );
+
+		goto on_error;
+	}
+	internal_volume->io_handle->user_password[ internal_volume->io_handle->user_password_size - 1 ] = 0;
+
+	internal_volume->io_handle->user_password_is_set = 1;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: user password: %s\n",
+		 function,
+		 internal_volume->io_handle->user_password );
+	}
+#endif
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( internal_volume->io_handle->user_password != NULL )
+	{
+		memory_set(
+		 internal_volume->io_handle->user_password,
+		 0,
+		 internal_volume->io_handle->user_password_size );
+		memory_free(
+		 internal_volume->io_handle->user_password );
+
+		internal_volume->io_handle->user_password = NULL;
+	}
+	internal_volume->io_handle->user_password_size = 0;
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_volume->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Determines which of the passwords unlocks which key slot and sets the master key
+ * The PBKDF2 of the key slots and of the master key validation are calculated for
+ * all the passwords at once, which uses multi-buffer hashing when supported
+ * Returns 1 if one of the passwords unlocks a key slot, 0 if not or -1 on error
+ */
+int libluksde_internal_volume_test_passwords(
+     libluksde_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     const uint8_t **passwords,
+     const size_t *password_sizes,
+     int number_of_passwords,
+     int *password_index,
+     int *key_slot_index,
+     libcerror_error_t **error )
+{
+	libluksde_progress_t progress;
+
+	libluksde_encryption_context_t *encryption_context = NULL;
+	libluksde_key_slot_t *key_slot                     = NULL;
+	const uint8_t **master_keys                        = NULL;
+	size_t *master_key_sizes                           = NULL;
+	uint8_t *key_material_data                         = NULL;
+	uint8_t *master_keys_data                          = NULL;
+	uint8_t *split_master_key_data                     = NULL;
+	uint8_t *user_keys_data                            = NULL;
+	uint8_t *validation_hashes_data                    = NULL;
+	static char *function                              = "libluksde_internal_volume_test_passwords";
+	size_t key_material_size                           = 0;
+	size_t master_key_size                             = 0;
+	int candidate_index                                = 0;
+	int result                                         = 0;
+	int slot_index                                     = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	master_key_size = (size_t) internal_volume->io_handle->master_key_size;
+
+	if( ( master_key_size == 0 )
+	 || ( master_key_size > 64 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid volume - invalid IO handle - master key size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( passwords == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid passwords.",
+		 function );
+
+		return( -1 );
+	}
+	if( password_sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid password sizes.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_passwords <= 0 )
+	 || ( (size_t) number_of_passwords > ( (size_t) SSIZE_MAX / 64 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of passwords value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( password_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid password index.",
+		 function );
+
+		return( -1 );
+	}
+	if( key_slot_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key slot index.",
+		 function );
+
+		return( -1 );
+	}
+	user_keys_data = (uint8_t *) memory_allocate(
+	                              sizeof( uint8_t ) * master_key_size * number_of_passwords );
+
+	if( user_keys_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create user keys data.",
+		 function );
+
+		goto on_error;
+	}
+	master_keys_data = (uint8_t *) memory_allocate(
+	                                sizeof( uint8_t ) * master_key_size * number_of_passwords );
+
+	if( master_keys_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create master keys data.",
+		 function );
+
+		goto on_error;
+	}
+	master_keys = (const uint8_t **) memory_allocate(
+	                                  sizeof( const uint8_t * ) * number_of_passwords );
+
+	if( master_keys == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create master keys.",
+		 function );
+
+		goto on_error;
+	}
+	master_key_sizes = (size_t *) memory_allocate(
+	                               sizeof( size_t ) * number_of_passwords );
+
+	if( master_key_sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create master key sizes.",
+		 function );
+
+		goto on_error;
+	}
+	validation_hashes_data = (uint8_t *) memory_allocate(
+	                                      sizeof( uint8_t ) * 20 * number_of_passwords );
+
+	if( validation_hashes_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create validation hashes data.",
+		 function );
+
+		goto on_error;
+	}
+	for( candidate_index = 0;
+	     candidate_index < number_of_passwords;
+	     candidate_index++ )
+	{
+		master_keys[ candidate_index ]      = &( master_keys_data[ candidate_index * master_key_size ] );
+		master_key_sizes[ candidate_index ] = master_key_size;
+	}
+	/* A separate encryption context is used so that the state of the volume
+	 * is not changed, the built-in provider is used since the key changes
+	 * for every password
+	 */
+	if( libluksde_encryption_initialize(
+	     &encryption_context,
+	     internal_volume->io_handle->encryption_method,
+	     internal_volume->io_handle->encryption_chaining_mode,
+	     internal_volume->io_handle->initialization_vector_mode,
+	     internal_volume->io_handle->essiv_hashing_method,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create encryption context.",
+		 function );
+
+		goto on_error;
+	}
+	/* The multi-buffer PBKDF2 runs all the iterations at once, hence its progress
+	 * is only updated when the key derivation completes
+	 */
+	libluksde_progress_set_abort(
+	 &( internal_volume->io_handle->key_slots_abort ),
+	 internal_volume->io_handle->abort );
+
+	progress.abort             = &( internal_volume->io_handle->key_slots_abort );
+	progress.callback_function = internal_volume->io_handle->progress_callback_function;
+	progress.callback_data     = internal_volume->io_handle->progress_callback_data;
+
+	for( slot_index = 0;
+	     slot_index < 8;
+	     slot_index++ )
+	{
+		if( libluksde_progress_get_abort(
+		     &( internal_volume->io_handle->key_slots_abort ) ) != 0 )
+		{
+			break;
+		}
+		if( libcdata_array_get_entry_by_index(
+		     internal_volume->io_handle->key_slots_array,
+		     slot_index,
+		     (intptr_t **) &key_slot,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve key slot: %d.",
+			 function,
+			 slot_index );
+
+			goto on_error;
+		}
+		if( key_slot == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing key slot: %d.",
+			 function,
+			 slot_index );
+
+			goto on_error;
+		}
+		if( key_slot->state != 0x00ac71f3 )
+		{
+			continue;
+		}
+		if( libluksde_internal_volume_get_key_material_size(
+		     internal_volume,
+		     key_slot,
+		     &key_material_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine key slot: %d key material size.",
+			 function,
+			 slot_index );
+
+			goto on_error;
+		}
+		key_material_data = (uint8_t *) memory_allocate(
+		                                 sizeof( uint8_t ) * key_material_size );
+
+		if( key_material_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create key material data.",
+			 function );
+
+			goto on_error;
+		}
+		split_master_key_data = (uint8_t *) memory_allocate(
+		                                     sizeof( uint8_t ) * key_material_size );
+
+		if( split_master_key_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create split master key data.",
+			 function );
+
+			goto on_error;
+		}
+		if( libluksde_internal_volume_read_key_material(
+		     internal_volume,
+		     file_io_handle,
+		     key_slot,
+		     key_material_data,
+		     key_material_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read key slot: %d key material.",
+			 function,
+			 slot_index );
+
+			goto on_error;
+		}
+		if( libluksde_password_pbkdf2_multi_buffer(
+		     passwords,
+		     password_sizes,
+		     number_of_passwords,
+		     internal_volume->io_handle->hashing_method,
+		     key_slot->salt,
+		     32,
+		     key_slot->number_of_iterations,
+		     user_keys_data,
+		     master_key_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine user keys.",
+			 function );
+
+			goto on_error;
+		}
+		progress.key_slot_index = slot_index;
+		progress.stage          = LIBLUKSDE_PROGRESS_STAGE_KEY_SLOT_PBKDF2;
+
+		result = libluksde_progress_update(
+		          &progress,
+		          (uint64_t) key_slot->number_of_iterations,
+		          (uint64_t) key_slot->number_of_iterations );
+
+		for( candidate_index = 0;
+		     candidate_index < number_of_passwords;
+		     candidate_index++ )
+		{
+			if( result == 0 )
+			{
+				break;
+			}
+			result = libluksde_internal_volume_decrypt_key_material(
+			          internal_volume,
+			          encryption_context,
+			          key_slot,
+			          &( user_keys_data[ candidate_index * master_key_size ] ),
+			          key_material_data,
+			          split_master_key_data,
+			          key_material_size,
+			          &( master_keys_data[ candidate_index * master_key_size ] ),
+			          &progress,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+				 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+				 "%s: unable to decrypt key slot: %d key material.",
+				 function,
+				 slot_index );
+
+				goto on_error;
+			}
+		}
+		if( result == 0 )
+		{
+			break;
+		}
+		result = 0;
+
+		if( libluksde_password_pbkdf2_multi_buffer(
+		     master_keys,
+		     master_key_sizes,
+		     number_of_passwords,
+		     internal_volume->io_handle->hashing_method,
+		     internal_volume->io_handle->master_key_salt,
+		     32,
+		     internal_volume->io_handle->master_key_number_of_iterations,
+		     validation_hashes_data,
+		     20,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine master key validation hashes.",
+			 function );
+
+			goto on_error;
+		}
+		progress.stage = LIBLUKSDE_PROGRESS_STAGE_MASTER_KEY_DIGEST;
+
+		if( libluksde_progress_update(
+		     &progress,
+		     (uint64_t) internal_volume->io_handle->master_key_number_of_iterations,
+		     (uint64_t) internal_volume->io_handle->master_key_number_of_iterations ) == 0 )
+		{
+			break;
+		}
+		for( candidate_index = 0;
+		     candidate_index < number_of_passwords;
+		     candidate_index++ )
+		{
+			if( memory_compare(
+			     &( validation_hashes_data[ candidate_index * 20 ] ),
+			     internal_volume->io_handle->master_key_validation_hash,
+			     20 ) == 0 )
+			{
+				if( memory_copy(
+				     internal_volume->io_handle->master_key,
+				     &( master_keys_data[ candidate_index * master_key_size ] ),
+				     master_key_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy master key.",
+					 function );
+
+					goto on_error;
+				}
+				*password_index = candidate_index;
+				*key_slot_index = slot_index;
+
+				result = 1;
+
+				break;
+			}
+		}
+		memory_free(
+		 key_material_data );
+
+		key_material_data = NULL;
+
+		memory_set(
+		 split_master_key_data,
+		 0,
+		 key_material_size );
+
+		memory_free(
+		 split_master_key_data );
+
+		split_master_key_data = NULL;
+
+		if( result != 0 )
+		{
+			break;
+		}
+	}
+	/* The key material is not freed in the loop if the key derivation was aborted
+	 */
+	if( split_master_key_data != NULL )
+	{
+		memory_set(
+		 split_master_key_data,
+		 0,
+		 key_material_size );
+
+		memory_free(
+		 split_master_key_data );
+
+		split_master_key_data = NULL;
+	}
+	if( key_material_data != NULL )
+	{
+		memory_free(
+		 key_material_data );
+
+		key_material_data = NULL;
+	}
+	if( libluksde_encryption_free(
+	     &encryption_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free encryption context.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 validation_hashes_data );
+
+	memory_free(
+	 master_key_sizes );
+
+	memory_free(
+	 master_keys );
+
+	memory_set(
+	 master_keys_data,
+	 0,
+	 master_key_size * number_of_passwords );
+
+	memory_free(
+	 master_keys_data );
+
+	memory_set(
+	 user_keys_data,
+	 0,
+	 master_key_size * number_of_passwords );
+
+	memory_free(
+	 user_keys_data );
+
+	return( result );
+
+on_error:
+	if( encryption_context != NULL )
+	{
+		libluksde_encryption_free(
+		 &encryption_context,
+		 NULL );
+	}
+	if( split_master_key_data != NULL )
+	{
+		memory_set(
+		 split_master_key_data,
+		 0,
+		 key_material_size );
+
+		memory_free(
+		 split_master_key_data );
+	}
+	if( key_material_data != NULL )
+	{
+		memory_free(
+		 key_material_data );
+	}
+	if( validation_hashes_data != NULL )
+	{
+		memory_free(
+		 validation_hashes_data );
+	}
+	if( master_key_sizes != NULL )
+	{
+		memory_free(
+		 master_key_sizes );
+	}
+	if( master_keys != NULL )
+	{
+		memory_free(
+		 master_keys );
 	}
-#endif
-	*size = internal_volume->io_handle->encrypted_volume_size;
+	if( master_keys_data != NULL )
+	{
+		memory_set(
+		 master_keys_data,
+		 0,
+		 master_key_size * number_of_passwords );
 
-#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+		memory_free(
+		 master_keys_data );
+	}
+	if( user_keys_data != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
-		 function );
+		memory_set(
+		 user_keys_data,
+		 0,
+		 master_key_size * number_of_passwords );
 
-		return( -1 );
+		memory_free(
+		 user_keys_data );
 	}
-#endif
-	return( 1 );
+	return( -1 );
 }
 
-/* Retrieves the encryption method
+/* Sets UTF-8 formatted candidate passwords
+ * The candidate passwords are tried, after the password set by libluksde_volume_set_utf8_password,
+ * when the volume is opened. This function needs to be used before one of the open functions
  * Returns 1 if successful or -1 on error
  */
-int libluksde_volume_get_encryption_method(
+int libluksde_volume_set_utf8_passwords(
      libluksde_volume_t *volume,
-     int *encryption_method,
-     int *encryption_chaining_mode,
+     const uint8_t **utf8_strings,
+     const size_t *utf8_string_lengths,
+     int number_of_strings,
      libcerror_error_t **error )
 {
 	libluksde_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libluksde_volume_get_encryption_method";
+	uint8_t **passwords                          = NULL;
+	size_t *password_sizes                       = NULL;
+	static char *function                        = "libluksde_volume_set_utf8_passwords";
+	int password_index                           = 0;
 
 	if( volume == NULL )
 	{
@@ -2562,134 +5973,149 @@ int libluksde_volume_get_encryption_method(
 
 		return( -1 );
 	}
-	if( encryption_method == NULL )
+	if( internal_volume->file_io_handle != NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid encryption method.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( encryption_chaining_mode == NULL )
+	if( utf8_strings == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid encryption chaining mode.",
-		 function );
-
-		return( -1 );
-	}
-#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: invalid UTF-8 strings.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	*encryption_method        = internal_volume->io_handle->encryption_method;
-	*encryption_chaining_mode = internal_volume->io_handle->encryption_chaining_mode;
-
-#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	if( utf8_string_lengths == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string lengths.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	return( 1 );
-}
-
-/* Sets the keys
- * This function needs to be used before one of the open functions
- * Returns 1 if successful or -1 on error
- */
-int libluksde_volume_set_keys(
-     libluksde_volume_t *volume,
-     const uint8_t *master_key,
-     size_t master_key_size,
-     libcerror_error_t **error )
-{
-	libluksde_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libluksde_volume_set_keys";
-
-	if( volume == NULL )
+	if( ( number_of_strings <= 0 )
+	 || ( (size_t) number_of_strings > ( (size_t) SSIZE_MAX / 64 ) ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid volume.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of strings value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	internal_volume = (libluksde_internal_volume_t *) volume;
+	passwords = (uint8_t **) memory_allocate(
+	                          sizeof( uint8_t * ) * number_of_strings );
 
-	if( internal_volume->io_handle == NULL )
+	if( passwords == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create passwords.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( internal_volume->file_io_handle != NULL )
+	if( memory_set(
+	     passwords,
+	     0,
+	     sizeof( uint8_t * ) * number_of_strings ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid volume - file IO handle already set.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear passwords.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( master_key == NULL )
+	password_sizes = (size_t *) memory_allocate(
+	                             sizeof( size_t ) * number_of_strings );
+
+	if( password_sizes == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid master key.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create password sizes.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( ( master_key_size != 16 )
-	 && ( master_key_size != 32 ) )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported master key size.",
-		 function );
+	/* The passwords are converted the same way as by libluksde_volume_set_utf8_password
+	 */
+	for( password_index = 0;
+	     password_index < number_of_strings;
+	     password_index++ )
+	{
+		if( libuna_byte_stream_size_from_utf8(
+		     utf8_strings[ password_index ],
+		     utf8_string_lengths[ password_index ],
+		     LIBLUKSDE_CODEPAGE_US_ASCII,
+		     &( password_sizes[ password_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine password: %d size.",
+			 function,
+			 password_index );
 
-		return( -1 );
+			goto on_error;
+		}
+		passwords[ password_index ] = (uint8_t *) memory_allocate(
+		                                           sizeof( uint8_t ) * ( password_sizes[ password_index ] + 1 ) );
+
+		if( passwords[ password_index ] == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create password: %d.",
+			 function,
+			 password_index );
+
+			goto on_error;
+		}
+		if( libuna_byte_stream_copy_from_utf8(
+		     passwords[ password_index ],
+		     password_sizes[ password_index ] + 1,
+		     LIBLUKSDE_CODEPAGE_US_ASCII,
+		     utf8_strings[ password_index ],
+		     utf8_string_lengths[ password_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to copy password: %d.",
+			 function,
+			 password_index );
+
+			goto on_error;
+		}
 	}
 #if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
@@ -2703,43 +6129,30 @@ int libluksde_volume_set_keys(
 		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 #endif
-	if( master_key_size < 32 )
-	{
-		if( memory_set(
-		     internal_volume->io_handle->master_key,
-		     0,
-		     32  ) == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-			 "%s: unable to clear master key.",
-			 function );
-
-			goto on_error;
-		}
-	}
-	if( memory_copy(
-	     internal_volume->io_handle->master_key,
-	     master_key,
-	     master_key_size ) == NULL )
+	if( libluksde_io_handle_free_candidate_passwords(
+	     internal_volume->io_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to copy master key.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free candidate passwords.",
 		 function );
 
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+		libcthreads_read_write_lock_release_for_write(
+		 internal_volume->read_write_lock,
+		 NULL );
+#endif
 		goto on_error;
 	}
-	internal_volume->io_handle->master_key_size = (uint32_t) master_key_size;
-
-	internal_volume->io_handle->keys_are_set = 1;
+	internal_volume->io_handle->candidate_passwords           = passwords;
+	internal_volume->io_handle->candidate_password_sizes      = password_sizes;
+	internal_volume->io_handle->number_of_candidate_passwords = number_of_strings;
 
 #if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -2759,31 +6172,51 @@ int libluksde_volume_set_keys(
 	return( 1 );
 
 on_error:
-	memory_set(
-	 internal_volume->io_handle->master_key,
-	 0,
-	 32 );
+	if( passwords != NULL )
+	{
+		for( password_index = 0;
+		     password_index < number_of_strings;
+		     password_index++ )
+		{
+			if( passwords[ password_index ] != NULL )
+			{
+				memory_set(
+				 passwords[ password_index ],
+				 0,
+				 password_sizes[ password_index ] + 1 );
 
-#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_volume->read_write_lock,
-	 NULL );
-#endif
+				memory_free(
+				 passwords[ password_index ] );
+			}
+		}
+		memory_free(
+		 passwords );
+	}
+	if( password_sizes != NULL )
+	{
+		memory_free(
+		 password_sizes );
+	}
 	return( -1 );
 }
 
-/* Sets an UTF-8 formatted password
- * This function needs to be used before one of the open functions
- * Returns 1 if successful, 0 if password is invalid or -1 on error
+/* Sets UTF-16 formatted candidate passwords
+ * The candidate passwords are tried, after the password set by libluksde_volume_set_utf16_password,
+ * when the volume is opened. This function needs to be used before one of the open functions
+ * Returns 1 if successful or -1 on error
  */
-int libluksde_volume_set_utf8_password(
+int libluksde_volume_set_utf16_passwords(
      libluksde_volume_t *volume,
-     const uint8_t *utf8_string,
-     size_t utf8_string_length,
+     const uint16_t **utf16_strings,
+     const size_t *utf16_string_lengths,
+     int number_of_strings,
      libcerror_error_t **error )
 {
 	libluksde_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libluksde_volume_set_utf8_password";
+	uint8_t **passwords                          = NULL;
+	size_t *password_sizes                       = NULL;
+	static char *function                        = "libluksde_volume_set_utf16_passwords";
+	int password_index                           = 0;
 
 	if( volume == NULL )
 	{
@@ -2820,110 +6253,176 @@ int libluksde_volume_set_utf8_password(
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	if( utf16_strings == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-16 strings.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( internal_volume->io_handle->user_password != NULL )
+	if( utf16_string_lengths == NULL )
 	{
-		if( memory_set(
-		     internal_volume->io_handle->user_password,
-		     0,
-		     internal_volume->io_handle->user_password_size ) == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-			 "%s: unable to user password.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-16 string lengths.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_strings <= 0 )
+	 || ( (size_t) number_of_strings > ( (size_t) SSIZE_MAX / 64 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of strings value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	passwords = (uint8_t **) memory_allocate(
+	                          sizeof( uint8_t * ) * number_of_strings );
+
+	if( passwords == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create passwords.",
+		 function );
 
-#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
-			libcthreads_read_write_lock_release_for_write(
-			 internal_volume->read_write_lock,
-			 NULL );
-#endif
-			return( -1 );
-		}
-		memory_free(
-		 internal_volume->io_handle->user_password );
+		goto on_error;
+	}
+	if( memory_set(
+	     passwords,
+	     0,
+	     sizeof( uint8_t * ) * number_of_strings ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear passwords.",
+		 function );
 
-		internal_volume->io_handle->user_password      = NULL;
-		internal_volume->io_handle->user_password_size = 0;
+		goto on_error;
 	}
-	if( libuna_byte_stream_size_from_utf8(
-	     utf8_string,
-	     utf8_string_length,
-	     LIBLUKSDE_CODEPAGE_US_ASCII,
-	     &( internal_volume->io_handle->user_password_size ),
-	     error ) != 1 )
+	password_sizes = (size_t *) memory_allocate(
+	                             sizeof( size_t ) * number_of_strings );
+
+	if( password_sizes == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set password size.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create password sizes.",
 		 function );
 
 		goto on_error;
 	}
-	internal_volume->io_handle->user_password_size += 1;
+	/* The passwords are converted the same way as by libluksde_volume_set_utf16_password
+	 */
+	for( password_index = 0;
+	     password_index < number_of_strings;
+	     password_index++ )
+	{
+		if( libuna_byte_stream_size_from_utf16(
+		     utf16_strings[ password_index ],
+		     utf16_string_lengths[ password_index ],
+		     LIBLUKSDE_CODEPAGE_US_ASCII,
+		     &( password_sizes[ password_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine password: %d size.",
+			 function,
+			 password_index );
 
-	internal_volume->io_handle->user_password = (uint8_t *) memory_allocate(
-	                                                         sizeof( uint8_t ) * internal_volume->io_handle->user_password_size );
+			goto on_error;
+		}
+		passwords[ password_index ] = (uint8_t *) memory_allocate(
+		                                           sizeof( uint8_t ) * ( password_sizes[ password_index ] + 1 ) );
 
-	if( internal_volume->io_handle->user_password == NULL )
+		if( passwords[ password_index ] == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create password: %d.",
+			 function,
+			 password_index );
+
+			goto on_error;
+		}
+		if( libuna_byte_stream_copy_from_utf16(
+		     passwords[ password_index ],
+		     password_sizes[ password_index ] + 1,
+		     LIBLUKSDE_CODEPAGE_US_ASCII,
+		     utf16_strings[ password_index ],
+		     utf16_string_lengths[ password_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to copy password: %d.",
+			 function,
+			 password_index );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to create user password.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		goto on_error;
 	}
-	if( libuna_byte_stream_copy_from_utf8(
-	     internal_volume->io_handle->user_password,
-	     internal_volume->io_handle->user_password_size,
-	     LIBLUKSDE_CODEPAGE_US_ASCII,
-	     utf8_string,
-	     utf8_string_length,
+#endif
+	if( libluksde_io_handle_free_candidate_passwords(
+	     internal_volume->io_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to copy user password.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free candidate passwords.",
 		 function );
 
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+		libcthreads_read_write_lock_release_for_write(
+		 internal_volume->read_write_lock,
+		 NULL );
+#endif
 		goto on_error;
 	}
-	internal_volume->io_handle->user_password[ internal_volume->io_handle->user_password_size - 1 ] = 0;
-
-	internal_volume->io_handle->user_password_is_set = 1;
+	internal_volume->io_handle->candidate_passwords           = passwords;
+	internal_volume->io_handle->candidate_password_sizes      = password_sizes;
+	internal_volume->io_handle->number_of_candidate_passwords = number_of_strings;
 
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "%s: user password: %s\n",
-		 function,
-		 internal_volume->io_handle->user_password );
-	}
-#endif
 #if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_volume->read_write_lock,
@@ -2942,39 +6441,48 @@ int libluksde_volume_set_utf8_password(
 	return( 1 );
 
 on_error:
-	if( internal_volume->io_handle->user_password != NULL )
+	if( passwords != NULL )
 	{
-		memory_set(
-		 internal_volume->io_handle->user_password,
-		 0,
-		 internal_volume->io_handle->user_password_size );
-		memory_free(
-		 internal_volume->io_handle->user_password );
+		for( password_index = 0;
+		     password_index < number_of_strings;
+		     password_index++ )
+		{
+			if( passwords[ password_index ] != NULL )
+			{
+				memory_set(
+				 passwords[ password_index ],
+				 0,
+				 password_sizes[ password_index ] + 1 );
 
-		internal_volume->io_handle->user_password = NULL;
+				memory_free(
+				 passwords[ password_index ] );
+			}
+		}
+		memory_free(
+		 passwords );
+	}
+	if( password_sizes != NULL )
+	{
+		memory_free(
+		 password_sizes );
 	}
-	internal_volume->io_handle->user_password_size = 0;
-
-#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_volume->read_write_lock,
-	 NULL );
-#endif
 	return( -1 );
 }
 
-/* Sets an UTF-16 formatted password
- * This function needs to be used before one of the open functions
- * Returns 1 if successful, 0 if password is invalid or -1 on error
+/* Retrieves the indexes of the candidate password and key slot that unlocked the volume
+ * The password index is -1 if the volume was unlocked with the password set by
+ * libluksde_volume_set_utf8_password or libluksde_volume_set_utf16_password
+ * Returns 1 if successful, 0 if the volume was not unlocked with a key slot or -1 on error
  */
-int libluksde_volume_set_utf16_password(
+int libluksde_volume_get_unlocked_key_slot(
      libluksde_volume_t *volume,
-     const uint16_t *utf16_string,
-     size_t utf16_string_length,
+     int *password_index,
+     int *key_slot_index,
      libcerror_error_t **error )
 {
 	libluksde_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libluksde_volume_set_utf16_password";
+	static char *function                        = "libluksde_volume_get_unlocked_key_slot";
+	int result                                   = 0;
 
 	if( volume == NULL )
 	{
@@ -3000,123 +6508,52 @@ int libluksde_volume_set_utf16_password(
 
 		return( -1 );
 	}
-	if( internal_volume->file_io_handle != NULL )
+	if( password_index == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid volume - file IO handle already set.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid password index.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	if( key_slot_index == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key slot index.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( internal_volume->io_handle->user_password != NULL )
-	{
-		if( memory_set(
-		     internal_volume->io_handle->user_password,
-		     0,
-		     internal_volume->io_handle->user_password_size ) == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-			 "%s: unable to user password.",
-			 function );
-
 #if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
-			libcthreads_read_write_lock_release_for_write(
-			 internal_volume->read_write_lock,
-			 NULL );
-#endif
-			return( -1 );
-		}
-		memory_free(
-		 internal_volume->io_handle->user_password );
-
-		internal_volume->io_handle->user_password      = NULL;
-		internal_volume->io_handle->user_password_size = 0;
-	}
-	if( libuna_byte_stream_size_from_utf16(
-	     utf16_string,
-	     utf16_string_length,
-	     LIBLUKSDE_CODEPAGE_US_ASCII,
-	     &( internal_volume->io_handle->user_password_size ),
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set password length.",
-		 function );
-
-		goto on_error;
-	}
-	internal_volume->io_handle->user_password_size += 1;
-
-	internal_volume->io_handle->user_password = (uint8_t *) memory_allocate(
-	                                                         sizeof( uint8_t ) * internal_volume->io_handle->user_password_size );
-
-	if( internal_volume->io_handle->user_password == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to create user password.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libuna_byte_stream_copy_from_utf16(
-	     internal_volume->io_handle->user_password,
-	     internal_volume->io_handle->user_password_size,
-	     LIBLUKSDE_CODEPAGE_US_ASCII,
-	     utf16_string,
-	     utf16_string_length,
-	     error ) != 1 )
+#endif
+	if( internal_volume->io_handle->unlocked_key_slot_index != -1 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to copy user password.",
-		 function );
-
-		goto on_error;
-	}
-	internal_volume->io_handle->user_password[ internal_volume->io_handle->user_password_size - 1 ] = 0;
-
-	internal_volume->io_handle->user_password_is_set = 1;
+		*password_index = internal_volume->io_handle->unlocked_candidate_password_index;
+		*key_slot_index = internal_volume->io_handle->unlocked_key_slot_index;
 
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "%s: user password: %s\n",
-		 function,
-		 internal_volume->io_handle->user_password );
+		result = 1;
 	}
-#endif
 #if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -3124,33 +6561,12 @@ int libluksde_volume_set_utf16_password(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( 1 );
-
-on_error:
-	if( internal_volume->io_handle->user_password != NULL )
-	{
-		memory_set(
-		 internal_volume->io_handle->user_password,
-		 0,
-		 internal_volume->io_handle->user_password_size );
-		memory_free(
-		 internal_volume->io_handle->user_password );
-
-		internal_volume->io_handle->user_password = NULL;
-	}
-	internal_volume->io_handle->user_password_size = 0;
-
-#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_volume->read_write_lock,
-	 NULL );
-#endif
-	return( -1 );
+	return( result );
 }
 
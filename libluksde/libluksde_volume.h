@@ -25,13 +25,18 @@
 #include <common.h>
 #include <types.h>
 
+#include "libluksde_encryption.h"
 #include "libluksde_extern.h"
 #include "libluksde_io_handle.h"
+#include "libluksde_key_slot.h"
+#include "libluksde_key_slot_trial.h"
 #include "libluksde_libbfio.h"
 #include "libluksde_libcerror.h"
 #include "libluksde_libcthreads.h"
 #include "libluksde_libfcache.h"
 #include "libluksde_libfdata.h"
+#include "libluksde_progress.h"
+#include "libluksde_readahead.h"
 #include "libluksde_types.h"
 
 #if defined( __cplusplus )
@@ -46,13 +51,29 @@ struct libluksde_internal_volume
 	 */
 	off64_t current_offset;
 
-	/* The sectors vector
+	/* The chunks vector
 	 */
-	libfdata_vector_t *sectors_vector;
+	libfdata_vector_t *chunks_vector;
 
-	/* The sectors cache
+	/* The chunks cache
 	 */
-	libfcache_cache_t *sectors_cache;
+	libfcache_cache_t *chunks_cache;
+
+	/* The chunk size
+	 */
+	size_t chunk_size;
+
+	/* The number of entries of the chunks cache
+	 */
+	int number_of_cache_entries;
+
+	/* The minimum number of chunks that are read ahead
+	 */
+	int minimum_number_of_readahead_chunks;
+
+	/* The maximum number of chunks that are read ahead, 0 disables the readahead
+	 */
+	int maximum_number_of_readahead_chunks;
 
 	/* The file IO handle
 	 */
@@ -78,6 +99,14 @@ struct libluksde_internal_volume
 	/* The read/write lock
 	 */
 	libcthreads_read_write_lock_t *read_write_lock;
+
+	/* The readahead
+	 */
+	libluksde_readahead_t *readahead;
+
+	/* Value to indicate the readahead could not be created
+	 */
+	uint8_t readahead_is_unavailable;
 #endif
 };
 
@@ -131,6 +160,49 @@ int libluksde_volume_open_read(
      libbfio_handle_t *file_io_handle,
      libcerror_error_t **error );
 
+int libluksde_internal_volume_get_key_material_size(
+     libluksde_internal_volume_t *internal_volume,
+     libluksde_key_slot_t *key_slot,
+     size_t *key_material_size,
+     libcerror_error_t **error );
+
+int libluksde_internal_volume_read_key_material(
+     libluksde_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     libluksde_key_slot_t *key_slot,
+     uint8_t *key_material_data,
+     size_t key_material_size,
+     libcerror_error_t **error );
+
+int libluksde_internal_volume_decrypt_key_material(
+     libluksde_internal_volume_t *internal_volume,
+     libluksde_encryption_context_t *encryption_context,
+     libluksde_key_slot_t *key_slot,
+     const uint8_t *user_key,
+     const uint8_t *key_material_data,
+     uint8_t *split_master_key_data,
+     size_t key_material_size,
+     uint8_t *master_key,
+     libluksde_progress_t *progress,
+     libcerror_error_t **error );
+
+int libluksde_internal_volume_try_key_slot(
+     libluksde_internal_volume_t *internal_volume,
+     libluksde_key_slot_trial_t *key_slot_trial,
+     const uint8_t *password,
+     size_t password_size,
+     libcerror_error_t **error );
+
+int libluksde_internal_volume_key_slot_trial_callback(
+     libluksde_key_slot_trial_t *key_slot_trial,
+     libluksde_internal_volume_t *internal_volume );
+
+int libluksde_internal_volume_try_key_slots(
+     libluksde_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     int *key_slot_index,
+     libcerror_error_t **error );
+
 LIBLUKSDE_EXTERN \
 int libluksde_volume_is_locked(
      libluksde_volume_t *volume,
@@ -209,6 +281,85 @@ int libluksde_volume_get_encryption_method(
      int *encryption_chaining_mode,
      libcerror_error_t **error );
 
+LIBLUKSDE_EXTERN \
+int libluksde_volume_get_hashing_method(
+     libluksde_volume_t *volume,
+     int *hashing_method,
+     libcerror_error_t **error );
+
+LIBLUKSDE_EXTERN \
+int libluksde_volume_get_master_key_parameters(
+     libluksde_volume_t *volume,
+     size_t *master_key_size,
+     uint32_t *number_of_iterations,
+     libcerror_error_t **error );
+
+LIBLUKSDE_EXTERN \
+int libluksde_volume_get_number_of_key_slots(
+     libluksde_volume_t *volume,
+     int *number_of_key_slots,
+     libcerror_error_t **error );
+
+LIBLUKSDE_EXTERN \
+int libluksde_volume_get_key_slot_parameters(
+     libluksde_volume_t *volume,
+     int key_slot_index,
+     uint32_t *number_of_iterations,
+     uint32_t *number_of_stripes,
+     libcerror_error_t **error );
+
+LIBLUKSDE_EXTERN \
+int libluksde_volume_probe_pbkdf2(
+     libluksde_volume_t *volume,
+     uint32_t number_of_iterations,
+     size_t key_size,
+     libcerror_error_t **error );
+
+LIBLUKSDE_EXTERN \
+int libluksde_volume_set_encryption_provider(
+     libluksde_volume_t *volume,
+     int encryption_provider,
+     libcerror_error_t **error );
+
+LIBLUKSDE_EXTERN \
+int libluksde_volume_set_essiv_cache_size(
+     libluksde_volume_t *volume,
+     int number_of_cache_entries,
+     libcerror_error_t **error );
+
+LIBLUKSDE_EXTERN \
+int libluksde_volume_set_chunk_cache_parameters(
+     libluksde_volume_t *volume,
+     size_t chunk_size,
+     int number_of_cache_entries,
+     libcerror_error_t **error );
+
+LIBLUKSDE_EXTERN \
+int libluksde_volume_set_readahead_parameters(
+     libluksde_volume_t *volume,
+     int minimum_number_of_chunks,
+     int maximum_number_of_chunks,
+     libcerror_error_t **error );
+
+LIBLUKSDE_EXTERN \
+int libluksde_volume_get_readahead_statistics(
+     libluksde_volume_t *volume,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error );
+
+LIBLUKSDE_EXTERN \
+int libluksde_volume_set_progress_callback(
+     libluksde_volume_t *volume,
+     int (*progress_callback_function)(
+            void *callback_data,
+            int key_slot_index,
+            int stage,
+            uint64_t value,
+            uint64_t maximum_value ),
+     void *callback_data,
+     libcerror_error_t **error );
+
 LIBLUKSDE_EXTERN \
 int libluksde_volume_set_keys(
      libluksde_volume_t *volume,
@@ -230,6 +381,39 @@ int libluksde_volume_set_utf16_password(
      size_t utf16_string_length,
      libcerror_error_t **error );
 
+int libluksde_internal_volume_test_passwords(
+     libluksde_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     const uint8_t **passwords,
+     const size_t *password_sizes,
+     int number_of_passwords,
+     int *password_index,
+     int *key_slot_index,
+     libcerror_error_t **error );
+
+LIBLUKSDE_EXTERN \
+int libluksde_volume_set_utf8_passwords(
+     libluksde_volume_t *volume,
+     const uint8_t **utf8_strings,
+     const size_t *utf8_string_lengths,
+     int number_of_strings,
+     libcerror_error_t **error );
+
+LIBLUKSDE_EXTERN \
+int libluksde_volume_set_utf16_passwords(
+     libluksde_volume_t *volume,
+     const uint16_t **utf16_strings,
+     const size_t *utf16_string_lengths,
+     int number_of_strings,
+     libcerror_error_t **error );
+
+LIBLUKSDE_EXTERN \
+int libluksde_volume_get_unlocked_key_slot(
+     libluksde_volume_t *volume,
+     int *password_index,
+     int *key_slot_index,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
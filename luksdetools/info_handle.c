@@ -28,6 +28,8 @@
 #include <types.h>
 #include <wide_string.h>
 
+#include <time.h>
+
 #include "luksdetools_libluksde.h"
 #include "luksdetools_libbfio.h"
 #include "luksdetools_libcerror.h"
@@ -570,7 +572,7 @@ int info_handle_set_keys(
 
 			goto on_error;
 		}
-		full_volume_encryption_key_size = 32;
+		full_volume_encryption_key_size = 64;
 	}
 	else if( ( string_segment_size == 33 )
 	      || ( string_segment_size == 65 ) )
@@ -1071,3 +1073,357 @@ int info_handle_volume_fprint(
 	return( 1 );
 }
 
+/* Retrieves the value of a monotonic clock in nanoseconds
+ */
+uint64_t info_handle_get_time(
+          void )
+{
+#if defined( CLOCK_MONOTONIC )
+	struct timespec time_value;
+
+	clock_gettime(
+	 CLOCK_MONOTONIC,
+	 &time_value );
+
+	return( ( (uint64_t) time_value.tv_sec * 1000000000UL ) + (uint64_t) time_value.tv_nsec );
+#else
+	return( (uint64_t) clock() * ( 1000000000UL / CLOCKS_PER_SEC ) );
+#endif
+}
+
+/* Measures the number of PBKDF2 iterations per second of this host for a specific key size
+ * The number of iterations is doubled until a run takes at least INFO_HANDLE_PBKDF2_PROBE_TIME
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_probe_pbkdf2(
+     info_handle_t *info_handle,
+     size_t key_size,
+     uint64_t *iterations_per_second,
+     libcerror_error_t **error )
+{
+	static char *function         = "info_handle_probe_pbkdf2";
+	uint64_t elapsed_time         = 0;
+	uint64_t start_time           = 0;
+	uint32_t number_of_iterations = 1000;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( iterations_per_second == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid iterations per second.",
+		 function );
+
+		return( -1 );
+	}
+	if( key_size > 64 )
+	{
+		key_size = 64;
+	}
+	while( info_handle->abort == 0 )
+	{
+		start_time = info_handle_get_time();
+
+		if( libluksde_volume_probe_pbkdf2(
+		     info_handle->input_volume,
+		     number_of_iterations,
+		     key_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to probe PBKDF2 with: %" PRIu32 " iterations.",
+			 function,
+			 number_of_iterations );
+
+			return( -1 );
+		}
+		elapsed_time = info_handle_get_time() - start_time;
+
+		if( ( elapsed_time >= INFO_HANDLE_PBKDF2_PROBE_TIME )
+		 || ( number_of_iterations >= (uint32_t) 0x40000000UL ) )
+		{
+			break;
+		}
+		number_of_iterations *= 2;
+	}
+	if( elapsed_time == 0 )
+	{
+		elapsed_time = 1;
+	}
+	*iterations_per_second = ( (uint64_t) number_of_iterations * 1000000000UL ) / elapsed_time;
+
+	if( *iterations_per_second == 0 )
+	{
+		*iterations_per_second = 1;
+	}
+	return( 1 );
+}
+
+/* Prints the estimated unlock cost of the volume to a stream
+ * The cost is predicted from the PBKDF2 throughput of this host
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_unlock_cost_fprint(
+     info_handle_t *info_handle,
+     libcerror_error_t **error )
+{
+	static char *function                    = "info_handle_unlock_cost_fprint";
+	size_t master_key_size                   = 0;
+	uint64_t digest_iterations_per_second    = 0;
+	uint64_t digest_time                     = 0;
+	uint64_t key_slot_iterations_per_second  = 0;
+	uint64_t key_slot_time                   = 0;
+	uint32_t master_key_number_of_iterations = 0;
+	uint32_t number_of_iterations            = 0;
+	uint32_t number_of_stripes               = 0;
+	int hashing_method                       = 0;
+	int key_slot_index                       = 0;
+	int number_of_key_slots                  = 0;
+	int result                               = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libluksde_volume_get_hashing_method(
+	     info_handle->input_volume,
+	     &hashing_method,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve hashing method.",
+		 function );
+
+		return( -1 );
+	}
+	if( libluksde_volume_get_master_key_parameters(
+	     info_handle->input_volume,
+	     &master_key_size,
+	     &master_key_number_of_iterations,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve master key parameters.",
+		 function );
+
+		return( -1 );
+	}
+	if( libluksde_volume_get_number_of_key_slots(
+	     info_handle->input_volume,
+	     &number_of_key_slots,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of key slots.",
+		 function );
+
+		return( -1 );
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "Unlock cost estimate:\n" );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 "\tHashing method:\t\t\t" );
+
+	switch( hashing_method )
+	{
+		case LIBLUKSDE_HASHING_METHOD_RIPEMD160:
+			fprintf(
+			 info_handle->notify_stream,
+			 "RIPEMD-160" );
+
+			break;
+
+		case LIBLUKSDE_HASHING_METHOD_SHA1:
+			fprintf(
+			 info_handle->notify_stream,
+			 "SHA1" );
+
+			break;
+
+		case LIBLUKSDE_HASHING_METHOD_SHA224:
+			fprintf(
+			 info_handle->notify_stream,
+			 "SHA224" );
+
+			break;
+
+		case LIBLUKSDE_HASHING_METHOD_SHA256:
+			fprintf(
+			 info_handle->notify_stream,
+			 "SHA256" );
+
+			break;
+
+		case LIBLUKSDE_HASHING_METHOD_SHA512:
+			fprintf(
+			 info_handle->notify_stream,
+			 "SHA512" );
+
+			break;
+
+		default:
+			fprintf(
+			 info_handle->notify_stream,
+			 "Unknown" );
+
+			break;
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "\n" );
+
+	/* The key slot key has the size of the master key while the master key digest is 20 bytes,
+	 * which can require a different number of hash blocks per iteration
+	 */
+	if( info_handle_probe_pbkdf2(
+	     info_handle,
+	     master_key_size,
+	     &key_slot_iterations_per_second,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to probe key slot PBKDF2 throughput.",
+		 function );
+
+		return( -1 );
+	}
+	if( info_handle_probe_pbkdf2(
+	     info_handle,
+	     20,
+	     &digest_iterations_per_second,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to probe master key digest PBKDF2 throughput.",
+		 function );
+
+		return( -1 );
+	}
+	if( info_handle->abort != 0 )
+	{
+		return( 1 );
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "\tPBKDF2 iterations per second:\t%" PRIu64 " (%" PRIzd " byte key)\n",
+	 key_slot_iterations_per_second,
+	 master_key_size );
+
+	digest_time = ( (uint64_t) master_key_number_of_iterations * 1000000UL ) / digest_iterations_per_second;
+
+	fprintf(
+	 info_handle->notify_stream,
+	 "\tMaster key digest iterations:\t%" PRIu32 "\n",
+	 master_key_number_of_iterations );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 "\tMaster key digest time:\t\t%" PRIu64 ".%03" PRIu64 " ms\n",
+	 digest_time / 1000,
+	 digest_time % 1000 );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 "\n" );
+
+	for( key_slot_index = 0;
+	     key_slot_index < number_of_key_slots;
+	     key_slot_index++ )
+	{
+		result = libluksde_volume_get_key_slot_parameters(
+		          info_handle->input_volume,
+		          key_slot_index,
+		          &number_of_iterations,
+		          &number_of_stripes,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve key slot: %d parameters.",
+			 function,
+			 key_slot_index );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			continue;
+		}
+		/* The time of the anti-forensic merge is negligible compared to PBKDF2
+		 */
+		key_slot_time = ( (uint64_t) number_of_iterations * 1000000UL ) / key_slot_iterations_per_second;
+
+		fprintf(
+		 info_handle->notify_stream,
+		 "Key slot: %d\n",
+		 key_slot_index );
+
+		fprintf(
+		 info_handle->notify_stream,
+		 "\tNumber of iterations:\t\t%" PRIu32 "\n",
+		 number_of_iterations );
+
+		fprintf(
+		 info_handle->notify_stream,
+		 "\tNumber of stripes:\t\t%" PRIu32 "\n",
+		 number_of_stripes );
+
+		key_slot_time += digest_time;
+
+		fprintf(
+		 info_handle->notify_stream,
+		 "\tEstimated unlock time:\t\t%" PRIu64 ".%03" PRIu64 " ms\n",
+		 key_slot_time / 1000,
+		 key_slot_time % 1000 );
+
+		fprintf(
+		 info_handle->notify_stream,
+		 "\n" );
+	}
+	return( 1 );
+}
+
@@ -34,6 +34,10 @@
 extern "C" {
 #endif
 
+/* The minimum duration of a PBKDF2 probe run in nanoseconds
+ */
+#define INFO_HANDLE_PBKDF2_PROBE_TIME		100000000UL
+
 typedef struct info_handle info_handle_t;
 
 struct info_handle
@@ -109,6 +113,19 @@ int info_handle_volume_fprint(
      info_handle_t *info_handle,
      libcerror_error_t **error );
 
+uint64_t info_handle_get_time(
+          void );
+
+int info_handle_probe_pbkdf2(
+     info_handle_t *info_handle,
+     size_t key_size,
+     uint64_t *iterations_per_second,
+     libcerror_error_t **error );
+
+int info_handle_unlock_cost_fprint(
+     info_handle_t *info_handle,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -60,10 +60,12 @@ void usage_fprint(
 	                 "Key Setup (LUKS) volume\n\n" );
 
 	fprintf( stream, "Usage: luksdeinfo [ -k keys ] [ -o offset ] [ -p password ]\n"
-	                 "                  [ -hvV ] source\n\n" );
+	                 "                  [ -chvV ] source\n\n" );
 
 	fprintf( stream, "\tsource: the source file or device\n\n" );
 
+	fprintf( stream, "\t-c:     estimate the unlock cost of the active key slots on\n"
+	                 "\t        this host\n" );
 	fprintf( stream, "\t-h:     shows this help\n" );
 	fprintf( stream, "\t-k:     the master key, formatted in base16\n" );
 	fprintf( stream, "\t-o:     specify the volume offset\n" );
@@ -131,6 +133,7 @@ int main( int argc, char * const argv[] )
 	system_character_t *source               = NULL;
 	char *program                            = "luksdeinfo";
 	system_integer_t option                  = 0;
+	int print_unlock_cost                    = 0;
 	int result                               = 0;
 	int verbose                              = 0;
 
@@ -167,7 +170,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = luksdetools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "hk:o:p:vV" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "chk:o:p:vV" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -183,6 +186,11 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_FAILURE );
 
+			case (system_integer_t) 'c':
+				print_unlock_cost = 1;
+
+				break;
+
 			case (system_integer_t) 'h':
 				usage_fprint(
 				 stdout );
@@ -313,17 +321,36 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
-	result = info_handle_input_is_locked(
-	          luksdeinfo_info_handle,
-	          &error );
+	/* The unlock cost can be estimated without a password or keys
+	 * hence a locked volume is not considered an error
+	 */
+	if( print_unlock_cost != 0 )
+	{
+		if( info_handle_unlock_cost_fprint(
+		     luksdeinfo_info_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to print unlock cost estimate.\n" );
 
-	if( result != 0 )
+			goto on_error;
+		}
+	}
+	else
 	{
-		fprintf(
-		 stderr,
-		 "Unable to unlock volume.\n" );
+		result = info_handle_input_is_locked(
+		          luksdeinfo_info_handle,
+		          &error );
 
-		goto on_error;
+		if( result != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to unlock volume.\n" );
+
+			goto on_error;
+		}
 	}
 	if( info_handle_close_input(
 	     luksdeinfo_info_handle,
@@ -564,7 +564,7 @@ int mount_handle_set_keys(
 
 			goto on_error;
 		}
-		full_volume_encryption_key_size = 32;
+		full_volume_encryption_key_size = 64;
 	}
 	else if( ( string_segment_size == 33 )
 	      || ( string_segment_size == 65 ) )
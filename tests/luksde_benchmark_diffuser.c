@@ -0,0 +1,189 @@
+/*
+ * Library diffuser functions microbenchmark program
+ *
+ * Copyright (C) 2013-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "luksde_benchmark_functions.h"
+#include "luksde_test_libcerror.h"
+#include "luksde_test_libluksde.h"
+#include "luksde_test_unused.h"
+
+#include "../libluksde/libluksde_definitions.h"
+#include "../libluksde/libluksde_diffuser.h"
+
+/* The number of anti-forensic stripes of a LUKS key slot
+ */
+#define LUKSDE_BENCHMARK_NUMBER_OF_STRIPES	4000
+
+/* The maximum size of the master key
+ */
+#define LUKSDE_BENCHMARK_MAXIMUM_KEY_SIZE	64
+
+/* The number of merges of a run
+ */
+#define LUKSDE_BENCHMARK_NUMBER_OF_MERGES	200
+
+/* The master key sizes of AES-CBC and AES-XTS with 256-bit keys
+ */
+luksde_benchmark_configuration_t luksde_benchmark_configurations[] = {
+	{ "sha1", 0, 0, 0, LIBLUKSDE_HASHING_METHOD_SHA1, 32 },
+	{ "sha1", 0, 0, 0, LIBLUKSDE_HASHING_METHOD_SHA1, 64 },
+	{ "sha256", 0, 0, 0, LIBLUKSDE_HASHING_METHOD_SHA256, 32 },
+	{ "sha256", 0, 0, 0, LIBLUKSDE_HASHING_METHOD_SHA256, 64 },
+	{ "sha512", 0, 0, 0, LIBLUKSDE_HASHING_METHOD_SHA512, 32 },
+	{ "sha512", 0, 0, 0, LIBLUKSDE_HASHING_METHOD_SHA512, 64 },
+	{ "ripemd160", 0, 0, 0, LIBLUKSDE_HASHING_METHOD_RIPEMD160, 32 },
+	{ "ripemd160", 0, 0, 0, LIBLUKSDE_HASHING_METHOD_RIPEMD160, 64 },
+	{ NULL, 0, 0, 0, 0, 0 } };
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+/* Measures the time of merging the split key material of a number of key slots
+ * The benchmark data contains the split key material
+ * Returns 1 if successful or -1 on error
+ */
+int luksde_benchmark_diffuser(
+     const luksde_benchmark_configuration_t *configuration,
+     void *benchmark_data,
+     libcerror_error_t **error )
+{
+	uint8_t data[ LUKSDE_BENCHMARK_MAXIMUM_KEY_SIZE ];
+
+	uint64_t elapsed_time = 0;
+	uint64_t start_time   = 0;
+	int merge_index       = 0;
+
+	start_time = luksde_benchmark_get_time();
+
+	for( merge_index = 0;
+	     merge_index < LUKSDE_BENCHMARK_NUMBER_OF_MERGES;
+	     merge_index++ )
+	{
+		if( libluksde_diffuser_merge(
+		     (const uint8_t *) benchmark_data,
+		     configuration->key_size * LUKSDE_BENCHMARK_NUMBER_OF_STRIPES,
+		     data,
+		     configuration->key_size,
+		     LUKSDE_BENCHMARK_NUMBER_OF_STRIPES,
+		     configuration->hashing_method,
+		     NULL,
+		     error ) != 1 )
+		{
+			return( -1 );
+		}
+	}
+	elapsed_time = luksde_benchmark_get_time() - start_time;
+
+	luksde_benchmark_report(
+	 configuration,
+	 "%2" PRIzd " bytes key, %d stripes: %8.1f us/key slot",
+	 configuration->key_size,
+	 LUKSDE_BENCHMARK_NUMBER_OF_STRIPES,
+	 (double) elapsed_time / ( LUKSDE_BENCHMARK_NUMBER_OF_MERGES * 1000.0 ) );
+
+	return( 1 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc,
+     wchar_t * const argv[] )
+#else
+int main(
+     int argc,
+     char * const argv[] )
+#endif
+{
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+	libcerror_error_t *error = NULL;
+	uint8_t *split_data      = NULL;
+	size_t data_offset       = 0;
+	size_t split_data_size   = 0;
+#endif
+
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argc )
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+	split_data_size = LUKSDE_BENCHMARK_MAXIMUM_KEY_SIZE * LUKSDE_BENCHMARK_NUMBER_OF_STRIPES;
+
+	split_data = (uint8_t *) memory_allocate(
+	                          sizeof( uint8_t ) * split_data_size );
+
+	if( split_data == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create split data.\n" );
+
+		goto on_error;
+	}
+	for( data_offset = 0;
+	     data_offset < split_data_size;
+	     data_offset++ )
+	{
+		split_data[ data_offset ] = (uint8_t) ( data_offset * 13 );
+	}
+	if( luksde_benchmark_run_configurations(
+	     luksde_benchmark_configurations,
+	     &luksde_benchmark_diffuser,
+	     (void *) split_data,
+	     &error ) != 1 )
+	{
+		goto on_error;
+	}
+	memory_free(
+	 split_data );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( split_data != NULL )
+	{
+		memory_free(
+		 split_data );
+	}
+	return( EXIT_FAILURE );
+#endif
+}
+
@@ -0,0 +1,258 @@
+/*
+ * Library encryption functions microbenchmark program
+ *
+ * Copyright (C) 2013-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "luksde_benchmark_functions.h"
+#include "luksde_test_libcerror.h"
+#include "luksde_test_libluksde.h"
+#include "luksde_test_unused.h"
+
+#include "../libluksde/libluksde_definitions.h"
+#include "../libluksde/libluksde_encryption.h"
+
+/* The number of sectors of the volume the random reads are spread over
+ */
+#define LUKSDE_BENCHMARK_NUMBER_OF_SECTORS	( (uint64_t) 1 << 24 )
+
+/* The number of random reads of a run
+ */
+#define LUKSDE_BENCHMARK_NUMBER_OF_READS	200000
+
+luksde_benchmark_configuration_t luksde_benchmark_configurations[] = {
+	{ "aes-xts-plain64",
+	  LIBLUKSDE_ENCRYPTION_METHOD_AES, LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS,
+	  LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64, LIBLUKSDE_HASHING_METHOD_UNKNOWN, 64 },
+	{ "aes-cbc-essiv:sha256",
+	  LIBLUKSDE_ENCRYPTION_METHOD_AES, LIBLUKSDE_ENCRYPTION_CHAINING_MODE_CBC,
+	  LIBLUKSDE_INITIALIZATION_VECTOR_MODE_ESSIV, LIBLUKSDE_HASHING_METHOD_SHA256, 32 },
+	{ "aes-cbc-plain",
+	  LIBLUKSDE_ENCRYPTION_METHOD_AES, LIBLUKSDE_ENCRYPTION_CHAINING_MODE_CBC,
+	  LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN32, LIBLUKSDE_HASHING_METHOD_UNKNOWN, 32 },
+	{ "serpent-xts-plain64",
+	  LIBLUKSDE_ENCRYPTION_METHOD_SERPENT, LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS,
+	  LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64, LIBLUKSDE_HASHING_METHOD_UNKNOWN, 64 },
+	{ "twofish-xts-plain64",
+	  LIBLUKSDE_ENCRYPTION_METHOD_TWOFISH, LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS,
+	  LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64, LIBLUKSDE_HASHING_METHOD_UNKNOWN, 64 },
+	{ "cast5-cbc-plain64",
+	  LIBLUKSDE_ENCRYPTION_METHOD_CAST5, LIBLUKSDE_ENCRYPTION_CHAINING_MODE_CBC,
+	  LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64, LIBLUKSDE_HASHING_METHOD_UNKNOWN, 16 },
+	{ NULL, 0, 0, 0, 0, 0 } };
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+/* Measures the time of decrypting reads of a number of sectors at random offsets
+ * Returns 1 if successful or -1 on error
+ */
+int luksde_benchmark_random_reads(
+     libluksde_encryption_context_t *context,
+     uint8_t *encrypted_data,
+     uint8_t *data,
+     size_t read_size,
+     int number_of_reads,
+     uint64_t *elapsed_time,
+     libcerror_error_t **error )
+{
+	uint64_t block_key    = 0;
+	uint64_t random_value = 0x9e3779b97f4a7c15UL;
+	uint64_t start_time   = 0;
+	int read_index        = 0;
+
+	start_time = luksde_benchmark_get_time();
+
+	for( read_index = 0;
+	     read_index < number_of_reads;
+	     read_index++ )
+	{
+		/* xorshift64 to determine the sector of the read
+		 */
+		random_value ^= random_value << 13;
+		random_value ^= random_value >> 7;
+		random_value ^= random_value << 17;
+
+		block_key = random_value % LUKSDE_BENCHMARK_NUMBER_OF_SECTORS;
+
+		if( libluksde_encryption_crypt_sectors(
+		     context,
+		     LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+		     encrypted_data,
+		     read_size,
+		     data,
+		     read_size,
+		     block_key,
+		     512,
+		     error ) != 1 )
+		{
+			return( -1 );
+		}
+	}
+	*elapsed_time = luksde_benchmark_get_time() - start_time;
+
+	return( 1 );
+}
+
+/* Measures the random reads of an encryption configuration
+ * Returns 1 if successful or -1 on error
+ */
+int luksde_benchmark_encryption(
+     const luksde_benchmark_configuration_t *configuration,
+     void *benchmark_data LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     libcerror_error_t **error )
+{
+	uint8_t data[ 4096 ];
+	uint8_t encrypted_data[ 4096 ];
+	uint8_t key[ 64 ];
+
+	libluksde_encryption_context_t *context = NULL;
+	size_t data_offset                      = 0;
+	size_t read_size                        = 0;
+	uint64_t elapsed_time                   = 0;
+
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( benchmark_data )
+
+	for( data_offset = 0;
+	     data_offset < 4096;
+	     data_offset++ )
+	{
+		encrypted_data[ data_offset ] = (uint8_t) ( data_offset * 13 );
+	}
+	for( data_offset = 0;
+	     data_offset < 64;
+	     data_offset++ )
+	{
+		key[ data_offset ] = (uint8_t) ( 0x5a ^ ( data_offset * 3 ) );
+	}
+	if( libluksde_encryption_initialize(
+	     &context,
+	     configuration->encryption_method,
+	     configuration->encryption_chaining_mode,
+	     configuration->initialization_vector_mode,
+	     configuration->hashing_method,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libluksde_encryption_set_keys(
+	     context,
+	     key,
+	     configuration->key_size,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	/* Small random reads of a single sector and of a page
+	 */
+	for( read_size = 512;
+	     read_size <= 4096;
+	     read_size *= 8 )
+	{
+		if( luksde_benchmark_random_reads(
+		     context,
+		     encrypted_data,
+		     data,
+		     read_size,
+		     LUKSDE_BENCHMARK_NUMBER_OF_READS,
+		     &elapsed_time,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+		luksde_benchmark_report(
+		 configuration,
+		 "%4" PRIzd " bytes: %8.1f ns/read %8.1f MiB/s",
+		 read_size,
+		 (double) elapsed_time / LUKSDE_BENCHMARK_NUMBER_OF_READS,
+		 ( (double) read_size * LUKSDE_BENCHMARK_NUMBER_OF_READS * 1000000000.0 ) / ( (double) elapsed_time * 1024.0 * 1024.0 ) );
+	}
+	if( libluksde_encryption_free(
+	     &context,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( context != NULL )
+	{
+		libluksde_encryption_free(
+		 &context,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc,
+     wchar_t * const argv[] )
+#else
+int main(
+     int argc,
+     char * const argv[] )
+#endif
+{
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+	libcerror_error_t *error = NULL;
+#endif
+
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argc )
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+	if( luksde_benchmark_run_configurations(
+	     luksde_benchmark_configurations,
+	     &luksde_benchmark_encryption,
+	     NULL,
+	     &error ) != 1 )
+	{
+		goto on_error;
+	}
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	return( EXIT_FAILURE );
+#endif
+}
+
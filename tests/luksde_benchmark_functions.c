@@ -0,0 +1,153 @@
+/*
+ * Functions for microbenchmarks
+ *
+ * Copyright (C) 2013-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDARG_H ) || defined( WINAPI )
+#include <stdarg.h>
+#elif defined( HAVE_VARARGS_H )
+#include <varargs.h>
+#else
+#error Missing headers stdarg.h and varargs.h
+#endif
+
+#include <time.h>
+
+#include "luksde_benchmark_functions.h"
+#include "luksde_test_libcerror.h"
+
+/* Retrieves the value of a monotonic clock in nanoseconds
+ */
+uint64_t luksde_benchmark_get_time(
+          void )
+{
+#if defined( CLOCK_MONOTONIC )
+	struct timespec time_value;
+
+	clock_gettime(
+	 CLOCK_MONOTONIC,
+	 &time_value );
+
+	return( ( (uint64_t) time_value.tv_sec * 1000000000UL ) + (uint64_t) time_value.tv_nsec );
+#else
+	return( (uint64_t) clock() * ( 1000000000UL / CLOCKS_PER_SEC ) );
+#endif
+}
+
+/* Prints a line of the report of a configuration, prefixed by its description
+ */
+void luksde_benchmark_report(
+      const luksde_benchmark_configuration_t *configuration,
+      const char *format,
+      ... )
+{
+	va_list argument_list;
+
+	if( ( configuration == NULL )
+	 || ( format == NULL ) )
+	{
+		return;
+	}
+	fprintf(
+	 stdout,
+	 "%-24s ",
+	 configuration->description );
+
+	va_start(
+	 argument_list,
+	 format );
+
+	vfprintf(
+	 stdout,
+	 format,
+	 argument_list );
+
+	va_end(
+	 argument_list );
+
+	fprintf(
+	 stdout,
+	 "\n" );
+}
+
+/* Runs the benchmark function for every configuration
+ * The configurations are terminated by an entry without a description
+ * Returns 1 if successful or -1 on error
+ */
+int luksde_benchmark_run_configurations(
+     const luksde_benchmark_configuration_t *configurations,
+     int (*benchmark_function)(
+            const luksde_benchmark_configuration_t *configuration,
+            void *benchmark_data,
+            libcerror_error_t **error ),
+     void *benchmark_data,
+     libcerror_error_t **error )
+{
+	static char *function   = "luksde_benchmark_run_configurations";
+	int configuration_index = 0;
+
+	if( configurations == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid configurations.",
+		 function );
+
+		return( -1 );
+	}
+	if( benchmark_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark function.",
+		 function );
+
+		return( -1 );
+	}
+	for( configuration_index = 0;
+	     configurations[ configuration_index ].description != NULL;
+	     configuration_index++ )
+	{
+		if( benchmark_function(
+		     &( configurations[ configuration_index ] ),
+		     benchmark_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to run benchmark of configuration: %s.",
+			 function,
+			 configurations[ configuration_index ].description );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
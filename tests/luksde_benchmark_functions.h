@@ -0,0 +1,85 @@
+/*
+ * Functions for microbenchmarks
+ *
+ * Copyright (C) 2013-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LUKSDE_BENCHMARK_FUNCTIONS_H )
+#define _LUKSDE_BENCHMARK_FUNCTIONS_H
+
+#include <common.h>
+#include <types.h>
+
+#include "luksde_test_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct luksde_benchmark_configuration luksde_benchmark_configuration_t;
+
+struct luksde_benchmark_configuration
+{
+	/* The description
+	 */
+	const char *description;
+
+	/* The encryption method
+	 */
+	int encryption_method;
+
+	/* The encryption chaining mode
+	 */
+	int encryption_chaining_mode;
+
+	/* The initialization vector mode
+	 */
+	int initialization_vector_mode;
+
+	/* The hashing method, which is the ESSIV hashing method for encryption
+	 */
+	int hashing_method;
+
+	/* The key size
+	 */
+	size_t key_size;
+};
+
+uint64_t luksde_benchmark_get_time(
+          void );
+
+void luksde_benchmark_report(
+      const luksde_benchmark_configuration_t *configuration,
+      const char *format,
+      ... );
+
+int luksde_benchmark_run_configurations(
+     const luksde_benchmark_configuration_t *configurations,
+     int (*benchmark_function)(
+            const luksde_benchmark_configuration_t *configuration,
+            void *benchmark_data,
+            libcerror_error_t **error ),
+     void *benchmark_data,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LUKSDE_BENCHMARK_FUNCTIONS_H ) */
+
@@ -0,0 +1,216 @@
+/*
+ * Key derivation progress overhead microbenchmark program
+ *
+ * Copyright (C) 2013-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "luksde_benchmark_functions.h"
+#include "luksde_test_libcerror.h"
+#include "luksde_test_libluksde.h"
+#include "luksde_test_unused.h"
+
+#include "../libluksde/libluksde_definitions.h"
+#include "../libluksde/libluksde_hash.h"
+#include "../libluksde/libluksde_password.h"
+#include "../libluksde/libluksde_progress.h"
+
+/* The number of PBKDF2 iterations of a run
+ */
+#define LUKSDE_BENCHMARK_NUMBER_OF_ITERATIONS	200000
+
+/* The number of runs of which the fastest is used
+ */
+#define LUKSDE_BENCHMARK_NUMBER_OF_RUNS		5
+
+luksde_benchmark_configuration_t luksde_benchmark_configurations[] = {
+	{ "sha1", 0, 0, 0, LIBLUKSDE_HASHING_METHOD_SHA1, 32 },
+	{ "sha256", 0, 0, 0, LIBLUKSDE_HASHING_METHOD_SHA256, 32 },
+	{ "sha512", 0, 0, 0, LIBLUKSDE_HASHING_METHOD_SHA512, 32 },
+	{ NULL, 0, 0, 0, 0, 0 } };
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+/* The progress callback function, which counts the number of invocations
+ * Returns 1 to continue
+ */
+int luksde_benchmark_progress_callback(
+     void *callback_data,
+     int key_slot_index LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     int stage LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     uint64_t value LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     uint64_t maximum_value LUKSDE_TEST_ATTRIBUTE_UNUSED )
+{
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( key_slot_index )
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( stage )
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( value )
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( maximum_value )
+
+	*( (int *) callback_data ) += 1;
+
+	return( 1 );
+}
+
+/* Measures the fastest time of a number of PBKDF2 runs with and without progress
+ * The runs with and without progress alternate so that both are equally affected
+ * by changes in the clock frequency of the CPU
+ * The benchmark data contains the progress
+ * Returns 1 if successful or -1 on error
+ */
+int luksde_benchmark_progress(
+     const luksde_benchmark_configuration_t *configuration,
+     void *benchmark_data,
+     libcerror_error_t **error )
+{
+	uint8_t key[ 64 ];
+	uint8_t salt[ 32 ];
+
+	libluksde_progress_t *run_progress = NULL;
+	uint64_t elapsed_time              = 0;
+	uint64_t progress_elapsed_time     = 0;
+	uint64_t run_elapsed_time          = 0;
+	uint64_t start_time                = 0;
+	int run_index                      = 0;
+
+	memory_set(
+	 salt,
+	 0x5a,
+	 32 );
+
+	for( run_index = 0;
+	     run_index < ( 2 * LUKSDE_BENCHMARK_NUMBER_OF_RUNS );
+	     run_index++ )
+	{
+		run_progress = NULL;
+
+		if( ( run_index % 2 ) != 0 )
+		{
+			run_progress = (libluksde_progress_t *) benchmark_data;
+		}
+		start_time = luksde_benchmark_get_time();
+
+		if( libluksde_password_pbkdf2_with_progress(
+		     (uint8_t *) "password",
+		     8,
+		     configuration->hashing_method,
+		     LIBLUKSDE_HASH_BACKEND_DEFAULT,
+		     salt,
+		     32,
+		     LUKSDE_BENCHMARK_NUMBER_OF_ITERATIONS,
+		     key,
+		     configuration->key_size,
+		     run_progress,
+		     error ) != 1 )
+		{
+			return( -1 );
+		}
+		run_elapsed_time = luksde_benchmark_get_time() - start_time;
+
+		if( run_progress == NULL )
+		{
+			if( ( elapsed_time == 0 )
+			 || ( run_elapsed_time < elapsed_time ) )
+			{
+				elapsed_time = run_elapsed_time;
+			}
+		}
+		else
+		{
+			if( ( progress_elapsed_time == 0 )
+			 || ( run_elapsed_time < progress_elapsed_time ) )
+			{
+				progress_elapsed_time = run_elapsed_time;
+			}
+		}
+	}
+	luksde_benchmark_report(
+	 configuration,
+	 "PBKDF2: %10.0f iterations/s, with progress: %10.0f iterations/s, overhead: %+6.2f%%",
+	 ( (double) LUKSDE_BENCHMARK_NUMBER_OF_ITERATIONS * 1000000000.0 ) / elapsed_time,
+	 ( (double) LUKSDE_BENCHMARK_NUMBER_OF_ITERATIONS * 1000000000.0 ) / progress_elapsed_time,
+	 ( ( (double) progress_elapsed_time - elapsed_time ) * 100.0 ) / elapsed_time );
+
+	return( 1 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc,
+     wchar_t * const argv[] )
+#else
+int main(
+     int argc,
+     char * const argv[] )
+#endif
+{
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+	libluksde_progress_t progress;
+
+	libcerror_error_t *error = NULL;
+	int abort                = 0;
+	int number_of_calls      = 0;
+#endif
+
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argc )
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+	progress.abort             = &abort;
+	progress.callback_function = &luksde_benchmark_progress_callback;
+	progress.callback_data     = (void *) &number_of_calls;
+	progress.key_slot_index    = 0;
+	progress.stage             = LIBLUKSDE_PROGRESS_STAGE_KEY_SLOT_PBKDF2;
+
+	if( luksde_benchmark_run_configurations(
+	     luksde_benchmark_configurations,
+	     &luksde_benchmark_progress,
+	     (void *) &progress,
+	     &error ) != 1 )
+	{
+		goto on_error;
+	}
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	return( EXIT_FAILURE );
+#endif
+}
+
@@ -0,0 +1,3012 @@
+/*
+ * Library encryption functions test program
+ *
+ * Copyright (C) 2013-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "luksde_test_libcerror.h"
+#include "luksde_test_libluksde.h"
+#include "luksde_test_macros.h"
+#include "luksde_test_memory.h"
+#include "luksde_test_unused.h"
+
+#include "../libluksde/libluksde_definitions.h"
+#include "../libluksde/libluksde_encryption.h"
+
+/* IEEE P1619 XTS-AES-128 test vector 2
+ */
+uint8_t luksde_test_encryption_xts_key[ 32 ] = {
+	0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+	0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22 };
+
+uint8_t luksde_test_encryption_xts_plain_text[ 32 ] = {
+	0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44,
+	0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44 };
+
+uint8_t luksde_test_encryption_xts_cipher_text[ 32 ] = {
+	0xc4, 0x54, 0x18, 0x5e, 0x6a, 0x16, 0x93, 0x6e, 0x39, 0x33, 0x40, 0x38, 0xac, 0xef, 0x83, 0x8b,
+	0xfb, 0x18, 0x6f, 0xff, 0x74, 0x80, 0xad, 0xc4, 0x28, 0x93, 0x82, 0xec, 0xd6, 0xd3, 0x94, 0xf0 };
+
+/* Twofish 256-bit key test vector
+ */
+uint8_t luksde_test_encryption_twofish_key[ 32 ] = {
+	0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef, 0xfe, 0xdc, 0xba, 0x98, 0x76, 0x54, 0x32, 0x10,
+	0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff };
+
+uint8_t luksde_test_encryption_twofish_plain_text[ 16 ] = {
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+
+uint8_t luksde_test_encryption_twofish_cipher_text[ 16 ] = {
+	0x37, 0x52, 0x7b, 0xe0, 0x05, 0x23, 0x34, 0xb8, 0x9f, 0x0c, 0xfc, 0xca, 0xe8, 0x7c, 0xfa, 0x20 };
+
+/* Serpent 256-bit key test vector
+ */
+uint8_t luksde_test_encryption_serpent_key[ 32 ] = {
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+	0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f };
+
+uint8_t luksde_test_encryption_serpent_plain_text[ 16 ] = {
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f };
+
+uint8_t luksde_test_encryption_serpent_cipher_text[ 16 ] = {
+	0xde, 0x26, 0x9f, 0xf8, 0x33, 0xe4, 0x32, 0xb8, 0x5b, 0x2e, 0x88, 0xd2, 0x70, 0x1c, 0xe7, 0x5c };
+
+/* Blowfish 64-bit key test vector
+ */
+uint8_t luksde_test_encryption_blowfish_key[ 8 ] = {
+	0xfe, 0xdc, 0xba, 0x98, 0x76, 0x54, 0x32, 0x10 };
+
+uint8_t luksde_test_encryption_blowfish_plain_text[ 8 ] = {
+	0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef };
+
+uint8_t luksde_test_encryption_blowfish_cipher_text[ 8 ] = {
+	0x0a, 0xce, 0xab, 0x0f, 0xc6, 0xa0, 0xa2, 0x8d };
+
+/* CAST-128 (CAST5) 128-bit key test vector from RFC 2144
+ */
+uint8_t luksde_test_encryption_cast5_key[ 16 ] = {
+	0x01, 0x23, 0x45, 0x67, 0x12, 0x34, 0x56, 0x78, 0x23, 0x45, 0x67, 0x89, 0x34, 0x56, 0x78, 0x9a };
+
+uint8_t luksde_test_encryption_cast5_plain_text[ 8 ] = {
+	0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef };
+
+uint8_t luksde_test_encryption_cast5_cipher_text[ 8 ] = {
+	0x23, 0x8b, 0x4f, 0xe5, 0x84, 0x7e, 0x44, 0xb2 };
+
+/* CAST-256 (CAST6) 256-bit key test vector from RFC 2612
+ */
+uint8_t luksde_test_encryption_cast6_key[ 32 ] = {
+	0x23, 0x42, 0xbb, 0x9e, 0xfa, 0x38, 0x54, 0x2c, 0xbe, 0xd0, 0xac, 0x83, 0x94, 0x0a, 0xc2, 0x98,
+	0x8d, 0x7c, 0x47, 0xce, 0x26, 0x49, 0x08, 0x46, 0x1c, 0xc1, 0xb5, 0x13, 0x7a, 0xe6, 0xb6, 0x04 };
+
+uint8_t luksde_test_encryption_cast6_plain_text[ 16 ] = {
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+
+uint8_t luksde_test_encryption_cast6_cipher_text[ 16 ] = {
+	0x4f, 0x6a, 0x20, 0x38, 0x28, 0x68, 0x97, 0xb9, 0xc9, 0x87, 0x01, 0x36, 0x55, 0x33, 0x17, 0xfa };
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+/* Tests the libluksde_encryption_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_encryption_initialize(
+     void )
+{
+	libcerror_error_t *error                = NULL;
+	libluksde_encryption_context_t *context = NULL;
+	int result                              = 0;
+
+#if defined( HAVE_LUKSDE_TEST_MEMORY )
+	int number_of_malloc_fail_tests         = 1;
+	int number_of_memset_fail_tests         = 1;
+	int test_number                         = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libluksde_encryption_initialize(
+	          &context,
+	          LIBLUKSDE_ENCRYPTION_METHOD_AES,
+	          LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS,
+	          LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64,
+	          LIBLUKSDE_HASHING_METHOD_UNKNOWN,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "context",
+	 context );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_encryption_free(
+	          &context,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "context",
+	 context );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_encryption_initialize(
+	          NULL,
+	          LIBLUKSDE_ENCRYPTION_METHOD_AES,
+	          LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS,
+	          LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64,
+	          LIBLUKSDE_HASHING_METHOD_UNKNOWN,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	context = (libluksde_encryption_context_t *) 0x12345678UL;
+
+	result = libluksde_encryption_initialize(
+	          &context,
+	          LIBLUKSDE_ENCRYPTION_METHOD_AES,
+	          LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS,
+	          LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64,
+	          LIBLUKSDE_HASHING_METHOD_UNKNOWN,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	context = NULL;
+
+	result = libluksde_encryption_initialize(
+	          &context,
+	          -1,
+	          LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS,
+	          LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64,
+	          LIBLUKSDE_HASHING_METHOD_UNKNOWN,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* XTS is not supported for 64-bit block ciphers
+	 */
+	result = libluksde_encryption_initialize(
+	          &context,
+	          LIBLUKSDE_ENCRYPTION_METHOD_BLOWFISH,
+	          LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS,
+	          LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64,
+	          LIBLUKSDE_HASHING_METHOD_UNKNOWN,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_LUKSDE_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libluksde_encryption_initialize with malloc failing
+		 */
+		luksde_test_malloc_attempts_before_fail = test_number;
+
+		result = libluksde_encryption_initialize(
+		          &context,
+		          LIBLUKSDE_ENCRYPTION_METHOD_AES,
+		          LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS,
+		          LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64,
+		          LIBLUKSDE_HASHING_METHOD_UNKNOWN,
+		          &error );
+
+		if( luksde_test_malloc_attempts_before_fail != -1 )
+		{
+			luksde_test_malloc_attempts_before_fail = -1;
+
+			if( context != NULL )
+			{
+				libluksde_encryption_free(
+				 &context,
+				 NULL );
+			}
+		}
+		else
+		{
+			LUKSDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			LUKSDE_TEST_ASSERT_IS_NULL(
+			 "context",
+			 context );
+
+			LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libluksde_encryption_initialize with memset failing
+		 */
+		luksde_test_memset_attempts_before_fail = test_number;
+
+		result = libluksde_encryption_initialize(
+		          &context,
+		          LIBLUKSDE_ENCRYPTION_METHOD_AES,
+		          LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS,
+		          LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64,
+		          LIBLUKSDE_HASHING_METHOD_UNKNOWN,
+		          &error );
+
+		if( luksde_test_memset_attempts_before_fail != -1 )
+		{
+			luksde_test_memset_attempts_before_fail = -1;
+
+			if( context != NULL )
+			{
+				libluksde_encryption_free(
+				 &context,
+				 NULL );
+			}
+		}
+		else
+		{
+			LUKSDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			LUKSDE_TEST_ASSERT_IS_NULL(
+			 "context",
+			 context );
+
+			LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_LUKSDE_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( context != NULL )
+	{
+		libluksde_encryption_free(
+		 &context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_encryption_free function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_encryption_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libluksde_encryption_free(
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_encryption_set_backend function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_encryption_set_backend(
+     void )
+{
+	libcerror_error_t *error                = NULL;
+	libluksde_encryption_context_t *context = NULL;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	result = libluksde_encryption_initialize(
+	          &context,
+	          LIBLUKSDE_ENCRYPTION_METHOD_AES,
+	          LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS,
+	          LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64,
+	          LIBLUKSDE_HASHING_METHOD_UNKNOWN,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "context",
+	 context );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libluksde_encryption_set_backend(
+	          context,
+	          LIBLUKSDE_ENCRYPTION_BACKEND_GENERIC,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The AES-NI backend is only available on supported CPUs
+	 */
+	result = libluksde_encryption_set_backend(
+	          context,
+	          LIBLUKSDE_ENCRYPTION_BACKEND_AESNI,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The AVX2 backend is not available for AES
+	 */
+	result = libluksde_encryption_set_backend(
+	          context,
+	          LIBLUKSDE_ENCRYPTION_BACKEND_AVX2,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_encryption_set_backend(
+	          NULL,
+	          LIBLUKSDE_ENCRYPTION_BACKEND_GENERIC,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_encryption_set_backend(
+	          context,
+	          -1,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_encryption_free(
+	          &context,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "context",
+	 context );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( context != NULL )
+	{
+		libluksde_encryption_free(
+		 &context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_encryption_set_provider function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_encryption_set_provider(
+     void )
+{
+	uint8_t expected_data[ 8192 ];
+	uint8_t input_data[ 8192 ];
+	uint8_t key[ 64 ];
+	uint8_t output_data[ 8192 ];
+
+	libcerror_error_t *error                         = NULL;
+	libluksde_encryption_context_t *built_in_context = NULL;
+	libluksde_encryption_context_t *context          = NULL;
+	size_t bytes_per_sector                          = 0;
+	size_t data_offset                               = 0;
+	int result                                       = 0;
+
+	for( data_offset = 0;
+	     data_offset < 8192;
+	     data_offset++ )
+	{
+		input_data[ data_offset ] = (uint8_t) ( ( data_offset * 7 ) + ( data_offset >> 8 ) );
+	}
+	for( data_offset = 0;
+	     data_offset < 64;
+	     data_offset++ )
+	{
+		key[ data_offset ] = (uint8_t) ( 0xa5 ^ data_offset );
+	}
+	/* Initialize test
+	 */
+	result = libluksde_encryption_initialize(
+	          &context,
+	          LIBLUKSDE_ENCRYPTION_METHOD_AES,
+	          LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS,
+	          LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64,
+	          LIBLUKSDE_HASHING_METHOD_UNKNOWN,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "context",
+	 context );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_encryption_initialize(
+	          &built_in_context,
+	          LIBLUKSDE_ENCRYPTION_METHOD_AES,
+	          LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS,
+	          LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64,
+	          LIBLUKSDE_HASHING_METHOD_UNKNOWN,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_encryption_set_keys(
+	          built_in_context,
+	          key,
+	          64,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libluksde_encryption_set_provider(
+	          context,
+	          LIBLUKSDE_ENCRYPTION_PROVIDER_BUILT_IN,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The kernel provider is only available if the kernel provides the algorithm
+	 */
+	result = libluksde_encryption_set_provider(
+	          context,
+	          LIBLUKSDE_ENCRYPTION_PROVIDER_KERNEL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_encryption_set_keys(
+	          context,
+	          key,
+	          64,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Both the copied and the spliced requests must match the built-in implementation
+	 */
+	for( bytes_per_sector = 512;
+	     bytes_per_sector <= 4096;
+	     bytes_per_sector *= 8 )
+	{
+		result = libluksde_encryption_crypt_sectors(
+		          built_in_context,
+		          LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+		          input_data,
+		          8192,
+		          expected_data,
+		          8192,
+		          0x0123456789UL,
+		          bytes_per_sector,
+		          &error );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		LUKSDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libluksde_encryption_crypt_sectors(
+		          context,
+		          LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+		          input_data,
+		          8192,
+		          output_data,
+		          8192,
+		          0x0123456789UL,
+		          bytes_per_sector,
+		          &error );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		LUKSDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          output_data,
+		          expected_data,
+		          8192 );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test error cases
+	 */
+	result = libluksde_encryption_set_provider(
+	          NULL,
+	          LIBLUKSDE_ENCRYPTION_PROVIDER_BUILT_IN,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_encryption_set_provider(
+	          context,
+	          -1,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_encryption_free(
+	          &built_in_context,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_encryption_free(
+	          &context,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( built_in_context != NULL )
+	{
+		libluksde_encryption_free(
+		 &built_in_context,
+		 NULL );
+	}
+	if( context != NULL )
+	{
+		libluksde_encryption_free(
+		 &context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_encryption_set_crypt_functions function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_encryption_set_crypt_functions(
+     void )
+{
+	libcerror_error_t *error                = NULL;
+	libluksde_encryption_context_t *context = NULL;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	result = libluksde_encryption_initialize(
+	          &context,
+	          LIBLUKSDE_ENCRYPTION_METHOD_AES,
+	          LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS,
+	          LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64,
+	          LIBLUKSDE_HASHING_METHOD_UNKNOWN,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "context",
+	 context );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "context->initialization_vectors_function",
+	 context->initialization_vectors_function );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "context->crypt_sectors_function",
+	 context->crypt_sectors_function );
+
+	result = libluksde_encryption_set_backend(
+	          context,
+	          LIBLUKSDE_ENCRYPTION_BACKEND_GENERIC,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "context->crypt_sectors_function",
+	 context->crypt_sectors_function );
+
+	/* An unsupported initialization vector mode leaves the function unset
+	 */
+	context->initialization_vector_mode = LIBLUKSDE_INITIALIZATION_VECTOR_MODE_LMK;
+
+	result = libluksde_encryption_set_crypt_functions(
+	          context,
+	          &error );
+
+	context->initialization_vector_mode = LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64;
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "context->initialization_vectors_function",
+	 context->initialization_vectors_function );
+
+	/* Test error cases
+	 */
+	result = libluksde_encryption_set_crypt_functions(
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_encryption_free(
+	          &context,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "context",
+	 context );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( context != NULL )
+	{
+		libluksde_encryption_free(
+		 &context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_encryption_set_essiv_cache_size function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_encryption_set_essiv_cache_size(
+     void )
+{
+	libcerror_error_t *error                = NULL;
+	libluksde_encryption_context_t *context = NULL;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	result = libluksde_encryption_initialize(
+	          &context,
+	          LIBLUKSDE_ENCRYPTION_METHOD_AES,
+	          LIBLUKSDE_ENCRYPTION_CHAINING_MODE_CBC,
+	          LIBLUKSDE_INITIALIZATION_VECTOR_MODE_ESSIV,
+	          LIBLUKSDE_HASHING_METHOD_SHA256,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "context",
+	 context );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SIZE(
+	 "context->essiv_cache_number_of_entries",
+	 context->essiv_cache_number_of_entries,
+	 (size_t) 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "context->essiv_cache_data",
+	 context->essiv_cache_data );
+
+	/* Test regular cases
+	 */
+	result = libluksde_encryption_set_essiv_cache_size(
+	          context,
+	          8,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SIZE(
+	 "context->essiv_cache_number_of_entries",
+	 context->essiv_cache_number_of_entries,
+	 (size_t) 8 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT64(
+	 "context->essiv_cache_block_keys[ 7 ]",
+	 context->essiv_cache_block_keys[ 7 ],
+	 (uint64_t) -1 );
+
+	result = libluksde_encryption_set_essiv_cache_size(
+	          context,
+	          0,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SIZE(
+	 "context->essiv_cache_number_of_entries",
+	 context->essiv_cache_number_of_entries,
+	 (size_t) 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "context->essiv_cache_data",
+	 context->essiv_cache_data );
+
+	/* Test error cases
+	 */
+	result = libluksde_encryption_set_essiv_cache_size(
+	          NULL,
+	          8,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_encryption_set_essiv_cache_size(
+	          context,
+	          (size_t) SSIZE_MAX,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_encryption_free(
+	          &context,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "context",
+	 context );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( context != NULL )
+	{
+		libluksde_encryption_free(
+		 &context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_encryption_set_decryption_keys function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_encryption_set_decryption_keys(
+     void )
+{
+	uint8_t data[ 32 ];
+
+	libcerror_error_t *error                = NULL;
+	libluksde_encryption_context_t *context = NULL;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	result = libluksde_encryption_initialize(
+	          &context,
+	          LIBLUKSDE_ENCRYPTION_METHOD_AES,
+	          LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS,
+	          LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64,
+	          LIBLUKSDE_HASHING_METHOD_UNKNOWN,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "context",
+	 context );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libluksde_encryption_set_decryption_keys(
+	          context,
+	          luksde_test_encryption_xts_key,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_encryption_crypt(
+	          context,
+	          LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          luksde_test_encryption_xts_cipher_text,
+	          32,
+	          data,
+	          32,
+	          0x3333333333UL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          data,
+	          luksde_test_encryption_xts_plain_text,
+	          32 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libluksde_encryption_set_decryption_keys(
+	          NULL,
+	          luksde_test_encryption_xts_key,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_encryption_set_decryption_keys(
+	          context,
+	          NULL,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* The encryption key schedule is not set if only the decryption keys are set
+	 */
+	result = libluksde_encryption_crypt(
+	          context,
+	          LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+	          luksde_test_encryption_xts_plain_text,
+	          32,
+	          data,
+	          32,
+	          0x3333333333UL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_encryption_free(
+	          &context,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "context",
+	 context );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( context != NULL )
+	{
+		libluksde_encryption_free(
+		 &context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_encryption_set_keys function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_encryption_set_keys(
+     void )
+{
+	libcerror_error_t *error                = NULL;
+	libluksde_encryption_context_t *context = NULL;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	result = libluksde_encryption_initialize(
+	          &context,
+	          LIBLUKSDE_ENCRYPTION_METHOD_AES,
+	          LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS,
+	          LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64,
+	          LIBLUKSDE_HASHING_METHOD_UNKNOWN,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "context",
+	 context );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libluksde_encryption_set_keys(
+	          context,
+	          luksde_test_encryption_xts_key,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_encryption_set_keys(
+	          NULL,
+	          luksde_test_encryption_xts_key,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_encryption_set_keys(
+	          context,
+	          NULL,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* XTS requires a key that can be split into a data and tweak key
+	 */
+	result = libluksde_encryption_set_keys(
+	          context,
+	          luksde_test_encryption_xts_key,
+	          16,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_encryption_free(
+	          &context,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "context",
+	 context );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( context != NULL )
+	{
+		libluksde_encryption_free(
+		 &context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_encryption_get_initialization_vectors function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_encryption_get_initialization_vectors(
+     void )
+{
+	uint8_t expected_initialization_vectors[ 48 ] = {
+		0xfe, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+
+	uint8_t initialization_vectors[ 48 ];
+
+	libcerror_error_t *error                = NULL;
+	libluksde_encryption_context_t *context = NULL;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	result = libluksde_encryption_initialize(
+	          &context,
+	          LIBLUKSDE_ENCRYPTION_METHOD_AES,
+	          LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS,
+	          LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64,
+	          LIBLUKSDE_HASHING_METHOD_UNKNOWN,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "context",
+	 context );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libluksde_encryption_get_initialization_vectors(
+	          context,
+	          0xfffffffeUL,
+	          3,
+	          initialization_vectors,
+	          48,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          initialization_vectors,
+	          expected_initialization_vectors,
+	          48 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libluksde_encryption_get_initialization_vectors(
+	          NULL,
+	          0xfffffffeUL,
+	          3,
+	          initialization_vectors,
+	          48,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_encryption_get_initialization_vectors(
+	          context,
+	          0xfffffffeUL,
+	          3,
+	          NULL,
+	          48,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_encryption_get_initialization_vectors(
+	          context,
+	          0xfffffffeUL,
+	          4,
+	          initialization_vectors,
+	          48,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_encryption_free(
+	          &context,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "context",
+	 context );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( context != NULL )
+	{
+		libluksde_encryption_free(
+		 &context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_encryption_get_initialization_vectors function using ESSIV
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_encryption_get_essiv_initialization_vectors(
+     void )
+{
+	/* The ESSIV key is the SHA-256 of the 128-bit key, hence AES-256 is used
+	 * to encrypt the block keys
+	 */
+	uint8_t expected_initialization_vectors[ 48 ] = {
+		0xf5, 0x5b, 0x30, 0x1c, 0x7d, 0x37, 0x26, 0x51, 0x56, 0x9e, 0xb7, 0xb0, 0xdc, 0x41, 0xb5, 0x7d,
+		0x66, 0xdf, 0x4c, 0x35, 0x9d, 0xf2, 0xf4, 0x24, 0x27, 0x56, 0xdf, 0x80, 0xab, 0x29, 0xa5, 0xad,
+		0xf8, 0xe4, 0x12, 0xb5, 0xc3, 0x7d, 0x76, 0x58, 0x91, 0x21, 0x3d, 0xf8, 0x3d, 0x98, 0x08, 0x31 };
+
+	uint8_t key[ 16 ] = {
+		0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f };
+
+	uint8_t initialization_vectors[ 48 ];
+
+	libcerror_error_t *error                = NULL;
+	libluksde_encryption_context_t *context = NULL;
+	int backend                             = 0;
+	int pass_index                          = 0;
+	int result                              = 0;
+
+	for( backend = LIBLUKSDE_ENCRYPTION_BACKEND_GENERIC;
+	     backend <= LIBLUKSDE_ENCRYPTION_BACKEND_VAES;
+	     backend++ )
+	{
+		/* Initialize test
+		 */
+		result = libluksde_encryption_initialize(
+		          &context,
+		          LIBLUKSDE_ENCRYPTION_METHOD_AES,
+		          LIBLUKSDE_ENCRYPTION_CHAINING_MODE_CBC,
+		          LIBLUKSDE_INITIALIZATION_VECTOR_MODE_ESSIV,
+		          LIBLUKSDE_HASHING_METHOD_SHA256,
+		          &error );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+		 "context",
+		 context );
+
+		LUKSDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libluksde_encryption_set_backend(
+		          context,
+		          backend,
+		          &error );
+
+		LUKSDE_TEST_ASSERT_NOT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		LUKSDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Skip backends that are not supported by the CPU
+		 */
+		if( result != 0 )
+		{
+			result = libluksde_encryption_set_keys(
+			          context,
+			          key,
+			          16,
+			          &error );
+
+			LUKSDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			LUKSDE_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			result = libluksde_encryption_set_essiv_cache_size(
+			          context,
+			          LIBLUKSDE_MAXIMUM_CACHE_ENTRIES_ESSIV_INITIALIZATION_VECTORS,
+			          &error );
+
+			LUKSDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			LUKSDE_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			/* Test regular cases, the block keys wrap around the end of the cache,
+			 * the second pass is served from the cache and the third pass without
+			 */
+			for( pass_index = 0;
+			     pass_index < 3;
+			     pass_index++ )
+			{
+				if( pass_index == 2 )
+				{
+					result = libluksde_encryption_set_essiv_cache_size(
+					          context,
+					          0,
+					          &error );
+
+					LUKSDE_TEST_ASSERT_EQUAL_INT(
+					 "result",
+					 result,
+					 1 );
+
+					LUKSDE_TEST_ASSERT_IS_NULL(
+					 "error",
+					 error );
+				}
+				result = libluksde_encryption_get_initialization_vectors(
+				          context,
+				          62,
+				          3,
+				          initialization_vectors,
+				          48,
+				          &error );
+
+				LUKSDE_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 1 );
+
+				LUKSDE_TEST_ASSERT_IS_NULL(
+				 "error",
+				 error );
+
+				result = memory_compare(
+				          initialization_vectors,
+				          expected_initialization_vectors,
+				          48 );
+
+				LUKSDE_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 0 );
+			}
+		}
+		/* Clean up
+		 */
+		result = libluksde_encryption_free(
+		          &context,
+		          &error );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		LUKSDE_TEST_ASSERT_IS_NULL(
+		 "context",
+		 context );
+
+		LUKSDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( context != NULL )
+	{
+		libluksde_encryption_free(
+		 &context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_encryption_crypt function using XTS
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_encryption_crypt_xts(
+     void )
+{
+	uint8_t data[ 32 ];
+
+	libcerror_error_t *error                = NULL;
+	libluksde_encryption_context_t *context = NULL;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	result = libluksde_encryption_initialize(
+	          &context,
+	          LIBLUKSDE_ENCRYPTION_METHOD_AES,
+	          LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS,
+	          LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64,
+	          LIBLUKSDE_HASHING_METHOD_UNKNOWN,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "context",
+	 context );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_encryption_set_keys(
+	          context,
+	          luksde_test_encryption_xts_key,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libluksde_encryption_crypt(
+	          context,
+	          LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+	          luksde_test_encryption_xts_plain_text,
+	          32,
+	          data,
+	          32,
+	          0x3333333333UL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          data,
+	          luksde_test_encryption_xts_cipher_text,
+	          32 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libluksde_encryption_crypt(
+	          context,
+	          LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          luksde_test_encryption_xts_cipher_text,
+	          32,
+	          data,
+	          32,
+	          0x3333333333UL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          data,
+	          luksde_test_encryption_xts_plain_text,
+	          32 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libluksde_encryption_crypt(
+	          NULL,
+	          LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          luksde_test_encryption_xts_cipher_text,
+	          32,
+	          data,
+	          32,
+	          0x3333333333UL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_encryption_crypt(
+	          context,
+	          -1,
+	          luksde_test_encryption_xts_cipher_text,
+	          32,
+	          data,
+	          32,
+	          0x3333333333UL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_encryption_crypt(
+	          context,
+	          LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          luksde_test_encryption_xts_cipher_text,
+	          30,
+	          data,
+	          32,
+	          0x3333333333UL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_encryption_crypt(
+	          context,
+	          LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          luksde_test_encryption_xts_cipher_text,
+	          32,
+	          data,
+	          16,
+	          0x3333333333UL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_encryption_free(
+	          &context,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "context",
+	 context );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( context != NULL )
+	{
+		libluksde_encryption_free(
+		 &context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_encryption_crypt_sectors function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_encryption_crypt_sectors(
+     void )
+{
+	uint8_t data[ 16896 ];
+	uint8_t expected_data[ 16896 ];
+	uint8_t input_data[ 16896 ];
+	uint8_t key[ 64 ];
+
+	int chaining_modes[ 3 ] = {
+		LIBLUKSDE_ENCRYPTION_CHAINING_MODE_CBC,
+		LIBLUKSDE_ENCRYPTION_CHAINING_MODE_ECB,
+		LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS };
+
+	int initialization_vector_modes[ 3 ] = {
+		LIBLUKSDE_INITIALIZATION_VECTOR_MODE_ESSIV,
+		LIBLUKSDE_INITIALIZATION_VECTOR_MODE_NULL,
+		LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64 };
+
+	size_t key_sizes[ 3 ] = {
+		32, 32, 64 };
+
+	libcerror_error_t *error                = NULL;
+	libluksde_encryption_context_t *context = NULL;
+	size_t data_offset                      = 0;
+	int backend                             = 0;
+	int result                              = 0;
+	int test_index                          = 0;
+
+	for( data_offset = 0;
+	     data_offset < 16896;
+	     data_offset++ )
+	{
+		input_data[ data_offset ] = (uint8_t) ( ( data_offset * 11 ) + ( data_offset >> 9 ) );
+	}
+	for( data_offset = 0;
+	     data_offset < 64;
+	     data_offset++ )
+	{
+		key[ data_offset ] = (uint8_t) ( ( data_offset * 5 ) + 1 );
+	}
+	/* Test regular cases
+	 * Use more sectors than are processed in a single batch
+	 */
+	for( test_index = 0;
+	     test_index < 3;
+	     test_index++ )
+	{
+		for( backend = LIBLUKSDE_ENCRYPTION_BACKEND_GENERIC;
+		     backend <= LIBLUKSDE_ENCRYPTION_BACKEND_VAES;
+		     backend++ )
+		{
+			result = libluksde_encryption_initialize(
+			          &context,
+			          LIBLUKSDE_ENCRYPTION_METHOD_AES,
+			          chaining_modes[ test_index ],
+			          initialization_vector_modes[ test_index ],
+			          LIBLUKSDE_HASHING_METHOD_SHA256,
+			          &error );
+
+			LUKSDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			LUKSDE_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			result = libluksde_encryption_set_backend(
+			          context,
+			          backend,
+			          &error );
+
+			LUKSDE_TEST_ASSERT_NOT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			LUKSDE_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			if( result != 0 )
+			{
+				result = libluksde_encryption_set_keys(
+				          context,
+				          key,
+				          key_sizes[ test_index ],
+				          &error );
+
+				LUKSDE_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 1 );
+
+				LUKSDE_TEST_ASSERT_IS_NULL(
+				 "error",
+				 error );
+
+				result = libluksde_encryption_crypt_sectors(
+				          context,
+				          LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+				          input_data,
+				          16896,
+				          data,
+				          16896,
+				          0x1000UL,
+				          256,
+				          &error );
+
+				LUKSDE_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 1 );
+
+				LUKSDE_TEST_ASSERT_IS_NULL(
+				 "error",
+				 error );
+
+				/* Every sector should be de- or encrypted as if it was done separately
+				 */
+				for( data_offset = 0;
+				     data_offset < 16896;
+				     data_offset += 256 )
+				{
+					result = libluksde_encryption_crypt(
+					          context,
+					          LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+					          &( input_data[ data_offset ] ),
+					          256,
+					          &( expected_data[ data_offset ] ),
+					          256,
+					          0x1000UL + ( data_offset / 256 ),
+					          &error );
+
+					LUKSDE_TEST_ASSERT_EQUAL_INT(
+					 "result",
+					 result,
+					 1 );
+
+					LUKSDE_TEST_ASSERT_IS_NULL(
+					 "error",
+					 error );
+				}
+				result = memory_compare(
+				          data,
+				          expected_data,
+				          16896 );
+
+				LUKSDE_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 0 );
+
+				result = libluksde_encryption_crypt_sectors(
+				          context,
+				          LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+				          expected_data,
+				          16896,
+				          data,
+				          16896,
+				          0x1000UL,
+				          256,
+				          &error );
+
+				LUKSDE_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 1 );
+
+				LUKSDE_TEST_ASSERT_IS_NULL(
+				 "error",
+				 error );
+
+				result = memory_compare(
+				          data,
+				          input_data,
+				          16896 );
+
+				LUKSDE_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 0 );
+
+				/* The sectors should also be decrypted in place
+				 */
+				memory_copy(
+				 data,
+				 expected_data,
+				 16896 );
+
+				result = libluksde_encryption_crypt_sectors(
+				          context,
+				          LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+				          data,
+				          16896,
+				          data,
+				          16896,
+				          0x1000UL,
+				          256,
+				          &error );
+
+				LUKSDE_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 1 );
+
+				LUKSDE_TEST_ASSERT_IS_NULL(
+				 "error",
+				 error );
+
+				result = memory_compare(
+				          data,
+				          input_data,
+				          16896 );
+
+				LUKSDE_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 0 );
+			}
+			result = libluksde_encryption_free(
+			          &context,
+			          &error );
+
+			LUKSDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			LUKSDE_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+	}
+	/* Initialize test
+	 */
+	result = libluksde_encryption_initialize(
+	          &context,
+	          LIBLUKSDE_ENCRYPTION_METHOD_AES,
+	          LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS,
+	          LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64,
+	          LIBLUKSDE_HASHING_METHOD_UNKNOWN,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "context",
+	 context );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_encryption_set_keys(
+	          context,
+	          key,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_encryption_crypt_sectors(
+	          NULL,
+	          LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          input_data,
+	          1024,
+	          data,
+	          1024,
+	          0,
+	          512,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_encryption_crypt_sectors(
+	          context,
+	          LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          input_data,
+	          1024,
+	          data,
+	          1024,
+	          0,
+	          0,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_encryption_crypt_sectors(
+	          context,
+	          LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          input_data,
+	          1000,
+	          data,
+	          1024,
+	          0,
+	          512,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_encryption_crypt_sectors(
+	          context,
+	          LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          input_data,
+	          1024,
+	          data,
+	          512,
+	          0,
+	          512,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_encryption_free(
+	          &context,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "context",
+	 context );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( context != NULL )
+	{
+		libluksde_encryption_free(
+		 &context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* De- or encrypts data using a specific backend
+ * Returns 1 if successful, 0 if the backend is not supported or -1 on error
+ */
+int luksde_test_encryption_crypt_with_backend(
+     int encryption_method,
+     int chaining_mode,
+     int initialization_vector_mode,
+     const uint8_t *key,
+     size_t key_size,
+     int backend,
+     int mode,
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libluksde_encryption_context_t *context = NULL;
+	int result                              = 0;
+
+	if( libluksde_encryption_initialize(
+	     &context,
+	     encryption_method,
+	     chaining_mode,
+	     initialization_vector_mode,
+	     LIBLUKSDE_HASHING_METHOD_UNKNOWN,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	result = libluksde_encryption_set_backend(
+	          context,
+	          backend,
+	          error );
+
+	if( result == -1 )
+	{
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		if( libluksde_encryption_set_keys(
+		     context,
+		     key,
+		     key_size,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+		if( libluksde_encryption_crypt(
+		     context,
+		     mode,
+		     input_data,
+		     data_size,
+		     output_data,
+		     data_size,
+		     0x0123456789UL,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+	}
+	if( libluksde_encryption_free(
+	     &context,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( context != NULL )
+	{
+		libluksde_encryption_free(
+		 &context,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Tests the libluksde_encryption_crypt function with a single block test vector
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_encryption_crypt_with_test_vector(
+     int encryption_method,
+     const uint8_t *key,
+     size_t key_size,
+     const uint8_t *plain_text,
+     const uint8_t *cipher_text,
+     size_t block_size )
+{
+	uint8_t data[ 512 ];
+	uint8_t input_data[ 512 ];
+
+	libcerror_error_t *error = NULL;
+	void *memcpy_result      = NULL;
+	size_t data_offset       = 0;
+	int backend              = 0;
+	int result               = 0;
+
+	/* Use enough blocks to test the blocks processed in parallel
+	 */
+	for( data_offset = 0;
+	     data_offset < 512;
+	     data_offset += block_size )
+	{
+		memcpy_result = memory_copy(
+		                 &( input_data[ data_offset ] ),
+		                 plain_text,
+		                 block_size );
+
+		LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+		 "memcpy_result",
+		 memcpy_result );
+	}
+	for( backend = LIBLUKSDE_ENCRYPTION_BACKEND_GENERIC;
+	     backend <= LIBLUKSDE_ENCRYPTION_BACKEND_AVX2;
+	     backend++ )
+	{
+		result = luksde_test_encryption_crypt_with_backend(
+		          encryption_method,
+		          LIBLUKSDE_ENCRYPTION_CHAINING_MODE_ECB,
+		          LIBLUKSDE_INITIALIZATION_VECTOR_MODE_NULL,
+		          key,
+		          key_size,
+		          backend,
+		          LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+		          input_data,
+		          data,
+		          512,
+		          &error );
+
+		LUKSDE_TEST_ASSERT_NOT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		LUKSDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Skip backends that are not supported by the CPU
+		 * or by the encryption method
+		 */
+		if( result == 0 )
+		{
+			continue;
+		}
+		for( data_offset = 0;
+		     data_offset < 512;
+		     data_offset += block_size )
+		{
+			result = memory_compare(
+			          &( data[ data_offset ] ),
+			          cipher_text,
+			          block_size );
+
+			LUKSDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 0 );
+		}
+		result = luksde_test_encryption_crypt_with_backend(
+		          encryption_method,
+		          LIBLUKSDE_ENCRYPTION_CHAINING_MODE_ECB,
+		          LIBLUKSDE_INITIALIZATION_VECTOR_MODE_NULL,
+		          key,
+		          key_size,
+		          backend,
+		          LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+		          data,
+		          data,
+		          512,
+		          &error );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		LUKSDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          data,
+		          input_data,
+		          512 );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_encryption_crypt function with Blowfish
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_encryption_crypt_blowfish(
+     void )
+{
+	return( luksde_test_encryption_crypt_with_test_vector(
+	         LIBLUKSDE_ENCRYPTION_METHOD_BLOWFISH,
+	         luksde_test_encryption_blowfish_key,
+	         8,
+	         luksde_test_encryption_blowfish_plain_text,
+	         luksde_test_encryption_blowfish_cipher_text,
+	         8 ) );
+}
+
+/* Tests the libluksde_encryption_crypt function with CAST5
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_encryption_crypt_cast5(
+     void )
+{
+	return( luksde_test_encryption_crypt_with_test_vector(
+	         LIBLUKSDE_ENCRYPTION_METHOD_CAST5,
+	         luksde_test_encryption_cast5_key,
+	         16,
+	         luksde_test_encryption_cast5_plain_text,
+	         luksde_test_encryption_cast5_cipher_text,
+	         8 ) );
+}
+
+/* Tests the libluksde_encryption_crypt function with CAST6
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_encryption_crypt_cast6(
+     void )
+{
+	return( luksde_test_encryption_crypt_with_test_vector(
+	         LIBLUKSDE_ENCRYPTION_METHOD_CAST6,
+	         luksde_test_encryption_cast6_key,
+	         32,
+	         luksde_test_encryption_cast6_plain_text,
+	         luksde_test_encryption_cast6_cipher_text,
+	         16 ) );
+}
+
+/* Tests the libluksde_encryption_crypt function with Serpent
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_encryption_crypt_serpent(
+     void )
+{
+	return( luksde_test_encryption_crypt_with_test_vector(
+	         LIBLUKSDE_ENCRYPTION_METHOD_SERPENT,
+	         luksde_test_encryption_serpent_key,
+	         32,
+	         luksde_test_encryption_serpent_plain_text,
+	         luksde_test_encryption_serpent_cipher_text,
+	         16 ) );
+}
+
+/* Tests the libluksde_encryption_crypt function with Twofish
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_encryption_crypt_twofish(
+     void )
+{
+	return( luksde_test_encryption_crypt_with_test_vector(
+	         LIBLUKSDE_ENCRYPTION_METHOD_TWOFISH,
+	         luksde_test_encryption_twofish_key,
+	         32,
+	         luksde_test_encryption_twofish_plain_text,
+	         luksde_test_encryption_twofish_cipher_text,
+	         16 ) );
+}
+
+/* Tests if the libluksde_encryption_crypt function produces the same output with every backend
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_encryption_crypt_backends(
+     void )
+{
+	uint8_t data[ 4176 ];
+	uint8_t expected_data[ 4176 ];
+	uint8_t input_data[ 4176 ];
+	uint8_t key[ 64 ];
+
+	int encryption_methods[ 14 ] = {
+		LIBLUKSDE_ENCRYPTION_METHOD_AES,
+		LIBLUKSDE_ENCRYPTION_METHOD_AES,
+		LIBLUKSDE_ENCRYPTION_METHOD_AES,
+		LIBLUKSDE_ENCRYPTION_METHOD_AES,
+		LIBLUKSDE_ENCRYPTION_METHOD_AES,
+		LIBLUKSDE_ENCRYPTION_METHOD_AES,
+		LIBLUKSDE_ENCRYPTION_METHOD_TWOFISH,
+		LIBLUKSDE_ENCRYPTION_METHOD_TWOFISH,
+		LIBLUKSDE_ENCRYPTION_METHOD_TWOFISH,
+		LIBLUKSDE_ENCRYPTION_METHOD_TWOFISH,
+		LIBLUKSDE_ENCRYPTION_METHOD_SERPENT,
+		LIBLUKSDE_ENCRYPTION_METHOD_SERPENT,
+		LIBLUKSDE_ENCRYPTION_METHOD_SERPENT,
+		LIBLUKSDE_ENCRYPTION_METHOD_SERPENT };
+
+	int chaining_modes[ 14 ] = {
+		LIBLUKSDE_ENCRYPTION_CHAINING_MODE_CBC,
+		LIBLUKSDE_ENCRYPTION_CHAINING_MODE_CBC,
+		LIBLUKSDE_ENCRYPTION_CHAINING_MODE_CBC,
+		LIBLUKSDE_ENCRYPTION_CHAINING_MODE_ECB,
+		LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS,
+		LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS,
+		LIBLUKSDE_ENCRYPTION_CHAINING_MODE_CBC,
+		LIBLUKSDE_ENCRYPTION_CHAINING_MODE_ECB,
+		LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS,
+		LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS,
+		LIBLUKSDE_ENCRYPTION_CHAINING_MODE_CBC,
+		LIBLUKSDE_ENCRYPTION_CHAINING_MODE_ECB,
+		LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS,
+		LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS };
+
+	int initialization_vector_modes[ 14 ] = {
+		LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64,
+		LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64,
+		LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64,
+		LIBLUKSDE_INITIALIZATION_VECTOR_MODE_NULL,
+		LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64,
+		LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64,
+		LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64,
+		LIBLUKSDE_INITIALIZATION_VECTOR_MODE_NULL,
+		LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64,
+		LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64,
+		LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64,
+		LIBLUKSDE_INITIALIZATION_VECTOR_MODE_NULL,
+		LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64,
+		LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64 };
+
+	size_t key_sizes[ 14 ] = {
+		16, 24, 32, 32, 32, 64, 24, 16, 32, 64, 32, 16, 32, 64 };
+
+	/* Use data sizes that are not a multitude of the number of blocks
+	 * processed in parallel
+	 */
+	size_t data_sizes[ 4 ] = {
+		16, 512, 4080, 4176 };
+
+	libcerror_error_t *error = NULL;
+	size_t data_index        = 0;
+	int backend              = 0;
+	int mode                 = 0;
+	int result               = 0;
+	int size_index           = 0;
+	int test_index           = 0;
+
+	for( data_index = 0;
+	     data_index < 4176;
+	     data_index++ )
+	{
+		input_data[ data_index ] = (uint8_t) ( ( data_index * 13 ) + ( data_index >> 8 ) );
+	}
+	for( data_index = 0;
+	     data_index < 64;
+	     data_index++ )
+	{
+		key[ data_index ] = (uint8_t) ( ( data_index * 7 ) + 3 );
+	}
+	for( test_index = 0;
+	     test_index < 14;
+	     test_index++ )
+	{
+		for( size_index = 0;
+		     size_index < 4;
+		     size_index++ )
+		{
+			for( mode = LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT;
+			     mode <= LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT;
+			     mode++ )
+			{
+				result = luksde_test_encryption_crypt_with_backend(
+				          encryption_methods[ test_index ],
+				          chaining_modes[ test_index ],
+				          initialization_vector_modes[ test_index ],
+				          key,
+				          key_sizes[ test_index ],
+				          LIBLUKSDE_ENCRYPTION_BACKEND_GENERIC,
+				          mode,
+				          input_data,
+				          expected_data,
+				          data_sizes[ size_index ],
+				          &error );
+
+				LUKSDE_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 1 );
+
+				LUKSDE_TEST_ASSERT_IS_NULL(
+				 "error",
+				 error );
+
+				for( backend = LIBLUKSDE_ENCRYPTION_BACKEND_AESNI;
+				     backend <= LIBLUKSDE_ENCRYPTION_BACKEND_AVX2;
+				     backend++ )
+				{
+					result = luksde_test_encryption_crypt_with_backend(
+					          encryption_methods[ test_index ],
+					          chaining_modes[ test_index ],
+					          initialization_vector_modes[ test_index ],
+					          key,
+					          key_sizes[ test_index ],
+					          backend,
+					          mode,
+					          input_data,
+					          data,
+					          data_sizes[ size_index ],
+					          &error );
+
+					LUKSDE_TEST_ASSERT_NOT_EQUAL_INT(
+					 "result",
+					 result,
+					 -1 );
+
+					LUKSDE_TEST_ASSERT_IS_NULL(
+					 "error",
+					 error );
+
+					/* Skip backends that are not supported by the CPU
+					 * or by the encryption method
+					 */
+					if( result == 0 )
+					{
+						continue;
+					}
+					result = memory_compare(
+					          data,
+					          expected_data,
+					          data_sizes[ size_index ] );
+
+					LUKSDE_TEST_ASSERT_EQUAL_INT(
+					 "result",
+					 result,
+					 0 );
+				}
+			}
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] LUKSDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] LUKSDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argc )
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_encryption_initialize",
+	 luksde_test_encryption_initialize );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_encryption_free",
+	 luksde_test_encryption_free );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_encryption_set_backend",
+	 luksde_test_encryption_set_backend );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_encryption_set_provider",
+	 luksde_test_encryption_set_provider );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_encryption_set_crypt_functions",
+	 luksde_test_encryption_set_crypt_functions );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_encryption_set_essiv_cache_size",
+	 luksde_test_encryption_set_essiv_cache_size );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_encryption_set_decryption_keys",
+	 luksde_test_encryption_set_decryption_keys );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_encryption_set_keys",
+	 luksde_test_encryption_set_keys );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_encryption_get_initialization_vectors",
+	 luksde_test_encryption_get_initialization_vectors );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_encryption_get_initialization_vectors (ESSIV)",
+	 luksde_test_encryption_get_essiv_initialization_vectors );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_encryption_crypt (XTS)",
+	 luksde_test_encryption_crypt_xts );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_encryption_crypt_sectors",
+	 luksde_test_encryption_crypt_sectors );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_encryption_crypt (Blowfish)",
+	 luksde_test_encryption_crypt_blowfish );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_encryption_crypt (CAST5)",
+	 luksde_test_encryption_crypt_cast5 );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_encryption_crypt (CAST6)",
+	 luksde_test_encryption_crypt_cast6 );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_encryption_crypt (Serpent)",
+	 luksde_test_encryption_crypt_serpent );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_encryption_crypt (Twofish)",
+	 luksde_test_encryption_crypt_twofish );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_encryption_crypt_backends",
+	 luksde_test_encryption_crypt_backends );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
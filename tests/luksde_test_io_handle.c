@@ -431,7 +431,9 @@ int main(
 
 	/* TODO: add tests for libluksde_io_handle_read_volume_header */
 
-	/* TODO: add tests for libluksde_io_handle_read_sector */
+	/* TODO: add tests for libluksde_io_handle_read_key_material_area */
+
+	/* TODO: add tests for libluksde_io_handle_read_chunk */
 
 #endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
 
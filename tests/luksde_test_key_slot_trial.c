@@ -0,0 +1,547 @@
+/*
+ * Library key_slot_trial type test program
+ *
+ * Copyright (C) 2013-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "luksde_test_libcerror.h"
+#include "luksde_test_libluksde.h"
+#include "luksde_test_macros.h"
+#include "luksde_test_memory.h"
+#include "luksde_test_unused.h"
+
+#include "../libluksde/libluksde_definitions.h"
+#include "../libluksde/libluksde_key_slot.h"
+#include "../libluksde/libluksde_key_slot_trial.h"
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+/* Tests the libluksde_key_slot_trial_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_key_slot_trial_initialize(
+     void )
+{
+	libcerror_error_t *error                   = NULL;
+	libluksde_key_slot_t *key_slot             = NULL;
+	libluksde_key_slot_trial_t *key_slot_trial = NULL;
+	int result                                 = 0;
+
+#if defined( HAVE_LUKSDE_TEST_MEMORY )
+	int number_of_malloc_fail_tests            = 2;
+	int number_of_memset_fail_tests            = 1;
+	int test_number                            = 0;
+#endif
+
+	/* Initialize test
+	 */
+	result = libluksde_key_slot_initialize(
+	          &key_slot,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "key_slot",
+	 key_slot );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libluksde_key_slot_trial_initialize(
+	          &key_slot_trial,
+	          3,
+	          key_slot,
+	          128000,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "key_slot_trial",
+	 key_slot_trial );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "key_slot_trial->key_slot_index",
+	 key_slot_trial->key_slot_index,
+	 3 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SIZE(
+	 "key_slot_trial->key_material_size",
+	 key_slot_trial->key_material_size,
+	 (size_t) 128000 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "key_slot_trial->key_material_data",
+	 key_slot_trial->key_material_data );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "key_slot_trial->result",
+	 key_slot_trial->result,
+	 0 );
+
+	result = libluksde_key_slot_trial_free(
+	          &key_slot_trial,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "key_slot_trial",
+	 key_slot_trial );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_key_slot_trial_initialize(
+	          NULL,
+	          3,
+	          key_slot,
+	          128000,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	key_slot_trial = (libluksde_key_slot_trial_t *) 0x12345678UL;
+
+	result = libluksde_key_slot_trial_initialize(
+	          &key_slot_trial,
+	          3,
+	          key_slot,
+	          128000,
+	          &error );
+
+	key_slot_trial = NULL;
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_key_slot_trial_initialize(
+	          &key_slot_trial,
+	          3,
+	          NULL,
+	          128000,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "key_slot_trial",
+	 key_slot_trial );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_key_slot_trial_initialize(
+	          &key_slot_trial,
+	          3,
+	          key_slot,
+	          0,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "key_slot_trial",
+	 key_slot_trial );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_key_slot_trial_initialize(
+	          &key_slot_trial,
+	          3,
+	          key_slot,
+	          (size_t) LIBLUKSDE_MAXIMUM_KEY_MATERIAL_SIZE + 1,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "key_slot_trial",
+	 key_slot_trial );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_LUKSDE_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libluksde_key_slot_trial_initialize with malloc failing
+		 */
+		luksde_test_malloc_attempts_before_fail = test_number;
+
+		result = libluksde_key_slot_trial_initialize(
+		          &key_slot_trial,
+		          3,
+		          key_slot,
+		          128000,
+		          &error );
+
+		if( luksde_test_malloc_attempts_before_fail != -1 )
+		{
+			luksde_test_malloc_attempts_before_fail = -1;
+
+			if( key_slot_trial != NULL )
+			{
+				libluksde_key_slot_trial_free(
+				 &key_slot_trial,
+				 NULL );
+			}
+		}
+		else
+		{
+			LUKSDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			LUKSDE_TEST_ASSERT_IS_NULL(
+			 "key_slot_trial",
+			 key_slot_trial );
+
+			LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libluksde_key_slot_trial_initialize with memset failing
+		 */
+		luksde_test_memset_attempts_before_fail = test_number;
+
+		result = libluksde_key_slot_trial_initialize(
+		          &key_slot_trial,
+		          3,
+		          key_slot,
+		          128000,
+		          &error );
+
+		if( luksde_test_memset_attempts_before_fail != -1 )
+		{
+			luksde_test_memset_attempts_before_fail = -1;
+
+			if( key_slot_trial != NULL )
+			{
+				libluksde_key_slot_trial_free(
+				 &key_slot_trial,
+				 NULL );
+			}
+		}
+		else
+		{
+			LUKSDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			LUKSDE_TEST_ASSERT_IS_NULL(
+			 "key_slot_trial",
+			 key_slot_trial );
+
+			LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_LUKSDE_TEST_MEMORY ) */
+
+	/* Clean up
+	 */
+	result = libluksde_key_slot_free(
+	          &key_slot,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "key_slot",
+	 key_slot );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( key_slot_trial != NULL )
+	{
+		libluksde_key_slot_trial_free(
+		 &key_slot_trial,
+		 NULL );
+	}
+	if( key_slot != NULL )
+	{
+		libluksde_key_slot_free(
+		 &key_slot,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_key_slot_trial_free function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_key_slot_trial_free(
+     void )
+{
+	libcerror_error_t *error                   = NULL;
+	libluksde_key_slot_t *key_slot             = NULL;
+	libluksde_key_slot_trial_t *key_slot_trial = NULL;
+	int result                                 = 0;
+
+	/* Initialize test
+	 */
+	result = libluksde_key_slot_initialize(
+	          &key_slot,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_key_slot_trial_initialize(
+	          &key_slot_trial,
+	          0,
+	          key_slot,
+	          512,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+
+	/* A trial that failed owns its error, which is freed with the trial
+	 */
+	libcerror_error_set(
+	 &( key_slot_trial->error ),
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "luksde_test_key_slot_trial_free: test error." );
+
+	key_slot_trial->result = -1;
+
+	result = libluksde_key_slot_trial_free(
+	          &key_slot_trial,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "key_slot_trial",
+	 key_slot_trial );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The key slot is referenced and not freed by the trial
+	 */
+	result = libluksde_key_slot_free(
+	          &key_slot,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_key_slot_trial_free(
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( key_slot_trial != NULL )
+	{
+		libluksde_key_slot_trial_free(
+		 &key_slot_trial,
+		 NULL );
+	}
+	if( key_slot != NULL )
+	{
+		libluksde_key_slot_free(
+		 &key_slot,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] LUKSDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] LUKSDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argc )
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_key_slot_trial_initialize",
+	 luksde_test_key_slot_trial_initialize );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_key_slot_trial_free",
+	 luksde_test_key_slot_trial_free );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -45,7 +45,10 @@ int luksde_test_memcpy_attempts_before_fail                     = -1;
 int luksde_test_memset_attempts_before_fail                     = -1;
 int luksde_test_realloc_attempts_before_fail                    = -1;
 
+int luksde_test_malloc_count                                    = 0;
+
 /* Custom malloc for testing memory error cases
+ * The number of allocations is counted in luksde_test_malloc_count
  * Note this function might fail if compiled with optimation
  * Returns a pointer to newly allocated data or NULL
  */
@@ -70,6 +73,8 @@ void *malloc(
 	{
 		luksde_test_malloc_attempts_before_fail--;
 	}
+	luksde_test_malloc_count++;
+
 	ptr = luksde_test_real_malloc(
 	       size );
 
@@ -42,6 +42,8 @@ extern int luksde_test_memset_attempts_before_fail;
 
 extern int luksde_test_realloc_attempts_before_fail;
 
+extern int luksde_test_malloc_count;
+
 #endif /* defined( HAVE_LUKSDE_TEST_MEMORY ) */
 
 #if defined( __cplusplus )
@@ -0,0 +1,437 @@
+/*
+ * Library multi-buffer functions test program
+ *
+ * Copyright (C) 2013-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "luksde_test_libcerror.h"
+#include "luksde_test_libluksde.h"
+#include "luksde_test_macros.h"
+#include "luksde_test_memory.h"
+#include "luksde_test_unused.h"
+
+#include "../libluksde/libluksde_definitions.h"
+#include "../libluksde/libluksde_hash.h"
+#include "../libluksde/libluksde_multi_buffer.h"
+#include "../libluksde/libluksde_password.h"
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+/* Tests the libluksde_multi_buffer_get_number_of_lanes function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_multi_buffer_get_number_of_lanes(
+     void )
+{
+	int number_of_lanes = 0;
+
+	number_of_lanes = libluksde_multi_buffer_get_number_of_lanes();
+
+	LUKSDE_TEST_ASSERT_GREATER_THAN_INT(
+	 "number_of_lanes",
+	 number_of_lanes,
+	 0 );
+
+	LUKSDE_TEST_ASSERT_LESS_THAN_INT(
+	 "number_of_lanes",
+	 number_of_lanes,
+	 LIBLUKSDE_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES + 1 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* Tests the libluksde_multi_buffer_pbkdf2_iterate function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_multi_buffer_pbkdf2_iterate(
+     void )
+{
+	libluksde_password_hmac_context_t hmac_context;
+
+	uint8_t block[ LIBLUKSDE_HASH_BLOCK_SIZE ];
+	uint8_t key[ 32 ];
+	uint32_t block_hash_values[ LIBLUKSDE_HASH_MAXIMUM_NUMBER_OF_HASH_VALUES * LIBLUKSDE_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES ];
+	uint32_t expected_block_hash_values[ LIBLUKSDE_HASH_MAXIMUM_NUMBER_OF_HASH_VALUES ];
+	uint32_t hash_values[ LIBLUKSDE_HASH_MAXIMUM_NUMBER_OF_HASH_VALUES ];
+	uint32_t inner_hash_values[ LIBLUKSDE_HASH_MAXIMUM_NUMBER_OF_HASH_VALUES * LIBLUKSDE_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES ];
+	uint32_t outer_hash_values[ LIBLUKSDE_HASH_MAXIMUM_NUMBER_OF_HASH_VALUES * LIBLUKSDE_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES ];
+
+	int hashing_methods[ 3 ] = {
+		LIBLUKSDE_HASHING_METHOD_SHA1,
+		LIBLUKSDE_HASHING_METHOD_SHA224,
+		LIBLUKSDE_HASHING_METHOD_SHA256 };
+
+	libcerror_error_t *error     = NULL;
+	size_t hash_size             = 0;
+	size_t number_of_hash_values = 0;
+	size_t value_index           = 0;
+	uint32_t iteration_index     = 0;
+	int lane_index               = 0;
+	int method_index             = 0;
+	int number_of_lanes          = 0;
+	int result                   = 0;
+
+	/* Test regular cases with every number of lanes supported by the CPU, which
+	 * cross-checks the multi-buffer and single buffer implementations
+	 */
+	for( number_of_lanes = 4;
+	     number_of_lanes <= libluksde_multi_buffer_get_number_of_lanes();
+	     number_of_lanes *= 2 )
+	{
+		for( method_index = 0;
+		     method_index < 3;
+		     method_index++ )
+		{
+			for( lane_index = 0;
+			     lane_index < number_of_lanes;
+			     lane_index++ )
+			{
+				memory_set(
+				 key,
+				 'A' + lane_index,
+				 32 );
+
+				result = libluksde_password_hmac_context_set_key(
+				          &hmac_context,
+				          hashing_methods[ method_index ],
+				          LIBLUKSDE_HASH_BACKEND_GENERIC,
+				          key,
+				          (size_t) ( lane_index + 1 ),
+				          &error );
+
+				LUKSDE_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 1 );
+
+				LUKSDE_TEST_ASSERT_IS_NULL(
+				 "error",
+				 error );
+
+				for( value_index = 0;
+				     value_index < LIBLUKSDE_HASH_MAXIMUM_NUMBER_OF_HASH_VALUES;
+				     value_index++ )
+				{
+					inner_hash_values[ ( value_index * number_of_lanes ) + lane_index ] = hmac_context.inner_hash_values[ value_index ];
+					outer_hash_values[ ( value_index * number_of_lanes ) + lane_index ] = hmac_context.outer_hash_values[ value_index ];
+					block_hash_values[ ( value_index * number_of_lanes ) + lane_index ] = (uint32_t) ( ( value_index * 0x01020304UL ) ^ lane_index );
+				}
+			}
+			result = libluksde_multi_buffer_pbkdf2_iterate(
+			          hashing_methods[ method_index ],
+			          number_of_lanes,
+			          inner_hash_values,
+			          outer_hash_values,
+			          block_hash_values,
+			          10,
+			          &error );
+
+			LUKSDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			LUKSDE_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			/* Determine the expected block hash values of every lane with the single buffer implementation
+			 */
+			for( lane_index = 0;
+			     lane_index < number_of_lanes;
+			     lane_index++ )
+			{
+				memory_set(
+				 key,
+				 'A' + lane_index,
+				 32 );
+
+				result = libluksde_password_hmac_context_set_key(
+				          &hmac_context,
+				          hashing_methods[ method_index ],
+				          LIBLUKSDE_HASH_BACKEND_GENERIC,
+				          key,
+				          (size_t) ( lane_index + 1 ),
+				          &error );
+
+				LUKSDE_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 1 );
+
+				hash_size             = hmac_context.hash_size;
+				number_of_hash_values = hash_size / 4;
+
+				for( value_index = 0;
+				     value_index < LIBLUKSDE_HASH_MAXIMUM_NUMBER_OF_HASH_VALUES;
+				     value_index++ )
+				{
+					hash_values[ value_index ]                = (uint32_t) ( ( value_index * 0x01020304UL ) ^ lane_index );
+					expected_block_hash_values[ value_index ] = hash_values[ value_index ];
+				}
+				memory_set(
+				 block,
+				 0,
+				 LIBLUKSDE_HASH_BLOCK_SIZE );
+
+				block[ hash_size ] = 0x80;
+				block[ 62 ]        = (uint8_t) ( ( ( LIBLUKSDE_HASH_BLOCK_SIZE + hash_size ) * 8 ) >> 8 );
+				block[ 63 ]        = (uint8_t) ( ( LIBLUKSDE_HASH_BLOCK_SIZE + hash_size ) * 8 );
+
+				for( iteration_index = 0;
+				     iteration_index < 10;
+				     iteration_index++ )
+				{
+					libluksde_hash_copy_hash_values(
+					 block,
+					 hash_values,
+					 hash_size,
+					 _BYTE_STREAM_ENDIAN_BIG );
+
+					memory_copy(
+					 hash_values,
+					 hmac_context.inner_hash_values,
+					 sizeof( uint32_t ) * LIBLUKSDE_HASH_MAXIMUM_NUMBER_OF_HASH_VALUES );
+
+					hmac_context.transform_function(
+					 hash_values,
+					 block,
+					 1 );
+
+					libluksde_hash_copy_hash_values(
+					 block,
+					 hash_values,
+					 hash_size,
+					 _BYTE_STREAM_ENDIAN_BIG );
+
+					memory_copy(
+					 hash_values,
+					 hmac_context.outer_hash_values,
+					 sizeof( uint32_t ) * LIBLUKSDE_HASH_MAXIMUM_NUMBER_OF_HASH_VALUES );
+
+					hmac_context.transform_function(
+					 hash_values,
+					 block,
+					 1 );
+
+					for( value_index = 0;
+					     value_index < number_of_hash_values;
+					     value_index++ )
+					{
+						expected_block_hash_values[ value_index ] ^= hash_values[ value_index ];
+					}
+				}
+				for( value_index = 0;
+				     value_index < number_of_hash_values;
+				     value_index++ )
+				{
+					LUKSDE_TEST_ASSERT_EQUAL_UINT32(
+					 "block_hash_value",
+					 block_hash_values[ ( value_index * number_of_lanes ) + lane_index ],
+					 expected_block_hash_values[ value_index ] );
+				}
+			}
+		}
+	}
+	/* Test error cases
+	 */
+	result = libluksde_multi_buffer_pbkdf2_iterate(
+	          LIBLUKSDE_HASHING_METHOD_UNKNOWN,
+	          4,
+	          inner_hash_values,
+	          outer_hash_values,
+	          block_hash_values,
+	          1,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_multi_buffer_pbkdf2_iterate(
+	          LIBLUKSDE_HASHING_METHOD_SHA1,
+	          3,
+	          inner_hash_values,
+	          outer_hash_values,
+	          block_hash_values,
+	          1,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_multi_buffer_pbkdf2_iterate(
+	          LIBLUKSDE_HASHING_METHOD_SHA1,
+	          LIBLUKSDE_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES * 2,
+	          inner_hash_values,
+	          outer_hash_values,
+	          block_hash_values,
+	          1,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_multi_buffer_pbkdf2_iterate(
+	          LIBLUKSDE_HASHING_METHOD_SHA1,
+	          4,
+	          NULL,
+	          outer_hash_values,
+	          block_hash_values,
+	          1,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_multi_buffer_pbkdf2_iterate(
+	          LIBLUKSDE_HASHING_METHOD_SHA1,
+	          4,
+	          inner_hash_values,
+	          NULL,
+	          block_hash_values,
+	          1,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_multi_buffer_pbkdf2_iterate(
+	          LIBLUKSDE_HASHING_METHOD_SHA1,
+	          4,
+	          inner_hash_values,
+	          outer_hash_values,
+	          NULL,
+	          1,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] LUKSDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] LUKSDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argc )
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_multi_buffer_get_number_of_lanes",
+	 luksde_test_multi_buffer_get_number_of_lanes );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_multi_buffer_pbkdf2_iterate",
+	 luksde_test_multi_buffer_pbkdf2_iterate );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,1366 @@
+/*
+ * Library password functions test program
+ *
+ * Copyright (C) 2013-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "luksde_test_libcerror.h"
+#include "luksde_test_libluksde.h"
+#include "luksde_test_macros.h"
+#include "luksde_test_memory.h"
+#include "luksde_test_unused.h"
+
+#include "../libluksde/libluksde_definitions.h"
+#include "../libluksde/libluksde_hash.h"
+#include "../libluksde/libluksde_password.h"
+#include "../libluksde/libluksde_progress.h"
+#include "../libluksde/libluksde_shani.h"
+
+/* PBKDF2 test vectors of RFC 6070 and ones generated with Python hashlib.pbkdf2_hmac
+ */
+uint8_t luksde_test_password_pbkdf2_sha1_iterations1[ 20 ] = {
+	0x0c, 0x60, 0xc8, 0x0f, 0x96, 0x1f, 0x0e, 0x71,
+	0xf3, 0xa9, 0xb5, 0x24, 0xaf, 0x60, 0x12, 0x06,
+	0x2f, 0xe0, 0x37, 0xa6 };
+
+uint8_t luksde_test_password_pbkdf2_sha1_iterations4096[ 25 ] = {
+	0x3d, 0x2e, 0xec, 0x4f, 0xe4, 0x1c, 0x84, 0x9b,
+	0x80, 0xc8, 0xd8, 0x36, 0x62, 0xc0, 0xe4, 0x4a,
+	0x8b, 0x29, 0x1a, 0x96, 0x4c, 0xf2, 0xf0, 0x70,
+	0x38 };
+
+uint8_t luksde_test_password_pbkdf2_sha224_iterations4096[ 40 ] = {
+	0x21, 0x8c, 0x45, 0x3b, 0xf9, 0x06, 0x35, 0xbd,
+	0x0a, 0x21, 0xa7, 0x5d, 0x17, 0x27, 0x03, 0xff,
+	0x61, 0x08, 0xef, 0x60, 0x3f, 0x65, 0xbb, 0x82,
+	0x1a, 0xed, 0xad, 0xe1, 0xd6, 0x96, 0x16, 0x83,
+	0xba, 0x8f, 0x67, 0x87, 0x7d, 0x2a, 0x3f, 0x73 };
+
+/* Password of 100 bytes and salt of 70 bytes, with values 0 to size - 1
+ */
+uint8_t luksde_test_password_pbkdf2_sha256_long_password[ 64 ] = {
+	0x65, 0x1f, 0xc2, 0xef, 0x3b, 0x63, 0x20, 0xe7,
+	0x1a, 0xf8, 0x95, 0x5e, 0x07, 0xaa, 0xae, 0x43,
+	0x26, 0xa2, 0x1d, 0xa4, 0x34, 0xc8, 0xec, 0x10,
+	0xb7, 0xdb, 0x73, 0x65, 0xf8, 0x13, 0x6d, 0xd2,
+	0x4f, 0x3d, 0x60, 0xd4, 0xf4, 0xe9, 0x1e, 0xec,
+	0xec, 0x6e, 0x15, 0x49, 0xed, 0x0e, 0x38, 0x08,
+	0x75, 0xcf, 0x0d, 0x35, 0x5b, 0x7d, 0x3d, 0x8b,
+	0x8d, 0x5f, 0xf9, 0x80, 0x9d, 0x2a, 0x2c, 0x3d };
+
+/* Salt of 56 bytes, with values 0 to 55, for which the padding requires an additional block
+ */
+uint8_t luksde_test_password_pbkdf2_sha256_long_salt[ 32 ] = {
+	0x00, 0x37, 0x3d, 0x7e, 0x29, 0xa1, 0x09, 0xa1,
+	0x3f, 0x7b, 0x50, 0x12, 0xc5, 0xbb, 0x10, 0x57,
+	0xa4, 0x1a, 0xfe, 0xe2, 0xf9, 0x82, 0xde, 0xc9,
+	0x31, 0xf5, 0x92, 0x09, 0x59, 0x5f, 0x06, 0xfb };
+
+uint8_t luksde_test_password_pbkdf2_sha512_iterations4096[ 64 ] = {
+	0xd1, 0x97, 0xb1, 0xb3, 0x3d, 0xb0, 0x14, 0x3e,
+	0x01, 0x8b, 0x12, 0xf3, 0xd1, 0xd1, 0x47, 0x9e,
+	0x6c, 0xde, 0xbd, 0xcc, 0x97, 0xc5, 0xc0, 0xf8,
+	0x7f, 0x69, 0x02, 0xe0, 0x72, 0xf4, 0x57, 0xb5,
+	0x14, 0x3f, 0x30, 0x60, 0x26, 0x41, 0xb3, 0xd5,
+	0x5c, 0xd3, 0x35, 0x98, 0x8c, 0xb3, 0x6b, 0x84,
+	0x37, 0x60, 0x60, 0xec, 0xd5, 0x32, 0xe0, 0x39,
+	0xb7, 0x42, 0xa2, 0x39, 0x43, 0x4a, 0xf2, 0xd5 };
+
+/* Password of 200 bytes and salt of 120 bytes, with values 0 to size - 1, which are
+ * larger than the SHA-512 block size and require an additional padding block
+ */
+uint8_t luksde_test_password_pbkdf2_sha512_long_password[ 70 ] = {
+	0xc1, 0x98, 0x38, 0xff, 0xa6, 0xf6, 0x2a, 0x02,
+	0x43, 0xd9, 0x9a, 0xda, 0x9b, 0xc5, 0xda, 0x1b,
+	0xda, 0xf6, 0x6e, 0x9e, 0x65, 0x14, 0x63, 0x6a,
+	0xb1, 0x69, 0x65, 0x96, 0xc3, 0xe1, 0x41, 0x50,
+	0x58, 0x38, 0xa6, 0x6e, 0xaf, 0xe5, 0xd1, 0x61,
+	0x5a, 0xb2, 0x73, 0xb3, 0xff, 0xdd, 0x76, 0x6a,
+	0x91, 0x0e, 0x1b, 0x60, 0xb7, 0x38, 0x2b, 0x0c,
+	0x01, 0xc4, 0x5e, 0xbc, 0x38, 0xfb, 0x0c, 0x78,
+	0x3b, 0x3a, 0x03, 0xf7, 0x5e, 0x16 };
+
+uint8_t luksde_test_password_pbkdf2_ripemd160_iterations4096[ 20 ] = {
+	0x99, 0xa4, 0x0d, 0x3f, 0xe4, 0xee, 0x95, 0x86,
+	0x97, 0x91, 0xd9, 0xfa, 0xa2, 0x48, 0x64, 0x56,
+	0x27, 0x82, 0x76, 0x21 };
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+/* Tests the libluksde_password_hmac_context_set_key function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_password_hmac_context_set_key(
+     void )
+{
+	uint8_t key[ 100 ];
+
+	libluksde_password_hmac_context_t hmac_context;
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	memory_set(
+	 key,
+	 'k',
+	 100 );
+
+	/* Test regular cases
+	 */
+	result = libluksde_password_hmac_context_set_key(
+	          &hmac_context,
+	          LIBLUKSDE_HASHING_METHOD_SHA1,
+	          LIBLUKSDE_HASH_BACKEND_GENERIC,
+	          key,
+	          20,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SIZE(
+	 "hmac_context.hash_size",
+	 hmac_context.hash_size,
+	 (size_t) 20 );
+
+	result = libluksde_password_hmac_context_set_key(
+	          &hmac_context,
+	          LIBLUKSDE_HASHING_METHOD_SHA224,
+	          LIBLUKSDE_HASH_BACKEND_GENERIC,
+	          key,
+	          100,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SIZE(
+	 "hmac_context.hash_size",
+	 hmac_context.hash_size,
+	 (size_t) 28 );
+
+	result = libluksde_password_hmac_context_set_key(
+	          &hmac_context,
+	          LIBLUKSDE_HASHING_METHOD_SHA256,
+	          LIBLUKSDE_HASH_BACKEND_GENERIC,
+	          key,
+	          0,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SIZE(
+	 "hmac_context.hash_size",
+	 hmac_context.hash_size,
+	 (size_t) 32 );
+
+	/* Test error cases
+	 */
+	result = libluksde_password_hmac_context_set_key(
+	          NULL,
+	          LIBLUKSDE_HASHING_METHOD_SHA1,
+	          LIBLUKSDE_HASH_BACKEND_GENERIC,
+	          key,
+	          20,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_password_hmac_context_set_key(
+	          &hmac_context,
+	          LIBLUKSDE_HASHING_METHOD_UNKNOWN,
+	          LIBLUKSDE_HASH_BACKEND_GENERIC,
+	          key,
+	          20,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_password_hmac_context_set_key(
+	          &hmac_context,
+	          LIBLUKSDE_HASHING_METHOD_SHA1,
+	          LIBLUKSDE_HASH_BACKEND_GENERIC,
+	          NULL,
+	          20,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_password_hmac_context_set_key(
+	          &hmac_context,
+	          LIBLUKSDE_HASHING_METHOD_SHA1,
+	          LIBLUKSDE_HASH_BACKEND_GENERIC,
+	          key,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_password_pbkdf2 function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_password_pbkdf2(
+     void )
+{
+	uint8_t output_data[ 70 ];
+	uint8_t password[ 200 ];
+	uint8_t salt[ 120 ];
+
+	libcerror_error_t *error = NULL;
+	size_t data_offset       = 0;
+	int backend              = 0;
+	int result               = 0;
+
+	for( data_offset = 0;
+	     data_offset < 200;
+	     data_offset++ )
+	{
+		password[ data_offset ] = (uint8_t) data_offset;
+	}
+	for( data_offset = 0;
+	     data_offset < 120;
+	     data_offset++ )
+	{
+		salt[ data_offset ] = (uint8_t) data_offset;
+	}
+	/* Test regular cases with every backend supported by the CPU, which cross-checks
+	 * the generic and SHA-NI compression functions
+	 */
+	for( backend = LIBLUKSDE_HASH_BACKEND_GENERIC;
+	     backend <= LIBLUKSDE_HASH_BACKEND_SHANI;
+	     backend++ )
+	{
+		if( ( backend == LIBLUKSDE_HASH_BACKEND_SHANI )
+		 && ( libluksde_shani_is_supported() == 0 ) )
+		{
+			continue;
+		}
+		result = libluksde_password_pbkdf2(
+		          (uint8_t *) "password",
+		          8,
+		          LIBLUKSDE_HASHING_METHOD_SHA1,
+		          backend,
+		          (uint8_t *) "salt",
+		          4,
+		          1,
+		          output_data,
+		          20,
+		          &error );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		LUKSDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          output_data,
+		          luksde_test_password_pbkdf2_sha1_iterations1,
+		          20 );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		/* Test an output data size that is not a multiple of the hash size
+		 */
+		result = libluksde_password_pbkdf2(
+		          (uint8_t *) "passwordPASSWORDpassword",
+		          24,
+		          LIBLUKSDE_HASHING_METHOD_SHA1,
+		          backend,
+		          (uint8_t *) "saltSALTsaltSALTsaltSALTsaltSALTsalt",
+		          36,
+		          4096,
+		          output_data,
+		          25,
+		          &error );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		LUKSDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          output_data,
+		          luksde_test_password_pbkdf2_sha1_iterations4096,
+		          25 );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		result = libluksde_password_pbkdf2(
+		          (uint8_t *) "password",
+		          8,
+		          LIBLUKSDE_HASHING_METHOD_SHA224,
+		          backend,
+		          (uint8_t *) "salt",
+		          4,
+		          4096,
+		          output_data,
+		          40,
+		          &error );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		LUKSDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          output_data,
+		          luksde_test_password_pbkdf2_sha224_iterations4096,
+		          40 );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		/* Test a password that is larger than the block size
+		 */
+		result = libluksde_password_pbkdf2(
+		          password,
+		          100,
+		          LIBLUKSDE_HASHING_METHOD_SHA256,
+		          backend,
+		          salt,
+		          70,
+		          1000,
+		          output_data,
+		          64,
+		          &error );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		LUKSDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          output_data,
+		          luksde_test_password_pbkdf2_sha256_long_password,
+		          64 );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		result = libluksde_password_pbkdf2(
+		          (uint8_t *) "password",
+		          8,
+		          LIBLUKSDE_HASHING_METHOD_SHA256,
+		          backend,
+		          salt,
+		          56,
+		          2,
+		          output_data,
+		          32,
+		          &error );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		LUKSDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          output_data,
+		          luksde_test_password_pbkdf2_sha256_long_salt,
+		          32 );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		result = libluksde_password_pbkdf2(
+		          (uint8_t *) "password",
+		          8,
+		          LIBLUKSDE_HASHING_METHOD_SHA512,
+		          backend,
+		          (uint8_t *) "salt",
+		          4,
+		          4096,
+		          output_data,
+		          64,
+		          &error );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		LUKSDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          output_data,
+		          luksde_test_password_pbkdf2_sha512_iterations4096,
+		          64 );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		result = libluksde_password_pbkdf2(
+		          password,
+		          200,
+		          LIBLUKSDE_HASHING_METHOD_SHA512,
+		          backend,
+		          salt,
+		          120,
+		          1000,
+		          output_data,
+		          70,
+		          &error );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		LUKSDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          output_data,
+		          luksde_test_password_pbkdf2_sha512_long_password,
+		          70 );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		result = libluksde_password_pbkdf2(
+		          (uint8_t *) "password",
+		          8,
+		          LIBLUKSDE_HASHING_METHOD_RIPEMD160,
+		          backend,
+		          (uint8_t *) "salt",
+		          4,
+		          4096,
+		          output_data,
+		          20,
+		          &error );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		LUKSDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          output_data,
+		          luksde_test_password_pbkdf2_ripemd160_iterations4096,
+		          20 );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+
+	/* Test error cases
+	 */
+	result = libluksde_password_pbkdf2(
+	          NULL,
+	          8,
+	          LIBLUKSDE_HASHING_METHOD_SHA1,
+	          LIBLUKSDE_HASH_BACKEND_GENERIC,
+	          salt,
+	          4,
+	          1,
+	          output_data,
+	          20,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_password_pbkdf2(
+	          password,
+	          8,
+	          LIBLUKSDE_HASHING_METHOD_UNKNOWN,
+	          LIBLUKSDE_HASH_BACKEND_GENERIC,
+	          salt,
+	          4,
+	          1,
+	          output_data,
+	          20,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_password_pbkdf2(
+	          password,
+	          8,
+	          LIBLUKSDE_HASHING_METHOD_SHA1,
+	          -1,
+	          salt,
+	          4,
+	          1,
+	          output_data,
+	          20,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_password_pbkdf2(
+	          password,
+	          8,
+	          LIBLUKSDE_HASHING_METHOD_SHA1,
+	          LIBLUKSDE_HASH_BACKEND_GENERIC,
+	          NULL,
+	          4,
+	          1,
+	          output_data,
+	          20,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_password_pbkdf2(
+	          password,
+	          8,
+	          LIBLUKSDE_HASHING_METHOD_SHA1,
+	          LIBLUKSDE_HASH_BACKEND_GENERIC,
+	          salt,
+	          4,
+	          0,
+	          output_data,
+	          20,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_password_pbkdf2(
+	          password,
+	          8,
+	          LIBLUKSDE_HASHING_METHOD_SHA1,
+	          LIBLUKSDE_HASH_BACKEND_GENERIC,
+	          salt,
+	          4,
+	          1,
+	          NULL,
+	          20,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_password_pbkdf2(
+	          password,
+	          8,
+	          LIBLUKSDE_HASHING_METHOD_SHA1,
+	          LIBLUKSDE_HASH_BACKEND_GENERIC,
+	          salt,
+	          4,
+	          1,
+	          output_data,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* The progress test callback data
+ */
+typedef struct luksde_test_password_progress_data luksde_test_password_progress_data_t;
+
+struct luksde_test_password_progress_data
+{
+	/* The number of callback invocations
+	 */
+	int number_of_calls;
+
+	/* The number of callback invocations after which the callback cancels or 0 if it never cancels
+	 */
+	int cancel_after;
+
+	/* The last value
+	 */
+	uint64_t value;
+
+	/* The last maximum value
+	 */
+	uint64_t maximum_value;
+};
+
+/* The progress test callback function
+ * Returns 1 to continue or 0 to cancel
+ */
+int luksde_test_password_progress_callback(
+     void *callback_data,
+     int key_slot_index LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     int stage LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     uint64_t value,
+     uint64_t maximum_value )
+{
+	luksde_test_password_progress_data_t *progress_data = NULL;
+
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( key_slot_index )
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( stage )
+
+	progress_data = (luksde_test_password_progress_data_t *) callback_data;
+
+	progress_data->number_of_calls += 1;
+	progress_data->value            = value;
+	progress_data->maximum_value    = maximum_value;
+
+	if( ( progress_data->cancel_after != 0 )
+	 && ( progress_data->number_of_calls >= progress_data->cancel_after ) )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Tests the libluksde_password_pbkdf2_with_progress function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_password_pbkdf2_with_progress(
+     void )
+{
+	uint8_t output_data[ 25 ];
+
+	luksde_test_password_progress_data_t progress_data;
+	libluksde_progress_t progress;
+
+	libcerror_error_t *error = NULL;
+	int abort                = 0;
+	int result               = 0;
+
+	progress.abort             = &abort;
+	progress.callback_function = &luksde_test_password_progress_callback;
+	progress.callback_data     = (void *) &progress_data;
+	progress.key_slot_index    = 0;
+	progress.stage             = LIBLUKSDE_PROGRESS_STAGE_KEY_SLOT_PBKDF2;
+
+	/* Test regular cases
+	 */
+	progress_data.number_of_calls = 0;
+	progress_data.cancel_after    = 0;
+	progress_data.value           = 0;
+	progress_data.maximum_value   = 0;
+
+	result = libluksde_password_pbkdf2_with_progress(
+	          (uint8_t *) "passwordPASSWORDpassword",
+	          24,
+	          LIBLUKSDE_HASHING_METHOD_SHA1,
+	          LIBLUKSDE_HASH_BACKEND_DEFAULT,
+	          (uint8_t *) "saltSALTsaltSALTsaltSALTsaltSALTsalt",
+	          36,
+	          4096,
+	          output_data,
+	          25,
+	          &progress,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          output_data,
+	          luksde_test_password_pbkdf2_sha1_iterations4096,
+	          25 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* 2 blocks of 4095 remaining iterations, which are reported in 4 batches each
+	 */
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "progress_data.number_of_calls",
+	 progress_data.number_of_calls,
+	 8 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT64(
+	 "progress_data.value",
+	 progress_data.value,
+	 (uint64_t) 8192 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT64(
+	 "progress_data.maximum_value",
+	 progress_data.maximum_value,
+	 (uint64_t) 8192 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "abort",
+	 abort,
+	 0 );
+
+	/* Test the callback cancelling the key derivation
+	 */
+	progress_data.number_of_calls = 0;
+	progress_data.cancel_after    = 1;
+
+	result = libluksde_password_pbkdf2_with_progress(
+	          (uint8_t *) "passwordPASSWORDpassword",
+	          24,
+	          LIBLUKSDE_HASHING_METHOD_SHA1,
+	          LIBLUKSDE_HASH_BACKEND_DEFAULT,
+	          (uint8_t *) "saltSALTsaltSALTsaltSALTsaltSALTsalt",
+	          36,
+	          4096,
+	          output_data,
+	          25,
+	          &progress,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "progress_data.number_of_calls",
+	 progress_data.number_of_calls,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "abort",
+	 abort,
+	 1 );
+
+	/* Test an abort that was signalled before, for which the callback is not invoked
+	 */
+	progress_data.number_of_calls = 0;
+	progress_data.cancel_after    = 0;
+
+	result = libluksde_password_pbkdf2_with_progress(
+	          (uint8_t *) "passwordPASSWORDpassword",
+	          24,
+	          LIBLUKSDE_HASHING_METHOD_SHA1,
+	          LIBLUKSDE_HASH_BACKEND_DEFAULT,
+	          (uint8_t *) "saltSALTsaltSALTsaltSALTsaltSALTsalt",
+	          36,
+	          4096,
+	          output_data,
+	          25,
+	          &progress,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "progress_data.number_of_calls",
+	 progress_data.number_of_calls,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libluksde_password_pbkdf2_with_progress(
+	          NULL,
+	          24,
+	          LIBLUKSDE_HASHING_METHOD_SHA1,
+	          LIBLUKSDE_HASH_BACKEND_DEFAULT,
+	          (uint8_t *) "saltSALTsaltSALTsaltSALTsaltSALTsalt",
+	          36,
+	          4096,
+	          output_data,
+	          25,
+	          &progress,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_password_pbkdf2_multi_buffer function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_password_pbkdf2_multi_buffer(
+     void )
+{
+	uint8_t expected_output_data[ 40 ];
+	uint8_t output_data[ 17 * 40 ];
+	uint8_t password_data[ 17 * 100 ];
+	const uint8_t *passwords[ 17 ];
+	size_t password_sizes[ 17 ];
+
+	int hashing_methods[ 5 ] = {
+		LIBLUKSDE_HASHING_METHOD_SHA1,
+		LIBLUKSDE_HASHING_METHOD_SHA224,
+		LIBLUKSDE_HASHING_METHOD_SHA256,
+		LIBLUKSDE_HASHING_METHOD_SHA512,
+		LIBLUKSDE_HASHING_METHOD_RIPEMD160 };
+
+	int numbers_of_passwords[ 4 ] = { 1, 2, 5, 17 };
+
+	libcerror_error_t *error = NULL;
+	size_t data_offset       = 0;
+	int method_index         = 0;
+	int number_index         = 0;
+	int password_index       = 0;
+	int result               = 0;
+
+	for( data_offset = 0;
+	     data_offset < 17 * 100;
+	     data_offset++ )
+	{
+		password_data[ data_offset ] = (uint8_t) ( data_offset * 7 );
+	}
+	/* The passwords vary in size, including sizes larger than the block size
+	 */
+	for( password_index = 0;
+	     password_index < 17;
+	     password_index++ )
+	{
+		passwords[ password_index ]      = &( password_data[ password_index * 100 ] );
+		password_sizes[ password_index ] = (size_t) ( ( password_index * 23 ) % 100 );
+	}
+	/* Test regular cases, which cross-checks the multi-buffer and single buffer implementations
+	 * SHA-512 and RIPEMD-160 have no multi-buffer implementation and use a single buffer
+	 */
+	for( method_index = 0;
+	     method_index < 5;
+	     method_index++ )
+	{
+		for( number_index = 0;
+		     number_index < 4;
+		     number_index++ )
+		{
+			result = libluksde_password_pbkdf2_multi_buffer(
+			          passwords,
+			          password_sizes,
+			          numbers_of_passwords[ number_index ],
+			          hashing_methods[ method_index ],
+			          (uint8_t *) "salt",
+			          4,
+			          100,
+			          output_data,
+			          40,
+			          &error );
+
+			LUKSDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			LUKSDE_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			for( password_index = 0;
+			     password_index < numbers_of_passwords[ number_index ];
+			     password_index++ )
+			{
+				result = libluksde_password_pbkdf2(
+				          passwords[ password_index ],
+				          password_sizes[ password_index ],
+				          hashing_methods[ method_index ],
+				          LIBLUKSDE_HASH_BACKEND_GENERIC,
+				          (uint8_t *) "salt",
+				          4,
+				          100,
+				          expected_output_data,
+				          40,
+				          &error );
+
+				LUKSDE_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 1 );
+
+				LUKSDE_TEST_ASSERT_IS_NULL(
+				 "error",
+				 error );
+
+				result = memory_compare(
+				          &( output_data[ password_index * 40 ] ),
+				          expected_output_data,
+				          40 );
+
+				LUKSDE_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 0 );
+			}
+		}
+	}
+	/* Test error cases
+	 */
+	result = libluksde_password_pbkdf2_multi_buffer(
+	          NULL,
+	          password_sizes,
+	          2,
+	          LIBLUKSDE_HASHING_METHOD_SHA1,
+	          (uint8_t *) "salt",
+	          4,
+	          1,
+	          output_data,
+	          20,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_password_pbkdf2_multi_buffer(
+	          passwords,
+	          NULL,
+	          2,
+	          LIBLUKSDE_HASHING_METHOD_SHA1,
+	          (uint8_t *) "salt",
+	          4,
+	          1,
+	          output_data,
+	          20,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_password_pbkdf2_multi_buffer(
+	          passwords,
+	          password_sizes,
+	          0,
+	          LIBLUKSDE_HASHING_METHOD_SHA1,
+	          (uint8_t *) "salt",
+	          4,
+	          1,
+	          output_data,
+	          20,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_password_pbkdf2_multi_buffer(
+	          passwords,
+	          password_sizes,
+	          2,
+	          LIBLUKSDE_HASHING_METHOD_UNKNOWN,
+	          (uint8_t *) "salt",
+	          4,
+	          1,
+	          output_data,
+	          20,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_password_pbkdf2_multi_buffer(
+	          passwords,
+	          password_sizes,
+	          2,
+	          LIBLUKSDE_HASHING_METHOD_SHA1,
+	          NULL,
+	          4,
+	          1,
+	          output_data,
+	          20,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_password_pbkdf2_multi_buffer(
+	          passwords,
+	          password_sizes,
+	          2,
+	          LIBLUKSDE_HASHING_METHOD_SHA1,
+	          (uint8_t *) "salt",
+	          4,
+	          0,
+	          output_data,
+	          20,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_password_pbkdf2_multi_buffer(
+	          passwords,
+	          password_sizes,
+	          2,
+	          LIBLUKSDE_HASHING_METHOD_SHA1,
+	          (uint8_t *) "salt",
+	          4,
+	          1,
+	          NULL,
+	          20,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_password_pbkdf2_multi_buffer(
+	          passwords,
+	          password_sizes,
+	          2,
+	          LIBLUKSDE_HASHING_METHOD_SHA1,
+	          (uint8_t *) "salt",
+	          4,
+	          1,
+	          output_data,
+	          0,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] LUKSDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] LUKSDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argc )
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_password_hmac_context_set_key",
+	 luksde_test_password_hmac_context_set_key );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_password_pbkdf2",
+	 luksde_test_password_pbkdf2 );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_password_pbkdf2_with_progress",
+	 luksde_test_password_pbkdf2_with_progress );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_password_pbkdf2_multi_buffer",
+	 luksde_test_password_pbkdf2_multi_buffer );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
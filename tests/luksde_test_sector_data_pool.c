@@ -0,0 +1,793 @@
+/*
+ * Library sector_data_pool type test program
+ *
+ * Copyright (C) 2013-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "luksde_test_libcerror.h"
+#include "luksde_test_libluksde.h"
+#include "luksde_test_macros.h"
+#include "luksde_test_memory.h"
+#include "luksde_test_unused.h"
+
+#include "../libluksde/libluksde_definitions.h"
+#include "../libluksde/libluksde_sector_data.h"
+#include "../libluksde/libluksde_sector_data_pool.h"
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+/* Tests the libluksde_sector_data_pool_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_sector_data_pool_initialize(
+     void )
+{
+	libcerror_error_t *error           = NULL;
+	libluksde_sector_data_pool_t *pool = NULL;
+	int result                         = 0;
+
+#if defined( HAVE_LUKSDE_TEST_MEMORY )
+	int number_of_malloc_fail_tests    = 1;
+	int number_of_memset_fail_tests    = 1;
+	int test_number                    = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libluksde_sector_data_pool_initialize(
+	          &pool,
+	          4096,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "pool",
+	 pool );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_sector_data_pool_free(
+	          &pool,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "pool",
+	 pool );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_sector_data_pool_initialize(
+	          NULL,
+	          4096,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	pool = (libluksde_sector_data_pool_t *) 0x12345678UL;
+
+	result = libluksde_sector_data_pool_initialize(
+	          &pool,
+	          4096,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	pool = NULL;
+
+	result = libluksde_sector_data_pool_initialize(
+	          &pool,
+	          0,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_LUKSDE_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libluksde_sector_data_pool_initialize with malloc failing
+		 */
+		luksde_test_malloc_attempts_before_fail = test_number;
+
+		result = libluksde_sector_data_pool_initialize(
+		          &pool,
+		          4096,
+		          &error );
+
+		if( luksde_test_malloc_attempts_before_fail != -1 )
+		{
+			luksde_test_malloc_attempts_before_fail = -1;
+
+			if( pool != NULL )
+			{
+				libluksde_sector_data_pool_free(
+				 &pool,
+				 NULL );
+			}
+		}
+		else
+		{
+			LUKSDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			LUKSDE_TEST_ASSERT_IS_NULL(
+			 "pool",
+			 pool );
+
+			LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libluksde_sector_data_pool_initialize with memset failing
+		 */
+		luksde_test_memset_attempts_before_fail = test_number;
+
+		result = libluksde_sector_data_pool_initialize(
+		          &pool,
+		          4096,
+		          &error );
+
+		if( luksde_test_memset_attempts_before_fail != -1 )
+		{
+			luksde_test_memset_attempts_before_fail = -1;
+
+			if( pool != NULL )
+			{
+				libluksde_sector_data_pool_free(
+				 &pool,
+				 NULL );
+			}
+		}
+		else
+		{
+			LUKSDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			LUKSDE_TEST_ASSERT_IS_NULL(
+			 "pool",
+			 pool );
+
+			LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_LUKSDE_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( pool != NULL )
+	{
+		libluksde_sector_data_pool_free(
+		 &pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_sector_data_pool_free function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_sector_data_pool_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libluksde_sector_data_pool_free(
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_sector_data_pool_get_block and libluksde_sector_data_pool_release_block functions
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_sector_data_pool_get_and_release_block(
+     void )
+{
+	libcerror_error_t *error           = NULL;
+	libluksde_sector_data_pool_t *pool = NULL;
+	uint8_t *block                     = NULL;
+	uint8_t *reused_block              = NULL;
+	int result                         = 0;
+
+	/* Initialize test
+	 */
+	result = libluksde_sector_data_pool_initialize(
+	          &pool,
+	          4096,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "pool",
+	 pool );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libluksde_sector_data_pool_get_block(
+	          pool,
+	          &block,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "block",
+	 block );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "pool->number_of_blocks",
+	 pool->number_of_blocks,
+	 1 );
+
+	memory_set(
+	 block,
+	 0xaa,
+	 4096 );
+
+	result = libluksde_sector_data_pool_release_block(
+	          pool,
+	          block,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A released block is cleared except for the link to the next unused block
+	 */
+	LUKSDE_TEST_ASSERT_EQUAL_UINT8(
+	 "block[ sizeof( uint8_t * ) ]",
+	 block[ sizeof( uint8_t * ) ],
+	 0 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT8(
+	 "block[ 4095 ]",
+	 block[ 4095 ],
+	 0 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "pool->number_of_unused_blocks",
+	 pool->number_of_unused_blocks,
+	 1 );
+
+	/* A released block is reused
+	 */
+	result = libluksde_sector_data_pool_get_block(
+	          pool,
+	          &reused_block,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "reused_block == block",
+	 (int) ( reused_block == block ),
+	 1 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "pool->number_of_blocks",
+	 pool->number_of_blocks,
+	 1 );
+
+	/* Test error cases
+	 */
+	result = libluksde_sector_data_pool_get_block(
+	          NULL,
+	          &block,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_sector_data_pool_get_block(
+	          pool,
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_sector_data_pool_release_block(
+	          NULL,
+	          reused_block,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_sector_data_pool_release_block(
+	          pool,
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_sector_data_pool_release_block(
+	          pool,
+	          reused_block,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Releasing more blocks than were retrieved fails
+	 */
+	result = libluksde_sector_data_pool_release_block(
+	          pool,
+	          reused_block,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_sector_data_pool_free(
+	          &pool,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "pool",
+	 pool );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( pool != NULL )
+	{
+		libluksde_sector_data_pool_free(
+		 &pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests that steady-state cache misses do not allocate memory
+ * This simulates a chunks cache where every miss creates sector data
+ * from the pool and then evicts the least recently used sector data
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_sector_data_pool_steady_state(
+     void )
+{
+	libluksde_sector_data_t *cache_entries[ 4 ] = { NULL, NULL, NULL, NULL };
+
+	libcerror_error_t *error                     = NULL;
+	libluksde_sector_data_pool_t *pool           = NULL;
+	libluksde_sector_data_t *sector_data         = NULL;
+	size_t block_size                            = 0;
+	int cache_entry_index                        = 0;
+	int iteration                                = 0;
+	int result                                   = 0;
+
+#if defined( HAVE_LUKSDE_TEST_MEMORY )
+	int malloc_count                             = 0;
+#endif
+
+	/* Initialize test
+	 */
+	result = libluksde_sector_data_get_block_size(
+	          4096,
+	          &block_size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_sector_data_pool_initialize(
+	          &pool,
+	          block_size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( iteration = 0;
+	     iteration < 256;
+	     iteration++ )
+	{
+#if defined( HAVE_LUKSDE_TEST_MEMORY )
+		/* The cache entries and the one additional sector data of a miss
+		 * are allocated during the first pass
+		 */
+		if( iteration == 5 )
+		{
+			malloc_count = luksde_test_malloc_count;
+		}
+#endif
+		cache_entry_index = iteration % 4;
+
+		result = libluksde_sector_data_initialize_from_pool(
+		          &sector_data,
+		          pool,
+		          4096,
+		          &error );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+		 "sector_data",
+		 sector_data );
+
+		LUKSDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		LUKSDE_TEST_ASSERT_EQUAL_SIZE(
+		 "sector_data->data_size",
+		 sector_data->data_size,
+		 (size_t) 4096 );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "data alignment",
+		 (int) ( (intptr_t) sector_data->data % LIBLUKSDE_SECTOR_DATA_ALIGNMENT ),
+		 0 );
+
+		if( cache_entries[ cache_entry_index ] != NULL )
+		{
+			result = libluksde_sector_data_free(
+			          &( cache_entries[ cache_entry_index ] ),
+			          &error );
+
+			LUKSDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			LUKSDE_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+		cache_entries[ cache_entry_index ] = sector_data;
+
+		sector_data = NULL;
+	}
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "pool->number_of_blocks",
+	 pool->number_of_blocks,
+	 5 );
+
+#if defined( HAVE_LUKSDE_TEST_MEMORY )
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "luksde_test_malloc_count",
+	 luksde_test_malloc_count,
+	 malloc_count );
+#endif
+
+	/* Clean up
+	 */
+	for( cache_entry_index = 0;
+	     cache_entry_index < 4;
+	     cache_entry_index++ )
+	{
+		result = libluksde_sector_data_free(
+		          &( cache_entries[ cache_entry_index ] ),
+		          &error );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		LUKSDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libluksde_sector_data_pool_free(
+	          &pool,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( sector_data != NULL )
+	{
+		libluksde_sector_data_free(
+		 &sector_data,
+		 NULL );
+	}
+	for( cache_entry_index = 0;
+	     cache_entry_index < 4;
+	     cache_entry_index++ )
+	{
+		if( cache_entries[ cache_entry_index ] != NULL )
+		{
+			libluksde_sector_data_free(
+			 &( cache_entries[ cache_entry_index ] ),
+			 NULL );
+		}
+	}
+	if( pool != NULL )
+	{
+		libluksde_sector_data_pool_free(
+		 &pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] LUKSDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] LUKSDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argc )
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_sector_data_pool_initialize",
+	 luksde_test_sector_data_pool_initialize );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_sector_data_pool_free",
+	 luksde_test_sector_data_pool_free );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_sector_data_pool_get_block",
+	 luksde_test_sector_data_pool_get_and_release_block );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_sector_data_pool steady state",
+	 luksde_test_sector_data_pool_steady_state );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -19,6 +19,7 @@
  * along with this software.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <byte_stream.h>
 #include <common.h>
 #include <file_stream.h>
 #include <narrow_string.h>
@@ -30,13 +31,25 @@
 #include <stdlib.h>
 #endif
 
+#include "luksde_test_functions.h"
 #include "luksde_test_getopt.h"
+#include "luksde_test_libbfio.h"
 #include "luksde_test_libcerror.h"
 #include "luksde_test_libclocale.h"
 #include "luksde_test_libluksde.h"
 #include "luksde_test_libuna.h"
 #include "luksde_test_macros.h"
 #include "luksde_test_memory.h"
+#include "luksde_test_unused.h"
+
+#include "../libluksde/libluksde_definitions.h"
+#include "../libluksde/libluksde_encryption.h"
+#include "../libluksde/libluksde_io_handle.h"
+#include "../libluksde/libluksde_password.h"
+#include "../libluksde/libluksde_readahead.h"
+#include "../libluksde/libluksde_sector_data.h"
+#include "../libluksde/libluksde_volume.h"
+#include "../libluksde/luksde_volume.h"
 
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER ) && SIZEOF_WCHAR_T != 2 && SIZEOF_WCHAR_T != 4
 #error Unsupported size of wchar_t
@@ -494,6 +507,24 @@ int luksde_test_volume_open_source(
 
 		goto on_error;
 	}
+	/* The readahead is disabled by default, it is enabled so that the read
+	 * tests cover it
+	 */
+	if( libluksde_volume_set_readahead_parameters(
+	     *volume,
+	     2,
+	     16,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set readahead parameters.",
+		 function );
+
+		goto on_error;
+	}
 	if( password != NULL )
 	{
 		string_length = system_string_length(
@@ -843,26 +874,20 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libluksde_volume_open function
+/* Tests the libluksde_volume_set_encryption_provider function
  * Returns 1 if successful or 0 if not
  */
-int luksde_test_volume_open(
-     const system_character_t *source,
-     const system_character_t *password )
+int luksde_test_volume_set_encryption_provider(
+     void )
 {
-	char narrow_source[ 256 ];
-
 	libcerror_error_t *error   = NULL;
 	libluksde_volume_t *volume = NULL;
-	size_t string_length       = 0;
 	int result                 = 0;
 
 	/* Initialize test
 	 */
-	result = luksde_test_volume_get_narrow_source(
-	          source,
-	          narrow_source,
-	          256,
+	result = libluksde_volume_initialize(
+	          &volume,
 	          &error );
 
 	LUKSDE_TEST_ASSERT_EQUAL_INT(
@@ -870,12 +895,19 @@ int luksde_test_volume_open(
 	 result,
 	 1 );
 
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
 	LUKSDE_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	result = libluksde_volume_initialize(
-	          &volume,
+	/* Test regular cases
+	 */
+	result = libluksde_volume_set_encryption_provider(
+	          volume,
+	          LIBLUKSDE_ENCRYPTION_PROVIDER_KERNEL,
 	          &error );
 
 	LUKSDE_TEST_ASSERT_EQUAL_INT(
@@ -883,47 +915,13 @@ int luksde_test_volume_open(
 	 result,
 	 1 );
 
-	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
-	 "volume",
-	 volume );
-
 	LUKSDE_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	if( password != NULL )
-	{
-		string_length = system_string_length(
-		                 password );
-
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-		result = libluksde_volume_set_utf16_password(
-		          volume,
-		          (uint16_t *) password,
-		          string_length,
-		          &error );
-#else
-		result = libluksde_volume_set_utf8_password(
-		          volume,
-		          (uint8_t *) password,
-		          string_length,
-		          &error );
-#endif
-		LUKSDE_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 1 );
-
-	        LUKSDE_TEST_ASSERT_IS_NULL(
-	         "error",
-		 error );
-	}
-	/* Test open
-	 */
-	result = libluksde_volume_open(
+	result = libluksde_volume_set_encryption_provider(
 	          volume,
-	          narrow_source,
-	          LIBLUKSDE_OPEN_READ,
+	          LIBLUKSDE_ENCRYPTION_PROVIDER_BUILT_IN,
 	          &error );
 
 	LUKSDE_TEST_ASSERT_EQUAL_INT(
@@ -937,10 +935,26 @@ int luksde_test_volume_open(
 
 	/* Test error cases
 	 */
-	result = libluksde_volume_open(
+	result = libluksde_volume_set_encryption_provider(
+	          NULL,
+	          LIBLUKSDE_ENCRYPTION_PROVIDER_BUILT_IN,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_volume_set_encryption_provider(
 	          volume,
-	          narrow_source,
-	          LIBLUKSDE_OPEN_READ,
+	          -1,
 	          &error );
 
 	LUKSDE_TEST_ASSERT_EQUAL_INT(
@@ -991,28 +1005,20 @@ on_error:
 	return( 0 );
 }
 
-#if defined( HAVE_WIDE_CHARACTER_TYPE )
-
-/* Tests the libluksde_volume_open_wide function
+/* Tests the libluksde_volume_set_essiv_cache_size function
  * Returns 1 if successful or 0 if not
  */
-int luksde_test_volume_open_wide(
-     const system_character_t *source,
-     const system_character_t *password )
+int luksde_test_volume_set_essiv_cache_size(
+     void )
 {
-	wchar_t wide_source[ 256 ];
-
 	libcerror_error_t *error   = NULL;
 	libluksde_volume_t *volume = NULL;
-	size_t string_length       = 0;
 	int result                 = 0;
 
 	/* Initialize test
 	 */
-	result = luksde_test_volume_get_wide_source(
-	          source,
-	          wide_source,
-	          256,
+	result = libluksde_volume_initialize(
+	          &volume,
 	          &error );
 
 	LUKSDE_TEST_ASSERT_EQUAL_INT(
@@ -1020,12 +1026,19 @@ int luksde_test_volume_open_wide(
 	 result,
 	 1 );
 
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
 	LUKSDE_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	result = libluksde_volume_initialize(
-	          &volume,
+	/* Test regular cases
+	 */
+	result = libluksde_volume_set_essiv_cache_size(
+	          volume,
+	          16,
 	          &error );
 
 	LUKSDE_TEST_ASSERT_EQUAL_INT(
@@ -1033,47 +1046,13 @@ int luksde_test_volume_open_wide(
 	 result,
 	 1 );
 
-	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
-	 "volume",
-	 volume );
-
 	LUKSDE_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	if( password != NULL )
-	{
-		string_length = system_string_length(
-		                 password );
-
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-		result = libluksde_volume_set_utf16_password(
-		          volume,
-		          (uint16_t *) password,
-		          string_length,
-		          &error );
-#else
-		result = libluksde_volume_set_utf8_password(
-		          volume,
-		          (uint8_t *) password,
-		          string_length,
-		          &error );
-#endif
-		LUKSDE_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 1 );
-
-	        LUKSDE_TEST_ASSERT_IS_NULL(
-	         "error",
-		 error );
-	}
-	/* Test open
-	 */
-	result = libluksde_volume_open_wide(
+	result = libluksde_volume_set_essiv_cache_size(
 	          volume,
-	          wide_source,
-	          LIBLUKSDE_OPEN_READ,
+	          0,
 	          &error );
 
 	LUKSDE_TEST_ASSERT_EQUAL_INT(
@@ -1087,10 +1066,43 @@ int luksde_test_volume_open_wide(
 
 	/* Test error cases
 	 */
-	result = libluksde_volume_open_wide(
+	result = libluksde_volume_set_essiv_cache_size(
+	          NULL,
+	          16,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_volume_set_essiv_cache_size(
 	          volume,
-	          wide_source,
-	          LIBLUKSDE_OPEN_READ,
+	          -1,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_volume_set_essiv_cache_size(
+	          volume,
+	          LIBLUKSDE_MAXIMUM_CACHE_ENTRIES_ESSIV_INITIALIZATION_VECTORS + 1,
 	          &error );
 
 	LUKSDE_TEST_ASSERT_EQUAL_INT(
@@ -1141,62 +1153,56 @@ on_error:
 	return( 0 );
 }
 
-#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
-
-/* Tests the libluksde_volume_close function
+/* Tests the libluksde_volume_set_chunk_cache_parameters function
  * Returns 1 if successful or 0 if not
  */
-int luksde_test_volume_close(
+int luksde_test_volume_set_chunk_cache_parameters(
      void )
 {
-	libcerror_error_t *error = NULL;
-	int result               = 0;
+	libcerror_error_t *error   = NULL;
+	libluksde_volume_t *volume = NULL;
+	int result                 = 0;
 
-	/* Test error cases
+	/* Initialize test
 	 */
-	result = libluksde_volume_close(
-	          NULL,
+	result = libluksde_volume_initialize(
+	          &volume,
 	          &error );
 
 	LUKSDE_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
 	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
-
-	return( 1 );
+	/* Test regular cases
+	 */
+	result = libluksde_volume_set_chunk_cache_parameters(
+	          volume,
+	          1024 * 1024,
+	          4,
+	          &error );
 
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	return( 0 );
-}
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-/* Tests the libluksde_volume_open and libluksde_volume_close functions
- * Returns 1 if successful or 0 if not
- */
-int luksde_test_volume_open_close(
-     const system_character_t *source,
-     const system_character_t *password )
-{
-	libcerror_error_t *error   = NULL;
-	libluksde_volume_t *volume = NULL;
-	size_t string_length       = 0;
-	int result                 = 0;
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-	/* Initialize test
-	 */
-	result = libluksde_volume_initialize(
-	          &volume,
+	result = libluksde_volume_set_chunk_cache_parameters(
+	          volume,
+	          512,
+	          1,
 	          &error );
 
 	LUKSDE_TEST_ASSERT_EQUAL_INT(
@@ -1204,68 +1210,3189 @@ int luksde_test_volume_open_close(
 	 result,
 	 1 );
 
-	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
-	 "volume",
-	 volume );
-
 	LUKSDE_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	if( password != NULL )
-	{
-		string_length = system_string_length(
-		                 password );
-
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	/* Test error cases
+	 */
+	result = libluksde_volume_set_chunk_cache_parameters(
+	          NULL,
+	          64 * 1024,
+	          16,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_volume_set_chunk_cache_parameters(
+	          volume,
+	          0,
+	          16,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_volume_set_chunk_cache_parameters(
+	          volume,
+	          1000,
+	          16,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_volume_set_chunk_cache_parameters(
+	          volume,
+	          (size_t) 32 * 1024 * 1024,
+	          16,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_volume_set_chunk_cache_parameters(
+	          volume,
+	          64 * 1024,
+	          0,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_volume_free(
+	          &volume,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "volume",
+	 volume );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libluksde_volume_free(
+		 &volume,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_volume_set_readahead_parameters function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_volume_set_readahead_parameters(
+     void )
+{
+	libcerror_error_t *error   = NULL;
+	libluksde_volume_t *volume = NULL;
+	int result                 = 0;
+
+	/* Initialize test
+	 */
+	result = libluksde_volume_initialize(
+	          &volume,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libluksde_volume_set_readahead_parameters(
+	          volume,
+	          4,
+	          64,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_volume_set_readahead_parameters(
+	          volume,
+	          1,
+	          1,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test disabling the readahead
+	 */
+	result = libluksde_volume_set_readahead_parameters(
+	          volume,
+	          0,
+	          0,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_volume_set_readahead_parameters(
+	          NULL,
+	          2,
+	          16,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_volume_set_readahead_parameters(
+	          volume,
+	          2,
+	          -1,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_volume_set_readahead_parameters(
+	          volume,
+	          2,
+	          257,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_volume_set_readahead_parameters(
+	          volume,
+	          0,
+	          16,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_volume_set_readahead_parameters(
+	          volume,
+	          17,
+	          16,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_volume_free(
+	          &volume,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "volume",
+	 volume );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libluksde_volume_free(
+		 &volume,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Progress callback function that is used by the tests
+ * Returns 1 to continue
+ */
+int luksde_test_volume_progress_callback(
+     void *callback_data LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     int key_slot_index LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     int stage LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     uint64_t value LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     uint64_t maximum_value LUKSDE_TEST_ATTRIBUTE_UNUSED )
+{
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( callback_data )
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( key_slot_index )
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( stage )
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( value )
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( maximum_value )
+
+	return( 1 );
+}
+
+/* Tests the libluksde_volume_set_progress_callback function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_volume_set_progress_callback(
+     void )
+{
+	libcerror_error_t *error   = NULL;
+	libluksde_volume_t *volume = NULL;
+	int result                 = 0;
+
+	/* Initialize test
+	 */
+	result = libluksde_volume_initialize(
+	          &volume,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libluksde_volume_set_progress_callback(
+	          volume,
+	          &luksde_test_volume_progress_callback,
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_volume_set_progress_callback(
+	          volume,
+	          NULL,
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_volume_set_progress_callback(
+	          NULL,
+	          &luksde_test_volume_progress_callback,
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_volume_free(
+	          &volume,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "volume",
+	 volume );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libluksde_volume_free(
+		 &volume,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_volume_set_utf8_passwords function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_volume_set_utf8_passwords(
+     void )
+{
+	const uint8_t *utf8_strings[ 2 ] = {
+		(uint8_t *) "password1",
+		(uint8_t *) "password2" };
+
+	size_t utf8_string_lengths[ 2 ] = { 9, 9 };
+
+	libcerror_error_t *error   = NULL;
+	libluksde_volume_t *volume = NULL;
+	int key_slot_index         = 0;
+	int password_index         = 0;
+	int result                 = 0;
+
+	/* Initialize test
+	 */
+	result = libluksde_volume_initialize(
+	          &volume,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libluksde_volume_set_utf8_passwords(
+	          volume,
+	          utf8_strings,
+	          utf8_string_lengths,
+	          2,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test if previously set candidate passwords are replaced
+	 */
+	result = libluksde_volume_set_utf8_passwords(
+	          volume,
+	          utf8_strings,
+	          utf8_string_lengths,
+	          1,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_volume_set_utf8_passwords(
+	          NULL,
+	          utf8_strings,
+	          utf8_string_lengths,
+	          2,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_volume_set_utf8_passwords(
+	          volume,
+	          NULL,
+	          utf8_string_lengths,
+	          2,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_volume_set_utf8_passwords(
+	          volume,
+	          utf8_strings,
+	          NULL,
+	          2,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_volume_set_utf8_passwords(
+	          volume,
+	          utf8_strings,
+	          utf8_string_lengths,
+	          0,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test if the volume was not unlocked with a key slot
+	 */
+	result = libluksde_volume_get_unlocked_key_slot(
+	          volume,
+	          &password_index,
+	          &key_slot_index,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_volume_get_unlocked_key_slot(
+	          NULL,
+	          &password_index,
+	          &key_slot_index,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_volume_get_unlocked_key_slot(
+	          volume,
+	          NULL,
+	          &key_slot_index,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_volume_get_unlocked_key_slot(
+	          volume,
+	          &password_index,
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_volume_free(
+	          &volume,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "volume",
+	 volume );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libluksde_volume_free(
+		 &volume,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_volume_open function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_volume_open(
+     const system_character_t *source,
+     const system_character_t *password )
+{
+	char narrow_source[ 256 ];
+
+	libcerror_error_t *error   = NULL;
+	libluksde_volume_t *volume = NULL;
+	size_t string_length       = 0;
+	int result                 = 0;
+
+	/* Initialize test
+	 */
+	result = luksde_test_volume_get_narrow_source(
+	          source,
+	          narrow_source,
+	          256,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_volume_initialize(
+	          &volume,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( password != NULL )
+	{
+		string_length = system_string_length(
+		                 password );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libluksde_volume_set_utf16_password(
+		          volume,
+		          (uint16_t *) password,
+		          string_length,
+		          &error );
+#else
+		result = libluksde_volume_set_utf8_password(
+		          volume,
+		          (uint8_t *) password,
+		          string_length,
+		          &error );
+#endif
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+	        LUKSDE_TEST_ASSERT_IS_NULL(
+	         "error",
+		 error );
+	}
+	/* Test open
+	 */
+	result = libluksde_volume_open(
+	          volume,
+	          narrow_source,
+	          LIBLUKSDE_OPEN_READ,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_volume_open(
+	          volume,
+	          narrow_source,
+	          LIBLUKSDE_OPEN_READ,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_volume_free(
+	          &volume,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "volume",
+	 volume );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libluksde_volume_free(
+		 &volume,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Tests the libluksde_volume_open_wide function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_volume_open_wide(
+     const system_character_t *source,
+     const system_character_t *password )
+{
+	wchar_t wide_source[ 256 ];
+
+	libcerror_error_t *error   = NULL;
+	libluksde_volume_t *volume = NULL;
+	size_t string_length       = 0;
+	int result                 = 0;
+
+	/* Initialize test
+	 */
+	result = luksde_test_volume_get_wide_source(
+	          source,
+	          wide_source,
+	          256,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_volume_initialize(
+	          &volume,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( password != NULL )
+	{
+		string_length = system_string_length(
+		                 password );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libluksde_volume_set_utf16_password(
+		          volume,
+		          (uint16_t *) password,
+		          string_length,
+		          &error );
+#else
+		result = libluksde_volume_set_utf8_password(
+		          volume,
+		          (uint8_t *) password,
+		          string_length,
+		          &error );
+#endif
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+	        LUKSDE_TEST_ASSERT_IS_NULL(
+	         "error",
+		 error );
+	}
+	/* Test open
+	 */
+	result = libluksde_volume_open_wide(
+	          volume,
+	          wide_source,
+	          LIBLUKSDE_OPEN_READ,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_volume_open_wide(
+	          volume,
+	          wide_source,
+	          LIBLUKSDE_OPEN_READ,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_volume_free(
+	          &volume,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "volume",
+	 volume );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libluksde_volume_free(
+		 &volume,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Tests the libluksde_volume_close function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_volume_close(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libluksde_volume_close(
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_volume_open and libluksde_volume_close functions
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_volume_open_close(
+     const system_character_t *source,
+     const system_character_t *password )
+{
+	libcerror_error_t *error   = NULL;
+	libluksde_volume_t *volume = NULL;
+	size_t string_length       = 0;
+	int result                 = 0;
+
+	/* Initialize test
+	 */
+	result = libluksde_volume_initialize(
+	          &volume,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( password != NULL )
+	{
+		string_length = system_string_length(
+		                 password );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 		result = libluksde_volume_set_utf16_password(
 		          volume,
 		          (uint16_t *) password,
 		          string_length,
 		          &error );
-#else
-		result = libluksde_volume_set_utf8_password(
-		          volume,
-		          (uint8_t *) password,
-		          string_length,
+#else
+		result = libluksde_volume_set_utf8_password(
+		          volume,
+		          (uint8_t *) password,
+		          string_length,
+		          &error );
+#endif
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+	        LUKSDE_TEST_ASSERT_IS_NULL(
+	         "error",
+		 error );
+	}
+	/* Test open and close
+	 */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libluksde_volume_open_wide(
+	          volume,
+	          source,
+	          LIBLUKSDE_OPEN_READ,
+	          &error );
+#else
+	result = libluksde_volume_open(
+	          volume,
+	          source,
+	          LIBLUKSDE_OPEN_READ,
+	          &error );
+#endif
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_volume_close(
+	          volume,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test open and close a second time to validate clean up on close
+	 */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libluksde_volume_open_wide(
+	          volume,
+	          source,
+	          LIBLUKSDE_OPEN_READ,
+	          &error );
+#else
+	result = libluksde_volume_open(
+	          volume,
+	          source,
+	          LIBLUKSDE_OPEN_READ,
+	          &error );
+#endif
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_volume_close(
+	          volume,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libluksde_volume_free(
+	          &volume,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "volume",
+	 volume );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libluksde_volume_free(
+		 &volume,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests opening a volume with candidate passwords
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_volume_open_with_passwords(
+     const system_character_t *source,
+     const system_character_t *password )
+{
+	const system_character_t *strings[ 3 ] = {
+		_SYSTEM_STRING( "incorrect1" ),
+		NULL,
+		_SYSTEM_STRING( "incorrect2" ) };
+
+	size_t string_lengths[ 3 ] = { 10, 0, 10 };
+
+	libcerror_error_t *error   = NULL;
+	libluksde_volume_t *volume = NULL;
+	int key_slot_index         = 0;
+	int password_index         = 0;
+	int result                 = 0;
+
+	strings[ 1 ]        = password;
+	string_lengths[ 1 ] = system_string_length(
+	                       password );
+
+	/* Initialize test
+	 */
+	result = libluksde_volume_initialize(
+	          &volume,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libluksde_volume_set_utf16_passwords(
+	          volume,
+	          (const uint16_t **) strings,
+	          string_lengths,
+	          3,
+	          &error );
+#else
+	result = libluksde_volume_set_utf8_passwords(
+	          volume,
+	          (const uint8_t **) strings,
+	          string_lengths,
+	          3,
+	          &error );
+#endif
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test open with candidate passwords
+	 */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libluksde_volume_open_wide(
+	          volume,
+	          source,
+	          LIBLUKSDE_OPEN_READ,
+	          &error );
+#else
+	result = libluksde_volume_open(
+	          volume,
+	          source,
+	          LIBLUKSDE_OPEN_READ,
+	          &error );
+#endif
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_volume_get_unlocked_key_slot(
+	          volume,
+	          &password_index,
+	          &key_slot_index,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "password_index",
+	 password_index,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_GREATER_THAN_INT(
+	 "key_slot_index",
+	 key_slot_index,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_volume_set_utf8_passwords(
+	          volume,
+	          (const uint8_t **) strings,
+	          string_lengths,
+	          3,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_volume_close(
+	          volume,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_volume_free(
+	          &volume,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "volume",
+	 volume );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libluksde_volume_free(
+		 &volume,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_volume_signal_abort function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_volume_signal_abort(
+     libluksde_volume_t *volume )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libluksde_volume_signal_abort(
+	          volume,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_volume_signal_abort(
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_volume_read_buffer function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_volume_read_buffer(
+     libluksde_volume_t *volume )
+{
+	uint8_t buffer[ 16 ];
+
+	libcerror_error_t *error = NULL;
+	size64_t size            = 0;
+	ssize_t read_count       = 0;
+	off64_t offset           = 0;
+
+	/* Determine size
+	 */
+	offset = libluksde_volume_seek_offset(
+	          volume,
+	          0,
+	          SEEK_END,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_NOT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	size = (size64_t) offset;
+
+	/* Reset offset to 0
+	 */
+	offset = libluksde_volume_seek_offset(
+	          volume,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	if( size > 16 )
+	{
+		read_count = libluksde_volume_read_buffer(
+		              volume,
+		              buffer,
+		              16,
+		              &error );
+
+		LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 16 );
+
+		LUKSDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+/* TODO read on size boundary */
+/* TODO read beyond size boundary */
+
+	/* Reset offset to 0
+	 */
+	offset = libluksde_volume_seek_offset(
+	          volume,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	read_count = libluksde_volume_read_buffer(
+	              NULL,
+	              buffer,
+	              16,
+	              &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libluksde_volume_read_buffer(
+	              volume,
+	              NULL,
+	              16,
+	              &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libluksde_volume_read_buffer(
+	              volume,
+	              buffer,
+	              (size_t) SSIZE_MAX + 1,
+	              &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_volume_get_readahead_statistics function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_volume_get_readahead_statistics(
+     libluksde_volume_t *volume )
+{
+	uint8_t sequential_buffer[ 32768 ];
+	uint8_t buffer[ 512 ];
+
+	libcerror_error_t *error  = NULL;
+	size64_t size             = 0;
+	size_t buffer_offset      = 0;
+	size_t read_size          = 0;
+	ssize_t read_count        = 0;
+	uint64_t number_of_hits   = 0;
+	uint64_t number_of_misses = 0;
+	off64_t offset            = 0;
+	int result                = 0;
+
+	/* Determine size
+	 */
+	result = libluksde_volume_get_size(
+	          volume,
+	          &size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_size = sizeof( sequential_buffer );
+
+	if( size < (size64_t) read_size )
+	{
+		read_size = (size_t) size - ( (size_t) size % 512 );
+	}
+	/* Test regular cases
+	 */
+	offset = libluksde_volume_seek_offset(
+	          volume,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( buffer_offset = 0;
+	     buffer_offset < read_size;
+	     buffer_offset += 512 )
+	{
+		read_count = libluksde_volume_read_buffer(
+		              volume,
+		              &( sequential_buffer[ buffer_offset ] ),
+		              512,
+		              &error );
+
+		LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 512 );
+
+		LUKSDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libluksde_volume_get_readahead_statistics(
+	          volume,
+	          &number_of_hits,
+	          &number_of_misses,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Read the same data backwards, which does not use the readahead
+	 */
+	while( buffer_offset > 0 )
+	{
+		buffer_offset -= 512;
+
+		read_count = libluksde_volume_read_buffer_at_offset(
+		              volume,
+		              buffer,
+		              512,
+		              (off64_t) buffer_offset,
+		              &error );
+
+		LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 512 );
+
+		LUKSDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          buffer,
+		          &( sequential_buffer[ buffer_offset ] ),
+		          512 );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Reset offset to 0
+	 */
+	offset = libluksde_volume_seek_offset(
+	          volume,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_volume_get_readahead_statistics(
+	          NULL,
+	          &number_of_hits,
+	          &number_of_misses,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_volume_get_readahead_statistics(
+	          volume,
+	          NULL,
+	          &number_of_misses,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_volume_get_readahead_statistics(
+	          volume,
+	          &number_of_hits,
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+/* Tests if reading sector data produces the same output with every encryption backend
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_volume_read_sector_data_backends(
+     libluksde_volume_t *volume )
+{
+	libcerror_error_t *error                           = NULL;
+	libluksde_encryption_context_t *encryption_context = NULL;
+	libluksde_internal_volume_t *internal_volume       = NULL;
+	libluksde_io_handle_t *io_handle                   = NULL;
+	libluksde_sector_data_t *expected_sector_data      = NULL;
+	libluksde_sector_data_t *sector_data               = NULL;
+	off64_t sector_data_offset                         = 0;
+	int backend                                        = 0;
+	int original_backend                               = 0;
+	int result                                         = 0;
+	int sector_index                                   = 0;
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+	/* The sector data can only be decrypted when the volume is unlocked
+	 */
+	if( internal_volume->is_locked != 0 )
+	{
+		return( 1 );
+	}
+	io_handle          = internal_volume->io_handle;
+	encryption_context = io_handle->encryption_context;
+	original_backend   = encryption_context->backend;
+
+	/* Initialize test
+	 */
+	result = libluksde_sector_data_initialize(
+	          &expected_sector_data,
+	          (size_t) io_handle->bytes_per_sector,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_sector_data_initialize(
+	          &sector_data,
+	          (size_t) io_handle->bytes_per_sector,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( sector_index = 0;
+	     sector_index < 16;
+	     sector_index++ )
+	{
+		if( ( (size64_t) ( sector_index + 1 ) * io_handle->bytes_per_sector ) > io_handle->volume_size )
+		{
+			break;
+		}
+		sector_data_offset = io_handle->encrypted_volume_offset
+		                   + ( (off64_t) sector_index * io_handle->bytes_per_sector );
+
+		result = libluksde_encryption_set_backend(
+		          encryption_context,
+		          LIBLUKSDE_ENCRYPTION_BACKEND_GENERIC,
+		          &error );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		LUKSDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libluksde_sector_data_read(
+		          expected_sector_data,
+		          io_handle,
+		          internal_volume->file_io_handle,
+		          sector_data_offset,
+		          encryption_context,
 		          &error );
-#endif
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		LUKSDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		for( backend = LIBLUKSDE_ENCRYPTION_BACKEND_AESNI;
+		     backend <= LIBLUKSDE_ENCRYPTION_BACKEND_VAES;
+		     backend++ )
+		{
+			result = libluksde_encryption_set_backend(
+			          encryption_context,
+			          backend,
+			          &error );
+
+			LUKSDE_TEST_ASSERT_NOT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			LUKSDE_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			/* Skip backends that are not supported by the CPU or the encryption method
+			 */
+			if( result == 0 )
+			{
+				continue;
+			}
+			result = libluksde_sector_data_read(
+			          sector_data,
+			          io_handle,
+			          internal_volume->file_io_handle,
+			          sector_data_offset,
+			          encryption_context,
+			          &error );
+
+			LUKSDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			LUKSDE_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			result = memory_compare(
+			          sector_data->data,
+			          expected_sector_data->data,
+			          sector_data->data_size );
+
+			LUKSDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 0 );
+		}
+	}
+	/* Clean up
+	 */
+	result = libluksde_encryption_set_backend(
+	          encryption_context,
+	          original_backend,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_sector_data_free(
+	          &sector_data,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_sector_data_free(
+	          &expected_sector_data,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( encryption_context != NULL )
+	{
+		libluksde_encryption_set_backend(
+		 encryption_context,
+		 original_backend,
+		 NULL );
+	}
+	if( sector_data != NULL )
+	{
+		libluksde_sector_data_free(
+		 &sector_data,
+		 NULL );
+	}
+	if( expected_sector_data != NULL )
+	{
+		libluksde_sector_data_free(
+		 &expected_sector_data,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+
+/* Tests if the readahead reads the same chunks as the volume
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_volume_readahead(
+     libluksde_volume_t *volume )
+{
+	libcerror_error_t *error                      = NULL;
+	libluksde_internal_volume_t *internal_volume  = NULL;
+	libluksde_io_handle_t *io_handle              = NULL;
+	libluksde_readahead_t *readahead              = NULL;
+	libluksde_sector_data_t *expected_sector_data = NULL;
+	libluksde_sector_data_t *sector_data          = NULL;
+	size_t chunk_size                             = 0;
+	off64_t chunk_offset                          = 0;
+	int chunk_index                               = 0;
+	int is_pending                                = 0;
+	int result                                    = 0;
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+	/* The chunks can only be decrypted when the volume is unlocked
+	 */
+	if( internal_volume->is_locked != 0 )
+	{
+		return( 1 );
+	}
+	io_handle  = internal_volume->io_handle;
+	chunk_size = (size_t) io_handle->bytes_per_sector * 8;
+
+	if( io_handle->encrypted_volume_size < (size64_t) ( chunk_size * 8 ) )
+	{
+		return( 1 );
+	}
+	/* Initialize test
+	 */
+	result = libluksde_readahead_initialize(
+	          &readahead,
+	          io_handle,
+	          internal_volume->file_io_handle,
+	          chunk_size,
+	          1,
+	          4,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "readahead",
+	 readahead );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_sector_data_initialize(
+	          &expected_sector_data,
+	          chunk_size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( chunk_index = 0;
+	     chunk_index < 3;
+	     chunk_index++ )
+	{
+		result = libluksde_readahead_update(
+		          readahead,
+		          (off64_t) chunk_index * chunk_size,
+		          (size64_t) chunk_size,
+		          &error );
+
 		LUKSDE_TEST_ASSERT_EQUAL_INT(
 		 "result",
 		 result,
 		 1 );
 
-	        LUKSDE_TEST_ASSERT_IS_NULL(
-	         "error",
-		 error );
+		LUKSDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Wait for the worker thread to read the requested chunk
+	 */
+	result = libcthreads_mutex_grab(
+	          readahead->mutex,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	do
+	{
+		is_pending = 0;
+
+		for( chunk_index = 0;
+		     chunk_index < readahead->number_of_chunks;
+		     chunk_index++ )
+		{
+			if( ( readahead->chunks[ chunk_index ].state == LIBLUKSDE_READAHEAD_CHUNK_STATE_REQUESTED )
+			 || ( readahead->chunks[ chunk_index ].state == LIBLUKSDE_READAHEAD_CHUNK_STATE_READING ) )
+			{
+				is_pending = 1;
+			}
+		}
+		if( is_pending != 0 )
+		{
+			result = libcthreads_condition_wait(
+			          readahead->completion_condition,
+			          readahead->mutex,
+			          &error );
+
+			LUKSDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+		}
+	}
+	while( is_pending != 0 );
+
+	result = libcthreads_mutex_release(
+	          readahead->mutex,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	chunk_offset = (off64_t) chunk_size * 3;
+
+	result = libluksde_readahead_get_chunk(
+	          readahead,
+	          chunk_offset,
+	          &sector_data,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "sector_data",
+	 sector_data );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT64(
+	 "readahead->number_of_hits",
+	 readahead->number_of_hits,
+	 (uint64_t) 1 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "readahead->window_size",
+	 readahead->window_size,
+	 2 );
+
+	result = libluksde_sector_data_read(
+	          expected_sector_data,
+	          io_handle,
+	          internal_volume->file_io_handle,
+	          io_handle->encrypted_volume_offset + chunk_offset,
+	          io_handle->encryption_context,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SIZE(
+	 "sector_data->data_size",
+	 sector_data->data_size,
+	 expected_sector_data->data_size );
+
+	result = memory_compare(
+	          sector_data->data,
+	          expected_sector_data->data,
+	          sector_data->data_size );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* A read that is not sequential resets the window
+	 */
+	result = libluksde_readahead_update(
+	          readahead,
+	          0,
+	          (size64_t) io_handle->bytes_per_sector,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "readahead->window_size",
+	 readahead->window_size,
+	 1 );
+
+	result = libluksde_readahead_get_chunk(
+	          readahead,
+	          (off64_t) chunk_size * 5,
+	          &sector_data,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_readahead_get_chunk(
+	          NULL,
+	          0,
+	          &sector_data,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_readahead_get_chunk(
+	          readahead,
+	          0,
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_readahead_update(
+	          NULL,
+	          0,
+	          (size64_t) chunk_size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_readahead_update(
+	          readahead,
+	          -1,
+	          (size64_t) chunk_size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_sector_data_free(
+	          &expected_sector_data,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_readahead_free(
+	          &readahead,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "readahead",
+	 readahead );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( expected_sector_data != NULL )
+	{
+		libluksde_sector_data_free(
+		 &expected_sector_data,
+		 NULL );
+	}
+	if( readahead != NULL )
+	{
+		libluksde_readahead_free(
+		 &readahead,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT ) */
+
+#define LUKSDE_TEST_VOLUME_IMAGE_BYTES_PER_SECTOR	512
+#define LUKSDE_TEST_VOLUME_IMAGE_DATA_START_SECTOR	72
+#define LUKSDE_TEST_VOLUME_IMAGE_SIZE			( ( LUKSDE_TEST_VOLUME_IMAGE_DATA_START_SECTOR + 1 ) * LUKSDE_TEST_VOLUME_IMAGE_BYTES_PER_SECTOR )
+
+/* Creates the data of a LUKS version 1 aes-ecb sha1 volume image
+ * The first number of key slots are active, each with its own password and number of iterations
+ * A key slot with 0 iterations is active but its key material is not set and cannot be tried
+ * The encrypted volume consists of a single sector
+ * Returns 1 if successful or -1 on error
+ */
+int luksde_test_volume_create_image(
+     uint8_t *image_data,
+     size_t image_data_size,
+     const char **passwords,
+     const uint32_t *number_of_iterations,
+     int number_of_key_slots,
+     libcerror_error_t **error )
+{
+	uint8_t key_material_data[ LUKSDE_TEST_VOLUME_IMAGE_BYTES_PER_SECTOR ];
+	uint8_t master_key[ 32 ];
+	uint8_t user_key[ 32 ];
+
+	libluksde_encryption_context_t *encryption_context = NULL;
+	luksde_volume_header_t *volume_header              = NULL;
+	luksde_volume_key_slot_t *volume_key_slot          = NULL;
+	uint8_t *sector_data                               = NULL;
+	static char *function                              = "luksde_test_volume_create_image";
+	size_t data_offset                                 = 0;
+	uint32_t key_material_start_sector                 = 0;
+	int key_slot_index                                 = 0;
+
+	if( image_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid image data.",
+		 function );
+
+		return( -1 );
+	}
+	if( image_data_size != LUKSDE_TEST_VOLUME_IMAGE_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid image data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_key_slots < 0 )
+	 || ( number_of_key_slots > 8 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of key slots value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	memory_set(
+	 image_data,
+	 0,
+	 image_data_size );
+
+	for( data_offset = 0;
+	     data_offset < 32;
+	     data_offset++ )
+	{
+		master_key[ data_offset ] = (uint8_t) ( ( data_offset * 7 ) + 1 );
+	}
+	volume_header = (luksde_volume_header_t *) image_data;
+
+	memory_copy(
+	 volume_header->signature,
+	 "LUKS\xba\xbe",
+	 6 );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 volume_header->version,
+	 1 );
+
+	memory_copy(
+	 volume_header->encryption_method,
+	 "aes",
+	 3 );
+
+	memory_copy(
+	 volume_header->encryption_mode,
+	 "ecb",
+	 3 );
+
+	memory_copy(
+	 volume_header->hashing_method,
+	 "sha1",
+	 4 );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 volume_header->encrypted_volume_start_sector,
+	 LUKSDE_TEST_VOLUME_IMAGE_DATA_START_SECTOR );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 volume_header->master_key_size,
+	 32 );
+
+	memory_set(
+	 volume_header->master_key_salt,
+	 0x5a,
+	 32 );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 volume_header->master_key_number_of_iterations,
+	 1000 );
+
+	if( libluksde_password_pbkdf2(
+	     master_key,
+	     32,
+	     LIBLUKSDE_HASHING_METHOD_SHA1,
+	     LIBLUKSDE_HASH_BACKEND_DEFAULT,
+	     volume_header->master_key_salt,
+	     32,
+	     1000,
+	     volume_header->master_key_validation_hash,
+	     20,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine master key validation hash.",
+		 function );
+
+		goto on_error;
+	}
+	if( libluksde_encryption_initialize(
+	     &encryption_context,
+	     LIBLUKSDE_ENCRYPTION_METHOD_AES,
+	     LIBLUKSDE_ENCRYPTION_CHAINING_MODE_ECB,
+	     LIBLUKSDE_INITIALIZATION_VECTOR_MODE_NULL,
+	     LIBLUKSDE_HASHING_METHOD_UNKNOWN,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create encryption context.",
+		 function );
+
+		goto on_error;
+	}
+	volume_key_slot = (luksde_volume_key_slot_t *) &( image_data[ sizeof( luksde_volume_header_t ) ] );
+
+	for( key_slot_index = 0;
+	     key_slot_index < 8;
+	     key_slot_index++ )
+	{
+		key_material_start_sector = 8 + ( (uint32_t) key_slot_index * 8 );
+
+		byte_stream_copy_from_uint32_big_endian(
+		 volume_key_slot->start_sector,
+		 key_material_start_sector );
+
+		byte_stream_copy_from_uint32_big_endian(
+		 volume_key_slot->number_of_stripes,
+		 1 );
+
+		if( key_slot_index >= number_of_key_slots )
+		{
+			byte_stream_copy_from_uint32_big_endian(
+			 volume_key_slot->state,
+			 0x0000dead );
+		}
+		else
+		{
+			byte_stream_copy_from_uint32_big_endian(
+			 volume_key_slot->state,
+			 0x00ac71f3 );
+
+			byte_stream_copy_from_uint32_big_endian(
+			 volume_key_slot->number_of_iterations,
+			 number_of_iterations[ key_slot_index ] );
+
+			memory_set(
+			 volume_key_slot->salt,
+			 0x40 + key_slot_index,
+			 32 );
+		}
+		if( ( key_slot_index < number_of_key_slots )
+		 && ( number_of_iterations[ key_slot_index ] != 0 ) )
+		{
+			if( libluksde_password_pbkdf2(
+			     (uint8_t *) passwords[ key_slot_index ],
+			     narrow_string_length(
+			      passwords[ key_slot_index ] ),
+			     LIBLUKSDE_HASHING_METHOD_SHA1,
+			     LIBLUKSDE_HASH_BACKEND_DEFAULT,
+			     volume_key_slot->salt,
+			     32,
+			     number_of_iterations[ key_slot_index ],
+			     user_key,
+			     32,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine key slot: %d user key.",
+				 function,
+				 key_slot_index );
+
+				goto on_error;
+			}
+			if( libluksde_encryption_set_keys(
+			     encryption_context,
+			     user_key,
+			     32,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set key slot: %d user key in encryption context.",
+				 function,
+				 key_slot_index );
+
+				goto on_error;
+			}
+			/* With a single stripe the split master key is the master key itself
+			 */
+			memory_set(
+			 key_material_data,
+			 0,
+			 LUKSDE_TEST_VOLUME_IMAGE_BYTES_PER_SECTOR );
+
+			memory_copy(
+			 key_material_data,
+			 master_key,
+			 32 );
+
+			if( libluksde_encryption_crypt(
+			     encryption_context,
+			     LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+			     key_material_data,
+			     LUKSDE_TEST_VOLUME_IMAGE_BYTES_PER_SECTOR,
+			     &( image_data[ key_material_start_sector * LUKSDE_TEST_VOLUME_IMAGE_BYTES_PER_SECTOR ] ),
+			     LUKSDE_TEST_VOLUME_IMAGE_BYTES_PER_SECTOR,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+				 LIBCERROR_ENCRYPTION_ERROR_ENCRYPT_FAILED,
+				 "%s: unable to encrypt key slot: %d key material.",
+				 function,
+				 key_slot_index );
+
+				goto on_error;
+			}
+		}
+		volume_key_slot++;
+	}
+	if( libluksde_encryption_set_keys(
+	     encryption_context,
+	     master_key,
+	     32,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set master key in encryption context.",
+		 function );
+
+		goto on_error;
+	}
+	sector_data = &( image_data[ LUKSDE_TEST_VOLUME_IMAGE_DATA_START_SECTOR * LUKSDE_TEST_VOLUME_IMAGE_BYTES_PER_SECTOR ] );
+
+	for( data_offset = 0;
+	     data_offset < LUKSDE_TEST_VOLUME_IMAGE_BYTES_PER_SECTOR;
+	     data_offset++ )
+	{
+		key_material_data[ data_offset ] = (uint8_t) ( data_offset % 251 );
+	}
+	if( libluksde_encryption_crypt(
+	     encryption_context,
+	     LIBLUKSDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+	     key_material_data,
+	     LUKSDE_TEST_VOLUME_IMAGE_BYTES_PER_SECTOR,
+	     sector_data,
+	     LUKSDE_TEST_VOLUME_IMAGE_BYTES_PER_SECTOR,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+		 LIBCERROR_ENCRYPTION_ERROR_ENCRYPT_FAILED,
+		 "%s: unable to encrypt sector data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libluksde_encryption_free(
+	     &encryption_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free encryption context.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( encryption_context != NULL )
+	{
+		libluksde_encryption_free(
+		 &encryption_context,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Opens a volume from the data of a volume image using a password
+ * The progress callback function is optional
+ * Returns 1 if successful, 0 if the keys could not be read or -1 on error
+ */
+int luksde_test_volume_open_image(
+     libluksde_volume_t **volume,
+     libbfio_handle_t **file_io_handle,
+     uint8_t *image_data,
+     size_t image_data_size,
+     const char *password,
+     int (*progress_callback_function)(
+            void *callback_data,
+            int key_slot_index,
+            int stage,
+            uint64_t value,
+            uint64_t maximum_value ),
+     void *callback_data,
+     libcerror_error_t **error )
+{
+	static char *function = "luksde_test_volume_open_image";
+	int result            = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
 	}
-	/* Test open and close
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( luksde_test_open_file_io_handle(
+	     file_io_handle,
+	     image_data,
+	     image_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libluksde_volume_initialize(
+	     volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize volume.",
+		 function );
+
+		goto on_error;
+	}
+	if( libluksde_volume_set_utf8_password(
+	     *volume,
+	     (uint8_t *) password,
+	     narrow_string_length(
+	      password ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set password.",
+		 function );
+
+		goto on_error;
+	}
+	if( progress_callback_function != NULL )
+	{
+		if( libluksde_volume_set_progress_callback(
+		     *volume,
+		     progress_callback_function,
+		     callback_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set progress callback.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	result = libluksde_volume_open_file_io_handle(
+	          *volume,
+	          *file_io_handle,
+	          LIBLUKSDE_OPEN_READ,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open volume.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( *volume != NULL )
+	{
+		libluksde_volume_free(
+		 volume,
+		 NULL );
+	}
+	if( *file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Closes a volume opened from the data of a volume image
+ * Returns 0 if successful or -1 on error
+ */
+int luksde_test_volume_close_image(
+     libluksde_volume_t **volume,
+     libbfio_handle_t **file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "luksde_test_volume_close_image";
+	int result            = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( libluksde_volume_close(
+	     *volume,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close volume.",
+		 function );
+
+		result = -1;
+	}
+	if( libluksde_volume_free(
+	     volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free volume.",
+		 function );
+
+		result = -1;
+	}
+	if( luksde_test_close_file_io_handle(
+	     file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file IO handle.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+/* Tests trying the key slots of a volume with multiple active key slots
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_volume_try_key_slots(
+     void )
+{
+	uint8_t image_data[ LUKSDE_TEST_VOLUME_IMAGE_SIZE ];
+	uint8_t sector_data[ LUKSDE_TEST_VOLUME_IMAGE_BYTES_PER_SECTOR ];
+
+	const char *passwords[ 4 ]         = { "password0", "password1", "password2", "password1" };
+	uint32_t number_of_iterations[ 4 ] = { 1000, 1000, 1000, 1000 };
+	libbfio_handle_t *file_io_handle   = NULL;
+	libcerror_error_t *error           = NULL;
+	libluksde_volume_t *volume         = NULL;
+	ssize_t read_count                 = 0;
+	size_t data_offset                 = 0;
+	int key_slot_index                 = 0;
+	int password_index                 = 0;
+	int result                         = 0;
+
+	/* Initialize test
 	 */
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	result = libluksde_volume_open_wide(
+	result = luksde_test_volume_create_image(
+	          image_data,
+	          LUKSDE_TEST_VOLUME_IMAGE_SIZE,
+	          passwords,
+	          number_of_iterations,
+	          4,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test unlocking with the password of a single key slot
+	 */
+	result = luksde_test_volume_open_image(
+	          &volume,
+	          &file_io_handle,
+	          image_data,
+	          LUKSDE_TEST_VOLUME_IMAGE_SIZE,
+	          "password2",
+	          NULL,
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_volume_is_locked(
 	          volume,
-	          source,
-	          LIBLUKSDE_OPEN_READ,
 	          &error );
-#else
-	result = libluksde_volume_open(
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_volume_get_unlocked_key_slot(
 	          volume,
-	          source,
-	          LIBLUKSDE_OPEN_READ,
+	          &password_index,
+	          &key_slot_index,
 	          &error );
-#endif
 
 	LUKSDE_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
 	 1 );
 
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "key_slot_index",
+	 key_slot_index,
+	 2 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = luksde_test_volume_close_image(
+	          &volume,
+	          &file_io_handle,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test unlocking with the password of multiple key slots that are tried concurrently
+	 */
+	result = luksde_test_volume_open_image(
+	          &volume,
+	          &file_io_handle,
+	          image_data,
+	          LUKSDE_TEST_VOLUME_IMAGE_SIZE,
+	          "password1",
+	          NULL,
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_volume_get_unlocked_key_slot(
+	          volume,
+	          &password_index,
+	          &key_slot_index,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ( ( key_slot_index == 1 ) || ( key_slot_index == 3 ) );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* The master key of the unlocking key slot decrypts the volume data
+	 */
+	read_count = libluksde_volume_read_buffer_at_offset(
+	              volume,
+	              sector_data,
+	              LUKSDE_TEST_VOLUME_IMAGE_BYTES_PER_SECTOR,
+	              0,
+	              &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) LUKSDE_TEST_VOLUME_IMAGE_BYTES_PER_SECTOR );
+
 	LUKSDE_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	result = libluksde_volume_close(
-	          volume,
+	for( data_offset = 0;
+	     data_offset < LUKSDE_TEST_VOLUME_IMAGE_BYTES_PER_SECTOR;
+	     data_offset++ )
+	{
+		if( sector_data[ data_offset ] != (uint8_t) ( data_offset % 251 ) )
+		{
+			break;
+		}
+	}
+	LUKSDE_TEST_ASSERT_EQUAL_SIZE(
+	 "data_offset",
+	 data_offset,
+	 (size_t) LUKSDE_TEST_VOLUME_IMAGE_BYTES_PER_SECTOR );
+
+	result = luksde_test_volume_close_image(
+	          &volume,
+	          &file_io_handle,
 	          &error );
 
 	LUKSDE_TEST_ASSERT_EQUAL_INT(
@@ -1277,21 +4404,30 @@ int luksde_test_volume_open_close(
 	 "error",
 	 error );
 
-	/* Test open and close a second time to validate clean up on close
+	/* Test unlocking with a password that does not match any key slot
 	 */
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	result = libluksde_volume_open_wide(
-	          volume,
-	          source,
-	          LIBLUKSDE_OPEN_READ,
+	result = luksde_test_volume_open_image(
+	          &volume,
+	          &file_io_handle,
+	          image_data,
+	          LUKSDE_TEST_VOLUME_IMAGE_SIZE,
+	          "password3",
+	          NULL,
+	          NULL,
 	          &error );
-#else
-	result = libluksde_volume_open(
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_volume_is_locked(
 	          volume,
-	          source,
-	          LIBLUKSDE_OPEN_READ,
 	          &error );
-#endif
 
 	LUKSDE_TEST_ASSERT_EQUAL_INT(
 	 "result",
@@ -1302,8 +4438,10 @@ int luksde_test_volume_open_close(
 	 "error",
 	 error );
 
-	result = libluksde_volume_close(
+	result = libluksde_volume_get_unlocked_key_slot(
 	          volume,
+	          &password_index,
+	          &key_slot_index,
 	          &error );
 
 	LUKSDE_TEST_ASSERT_EQUAL_INT(
@@ -1315,20 +4453,15 @@ int luksde_test_volume_open_close(
 	 "error",
 	 error );
 
-	/* Clean up
-	 */
-	result = libluksde_volume_free(
+	result = luksde_test_volume_close_image(
 	          &volume,
+	          &file_io_handle,
 	          &error );
 
 	LUKSDE_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
-
-	LUKSDE_TEST_ASSERT_IS_NULL(
-	 "volume",
-	 volume );
+	 0 );
 
 	LUKSDE_TEST_ASSERT_IS_NULL(
 	 "error",
@@ -1344,26 +4477,61 @@ on_error:
 	}
 	if( volume != NULL )
 	{
-		libluksde_volume_free(
+		luksde_test_volume_close_image(
 		 &volume,
+		 &file_io_handle,
 		 NULL );
 	}
 	return( 0 );
 }
 
-/* Tests the libluksde_volume_signal_abort function
+/* Progress callback function that signals the volume to abort
+ * Returns 1 to continue
+ */
+int luksde_test_volume_signal_abort_progress_callback(
+     void *callback_data,
+     int key_slot_index LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     int stage LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     uint64_t value LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     uint64_t maximum_value LUKSDE_TEST_ATTRIBUTE_UNUSED )
+{
+	libluksde_volume_t **volume = (libluksde_volume_t **) callback_data;
+
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( key_slot_index )
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( stage )
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( value )
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( maximum_value )
+
+	libluksde_volume_signal_abort(
+	 *volume,
+	 NULL );
+
+	return( 1 );
+}
+
+/* Tests signalling abort while the key slots of a volume are tried
  * Returns 1 if successful or 0 if not
  */
-int luksde_test_volume_signal_abort(
-     libluksde_volume_t *volume )
+int luksde_test_volume_try_key_slots_signal_abort(
+     void )
 {
-	libcerror_error_t *error = NULL;
-	int result               = 0;
+	uint8_t image_data[ LUKSDE_TEST_VOLUME_IMAGE_SIZE ];
 
-	/* Test regular cases
+	const char *passwords[ 2 ]         = { "password0", "password1" };
+	uint32_t number_of_iterations[ 2 ] = { 8192, 8192 };
+	libbfio_handle_t *file_io_handle   = NULL;
+	libcerror_error_t *error           = NULL;
+	libluksde_volume_t *volume         = NULL;
+	int result                         = 0;
+
+	/* Initialize test
 	 */
-	result = libluksde_volume_signal_abort(
-	          volume,
+	result = luksde_test_volume_create_image(
+	          image_data,
+	          LUKSDE_TEST_VOLUME_IMAGE_SIZE,
+	          passwords,
+	          number_of_iterations,
+	          2,
 	          &error );
 
 	LUKSDE_TEST_ASSERT_EQUAL_INT(
@@ -1375,23 +4543,53 @@ int luksde_test_volume_signal_abort(
 	 "error",
 	 error );
 
-	/* Test error cases
+	/* Test that the key slot trials stop when abort is signalled
 	 */
-	result = libluksde_volume_signal_abort(
-	          NULL,
+	result = luksde_test_volume_open_image(
+	          &volume,
+	          &file_io_handle,
+	          image_data,
+	          LUKSDE_TEST_VOLUME_IMAGE_SIZE,
+	          "password1",
+	          &luksde_test_volume_signal_abort_progress_callback,
+	          (void *) &volume,
 	          &error );
 
 	LUKSDE_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 0 );
 
-	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	LUKSDE_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	result = libluksde_volume_is_locked(
+	          volume,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = luksde_test_volume_close_image(
+	          &volume,
+	          &file_io_handle,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	return( 1 );
 
@@ -1401,149 +4599,143 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( volume != NULL )
+	{
+		luksde_test_volume_close_image(
+		 &volume,
+		 &file_io_handle,
+		 NULL );
+	}
 	return( 0 );
 }
 
-/* Tests the libluksde_volume_read_buffer function
+/* Tests trying the key slots of a volume with a key slot that cannot be tried
  * Returns 1 if successful or 0 if not
  */
-int luksde_test_volume_read_buffer(
-     libluksde_volume_t *volume )
+int luksde_test_volume_try_key_slots_error(
+     void )
 {
-	uint8_t buffer[ 16 ];
+	uint8_t image_data[ LUKSDE_TEST_VOLUME_IMAGE_SIZE ];
 
-	libcerror_error_t *error = NULL;
-	size64_t size            = 0;
-	ssize_t read_count       = 0;
-	off64_t offset           = 0;
+	const char *passwords[ 2 ]         = { "password0", "password1" };
+	uint32_t number_of_iterations[ 2 ] = { 0, 1000 };
+	libbfio_handle_t *file_io_handle   = NULL;
+	libcerror_error_t *error           = NULL;
+	libluksde_volume_t *volume         = NULL;
+	int key_slot_index                 = 0;
+	int password_index                 = 0;
+	int result                         = 0;
 
-	/* Determine size
+	/* Initialize test
 	 */
-	offset = libluksde_volume_seek_offset(
-	          volume,
-	          0,
-	          SEEK_END,
+	result = luksde_test_volume_create_image(
+	          image_data,
+	          LUKSDE_TEST_VOLUME_IMAGE_SIZE,
+	          passwords,
+	          number_of_iterations,
+	          2,
 	          &error );
 
-	LUKSDE_TEST_ASSERT_NOT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	LUKSDE_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	size = (size64_t) offset;
-
-	/* Reset offset to 0
+	/* Test that another key slot unlocks the volume when a key slot cannot be tried
 	 */
-	offset = libluksde_volume_seek_offset(
-	          volume,
-	          0,
-	          SEEK_SET,
+	result = luksde_test_volume_open_image(
+	          &volume,
+	          &file_io_handle,
+	          image_data,
+	          LUKSDE_TEST_VOLUME_IMAGE_SIZE,
+	          "password1",
+	          NULL,
+	          NULL,
 	          &error );
 
-	LUKSDE_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 0 );
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	LUKSDE_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Test regular cases
-	 */
-	if( size > 16 )
-	{
-		read_count = libluksde_volume_read_buffer(
-		              volume,
-		              buffer,
-		              16,
-		              &error );
-
-		LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
-		 "read_count",
-		 read_count,
-		 (ssize_t) 16 );
-
-		LUKSDE_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
-	}
-/* TODO read on size boundary */
-/* TODO read beyond size boundary */
-
-	/* Reset offset to 0
-	 */
-	offset = libluksde_volume_seek_offset(
+	result = libluksde_volume_get_unlocked_key_slot(
 	          volume,
-	          0,
-	          SEEK_SET,
+	          &password_index,
+	          &key_slot_index,
 	          &error );
 
-	LUKSDE_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 0 );
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "key_slot_index",
+	 key_slot_index,
+	 1 );
 
 	LUKSDE_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Test error cases
-	 */
-	read_count = libluksde_volume_read_buffer(
-	              NULL,
-	              buffer,
-	              16,
-	              &error );
+	result = luksde_test_volume_close_image(
+	          &volume,
+	          &file_io_handle,
+	          &error );
 
-	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
-	 "read_count",
-	 read_count,
-	 (ssize_t) -1 );
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
 
-	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	LUKSDE_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	/* Test that the error of the key slot trial is passed on when no key slot unlocks the volume
+	 */
+	result = luksde_test_volume_open_image(
+	          &volume,
+	          &file_io_handle,
+	          image_data,
+	          LUKSDE_TEST_VOLUME_IMAGE_SIZE,
+	          "password2",
+	          NULL,
+	          NULL,
+	          &error );
 
-	read_count = libluksde_volume_read_buffer(
-	              volume,
-	              NULL,
-	              16,
-	              &error );
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
-	 "read_count",
-	 read_count,
-	 (ssize_t) -1 );
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "volume",
+	 volume );
 
 	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
-
-	read_count = libluksde_volume_read_buffer(
-	              volume,
-	              buffer,
-	              (size_t) SSIZE_MAX + 1,
-	              &error );
-
-	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
-	 "read_count",
-	 read_count,
-	 (ssize_t) -1 );
+	/* The error originates from the PBKDF2 of the key slot with 0 iterations
+	 */
+	result = libcerror_error_matches(
+	          error,
+	          LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+	          LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS );
 
-	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	libcerror_error_free(
 	 &error );
@@ -1556,9 +4748,18 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( volume != NULL )
+	{
+		luksde_test_volume_close_image(
+		 &volume,
+		 &file_io_handle,
+		 NULL );
+	}
 	return( 0 );
 }
 
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+
 /* Tests the libluksde_volume_seek_offset function
  * Returns 1 if successful or 0 if not
  */
@@ -1888,6 +5089,259 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libluksde_volume_get_key_slot_parameters function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_volume_get_key_slot_parameters(
+     libluksde_volume_t *volume )
+{
+	libcerror_error_t *error      = NULL;
+	uint32_t number_of_iterations = 0;
+	uint32_t number_of_stripes    = 0;
+	int key_slot_index            = 0;
+	int number_of_key_slots       = 0;
+	int result                    = 0;
+
+	/* Test regular cases
+	 */
+	result = libluksde_volume_get_number_of_key_slots(
+	          volume,
+	          &number_of_key_slots,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "number_of_key_slots",
+	 number_of_key_slots,
+	 8 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( key_slot_index = 0;
+	     key_slot_index < number_of_key_slots;
+	     key_slot_index++ )
+	{
+		result = libluksde_volume_get_key_slot_parameters(
+		          volume,
+		          key_slot_index,
+		          &number_of_iterations,
+		          &number_of_stripes,
+		          &error );
+
+		LUKSDE_TEST_ASSERT_NOT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		LUKSDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	result = libluksde_volume_get_number_of_key_slots(
+	          NULL,
+	          &number_of_key_slots,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_volume_get_key_slot_parameters(
+	          NULL,
+	          0,
+	          &number_of_iterations,
+	          &number_of_stripes,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_volume_get_key_slot_parameters(
+	          volume,
+	          -1,
+	          &number_of_iterations,
+	          &number_of_stripes,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_volume_get_key_slot_parameters(
+	          volume,
+	          0,
+	          NULL,
+	          &number_of_stripes,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_volume_get_key_slot_parameters(
+	          volume,
+	          0,
+	          &number_of_iterations,
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_volume_probe_pbkdf2 function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_volume_probe_pbkdf2(
+     libluksde_volume_t *volume )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libluksde_volume_probe_pbkdf2(
+	          volume,
+	          1000,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_volume_probe_pbkdf2(
+	          NULL,
+	          1000,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_volume_probe_pbkdf2(
+	          volume,
+	          0,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_volume_probe_pbkdf2(
+	          volume,
+	          1000,
+	          65,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 /* The main program
  */
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -1949,6 +5403,46 @@ int main(
 	 "libluksde_volume_free",
 	 luksde_test_volume_free );
 
+	LUKSDE_TEST_RUN(
+	 "libluksde_volume_set_encryption_provider",
+	 luksde_test_volume_set_encryption_provider );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_volume_set_essiv_cache_size",
+	 luksde_test_volume_set_essiv_cache_size );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_volume_set_chunk_cache_parameters",
+	 luksde_test_volume_set_chunk_cache_parameters );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_volume_set_readahead_parameters",
+	 luksde_test_volume_set_readahead_parameters );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_volume_set_progress_callback",
+	 luksde_test_volume_set_progress_callback );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_volume_set_utf8_passwords",
+	 luksde_test_volume_set_utf8_passwords );
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_internal_volume_try_key_slots",
+	 luksde_test_volume_try_key_slots );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_internal_volume_try_key_slots_signal_abort",
+	 luksde_test_volume_try_key_slots_signal_abort );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_internal_volume_try_key_slots_error",
+	 luksde_test_volume_try_key_slots_error );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+
 #if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
 	if( source != NULL )
 	{
@@ -1984,6 +5478,15 @@ int main(
 		 source,
 		 option_password );
 
+		if( option_password != NULL )
+		{
+			LUKSDE_TEST_RUN_WITH_ARGS(
+			 "libluksde_volume_open_with_passwords",
+			 luksde_test_volume_open_with_passwords,
+			 source,
+			 option_password );
+		}
+
 		/* Initialize test
 		 */
 		result = luksde_test_volume_open_source(
@@ -2014,6 +5517,20 @@ int main(
 
 		/* TODO: add tests for libluksde_volume_open_read */
 
+		LUKSDE_TEST_RUN_WITH_ARGS(
+		 "libluksde_sector_data_read_backends",
+		 luksde_test_volume_read_sector_data_backends,
+		 volume );
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+
+		LUKSDE_TEST_RUN_WITH_ARGS(
+		 "libluksde_readahead",
+		 luksde_test_volume_readahead,
+		 volume );
+
+#endif /* defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT ) */
+
 #endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
 
 		LUKSDE_TEST_RUN_WITH_ARGS(
@@ -2021,6 +5538,11 @@ int main(
 		 luksde_test_volume_read_buffer,
 		 volume );
 
+		LUKSDE_TEST_RUN_WITH_ARGS(
+		 "libluksde_volume_get_readahead_statistics",
+		 luksde_test_volume_get_readahead_statistics,
+		 volume );
+
 		/* TODO: add tests for libluksde_volume_read_buffer_at_offset */
 
 		/* TODO: add tests for libluksde_volume_write_buffer */
@@ -2044,6 +5566,20 @@ int main(
 
 		/* TODO: add tests for libluksde_volume_get_encryption_method */
 
+		/* TODO: add tests for libluksde_volume_get_hashing_method */
+
+		/* TODO: add tests for libluksde_volume_get_master_key_parameters */
+
+		LUKSDE_TEST_RUN_WITH_ARGS(
+		 "libluksde_volume_get_key_slot_parameters",
+		 luksde_test_volume_get_key_slot_parameters,
+		 volume );
+
+		LUKSDE_TEST_RUN_WITH_ARGS(
+		 "libluksde_volume_probe_pbkdf2",
+		 luksde_test_volume_probe_pbkdf2,
+		 volume );
+
 		/* TODO: add tests for libluksde_volume_set_keys */
 
 		/* TODO: add tests for libluksde_volume_set_utf8_password */
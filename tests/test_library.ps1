@@ -6,7 +6,7 @@ $ExitSuccess = 0
 $ExitFailure = 1
 $ExitIgnore = 77
 
-$LibraryTests = "error key_slot notify sector_data"
+$LibraryTests = "encryption error key_slot key_slot_trial multi_buffer notify password readahead sector_data sector_data_pool"
 $LibraryTestsWithInput = "support volume"
 
 Function GetTestToolDirectory
@@ -7,7 +7,7 @@ EXIT_SUCCESS=0;
 EXIT_FAILURE=1;
 EXIT_IGNORE=77;
 
-LIBRARY_TESTS="error key_slot notify sector_data";
+LIBRARY_TESTS="encryption error key_slot key_slot_trial multi_buffer notify password readahead sector_data sector_data_pool";
 LIBRARY_TESTS_WITH_INPUT="support volume";
 OPTION_SETS="password";
 